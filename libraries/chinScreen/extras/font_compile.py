@@ -0,0 +1,276 @@
+#!/usr/bin/env python3
+"""Add direct look up tables to the fonts made by lv_font_conv, for O(1) glyph and kerning look ups.
+
+    font_compile.py [--range 256] [--strip] fonts...
+
+LVGL finds the glyph of a letter by walking the cmaps of the font and binary searching the sparse
+ones, and the kerning of two letters by binary searching the kern pairs, for every letter drawn or
+measured. This rewrites every font of the given .inc files (src/includes/fonts/*.inc) in place with
+
+    <name>_lut_glyph_ids[]      the glyph of every letter below --range (256: ASCII and Latin-1)
+    <name>_lut_kern_left[]      the row and column of those letters in a flat kerning table,
+    <name>_lut_kern_right[]     letters that kern the same share a row or a column
+    <name>_lut_kern_values[]
+    <name>_get_glyph_dsc()      callbacks of the font that read the tables and fall back to the
+    <name>_get_glyph_bitmap()   cmaps for the letters above --range
+
+The glyphs, bitmaps and kerning stay the same, so the font draws the same pixels. Running it again
+replaces the tables, --strip removes them.
+
+Needs only the Python standard library.
+"""
+
+import argparse
+import re
+import sys
+
+
+LUT_HEADER = '/*--------------------\n *  DIRECT LOOK UP\n *--------------------*/\n'
+PUBLIC_HEADER = '/*-----------------\n *  PUBLIC FONT\n *----------------*/\n'
+
+
+#####################################################################
+# Parsing the lv_font_conv output
+#####################################################################
+
+def strip_comments(text):
+    return re.sub(r'/\*.*?\*/|//[^\n]*', '', text, flags=re.S)
+
+
+def c_struct(text, name):
+    """Fields of `NAME = { .field = value, ... }` as strings"""
+    m = re.search(r'\b%s\s*=\s*\{(.*?)\};' % re.escape(name), text, re.S)
+    if not m:
+        raise ValueError('%s not found' % name)
+    return dict(re.findall(r'\.(\w+)\s*=\s*([^,}]+?)\s*(?:,|$)', m.group(1)))
+
+
+def c_array(text, name):
+    """Numbers in `NAME[] = { ... }`"""
+    m = re.search(r'\b%s\s*\[\s*\]\s*=\s*\{(.*?)\};' % re.escape(name), text, re.S)
+    if not m:
+        raise ValueError('%s[] not found' % name)
+    return [int(v, 0) for v in re.findall(r'-?(?:0x[0-9a-fA-F]+|\d+)', m.group(1))]
+
+
+def c_ref(value):
+    """Name of the array a field points to, None for NULL"""
+    value = value.strip().lstrip('&').strip()
+    return None if value in ('NULL', '0') else value
+
+
+class Font:
+    def __init__(self, name, text):
+        self.name = name
+        font = c_struct(text, name)
+        fdsc = c_struct(text, c_ref(font['dsc']))
+
+        self.cmaps = []
+        cmaps_name = c_ref(fdsc['cmaps'])
+        body = re.search(r'\b%s\s*\[\s*\]\s*=\s*\{(.*?\})\s*\};' % re.escape(cmaps_name), text, re.S).group(1)
+        for entry in re.findall(r'\{([^{}]*)\}', body):
+            f = dict(re.findall(r'\.(\w+)\s*=\s*([^,]+?)\s*(?:,|$)', entry.strip()))
+            cmap = {
+                'start': int(f['range_start'], 0),
+                'length': int(f['range_length'], 0),
+                'gid_start': int(f['glyph_id_start'], 0),
+                'type': f['type'].strip(),
+                'unicode_list': None,
+                'ofs_list': None,
+            }
+            if c_ref(f['unicode_list']):
+                cmap['unicode_list'] = c_array(text, c_ref(f['unicode_list']))
+            if c_ref(f['glyph_id_ofs_list']):
+                cmap['ofs_list'] = c_array(text, c_ref(f['glyph_id_ofs_list']))
+            self.cmaps.append(cmap)
+        self.cmaps = self.cmaps[:int(fdsc['cmap_num'], 0)]
+
+        self.kern = {}
+        self.kern_classes = None
+        kern_name = c_ref(fdsc['kern_dsc'])
+        if kern_name and int(fdsc['kern_classes'], 0) == 0:
+            k = c_struct(text, kern_name)
+            ids = c_array(text, c_ref(k['glyph_ids']))
+            values = c_array(text, c_ref(k['values']))
+            for i in range(int(k['pair_cnt'], 0)):
+                self.kern[(ids[2 * i], ids[2 * i + 1])] = values[i]
+        elif kern_name:
+            k = c_struct(text, kern_name)
+            self.kern_classes = (c_array(text, c_ref(k['left_class_mapping'])),
+                                 c_array(text, c_ref(k['right_class_mapping'])),
+                                 c_array(text, c_ref(k['class_pair_values'])),
+                                 int(k['right_class_cnt'], 0))
+        self.has_kerning = kern_name is not None
+
+    def glyph_id(self, letter):
+        """Like get_glyph_dsc_id() of lv_font_fmt_txt.c: the first cmap covering the letter decides"""
+        if letter == 0:
+            return 0
+        for c in self.cmaps:
+            rcp = letter - c['start']
+            if rcp < 0 or rcp >= c['length']:
+                continue
+            if c['type'] == 'LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY':
+                return c['gid_start'] + rcp
+            if c['type'] == 'LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL':
+                return c['gid_start'] + c['ofs_list'][rcp]
+            if rcp not in c['unicode_list']:
+                return 0
+            ofs = c['unicode_list'].index(rcp)
+            if c['type'] == 'LV_FONT_FMT_TXT_CMAP_SPARSE_TINY':
+                return c['gid_start'] + ofs
+            return c['gid_start'] + c['ofs_list'][ofs]
+        return 0
+
+    def kern_value(self, gid_left, gid_right):
+        if self.kern_classes:
+            left_map, right_map, values, right_cnt = self.kern_classes
+            left, right = left_map[gid_left], right_map[gid_right]
+            return values[(left - 1) * right_cnt + (right - 1)] if left and right else 0
+        return self.kern.get((gid_left, gid_right), 0)
+
+
+#####################################################################
+# Output
+#####################################################################
+
+def c_numbers(values, per_line=16, width=0):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join('%*d' % (width, v) for v in values[i:i + per_line]) + ',')
+    return '\n'.join(lines)
+
+
+def kern_tables(font, letters):
+    """Row and column of every letter, 0 if it never kerns on that side, and the rows of values"""
+    gids = [font.glyph_id(c) for c in letters]
+    matrix = [[font.kern_value(l, r) if l and r else 0 for r in gids] for l in gids]
+
+    def index(vectors):
+        ids, unique = [], {}
+        for v in vectors:
+            if not any(v):
+                ids.append(0)
+                continue
+            unique.setdefault(tuple(v), len(unique) + 1)
+            ids.append(unique[tuple(v)])
+        if len(unique) > 255:
+            raise ValueError('%d distinct kerning rows or columns, more than 255' % len(unique))
+        return ids, sorted(unique, key=unique.get)
+
+    left, rows = index(matrix)
+    right, cols = index([list(col) for col in zip(*matrix)])
+    # The letter of every column, to read the distinct rows at them
+    col_letters = [right.index(j + 1) for j in range(len(cols))]
+    values = [row[i] for row in rows for i in col_letters]
+    return left, right, values, len(cols)
+
+
+def lut_block(font, lut_range):
+    n = font.name
+    letters = range(lut_range)
+    gids = [font.glyph_id(c) for c in letters]
+    found = sum(1 for g in gids if g)
+    out = [LUT_HEADER,
+           '/*Glyph IDs of U+0000..U+%04X, 0: not in the font. Made by extras/font_compile.py, run it again\n'
+           ' *when the font changes*/\n' % (lut_range - 1),
+           'static const uint16_t %s_lut_glyph_ids[%d] = {\n%s\n};\n' % (n, lut_range, c_numbers(gids, 16, 3))]
+    size = 2 * lut_range
+
+    kern = 'NULL', 'NULL', 'NULL', 0
+    if font.has_kerning:
+        left, right, values, right_cnt = kern_tables(font, letters)
+        out.append('\n/*Row and column of the letters in the kerning table, 0: not kerned on that side*/\n')
+        out.append('static const uint8_t %s_lut_kern_left[%d] = {\n%s\n};\n' % (n, lut_range, c_numbers(left, 16, 3)))
+        out.append('static const uint8_t %s_lut_kern_right[%d] = {\n%s\n};\n' % (n, lut_range, c_numbers(right, 16, 3)))
+        out.append('\n/*%d x %d kerning values, 4.4 format scaled with `kern_scale`*/\n' % (len(values) // max(right_cnt, 1), right_cnt))
+        out.append('static const int8_t %s_lut_kern_values[%d] = {\n%s\n};\n' % (n, max(len(values), 1),
+                                                                                c_numbers(values or [0], 16, 3)))
+        kern = '%s_lut_kern_left' % n, '%s_lut_kern_right' % n, '%s_lut_kern_values' % n, right_cnt
+        size += 2 * lut_range + len(values)
+
+    out.append('\nstatic const lv_font_fmt_txt_lut_t %s_lut = {\n' % n)
+    out.append('    .glyph_ids = %s_lut_glyph_ids,\n' % n)
+    out.append('    .kern_left = %s,\n    .kern_right = %s,\n    .kern_values = %s,\n' % kern[:3])
+    out.append('    .range = %d,\n    .kern_right_cnt = %d\n};\n\n' % (lut_range, kern[3]))
+    decl = 'static bool %s_get_glyph_dsc(' % n
+    out.append('%sconst lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,\n'
+               '%suint32_t letter_next)\n{\n'
+               '    return lv_font_get_glyph_dsc_fmt_txt_lut(font, dsc_out, letter, letter_next, &%s_lut);\n}\n\n'
+               % (decl, ' ' * len(decl), n))
+    out.append('static const uint8_t * %s_get_glyph_bitmap(const lv_font_t * font, uint32_t letter)\n{\n'
+               '    return lv_font_get_bitmap_fmt_txt_lut(font, letter, &%s_lut);\n}\n' % (n, n))
+    return ''.join(out), found, size, kern[3]
+
+
+def strip_lut(text, name):
+    """Remove the tables of a font and give it back the plain callbacks"""
+    m = re.search(re.escape(LUT_HEADER) + r'[^\n]*\n[^\n]*\nstatic const uint16_t %s_lut_glyph_ids\[' % name, text)
+    if m:
+        end = text.index('\n}\n', text.index('%s_get_glyph_bitmap(' % name, m.start())) + 3
+        text = text[:m.start()] + text[end:]
+    text = text.replace('.get_glyph_dsc = %s_get_glyph_dsc,' % name, '.get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,')
+    text = text.replace('.get_glyph_bitmap = %s_get_glyph_bitmap,' % name, '.get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,')
+    return text
+
+
+def compile_file(path, args):
+    with open(path, encoding='utf-8') as f:
+        text = f.read()
+
+    names = re.findall(r'^\s*const lv_font_t (\w+)\s*=\s*\{', text, re.M)
+    if not names:
+        raise ValueError('no lv_font_t in the file')
+    for name in names:
+        text = strip_lut(text, name)
+        if args.strip:
+            print('%-28s tables removed' % name)
+            continue
+
+        # The font's own part of the file, some files hold several fonts
+        font_pos = re.search(r'^\s*const lv_font_t %s\s*=\s*\{' % name, text, re.M).start()
+        prev = [m.end() for m in re.finditer(r'^\s*const lv_font_t \w+\s*=\s*\{.*?\};', text[:font_pos], re.M | re.S)]
+        part = strip_comments(text[prev[-1] if prev else 0:text.index('};', font_pos) + 2])
+        font = Font(name, part)
+
+        block, found, size, right_cnt = lut_block(font, args.range)
+        header = text.rfind(PUBLIC_HEADER, 0, font_pos)
+        insert = header if header >= 0 and header > (prev[-1] if prev else 0) else font_pos
+        text = replace_in_font(text[:insert] + block + text[insert:], name)
+        print('%-28s %3d of %d letters, %s, %d bytes' % (name, found, args.range,
+              'kerning %d columns' % right_cnt if font.has_kerning else 'no kerning', size))
+
+    with open(path, 'w', encoding='utf-8') as f:
+        f.write(text)
+
+
+def replace_in_font(text, name):
+    """Point the callbacks of the font to the generated ones"""
+    start = re.search(r'^\s*const lv_font_t %s\s*=\s*\{' % name, text, re.M).start()
+    end = text.index('};', start)
+    body = text[start:end]
+    body = body.replace('.get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,', '.get_glyph_dsc = %s_get_glyph_dsc,' % name)
+    body = body.replace('.get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,', '.get_glyph_bitmap = %s_get_glyph_bitmap,' % name)
+    return text[:start] + body + text[end:]
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Add direct glyph and kerning look up tables to lv_font_conv fonts.')
+    parser.add_argument('fonts', nargs='+', help='.inc/.c files made by lv_font_conv, rewritten in place')
+    parser.add_argument('--range', type=int, default=256, choices=[128, 256],
+                        help='letters covered by the tables: 128 ASCII, 256 ASCII and Latin-1')
+    parser.add_argument('--strip', action='store_true', help='remove the tables again')
+    args = parser.parse_args()
+
+    failed = False
+    for path in args.fonts:
+        try:
+            compile_file(path, args)
+        except (ValueError, KeyError, AttributeError) as e:
+            print('%s: %s' % (path, e), file=sys.stderr)
+            failed = True
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,520 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host build: Arduino core, Serial and SD on top of POSIX
+ */
+
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include "Arduino.h"
+#include "SD.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+fs::SDFS SD;
+
+/*******************************************************************************
+* Time and pins
+*******************************************************************************/
+
+static uint64_t host_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static const uint64_t host_start_us = host_now_us();
+
+unsigned long millis(void)
+{
+    return (unsigned long)((host_now_us() - host_start_us) / 1000);
+}
+
+unsigned long micros(void)
+{
+    return (unsigned long)(host_now_us() - host_start_us);
+}
+
+void delay(uint32_t ms)
+{
+    delayMicroseconds(ms * 1000);
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    struct timespec ts = {
+        .tv_sec = us / 1000000,
+        .tv_nsec = (long)(us % 1000000) * 1000,
+    };
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+    }
+}
+
+void yield(void)
+{
+    sched_yield();
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {}
+void digitalWrite(uint8_t pin, uint8_t val) {}
+int digitalRead(uint8_t pin) { return LOW; }
+int analogRead(uint8_t pin) { return 0; }
+void analogWrite(uint8_t pin, int val) {}
+
+long random(long howbig)
+{
+    return howbig > 0 ? ::random() % howbig : 0;
+}
+
+long random(long howsmall, long howbig)
+{
+    return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed)
+{
+    if (seed != 0) {
+        srandom(seed);
+    }
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+    if (in_max == in_min) {
+        return out_min;
+    }
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+/*******************************************************************************
+* String
+*******************************************************************************/
+
+String::String(double v, unsigned int decimals)
+{
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+    str = buf;
+}
+
+int String::indexOf(char c, unsigned int from) const
+{
+    size_t i = str.find(c, from);
+    return i == std::string::npos ? -1 : (int)i;
+}
+
+int String::indexOf(const String &s, unsigned int from) const
+{
+    size_t i = str.find(s.str, from);
+    return i == std::string::npos ? -1 : (int)i;
+}
+
+String String::substring(unsigned int from) const
+{
+    return from < str.length() ? String(str.substr(from)) : String();
+}
+
+String String::substring(unsigned int from, unsigned int to) const
+{
+    if (from > to) {
+        std::swap(from, to);
+    }
+    return from < str.length() ? String(str.substr(from, to - from)) : String();
+}
+
+bool String::endsWith(const String &s) const
+{
+    return str.length() >= s.str.length() && str.compare(str.length() - s.str.length(), s.str.length(), s.str) == 0;
+}
+
+bool String::equalsIgnoreCase(const String &s) const
+{
+    return strcasecmp(str.c_str(), s.str.c_str()) == 0;
+}
+
+void String::trim()
+{
+    size_t b = 0;
+    size_t e = str.length();
+    while (b < e && isspace((unsigned char)str[b])) {
+        b++;
+    }
+    while (e > b && isspace((unsigned char)str[e - 1])) {
+        e--;
+    }
+    str = str.substr(b, e - b);
+}
+
+void String::toLowerCase()
+{
+    for (char &c : str) {
+        c = (char)tolower((unsigned char)c);
+    }
+}
+
+void String::toUpperCase()
+{
+    for (char &c : str) {
+        c = (char)toupper((unsigned char)c);
+    }
+}
+
+/*******************************************************************************
+* Serial
+*******************************************************************************/
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    return fwrite(&c, 1, 1, stdout);
+}
+
+size_t HardwareSerial::write(const uint8_t *buf, size_t size)
+{
+    return fwrite(buf, 1, size, stdout);
+}
+
+size_t HardwareSerial::print(const char *s)
+{
+    return fputs(s, stdout) >= 0 ? strlen(s) : 0;
+}
+
+size_t HardwareSerial::print(char c)
+{
+    return write((uint8_t)c);
+}
+
+size_t HardwareSerial::print(long n, int base)
+{
+    if (base == DEC) {
+        return ::printf("%ld", n);
+    }
+    return print((unsigned long)n, base);
+}
+
+size_t HardwareSerial::print(unsigned long n, int base)
+{
+    char buf[8 * sizeof(long) + 1];
+    char *p = &buf[sizeof(buf) - 1];
+    *p = '\0';
+    if (base < 2) {
+        base = DEC;
+    }
+    do {
+        const unsigned long d = n % base;
+        *--p = (char)(d < 10 ? '0' + d : 'A' + d - 10);
+        n /= base;
+    } while (n);
+    return print(p);
+}
+
+size_t HardwareSerial::print(double n, int digits)
+{
+    return ::printf("%.*f", digits, n);
+}
+
+size_t HardwareSerial::println(void)
+{
+    return print("\r\n");
+}
+
+size_t HardwareSerial::printf(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    const int len = vprintf(format, args);
+    va_end(args);
+    return len > 0 ? (size_t)len : 0;
+}
+
+void HardwareSerial::flush()
+{
+    fflush(stdout);
+}
+
+int HardwareSerial::available()
+{
+    struct pollfd pfd = {
+        .fd = STDIN_FILENO,
+        .events = POLLIN,
+        .revents = 0,
+    };
+    return (poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN)) ? 1 : 0;
+}
+
+int HardwareSerial::read()
+{
+    if (!available()) {
+        return -1;
+    }
+    uint8_t c;
+    return ::read(STDIN_FILENO, &c, 1) == 1 ? c : -1;
+}
+
+int HardwareSerial::peek()
+{
+    /* stdin cannot be peeked without buffering, which would hide it from available() */
+    return -1;
+}
+
+String HardwareSerial::readStringUntil(char terminator)
+{
+    std::string s;
+    int c;
+    while ((c = read()) >= 0 && c != terminator) {
+        s += (char)c;
+    }
+    return String(s);
+}
+
+String HardwareSerial::readString()
+{
+    return readStringUntil('\0');
+}
+
+/*******************************************************************************
+* ESP
+*******************************************************************************/
+
+uint32_t EspClass::getFreeHeap() { return 320 * 1024; }
+uint32_t EspClass::getHeapSize() { return 320 * 1024; }
+uint32_t EspClass::getFreePsram() { return 8 * 1024 * 1024; }
+uint32_t EspClass::getPsramSize() { return 8 * 1024 * 1024; }
+
+void EspClass::restart()
+{
+    fflush(stdout);
+    exit(0);
+}
+
+/*******************************************************************************
+* File system
+*******************************************************************************/
+
+namespace fs {
+
+struct File::Handle {
+    FILE *file = nullptr;
+    DIR *dir = nullptr;
+    std::string host_path;
+
+    ~Handle()
+    {
+        if (file) {
+            fclose(file);
+        }
+        if (dir) {
+            closedir(dir);
+        }
+    }
+};
+
+File::File(const std::string &host_path, const std::string &vpath, const char *mode)
+{
+    struct stat st;
+    std::shared_ptr<Handle> handle = std::make_shared<Handle>();
+    handle->host_path = host_path;
+    if (stat(host_path.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        handle->dir = opendir(host_path.c_str());
+    } else {
+        /* "w" on the device truncates, "r" must exist; binary either way */
+        std::string m = std::string(mode) + "b";
+        handle->file = fopen(host_path.c_str(), m.c_str());
+    }
+    if (!handle->file && !handle->dir) {
+        return;
+    }
+    h = handle;
+    vpath_ = vpath;
+    const size_t slash = vpath.find_last_of('/');
+    name_ = slash == std::string::npos ? vpath : vpath.substr(slash + 1);
+}
+
+File::operator bool() const
+{
+    return h != nullptr;
+}
+
+size_t File::size() const
+{
+    struct stat st;
+    if (!h || !h->file || fstat(fileno(h->file), &st) != 0) {
+        return 0;
+    }
+    return (size_t)st.st_size;
+}
+
+size_t File::position() const
+{
+    return (h && h->file) ? (size_t)ftell(h->file) : 0;
+}
+
+bool File::seek(uint32_t pos, SeekMode mode)
+{
+    return h && h->file && fseek(h->file, pos, mode == SeekSet ? SEEK_SET : mode == SeekCur ? SEEK_CUR : SEEK_END) == 0;
+}
+
+int File::available()
+{
+    if (!h || !h->file) {
+        return 0;
+    }
+    const size_t sz = size();
+    const size_t pos = position();
+    return pos < sz ? (int)(sz - pos) : 0;
+}
+
+int File::read()
+{
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int File::peek()
+{
+    if (!h || !h->file) {
+        return -1;
+    }
+    const int c = fgetc(h->file);
+    if (c != EOF) {
+        ungetc(c, h->file);
+    }
+    return c == EOF ? -1 : c;
+}
+
+size_t File::read(uint8_t *buf, size_t size)
+{
+    return (h && h->file) ? fread(buf, 1, size, h->file) : 0;
+}
+
+size_t File::write(const uint8_t *buf, size_t size)
+{
+    return (h && h->file) ? fwrite(buf, 1, size, h->file) : 0;
+}
+
+size_t File::print(const char *s)
+{
+    return write((const uint8_t *)s, strlen(s));
+}
+
+void File::flush()
+{
+    if (h && h->file) {
+        fflush(h->file);
+    }
+}
+
+void File::close()
+{
+    h.reset();
+}
+
+bool File::isDirectory() const
+{
+    return h && h->dir;
+}
+
+File File::openNextFile(const char *mode)
+{
+    if (!h || !h->dir) {
+        return File();
+    }
+    struct dirent *e;
+    while ((e = readdir(h->dir)) != nullptr) {
+        if (strcmp(e->d_name, ".") != 0 && strcmp(e->d_name, "..") != 0) {
+            const std::string sep = (vpath_.empty() || vpath_.back() != '/') ? "/" : "";
+            return File(h->host_path + "/" + e->d_name, vpath_ + sep + e->d_name, mode);
+        }
+    }
+    return File();
+}
+
+void File::rewindDirectory()
+{
+    if (h && h->dir) {
+        rewinddir(h->dir);
+    }
+}
+
+std::string FS::hostPath(const char *path) const
+{
+    if (root.empty()) {
+        /* Not mounted: nothing exists */
+        return std::string();
+    }
+    std::string p = path ? path : "";
+    if (p.empty() || p[0] != '/') {
+        p = "/" + p;
+    }
+    return root + p;
+}
+
+File FS::open(const char *path, const char *mode, bool create)
+{
+    return File(hostPath(path), path, mode);
+}
+
+bool FS::exists(const char *path)
+{
+    struct stat st;
+    return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char *path)
+{
+    return unlink(hostPath(path).c_str()) == 0;
+}
+
+bool FS::rename(const char *from, const char *to)
+{
+    return ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0;
+}
+
+bool FS::mkdir(const char *path)
+{
+    return ::mkdir(hostPath(path).c_str(), 0777) == 0 || errno == EEXIST;
+}
+
+bool FS::rmdir(const char *path)
+{
+    return ::rmdir(hostPath(path).c_str()) == 0;
+}
+
+bool SDFS::begin(uint8_t ssPin)
+{
+    const char *env = getenv("CHINSCREEN_SD_ROOT");
+    root = (env && env[0]) ? env : "sd";
+    while (root.size() > 1 && root.back() == '/') {
+        root.pop_back();
+    }
+    struct stat st;
+    return stat(root.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+void SDFS::end()
+{
+    root.clear();
+}
+
+sdcard_type_t SDFS::cardType()
+{
+    return root.empty() ? CARD_NONE : CARD_SDHC;
+}
+
+uint64_t SDFS::cardSize() { return 32ULL * 1024 * 1024 * 1024; }
+uint64_t SDFS::totalBytes() { return cardSize(); }
+uint64_t SDFS::usedBytes() { return 0; }
+
+} // namespace fs
@@ -0,0 +1,734 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host build: esp_bsp.c and lv_port.c on top of pthreads and a headless panel
+ *
+ * LVGL runs in its own thread behind a recursive mutex like the LVGL task on the device. The
+ * flush path is the one of lv_port.c without DMA: areas are rotated into a transport buffer in
+ * trans_size chunks and handed to a panel that speaks the AXS15231B memory write commands.
+ */
+
+#define _GNU_SOURCE
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "esp_check.h"
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "lv_port.h"
+#include "lv_port_area.h"
+#include "lv_port_fb.h"
+#include "lv_port_mem.h"
+#include "lv_port_perf.h"
+#include "lv_port_ramwr.h"
+#include "lv_port_rotate.h"
+#include "display.h"
+#include "esp_bsp.h"
+#include "chinScreen_host.h"
+
+static const char *TAG = "host";
+
+#define HOST_ALIGN4(size)   (((size) + 3) & ~(size_t)3)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+struct esp_lcd_panel_t {
+    lvgl_port_fb_t fb;          /* Frame memory and command decoder */
+    lvgl_port_ramwr_t ramwr;    /* RAMWR/RAMWRC choice, shared with the panel driver */
+    uint16_t *pixels;
+};
+
+struct esp_lcd_panel_io_t {
+    struct esp_lcd_panel_t *panel;
+};
+
+typedef struct {
+    pthread_mutex_t     lvgl_mux;
+    pthread_t           task;
+    atomic_bool         running;
+    bool                initialized;
+    int                 task_max_sleep_ms;
+    uint32_t            tick_ms;    /* Milliseconds already passed to lv_tick_inc() */
+} host_port_ctx_t;
+
+typedef struct {
+    esp_lcd_panel_handle_t    panel_handle;
+    lv_disp_drv_t             disp_drv;
+    uint32_t                  trans_size;
+    lv_color_t                *trans_buf;
+    lv_disp_rot_t             sw_rotate;
+    int64_t                   render_start_us;
+    uint32_t                  render_blocked_us;
+} host_display_ctx_t;
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+
+static host_port_ctx_t host_port_ctx = {
+    .lvgl_mux = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP,
+};
+static int64_t host_start_us;
+static struct esp_lcd_panel_t *panel_handle;
+static struct esp_lcd_panel_io_t panel_io;
+static lv_disp_t *disp;
+static lv_indev_t *disp_indev;
+static int brightness = 0;
+
+static struct {
+    int x;
+    int y;
+    bool pressed;
+} host_touch;           /* Read by LVGL, so only touched with the LVGL lock held */
+
+/*******************************************************************************
+* ESP-IDF stand-ins
+*******************************************************************************/
+
+static int64_t host_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+__attribute__((constructor)) static void host_start(void)
+{
+    host_start_us = host_now_us();
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return host_now_us() - host_start_us;
+}
+
+uint32_t esp_log_timestamp(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code) {
+    case ESP_OK:
+        return "ESP_OK";
+    case ESP_FAIL:
+        return "ESP_FAIL";
+    case ESP_ERR_NO_MEM:
+        return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:
+        return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE:
+        return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_INVALID_SIZE:
+        return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_NOT_FOUND:
+        return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_NOT_SUPPORTED:
+        return "ESP_ERR_NOT_SUPPORTED";
+    case ESP_ERR_TIMEOUT:
+        return "ESP_ERR_TIMEOUT";
+    default:
+        return "UNKNOWN ERROR";
+    }
+}
+
+static void host_sleep_ms(uint32_t ms)
+{
+    struct timespec ts = {
+        .tv_sec = ms / 1000,
+        .tv_nsec = (long)(ms % 1000) * 1000000,
+    };
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+    }
+}
+
+/*******************************************************************************
+* Panel
+*******************************************************************************/
+
+static void panel_tx_window(struct esp_lcd_panel_t *panel, int cmd, int start, int end)
+{
+    const uint8_t param[4] = {
+        (start >> 8) & 0xFF,
+        start & 0xFF,
+        ((end - 1) >> 8) & 0xFF,
+        (end - 1) & 0xFF,
+    };
+    lvgl_port_fb_tx_param(&panel->fb, cmd, param, sizeof(param));
+}
+
+/* The QSPI path of panel_axs15231b_draw_bitmap() (end exclusive) */
+static void panel_draw_bitmap(struct esp_lcd_panel_t *panel, int x_start, int y_start, int x_end, int y_end, const void *color_data)
+{
+    panel_tx_window(panel, LVGL_PORT_FB_CMD_CASET, x_start, x_end);
+
+    lvgl_port_ramwr_op_t op = lvgl_port_ramwr_next(&panel->ramwr, x_start, y_start, x_end, y_end);
+    if (op.raset) {
+        panel_tx_window(panel, LVGL_PORT_FB_CMD_RASET, y_start, y_end);
+    }
+
+    const size_t len = (size_t)(x_end - x_start) * (y_end - y_start) * BSP_LCD_BITS_PER_PIXEL / 8;
+    lvgl_port_fb_tx_color(&panel->fb, op.continuation ? LVGL_PORT_FB_CMD_RAMWRC : LVGL_PORT_FB_CMD_RAMWR, color_data, len);
+}
+
+esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_handle_t *ret_panel, esp_lcd_panel_io_handle_t *ret_io)
+{
+    esp_err_t ret = ESP_OK;
+    assert(config != NULL && config->max_transfer_sz > 0);
+    struct esp_lcd_panel_t *panel = NULL;
+
+    panel = calloc(1, sizeof(struct esp_lcd_panel_t));
+    ESP_GOTO_ON_FALSE(panel, ESP_ERR_NO_MEM, err, TAG, "no mem for panel");
+    panel->pixels = malloc(EXAMPLE_LCD_QSPI_H_RES * EXAMPLE_LCD_QSPI_V_RES * sizeof(uint16_t));
+    ESP_GOTO_ON_FALSE(panel->pixels, ESP_ERR_NO_MEM, err, TAG, "no mem for frame memory");
+
+    lvgl_port_fb_init(&panel->fb, panel->pixels, EXAMPLE_LCD_QSPI_H_RES, EXAMPLE_LCD_QSPI_V_RES);
+    lvgl_port_ramwr_init(&panel->ramwr);
+    lvgl_port_fb_tx_param(&panel->fb, LVGL_PORT_FB_CMD_DISPON, NULL, 0);
+
+    panel_io.panel = panel;
+    *ret_panel = panel;
+    if (ret_io) {
+        *ret_io = &panel_io;
+    }
+    return ESP_OK;
+
+err:
+    if (panel) {
+        free(panel->pixels);
+        free(panel);
+    }
+    return ret;
+}
+
+/*******************************************************************************
+* LVGL port
+*******************************************************************************/
+
+/* Called with the LVGL lock held */
+static void lvgl_port_tick_update(void)
+{
+    const uint32_t now_ms = esp_log_timestamp();
+    if (now_ms != host_port_ctx.tick_ms) {
+        lv_tick_inc(now_ms - host_port_ctx.tick_ms);
+        host_port_ctx.tick_ms = now_ms;
+    }
+}
+
+static void *lvgl_port_task(void *arg)
+{
+    uint32_t task_delay_ms = host_port_ctx.task_max_sleep_ms;
+
+    ESP_LOGI(TAG, "Starting LVGL task");
+    while (host_port_ctx.running) {
+        if (lvgl_port_lock(0)) {
+            task_delay_ms = lv_timer_handler();
+            lvgl_port_unlock();
+        }
+        if (task_delay_ms > host_port_ctx.task_max_sleep_ms) {
+            task_delay_ms = host_port_ctx.task_max_sleep_ms;
+        } else if (task_delay_ms < 1) {
+            task_delay_ms = 1;
+        }
+        lvgl_port_perf_record(LVGL_PORT_PERF_SLEEP_MS, task_delay_ms);
+        host_sleep_ms(task_delay_ms);
+    }
+    return NULL;
+}
+
+esp_err_t lvgl_port_init(const lvgl_port_cfg_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(cfg, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    ESP_RETURN_ON_FALSE(!host_port_ctx.initialized, ESP_ERR_INVALID_STATE, TAG, "already initialized");
+
+    lv_init();
+    host_port_ctx.tick_ms = esp_log_timestamp();
+    host_port_ctx.task_max_sleep_ms = cfg->task_max_sleep_ms > 0 ? cfg->task_max_sleep_ms : 500;
+    host_port_ctx.initialized = true;
+    host_port_ctx.running = true;
+    if (pthread_create(&host_port_ctx.task, NULL, lvgl_port_task, NULL) != 0) {
+        host_port_ctx.running = false;
+        host_port_ctx.initialized = false;
+        ESP_LOGE(TAG, "Create LVGL task fail!");
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_deinit(void)
+{
+    if (host_port_ctx.running) {
+        host_port_ctx.running = false;
+        pthread_join(host_port_ctx.task, NULL);
+    }
+    host_port_ctx.initialized = false;
+    return ESP_OK;
+}
+
+bool lvgl_port_lock(uint32_t timeout_ms)
+{
+    assert(host_port_ctx.initialized && "lvgl_port_init must be called first");
+
+    const int64_t start_us = esp_timer_get_time();
+    if (timeout_ms == 0) {
+        pthread_mutex_lock(&host_port_ctx.lvgl_mux);
+    } else {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_sec += timeout_ms / 1000;
+        ts.tv_nsec += (long)(timeout_ms % 1000) * 1000000;
+        if (ts.tv_nsec >= 1000000000) {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000;
+        }
+        if (pthread_mutex_timedlock(&host_port_ctx.lvgl_mux, &ts) != 0) {
+            return false;
+        }
+    }
+    /* There is no tick timer: whoever takes the lock brings LVGL's clock up to date */
+    lvgl_port_tick_update();
+    lvgl_port_perf_record(LVGL_PORT_PERF_LOCK_WAIT_US, (uint32_t)(esp_timer_get_time() - start_us));
+    return true;
+}
+
+void lvgl_port_unlock(void)
+{
+    assert(host_port_ctx.initialized && "lvgl_port_init must be called first");
+    pthread_mutex_unlock(&host_port_ctx.lvgl_mux);
+}
+
+void lvgl_port_flush_ready(lv_disp_t *disp)
+{
+    assert(disp);
+    assert(disp->driver);
+    lv_disp_flush_ready(disp->driver);
+}
+
+static void lvgl_port_flush_area(host_display_ctx_t *disp_ctx, lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    const int x_start = area->x1;
+    const int x_end = area->x2;
+    const int y_start = area->y1;
+    const int y_end = area->y2;
+    const int width = x_end - x_start + 1;
+    const int height = y_end - y_start + 1;
+    const lv_disp_rot_t rotate = disp_ctx->sw_rotate;
+
+    const bool last_area = lv_disp_flush_is_last(drv);
+    const int64_t flush_start_us = esp_timer_get_time();
+
+    if (!disp_ctx->trans_size) {
+        lvgl_port_perf_add(LVGL_PORT_PERF_TX_BYTES, width * height * sizeof(lv_color_t));
+        panel_draw_bitmap(disp_ctx->panel_handle, x_start, y_start, x_end + 1, y_end + 1, color_map);
+    } else if (LV_DISP_ROT_90 == rotate || LV_DISP_ROT_270 == rotate) {
+        /* Column chunks, in the order that walks the panel rows downwards */
+        const int max_width = LV_MIN(width, (int)(disp_ctx->trans_size / height));
+        assert(max_width > 0);
+        for (int done = 0; done < width; done += max_width) {
+            const int w = LV_MIN(max_width, width - done);
+            const int cx1 = (LV_DISP_ROT_90 == rotate) ? (x_start + done) : (x_end - done - w + 1);
+            const int cx2 = cx1 + w - 1;
+            lvgl_port_rotate_copy(disp_ctx->trans_buf, color_map + (cx1 - x_start), w, height, width, rotate);
+            if (LV_DISP_ROT_90 == rotate) {
+                panel_draw_bitmap(disp_ctx->panel_handle, drv->ver_res - y_end - 1, cx1, drv->ver_res - y_start, cx2 + 1, disp_ctx->trans_buf);
+            } else {
+                panel_draw_bitmap(disp_ctx->panel_handle, y_start, drv->hor_res - cx2 - 1, y_end + 1, drv->hor_res - cx1, disp_ctx->trans_buf);
+            }
+            lvgl_port_perf_add(LVGL_PORT_PERF_TX_BYTES, w * height * sizeof(lv_color_t));
+        }
+    } else {
+        /* Row chunks, bottom up for 180 so the panel rows are still written downwards */
+        const int max_height = LV_MIN(height, (int)(disp_ctx->trans_size / width));
+        assert(max_height > 0);
+        for (int done = 0; done < height; done += max_height) {
+            const int h = LV_MIN(max_height, height - done);
+            const int cy1 = (LV_DISP_ROT_NONE == rotate) ? (y_start + done) : (y_end - done - h + 1);
+            const int cy2 = cy1 + h - 1;
+            lvgl_port_rotate_copy(disp_ctx->trans_buf, color_map + (cy1 - y_start) * width, width, h, width, rotate);
+            if (LV_DISP_ROT_NONE == rotate) {
+                panel_draw_bitmap(disp_ctx->panel_handle, x_start, cy1, x_end + 1, cy2 + 1, disp_ctx->trans_buf);
+            } else {
+                panel_draw_bitmap(disp_ctx->panel_handle, drv->hor_res - x_end - 1, drv->ver_res - cy2 - 1,
+                                  drv->hor_res - x_start, drv->ver_res - cy1, disp_ctx->trans_buf);
+            }
+            lvgl_port_perf_add(LVGL_PORT_PERF_TX_BYTES, width * h * sizeof(lv_color_t));
+        }
+    }
+
+    lvgl_port_perf_add(LVGL_PORT_PERF_FLUSH_US, (uint32_t)(esp_timer_get_time() - flush_start_us));
+    if (last_area) {
+        lvgl_port_perf_commit(LVGL_PORT_PERF_FLUSH_US);
+        lvgl_port_perf_commit(LVGL_PORT_PERF_TE_WAIT_US);
+        lvgl_port_perf_commit(LVGL_PORT_PERF_TX_BYTES);
+    }
+}
+
+static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    host_display_ctx_t *disp_ctx = (host_display_ctx_t *)drv->user_data;
+    assert(disp_ctx != NULL);
+    const int64_t start_us = esp_timer_get_time();
+
+    lvgl_port_flush_area(disp_ctx, drv, area, color_map);
+    lv_disp_flush_ready(drv);
+    disp_ctx->render_blocked_us += (uint32_t)(esp_timer_get_time() - start_us);
+}
+
+static void lvgl_port_rounder_callback(lv_disp_drv_t *drv, lv_area_t *area)
+{
+    host_display_ctx_t *disp_ctx = (host_display_ctx_t *)drv->user_data;
+    assert(disp_ctx != NULL);
+
+    lvgl_port_area_round(area, drv->hor_res, drv->ver_res, disp_ctx->sw_rotate);
+}
+
+static void lvgl_port_render_start_callback(lv_disp_drv_t *drv)
+{
+    host_display_ctx_t *disp_ctx = (host_display_ctx_t *)drv->user_data;
+    assert(disp_ctx != NULL);
+
+    disp_ctx->render_start_us = esp_timer_get_time();
+    disp_ctx->render_blocked_us = 0;
+}
+
+static void lvgl_port_monitor_callback(lv_disp_drv_t *drv, uint32_t time, uint32_t px)
+{
+    host_display_ctx_t *disp_ctx = (host_display_ctx_t *)drv->user_data;
+    assert(disp_ctx != NULL);
+
+    const int64_t elapsed_us = esp_timer_get_time() - disp_ctx->render_start_us;
+    const int64_t render_us = elapsed_us - disp_ctx->render_blocked_us;
+    lvgl_port_perf_record(LVGL_PORT_PERF_RENDER_US, render_us > 0 ? (uint32_t)render_us : 0);
+
+    const lv_refr_stat_t *stat = lv_refr_get_stat();
+    lvgl_port_perf_record(LVGL_PORT_PERF_AREAS, stat->area_num);
+    lvgl_port_perf_record(LVGL_PORT_PERF_PIXELS, px);
+}
+
+lv_disp_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg)
+{
+    esp_err_t ret = ESP_OK;
+    lv_disp_t *new_disp = NULL;
+    lv_color_t *buf1 = NULL;
+    lv_color_t *buf2 = NULL;
+    lv_disp_draw_buf_t *disp_buf = NULL;
+    host_display_ctx_t *disp_ctx = NULL;
+
+    assert(disp_cfg != NULL);
+    assert(disp_cfg->panel_handle != NULL);
+    assert(disp_cfg->buffer_size > 0);
+    assert(disp_cfg->hres > 0);
+    assert(disp_cfg->vres > 0);
+
+    /* Same checks as on the device, so a configuration that fails there fails here */
+    lvgl_port_mem_plan_t plan;
+    const lvgl_port_mem_cfg_t plan_cfg = {
+        .hres = disp_cfg->hres,
+        .vres = disp_cfg->vres,
+        .bytes_per_pixel = sizeof(lv_color_t),
+        .buffer_size = disp_cfg->buffer_size,
+        .double_buffer = disp_cfg->double_buffer,
+        .buff_caps = disp_cfg->flags.buff_dma ? LVGL_PORT_MEM_DMA :
+        disp_cfg->flags.buff_spiram ? LVGL_PORT_MEM_PSRAM : LVGL_PORT_MEM_INTERNAL,
+        .trans_size = disp_cfg->trans_size,
+        .sw_rotate = disp_cfg->sw_rotate,
+        .full_refresh = disp_cfg->flags.full_refresh,
+    };
+    ESP_GOTO_ON_FALSE(lvgl_port_mem_plan(&plan_cfg, &plan), ESP_ERR_INVALID_ARG, err, TAG, "Invalid display configuration: %s", plan.error);
+    ESP_LOGI(TAG, "Display buffers: %"PRIu32" B internal (%"PRIu32" B DMA), %"PRIu32" B PSRAM", plan.internal_bytes, plan.dma_bytes, plan.psram_bytes);
+    if (disp_cfg->flags.async_flush) {
+        ESP_LOGW(TAG, "The host panel has no DMA, flushing synchronously");
+    }
+
+    disp_ctx = calloc(1, sizeof(host_display_ctx_t));
+    ESP_GOTO_ON_FALSE(disp_ctx, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for display context allocation!");
+    disp_ctx->panel_handle = disp_cfg->panel_handle;
+    disp_ctx->trans_size = disp_cfg->trans_size;
+    disp_ctx->sw_rotate = disp_cfg->sw_rotate;
+
+    /* 4 byte aligned like heap_caps_malloc(), so the rotation kernels take their fast path */
+    buf1 = aligned_alloc(4, HOST_ALIGN4(disp_cfg->buffer_size * sizeof(lv_color_t)));
+    ESP_GOTO_ON_FALSE(buf1, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (buf1) allocation!");
+    if (disp_cfg->double_buffer) {
+        buf2 = aligned_alloc(4, HOST_ALIGN4(disp_cfg->buffer_size * sizeof(lv_color_t)));
+        ESP_GOTO_ON_FALSE(buf2, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (buf2) allocation!");
+    }
+    if (disp_ctx->trans_size) {
+        disp_ctx->trans_buf = aligned_alloc(4, HOST_ALIGN4(disp_ctx->trans_size * sizeof(lv_color_t)));
+        ESP_GOTO_ON_FALSE(disp_ctx->trans_buf, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for buffer(transport) allocation!");
+    }
+
+    disp_buf = malloc(sizeof(lv_disp_draw_buf_t));
+    ESP_GOTO_ON_FALSE(disp_buf, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL display buffer allocation!");
+    lv_disp_draw_buf_init(disp_buf, buf1, buf2, disp_cfg->buffer_size);
+
+    lv_disp_drv_init(&disp_ctx->disp_drv);
+    disp_ctx->disp_drv.hor_res = disp_cfg->hres;
+    disp_ctx->disp_drv.ver_res = disp_cfg->vres;
+    disp_ctx->disp_drv.flush_cb = lvgl_port_flush_callback;
+    disp_ctx->disp_drv.draw_buf = disp_buf;
+    disp_ctx->disp_drv.user_data = disp_ctx;
+    disp_ctx->disp_drv.full_refresh = disp_cfg->flags.full_refresh;
+    if (!disp_cfg->flags.full_refresh) {
+        disp_ctx->disp_drv.rounder_cb = lvgl_port_rounder_callback;
+    }
+    disp_ctx->disp_drv.render_start_cb = lvgl_port_render_start_callback;
+    disp_ctx->disp_drv.monitor_cb = lvgl_port_monitor_callback;
+
+    new_disp = lv_disp_drv_register(&disp_ctx->disp_drv);
+
+err:
+    if (ret != ESP_OK) {
+        free(buf1);
+        free(buf2);
+        free(disp_buf);
+        if (disp_ctx) {
+            free(disp_ctx->trans_buf);
+            free(disp_ctx);
+        }
+    }
+    return new_disp;
+}
+
+esp_err_t lvgl_port_remove_disp(lv_disp_t *disp)
+{
+    assert(disp);
+    lv_disp_drv_t *disp_drv = disp->driver;
+    assert(disp_drv);
+    host_display_ctx_t *disp_ctx = (host_display_ctx_t *)disp_drv->user_data;
+
+    lv_disp_remove(disp);
+
+    if (disp_drv->draw_buf) {
+        free(disp_drv->draw_buf->buf1);
+        free(disp_drv->draw_buf->buf2);
+        free(disp_drv->draw_buf);
+    }
+    if (disp_ctx) {
+        free(disp_ctx->trans_buf);
+        free(disp_ctx);
+    }
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* BSP
+*******************************************************************************/
+
+esp_err_t bsp_i2c_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t bsp_i2c_deinit(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t bsp_display_brightness_set(int brightness_percent)
+{
+    if (brightness_percent > 100) {
+        brightness_percent = 100;
+    }
+    if (brightness_percent < 0) {
+        brightness_percent = 0;
+    }
+
+    ESP_LOGI(TAG, "Setting LCD backlight: %d%%", brightness_percent);
+    brightness = brightness_percent;
+    return ESP_OK;
+}
+
+esp_err_t bsp_display_backlight_off(void)
+{
+    return bsp_display_brightness_set(0);
+}
+
+esp_err_t bsp_display_backlight_on(void)
+{
+    return bsp_display_brightness_set(100);
+}
+
+esp_err_t bsp_display_get_sync_stats(lvgl_port_te_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    /* The host panel has no TE line */
+    return ESP_ERR_INVALID_STATE;
+}
+
+static void bsp_touch_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data)
+{
+    data->point.x = host_touch.x;
+    data->point.y = host_touch.y;
+    data->state = host_touch.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+static lv_indev_t *bsp_display_indev_init(lv_disp_t *disp)
+{
+    static lv_indev_drv_t indev_drv;
+
+    lv_indev_drv_init(&indev_drv);
+    indev_drv.type = LV_INDEV_TYPE_POINTER;
+    indev_drv.disp = disp;
+    indev_drv.read_cb = bsp_touch_read;
+    return lv_indev_drv_register(&indev_drv);
+}
+
+lv_disp_t *bsp_display_start_with_config(const bsp_display_cfg_t *cfg)
+{
+    esp_lcd_panel_io_handle_t io_handle = NULL;
+    const uint32_t hres = EXAMPLE_LCD_QSPI_H_RES;
+    const uint32_t vres = EXAMPLE_LCD_QSPI_V_RES;
+
+    if (lvgl_port_init(&cfg->lvgl_port_cfg) != ESP_OK) {
+        return NULL;
+    }
+
+    const bsp_display_config_t bsp_disp_cfg = {
+        .max_transfer_sz = hres * vres * sizeof(uint16_t),
+    };
+    if (bsp_display_new(&bsp_disp_cfg, &panel_handle, &io_handle) != ESP_OK) {
+        return NULL;
+    }
+
+    lvgl_port_display_cfg_t disp_cfg = {
+        .io_handle = io_handle,
+        .panel_handle = panel_handle,
+        .buffer_size = cfg->buffer_size,
+        .double_buffer = cfg->double_buffer,
+        .sw_rotate = cfg->rotate,
+        .hres = hres,
+        .vres = vres,
+        .trans_size = cfg->trans_size,
+        .flags = {
+            .buff_dma = cfg->flags.buff_dma,
+            .buff_spiram = cfg->flags.buff_spiram,
+            .buff_internal = cfg->flags.buff_internal,
+            .full_refresh = cfg->flags.full_refresh,
+            .async_flush = cfg->flags.async_flush,
+        },
+    };
+    if (disp_cfg.sw_rotate == LV_DISP_ROT_90 || disp_cfg.sw_rotate == LV_DISP_ROT_270) {
+        disp_cfg.hres = vres;
+        disp_cfg.vres = hres;
+    }
+
+    lvgl_port_lock(0);
+    disp = lvgl_port_add_disp(&disp_cfg);
+    if (disp) {
+        disp_indev = bsp_display_indev_init(disp);
+    }
+    lvgl_port_unlock();
+    return disp;
+}
+
+lv_indev_t *bsp_display_get_input_dev(void)
+{
+    return disp_indev;
+}
+
+bool bsp_display_lock(uint32_t timeout_ms)
+{
+    return lvgl_port_lock(timeout_ms);
+}
+
+void bsp_display_unlock(void)
+{
+    lvgl_port_unlock();
+}
+
+/*******************************************************************************
+* chinScreen_host.h
+*******************************************************************************/
+
+const uint16_t *chinScreen_host_framebuffer(int *hres, int *vres)
+{
+    if (!panel_handle) {
+        return NULL;
+    }
+    if (hres) {
+        *hres = panel_handle->fb.hres;
+    }
+    if (vres) {
+        *vres = panel_handle->fb.vres;
+    }
+    return panel_handle->pixels;
+}
+
+const lvgl_port_fb_stats_t *chinScreen_host_panel_stats(void)
+{
+    static const lvgl_port_fb_stats_t none;
+    return panel_handle ? &panel_handle->fb.stats : &none;
+}
+
+int chinScreen_host_brightness(void)
+{
+    return brightness;
+}
+
+void chinScreen_host_refresh(void)
+{
+    if (!disp) {
+        return;
+    }
+    lvgl_port_lock(0);
+    lv_refr_now(disp);
+    lvgl_port_unlock();
+}
+
+bool chinScreen_host_save_ppm(const char *path)
+{
+    if (!panel_handle) {
+        return false;
+    }
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        ESP_LOGE(TAG, "Cannot open %s", path);
+        return false;
+    }
+
+    /* The panel is written under the LVGL lock, so this reads a complete frame */
+    lvgl_port_lock(0);
+    const lvgl_port_fb_t *fb = &panel_handle->fb;
+    fprintf(f, "P6\n%d %d\n255\n", fb->hres, fb->vres);
+    for (int i = 0; i < fb->hres * fb->vres; i++) {
+        uint16_t c = fb->display_on ? fb->pixels[i] : 0;
+        if (fb->inverted) {
+            c = ~c;
+        }
+        const uint8_t rgb[3] = {
+            (uint8_t)(((c >> 11) & 0x1F) * 255 / 31),
+            (uint8_t)(((c >> 5) & 0x3F) * 255 / 63),
+            (uint8_t)((c & 0x1F) * 255 / 31),
+        };
+        fwrite(rgb, 1, sizeof(rgb), f);
+    }
+    lvgl_port_unlock();
+
+    return fclose(f) == 0;
+}
+
+void chinScreen_host_touch(int x, int y, bool pressed)
+{
+    lvgl_port_lock(0);
+    host_touch.x = x;
+    host_touch.y = y;
+    host_touch.pressed = pressed;
+    lvgl_port_unlock();
+}
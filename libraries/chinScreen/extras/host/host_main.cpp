@@ -0,0 +1,85 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host build: run a sketch's setup() and loop() for a while, then save the screen
+ *
+ *   chinScreen_host [--ms 3000] [--out screen.ppm] [--sd ./sd] [--perf]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Arduino.h"
+#include "esp_bsp.h"
+#include "lv_port.h"
+#include "lv_port_perf.h"
+#include "chinScreen_host.h"
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr, "usage: %s [--ms run_time] [--out screen.ppm] [--sd sd_root] [--perf]\n", argv0);
+}
+
+static void print_perf(void)
+{
+    printf("%-12s %8s %10s %10s %10s %10s\n", "metric", "samples", "min", "avg", "max", "p99");
+    for (int m = 0; m < LVGL_PORT_PERF_MAX; m++) {
+        lvgl_port_perf_summary_t s;
+        if (lvgl_port_perf_get((lvgl_port_perf_metric_t)m, &s)) {
+            printf("%-12s %8u %10u %10u %10u %10u\n", lvgl_port_perf_name((lvgl_port_perf_metric_t)m),
+                   (unsigned)s.count, (unsigned)s.min, (unsigned)s.avg, (unsigned)s.max, (unsigned)s.p99);
+        }
+    }
+
+    const lvgl_port_fb_stats_t *fb = chinScreen_host_panel_stats();
+    printf("panel: %u CASET, %u RASET, %u RAMWR, %u RAMWRC, %u px\n",
+           (unsigned)fb->caset, (unsigned)fb->raset, (unsigned)fb->ramwr, (unsigned)fb->ramwrc, (unsigned)fb->pixels);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long run_ms = 3000;
+    const char *out = NULL;
+    bool perf = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--ms") && i + 1 < argc) {
+            run_ms = strtoul(argv[++i], NULL, 10);
+        } else if (!strcmp(argv[i], "--out") && i + 1 < argc) {
+            out = argv[++i];
+        } else if (!strcmp(argv[i], "--sd") && i + 1 < argc) {
+            setenv("CHINSCREEN_SD_ROOT", argv[++i], 1);
+        } else if (!strcmp(argv[i], "--perf")) {
+            perf = true;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    setup();
+    while (millis() < run_ms) {
+        loop();
+    }
+
+    /* Whatever is still invalidated, so the picture matches the last state of the UI */
+    chinScreen_host_refresh();
+
+    if (perf) {
+        print_perf();
+    }
+
+    int ret = 0;
+    if (out && !chinScreen_host_save_ppm(out)) {
+        fprintf(stderr, "failed to write %s\n", out);
+        ret = 1;
+    }
+    lvgl_port_deinit();
+    return ret;
+}
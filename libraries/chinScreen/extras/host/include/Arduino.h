@@ -0,0 +1,177 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host build: the part of the Arduino core the chinScreen headers and examples use
+ *
+ * Serial reads stdin and writes stdout, time comes from CLOCK_MONOTONIC, pins do nothing.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+#include <algorithm>
+#include <string>
+
+extern "C" {
+#endif
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH            0x1
+#define LOW             0x0
+#define INPUT           0x01
+#define OUTPUT          0x03
+#define INPUT_PULLUP    0x05
+
+#define PI              3.1415926535897932384626433832795
+#define HALF_PI         1.5707963267948966192313216916398
+#define TWO_PI          6.283185307179586476925286766559
+#define DEG_TO_RAD      0.017453292519943295769236907684886
+#define RAD_TO_DEG      57.295779513082320876798154814105
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield(void);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+
+#ifdef __cplusplus
+}
+
+using std::min;
+using std::max;
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+template<typename T, typename L, typename H>
+inline T constrain(T amt, L low, H high)
+{
+    return (amt < low) ? low : ((amt > high) ? high : amt);
+}
+
+/**
+ * @brief Arduino String, enough for command parsing in sketches
+ */
+class String {
+public:
+    String(const char *s = "") : str(s ? s : "") {}
+    String(const std::string &s) : str(s) {}
+    String(char c) : str(1, c) {}
+    String(int v) : str(std::to_string(v)) {}
+    String(unsigned int v) : str(std::to_string(v)) {}
+    String(long v) : str(std::to_string(v)) {}
+    String(unsigned long v) : str(std::to_string(v)) {}
+    String(double v, unsigned int decimals = 2);
+
+    const char *c_str() const { return str.c_str(); }
+    unsigned int length() const { return (unsigned int)str.length(); }
+    char charAt(unsigned int i) const { return i < str.length() ? str[i] : 0; }
+    char operator[](unsigned int i) const { return charAt(i); }
+    int indexOf(char c, unsigned int from = 0) const;
+    int indexOf(const String &s, unsigned int from = 0) const;
+    String substring(unsigned int from) const;
+    String substring(unsigned int from, unsigned int to) const;
+    bool startsWith(const String &s) const { return str.compare(0, s.str.length(), s.str) == 0; }
+    bool endsWith(const String &s) const;
+    bool equals(const String &s) const { return str == s.str; }
+    bool equalsIgnoreCase(const String &s) const;
+    long toInt() const { return atol(str.c_str()); }
+    float toFloat() const { return (float)atof(str.c_str()); }
+    void trim();
+    void toLowerCase();
+    void toUpperCase();
+
+    String &operator+=(const String &s) { str += s.str; return *this; }
+    friend String operator+(const String &a, const String &b) { return String(a.str + b.str); }
+    bool operator==(const String &s) const { return str == s.str; }
+    bool operator!=(const String &s) const { return str != s.str; }
+    bool operator<(const String &s) const { return str < s.str; }
+
+private:
+    std::string str;
+};
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+/**
+ * @brief Print/Stream on top of stdio
+ */
+class HardwareSerial {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    void end() {}
+    operator bool() const { return true; }
+
+    size_t write(uint8_t c);
+    size_t write(const uint8_t *buf, size_t size);
+    size_t print(const char *s);
+    size_t print(const String &s) { return print(s.c_str()); }
+    size_t print(char c);
+    size_t print(long n, int base = DEC);
+    size_t print(unsigned long n, int base = DEC);
+    size_t print(int n, int base = DEC) { return print((long)n, base); }
+    size_t print(unsigned int n, int base = DEC) { return print((unsigned long)n, base); }
+    size_t print(double n, int digits = 2);
+    size_t println(void);
+    template<typename T>
+    size_t println(T v) { return print(v) + println(); }
+    template<typename T>
+    size_t println(T v, int format) { return print(v, format) + println(); }
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+    void flush();
+
+    int available();
+    int read();
+    int peek();
+    String readString();
+    String readStringUntil(char terminator);
+    void setTimeout(unsigned long ms) { (void)ms; }
+};
+
+extern HardwareSerial Serial;
+
+/**
+ * @brief The few ESP.* calls the examples make
+ */
+class EspClass {
+public:
+    uint32_t getFreeHeap();
+    uint32_t getHeapSize();
+    uint32_t getFreePsram();
+    uint32_t getPsramSize();
+    void restart();
+};
+
+extern EspClass ESP;
+
+/* Implemented by the sketch */
+void setup(void);
+void loop(void);
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host build: Arduino FS File on top of stdio and dirent
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <memory>
+#include <string>
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+enum SeekMode {
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2,
+};
+
+/**
+ * @brief An open file or directory; copies share the underlying handle like on the device
+ */
+class File {
+public:
+    File() {}
+    File(const std::string &host_path, const std::string &vpath, const char *mode);
+
+    operator bool() const;
+    size_t size() const;
+    size_t position() const;
+    bool seek(uint32_t pos, SeekMode mode = SeekSet);
+    int available();
+    int read();
+    int peek();
+    size_t read(uint8_t *buf, size_t size);
+    size_t readBytes(char *buf, size_t size) { return read((uint8_t *)buf, size); }
+    size_t write(uint8_t c) { return write(&c, 1); }
+    size_t write(const uint8_t *buf, size_t size);
+    size_t print(const char *s);
+    void flush();
+    void close();
+    const char *name() const { return name_.c_str(); }
+    const char *path() const { return vpath_.c_str(); }
+    bool isDirectory() const;
+    File openNextFile(const char *mode = FILE_READ);
+    void rewindDirectory();
+
+private:
+    struct Handle;
+    std::shared_ptr<Handle> h;
+    std::string vpath_;     /* Path on the card */
+    std::string name_;
+};
+
+/**
+ * @brief A directory of the host file system standing in for the SD card
+ */
+class FS {
+public:
+    File open(const char *path, const char *mode = FILE_READ, bool create = false);
+    File open(const std::string &path, const char *mode = FILE_READ) { return open(path.c_str(), mode); }
+    bool exists(const char *path);
+    bool remove(const char *path);
+    bool rename(const char *from, const char *to);
+    bool mkdir(const char *path);
+    bool rmdir(const char *path);
+
+    /* Host path of a path on the card */
+    std::string hostPath(const char *path) const;
+
+protected:
+    std::string root;
+};
+
+} // namespace fs
+
+using fs::FS;
+using fs::File;
+using fs::SeekMode;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
@@ -0,0 +1,64 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host build: look at and poke the simulated panel
+ *
+ * The host backend replaces esp_bsp.c and lv_port.c. Its panel is an lvgl_port_fb_t fed with the
+ * same CASET/RASET/RAMWR/RAMWRC sequence the AXS15231B driver sends, so what ends up in the
+ * framebuffer is what the device would show.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lv_port_fb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Panel frame memory, row major RGB565 in native byte order, in panel (unrotated) orientation
+ *
+ * @param[out] hres Panel width, may be NULL
+ * @param[out] vres Panel height, may be NULL
+ *
+ * @return Pixels, or NULL before bsp_display_start_with_config()
+ */
+const uint16_t *chinScreen_host_framebuffer(int *hres, int *vres);
+
+/**
+ * @brief Commands and pixels the panel received since start
+ */
+const lvgl_port_fb_stats_t *chinScreen_host_panel_stats(void);
+
+/**
+ * @brief Backlight brightness last set, in percent
+ */
+int chinScreen_host_brightness(void);
+
+/**
+ * @brief Render and send everything LVGL has invalidated, without waiting for the LVGL task
+ */
+void chinScreen_host_refresh(void);
+
+/**
+ * @brief Save the panel as a binary PPM (P6)
+ *
+ * @return true if the file was written
+ */
+bool chinScreen_host_save_ppm(const char *path);
+
+/**
+ * @brief Touch input, in LVGL (rotated) coordinates
+ */
+void chinScreen_host_touch(int x, int y, bool pressed);
+
+#ifdef __cplusplus
+}
+#endif
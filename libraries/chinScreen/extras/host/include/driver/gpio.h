@@ -0,0 +1,41 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host build: GPIO numbers and types used in the BSP headers
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int gpio_num_t;
+
+#define GPIO_NUM_NC     (-1)
+#define GPIO_NUM_1      (1)
+#define GPIO_NUM_4      (4)
+#define GPIO_NUM_8      (8)
+#define GPIO_NUM_21     (21)
+#define GPIO_NUM_38     (38)
+#define GPIO_NUM_39     (39)
+#define GPIO_NUM_40     (40)
+#define GPIO_NUM_45     (45)
+#define GPIO_NUM_47     (47)
+#define GPIO_NUM_48     (48)
+
+typedef enum {
+    GPIO_INTR_DISABLE,
+    GPIO_INTR_POSEDGE,
+    GPIO_INTR_NEGEDGE,
+    GPIO_INTR_ANYEDGE,
+    GPIO_INTR_LOW_LEVEL,
+    GPIO_INTR_HIGH_LEVEL,
+} gpio_int_type_t;
+
+#ifdef __cplusplus
+}
+#endif
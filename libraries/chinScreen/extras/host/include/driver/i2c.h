@@ -0,0 +1,12 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host build: there is no I2C bus, bsp_i2c_init() only records the call */
+
+#pragma once
+
+typedef int i2c_port_t;
+
+#define I2C_NUM_0   (0)
+#define I2C_NUM_1   (1)
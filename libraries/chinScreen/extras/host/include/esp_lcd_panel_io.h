@@ -0,0 +1,10 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host build: only the handle types are needed (esp_lcd_touch.h) */
+
+#pragma once
+
+#include "esp_err.h"
+#include "esp_lcd_types.h"
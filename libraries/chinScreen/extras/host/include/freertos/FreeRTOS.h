@@ -0,0 +1,26 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host build: the FreeRTOS types that appear in the BSP headers
+ *
+ * The host backend runs LVGL in a pthread; nothing here schedules anything.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef struct {
+    int owner;
+    int count;
+} portMUX_TYPE;
+
+#define pdTRUE          1
+#define pdFALSE         0
+#define portMAX_DELAY   UINT32_MAX
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(ms))
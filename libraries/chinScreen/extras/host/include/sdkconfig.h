@@ -0,0 +1,7 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host build: no Kconfig options */
+
+#pragma once
@@ -0,0 +1,478 @@
+#!/usr/bin/env python3
+"""Compile PNG/GIF icons into LVGL image descriptors that are drawn without decoding.
+
+    img_compile.py [--cf auto] [--out DIR] [--index] images...
+
+Every image (.png, .gif, or a .inc with the PNG/GIF bytes as a C array, like the ones in
+src/includes/icons) becomes DIR/<name>.inc with a `const lv_img_dsc_t <name>_img` whose pixels are
+already in the display's format: RGB565 with LV_COLOR_16_SWAP applied, plus an alpha byte per
+pixel if the image has transparency. An animated GIF becomes one descriptor per frame,
+`<name>_frames[]`, with `<name>_frame_srcs[]` for lv_animimg and the delays in `<name>_delays_ms[]`.
+
+--index also writes DIR/icons.inc, which includes them all and lists the still images for the
+chinScreen icon registry (see CHINSCREEN_ICONS_NATIVE in the readme).
+
+Color formats (--cf):
+    auto      true_color if the image is opaque, else true_color_alpha (default)
+    true_color, true_color_alpha
+              ready to blit; 2 or 3 bytes per pixel at 16 bit color depth
+    indexed   1, 2, 4 or 8 bit palette, whichever fits the colors; a fraction of the flash,
+              but LVGL looks up the palette on every draw
+    alpha     1, 2, 4 or 8 bit alpha only, drawn in the image recolor color
+
+Needs only the Python standard library.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+
+#####################################################################
+# PNG
+#####################################################################
+
+def png_decode(data):
+    """Decode a PNG into (width, height, [(r, g, b, a), ...])"""
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError('not a PNG')
+    pos = 8
+    idat = b''
+    palette = []
+    trns = None
+    while pos < len(data):
+        length, ctype = struct.unpack('>I4s', data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if ctype == b'IHDR':
+            w, h, depth, color_type, _, _, interlace = struct.unpack('>IIBBBBB', chunk)
+        elif ctype == b'PLTE':
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif ctype == b'tRNS':
+            trns = chunk
+        elif ctype == b'IDAT':
+            idat += chunk
+        elif ctype == b'IEND':
+            break
+    if interlace:
+        raise ValueError('interlaced PNGs are not supported, save it without interlacing')
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+    bpp = max(1, channels * depth // 8)          # bytes per pixel for the filters
+    stride = (w * channels * depth + 7) // 8
+    raw = zlib.decompress(idat)
+
+    rows = []
+    prev = bytearray(stride)
+    for y in range(h):
+        ftype = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if ftype == 1:
+                line[i] = (line[i] + a) & 0xff
+            elif ftype == 2:
+                line[i] = (line[i] + b) & 0xff
+            elif ftype == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xff
+            elif ftype == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                line[i] = (line[i] + pred) & 0xff
+        rows.append(line)
+        prev = line
+
+    def samples(line):
+        """Samples of a row scaled to 8 bit"""
+        if depth == 8:
+            return list(line)
+        if depth == 16:
+            return [line[i] for i in range(0, len(line), 2)]
+        out = []
+        mask = (1 << depth) - 1
+        for byte in line:
+            for shift in range(8 - depth, -1, -depth):
+                out.append((byte >> shift) & mask)
+        return out
+
+    scale = 255 // ((1 << depth) - 1) if depth < 8 else 1
+    px = []
+    for line in rows:
+        s = samples(line)
+        for x in range(w):
+            if color_type == 3:
+                i = s[x]
+                r, g, b = palette[i]
+                a = trns[i] if trns is not None and i < len(trns) else 255
+            elif color_type == 0:
+                v = s[x] * scale if depth < 8 else s[x]
+                r = g = b = v
+                a = 255
+                if trns is not None and s[x] == struct.unpack('>H', trns[:2])[0] >> (16 - depth if depth == 16 else 0):
+                    a = 0
+            elif color_type == 4:
+                r = g = b = s[x * 2]
+                a = s[x * 2 + 1]
+            elif color_type == 2:
+                r, g, b = s[x * 3:x * 3 + 3]
+                a = 255
+                if trns is not None and depth == 8 and (r, g, b) == struct.unpack('>HHH', trns[:6]):
+                    a = 0
+            else:
+                r, g, b, a = s[x * 4:x * 4 + 4]
+            px.append((r, g, b, a))
+    return w, h, px
+
+
+#####################################################################
+# GIF
+#####################################################################
+
+def lzw_decode(data, min_size, count):
+    clear = 1 << min_size
+    stop = clear + 1
+    out = bytearray()
+    table = [bytes([i]) for i in range(clear)] + [b'', b'']
+    size = min_size + 1
+    prev = None
+    bits = 0
+    nbits = 0
+    for byte in data:
+        bits |= byte << nbits
+        nbits += 8
+        while nbits >= size:
+            code = bits & ((1 << size) - 1)
+            bits >>= size
+            nbits -= size
+            if code == clear:
+                table = table[:clear + 2]
+                size = min_size + 1
+                prev = None
+                continue
+            if code == stop:
+                return out[:count]
+            if prev is None:
+                entry = table[code]
+            elif code < len(table):
+                entry = table[code]
+                table.append(prev + entry[:1])
+            else:
+                entry = prev + prev[:1]
+                table.append(entry)
+            out += entry
+            prev = entry
+            if len(table) == (1 << size) and size < 12:
+                size += 1
+    return out[:count]
+
+
+def gif_decode(data):
+    """Decode every frame of a GIF into (width, height, [(pixels, delay_ms), ...])"""
+    if data[:6] not in (b'GIF87a', b'GIF89a'):
+        raise ValueError('not a GIF')
+    w, h, flags, _bg, _aspect = struct.unpack('<HHBBB', data[6:13])
+    pos = 13
+    global_palette = []
+    if flags & 0x80:
+        n = 2 << (flags & 7)
+        global_palette = [tuple(data[pos + i * 3:pos + i * 3 + 3]) for i in range(n)]
+        pos += n * 3
+
+    canvas = [(0, 0, 0, 0)] * (w * h)
+    frames = []
+    delay = 100
+    transparent = None
+    disposal = 0
+    while pos < len(data):
+        block = data[pos]
+        pos += 1
+        if block == 0x21:                              # extension
+            label = data[pos]
+            pos += 1
+            if label == 0xf9:                          # graphic control
+                packed, d, t = struct.unpack('<BHB', data[pos + 1:pos + 5])
+                disposal = (packed >> 2) & 7
+                transparent = t if packed & 1 else None
+                delay = (d or 10) * 10
+            while data[pos]:
+                pos += data[pos] + 1
+            pos += 1
+        elif block == 0x2c:                            # image
+            fx, fy, fw, fh, fflags = struct.unpack('<HHHHB', data[pos:pos + 9])
+            pos += 9
+            palette = global_palette
+            if fflags & 0x80:
+                n = 2 << (fflags & 7)
+                palette = [tuple(data[pos + i * 3:pos + i * 3 + 3]) for i in range(n)]
+                pos += n * 3
+            min_size = data[pos]
+            pos += 1
+            lzw = bytearray()
+            while data[pos]:
+                lzw += data[pos + 1:pos + 1 + data[pos]]
+                pos += data[pos] + 1
+            pos += 1
+            indices = lzw_decode(lzw, min_size, fw * fh)
+
+            rows = list(range(fh))
+            if fflags & 0x40:                          # interlaced
+                rows = list(range(0, fh, 8)) + list(range(4, fh, 8)) + list(range(2, fh, 4)) + list(range(1, fh, 2))
+
+            before = list(canvas)
+            for i, y in enumerate(rows):
+                cy = fy + y
+                if cy >= h:
+                    continue
+                for x in range(fw):
+                    cx = fx + x
+                    k = i * fw + x
+                    if cx >= w or k >= len(indices):
+                        continue
+                    c = indices[k]
+                    if c == transparent or c >= len(palette):
+                        continue
+                    r, g, b = palette[c]
+                    canvas[cy * w + cx] = (r, g, b, 255)
+            frames.append((list(canvas), delay))
+
+            if disposal == 2:                          # back to the (transparent) background
+                for y in range(fy, min(fy + fh, h)):
+                    for x in range(fx, min(fx + fw, w)):
+                        canvas[y * w + x] = (0, 0, 0, 0)
+            elif disposal == 3:                        # back to what was there before
+                canvas = before
+            transparent = None
+            disposal = 0
+            delay = 100
+        elif block == 0x3b:                            # trailer
+            break
+        else:
+            raise ValueError('broken GIF at byte %d' % (pos - 1))
+    return w, h, frames
+
+
+#####################################################################
+# LVGL color formats
+#####################################################################
+
+def rgb565(r, g, b, swap):
+    c = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+    return bytes([c >> 8, c & 0xff]) if swap else bytes([c & 0xff, c >> 8])
+
+
+def color_bytes(r, g, b, depth, swap):
+    if depth == 32:
+        return bytes([b, g, r, 0xff])
+    return rgb565(r, g, b, swap)
+
+
+def pack_bits(values, bits, w):
+    """Rows of `bits` bit values, MSB first, each row starting on a byte"""
+    out = bytearray()
+    for y in range(len(values) // w):
+        acc = 0
+        n = 0
+        for v in values[y * w:(y + 1) * w]:
+            acc = (acc << bits) | v
+            n += bits
+            if n == 8:
+                out.append(acc)
+                acc = n = 0
+        if n:
+            out.append(acc << (8 - n))
+    return bytes(out)
+
+
+def fit_bits(count):
+    for bits in (1, 2, 4, 8):
+        if count <= (1 << bits):
+            return bits
+    return None
+
+
+def encode(px, w, cf, depth, swap):
+    """Pixels in an LVGL color format; returns (cf name, data)"""
+    opaque = all(p[3] == 255 for p in px)
+    if cf == 'auto':
+        cf = 'true_color' if opaque else 'true_color_alpha'
+
+    if cf == 'true_color':
+        return 'LV_IMG_CF_TRUE_COLOR', b''.join(color_bytes(r, g, b, depth, swap) for r, g, b, _ in px)
+
+    if cf == 'true_color_alpha':
+        if depth == 32:
+            return 'LV_IMG_CF_TRUE_COLOR_ALPHA', b''.join(bytes([b, g, r, a]) for r, g, b, a in px)
+        return 'LV_IMG_CF_TRUE_COLOR_ALPHA', b''.join(rgb565(r, g, b, swap) + bytes([a]) for r, g, b, a in px)
+
+    if cf == 'indexed':
+        # Colors as the display shows them, so near duplicates share an entry
+        def key(p):
+            r, g, b, a = p
+            return (0, 0, 0, 0) if a == 0 else (r & 0xf8, g & 0xfc, b & 0xf8, a)
+        palette = []
+        index = {}
+        values = []
+        for p in px:
+            k = key(p)
+            if k not in index:
+                index[k] = len(palette)
+                palette.append(p if p[3] else (0, 0, 0, 0))
+            values.append(index[k])
+        bits = fit_bits(len(palette))
+        if bits is None:
+            raise ValueError('%d colors, too many for an indexed image' % len(palette))
+        palette += [(0, 0, 0, 0)] * ((1 << bits) - len(palette))
+        data = b''.join(bytes([b, g, r, a]) for r, g, b, a in palette)   # lv_color32_t
+        return 'LV_IMG_CF_INDEXED_%dBIT' % bits, data + pack_bits(values, bits, w)
+
+    if cf == 'alpha':
+        levels = sorted(set(p[3] for p in px))
+        bits = fit_bits(len(levels)) if all(a in (0, 255) for a in levels) else 8
+        bits = bits or 8
+        top = (1 << bits) - 1
+        values = [(p[3] * top + 127) // 255 for p in px]
+        return 'LV_IMG_CF_ALPHA_%dBIT' % bits, pack_bits(values, bits, w)
+
+    raise ValueError('unknown color format ' + cf)
+
+
+#####################################################################
+# Output
+#####################################################################
+
+def c_name(path):
+    name = os.path.splitext(os.path.basename(path))[0]
+    name = re.sub(r'[^0-9a-zA-Z_]', '_', name)
+    return '_' + name if name[0].isdigit() else name
+
+
+def load(path):
+    """Bytes of an image file, or of the first C array in a .inc"""
+    with open(path, 'rb') as f:
+        data = f.read()
+    if path.endswith('.inc') or path.endswith('.h'):
+        text = data.decode('latin-1')
+        body = text[text.index('{') + 1:text.index('}')]
+        data = bytes(int(v, 16) for v in re.findall(r'0x([0-9a-fA-F]{1,2})', body))
+    return data
+
+
+def c_array(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append('    ' + ', '.join('0x%02x' % b for b in data[i:i + 16]) + ',')
+    return '\n'.join(lines)
+
+
+def c_dsc(name, cf, w, h, map_name, size):
+    # Positional, so the header compiles as C and C++ alike
+    return ('const lv_img_dsc_t %s = {\n    {%s, 0, 0, %d, %d},\n    %d,\n    %s,\n};\n'
+            % (name, cf, w, h, size, map_name))
+
+
+def depth_check(cfs, depth, swap, out_name):
+    if not any(cf.startswith('LV_IMG_CF_TRUE_COLOR') for cf in cfs):
+        return ''
+    cond = 'LV_COLOR_DEPTH != %d' % depth
+    if depth == 16:
+        cond += ' || LV_COLOR_16_SWAP != %d' % swap
+    return ('#if %s\n#error "%s was made for LV_COLOR_DEPTH %d%s, run extras/img_compile.py again"\n#endif\n\n'
+            % (cond, out_name, depth, ' with LV_COLOR_16_SWAP %d' % swap if depth == 16 else ''))
+
+
+def compile_image(path, args):
+    data = load(path)
+    name = c_name(path)
+    out_name = name + '.inc'
+    header = '// %s - made by extras/img_compile.py from %s, do not edit\n' % (out_name, os.path.basename(path))
+
+    if data[:3] == b'GIF':
+        w, h, frames = gif_decode(data)
+        if not frames:
+            raise ValueError('no frames')
+        encoded = [encode(px, w, args.cf, args.depth, args.swap) for px, _ in frames]
+        cfs = set(cf for cf, _ in encoded)
+        total = sum(len(d) for _, d in encoded)
+        body = [header, '// %dx%d, %d frames, %s, %d bytes (GIF: %d bytes)\n\n'
+                % (w, h, len(frames), '/'.join(sorted(cfs)), total, len(data)),
+                depth_check(cfs, args.depth, args.swap, out_name)]
+        for i, (cf, d) in enumerate(encoded):
+            body.append('static const LV_ATTRIBUTE_LARGE_CONST uint8_t %s_frame_%d_map[] = {\n%s\n};\n\n'
+                        % (name, i, c_array(d)))
+        body.append('const lv_img_dsc_t %s_frames[] = {\n' % name)
+        for i, (cf, d) in enumerate(encoded):
+            body.append('    {{%s, 0, 0, %d, %d}, %d, %s_frame_%d_map},\n' % (cf, w, h, len(d), name, i))
+        body.append('};\n\n')
+        body.append('const void * const %s_frame_srcs[] = {\n' % name)
+        body.append(''.join('    &%s_frames[%d],\n' % (name, i) for i in range(len(frames))))
+        body.append('};\n\n')
+        body.append('const uint16_t %s_delays_ms[] = {%s};\n'
+                    % (name, ', '.join(str(d) for _, d in frames)))
+        body.append('const uint16_t %s_frame_count = %d;\n' % (name, len(frames)))
+        body.append('const uint32_t %s_duration_ms = %d;\n' % (name, sum(d for _, d in frames)))
+        kind = 'anim'
+        size = total
+    else:
+        w, h, px = png_decode(data)
+        cf, d = encode(px, w, args.cf, args.depth, args.swap)
+        body = [header, '// %dx%d, %s, %d bytes (PNG: %d bytes)\n\n' % (w, h, cf, len(d), len(data)),
+                depth_check({cf}, args.depth, args.swap, out_name),
+                'static const LV_ATTRIBUTE_LARGE_CONST uint8_t %s_map[] = {\n%s\n};\n\n' % (name, c_array(d)),
+                c_dsc(name + '_img', cf, w, h, name + '_map', len(d))]
+        kind = 'img'
+        size = len(d)
+
+    with open(os.path.join(args.out, out_name), 'w') as f:
+        f.write(''.join(body))
+    print('%-24s %4dx%-4d %8d bytes (was %d)' % (out_name, w, h, size, len(data)))
+    return name, os.path.splitext(os.path.basename(path))[0], kind
+
+
+def write_index(out_dir, images):
+    lines = ['// icons.inc - made by extras/img_compile.py --index, do not edit\n',
+             '// Included by includes/icons.inc when CHINSCREEN_ICONS_NATIVE is defined\n\n']
+    for name, _, _ in images:
+        lines.append('#include "%s.inc"\n' % name)
+    lines.append('\n// Rows of the chinScreen icon registry: name, PNG data, PNG size, colorable, image\n')
+    lines.append('#define CHINSCREEN_NATIVE_ICONS \\\n')
+    for name, icon, kind in images:
+        if kind == 'img':
+            lines.append('    {"%s", nullptr, nullptr, true, &%s_img}, \\\n' % (icon, name))
+    lines.append('\n')
+    with open(os.path.join(out_dir, 'icons.inc'), 'w') as f:
+        f.write(''.join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compile PNG/GIF icons into LVGL image descriptors.')
+    parser.add_argument('images', nargs='+', help='.png, .gif or .inc with the bytes of either')
+    parser.add_argument('--out', default='.', help='directory for the generated .inc files')
+    parser.add_argument('--cf', default='auto', choices=['auto', 'true_color', 'true_color_alpha', 'indexed', 'alpha'])
+    parser.add_argument('--depth', type=int, default=16, choices=[16, 32], help='LV_COLOR_DEPTH')
+    parser.add_argument('--no-swap', dest='swap', action='store_const', const=0, default=1,
+                        help='for LV_COLOR_16_SWAP 0 (lv_conf.h of chinScreen has 1)')
+    parser.add_argument('--index', action='store_true', help='also write icons.inc for the icon registry')
+    args = parser.parse_args()
+
+    os.makedirs(args.out, exist_ok=True)
+    images = []
+    failed = False
+    for path in args.images:
+        try:
+            images.append(compile_image(path, args))
+        except (ValueError, IndexError, zlib.error) as e:
+            print('%s: %s' % (path, e), file=sys.stderr)
+            failed = True
+    if args.index:
+        write_index(args.out, images)
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+"""Decode chinScreen_perf_dump() lines from a serial log.
+
+    python3 perf_decode.py serial.log
+    cat /dev/ttyACM0 | python3 perf_decode.py
+
+Every "chinScreen-perf:<hex>" line is decoded and printed as a table with
+min/avg/max/p99 and a log2 histogram of the last samples of each metric.
+The format is described at lvgl_port_perf_dump() in src/lv_port_perf.h.
+"""
+
+import struct
+import sys
+
+MAGIC = 0x4650564C
+VERSION = 1
+BUCKETS = 24
+PREFIX = "chinScreen-perf:"
+
+# Same order as lvgl_port_perf_metric_t
+NAMES = ["render_us", "flush_us", "te_wait_us", "lock_wait_us",
+         "tx_bytes", "areas", "pixels", "sleep_ms"]
+
+
+def decode(data):
+    magic, version, metrics, window, timestamp = struct.unpack_from("<IBBHI", data, 0)
+    if magic != MAGIC:
+        raise ValueError("bad magic 0x%08x" % magic)
+    if version != VERSION:
+        raise ValueError("unsupported version %d" % version)
+    size = 12 + metrics * (22 + BUCKETS)
+    if len(data) != size:
+        raise ValueError("expected %d bytes, got %d" % (size, len(data)))
+
+    out = {"timestamp_ms": timestamp, "window": window, "metrics": []}
+    offset = 12
+    for m in range(metrics):
+        total, count, vmin, vavg, vmax, p99 = struct.unpack_from("<IHIIII", data, offset)
+        offset += 22
+        buckets = list(data[offset:offset + BUCKETS])
+        offset += BUCKETS
+        out["metrics"].append({
+            "name": NAMES[m] if m < len(NAMES) else "metric%d" % m,
+            "total": total, "count": count,
+            "min": vmin, "avg": vavg, "max": vmax, "p99": p99,
+            "buckets": buckets,
+        })
+    return out
+
+
+def bucket_range(b):
+    if b == 0:
+        return "0"
+    lo = 1 << (b - 1)
+    hi = (1 << b) - 1
+    if b == BUCKETS - 1:
+        return ">=%d" % lo
+    return str(lo) if lo == hi else "%d-%d" % (lo, hi)
+
+
+def print_dump(dump):
+    print("t=%d ms, window %d samples" % (dump["timestamp_ms"], dump["window"]))
+    print("%-13s %8s %10s %10s %10s %10s" % ("metric", "samples", "min", "avg", "max", "p99"))
+    for m in dump["metrics"]:
+        print("%-13s %8d %10d %10d %10d %10d" % (m["name"], m["count"], m["min"], m["avg"], m["max"], m["p99"]))
+    for m in dump["metrics"]:
+        if not m["count"]:
+            continue
+        print("  %s:" % m["name"])
+        peak = max(m["buckets"])
+        for b, n in enumerate(m["buckets"]):
+            if n:
+                print("    %-16s %4d %s" % (bucket_range(b), n, "#" * max(1, n * 40 // peak)))
+    print()
+
+
+def main():
+    src = open(sys.argv[1], errors="replace") if len(sys.argv) > 1 else sys.stdin
+    found = 0
+    for line in src:
+        pos = line.find(PREFIX)
+        if pos < 0:
+            continue
+        try:
+            print_dump(decode(bytes.fromhex(line[pos + len(PREFIX):].strip())))
+            found += 1
+        except ValueError as e:
+            print("skipping dump: %s" % e, file=sys.stderr)
+    if not found:
+        print("no %s lines found" % PREFIX, file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
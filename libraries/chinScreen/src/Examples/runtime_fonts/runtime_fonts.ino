@@ -0,0 +1,52 @@
+//=============================================================================
+// EXAMPLE: Fonts loaded from the SD card at any size
+// Copy a TrueType font to the card first, e.g. Roboto-Regular.ttf from
+// fonts.google.com as /fonts/Roboto.ttf
+//=============================================================================
+#define CHINSCREEN_ENABLE_GFONTS
+#include "chinScreen.h"
+
+lv_obj_t* clock_value;
+int seconds = 0;
+
+void tick(void* user_data);
+
+void setup() {
+    Serial.begin(115200);
+    init_display();
+    chinScreen_init_sd_card(5);
+
+    chinScreen_background_solid("black");
+
+    lv_font_t* title = chinScreen_font_load("/fonts/Roboto.ttf", 36);
+    lv_font_t* body = chinScreen_font_load("/fonts/Roboto.ttf", 18);
+    lv_font_t* digits = chinScreen_font_load("/fonts/Roboto.ttf", 72);
+    if (!title || !body || !digits) {
+        chinScreen_text("Copy a font to /fonts/Roboto.ttf", 10, 10, "red", "medium");
+        return;
+    }
+
+    // The digits change every second, draw them now instead of on the first update
+    chinScreen_font_warm_up(digits, "0123456789:");
+
+    chinScreen_text("Runtime fonts", 10, 10, "white", title);
+    chinScreen_text("One file, any size", 10, 60, "gray", body);
+
+    clock_value = chinScreen_number("%02d", 110, 180, "yellow", "xlarge");
+    bsp_display_lock(0);
+    lv_obj_set_style_text_font(clock_value, digits, LV_PART_MAIN);
+    bsp_display_unlock();
+    chinScreen_number_set(clock_value, 0);
+
+    chinScreen_repeat_every(1000, tick);
+}
+
+void loop() {
+    delay(10);
+}
+
+void tick(void* user_data) {
+    seconds = (seconds + 1) % 60;
+    chinScreen_number_set(clock_value, seconds);
+    if (seconds % 10 == 0) chinScreen_font_stats();
+}
@@ -5,6 +5,7 @@
 
 lv_obj_t* temp_circle;
 lv_obj_t* temp_bar;
+lv_obj_t* temp_value;
 
 void setup() {
     Serial.begin(115200);
@@ -19,7 +20,11 @@ void setup() {
     
     // Temperature display circle
     temp_circle = chinScreen_circle("red", "white", 60, "top", "right");
-    chinScreen_shape_text(temp_circle, "75°F", "white", "large");
+    chinScreen_shape_text(temp_circle, "Temp", "white", "large");
+
+    // Current reading, only the digits that change are redrawn
+    temp_value = chinScreen_number("Now: %3d°F", 10, 60, "white", "large");
+    chinScreen_number_set(temp_value, 75);
     
     // Progress bar for temperature
     temp_bar = chinScreen_progress_bar(200, 20, 75, "gray", "orange", "middle", "center");
@@ -39,7 +44,6 @@ void update_temp(lv_event_t* e) {
     // Simulate temperature reading
     int new_temp = random(60, 90);
     chinScreen_progress_set_value(temp_bar, new_temp);
-    
-    // Update circle text (in real code, you'd update the label)
+    chinScreen_number_set(temp_value, new_temp);
     Serial.printf("Temperature updated to %d°F\n", new_temp);
 }
\ No newline at end of file
@@ -23,9 +23,12 @@
 #include "includes/lvgl-8.3.11/src/lvgl.h"
 
 #include "includes/lvgl-8.3.11/src/extra/libs/gif/lv_gif.h"
+#include "includes/lvgl-8.3.11/src/extra/libs/mjpeg/lv_mjpeg.h"
 #include "display.h"
 #include "esp_bsp.h"
 #include "lv_port.h"
+#include "lv_port_mem.h"
+#include "lv_port_perf.h"
 #include <ctype.h>
 #include <SD.h>
 #include <FS.h>
@@ -141,6 +144,7 @@
 
 
 // special includes - do not change this order!!
+#include "includes/resolve.h"
 #include "includes/colors.h"
 #include "includes/basic.h"
 #include "includes/inputs.h"
@@ -48,6 +48,7 @@
         .task_affinity = -1,                    \
         .time_Tvdl = 13,                        \
         .time_Tvdh = 3,                         \
+        .bus_bytes_per_sec = 20 * 1000 * 1000,  \
         .te_gpio_num = te_io,                   \
         .tear_intr_type = intr_type,            \
     }
@@ -68,6 +69,7 @@ typedef struct {
         int task_affinity;          /*!< Tear task pinned to core (-1 is no affinity) */
         uint32_t time_Tvdl;         /*!< The display panel is updated from the Frame Memory, Reference specifications */
         uint32_t time_Tvdh;         /*!< The display panel is not updated from the Frame Memory, Reference specifications */
+        uint32_t bus_bytes_per_sec; /*!< Color throughput of the panel bus, used to plan tear-free transfers */
         int te_gpio_num;            /*!< Tear gpio num */
         gpio_int_type_t tear_intr_type;  /*!< Tear intr type */
     } tear_cfg;
@@ -5,12 +5,14 @@
  */
 
 #include <stdio.h>
+#include <inttypes.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "driver/gpio.h"
 #include "driver/i2c.h"
 #include "driver/spi_master.h"
 #include "esp_timer.h"
+#include "esp_rom_sys.h"
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_vendor.h"
 #include "esp_lcd_panel_ops.h"
@@ -26,6 +28,7 @@
 #include "bsp_err_check.h"
 
 #include "lv_port.h"
+#include "lv_port_te.h"
 #include "display.h"
 #include "esp_bsp.h"
 
@@ -67,13 +70,23 @@ static const axs15231b_lcd_init_cmd_t lcd_init_cmds[] = {
 };
 typedef struct {
     SemaphoreHandle_t te_v_sync_sem;    /*!< Semaphore for vertical synchronization */
-    SemaphoreHandle_t te_catch_sem;     /*!< Semaphore for tear catch */
     uint32_t time_Tvdl;                 /*!< tvdl = The display panel is updated from the Frame Memory */
     uint32_t time_Tvdh;                 /*!< tvdh = The display panel is not updated from the Frame Memory */
     uint32_t te_timestamp;              /*!< Tear record timestamp */
+    lvgl_port_te_t sched;               /*!< Frame scheduler fed with the TE edges */
+    lv_disp_t *disp;                    /*!< LVGL display whose refresh period follows the TE period */
+    uint32_t refr_period_ms;            /*!< Refresh period currently set on disp */
+    esp_timer_handle_t wake_timer;      /*!< Wakes the flushing task shortly before its transfer may start */
+    TaskHandle_t waiter;                /*!< Task waiting in bsp_display_sync_cb() */
     portMUX_TYPE lock;                  /*!< Lock for read/write */
 } bsp_lcd_tear_t;
 
+/* TE edges between two checks of the LVGL refresh period */
+#define BSP_SYNC_ADAPT_EDGES    (64)
+
+/* Longest wait spun before a transfer; the rest of it is slept through */
+#define BSP_SYNC_SPIN_US        (50)
+
 typedef struct {
     SemaphoreHandle_t tp_intr_event;    /*!< Semaphore for tp interrupt */
     lv_disp_rot_t rotate;               /*!< Rotation configuration for the display */
@@ -172,30 +185,70 @@ esp_err_t bsp_display_backlight_on(void)
     return bsp_display_brightness_set(100);
 }
 
-static bool bsp_display_sync_cb(void *arg)
+static bool bsp_display_sync_cb(void *arg, int x_start, int y_start, int x_end, int y_end)
 {
-    assert(arg);
     bsp_lcd_tear_t *tear_handle = (bsp_lcd_tear_t *)arg;
-
-    if (tear_handle->te_catch_sem) {
-        xSemaphoreGive(tear_handle->te_catch_sem);
+    if (!tear_handle) {
+        return false;
     }
 
-    if (tear_handle->te_v_sync_sem) {
-
-        xSemaphoreTake(tear_handle->te_v_sync_sem, portMAX_DELAY);
+    /* Hold the transfer until its rows can be written without crossing the scan line */
+    const int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&tear_handle->lock);
+    const uint32_t wait_us = lvgl_port_te_plan(&tear_handle->sched, now, y_start, y_end);
+    portEXIT_CRITICAL(&tear_handle->lock);
+
+    if (wait_us) {
+        /* Sleep until just before the start; with async flush the tile worker runs on the other core */
+        const int64_t start = now + wait_us;
+        int64_t left = wait_us;
+        while (left > BSP_SYNC_SPIN_US) {
+            tear_handle->waiter = xTaskGetCurrentTaskHandle();
+            if (esp_timer_start_once(tear_handle->wake_timer, left - BSP_SYNC_SPIN_US) != ESP_OK) {
+                break;
+            }
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(left / 1000) + 2);
+            esp_timer_stop(tear_handle->wake_timer);
+            left = start - esp_timer_get_time();
+        }
+        if (left > 0 && left <= BSP_SYNC_SPIN_US) {
+            esp_rom_delay_us(left);
+        }
     }
     return true;
 }
 
+static void bsp_display_sync_wake(void *arg)
+{
+    bsp_lcd_tear_t *tear_handle = (bsp_lcd_tear_t *)arg;
+    xTaskNotifyGive(tear_handle->waiter);
+}
+
 static void bsp_display_sync_task(void *arg)
 {
     assert(arg);
     bsp_lcd_tear_t *tear_handle = (bsp_lcd_tear_t *)arg;
+    uint32_t edges = 0;
 
     while (true) {
-        if (pdPASS != xSemaphoreTake(tear_handle->te_catch_sem, pdMS_TO_TICKS(tear_handle->time_Tvdl))) {
-            xSemaphoreTake(tear_handle->te_v_sync_sem, 0);
+        if (pdPASS != xSemaphoreTake(tear_handle->te_v_sync_sem, portMAX_DELAY)) {
+            continue;
+        }
+        if (++edges % BSP_SYNC_ADAPT_EDGES || !tear_handle->disp) {
+            continue;
+        }
+
+        /* Let LVGL refresh at the rate the panel really scans */
+        portENTER_CRITICAL(&tear_handle->lock);
+        const uint32_t period_ms = lvgl_port_te_refr_period_ms(&tear_handle->sched);
+        const uint32_t period_us = tear_handle->sched.stats.period_us;
+        portEXIT_CRITICAL(&tear_handle->lock);
+
+        if (period_ms != tear_handle->refr_period_ms && lvgl_port_lock(0)) {
+            lv_timer_set_period(_lv_disp_get_refr_timer(tear_handle->disp), period_ms);
+            lvgl_port_unlock();
+            tear_handle->refr_period_ms = period_ms;
+            ESP_LOGI(TAG, "TE period %"PRIu32" us, LVGL refresh period %"PRIu32" ms", period_us, period_ms);
         }
     }
     vTaskDelete(NULL);
@@ -208,8 +261,10 @@ static void bsp_display_tear_interrupt(void *arg)
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
     if (tear_handle->te_v_sync_sem) {
+        const int64_t now = esp_timer_get_time();
         portENTER_CRITICAL_ISR(&tear_handle->lock);
         tear_handle->te_timestamp = esp_log_timestamp();
+        lvgl_port_te_edge(&tear_handle->sched, now);
         portEXIT_CRITICAL_ISR(&tear_handle->lock);
         xSemaphoreGiveFromISR(tear_handle->te_v_sync_sem, &xHigherPriorityTaskWoken);
 
@@ -219,12 +274,23 @@ static void bsp_display_tear_interrupt(void *arg)
     }
 }
 
+esp_err_t bsp_display_get_sync_stats(lvgl_port_te_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(panel_handle && panel_handle->user_data, ESP_ERR_INVALID_STATE, TAG, "no TE signal");
+
+    bsp_lcd_tear_t *tear_handle = (bsp_lcd_tear_t *)panel_handle->user_data;
+    portENTER_CRITICAL(&tear_handle->lock);
+    *stats = tear_handle->sched.stats;
+    portEXIT_CRITICAL(&tear_handle->lock);
+    return ESP_OK;
+}
+
 esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_handle_t *ret_panel, esp_lcd_panel_io_handle_t *ret_io)
 {
     esp_err_t ret = ESP_OK;
     assert(config != NULL && config->max_transfer_sz > 0);
 
-    SemaphoreHandle_t te_catch_sem = NULL;
     SemaphoreHandle_t te_v_sync_sem = NULL;
     bsp_lcd_tear_t *tear_ctx = NULL;
 
@@ -265,20 +331,33 @@ esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_hand
 
     if (config->tear_cfg.te_gpio_num > 0) {
 
-        tear_ctx = malloc(sizeof(bsp_lcd_tear_t));
+        tear_ctx = calloc(1, sizeof(bsp_lcd_tear_t));
         ESP_GOTO_ON_FALSE(tear_ctx, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for tear_ctx allocation!");
 
         te_v_sync_sem = xSemaphoreCreateCounting(1, 0);
         ESP_GOTO_ON_FALSE(te_v_sync_sem, ESP_ERR_NO_MEM, err, TAG, "Failed to create te_v_sync_sem Semaphore");
         tear_ctx->te_v_sync_sem = te_v_sync_sem;
 
-        te_catch_sem = xSemaphoreCreateCounting(1, 0);
-        ESP_GOTO_ON_FALSE(te_catch_sem, ESP_ERR_NO_MEM, err, TAG, "Failed to create te_catch_sem Semaphore");
-        tear_ctx->te_catch_sem = te_catch_sem;
-
         tear_ctx->time_Tvdl = config->tear_cfg.time_Tvdl;
         tear_ctx->time_Tvdh = config->tear_cfg.time_Tvdh;
 
+        const uint32_t row_bytes = EXAMPLE_LCD_QSPI_H_RES * BSP_LCD_BITS_PER_PIXEL / 8;
+        const lvgl_port_te_cfg_t sched_cfg = {
+            .lines = EXAMPLE_LCD_QSPI_V_RES,
+            .period_us = (config->tear_cfg.time_Tvdl + config->tear_cfg.time_Tvdh) * 1000,
+            .scan_us = config->tear_cfg.time_Tvdl * 1000,
+            .row_xfer_ns = (uint32_t)((uint64_t)row_bytes * 1000000000ULL / config->tear_cfg.bus_bytes_per_sec),
+            .margin_us = 200,
+        };
+        lvgl_port_te_init(&tear_ctx->sched, &sched_cfg);
+
+        const esp_timer_create_args_t wake_timer_args = {
+            .callback = bsp_display_sync_wake,
+            .arg = tear_ctx,
+            .name = "TE wait",
+        };
+        ESP_GOTO_ON_ERROR(esp_timer_create(&wake_timer_args, &tear_ctx->wake_timer), err, TAG, "Failed to create the TE wait timer");
+
         tear_ctx->lock.owner = portMUX_FREE_VAL;
         tear_ctx->lock.count = 0;
 
@@ -311,10 +390,10 @@ err:
     if (te_v_sync_sem) {
         vSemaphoreDelete(te_v_sync_sem);
     }
-    if (te_catch_sem) {
-        vSemaphoreDelete(te_catch_sem);
-    }
     if (tear_ctx) {
+        if (tear_ctx->wake_timer) {
+            esp_timer_delete(tear_ctx->wake_timer);
+        }
         free(tear_ctx);
     }
     if (*ret_panel) {
@@ -353,14 +432,18 @@ static lv_disp_t *bsp_display_lcd_init(const bsp_display_cfg_t *cfg)
         .io_handle = io_handle,
         .panel_handle = panel_handle,
         .buffer_size = cfg->buffer_size,
+        .double_buffer = cfg->double_buffer,
         .sw_rotate = cfg->rotate,
         .hres = hres,
         .vres = vres,
-        .trans_size = hres * vres / 10,
-        .draw_wait_cb = bsp_display_sync_cb,
+        .trans_size = cfg->trans_size,
+        .draw_area_wait_cb = bsp_display_sync_cb,
         .flags = {
-            .buff_dma = false,
-            .buff_spiram = true,
+            .buff_dma = cfg->flags.buff_dma,
+            .buff_spiram = cfg->flags.buff_spiram,
+            .buff_internal = cfg->flags.buff_internal,
+            .full_refresh = cfg->flags.full_refresh,
+            .async_flush = cfg->flags.async_flush,
         },
     };
 
@@ -372,7 +455,13 @@ static lv_disp_t *bsp_display_lcd_init(const bsp_display_cfg_t *cfg)
         disp_cfg.vres = hres;
     }
 
-    return lvgl_port_add_disp(&disp_cfg);
+    lv_disp_t *disp = lvgl_port_add_disp(&disp_cfg);
+
+    bsp_lcd_tear_t *tear_ctx = (bsp_lcd_tear_t *)panel_handle->user_data;
+    if (disp && tear_ctx) {
+        tear_ctx->disp = disp;
+    }
+    return disp;
 }
 
 static bool bsp_touch_sync_cb(void *arg)
@@ -512,7 +601,14 @@ static lv_indev_t *bsp_display_indev_init(const bsp_display_cfg_t *config, lv_di
 
 lv_disp_t *bsp_display_start_with_config(const bsp_display_cfg_t *cfg)
 {
-    BSP_ERROR_CHECK_RETURN_NULL(lvgl_port_init(&cfg->lvgl_port_cfg));
+    lvgl_port_cfg_t port_cfg = cfg->lvgl_port_cfg;
+#if LV_USE_DRAW_SW_TILES && (configNUM_CORES > 1)
+    /* Keep the LVGL task on the sketch's core, lvgl_port_init() gives the tile worker the other one */
+    if (port_cfg.task_affinity < 0) {
+        port_cfg.task_affinity = xPortGetCoreID();
+    }
+#endif
+    BSP_ERROR_CHECK_RETURN_NULL(lvgl_port_init(&port_cfg));
 
     BSP_ERROR_CHECK_RETURN_NULL(bsp_display_brightness_init());
 
@@ -17,6 +17,7 @@
 #include "driver/i2c.h"
 #include "includes/lvgl-8.3.11/src/lvgl.h"
 #include "lv_port.h"
+#include "lv_port_te.h"
 
 /**************************************************************************************************
  *  pinout
@@ -56,7 +57,16 @@ extern "C" {
 typedef struct {
     lvgl_port_cfg_t lvgl_port_cfg;  /*!< Configuration for the LVGL port */
     uint32_t buffer_size;           /*!< Size of the buffer for the screen in pixels */
+    bool double_buffer;             /*!< True, if should be allocated two buffers */
+    uint32_t trans_size;            /*!< Pixels per transport buffer, two are allocated in internal DMA RAM (0 = send from the draw buffer) */
     lv_disp_rot_t rotate;           /*!< Rotation configuration for the display */
+    struct {
+        unsigned int full_refresh: 1;   /*!< Redraw and send the whole screen on every change */
+        unsigned int async_flush: 1;    /*!< Render the next area while the previous one is sent */
+        unsigned int buff_dma: 1;       /*!< Draw buffers in internal DMA capable RAM */
+        unsigned int buff_spiram: 1;    /*!< Draw buffers in PSRAM */
+        unsigned int buff_internal: 1;  /*!< Draw buffers in internal RAM */
+    } flags;
 } bsp_display_cfg_t;
 
 /**
@@ -101,6 +111,17 @@ lv_disp_t *bsp_display_start_with_config(const bsp_display_cfg_t *cfg);
  */
 lv_indev_t *bsp_display_get_input_dev(void);
 
+/**
+ * @brief Get the counters of the TE frame scheduler
+ *
+ * @param[out] stats Learned TE period, tears avoided and missed deadlines
+ *
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_STATE if the display is not started or has no TE signal
+ */
+esp_err_t bsp_display_get_sync_stats(lvgl_port_te_stats_t *stats);
+
 /**
  * @brief Take LVGL mutex
  *
@@ -19,6 +19,7 @@
 #include "esp_lcd_touch.h"
 
 #include "esp_lcd_axs15231b.h"
+#include "lv_port_ramwr.h"
 
 /*max point num*/
 #define AXS_MAX_TOUCH_NUMBER                (1)
@@ -58,6 +59,7 @@ typedef struct {
     uint8_t colmod_val; // save surrent value of LCD_CMD_COLMOD register
     const axs15231b_lcd_init_cmd_t *init_cmds;
     uint16_t init_cmds_size;
+    lvgl_port_ramwr_t ramwr; // write window and pointer of the panel, decides between RAMWR and RAMWRC
     struct {
         unsigned int use_qspi_interface: 1;
         unsigned int reset_level: 1;
@@ -120,6 +122,7 @@ esp_err_t esp_lcd_new_panel_axs15231b(const esp_lcd_panel_io_handle_t io, const
     axs15231b->base.del = panel_axs15231b_del;
     axs15231b->base.reset = panel_axs15231b_reset;
     axs15231b->base.init = panel_axs15231b_init;
+    lvgl_port_ramwr_init(&axs15231b->ramwr);
     axs15231b->base.draw_bitmap = panel_axs15231b_draw_bitmap;
     axs15231b->base.invert_color = panel_axs15231b_invert_color;
     axs15231b->base.set_gap = panel_axs15231b_set_gap;
@@ -303,7 +306,13 @@ static esp_err_t panel_axs15231b_draw_bitmap(esp_lcd_panel_t *panel, int x_start
         (x_end - 1) & 0xFF,
     }, 4);
 
-    if (0 == axs15231b->flags.use_qspi_interface) {
+    // In QSPI mode RAMWRC continues from where the previous write stopped, so it may only be used when
+    // this area directly follows the last one inside the row window. RAMWR starts at the top of the row
+    // window, so any other area needs RASET unless the window already starts at its first row.
+    lvgl_port_ramwr_op_t op = lvgl_port_ramwr_next(&axs15231b->ramwr, x_start, y_start, x_end, y_end);
+    bool qspi_restart = axs15231b->flags.use_qspi_interface && !op.continuation;
+
+    if (0 == axs15231b->flags.use_qspi_interface || (qspi_restart && op.raset)) {
         tx_param(axs15231b, io, LCD_CMD_RASET, (uint8_t[]) {
             (y_start >> 8) & 0xFF,
             y_start & 0xFF,
@@ -314,7 +323,7 @@ static esp_err_t panel_axs15231b_draw_bitmap(esp_lcd_panel_t *panel, int x_start
 
     // transfer frame buffer
     size_t len = (x_end - x_start) * (y_end - y_start) * axs15231b->fb_bits_per_pixel / 8;
-    if (y_start == 0) {
+    if (axs15231b->flags.use_qspi_interface ? qspi_restart : (y_start == 0)) {
         tx_color(axs15231b, io, LCD_CMD_RAMWR, color_data, len);//2C
     } else {
         tx_color(axs15231b, io, LCD_CMD_RAMWRC, color_data, len);//3C
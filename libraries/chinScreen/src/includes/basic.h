@@ -36,6 +36,7 @@ inline void chinScreen_clear() {
 inline void chinScreen_background_solid(const char* colorName) {
     bsp_display_lock(0);
     lv_obj_t *scr = lv_scr_act();
+    lv_obj_remove_local_style_prop(scr, LV_STYLE_BG_GRAD, LV_PART_MAIN);
     lv_obj_set_style_bg_color(scr, getColorByName(colorName), LV_PART_MAIN);
     lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, LV_PART_MAIN);
     bsp_display_unlock();
@@ -62,88 +63,115 @@ inline void chinScreen_brightness(int howBright) {
 
 
 /////////////////////////////////////////////////////////////
-// Function: add text
+// Function: Font by name, "small" .. "xlarge" and the enabled fonts
 /////////////////////////////////////////////////////////////
+struct chinScreen_font_entry {
+    const char* name;
+    const lv_font_t* font;
+};
+
+constexpr const char* chinScreen_entry_name(const chinScreen_font_entry& entry) {
+    return entry.name;
+}
+
+static constexpr chinScreen_font_entry chinScreen_fonts[] = {
+    {"small", FONT_SMALL},
+    {"medium", FONT_MEDIUM},
+    {"large", FONT_LARGE},
+    {"xlarge", FONT_XLARGE},
+
+    {"small-pixel", FONT_PIXEL_S},
+    {"big-pixel", FONT_PIXEL_B},
+
+#ifdef CHINSCREEN_ENABLE_CURSIVE
+    {"cursive-s", FONT_CURSIVE},
+    {"cursive", FONT_CURSIVE_20},
+    {"cursive-l", FONT_CURSIVE_24},
+#endif
+
+#ifdef CHINSCREEN_ENABLE_COMIC
+    {"comic-s", FONT_COMIC_18},
+    {"comic", FONT_COMIC_20},
+    {"comic-l", FONT_COMIC_24},
+#endif
+
+#ifdef CHINSCREEN_ENABLE_BRUSH
+    {"brush-s", FONT_BRUSH_18},
+    {"brush", FONT_BRUSH_20},
+    {"brush-l", FONT_BRUSH_24},
+#endif
+
+#ifdef CHINSCREEN_ENABLE_DOTS
+    {"dots-s", FONT_DOTS},
+    {"dots", FONT_DOTS_20},
+    {"dots-l", FONT_DOTS_24},
+#endif
+
+#ifdef CHINSCREEN_ENABLE_MODERN
+    {"modern-s", FONT_MODERN},
+    {"modern", FONT_MODERN_20},
+    {"modern-l", FONT_MODERN_24},
+#endif
+
+#ifdef CHINSCREEN_ENABLE_CREEPY
+    {"creepy-s", FONT_CREEPY_18},
+    {"creepy", FONT_CREEPY},
+    {"creepy-l", FONT_CREEPY_24},
+#endif
+
+#ifdef CHINSCREEN_ENABLE_ALADIN
+    {"aladin-s", FONT_ALADIN},
+    {"aladin", FONT_ALADIN_20},
+    {"aladin-l", FONT_ALADIN_24},
+#endif
+
+#ifdef CHINSCREEN_ENABLE_MONSTER
+    {"monster-s", FONT_MONSTER},
+    {"monster", FONT_MONSTER_20},
+    {"monster-l", FONT_MONSTER_24},
+#endif
+
+#ifdef CHINSCREEN_ENABLE_EMOJI
+    {"emoji-s", FONT_EMOJI_18},
+    {"emoji", FONT_EMOJI_20},
+    {"emoji-l", FONT_EMOJI_24},
+#endif
+
+#ifdef CHINSCREEN_ENABLE_BITJI
+    {"bitji-s", FONT_BITJI_18},
+    {"bitji", FONT_BITJI_20},
+    {"bitji-l", FONT_BITJI_24},
+#endif
+
+#ifdef CHINSCREEN_ENABLE_BLOCKHEAD
+    {"blockhead-s", FONT_BLOCKHEAD_18},
+    {"blockhead", FONT_BLOCKHEAD_20},
+    {"blockhead-l", FONT_BLOCKHEAD_24},
+#endif
+};
+
+#define CHINSCREEN_FONT_COUNT (sizeof(chinScreen_fonts)/sizeof(chinScreen_fonts[0]))
+
+static CHINSCREEN_CONSTEXPR14 const chinScreen_phash<128> chinScreen_font_table =
+    chinScreen_phash_build<128>(chinScreen_fonts, CHINSCREEN_FONT_COUNT);
+CHINSCREEN_PHASH_ASSERT(chinScreen_font_table);
+
 inline const lv_font_t* getFontBySize(const char* size) {
-    if (strcmp(size, "small") == 0) return FONT_SMALL;
-    if (strcmp(size, "medium") == 0) return FONT_MEDIUM;
-    if (strcmp(size, "large") == 0) return FONT_LARGE;
-    if (strcmp(size, "xlarge") == 0) return FONT_XLARGE;
-	
-	if (strcmp(size, "small-pixel") == 0) return FONT_PIXEL_S;
-	if (strcmp(size, "big-pixel") == 0) return FONT_PIXEL_B;
-	
-	#ifdef CHINSCREEN_ENABLE_CURSIVE
-	if (strcmp(size, "cursive-s") == 0) return FONT_CURSIVE;
-	if (strcmp(size, "cursive") == 0) return FONT_CURSIVE_20;
-	if (strcmp(size, "cursive-l") == 0) return FONT_CURSIVE_24;
-	#endif
-	
-	#ifdef CHINSCREEN_ENABLE_COMIC
-	if (strcmp(size, "comic-s") == 0) return FONT_COMIC_18;
-	if (strcmp(size, "comic") == 0) return FONT_COMIC_20;
-	if (strcmp(size, "comic-l") == 0) return FONT_COMIC_24;
-	#endif
-		
-	#ifdef CHINSCREEN_ENABLE_BRUSH
-	if (strcmp(size, "brush-s") == 0) return FONT_BRUSH_18;
-	if (strcmp(size, "brush") == 0) return FONT_BRUSH_20;
-	if (strcmp(size, "brush-l") == 0) return FONT_BRUSH_24;
-	#endif
-
-	
-	#ifdef CHINSCREEN_ENABLE_DOTS
-	if (strcmp(size, "dots-s") == 0) return FONT_DOTS;
-	if (strcmp(size, "dots") == 0) return FONT_DOTS_20;
-	if (strcmp(size, "dots-l") == 0) return FONT_DOTS_24;
-	#endif
-	
-	
-	#ifdef CHINSCREEN_ENABLE_MODERN
-	if (strcmp(size, "modern-s") == 0) return FONT_MODERN;
-	if (strcmp(size, "modern") == 0) return FONT_MODERN_20;
-	if (strcmp(size, "modern-l") == 0) return FONT_MODERN_24;
-	#endif
-
-	#ifdef CHINSCREEN_ENABLE_CREEPY
-	if (strcmp(size, "creepy-s") == 0) return FONT_CREEPY_18;
-	if (strcmp(size, "creepy") == 0) return FONT_CREEPY;
-	if (strcmp(size, "creepy-l") == 0) return FONT_CREEPY_24;
-	#endif
-	
-	#ifdef CHINSCREEN_ENABLE_ALADIN
-	if (strcmp(size, "aladin-s") == 0) return FONT_ALADIN;
-	if (strcmp(size, "aladin") == 0) return FONT_ALADIN_20;
-	if (strcmp(size, "aladin-l") == 0) return FONT_ALADIN_24;	
-	#endif
-
-	#ifdef CHINSCREEN_ENABLE_MONSTER
-	if (strcmp(size, "monster-s") == 0) return FONT_MONSTER;
-	if (strcmp(size, "monster") == 0) return FONT_MONSTER_20;
-	if (strcmp(size, "monster-l") == 0) return FONT_MONSTER_24;	
-	#endif
-
-	#ifdef CHINSCREEN_ENABLE_EMOJI
-	if (strcmp(size, "emoji-s") == 0) return FONT_EMOJI;
-	if (strcmp(size, "emoji") == 0) return FONT_EMOJI_20;
-	if (strcmp(size, "emoji-l") == 0) return FONT_EMOJI_24;	
-	#endif
-
-	#ifdef CHINSCREEN_ENABLE_BITJI
-	if (strcmp(size, "bitji-s") == 0) return FONT_BITJI;
-	if (strcmp(size, "bitji") == 0) return FONT_BITJI_20;
-	if (strcmp(size, "bitji-l") == 0) return FONT_BITJI_24;	
-	#endif
-
-	#ifdef CHINSCREEN_ENABLE_BLOCKHEAD
-	if (strcmp(size, "blockhead-s") == 0) return FONT_BLOCKHEAD;
-	if (strcmp(size, "blockhead") == 0) return FONT_BLOCKHEAD_20;
-	if (strcmp(size, "blockhead-l") == 0) return FONT_BLOCKHEAD_24;	
-	#endif
-	
-    return FONT_MEDIUM; // default
+    int i = chinScreen_phash_find(chinScreen_font_table, chinScreen_fonts, CHINSCREEN_FONT_COUNT, size);
+    if (i < 0) return FONT_MEDIUM; // default
+    return chinScreen_fonts[i].font;
+}
+
+// Font of a string literal, looked up while compiling: CHINSCREEN_FONT("large")
+CHINSCREEN_CONSTEVAL int chinScreen_font_index(const char* size) {
+    return chinScreen_find_name(chinScreen_fonts, CHINSCREEN_FONT_COUNT, size);
 }
 
+#define CHINSCREEN_FONT(size) (chinScreen_fonts[chinScreen_constant<int, chinScreen_font_index(size)>::value].font)
+
+/////////////////////////////////////////////////////////////
+// Function: add text
+/////////////////////////////////////////////////////////////
 inline void chinScreen_text(const char* text, int x, int y, 
                            const char* colorName = "white", 
                            const char* fontSize = "medium") {
@@ -158,6 +186,56 @@ inline void chinScreen_text(const char* text, int x, int y,
     bsp_display_unlock();
 }
 
+/////////////////////////////////////////////////////////////
+// Function: add text in a font loaded at run time, e.g. by chinScreen_font_load()
+/////////////////////////////////////////////////////////////
+inline void chinScreen_text(const char* text, int x, int y,
+                           const char* colorName, const lv_font_t* font) {
+    bsp_display_lock(0);
+
+    lv_obj_t *label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, text);
+    lv_obj_set_style_text_color(label, getColorByName(colorName), LV_PART_MAIN);
+    lv_obj_set_style_text_font(label, font ? font : FONT_MEDIUM, LV_PART_MAIN);
+    lv_obj_set_pos(label, x, y);
+
+    bsp_display_unlock();
+}
+
+/////////////////////////////////////////////////////////////
+// Function: add a number with a printf format, like "Temp: %5.1f°C"
+// Only the digits that change are redrawn, keep the label to update it
+/////////////////////////////////////////////////////////////
+inline lv_obj_t* chinScreen_number(const char* format, int x, int y,
+                                   const char* colorName = "white",
+                                   const char* fontSize = "medium") {
+    bsp_display_lock(0);
+
+    lv_obj_t *label = lv_numlabel_create(lv_scr_act());
+    lv_obj_set_style_text_color(label, getColorByName(colorName), LV_PART_MAIN);
+    lv_obj_set_style_text_font(label, getFontBySize(fontSize), LV_PART_MAIN);
+    lv_numlabel_set_format(label, format);
+    lv_obj_set_pos(label, x, y);
+
+    bsp_display_unlock();
+    return label;
+}
+
+/////////////////////////////////////////////////////////////
+// Function: Show a new value in a number label
+/////////////////////////////////////////////////////////////
+inline void chinScreen_number_set(lv_obj_t* label, double value) {
+    if (!label) return;
+    bsp_display_lock(0);
+    // Whole numbers keep every digit, floats have 24 bits
+    if (value >= -2147483648.0 && value <= 2147483647.0 && value == (int32_t)value) {
+        lv_numlabel_set_value(label, (int32_t)value);
+    } else {
+        lv_numlabel_set_value_float(label, (float)value);
+    }
+    bsp_display_unlock();
+}
+
 
 /////////////////////////////////////////////////////////////
 // Function: Set object position (useful for manual positioning)
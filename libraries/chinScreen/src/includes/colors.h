@@ -22,7 +22,7 @@
 /////////////////////////////////////////////////////////////
 // Complete set of 140 HTML color names and values for LVGL 8.3.11
 /////////////////////////////////////////////////////////////
-static const char* colorNames[] = {
+static constexpr const char* colorNames[] = {
     "aliceblue", "antiquewhite", "aqua", "aquamarine", "azure",
     "beige", "bisque", "black", "blanchedalmond", "blue",
     "blueviolet", "brown", "burlywood", "cadetblue", "chartreuse",
@@ -55,176 +55,175 @@ static const char* colorNames[] = {
     "yellow", "yellowgreen"
 };
 
-static const lv_color_t colorValues[] = {
-    lv_color_make(240,248,255), // aliceblue
-    lv_color_make(250,235,215), // antiquewhite
-    lv_color_make(0,255,255),   // aqua
-    lv_color_make(127,255,212), // aquamarine
-    lv_color_make(240,255,255), // azure
-    lv_color_make(245,245,220), // beige
-    lv_color_make(255,228,196), // bisque
-    lv_color_make(0,0,0),       // black
-    lv_color_make(255,235,205), // blanchedalmond
-    lv_color_make(0,0,255),     // blue
-    lv_color_make(138,43,226),  // blueviolet
-    lv_color_make(165,42,42),   // brown
-    lv_color_make(222,184,135), // burlywood
-    lv_color_make(95,158,160),  // cadetblue
-    lv_color_make(127,255,0),   // chartreuse
-    lv_color_make(210,105,30),  // chocolate
-    lv_color_make(255,127,80),  // coral
-    lv_color_make(100,149,237), // cornflowerblue
-    lv_color_make(255,248,220), // cornsilk
-    lv_color_make(220,20,60),   // crimson
-    lv_color_make(0,255,255),   // cyan
-    lv_color_make(0,0,139),     // darkblue
-    lv_color_make(0,139,139),   // darkcyan
-    lv_color_make(184,134,11),  // darkgoldenrod
-    lv_color_make(169,169,169), // darkgray
-    lv_color_make(169,169,169), // darkgrey
-    lv_color_make(0,100,0),     // darkgreen
-    lv_color_make(189,183,107), // darkkhaki
-    lv_color_make(139,0,139),   // darkmagenta
-    lv_color_make(85,107,47),   // darkolivegreen
-    lv_color_make(255,140,0),   // darkorange
-    lv_color_make(153,50,204),  // darkorchid
-    lv_color_make(139,0,0),     // darkred
-    lv_color_make(233,150,122), // darksalmon
-    lv_color_make(143,188,143), // darkseagreen
-    lv_color_make(72,61,139),   // darkslateblue
-    lv_color_make(47,79,79),    // darkslategray
-    lv_color_make(47,79,79),    // darkslategrey
-    lv_color_make(0,206,209),   // darkturquoise
-    lv_color_make(148,0,211),   // darkviolet
-    lv_color_make(255,20,147),  // deeppink
-    lv_color_make(0,191,255),   // deepskyblue
-    lv_color_make(105,105,105), // dimgray
-    lv_color_make(105,105,105), // dimgrey
-    lv_color_make(30,144,255),  // dodgerblue
-    lv_color_make(178,34,34),   // firebrick
-    lv_color_make(255,250,240), // floralwhite
-    lv_color_make(34,139,34),   // forestgreen
-    lv_color_make(255,0,255),   // fuchsia
-    lv_color_make(220,220,220), // gainsboro
-    lv_color_make(248,248,255), // ghostwhite
-    lv_color_make(255,215,0),   // gold
-    lv_color_make(218,165,32),  // goldenrod
-    lv_color_make(128,128,128), // gray
-    lv_color_make(128,128,128), // grey
-    lv_color_make(0,128,0),     // green
-    lv_color_make(173,255,47),  // greenyellow
-    lv_color_make(240,255,240), // honeydew
-    lv_color_make(255,105,180), // hotpink
-    lv_color_make(205,92,92),   // indianred
-    lv_color_make(75,0,130),    // indigo
-    lv_color_make(255,255,240), // ivory
-    lv_color_make(240,230,140), // khaki
-    lv_color_make(230,230,250), // lavender
-    lv_color_make(255,240,245), // lavenderblush
-    lv_color_make(124,252,0),   // lawngreen
-    lv_color_make(255,250,205), // lemonchiffon
-    lv_color_make(173,216,230), // lightblue
-    lv_color_make(240,128,128), // lightcoral
-    lv_color_make(224,255,255), // lightcyan
-    lv_color_make(250,250,210), // lightgoldenrodyellow
-    lv_color_make(211,211,211), // lightgray
-    lv_color_make(211,211,211), // lightgrey
-    lv_color_make(144,238,144), // lightgreen
-    lv_color_make(255,182,193), // lightpink
-    lv_color_make(255,160,122), // lightsalmon
-    lv_color_make(32,178,170),  // lightseagreen
-    lv_color_make(135,206,250), // lightskyblue
-    lv_color_make(119,136,153), // lightslategray
-    lv_color_make(119,136,153), // lightslategrey
-    lv_color_make(176,196,222), // lightsteelblue
-    lv_color_make(255,255,224), // lightyellow
-    lv_color_make(0,255,0),     // lime
-    lv_color_make(50,205,50),   // limegreen
-    lv_color_make(250,240,230), // linen
-    lv_color_make(255,0,255),   // magenta
-    lv_color_make(128,0,0),     // maroon
-    lv_color_make(102,205,170), // mediumaquamarine
-    lv_color_make(0,0,205),     // mediumblue
-    lv_color_make(186,85,211),  // mediumorchid
-    lv_color_make(147,112,219), // mediumpurple
-    lv_color_make(60,179,113),  // mediumseagreen
-    lv_color_make(123,104,238), // mediumslateblue
-    lv_color_make(0,250,154),   // mediumspringgreen
-    lv_color_make(72,209,204),  // mediumturquoise
-    lv_color_make(199,21,133),  // mediumvioletred
-    lv_color_make(25,25,112),   // midnightblue
-    lv_color_make(245,255,250), // mintcream
-    lv_color_make(255,228,225), // mistyrose
-    lv_color_make(255,228,181), // moccasin
-    lv_color_make(255,222,173), // navajowhite
-    lv_color_make(0,0,128),     // navy
-    lv_color_make(253,245,230), // oldlace
-    lv_color_make(128,128,0),   // olive
-    lv_color_make(107,142,35),  // olivedrab
-    lv_color_make(255,165,0),   // orange
-    lv_color_make(255,69,0),    // orangered
-    lv_color_make(218,112,214), // orchid
-    lv_color_make(238,232,170), // palegoldenrod
-    lv_color_make(152,251,152), // palegreen
-    lv_color_make(175,238,238), // paleturquoise
-    lv_color_make(219,112,147), // palevioletred
-    lv_color_make(255,239,213), // papayawhip
-    lv_color_make(255,218,185), // peachpuff
-    lv_color_make(205,133,63),  // peru
-    lv_color_make(255,192,203), // pink
-    lv_color_make(221,160,221), // plum
-    lv_color_make(176,224,230), // powderblue
-    lv_color_make(128,0,128),   // purple
-    lv_color_make(255,0,0),     // red
-    lv_color_make(188,143,143), // rosybrown
-    lv_color_make(65,105,225),  // royalblue
-    lv_color_make(139,69,19),   // saddlebrown
-    lv_color_make(250,128,114), // salmon
-    lv_color_make(244,164,96),  // sandybrown
-    lv_color_make(46,139,87),   // seagreen
-    lv_color_make(255,245,238), // seashell
-    lv_color_make(160,82,45),   // sienna
-    lv_color_make(192,192,192), // silver
-    lv_color_make(135,206,235), // skyblue
-    lv_color_make(106,90,205),  // slateblue
-    lv_color_make(112,128,144), // slategray
-    lv_color_make(112,128,144), // slategrey
-    lv_color_make(255,250,250), // snow
-    lv_color_make(0,255,127),   // springgreen
-    lv_color_make(70,130,180),  // steelblue
-    lv_color_make(210,180,140), // tan
-    lv_color_make(0,128,128),   // teal
-    lv_color_make(216,191,216), // thistle
-    lv_color_make(255,99,71),   // tomato
-    lv_color_make(64,224,208),  // turquoise
-    lv_color_make(238,130,238), // violet
-    lv_color_make(245,222,179), // wheat
-    lv_color_make(255,255,255), // white
-    lv_color_make(245,245,245), // whitesmoke
-    lv_color_make(255,255,0),   // yellow
-    lv_color_make(154,205,50)   // yellowgreen
+static constexpr uint32_t colorHex[] = {
+    0xF0F8FF, // aliceblue
+    0xFAEBD7, // antiquewhite
+    0x00FFFF, // aqua
+    0x7FFFD4, // aquamarine
+    0xF0FFFF, // azure
+    0xF5F5DC, // beige
+    0xFFE4C4, // bisque
+    0x000000, // black
+    0xFFEBCD, // blanchedalmond
+    0x0000FF, // blue
+    0x8A2BE2, // blueviolet
+    0xA52A2A, // brown
+    0xDEB887, // burlywood
+    0x5F9EA0, // cadetblue
+    0x7FFF00, // chartreuse
+    0xD2691E, // chocolate
+    0xFF7F50, // coral
+    0x6495ED, // cornflowerblue
+    0xFFF8DC, // cornsilk
+    0xDC143C, // crimson
+    0x00FFFF, // cyan
+    0x00008B, // darkblue
+    0x008B8B, // darkcyan
+    0xB8860B, // darkgoldenrod
+    0xA9A9A9, // darkgray
+    0xA9A9A9, // darkgrey
+    0x006400, // darkgreen
+    0xBDB76B, // darkkhaki
+    0x8B008B, // darkmagenta
+    0x556B2F, // darkolivegreen
+    0xFF8C00, // darkorange
+    0x9932CC, // darkorchid
+    0x8B0000, // darkred
+    0xE9967A, // darksalmon
+    0x8FBC8F, // darkseagreen
+    0x483D8B, // darkslateblue
+    0x2F4F4F, // darkslategray
+    0x2F4F4F, // darkslategrey
+    0x00CED1, // darkturquoise
+    0x9400D3, // darkviolet
+    0xFF1493, // deeppink
+    0x00BFFF, // deepskyblue
+    0x696969, // dimgray
+    0x696969, // dimgrey
+    0x1E90FF, // dodgerblue
+    0xB22222, // firebrick
+    0xFFFAF0, // floralwhite
+    0x228B22, // forestgreen
+    0xFF00FF, // fuchsia
+    0xDCDCDC, // gainsboro
+    0xF8F8FF, // ghostwhite
+    0xFFD700, // gold
+    0xDAA520, // goldenrod
+    0x808080, // gray
+    0x808080, // grey
+    0x008000, // green
+    0xADFF2F, // greenyellow
+    0xF0FFF0, // honeydew
+    0xFF69B4, // hotpink
+    0xCD5C5C, // indianred
+    0x4B0082, // indigo
+    0xFFFFF0, // ivory
+    0xF0E68C, // khaki
+    0xE6E6FA, // lavender
+    0xFFF0F5, // lavenderblush
+    0x7CFC00, // lawngreen
+    0xFFFACD, // lemonchiffon
+    0xADD8E6, // lightblue
+    0xF08080, // lightcoral
+    0xE0FFFF, // lightcyan
+    0xFAFAD2, // lightgoldenrodyellow
+    0xD3D3D3, // lightgray
+    0xD3D3D3, // lightgrey
+    0x90EE90, // lightgreen
+    0xFFB6C1, // lightpink
+    0xFFA07A, // lightsalmon
+    0x20B2AA, // lightseagreen
+    0x87CEFA, // lightskyblue
+    0x778899, // lightslategray
+    0x778899, // lightslategrey
+    0xB0C4DE, // lightsteelblue
+    0xFFFFE0, // lightyellow
+    0x00FF00, // lime
+    0x32CD32, // limegreen
+    0xFAF0E6, // linen
+    0xFF00FF, // magenta
+    0x800000, // maroon
+    0x66CDAA, // mediumaquamarine
+    0x0000CD, // mediumblue
+    0xBA55D3, // mediumorchid
+    0x9370DB, // mediumpurple
+    0x3CB371, // mediumseagreen
+    0x7B68EE, // mediumslateblue
+    0x00FA9A, // mediumspringgreen
+    0x48D1CC, // mediumturquoise
+    0xC71585, // mediumvioletred
+    0x191970, // midnightblue
+    0xF5FFFA, // mintcream
+    0xFFE4E1, // mistyrose
+    0xFFE4B5, // moccasin
+    0xFFDEAD, // navajowhite
+    0x000080, // navy
+    0xFDF5E6, // oldlace
+    0x808000, // olive
+    0x6B8E23, // olivedrab
+    0xFFA500, // orange
+    0xFF4500, // orangered
+    0xDA70D6, // orchid
+    0xEEE8AA, // palegoldenrod
+    0x98FB98, // palegreen
+    0xAFEEEE, // paleturquoise
+    0xDB7093, // palevioletred
+    0xFFEFD5, // papayawhip
+    0xFFDAB9, // peachpuff
+    0xCD853F, // peru
+    0xFFC0CB, // pink
+    0xDDA0DD, // plum
+    0xB0E0E6, // powderblue
+    0x800080, // purple
+    0xFF0000, // red
+    0xBC8F8F, // rosybrown
+    0x4169E1, // royalblue
+    0x8B4513, // saddlebrown
+    0xFA8072, // salmon
+    0xF4A460, // sandybrown
+    0x2E8B57, // seagreen
+    0xFFF5EE, // seashell
+    0xA0522D, // sienna
+    0xC0C0C0, // silver
+    0x87CEEB, // skyblue
+    0x6A5ACD, // slateblue
+    0x708090, // slategray
+    0x708090, // slategrey
+    0xFFFAFA, // snow
+    0x00FF7F, // springgreen
+    0x4682B4, // steelblue
+    0xD2B48C, // tan
+    0x008080, // teal
+    0xD8BFD8, // thistle
+    0xFF6347, // tomato
+    0x40E0D0, // turquoise
+    0xEE82EE, // violet
+    0xF5DEB3, // wheat
+    0xFFFFFF, // white
+    0xF5F5F5, // whitesmoke
+    0xFFFF00, // yellow
+    0x9ACD32  // yellowgreen
 };
 
+#define CHINSCREEN_COLOR_COUNT (sizeof(colorNames)/sizeof(colorNames[0]))
+
+static CHINSCREEN_CONSTEXPR14 const chinScreen_phash<256> colorTable =
+    chinScreen_phash_build<256>(colorNames, CHINSCREEN_COLOR_COUNT);
+CHINSCREEN_PHASH_ASSERT(colorTable);
+
 inline lv_color_t getColorByName(const char* name) {
-    for (uint8_t i = 0; i < sizeof(colorNames)/sizeof(colorNames[0]); i++) {
-        const char* p1 = name;
-        const char* p2 = colorNames[i];
-        bool match = true;
-        while (*p1 && *p2) {
-            if (tolower(*p1) != tolower(*p2)) {
-                match = false;
-                break;
-            }
-            p1++;
-            p2++;
-        }
-        if (match && *p1 == '\0' && *p2 == '\0') {
-            return colorValues[i];
-        }
-    }
-    return lv_color_make(0,0,0); // default black if not found
+    int i = chinScreen_phash_find(colorTable, colorNames, CHINSCREEN_COLOR_COUNT, name);
+    if (i < 0) return lv_color_make(0,0,0); // default black if not found
+    return lv_color_hex(colorHex[i]);
+}
+
+// Colour of a string literal, looked up while compiling: CHINSCREEN_COLOR("red")
+CHINSCREEN_CONSTEVAL int chinScreen_color_index(const char* name) {
+    return chinScreen_find_name(colorNames, CHINSCREEN_COLOR_COUNT, name);
 }
 
+#define CHINSCREEN_COLOR(name) lv_color_hex(colorHex[chinScreen_constant<int, chinScreen_color_index(name)>::value])
+
 // Optional: Get the number of available colors
 inline uint8_t getColorCount() {
     return sizeof(colorNames)/sizeof(colorNames[0]);
@@ -252,6 +251,8 @@ inline void chinScreen_background_gradient(const char* color1Name, const char* c
     lv_grad_dir_t grad_dir = LV_GRAD_DIR_VER;
     if (strcmp(direction, "horizontal") == 0) grad_dir = LV_GRAD_DIR_HOR;
     
+    // a multi-color gradient set before would take precedence
+    lv_obj_remove_local_style_prop(scr, LV_STYLE_BG_GRAD, LV_PART_MAIN);
     lv_obj_set_style_bg_color(scr, color1, LV_PART_MAIN);
     lv_obj_set_style_bg_grad_color(scr, color2, LV_PART_MAIN);
     lv_obj_set_style_bg_grad_dir(scr, grad_dir, LV_PART_MAIN);
@@ -307,6 +308,38 @@ static const lv_color_t fire_colors[] = {
     lv_color_make(255, 255, 255)  // White
 };
 
+/////////////////////////////////////////////////////////////
+// Function: Fill an LVGL gradient descriptor from chinScreen stops
+/////////////////////////////////////////////////////////////
+// Positions go from 0-100 to LVGL's 0-255. With more stops than LV_GRADIENT_MAX_STOPS
+// the first and last are kept and the ones in between are picked evenly. A single stop
+// becomes a solid fill of its color.
+inline void chinScreen_gradient_to_dsc(lv_grad_dsc_t* dsc, const chinScreen_gradient_stop* stops,
+                                       uint8_t stop_count, lv_grad_dir_t grad_dir) {
+    uint8_t count = stop_count > LV_GRADIENT_MAX_STOPS ? LV_GRADIENT_MAX_STOPS : stop_count;
+
+    memset(dsc, 0, sizeof(lv_grad_dsc_t));
+    dsc->dir = grad_dir;
+    if (count == 0) return;
+    if (count == 1) {
+        dsc->stops_count = 2;
+        dsc->stops[0].color = stops[0].color;
+        dsc->stops[1].color = stops[0].color;
+        dsc->stops[1].frac = 255;
+        return;
+    }
+    dsc->stops_count = count;
+    for (uint8_t i = 0; i < count; i++) {
+        const chinScreen_gradient_stop& stop = stops[(i * (stop_count - 1)) / (count - 1)];
+        uint8_t position = stop.position > 100 ? 100 : stop.position;
+        dsc->stops[i].color = stop.color;
+        dsc->stops[i].frac = (uint8_t)((position * 255) / 100);
+    }
+}
+
+// The screen background keeps a pointer to its gradient, so it has to outlive the call
+static lv_grad_dsc_t chinScreen_bg_grad;
+
 /////////////////////////////////////////////////////////////
 // Function: Create multi-color gradient background
 /////////////////////////////////////////////////////////////
@@ -314,6 +347,10 @@ inline void chinScreen_background_multi_gradient(const chinScreen_gradient_stop*
                                                  uint8_t stop_count,
                                                  const char* direction = "vertical") {
     if (stop_count < 2) return;
+    if (stop_count > LV_GRADIENT_MAX_STOPS) {
+        Serial.printf("chinScreen_background_multi_gradient: %u stops, only %d are drawn\n",
+                      (unsigned)stop_count, LV_GRADIENT_MAX_STOPS);
+    }
     
     bsp_display_lock(0);
     lv_obj_t *scr = lv_scr_act();
@@ -321,97 +358,19 @@ inline void chinScreen_background_multi_gradient(const chinScreen_gradient_stop*
     // Clear any existing children first
     lv_obj_clean(scr);
     
-    // CRITICAL: Ensure the screen itself has no padding/margins
+    // The gradient is drawn by the screen itself, so it must not have padding or a border
     lv_obj_set_style_pad_all(scr, 0, LV_PART_MAIN);
     lv_obj_set_style_border_width(scr, 0, LV_PART_MAIN);
     
     lv_grad_dir_t grad_dir = LV_GRAD_DIR_VER;
     if (strcmp(direction, "horizontal") == 0) grad_dir = LV_GRAD_DIR_HOR;
     
-    // Use the full display resolution constants
-    lv_coord_t screen_width = LV_HOR_RES;
-    lv_coord_t screen_height = LV_VER_RES;
-    
-    // Set screen background to the first color as fallback
+    // One object, one draw: LVGL computes the color map once and keeps it in its gradient cache
+    chinScreen_gradient_to_dsc(&chinScreen_bg_grad, stops, stop_count, grad_dir);
     lv_obj_set_style_bg_color(scr, stops[0].color, LV_PART_MAIN);
+    lv_obj_set_style_bg_grad(scr, &chinScreen_bg_grad, LV_PART_MAIN);
     lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, LV_PART_MAIN);
     
-    // Create gradient segments with guaranteed full coverage
-    for (uint8_t i = 0; i < stop_count - 1; i++) {
-        lv_obj_t *gradient_obj = lv_obj_create(scr);
-        
-        // CRITICAL: Remove ALL styling that could create gaps
-        lv_obj_remove_style_all(gradient_obj);
-        lv_obj_set_style_border_width(gradient_obj, 0, LV_PART_MAIN);
-        lv_obj_set_style_pad_all(gradient_obj, 0, LV_PART_MAIN);
-        lv_obj_set_style_outline_width(gradient_obj, 0, LV_PART_MAIN);
-        lv_obj_clear_flag(gradient_obj, LV_OBJ_FLAG_SCROLLABLE);
-        
-        // Calculate segment positions with overlap
-        uint8_t start_pos = stops[i].position;
-        uint8_t end_pos = stops[i + 1].position;
-        
-        lv_coord_t start_pixel, size_pixel;
-        
-        if (grad_dir == LV_GRAD_DIR_VER) {
-            // Vertical gradient - calculate precise boundaries
-            start_pixel = (start_pos * screen_height) / 100;
-            lv_coord_t end_pixel = (end_pos * screen_height) / 100;
-            size_pixel = end_pixel - start_pixel;
-            
-            // Add minimal overlap to prevent gaps but avoid scroll
-            if (i > 0) start_pixel -= 1;  // Minimal overlap with previous
-            if (i < stop_count - 2) {
-                size_pixel += 2;  // Small overlap with next
-            } else {
-                // Last segment - ensure it ends exactly at screen bottom
-                size_pixel = screen_height - start_pixel;
-            }
-            
-            // Ensure we don't go negative or exceed screen bounds
-            if (start_pixel < 0) start_pixel = 0;
-            if (start_pixel + size_pixel > screen_height) {
-                size_pixel = screen_height - start_pixel;
-            }
-            
-            lv_obj_set_size(gradient_obj, screen_width, size_pixel);
-            lv_obj_set_pos(gradient_obj, 0, start_pixel);
-            
-        } else {
-            // Horizontal gradient - calculate precise boundaries
-            start_pixel = (start_pos * screen_width) / 100;
-            lv_coord_t end_pixel = (end_pos * screen_width) / 100;
-            size_pixel = end_pixel - start_pixel;
-            
-            // Add minimal overlap to prevent gaps but avoid scroll
-            if (i > 0) start_pixel -= 1;  // Minimal overlap with previous
-            if (i < stop_count - 2) {
-                size_pixel += 2;  // Small overlap with next
-            } else {
-                // Last segment - ensure it ends exactly at screen edge
-                size_pixel = screen_width - start_pixel;
-            }
-            
-            // Ensure we don't go negative or exceed screen bounds
-            if (start_pixel < 0) start_pixel = 0;
-            if (start_pixel + size_pixel > screen_width) {
-                size_pixel = screen_width - start_pixel;
-            }
-            
-            lv_obj_set_size(gradient_obj, size_pixel, screen_height);
-            lv_obj_set_pos(gradient_obj, start_pixel, 0);
-        }
-        
-        // Set gradient colors
-        lv_obj_set_style_bg_color(gradient_obj, stops[i].color, LV_PART_MAIN);
-        lv_obj_set_style_bg_grad_color(gradient_obj, stops[i + 1].color, LV_PART_MAIN);
-        lv_obj_set_style_bg_grad_dir(gradient_obj, grad_dir, LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(gradient_obj, LV_OPA_COVER, LV_PART_MAIN);
-        
-        // Ensure the object is positioned correctly
-        lv_obj_move_background(gradient_obj);
-    }
-    
     bsp_display_unlock();
 }
 
@@ -48,6 +48,68 @@ inline bool chinScreen_init_sd_card(int cs_pin = 5) {
     return true;
 }
 
+/////////////////////////////////////////////////////////////
+// Function: Read SD card files through LVGL (videos, fonts)
+/////////////////////////////////////////////////////////////
+// LVGL file system driver on the SD library: "D:/video.avi" is SD.open("/video.avi")
+#define CHINSCREEN_SD_FS_LETTER 'D'
+
+static void* chinScreen_sd_fs_open(lv_fs_drv_t* drv, const char* path, lv_fs_mode_t mode) {
+    LV_UNUSED(drv);
+    File f = SD.open(path, mode == LV_FS_MODE_WR ? FILE_WRITE : FILE_READ);
+    if (!f) return nullptr;
+    return new File(f);
+}
+
+static lv_fs_res_t chinScreen_sd_fs_close(lv_fs_drv_t* drv, void* file_p) {
+    LV_UNUSED(drv);
+    File* f = (File*)file_p;
+    f->close();
+    delete f;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t chinScreen_sd_fs_read(lv_fs_drv_t* drv, void* file_p, void* buf, uint32_t btr, uint32_t* br) {
+    LV_UNUSED(drv);
+    *br = ((File*)file_p)->read((uint8_t*)buf, btr);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t chinScreen_sd_fs_seek(lv_fs_drv_t* drv, void* file_p, uint32_t pos, lv_fs_whence_t whence) {
+    LV_UNUSED(drv);
+    SeekMode mode = whence == LV_FS_SEEK_CUR ? SeekCur : whence == LV_FS_SEEK_END ? SeekEnd : SeekSet;
+    return ((File*)file_p)->seek(pos, mode) ? LV_FS_RES_OK : LV_FS_RES_UNKNOWN;
+}
+
+static lv_fs_res_t chinScreen_sd_fs_tell(lv_fs_drv_t* drv, void* file_p, uint32_t* pos_p) {
+    LV_UNUSED(drv);
+    *pos_p = ((File*)file_p)->position();
+    return LV_FS_RES_OK;
+}
+
+inline void chinScreen_sd_fs_register() {
+    static lv_fs_drv_t drv;
+    if (drv.letter) return;
+
+    lv_fs_drv_init(&drv);
+    drv.letter = CHINSCREEN_SD_FS_LETTER;
+    drv.open_cb = chinScreen_sd_fs_open;
+    drv.close_cb = chinScreen_sd_fs_close;
+    drv.read_cb = chinScreen_sd_fs_read;
+    drv.seek_cb = chinScreen_sd_fs_seek;
+    drv.tell_cb = chinScreen_sd_fs_tell;
+    lv_fs_drv_register(&drv);
+}
+
+// "/video.avi" is on the SD card, paths with a drive letter ("S:/sd/video.avi") are kept
+inline void chinScreen_sd_path(const char* filepath, char* path, size_t len) {
+    if (filepath[0] && filepath[1] == ':') {
+        snprintf(path, len, "%s", filepath);
+    } else {
+        snprintf(path, len, "%c:%s", CHINSCREEN_SD_FS_LETTER, filepath);
+    }
+}
+
 /////////////////////////////////////////////////////////////
 // Function to preload images into memory for better performance
 /////////////////////////////////////////////////////////////
@@ -100,16 +162,7 @@ inline lv_obj_t* chinScreen_show_preloaded_image(int imageIndex,
     lv_img_set_src(img, preloaded_images[imageIndex]);
     
     // Position
-    lv_align_t align = LV_ALIGN_CENTER;
-    if (strcmp(vAlign, "top") == 0 && strcmp(hAlign, "left") == 0) align = LV_ALIGN_TOP_LEFT;
-    else if (strcmp(vAlign, "top") == 0 && strcmp(hAlign, "center") == 0) align = LV_ALIGN_TOP_MID;
-    else if (strcmp(vAlign, "top") == 0 && strcmp(hAlign, "right") == 0) align = LV_ALIGN_TOP_RIGHT;
-    else if (strcmp(vAlign, "middle") == 0 && strcmp(hAlign, "left") == 0) align = LV_ALIGN_LEFT_MID;
-    else if (strcmp(vAlign, "middle") == 0 && strcmp(hAlign, "center") == 0) align = LV_ALIGN_CENTER;
-    else if (strcmp(vAlign, "middle") == 0 && strcmp(hAlign, "right") == 0) align = LV_ALIGN_RIGHT_MID;
-    else if (strcmp(vAlign, "bottom") == 0 && strcmp(hAlign, "left") == 0) align = LV_ALIGN_BOTTOM_LEFT;
-    else if (strcmp(vAlign, "bottom") == 0 && strcmp(hAlign, "center") == 0) align = LV_ALIGN_BOTTOM_MID;
-    else if (strcmp(vAlign, "bottom") == 0 && strcmp(hAlign, "right") == 0) align = LV_ALIGN_BOTTOM_RIGHT;
+    lv_align_t align = chinScreen_resolve_align(vAlign, hAlign);
 
     lv_obj_align(img, align, 0, 0);
     bsp_display_unlock();
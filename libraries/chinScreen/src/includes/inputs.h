@@ -24,23 +24,129 @@
 /////////////////////////////////////////////////////////////
 typedef void (*chinScreen_btn_callback_t)(lv_event_t* e);
 
-// Initialize the display (panel, rotation, backlight)
-inline void init_display() {
-    Serial.println("Initialize panel device");
-
-    bsp_display_cfg_t cfg = {
-        .lvgl_port_cfg = ESP_LVGL_PORT_INIT_CONFIG(),
-        .buffer_size = EXAMPLE_LCD_QSPI_H_RES * EXAMPLE_LCD_QSPI_V_RES,
+/////////////////////////////////////////////////////////////
+// Display buffers
+/////////////////////////////////////////////////////////////
+#define CHINSCREEN_MEM_PSRAM     LVGL_PORT_MEM_PSRAM     // draw buffers in PSRAM (default)
+#define CHINSCREEN_MEM_INTERNAL  LVGL_PORT_MEM_INTERNAL  // draw buffers in internal RAM
+#define CHINSCREEN_MEM_DMA       LVGL_PORT_MEM_DMA       // draw buffers in internal DMA RAM
+
+typedef struct {
+    uint8_t draw_buffers;            // 1 or 2; with 2 LVGL renders while the other one is sent
+    uint32_t draw_buffer_px;         // pixels per draw buffer, H_RES * V_RES is a whole screen
+    uint32_t trans_px;               // pixels per transport chunk (2 chunks in internal DMA RAM), 0 = send from the draw buffer
+    lvgl_port_mem_caps_t draw_caps;  // CHINSCREEN_MEM_PSRAM, CHINSCREEN_MEM_INTERNAL or CHINSCREEN_MEM_DMA
+    bool full_refresh;               // redraw and send the whole screen on every change
+    bool async_flush;                // send from a separate task while LVGL renders
+} chinScreen_display_config_t;
+
+inline lv_disp_rot_t chinScreen_display_rotation() {
 #if LVGL_PORT_ROTATION_DEGREE == 90
-        .rotate = LV_DISP_ROT_90,
+    return LV_DISP_ROT_90;
 #elif LVGL_PORT_ROTATION_DEGREE == 270
-        .rotate = LV_DISP_ROT_270,
+    return LV_DISP_ROT_270;
 #elif LVGL_PORT_ROTATION_DEGREE == 180
-        .rotate = LV_DISP_ROT_180,
-#elif LVGL_PORT_ROTATION_DEGREE == 0
-        .rotate = LV_DISP_ROT_NONE,
+    return LV_DISP_ROT_180;
+#else
+    return LV_DISP_ROT_NONE;
 #endif
-    };
+}
+
+// What init_display() uses unless chinScreen_display_config() was called
+inline chinScreen_display_config_t chinScreen_display_default_config() {
+    const uint32_t screen_px = EXAMPLE_LCD_QSPI_H_RES * EXAMPLE_LCD_QSPI_V_RES;
+    const lv_disp_rot_t rot = chinScreen_display_rotation();
+
+    chinScreen_display_config_t cfg;
+    cfg.trans_px = screen_px / 10;
+    cfg.draw_caps = CHINSCREEN_MEM_PSRAM;
+#ifdef CHINSCREEN_FULL_REFRESH
+    // old behaviour: one full screen buffer, every change redraws and sends all pixels
+    cfg.draw_buffers = 1;
+    cfg.draw_buffer_px = screen_px;
+    cfg.full_refresh = true;
+    cfg.async_flush = false;
+#else
+    if (rot == LV_DISP_ROT_90 || rot == LV_DISP_ROT_270) {
+        // panel rows are LVGL columns here, LVGL can only render them full height from a full screen buffer
+        cfg.draw_buffers = 1;
+        cfg.draw_buffer_px = screen_px;
+    } else {
+        // partial refresh: two 1/10 screen buffers, only the changed rows are sent
+        cfg.draw_buffers = 2;
+        cfg.draw_buffer_px = screen_px / 10;
+    }
+    cfg.full_refresh = false;
+    cfg.async_flush = true;
+#endif
+    return cfg;
+}
+
+static chinScreen_display_config_t chinScreen_display_cfg = chinScreen_display_default_config();
+
+// Work out RAM footprint and bytes per flush of a configuration, without allocating anything
+inline lvgl_port_mem_plan_t chinScreen_display_plan(const chinScreen_display_config_t& cfg, bool print = true) {
+    const lv_disp_rot_t rot = chinScreen_display_rotation();
+    const bool swap = (rot == LV_DISP_ROT_90 || rot == LV_DISP_ROT_270);
+
+    lvgl_port_mem_cfg_t mem_cfg = {};
+    mem_cfg.hres = swap ? EXAMPLE_LCD_QSPI_V_RES : EXAMPLE_LCD_QSPI_H_RES;
+    mem_cfg.vres = swap ? EXAMPLE_LCD_QSPI_H_RES : EXAMPLE_LCD_QSPI_V_RES;
+    mem_cfg.bytes_per_pixel = sizeof(lv_color_t);
+    mem_cfg.buffer_size = cfg.draw_buffer_px;
+    mem_cfg.double_buffer = (cfg.draw_buffers > 1);
+    mem_cfg.buff_caps = cfg.draw_caps;
+    mem_cfg.trans_size = cfg.trans_px;
+    mem_cfg.sw_rotate = rot;
+    mem_cfg.full_refresh = cfg.full_refresh;
+
+    lvgl_port_mem_plan_t plan;
+    lvgl_port_mem_plan(&mem_cfg, &plan);
+
+    if (print) {
+        static const char* const caps_names[] = {"PSRAM", "internal RAM", "DMA RAM"};
+        Serial.printf("Display plan: %u x %u B draw buffer(s) in %s, 2 x %u B transport buffers\n",
+                      (unsigned)(mem_cfg.double_buffer ? 2 : 1), (unsigned)(cfg.draw_buffer_px * sizeof(lv_color_t)),
+                      caps_names[cfg.draw_caps], (unsigned)(cfg.trans_px * sizeof(lv_color_t)));
+        Serial.printf("  internal RAM %u B (%u B DMA), PSRAM %u B\n",
+                      (unsigned)plan.internal_bytes, (unsigned)plan.dma_bytes, (unsigned)plan.psram_bytes);
+        Serial.printf("  up to %u B in %u transfer(s) per flush, %u flush(es) per full screen\n",
+                      (unsigned)plan.bytes_per_flush, (unsigned)plan.chunks_per_flush, (unsigned)plan.flushes_per_frame);
+        if (plan.error) {
+            Serial.printf("  not usable: %s\n", plan.error);
+        }
+    }
+    return plan;
+}
+
+// Set the buffers init_display() allocates; call before init_display()
+inline bool chinScreen_display_config(const chinScreen_display_config_t& cfg) {
+    lvgl_port_mem_plan_t plan = chinScreen_display_plan(cfg, false);
+    if (plan.error) {
+        Serial.printf("chinScreen_display_config: %s\n", plan.error);
+        return false;
+    }
+    chinScreen_display_cfg = cfg;
+    return true;
+}
+
+// Initialize the display (panel, rotation, backlight)
+inline void init_display() {
+    Serial.println("Initialize panel device");
+
+    const chinScreen_display_config_t& dc = chinScreen_display_cfg;
+    const lvgl_port_cfg_t port_cfg = ESP_LVGL_PORT_INIT_CONFIG();
+    bsp_display_cfg_t cfg = {};
+    cfg.lvgl_port_cfg = port_cfg;
+    cfg.buffer_size = dc.draw_buffer_px;
+    cfg.double_buffer = (dc.draw_buffers > 1);
+    cfg.trans_size = dc.trans_px;
+    cfg.rotate = chinScreen_display_rotation();
+    cfg.flags.full_refresh = dc.full_refresh;
+    cfg.flags.async_flush = dc.async_flush;
+    cfg.flags.buff_spiram = (dc.draw_caps == CHINSCREEN_MEM_PSRAM);
+    cfg.flags.buff_internal = (dc.draw_caps == CHINSCREEN_MEM_INTERNAL);
+    cfg.flags.buff_dma = (dc.draw_caps == CHINSCREEN_MEM_DMA);
 
     bsp_display_start_with_config(&cfg);
     bsp_display_backlight_on();
@@ -176,16 +282,7 @@ inline lv_obj_t* chinScreen_numpad(const char* placeholder = "Enter number...",
     lv_obj_set_size(numpad_obj, 200, 200);
     
     // Position numpad
-    lv_align_t align = LV_ALIGN_CENTER;
-    if (strcmp(vAlign, "top") == 0 && strcmp(hAlign, "left") == 0) align = LV_ALIGN_TOP_LEFT;
-    else if (strcmp(vAlign, "top") == 0 && strcmp(hAlign, "center") == 0) align = LV_ALIGN_TOP_MID;
-    else if (strcmp(vAlign, "top") == 0 && strcmp(hAlign, "right") == 0) align = LV_ALIGN_TOP_RIGHT;
-    else if (strcmp(vAlign, "middle") == 0 && strcmp(hAlign, "left") == 0) align = LV_ALIGN_LEFT_MID;
-    else if (strcmp(vAlign, "middle") == 0 && strcmp(hAlign, "center") == 0) align = LV_ALIGN_CENTER;
-    else if (strcmp(vAlign, "middle") == 0 && strcmp(hAlign, "right") == 0) align = LV_ALIGN_RIGHT_MID;
-    else if (strcmp(vAlign, "bottom") == 0 && strcmp(hAlign, "left") == 0) align = LV_ALIGN_BOTTOM_LEFT;
-    else if (strcmp(vAlign, "bottom") == 0 && strcmp(hAlign, "center") == 0) align = LV_ALIGN_BOTTOM_MID;
-    else if (strcmp(vAlign, "bottom") == 0 && strcmp(hAlign, "right") == 0) align = LV_ALIGN_BOTTOM_RIGHT;
+    lv_align_t align = chinScreen_resolve_align(vAlign, hAlign);
     
     lv_obj_align(numpad_obj, align, 0, 20);
     
@@ -248,16 +345,7 @@ inline lv_obj_t* chinScreen_image_button(const char* imagePath,
     }
     
     // Position
-    lv_align_t align = LV_ALIGN_CENTER;
-    if (strcmp(vAlign, "top") == 0 && strcmp(hAlign, "left") == 0) align = LV_ALIGN_TOP_LEFT;
-    else if (strcmp(vAlign, "top") == 0 && strcmp(hAlign, "center") == 0) align = LV_ALIGN_TOP_MID;
-    else if (strcmp(vAlign, "top") == 0 && strcmp(hAlign, "right") == 0) align = LV_ALIGN_TOP_RIGHT;
-    else if (strcmp(vAlign, "middle") == 0 && strcmp(hAlign, "left") == 0) align = LV_ALIGN_LEFT_MID;
-    else if (strcmp(vAlign, "middle") == 0 && strcmp(hAlign, "center") == 0) align = LV_ALIGN_CENTER;
-    else if (strcmp(vAlign, "middle") == 0 && strcmp(hAlign, "right") == 0) align = LV_ALIGN_RIGHT_MID;
-    else if (strcmp(vAlign, "bottom") == 0 && strcmp(hAlign, "left") == 0) align = LV_ALIGN_BOTTOM_LEFT;
-    else if (strcmp(vAlign, "bottom") == 0 && strcmp(hAlign, "center") == 0) align = LV_ALIGN_BOTTOM_MID;
-    else if (strcmp(vAlign, "bottom") == 0 && strcmp(hAlign, "right") == 0) align = LV_ALIGN_BOTTOM_RIGHT;
+    lv_align_t align = chinScreen_resolve_align(vAlign, hAlign);
 
     lv_obj_align(imgBtn, align, 0, 0);
 
@@ -284,16 +372,7 @@ inline lv_obj_t* chinScreen_slider(int width, int height, int min_val, int max_v
     lv_obj_set_style_bg_color(slider, getColorByName(knobColorName), LV_PART_INDICATOR);
 
     // Position
-    lv_align_t align = LV_ALIGN_CENTER;
-    if (strcmp(vAlign, "top") == 0 && strcmp(hAlign, "left") == 0) align = LV_ALIGN_TOP_LEFT;
-    else if (strcmp(vAlign, "top") == 0 && strcmp(hAlign, "center") == 0) align = LV_ALIGN_TOP_MID;
-    else if (strcmp(vAlign, "top") == 0 && strcmp(hAlign, "right") == 0) align = LV_ALIGN_TOP_RIGHT;
-    else if (strcmp(vAlign, "middle") == 0 && strcmp(hAlign, "left") == 0) align = LV_ALIGN_LEFT_MID;
-    else if (strcmp(vAlign, "middle") == 0 && strcmp(hAlign, "center") == 0) align = LV_ALIGN_CENTER;
-    else if (strcmp(vAlign, "middle") == 0 && strcmp(hAlign, "right") == 0) align = LV_ALIGN_RIGHT_MID;
-    else if (strcmp(vAlign, "bottom") == 0 && strcmp(hAlign, "left") == 0) align = LV_ALIGN_BOTTOM_LEFT;
-    else if (strcmp(vAlign, "bottom") == 0 && strcmp(hAlign, "center") == 0) align = LV_ALIGN_BOTTOM_MID;
-    else if (strcmp(vAlign, "bottom") == 0 && strcmp(hAlign, "right") == 0) align = LV_ALIGN_BOTTOM_RIGHT;
+    lv_align_t align = chinScreen_resolve_align(vAlign, hAlign);
 
     lv_obj_align(slider, align, 0, 0);
 
@@ -320,16 +399,7 @@ inline lv_obj_t* chinScreen_toggle(bool initial_state = false,
     lv_obj_set_style_bg_color(sw, getColorByName(knobColorName), LV_PART_KNOB);
 
     // Position
-    lv_align_t align = LV_ALIGN_CENTER;
-    if (strcmp(vAlign, "top") == 0 && strcmp(hAlign, "left") == 0) align = LV_ALIGN_TOP_LEFT;
-    else if (strcmp(vAlign, "top") == 0 && strcmp(hAlign, "center") == 0) align = LV_ALIGN_TOP_MID;
-    else if (strcmp(vAlign, "top") == 0 && strcmp(hAlign, "right") == 0) align = LV_ALIGN_TOP_RIGHT;
-    else if (strcmp(vAlign, "middle") == 0 && strcmp(hAlign, "left") == 0) align = LV_ALIGN_LEFT_MID;
-    else if (strcmp(vAlign, "middle") == 0 && strcmp(hAlign, "center") == 0) align = LV_ALIGN_CENTER;
-    else if (strcmp(vAlign, "middle") == 0 && strcmp(hAlign, "right") == 0) align = LV_ALIGN_RIGHT_MID;
-    else if (strcmp(vAlign, "bottom") == 0 && strcmp(hAlign, "left") == 0) align = LV_ALIGN_BOTTOM_LEFT;
-    else if (strcmp(vAlign, "bottom") == 0 && strcmp(hAlign, "center") == 0) align = LV_ALIGN_BOTTOM_MID;
-    else if (strcmp(vAlign, "bottom") == 0 && strcmp(hAlign, "right") == 0) align = LV_ALIGN_BOTTOM_RIGHT;
+    lv_align_t align = chinScreen_resolve_align(vAlign, hAlign);
 
     lv_obj_align(sw, align, 0, 0);
 
@@ -74,6 +74,7 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
  *  STATIC VARIABLES
  **********************/
 static uint32_t px_num;
+static lv_refr_stat_t refr_stat;
 static lv_disp_t * disp_refr; /*Display being refreshed*/
 
 #if LV_USE_PERF_MONITOR
@@ -280,6 +281,11 @@ void _lv_refr_set_disp_refreshing(lv_disp_t * disp)
     disp_refr = disp;
 }
 
+const lv_refr_stat_t * lv_refr_get_stat(void)
+{
+    return &refr_stat;
+}
+
 /**
  * Called periodically to handle the refreshing
  * @param tmr pointer to the timer itself
@@ -587,6 +593,7 @@ static void refr_sync_areas(void)
 static void refr_invalid_areas(void)
 {
     px_num = 0;
+    lv_memset_00(&refr_stat, sizeof(refr_stat));
 
     if(disp_refr->inv_p == 0) return;
 
@@ -618,9 +625,12 @@ static void refr_invalid_areas(void)
             refr_area(&disp_refr->inv_areas[i]);
 
             px_num += lv_area_get_size(&disp_refr->inv_areas[i]);
+            refr_stat.area_num++;
         }
     }
 
+    refr_stat.px_num = px_num;
+
     disp_refr->rendering_in_progress = false;
 }
 
@@ -1324,6 +1334,7 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
         .y2 = area->y2 + drv->offset_y
     };
 
+    refr_stat.flush_num++;
     drv->flush_cb(drv, &offset_area, color_p);
 }
 
@@ -26,6 +26,15 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/**
+ * What the last refresh rendered
+ */
+typedef struct {
+    uint32_t area_num;      /**< Dirty areas rendered, after joining*/
+    uint32_t px_num;        /**< Pixels rendered*/
+    uint32_t flush_num;     /**< Calls of `flush_cb`*/
+} lv_refr_stat_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -85,6 +94,13 @@ lv_disp_t * _lv_refr_get_disp_refreshing(void);
  */
 void _lv_refr_set_disp_refreshing(lv_disp_t * disp);
 
+/**
+ * Get what the last refresh rendered.
+ * Complete in the `monitor_cb` of the display, updated while a refresh is in progress.
+ * @return pointer to the statistics of the last refresh
+ */
+const lv_refr_stat_t * lv_refr_get_stat(void);
+
 #if LV_USE_PERF_MONITOR
 /**
  * Reset FPS counter
@@ -30,6 +30,8 @@ static lv_res_t /* LV_ATTRIBUTE_FAST_MEM */ decode_and_draw(lv_draw_ctx_t * draw
                                                             const lv_area_t * coords, const void * src);
 
 static void show_error(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const char * msg);
+static bool can_read_into_buf(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * draw_dsc,
+                              const _lv_img_cache_entry_t * cdsc, lv_img_cf_t cf, const lv_area_t * area);
 static void draw_cleanup(_lv_img_cache_entry_t * cache);
 
 /**********************
@@ -309,6 +311,21 @@ static lv_res_t LV_ATTRIBUTE_FAST_MEM decode_and_draw(lv_draw_ctx_t * draw_ctx,
             return LV_RES_OK;
         }
 
+        /*If the pixels are only copied let the decoder write them straight into the draw buffer*/
+        if(can_read_into_buf(draw_ctx, draw_dsc, cdsc, cf, &mask_com)) {
+            lv_coord_t stride = lv_area_get_width(draw_ctx->buf_area);
+            lv_color_t * dest = (lv_color_t *)draw_ctx->buf + (mask_com.y1 - draw_ctx->buf_area->y1) * stride +
+                                (mask_com.x1 - draw_ctx->buf_area->x1);
+            lv_area_t area;
+            lv_area_copy(&area, &mask_com);
+            lv_area_move(&area, -coords->x1, -coords->y1);
+            if(lv_img_decoder_read_area(&cdsc->dec_dsc, &area, dest, stride) == LV_RES_OK) {
+                draw_cleanup(cdsc);
+                return LV_RES_OK;
+            }
+            LV_LOG_WARN("Image draw can't read the area, trying line by line");
+        }
+
         int32_t width = lv_area_get_width(&mask_com);
 
         uint8_t  * buf = lv_mem_buf_get(lv_area_get_width(&mask_com) *
@@ -364,6 +381,26 @@ static void show_error(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const
     lv_draw_label(draw_ctx, &label_dsc, coords, msg, NULL);
 }
 
+/**
+ * Check whether the pixels of an image only have to be copied to the draw buffer
+ */
+static bool can_read_into_buf(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * draw_dsc,
+                              const _lv_img_cache_entry_t * cdsc, lv_img_cf_t cf, const lv_area_t * area)
+{
+    if(cdsc->dec_dsc.decoder->read_area_cb == NULL) return false;
+    if(cf != LV_IMG_CF_TRUE_COLOR || draw_ctx->buf == NULL) return false;
+    if(draw_dsc->opa < LV_OPA_MAX || draw_dsc->recolor_opa > LV_OPA_MIN) return false;
+    if(draw_dsc->angle || draw_dsc->zoom != LV_IMG_ZOOM_NONE) return false;
+    if(draw_dsc->blend_mode != LV_BLEND_MODE_NORMAL) return false;
+    if(lv_draw_mask_is_any(area)) return false;
+
+    /*Layers with alpha and `set_px_cb` don't store plain `lv_color_t` pixels*/
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp == NULL || disp->driver->screen_transp || disp->driver->set_px_cb) return false;
+
+    return true;
+}
+
 static void draw_cleanup(_lv_img_cache_entry_t * cache)
 {
     /*Automatically close images with no caching*/
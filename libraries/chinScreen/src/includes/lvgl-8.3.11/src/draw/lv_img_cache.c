@@ -13,18 +13,17 @@
 #include "../hal/lv_hal_tick.h"
 #include "../misc/lv_gc.h"
 
+#ifdef LV_IMG_CACHE_ALLOC_INCLUDE
+    #include LV_IMG_CACHE_ALLOC_INCLUDE
+#endif
+
 /*********************
  *      DEFINES
  *********************/
-/*Decrement life with this value on every open*/
-#define LV_IMG_CACHE_AGING 1
-
-/*Boost life by this factor (multiply time_to_open with this value)*/
-#define LV_IMG_CACHE_LIFE_GAIN 1
-
-/*Don't let life to be greater than this limit because it would require a lot of time to
- * "die" from very high values*/
-#define LV_IMG_CACHE_LIFE_LIMIT 1000
+#ifndef LV_IMG_CACHE_ALLOC
+    #define LV_IMG_CACHE_ALLOC(size) lv_mem_alloc(size)
+    #define LV_IMG_CACHE_FREE(p)     lv_mem_free(p)
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -35,13 +34,24 @@
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static bool lv_img_cache_match(const void * src1, const void * src2);
+    static uint32_t cache_hash(const void * src, lv_color_t color, int32_t frame_id);
+    static uint32_t cache_entry_size(const lv_img_decoder_dsc_t * dsc);
+    static void cache_remove(_lv_img_cache_entry_t * entry);
+    static void cache_trim(uint32_t budget, const _lv_img_cache_entry_t * keep);
 #endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
-    static uint16_t entry_cnt;
+    static uint16_t entry_cnt;                      /*Allocated entries*/
+    static uint32_t bucket_mask;
+    static _lv_img_cache_entry_t ** buckets;        /*Behind the entries in the same allocation*/
+    static _lv_img_cache_entry_t * free_entries;
+    static _lv_img_cache_entry_t * lru_first;       /*Most recently used*/
+    static _lv_img_cache_entry_t * lru_last;        /*Evicted next*/
+    static uint32_t budget = LV_IMG_CACHE_DEF_BYTES;
+    static lv_img_cache_stats_t stats;
 #endif
 
 /**********************
@@ -62,8 +72,7 @@
  */
 _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, int32_t frame_id)
 {
-    /*Is the image cached?*/
-    _lv_img_cache_entry_t * cached_src = NULL;
+    _lv_img_cache_entry_t * cached_src;
 
 #if LV_IMG_CACHE_DEF_SIZE
     if(entry_cnt == 0) {
@@ -71,50 +80,47 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
         return NULL;
     }
 
-    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
-
-    /*Decrement all lifes. Make the entries older*/
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].life > INT32_MIN + LV_IMG_CACHE_AGING) {
-            cache[i].life -= LV_IMG_CACHE_AGING;
-        }
-    }
-
-    for(i = 0; i < entry_cnt; i++) {
-        if(color.full == cache[i].dec_dsc.color.full &&
-           frame_id == cache[i].dec_dsc.frame_id &&
-           lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            /*If opened increment its life.
-             *Image difficult to open should live longer to keep avoid frequent their recaching.
-             *Therefore increase `life` with `time_to_open`*/
-            cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
-            if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
-            LV_LOG_TRACE("image source found in the cache");
+    /*Is the image cached?*/
+    uint32_t hash = cache_hash(src, color, frame_id);
+    _lv_img_cache_entry_t ** bucket = &buckets[hash & bucket_mask];
+    for(cached_src = *bucket; cached_src != NULL; cached_src = cached_src->hash_next) {
+        if(cached_src->hash == hash &&
+           color.full == cached_src->dec_dsc.color.full &&
+           frame_id == cached_src->dec_dsc.frame_id &&
+           lv_img_cache_match(src, cached_src->dec_dsc.src)) {
             break;
         }
     }
 
-    /*The image is not cached then cache it now*/
-    if(cached_src) return cached_src;
-
-    /*Find an entry to reuse. Select the entry with the least life*/
-    cached_src = &cache[0];
-    for(i = 1; i < entry_cnt; i++) {
-        if(cache[i].life < cached_src->life) {
-            cached_src = &cache[i];
+    if(cached_src) {
+        /*Move it to the front of the LRU list*/
+        if(cached_src != lru_first) {
+            cached_src->prev->next = cached_src->next;
+            if(cached_src->next) cached_src->next->prev = cached_src->prev;
+            else lru_last = cached_src->prev;
+            cached_src->prev = NULL;
+            cached_src->next = lru_first;
+            lru_first->prev = cached_src;
+            lru_first = cached_src;
         }
+        stats.hits++;
+        LV_LOG_TRACE("image source found in the cache");
+        return cached_src;
     }
 
-    /*Close the decoder to reuse if it was opened (has a valid source)*/
-    if(cached_src->dec_dsc.src) {
-        lv_img_decoder_close(&cached_src->dec_dsc);
+    /*The image is not cached then cache it now, in the least recently used entry if all are taken*/
+    stats.misses++;
+    if(free_entries == NULL) {
+        cache_remove(lru_last);
+        stats.evictions++;
         LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
     }
     else {
         LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
     }
+    cached_src = free_entries;
+    free_entries = cached_src->hash_next;
+    lv_memset_00(cached_src, sizeof(_lv_img_cache_entry_t));
 #else
     cached_src = &LV_GC_ROOT(_lv_img_cache_single);
 #endif
@@ -124,12 +130,13 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
     if(open_res == LV_RES_INV) {
         LV_LOG_WARN("Image draw cannot open the image resource");
         lv_memset_00(cached_src, sizeof(_lv_img_cache_entry_t));
-        cached_src->life = INT32_MIN; /*Make the empty entry very "weak" to force its us*/
+#if LV_IMG_CACHE_DEF_SIZE
+        cached_src->hash_next = free_entries;
+        free_entries = cached_src;
+#endif
         return NULL;
     }
 
-    cached_src->life = 0;
-
     /*If `time_to_open` was not set in the open function set it here*/
     if(cached_src->dec_dsc.time_to_open == 0) {
         cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
@@ -137,6 +144,24 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
 
     if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
 
+#if LV_IMG_CACHE_DEF_SIZE
+    cached_src->hash = hash;
+    cached_src->size = cache_entry_size(&cached_src->dec_dsc);
+    cached_src->hash_next = *bucket;
+    *bucket = cached_src;
+
+    cached_src->next = lru_first;
+    if(lru_first) lru_first->prev = cached_src;
+    else lru_last = cached_src;
+    lru_first = cached_src;
+
+    stats.entry_cnt++;
+    stats.bytes += cached_src->size;
+
+    /*Stay in the budget, but keep the image that is about to be drawn*/
+    cache_trim(budget, cached_src);
+#endif
+
     return cached_src;
 }
 
@@ -156,19 +181,76 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
         /*Clean the cache before free it*/
         lv_img_cache_invalidate_src(NULL);
         lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
+        LV_GC_ROOT(_lv_img_cache_array) = NULL;
     }
+    entry_cnt = 0;
+    buckets = NULL;
+    free_entries = NULL;
+    if(new_entry_cnt == 0) return;
+
+    /*A power of two buckets, at least one per entry*/
+    uint32_t bucket_cnt = 1;
+    while(bucket_cnt < new_entry_cnt) bucket_cnt <<= 1;
 
     /*Reallocate the cache*/
-    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(_lv_img_cache_entry_t) * new_entry_cnt);
+    size_t entries_size = sizeof(_lv_img_cache_entry_t) * new_entry_cnt;
+    size_t alloc_size = entries_size + sizeof(_lv_img_cache_entry_t *) * bucket_cnt;
+    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(alloc_size);
     LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_img_cache_array));
-    if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
-        entry_cnt = 0;
-        return;
-    }
-    entry_cnt = new_entry_cnt;
+    if(LV_GC_ROOT(_lv_img_cache_array) == NULL) return;
 
     /*Clean the cache*/
-    lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), entry_cnt * sizeof(_lv_img_cache_entry_t));
+    lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), alloc_size);
+    entry_cnt = new_entry_cnt;
+    bucket_mask = bucket_cnt - 1;
+    buckets = (_lv_img_cache_entry_t **)((uint8_t *)LV_GC_ROOT(_lv_img_cache_array) + entries_size);
+
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        LV_GC_ROOT(_lv_img_cache_array)[i].hash_next = free_entries;
+        free_entries = &LV_GC_ROOT(_lv_img_cache_array)[i];
+    }
+#endif
+}
+
+/**
+ * Set how many bytes of decoded images the cache may keep.
+ * @param bytes the budget
+ */
+void lv_img_cache_set_budget(uint32_t bytes)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    budget = bytes;
+    cache_trim(budget, NULL);
+#else
+    LV_UNUSED(bytes);
+    LV_LOG_WARN("Can't change cache budget because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+#endif
+}
+
+/**
+ * Get the hit/miss/eviction counters and the current fill of the cache.
+ * @param stats store the statistics here
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats_out)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    *stats_out = stats;
+    stats_out->budget = budget;
+#else
+    lv_memset_00(stats_out, sizeof(lv_img_cache_stats_t));
+#endif
+}
+
+/**
+ * Clear the hit/miss/eviction counters.
+ */
+void lv_img_cache_reset_stats(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    stats.hits = 0;
+    stats.misses = 0;
+    stats.evictions = 0;
 #endif
 }
 
@@ -181,21 +263,27 @@ void lv_img_cache_invalidate_src(const void * src)
 {
     LV_UNUSED(src);
 #if LV_IMG_CACHE_DEF_SIZE
-    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
-
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
-            }
-
-            lv_memset_00(&cache[i], sizeof(_lv_img_cache_entry_t));
+    _lv_img_cache_entry_t * entry = lru_first;
+    while(entry) {
+        _lv_img_cache_entry_t * next = entry->next;
+        if(src == NULL || lv_img_cache_match(src, entry->dec_dsc.src)) {
+            cache_remove(entry);
         }
+        entry = next;
     }
 #endif
 }
 
+void * lv_img_cache_alloc(size_t size)
+{
+    return LV_IMG_CACHE_ALLOC(size);
+}
+
+void lv_img_cache_free(void * p)
+{
+    if(p) LV_IMG_CACHE_FREE(p);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -212,4 +300,61 @@ static bool lv_img_cache_match(const void * src1, const void * src2)
         return false;
     return strcmp(src1, src2) == 0;
 }
+
+static uint32_t cache_hash(const void * src, lv_color_t color, int32_t frame_id)
+{
+    /*Files by their path, everything else by address (FNV-1a)*/
+    uint32_t h = 2166136261u;
+#define IMG_HASH(v) h = (h ^ (uint32_t)(v)) * 16777619u
+    if(lv_img_src_get_type(src) == LV_IMG_SRC_FILE) {
+        const char * s;
+        for(s = src; *s; s++) IMG_HASH(*s);
+    }
+    else {
+        lv_uintptr_t p = (lv_uintptr_t)src;
+        IMG_HASH(p);
+        IMG_HASH((uint64_t)p >> 32);
+    }
+    IMG_HASH(color.full);
+    IMG_HASH(frame_id);
+#undef IMG_HASH
+    return h;
+}
+
+static uint32_t cache_entry_size(const lv_img_decoder_dsc_t * dsc)
+{
+    /*Only what the decoder allocated, not images decoded straight from a C array*/
+    if(dsc->img_data == NULL) return 0;
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE && dsc->img_data == ((const lv_img_dsc_t *)dsc->src)->data) return 0;
+    return lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf);
+}
+
+/*Close the image and give the entry back to the free list*/
+static void cache_remove(_lv_img_cache_entry_t * entry)
+{
+    _lv_img_cache_entry_t ** link = &buckets[entry->hash & bucket_mask];
+    while(*link != entry) link = &(*link)->hash_next;
+    *link = entry->hash_next;
+
+    if(entry->prev) entry->prev->next = entry->next;
+    else lru_first = entry->next;
+    if(entry->next) entry->next->prev = entry->prev;
+    else lru_last = entry->prev;
+
+    lv_img_decoder_close(&entry->dec_dsc);
+    stats.entry_cnt--;
+    stats.bytes -= entry->size;
+
+    lv_memset_00(entry, sizeof(_lv_img_cache_entry_t));
+    entry->hash_next = free_entries;
+    free_entries = entry;
+}
+
+static void cache_trim(uint32_t max_bytes, const _lv_img_cache_entry_t * keep)
+{
+    while(stats.bytes > max_bytes && lru_last != NULL && lru_last != keep) {
+        cache_remove(lru_last);
+        stats.evictions++;
+    }
+}
 #endif
@@ -27,16 +27,29 @@ extern "C" {
  * When loading images from the network it can take a long time to download and decode the image.
  *
  * To avoid repeating this heavy load images can be cached.
+ * Entries are found by a hash of (source, color, frame) and evicted least recently used first
+ * when either all entries are taken or the decoded images exceed the byte budget.
  */
-typedef struct {
+typedef struct _lv_img_cache_entry_t {
     lv_img_decoder_dsc_t dec_dsc; /**< Image information*/
 
-    /** Count the cache entries's life. Add `time_to_open` to `life` when the entry is used.
-     * Decrement all lifes by one every in every ::lv_img_cache_open.
-     * If life == 0 the entry can be reused*/
-    int32_t life;
+    /*Private*/
+    struct _lv_img_cache_entry_t * hash_next;   /**< Next entry in the same bucket (or free entry)*/
+    struct _lv_img_cache_entry_t * prev;        /**< Used more recently*/
+    struct _lv_img_cache_entry_t * next;        /**< Used less recently*/
+    uint32_t hash;
+    uint32_t size;                              /**< Bytes counted against the budget*/
 } _lv_img_cache_entry_t;
 
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;          /**< Images opened (decoded) by the cache*/
+    uint32_t evictions;       /**< Images closed to make room; invalidation is not counted*/
+    uint32_t entry_cnt;       /**< Images open now*/
+    uint32_t bytes;           /**< Their decoded size*/
+    uint32_t budget;          /**< Limit of `bytes`*/
+} lv_img_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -60,6 +73,40 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
  */
 void lv_img_cache_set_size(uint16_t new_slot_num);
 
+/**
+ * Set how many bytes of decoded images the cache may keep.
+ * Only memory the decoders allocate counts, e.g. a decoded PNG, not a C array in flash.
+ * The image being drawn is never evicted, so a single image larger than the budget still works.
+ * @param bytes the budget, `LV_IMG_CACHE_DEF_BYTES` by default
+ */
+void lv_img_cache_set_budget(uint32_t bytes);
+
+/**
+ * Get the hit/miss/eviction counters and the current fill of the cache.
+ * @param stats store the statistics here
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats);
+
+/**
+ * Clear the hit/miss/eviction counters.
+ */
+void lv_img_cache_reset_stats(void);
+
+/**
+ * Allocate memory for decoded pixels that will be kept in the cache.
+ * Decoders use it instead of `lv_mem_alloc()` so `LV_IMG_CACHE_ALLOC` can put images into
+ * external RAM.
+ * @param size size in bytes
+ * @return the memory or NULL
+ */
+void * lv_img_cache_alloc(size_t size);
+
+/**
+ * Free memory from `lv_img_cache_alloc()`.
+ * @param p the memory, can be NULL
+ */
+void lv_img_cache_free(void * p);
+
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
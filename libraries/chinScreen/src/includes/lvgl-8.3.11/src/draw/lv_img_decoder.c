@@ -181,6 +181,23 @@ lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_c
     return res;
 }
 
+/**
+ * Decode an area of an opened true color image into a buffer
+ * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
+ * @param area the area to decode, relative to the image
+ * @param buf the first pixel of `area` goes here
+ * @param stride number of pixels from a line of `buf` to the next
+ * @return LV_RES_OK: success; LV_RES_INV: an error occurred or the decoder has no `read_area_cb`
+ */
+lv_res_t lv_img_decoder_read_area(lv_img_decoder_dsc_t * dsc, const lv_area_t * area, lv_color_t * buf,
+                                  lv_coord_t stride)
+{
+    lv_res_t res = LV_RES_INV;
+    if(dsc->decoder->read_area_cb) res = dsc->decoder->read_area_cb(dsc->decoder, dsc, area, buf, stride);
+
+    return res;
+}
+
 /**
  * Close a decoding session
  * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
@@ -253,6 +270,16 @@ void lv_img_decoder_set_read_line_cb(lv_img_decoder_t * decoder, lv_img_decoder_
     decoder->read_line_cb = read_line_cb;
 }
 
+/**
+ * Set a callback to decode an area of an image straight into the draw buffer
+ * @param decoder pointer to an image decoder
+ * @param read_area_cb a function to decode an area of an image
+ */
+void lv_img_decoder_set_read_area_cb(lv_img_decoder_t * decoder, lv_img_decoder_read_area_f_t read_area_cb)
+{
+    decoder->read_area_cb = read_area_cb;
+}
+
 /**
  * Set a callback to close a decoding session. E.g. close files and free other resources.
  * @param decoder pointer to an image decoder
@@ -75,6 +75,20 @@ typedef lv_res_t (*lv_img_decoder_open_f_t)(struct _lv_img_decoder_t * decoder,
 typedef lv_res_t (*lv_img_decoder_read_line_f_t)(struct _lv_img_decoder_t * decoder, struct _lv_img_decoder_dsc_t * dsc,
                                                  lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf);
 
+/**
+ * Decode an area of a true color image straight into `buf`, e.g. into the draw buffer.
+ * Optional, used instead of `read_line_cb` when the pixels are only copied, i.e. no opacity,
+ * recolor, transformation or mask is applied to them.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ * @param area the area to decode, relative to the image
+ * @param buf the first pixel of `area` goes here
+ * @param stride number of pixels from a line of `buf` to the next
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+typedef lv_res_t (*lv_img_decoder_read_area_f_t)(struct _lv_img_decoder_t * decoder, struct _lv_img_decoder_dsc_t * dsc,
+                                                 const lv_area_t * area, lv_color_t * buf, lv_coord_t stride);
+
 /**
  * Close the pending decoding. Free resources etc.
  * @param decoder pointer to the decoder the function associated with
@@ -88,6 +102,7 @@ typedef struct _lv_img_decoder_t {
     lv_img_decoder_open_f_t open_cb;
     lv_img_decoder_read_line_f_t read_line_cb;
     lv_img_decoder_close_f_t close_cb;
+    lv_img_decoder_read_area_f_t read_area_cb;
 
 #if LV_USE_USER_DATA
     void * user_data;
@@ -179,6 +194,17 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
 lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
                                   uint8_t * buf);
 
+/**
+ * Decode an area of an opened true color image into a buffer
+ * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
+ * @param area the area to decode, relative to the image
+ * @param buf the first pixel of `area` goes here
+ * @param stride number of pixels from a line of `buf` to the next
+ * @return LV_RES_OK: success; LV_RES_INV: an error occurred or the decoder has no `read_area_cb`
+ */
+lv_res_t lv_img_decoder_read_area(lv_img_decoder_dsc_t * dsc, const lv_area_t * area, lv_color_t * buf,
+                                  lv_coord_t stride);
+
 /**
  * Close a decoding session
  * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
@@ -218,6 +244,13 @@ void lv_img_decoder_set_open_cb(lv_img_decoder_t * decoder, lv_img_decoder_open_
  */
 void lv_img_decoder_set_read_line_cb(lv_img_decoder_t * decoder, lv_img_decoder_read_line_f_t read_line_cb);
 
+/**
+ * Set a callback to decode an area of an image straight into the draw buffer
+ * @param decoder pointer to an image decoder
+ * @param read_area_cb a function to decode an area of an image
+ */
+void lv_img_decoder_set_read_area_cb(lv_img_decoder_t * decoder, lv_img_decoder_read_area_f_t read_area_cb);
+
 /**
  * Set a callback to close a decoding session. E.g. close files and free other resources.
  * @param decoder pointer to an image decoder
@@ -14,6 +14,9 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include "lv_draw_sw_blend.h"
+#include "lv_draw_sw_blend_565.h"
+#include "lv_draw_sw_zoom_cache.h"
+#include "lv_draw_sw_glyph_cache.h"
 #include "../lv_draw.h"
 #include "../../misc/lv_area.h"
 #include "../../misc/lv_color.h"
@@ -43,6 +46,14 @@ typedef struct {
     uint32_t has_alpha : 1;
 } lv_draw_sw_layer_ctx_t;
 
+/**How `lv_draw_sw_transform()` zooms when there is no rotation*/
+enum {
+    LV_DRAW_SW_TRANSFORM_GENERIC,       /**Transform every pixel, like with rotation*/
+    LV_DRAW_SW_TRANSFORM_SEPARABLE,     /**Step the columns and rows separately. Gives the same pixels*/
+    LV_DRAW_SW_TRANSFORM_INTEGER,       /**Also repeat the pixels of 2x, 3x... and average n x n pixels for 1/n*/
+};
+typedef uint8_t lv_draw_sw_transform_path_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -80,6 +91,18 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
                           lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
                           const lv_draw_img_dsc_t * draw_dsc, lv_img_cf_t cf, lv_color_t * cbuf, lv_opa_t * abuf);
 
+/**
+ * Set how images are zoomed without rotation. The default depends on `LV_DRAW_SW_TRANSFORM_INT_ZOOM`.
+ * @param path      `LV_DRAW_SW_TRANSFORM_GENERIC/SEPARABLE/INTEGER`
+ */
+void lv_draw_sw_transform_set_path(lv_draw_sw_transform_path_t path);
+
+/**
+ * Get how images are zoomed without rotation.
+ * @return          `LV_DRAW_SW_TRANSFORM_GENERIC/SEPARABLE/INTEGER`
+ */
+lv_draw_sw_transform_path_t lv_draw_sw_transform_get_path(void);
+
 struct _lv_draw_layer_ctx_t * lv_draw_sw_layer_create(struct _lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx,
                                                       lv_draw_layer_flags_t flags);
 
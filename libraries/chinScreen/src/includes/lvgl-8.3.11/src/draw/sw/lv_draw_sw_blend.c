@@ -10,6 +10,8 @@
 #include "../../misc/lv_math.h"
 #include "../../hal/lv_hal_disp.h"
 #include "../../core/lv_refr.h"
+#include "../../misc/lv_thread.h"
+#include "lv_draw_sw_blend_565.h"
 
 /*********************
  *      DEFINES
@@ -30,6 +32,13 @@ static void /* LV_ATTRIBUTE_FAST_MEM */ fill_normal(lv_color_t * dest_buf, const
                                                     lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa,
                                                     const lv_opa_t * mask, lv_coord_t mask_stride);
 
+static void /* LV_ATTRIBUTE_FAST_MEM */ fill_opa_ref(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                     lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa);
+
+static void /* LV_ATTRIBUTE_FAST_MEM */ fill_mask_ref(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                      lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa,
+                                                      const lv_opa_t * mask, lv_coord_t mask_stride);
+
 
 #if LV_COLOR_SCREEN_TRANSP
 static void /* LV_ATTRIBUTE_FAST_MEM */ fill_argb(lv_color_t * dest_buf, const lv_area_t * dest_area,
@@ -51,6 +60,15 @@ static void /* LV_ATTRIBUTE_FAST_MEM */ map_normal(lv_color_t * dest_buf, const
                                                    lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask,
                                                    lv_coord_t mask_stride);
 
+static void /* LV_ATTRIBUTE_FAST_MEM */ map_opa_ref(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                    lv_coord_t dest_stride, const lv_color_t * src_buf,
+                                                    lv_coord_t src_stride, lv_opa_t opa);
+
+static void /* LV_ATTRIBUTE_FAST_MEM */ map_mask_ref(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                     lv_coord_t dest_stride, const lv_color_t * src_buf,
+                                                     lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask,
+                                                     lv_coord_t mask_stride);
+
 #if LV_COLOR_SCREEN_TRANSP
 static void /* LV_ATTRIBUTE_FAST_MEM */ map_argb(lv_color_t * dest_buf, const lv_area_t * dest_area,
                                                  lv_coord_t dest_stride, const lv_color_t * src_buf,
@@ -69,10 +87,31 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
 static inline lv_color_t color_blend_true_color_multiply(lv_color_t fg, lv_color_t bg, lv_opa_t opa);
 #endif /*LV_DRAW_COMPLEX*/
 
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+
+const lv_draw_sw_blend_kernels_t lv_draw_sw_blend_kernels_ref = {
+    .fill_opa = fill_opa_ref,
+    .fill_mask = fill_mask_ref,
+    .map_opa = map_opa_ref,
+    .map_mask = map_mask_ref,
+};
+
 /**********************
  *  STATIC VARIABLES
  **********************/
 
+#if LV_DRAW_SW_BLEND_565_VECTOR
+    #define BLEND_KERNELS_DEF (&lv_draw_sw_blend_565_vector_kernels)
+#elif LV_DRAW_SW_BLEND_565
+    #define BLEND_KERNELS_DEF (&lv_draw_sw_blend_565_swar_kernels)
+#else
+    #define BLEND_KERNELS_DEF (&lv_draw_sw_blend_kernels_ref)
+#endif
+
+static const lv_draw_sw_blend_kernels_t * blend_kernels = BLEND_KERNELS_DEF;
+
 /**********************
  *      MACROS
  **********************/
@@ -206,6 +245,15 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx,
     }
 }
 
+void lv_draw_sw_blend_set_kernels(const lv_draw_sw_blend_kernels_t * kernels)
+{
+    blend_kernels = kernels ? kernels : BLEND_KERNELS_DEF;
+}
+
+const lv_draw_sw_blend_kernels_t * lv_draw_sw_blend_get_kernels(void)
+{
+    return blend_kernels;
+}
 
 /**********************
  *   STATIC FUNCTIONS
@@ -248,15 +296,12 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
                                               lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa,
                                               const lv_opa_t * mask, lv_coord_t mask_stride)
 {
-    int32_t w = lv_area_get_width(dest_area);
-    int32_t h = lv_area_get_height(dest_area);
-
-    int32_t x;
-    int32_t y;
-
     /*No mask*/
     if(mask == NULL) {
         if(opa >= LV_OPA_MAX) {
+            int32_t w = lv_area_get_width(dest_area);
+            int32_t h = lv_area_get_height(dest_area);
+            int32_t y;
             for(y = 0; y < h; y++) {
                 lv_color_fill(dest_buf, color, w);
                 dest_buf += dest_stride;
@@ -264,117 +309,142 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
         }
         /*Has opacity*/
         else {
-            lv_color_t last_dest_color = lv_color_black();
-            lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
+            blend_kernels->fill_opa(dest_buf, dest_area, dest_stride, color, opa);
+        }
+    }
+    /*Masked*/
+    else {
+        blend_kernels->fill_mask(dest_buf, dest_area, dest_stride, color, opa, mask, mask_stride);
+    }
+}
+
+static LV_ATTRIBUTE_FAST_MEM void fill_opa_ref(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                               lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+
+    int32_t x;
+    int32_t y;
+
+    lv_color_t last_dest_color = lv_color_black();
+    lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
 
 #if LV_COLOR_MIX_ROUND_OFS == 0 && LV_COLOR_DEPTH == 16
-            /*lv_color_mix work with an optimized algorithm with 16 bit color depth.
-             *However, it introduces some rounded error on opa.
-             *Introduce the same error here too to make lv_color_premult produces the same result */
-            opa = (uint32_t)((uint32_t)opa + 4) >> 3;
-            opa = opa << 3;
+    /*lv_color_mix work with an optimized algorithm with 16 bit color depth.
+     *However, it introduces some rounded error on opa.
+     *Introduce the same error here too to make lv_color_premult produces the same result */
+    opa = (uint32_t)((uint32_t)opa + 4) >> 3;
+    opa = opa << 3;
 #endif
 
-            uint16_t color_premult[3];
-            lv_color_premult(color, opa, color_premult);
-            lv_opa_t opa_inv = 255 - opa;
+    uint16_t color_premult[3];
+    lv_color_premult(color, opa, color_premult);
+    lv_opa_t opa_inv = 255 - opa;
 
-            for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    if(last_dest_color.full != dest_buf[x].full) {
-                        last_dest_color = dest_buf[x];
-                        last_res_color = lv_color_mix_premult(color_premult, dest_buf[x], opa_inv);
-                    }
-                    dest_buf[x] = last_res_color;
-                }
-                dest_buf += dest_stride;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            if(last_dest_color.full != dest_buf[x].full) {
+                last_dest_color = dest_buf[x];
+                last_res_color = lv_color_mix_premult(color_premult, dest_buf[x], opa_inv);
             }
+            dest_buf[x] = last_res_color;
         }
+        dest_buf += dest_stride;
     }
-    /*Masked*/
-    else {
+}
+
+static LV_ATTRIBUTE_FAST_MEM void fill_mask_ref(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa,
+                                                const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+
+    int32_t x;
+    int32_t y;
+
 #if LV_COLOR_DEPTH == 16
-        uint32_t c32 = color.full + ((uint32_t)color.full << 16);
+    uint32_t c32 = color.full + ((uint32_t)color.full << 16);
 #endif
-        /*Only the mask matters*/
-        if(opa >= LV_OPA_MAX) {
-            int32_t x_end4 = w - 4;
-            for(y = 0; y < h; y++) {
-                for(x = 0; x < w && ((lv_uintptr_t)(mask) & 0x3); x++) {
-                    FILL_NORMAL_MASK_PX(color)
-                }
+    /*Only the mask matters*/
+    if(opa >= LV_OPA_MAX) {
+        int32_t x_end4 = w - 4;
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w && ((lv_uintptr_t)(mask) & 0x3); x++) {
+                FILL_NORMAL_MASK_PX(color)
+            }
 
-                for(; x <= x_end4; x += 4) {
-                    uint32_t mask32 = *((uint32_t *)mask);
-                    if(mask32 == 0xFFFFFFFF) {
+            for(; x <= x_end4; x += 4) {
+                uint32_t mask32 = *((uint32_t *)mask);
+                if(mask32 == 0xFFFFFFFF) {
 #if LV_COLOR_DEPTH == 16
-                        if((lv_uintptr_t)dest_buf & 0x3) {
-                            *(dest_buf + 0) = color;
-                            uint32_t * d = (uint32_t *)(dest_buf + 1);
-                            *d = c32;
-                            *(dest_buf + 3) = color;
-                        }
-                        else {
-                            uint32_t * d = (uint32_t *)dest_buf;
-                            *d = c32;
-                            *(d + 1) = c32;
-                        }
-#else
-                        dest_buf[0] = color;
-                        dest_buf[1] = color;
-                        dest_buf[2] = color;
-                        dest_buf[3] = color;
-#endif
-                        dest_buf += 4;
-                        mask += 4;
-                    }
-                    else if(mask32) {
-                        FILL_NORMAL_MASK_PX(color)
-                        FILL_NORMAL_MASK_PX(color)
-                        FILL_NORMAL_MASK_PX(color)
-                        FILL_NORMAL_MASK_PX(color)
+                    if((lv_uintptr_t)dest_buf & 0x3) {
+                        *(dest_buf + 0) = color;
+                        uint32_t * d = (uint32_t *)(dest_buf + 1);
+                        *d = c32;
+                        *(dest_buf + 3) = color;
                     }
                     else {
-                        mask += 4;
-                        dest_buf += 4;
+                        uint32_t * d = (uint32_t *)dest_buf;
+                        *d = c32;
+                        *(d + 1) = c32;
                     }
+#else
+                    dest_buf[0] = color;
+                    dest_buf[1] = color;
+                    dest_buf[2] = color;
+                    dest_buf[3] = color;
+#endif
+                    dest_buf += 4;
+                    mask += 4;
                 }
-
-                for(; x < w ; x++) {
+                else if(mask32) {
+                    FILL_NORMAL_MASK_PX(color)
+                    FILL_NORMAL_MASK_PX(color)
+                    FILL_NORMAL_MASK_PX(color)
                     FILL_NORMAL_MASK_PX(color)
                 }
-                dest_buf += (dest_stride - w);
-                mask += (mask_stride - w);
+                else {
+                    mask += 4;
+                    dest_buf += 4;
+                }
+            }
+
+            for(; x < w ; x++) {
+                FILL_NORMAL_MASK_PX(color)
             }
+            dest_buf += (dest_stride - w);
+            mask += (mask_stride - w);
         }
-        /*With opacity*/
-        else {
-            /*Buffer the result color to avoid recalculating the same color*/
-            lv_color_t last_dest_color;
-            lv_color_t last_res_color;
-            lv_opa_t last_mask = LV_OPA_TRANSP;
-            last_dest_color.full = dest_buf[0].full;
-            last_res_color.full = dest_buf[0].full;
-            lv_opa_t opa_tmp = LV_OPA_TRANSP;
+    }
+    /*With opacity*/
+    else {
+        /*Buffer the result color to avoid recalculating the same color*/
+        lv_color_t last_dest_color;
+        lv_color_t last_res_color;
+        lv_opa_t last_mask = LV_OPA_TRANSP;
+        last_dest_color.full = dest_buf[0].full;
+        last_res_color.full = dest_buf[0].full;
+        lv_opa_t opa_tmp = LV_OPA_TRANSP;
 
-            for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    if(*mask) {
-                        if(*mask != last_mask) opa_tmp = *mask == LV_OPA_COVER ? opa :
-                                                             (uint32_t)((uint32_t)(*mask) * opa) >> 8;
-                        if(*mask != last_mask || last_dest_color.full != dest_buf[x].full) {
-                            if(opa_tmp == LV_OPA_COVER) last_res_color = color;
-                            else last_res_color = lv_color_mix(color, dest_buf[x], opa_tmp);
-                            last_mask = *mask;
-                            last_dest_color.full = dest_buf[x].full;
-                        }
-                        dest_buf[x] = last_res_color;
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                if(*mask) {
+                    if(*mask != last_mask) opa_tmp = *mask == LV_OPA_COVER ? opa :
+                                                         (uint32_t)((uint32_t)(*mask) * opa) >> 8;
+                    if(*mask != last_mask || last_dest_color.full != dest_buf[x].full) {
+                        if(opa_tmp == LV_OPA_COVER) last_res_color = color;
+                        else last_res_color = lv_color_mix(color, dest_buf[x], opa_tmp);
+                        last_mask = *mask;
+                        last_dest_color.full = dest_buf[x].full;
                     }
-                    mask++;
+                    dest_buf[x] = last_res_color;
                 }
-                dest_buf += dest_stride;
-                mask += (mask_stride - w);
+                mask++;
             }
+            dest_buf += dest_stride;
+            mask += (mask_stride - w);
         }
     }
 }
@@ -409,10 +479,11 @@ static inline void set_px_argb(uint8_t * buf, lv_color_t color, lv_opa_t opa)
 static inline void set_px_argb_blend(uint8_t * buf, lv_color_t color, lv_opa_t opa, lv_color_t (*blend_fp)(lv_color_t,
                                                                                                            lv_color_t, lv_opa_t))
 {
-    static lv_color_t last_dest_color;
-    static lv_color_t last_src_color;
-    static lv_color_t last_res_color;
-    static uint32_t last_opa = 0xffff; /*Set to an invalid value for first*/
+    /*One memo per thread drawing tiles*/
+    static LV_THREAD_LOCAL lv_color_t last_dest_color;
+    static LV_THREAD_LOCAL lv_color_t last_src_color;
+    static LV_THREAD_LOCAL lv_color_t last_res_color;
+    static LV_THREAD_LOCAL uint32_t last_opa = 0xffff; /*Set to an invalid value for first*/
 
     lv_color_t bg_color;
 
@@ -649,15 +720,12 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
                                              lv_coord_t mask_stride)
 
 {
-    int32_t w = lv_area_get_width(dest_area);
-    int32_t h = lv_area_get_height(dest_area);
-
-    int32_t x;
-    int32_t y;
-
     /*Simple fill (maybe with opacity), no masking*/
     if(mask == NULL) {
         if(opa >= LV_OPA_MAX) {
+            int32_t w = lv_area_get_width(dest_area);
+            int32_t h = lv_area_get_height(dest_area);
+            int32_t y;
             for(y = 0; y < h; y++) {
                 lv_memcpy(dest_buf, src_buf, w * sizeof(lv_color_t));
                 dest_buf += dest_stride;
@@ -665,75 +733,102 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
             }
         }
         else {
-            for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], opa);
-                }
-                dest_buf += dest_stride;
-                src_buf += src_stride;
-            }
+            blend_kernels->map_opa(dest_buf, dest_area, dest_stride, src_buf, src_stride, opa);
         }
     }
     /*Masked*/
     else {
-        /*Only the mask matters*/
-        if(opa > LV_OPA_MAX) {
-            int32_t x_end4 = w - 4;
+        blend_kernels->map_mask(dest_buf, dest_area, dest_stride, src_buf, src_stride, opa, mask, mask_stride);
+    }
+}
 
-            for(y = 0; y < h; y++) {
-                const lv_opa_t * mask_tmp_x = mask;
+static void LV_ATTRIBUTE_FAST_MEM map_opa_ref(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                              lv_coord_t dest_stride, const lv_color_t * src_buf,
+                                              lv_coord_t src_stride, lv_opa_t opa)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+
+    int32_t x;
+    int32_t y;
+
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], opa);
+        }
+        dest_buf += dest_stride;
+        src_buf += src_stride;
+    }
+}
+
+static void LV_ATTRIBUTE_FAST_MEM map_mask_ref(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                               lv_coord_t dest_stride, const lv_color_t * src_buf,
+                                               lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask,
+                                               lv_coord_t mask_stride)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+
+    int32_t x;
+    int32_t y;
+
+    /*Only the mask matters*/
+    if(opa > LV_OPA_MAX) {
+        int32_t x_end4 = w - 4;
+
+        for(y = 0; y < h; y++) {
+            const lv_opa_t * mask_tmp_x = mask;
 #if 0
-                for(x = 0; x < w; x++) {
-                    MAP_NORMAL_MASK_PX(x);
-                }
+            for(x = 0; x < w; x++) {
+                MAP_NORMAL_MASK_PX(x);
+            }
 #else
-                for(x = 0; x < w && ((lv_uintptr_t)mask_tmp_x & 0x3); x++) {
-                    MAP_NORMAL_MASK_PX(x)
-                }
+            for(x = 0; x < w && ((lv_uintptr_t)mask_tmp_x & 0x3); x++) {
+                MAP_NORMAL_MASK_PX(x)
+            }
 
-                uint32_t * mask32 = (uint32_t *)mask_tmp_x;
-                for(; x < x_end4; x += 4) {
-                    if(*mask32) {
-                        if((*mask32) == 0xFFFFFFFF) {
-                            dest_buf[x] = src_buf[x];
-                            dest_buf[x + 1] = src_buf[x + 1];
-                            dest_buf[x + 2] = src_buf[x + 2];
-                            dest_buf[x + 3] = src_buf[x + 3];
-                        }
-                        else {
-                            mask_tmp_x = (const lv_opa_t *)mask32;
-                            MAP_NORMAL_MASK_PX(x)
-                            MAP_NORMAL_MASK_PX(x + 1)
-                            MAP_NORMAL_MASK_PX(x + 2)
-                            MAP_NORMAL_MASK_PX(x + 3)
-                        }
+            uint32_t * mask32 = (uint32_t *)mask_tmp_x;
+            for(; x < x_end4; x += 4) {
+                if(*mask32) {
+                    if((*mask32) == 0xFFFFFFFF) {
+                        dest_buf[x] = src_buf[x];
+                        dest_buf[x + 1] = src_buf[x + 1];
+                        dest_buf[x + 2] = src_buf[x + 2];
+                        dest_buf[x + 3] = src_buf[x + 3];
+                    }
+                    else {
+                        mask_tmp_x = (const lv_opa_t *)mask32;
+                        MAP_NORMAL_MASK_PX(x)
+                        MAP_NORMAL_MASK_PX(x + 1)
+                        MAP_NORMAL_MASK_PX(x + 2)
+                        MAP_NORMAL_MASK_PX(x + 3)
                     }
-                    mask32++;
                 }
+                mask32++;
+            }
 
-                mask_tmp_x = (const lv_opa_t *)mask32;
-                for(; x < w ; x++) {
-                    MAP_NORMAL_MASK_PX(x)
-                }
-#endif
-                dest_buf += dest_stride;
-                src_buf += src_stride;
-                mask += mask_stride;
+            mask_tmp_x = (const lv_opa_t *)mask32;
+            for(; x < w ; x++) {
+                MAP_NORMAL_MASK_PX(x)
             }
+#endif
+            dest_buf += dest_stride;
+            src_buf += src_stride;
+            mask += mask_stride;
         }
-        /*Handle opa and mask values too*/
-        else {
-            for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    if(mask[x]) {
-                        lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
-                        dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], opa_tmp);
-                    }
+    }
+    /*Handle opa and mask values too*/
+    else {
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                if(mask[x]) {
+                    lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
+                    dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], opa_tmp);
                 }
-                dest_buf += dest_stride;
-                src_buf += src_stride;
-                mask += mask_stride;
             }
+            dest_buf += dest_stride;
+            src_buf += src_stride;
+            mask += mask_stride;
         }
     }
 }
@@ -40,6 +40,33 @@ typedef struct {
 
 struct _lv_draw_ctx_t;
 
+/**
+ * The inner loops of the normal blend mode when there is something to mix.
+ * A set has to give exactly the same pixels as `lv_draw_sw_blend_kernels_ref`.
+ * All of them work on `dest_area` sized areas; the buffers point to its first pixel.
+ */
+typedef struct {
+    /**Fill with `color` on `opa` (`opa < LV_OPA_MAX`), no mask*/
+    void (*fill_opa)(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
+                     lv_color_t color, lv_opa_t opa);
+
+    /**Fill with `color` on `opa` through `mask`*/
+    void (*fill_mask)(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
+                      lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride);
+
+    /**Copy `src_buf` on `opa` (`opa < LV_OPA_MAX`), no mask*/
+    void (*map_opa)(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
+                    const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa);
+
+    /**Copy `src_buf` on `opa` through `mask`*/
+    void (*map_mask)(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
+                     const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
+                     const lv_opa_t * mask, lv_coord_t mask_stride);
+} lv_draw_sw_blend_kernels_t;
+
+/**The plain C kernels working with `lv_color_mix()` on every pixel*/
+extern const lv_draw_sw_blend_kernels_t lv_draw_sw_blend_kernels_ref;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -59,6 +86,19 @@ void lv_draw_sw_blend(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_d
 void /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_sw_blend_basic(struct _lv_draw_ctx_t * draw_ctx,
                                                         const lv_draw_sw_blend_dsc_t * dsc);
 
+/**
+ * Select the kernels used by the normal blend mode, e.g. a hardware specific set of the port.
+ * Should be called when nothing is being drawn.
+ * @param kernels       pointer to a static kernel set, or NULL to use the fastest built-in one
+ */
+void lv_draw_sw_blend_set_kernels(const lv_draw_sw_blend_kernels_t * kernels);
+
+/**
+ * Get the kernels used by the normal blend mode.
+ * @return              pointer to the kernel set in use
+ */
+const lv_draw_sw_blend_kernels_t * lv_draw_sw_blend_get_kernels(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,665 @@
+/**
+ * @file lv_draw_sw_blend_565.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_blend_565.h"
+#include "../../misc/lv_math.h"
+#include "../../misc/lv_mem.h"
+#include <string.h>
+
+#if LV_DRAW_SW_BLEND_565
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*G in the upper half, R and B in the lower half of a word, with room for `* mix` above each*/
+#define MIX_SPREAD_MASK     0x07E0F81FU
+
+/*Below this many pixels building the look-up tables of the fill costs more than they save*/
+#define FILL_LUT_MIN_PX     128
+
+#if LV_COLOR_16_SWAP
+#define SWAP16(x)           ((uint16_t)((uint16_t)(x) << 8 | (uint16_t)(x) >> 8))
+#define SWAP16X2(x)         ((((x) & 0x00FF00FFU) << 8) | (((x) >> 8) & 0x00FF00FFU))
+#else
+#define SWAP16(x)           (x)
+#define SWAP16X2(x)         (x)
+#endif
+
+/*The two pixels of a 32 bit word in memory order*/
+#if LV_BIG_ENDIAN_SYSTEM
+#define PAIR(p0, p1)        (((uint32_t)(p0) << 16) | (uint32_t)(p1))
+#define PAIR_0(w)           ((w) >> 16)
+#define PAIR_1(w)           ((w) & 0xFFFFU)
+#else
+#define PAIR(p0, p1)        ((uint32_t)(p0) | ((uint32_t)(p1) << 16))
+#define PAIR_0(w)           ((w) & 0xFFFFU)
+#define PAIR_1(w)           ((w) >> 16)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*The premultiplied fill of every channel value, already shifted and swapped to their place*/
+typedef struct {
+    uint16_t r[32];
+    uint16_t g[64];
+    uint16_t b[32];
+} fill_lut_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void /* LV_ATTRIBUTE_FAST_MEM */ fill_opa_swar(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                      lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa);
+
+static void /* LV_ATTRIBUTE_FAST_MEM */ fill_mask_swar(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                       lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa,
+                                                       const lv_opa_t * mask, lv_coord_t mask_stride);
+
+static void /* LV_ATTRIBUTE_FAST_MEM */ map_opa_swar(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                     lv_coord_t dest_stride, const lv_color_t * src_buf,
+                                                     lv_coord_t src_stride, lv_opa_t opa);
+
+static void /* LV_ATTRIBUTE_FAST_MEM */ map_mask_swar(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                      lv_coord_t dest_stride, const lv_color_t * src_buf,
+                                                      lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask,
+                                                      lv_coord_t mask_stride);
+
+#if LV_DRAW_SW_BLEND_565_VECTOR
+static void /* LV_ATTRIBUTE_FAST_MEM */ fill_opa_vector(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                        lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa);
+
+static void /* LV_ATTRIBUTE_FAST_MEM */ fill_mask_vector(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                         lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa,
+                                                         const lv_opa_t * mask, lv_coord_t mask_stride);
+
+static void /* LV_ATTRIBUTE_FAST_MEM */ map_opa_vector(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                       lv_coord_t dest_stride, const lv_color_t * src_buf,
+                                                       lv_coord_t src_stride, lv_opa_t opa);
+
+static void /* LV_ATTRIBUTE_FAST_MEM */ map_mask_vector(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                        lv_coord_t dest_stride, const lv_color_t * src_buf,
+                                                        lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask,
+                                                        lv_coord_t mask_stride);
+#endif
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+
+const lv_draw_sw_blend_kernels_t lv_draw_sw_blend_565_swar_kernels = {
+    .fill_opa = fill_opa_swar,
+    .fill_mask = fill_mask_swar,
+    .map_opa = map_opa_swar,
+    .map_mask = map_mask_swar,
+};
+
+#if LV_DRAW_SW_BLEND_565_VECTOR
+const lv_draw_sw_blend_kernels_t lv_draw_sw_blend_565_vector_kernels = {
+    .fill_opa = fill_opa_vector,
+    .fill_mask = fill_mask_vector,
+    .map_opa = map_opa_vector,
+    .map_mask = map_mask_vector,
+};
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*----------------------------------------------------------------------
+ * Pixel helpers. "Native" is RGB565 in a register, "memory" is as it's
+ * stored in the buffer (swapped with LV_COLOR_16_SWAP)
+ *---------------------------------------------------------------------*/
+
+static inline uint32_t spread(uint32_t c)
+{
+    return (c | (c << 16)) & MIX_SPREAD_MASK;
+}
+
+/*lv_color_mix() of native colors with the already rounded `mix` (0..32)*/
+static inline uint32_t mix_spread(uint32_t fg_spread, uint32_t bg, uint32_t mix)
+{
+    uint32_t bg_spread = spread(bg);
+    uint32_t res = ((((fg_spread - bg_spread) * mix) >> 5) + bg_spread) & MIX_SPREAD_MASK;
+    return (res >> 16 | res) & 0xFFFFU;
+}
+
+/*Mix one memory format pixel towards a spread native color*/
+static inline uint16_t mix_px(uint32_t fg_spread, uint32_t bg, uint32_t mix)
+{
+    return (uint16_t)SWAP16(mix_spread(fg_spread, SWAP16(bg), mix));
+}
+
+/*Mix the two memory format pixels of `bg` towards the ones of `fg`*/
+static inline uint32_t mix_pair(uint32_t fg, uint32_t bg, uint32_t mix0, uint32_t mix1)
+{
+    fg = SWAP16X2(fg);
+    bg = SWAP16X2(bg);
+    uint32_t res0 = mix_spread(spread(PAIR_0(fg)), PAIR_0(bg), mix0);
+    uint32_t res1 = mix_spread(spread(PAIR_1(fg)), PAIR_1(bg), mix1);
+    return SWAP16X2(PAIR(res0, res1));
+}
+
+/**
+ * The mix of a mask value as the reference kernels calculate it.
+ * @param mask      the mask value
+ * @param opa       LV_OPA_COVER if only the mask matters, else the opacity
+ * @param cover     masks from this on use `opa` as it is
+ * @return          the mix ratio of lv_color_mix(), 0..32
+ */
+static inline uint32_t mask_mix(uint32_t mask, uint32_t opa, uint32_t cover)
+{
+    if(opa == LV_OPA_COVER) return (mask + 4) >> 3;
+
+    uint32_t opa_tmp = mask >= cover ? opa : (mask * opa) >> 8;
+    return (opa_tmp + 4) >> 3;
+}
+
+/*Four mask values in a word, for checking them at once. The mask can be at any address*/
+static inline uint32_t mask_4(const lv_opa_t * mask)
+{
+    uint32_t m4;
+    memcpy(&m4, mask, sizeof(m4));
+    return m4;
+}
+
+/*lv_color_mix_premult() of a native pixel, in memory format*/
+static inline uint16_t premult_px(const uint16_t premult[3], uint32_t opa_inv, uint32_t px)
+{
+    uint32_t r = LV_UDIV255(premult[0] + (px >> 11) * opa_inv);
+    uint32_t g = LV_UDIV255(premult[1] + ((px >> 5) & 0x3F) * opa_inv);
+    uint32_t b = LV_UDIV255(premult[2] + (px & 0x1F) * opa_inv);
+    return (uint16_t)SWAP16((r << 11) | (g << 5) | b);
+}
+
+/*The opacity lv_color_mix() really uses, like in the reference fill*/
+static inline lv_opa_t fill_opa_round(lv_opa_t opa)
+{
+    return (lv_opa_t)((((uint32_t)opa + 4) >> 3) << 3);
+}
+
+static void fill_premult_init(lv_color_t color, lv_opa_t opa, uint16_t premult[3])
+{
+    uint32_t c = SWAP16((uint32_t)color.full);
+    premult[0] = (uint16_t)((c >> 11) * opa);
+    premult[1] = (uint16_t)(((c >> 5) & 0x3F) * opa);
+    premult[2] = (uint16_t)((c & 0x1F) * opa);
+}
+
+/**
+ * The reference fill remembers the last pixel starting from black with the result of `lv_color_mix()`
+ * instead of the premultiplied mix, so the black pixels before the first other one get that.
+ * @param d         pointer to the row
+ * @param w         width of the row
+ * @param black_res memory format result for the leading black pixels
+ * @param lead      set to false if a not black pixel is found
+ * @return          index of the first pixel still to blend
+ */
+static inline int32_t fill_lead_black(uint16_t * d, int32_t w, uint16_t black_res, bool * lead)
+{
+    int32_t x = 0;
+    while(x < w && d[x] == 0) d[x++] = black_res;
+    if(x < w) *lead = false;
+    return x;
+}
+
+/*----------------------------------------------------------------------
+ * Two pixels in a word
+ *---------------------------------------------------------------------*/
+
+static void fill_lut_init(fill_lut_t * lut, lv_color_t color, lv_opa_t opa)
+{
+    uint16_t premult[3];
+    fill_premult_init(color, opa, premult);
+    uint32_t opa_inv = 255 - opa;
+
+    /*Mix every value of a channel with 0 in the other two channels*/
+    uint32_t i;
+    for(i = 0; i < 32; i++) {
+        uint32_t r = LV_UDIV255(premult[0] + i * opa_inv);
+        uint32_t b = LV_UDIV255(premult[2] + i * opa_inv);
+        lut->r[i] = (uint16_t)SWAP16(r << 11);
+        lut->b[i] = (uint16_t)SWAP16(b);
+    }
+    for(i = 0; i < 64; i++) {
+        uint32_t g = LV_UDIV255(premult[1] + i * opa_inv);
+        lut->g[i] = (uint16_t)SWAP16(g << 5);
+    }
+}
+
+/*The premultiplied fill of a native pixel, in memory format*/
+static inline uint32_t fill_lut_px(const fill_lut_t * lut, uint32_t px)
+{
+    return lut->r[px >> 11] | lut->g[(px >> 5) & 0x3F] | lut->b[px & 0x1F];
+}
+
+static LV_ATTRIBUTE_FAST_MEM void fill_opa_swar(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+
+    if(w * h < FILL_LUT_MIN_PX) {
+        lv_draw_sw_blend_kernels_ref.fill_opa(dest_buf, dest_area, dest_stride, color, opa);
+        return;
+    }
+
+    uint16_t black_res = lv_color_mix(color, lv_color_black(), opa).full;
+    fill_lut_t lut;
+    fill_lut_init(&lut, color, fill_opa_round(opa));
+
+    /*Same colors are frequent in the background so remember the last pair*/
+    uint32_t last_dest = 0;
+    uint32_t last_res = PAIR(fill_lut_px(&lut, 0), fill_lut_px(&lut, 0));
+    bool lead = true;
+
+    uint16_t * d = (uint16_t *)dest_buf;
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        x = 0;
+        if(lead) x = fill_lead_black(d, w, black_res, &lead);
+
+        if(x < w && ((lv_uintptr_t)(d + x) & 0x2)) {
+            d[x] = (uint16_t)fill_lut_px(&lut, SWAP16((uint32_t)d[x]));
+            x++;
+        }
+
+        for(; x < w - 1; x += 2) {
+            uint32_t * d32 = (uint32_t *)(d + x);
+            if(*d32 != last_dest) {
+                last_dest = *d32;
+                uint32_t px = SWAP16X2(last_dest);
+                last_res = PAIR(fill_lut_px(&lut, PAIR_0(px)), fill_lut_px(&lut, PAIR_1(px)));
+            }
+            *d32 = last_res;
+        }
+
+        if(x < w) d[x] = (uint16_t)fill_lut_px(&lut, SWAP16((uint32_t)d[x]));
+
+        d += dest_stride;
+    }
+}
+
+static LV_ATTRIBUTE_FAST_MEM void fill_mask_swar(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                 lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa,
+                                                 const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+
+    if(opa >= LV_OPA_MAX) opa = LV_OPA_COVER;
+
+    uint32_t fg_spread = spread(SWAP16((uint32_t)color.full));
+    uint32_t c32 = PAIR(color.full, color.full);
+
+    uint16_t * d = (uint16_t *)dest_buf;
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        x = 0;
+        if(w > 0 && ((lv_uintptr_t)d & 0x2)) {
+            d[0] = mix_px(fg_spread, d[0], mask_mix(mask[0], opa, LV_OPA_COVER));
+            x++;
+        }
+
+        /*Skip or cover 4 pixels at once. Mixing them one by one is faster than
+         *packing pairs when every pixel has its own mix*/
+        for(; x < w - 3; x += 4) {
+            uint32_t m4 = mask_4(mask + x);
+            if(m4 == 0) continue;
+
+            uint32_t * d32 = (uint32_t *)(d + x);
+            if(m4 == 0xFFFFFFFF && opa == LV_OPA_COVER) {
+                d32[0] = c32;
+                d32[1] = c32;
+                continue;
+            }
+
+            d[x] = mix_px(fg_spread, d[x], mask_mix(mask[x], opa, LV_OPA_COVER));
+            d[x + 1] = mix_px(fg_spread, d[x + 1], mask_mix(mask[x + 1], opa, LV_OPA_COVER));
+            d[x + 2] = mix_px(fg_spread, d[x + 2], mask_mix(mask[x + 2], opa, LV_OPA_COVER));
+            d[x + 3] = mix_px(fg_spread, d[x + 3], mask_mix(mask[x + 3], opa, LV_OPA_COVER));
+        }
+
+        for(; x < w; x++) d[x] = mix_px(fg_spread, d[x], mask_mix(mask[x], opa, LV_OPA_COVER));
+
+        d += dest_stride;
+        mask += mask_stride;
+    }
+}
+
+static LV_ATTRIBUTE_FAST_MEM void map_opa_swar(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                               lv_coord_t dest_stride, const lv_color_t * src_buf,
+                                               lv_coord_t src_stride, lv_opa_t opa)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+
+    uint32_t mix = ((uint32_t)opa + 4) >> 3;
+    if(mix == 0) return;
+
+    uint16_t * d = (uint16_t *)dest_buf;
+    const uint16_t * s = (const uint16_t *)src_buf;
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        if(mix == 32) {
+            lv_memcpy(d, s, w * sizeof(lv_color_t));
+        }
+        else {
+            x = 0;
+            if(w > 0 && ((lv_uintptr_t)d & 0x2)) {
+                d[0] = mix_px(spread(SWAP16((uint32_t)s[0])), d[0], mix);
+                x++;
+            }
+
+            /*The source might be misaligned to the destination so read it by pixels*/
+            for(; x < w - 1; x += 2) {
+                uint32_t * d32 = (uint32_t *)(d + x);
+                *d32 = mix_pair(PAIR(s[x], s[x + 1]), *d32, mix, mix);
+            }
+
+            if(x < w) d[x] = mix_px(spread(SWAP16((uint32_t)s[x])), d[x], mix);
+        }
+
+        d += dest_stride;
+        s += src_stride;
+    }
+}
+
+static LV_ATTRIBUTE_FAST_MEM void map_mask_swar(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                lv_coord_t dest_stride, const lv_color_t * src_buf,
+                                                lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask,
+                                                lv_coord_t mask_stride)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+
+    if(opa > LV_OPA_MAX) opa = LV_OPA_COVER;
+
+    uint16_t * d = (uint16_t *)dest_buf;
+    const uint16_t * s = (const uint16_t *)src_buf;
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        x = 0;
+        if(w > 0 && ((lv_uintptr_t)d & 0x2)) {
+            d[0] = mix_px(spread(SWAP16((uint32_t)s[0])), d[0], mask_mix(mask[0], opa, LV_OPA_MAX));
+            x++;
+        }
+
+        for(; x < w - 3; x += 4) {
+            uint32_t m4 = mask_4(mask + x);
+            if(m4 == 0) continue;
+
+            uint32_t * d32 = (uint32_t *)(d + x);
+            if(m4 == 0xFFFFFFFF && opa == LV_OPA_COVER) {
+                d32[0] = PAIR(s[x], s[x + 1]);
+                d32[1] = PAIR(s[x + 2], s[x + 3]);
+                continue;
+            }
+
+            d[x] = mix_px(spread(SWAP16(s[x])), d[x], mask_mix(mask[x], opa, LV_OPA_MAX));
+            d[x + 1] = mix_px(spread(SWAP16(s[x + 1])), d[x + 1], mask_mix(mask[x + 1], opa, LV_OPA_MAX));
+            d[x + 2] = mix_px(spread(SWAP16(s[x + 2])), d[x + 2], mask_mix(mask[x + 2], opa, LV_OPA_MAX));
+            d[x + 3] = mix_px(spread(SWAP16(s[x + 3])), d[x + 3], mask_mix(mask[x + 3], opa, LV_OPA_MAX));
+        }
+
+        for(; x < w; x++) {
+            d[x] = mix_px(spread(SWAP16((uint32_t)s[x])), d[x], mask_mix(mask[x], opa, LV_OPA_MAX));
+        }
+
+        d += dest_stride;
+        s += src_stride;
+        mask += mask_stride;
+    }
+}
+
+/*----------------------------------------------------------------------
+ * Eight pixels in a vector
+ *---------------------------------------------------------------------*/
+
+#if LV_DRAW_SW_BLEND_565_VECTOR
+
+typedef uint16_t vu16_t __attribute__((vector_size(16)));
+typedef int16_t vi16_t __attribute__((vector_size(16)));
+typedef uint8_t vu8_t __attribute__((vector_size(8)));
+
+static inline vu16_t v_load(const void * p)
+{
+    vu16_t v;
+    __builtin_memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void v_store(void * p, vu16_t v)
+{
+    __builtin_memcpy(p, &v, sizeof(v));
+}
+
+static inline vu16_t v_load_mask(const lv_opa_t * p)
+{
+    vu8_t m;
+    __builtin_memcpy(&m, p, sizeof(m));
+    return __builtin_convertvector(m, vu16_t);
+}
+
+/*Memory format to native and back*/
+static inline vu16_t v_swap(vu16_t v)
+{
+#if LV_COLOR_16_SWAP
+    return (v << 8) | (v >> 8);
+#else
+    return v;
+#endif
+}
+
+/*`((fg - bg) * mix >> 5) + bg` on every channel is what the spread words of lv_color_mix() give*/
+static inline vu16_t v_mix(vu16_t fg, vu16_t bg, vi16_t mix)
+{
+    vi16_t fg_r = (vi16_t)(fg >> 11);
+    vi16_t fg_g = (vi16_t)((fg >> 5) & 0x3F);
+    vi16_t fg_b = (vi16_t)(fg & 0x1F);
+    vi16_t bg_r = (vi16_t)(bg >> 11);
+    vi16_t bg_g = (vi16_t)((bg >> 5) & 0x3F);
+    vi16_t bg_b = (vi16_t)(bg & 0x1F);
+
+    vu16_t r = (vu16_t)((((fg_r - bg_r) * mix) >> 5) + bg_r);
+    vu16_t g = (vu16_t)((((fg_g - bg_g) * mix) >> 5) + bg_g);
+    vu16_t b = (vu16_t)((((fg_b - bg_b) * mix) >> 5) + bg_b);
+    return (r << 11) | (g << 5) | b;
+}
+
+/*mask_mix() of 8 mask values*/
+static inline vi16_t v_mask_mix(vu16_t mask, uint16_t opa, uint16_t cover)
+{
+    vu16_t opa_tmp;
+    if(opa == LV_OPA_COVER) {
+        opa_tmp = mask;
+    }
+    else {
+        vu16_t opa_v = (vu16_t){0} + opa;
+        vu16_t cover_v = (vu16_t){0} + cover;
+        vi16_t full = (vi16_t)(mask >= cover_v);
+        opa_tmp = (opa_v & (vu16_t)full) | (((mask * opa) >> 8) & (vu16_t)~full);
+    }
+    return (vi16_t)((opa_tmp + 4) >> 3);
+}
+
+/*floor(x / 255) without division, exact up to 65534 so for all the premultiplied sums*/
+static inline vu16_t v_div255(vu16_t x)
+{
+    return (x + 1 + (x >> 8)) >> 8;
+}
+
+static LV_ATTRIBUTE_FAST_MEM void fill_opa_vector(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                  lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+
+    uint16_t black_res = lv_color_mix(color, lv_color_black(), opa).full;
+    opa = fill_opa_round(opa);
+    uint16_t premult[3];
+    fill_premult_init(color, opa, premult);
+    uint32_t opa_inv = 255 - opa;
+
+    vu16_t premult_r = (vu16_t){0} + premult[0];
+    vu16_t premult_g = (vu16_t){0} + premult[1];
+    vu16_t premult_b = (vu16_t){0} + premult[2];
+    bool lead = true;
+
+    uint16_t * d = (uint16_t *)dest_buf;
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        x = 0;
+        if(lead) x = fill_lead_black(d, w, black_res, &lead);
+
+        for(; x <= w - 8; x += 8) {
+            vu16_t px = v_swap(v_load(d + x));
+            vu16_t r = v_div255(premult_r + (px >> 11) * (uint16_t)opa_inv);
+            vu16_t g = v_div255(premult_g + ((px >> 5) & 0x3F) * (uint16_t)opa_inv);
+            vu16_t b = v_div255(premult_b + (px & 0x1F) * (uint16_t)opa_inv);
+            v_store(d + x, v_swap((r << 11) | (g << 5) | b));
+        }
+
+        for(; x < w; x++) d[x] = premult_px(premult, opa_inv, SWAP16((uint32_t)d[x]));
+
+        d += dest_stride;
+    }
+}
+
+static LV_ATTRIBUTE_FAST_MEM void fill_mask_vector(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                   lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa,
+                                                   const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+
+    if(opa >= LV_OPA_MAX) opa = LV_OPA_COVER;
+
+    uint32_t fg_spread = spread(SWAP16((uint32_t)color.full));
+    vu16_t fg = (vu16_t){0} + (uint16_t)SWAP16((uint32_t)color.full);
+    vu16_t c = (vu16_t){0} + color.full;
+
+    uint16_t * d = (uint16_t *)dest_buf;
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x <= w - 8; x += 8) {
+            uint64_t mask64;
+            __builtin_memcpy(&mask64, mask + x, sizeof(mask64));
+            if(mask64 == 0) continue;
+            if(mask64 == UINT64_MAX && opa == LV_OPA_COVER) {
+                v_store(d + x, c);
+                continue;
+            }
+
+            vi16_t mix = v_mask_mix(v_load_mask(mask + x), opa, LV_OPA_COVER);
+            v_store(d + x, v_swap(v_mix(fg, v_swap(v_load(d + x)), mix)));
+        }
+
+        for(; x < w; x++) d[x] = mix_px(fg_spread, d[x], mask_mix(mask[x], opa, LV_OPA_COVER));
+
+        d += dest_stride;
+        mask += mask_stride;
+    }
+}
+
+static LV_ATTRIBUTE_FAST_MEM void map_opa_vector(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                 lv_coord_t dest_stride, const lv_color_t * src_buf,
+                                                 lv_coord_t src_stride, lv_opa_t opa)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+
+    uint32_t mix = ((uint32_t)opa + 4) >> 3;
+    if(mix == 0) return;
+
+    vi16_t mix_v = (vi16_t){0} + (int16_t)mix;
+
+    uint16_t * d = (uint16_t *)dest_buf;
+    const uint16_t * s = (const uint16_t *)src_buf;
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        if(mix == 32) {
+            lv_memcpy(d, s, w * sizeof(lv_color_t));
+        }
+        else {
+            for(x = 0; x <= w - 8; x += 8) {
+                v_store(d + x, v_swap(v_mix(v_swap(v_load(s + x)), v_swap(v_load(d + x)), mix_v)));
+            }
+
+            for(; x < w; x++) d[x] = mix_px(spread(SWAP16((uint32_t)s[x])), d[x], mix);
+        }
+
+        d += dest_stride;
+        s += src_stride;
+    }
+}
+
+static LV_ATTRIBUTE_FAST_MEM void map_mask_vector(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                  lv_coord_t dest_stride, const lv_color_t * src_buf,
+                                                  lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask,
+                                                  lv_coord_t mask_stride)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+
+    if(opa > LV_OPA_MAX) opa = LV_OPA_COVER;
+
+    uint16_t * d = (uint16_t *)dest_buf;
+    const uint16_t * s = (const uint16_t *)src_buf;
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x <= w - 8; x += 8) {
+            uint64_t mask64;
+            __builtin_memcpy(&mask64, mask + x, sizeof(mask64));
+            if(mask64 == 0) continue;
+            if(mask64 == UINT64_MAX && opa == LV_OPA_COVER) {
+                v_store(d + x, v_load(s + x));
+                continue;
+            }
+
+            vi16_t mix = v_mask_mix(v_load_mask(mask + x), opa, LV_OPA_MAX);
+            v_store(d + x, v_swap(v_mix(v_swap(v_load(s + x)), v_swap(v_load(d + x)), mix)));
+        }
+
+        for(; x < w; x++) {
+            d[x] = mix_px(spread(SWAP16((uint32_t)s[x])), d[x], mask_mix(mask[x], opa, LV_OPA_MAX));
+        }
+
+        d += dest_stride;
+        s += src_stride;
+        mask += mask_stride;
+    }
+}
+
+#endif /*LV_DRAW_SW_BLEND_565_VECTOR*/
+
+#endif /*LV_DRAW_SW_BLEND_565*/
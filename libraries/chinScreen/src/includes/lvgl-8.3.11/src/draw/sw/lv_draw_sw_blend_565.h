@@ -0,0 +1,65 @@
+/**
+ * @file lv_draw_sw_blend_565.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_BLEND_565_H
+#define LV_DRAW_SW_BLEND_565_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_blend.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*The kernels reproduce the optimized RGB565 `lv_color_mix()`, so only that is supported*/
+#if LV_USE_DRAW_SW_BLEND_565 && LV_COLOR_DEPTH == 16 && LV_COLOR_MIX_ROUND_OFS == 0
+#define LV_DRAW_SW_BLEND_565 1
+#else
+#define LV_DRAW_SW_BLEND_565 0
+#endif
+
+/*The vector kernels are written with GCC's generic vectors which are lowered to SSE2 or NEON*/
+#define LV_DRAW_SW_BLEND_565_VECTOR 0
+#if LV_DRAW_SW_BLEND_565
+#if LV_DRAW_SW_BLEND_565_SIMD && defined(__GNUC__) && (defined(__SSE2__) || defined(__ARM_NEON))
+#undef LV_DRAW_SW_BLEND_565_VECTOR
+#define LV_DRAW_SW_BLEND_565_VECTOR 1
+#endif
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LV_DRAW_SW_BLEND_565
+/**Two pixels per 32 bit word, transparent and covering masks 4 pixels at once, look-up tables for the
+ *premultiplied fill. Plain C for any CPU*/
+extern const lv_draw_sw_blend_kernels_t lv_draw_sw_blend_565_swar_kernels;
+#endif
+
+#if LV_DRAW_SW_BLEND_565_VECTOR
+/**Mix 8 pixels in 128 bit vectors*/
+extern const lv_draw_sw_blend_kernels_t lv_draw_sw_blend_565_vector_kernels;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_BLEND_565_H*/
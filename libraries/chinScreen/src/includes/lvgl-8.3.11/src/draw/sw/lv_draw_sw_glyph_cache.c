@@ -0,0 +1,263 @@
+/**
+ * @file lv_draw_sw_glyph_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_glyph_cache.h"
+#include "../../misc/lv_mem.h"
+#include "../../misc/lv_log.h"
+#include "../../misc/lv_printf.h"
+
+#ifdef LV_IMG_CACHE_ALLOC_INCLUDE
+    #include LV_IMG_CACHE_ALLOC_INCLUDE
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef LV_IMG_CACHE_ALLOC
+    #define LV_IMG_CACHE_ALLOC(size) lv_mem_alloc(size)
+    #define LV_IMG_CACHE_FREE(p)     lv_mem_free(p)
+#endif
+
+#define GLYPH_BUCKET_CNT    256     /*A power of two, a label heavy screen uses a few hundred glyphs*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct _glyph_entry_t {
+    struct _glyph_entry_t * hash_next;  /*Next entry in the same bucket*/
+    struct _glyph_entry_t * prev;       /*Used more recently*/
+    struct _glyph_entry_t * next;       /*Used less recently*/
+    const lv_font_t * font;
+    uint32_t letter;
+    uint32_t hash;
+    uint32_t size;                      /*Bytes counted against the budget*/
+    lv_font_glyph_dsc_t dsc;
+    /*`box_w` x `box_h` opacities follow*/
+} glyph_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t glyph_hash(const lv_font_t * font, uint32_t letter);
+static glyph_entry_t * glyph_create(const lv_font_t * font, uint32_t letter, uint32_t hash);
+static void glyph_expand(const lv_font_glyph_dsc_t * g, const uint8_t * src, uint8_t * dest);
+static void cache_remove(glyph_entry_t * entry);
+static void cache_trim(uint32_t max_bytes);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static glyph_entry_t * buckets[GLYPH_BUCKET_CNT];
+static glyph_entry_t * lru_first;       /*Most recently used*/
+static glyph_entry_t * lru_last;        /*Evicted next*/
+static uint32_t budget = LV_DRAW_SW_GLYPH_CACHE_DEF_BYTES;
+static lv_draw_sw_glyph_cache_stats_t stats;
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+/*The opacity tables of lv_draw_sw_letter.c, so cached glyphs draw with the same opacities*/
+extern const uint8_t _lv_bpp1_opa_table[2];
+extern const uint8_t _lv_bpp2_opa_table[4];
+extern const uint8_t _lv_bpp4_opa_table[16];
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+bool _lv_draw_sw_glyph_cache_get(const lv_font_t * font, uint32_t letter, lv_font_glyph_dsc_t * g,
+                                 const uint8_t ** map)
+{
+    if(budget == 0 || font == NULL) return false;
+
+    uint32_t hash = glyph_hash(font, letter);
+    glyph_entry_t * entry;
+    for(entry = buckets[hash & (GLYPH_BUCKET_CNT - 1)]; entry != NULL; entry = entry->hash_next) {
+        if(entry->font == font && entry->letter == letter) break;
+    }
+
+    if(entry) {
+        /*Move it to the front of the LRU list*/
+        if(entry != lru_first) {
+            entry->prev->next = entry->next;
+            if(entry->next) entry->next->prev = entry->prev;
+            else lru_last = entry->prev;
+            entry->prev = NULL;
+            entry->next = lru_first;
+            lru_first->prev = entry;
+            lru_first = entry;
+        }
+        stats.hits++;
+    }
+    else {
+        entry = glyph_create(font, letter, hash);
+        if(entry == NULL) return false;
+        stats.misses++;
+    }
+
+    *g = entry->dsc;
+    *map = (const uint8_t *)(entry + 1);
+    return true;
+}
+
+void lv_draw_sw_glyph_cache_set_budget(uint32_t bytes)
+{
+    budget = bytes;
+    cache_trim(budget);
+}
+
+void lv_draw_sw_glyph_cache_invalidate_font(const lv_font_t * font)
+{
+    glyph_entry_t * entry = lru_first;
+    while(entry) {
+        glyph_entry_t * next = entry->next;
+        if(font == NULL || entry->font == font || entry->dsc.resolved_font == font) cache_remove(entry);
+        entry = next;
+    }
+}
+
+void lv_draw_sw_glyph_cache_get_stats(lv_draw_sw_glyph_cache_stats_t * stats_out)
+{
+    *stats_out = stats;
+    stats_out->budget = budget;
+}
+
+void lv_draw_sw_glyph_cache_reset_stats(void)
+{
+    stats.hits = 0;
+    stats.misses = 0;
+    stats.evictions = 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint32_t glyph_hash(const lv_font_t * font, uint32_t letter)
+{
+    /*FNV-1a of the font's address and the letter*/
+    uint32_t h = 2166136261u;
+    lv_uintptr_t p = (lv_uintptr_t)font;
+    h = (h ^ (uint32_t)p) * 16777619u;
+    h = (h ^ (uint32_t)((uint64_t)p >> 32)) * 16777619u;
+    h = (h ^ letter) * 16777619u;
+    return h ^ (h >> 16);
+}
+
+/**
+ * Look up a glyph and add it to the cache
+ * @return          the new entry, NULL if the glyph can't be cached
+ */
+static glyph_entry_t * glyph_create(const lv_font_t * font, uint32_t letter, uint32_t hash)
+{
+    lv_font_glyph_dsc_t g;
+    if(!lv_font_get_glyph_dsc(font, &g, letter, '\0')) return NULL;
+    if(g.resolved_font == NULL || g.resolved_font->subpx) return NULL;
+    if(g.bpp != 1 && g.bpp != 2 && g.bpp != 3 && g.bpp != 4 && g.bpp != 8) return NULL;
+
+    /*Spaces have no bitmap, but keep them too to skip the look up*/
+    uint32_t px_cnt = (uint32_t)g.box_w * g.box_h;
+    const uint8_t * src = NULL;
+    if(px_cnt) {
+        src = lv_font_get_glyph_bitmap(g.resolved_font, letter);
+        if(src == NULL) return NULL;
+    }
+
+    uint32_t size = sizeof(glyph_entry_t) + px_cnt;
+    if(size > budget) return NULL;
+    cache_trim(budget - size);
+
+    glyph_entry_t * entry = LV_IMG_CACHE_ALLOC(size);
+    if(entry == NULL) {
+        LV_LOG_WARN("couldn't allocate %"LV_PRIu32" bytes for a glyph", size);
+        return NULL;
+    }
+
+    lv_memset_00(entry, sizeof(glyph_entry_t));
+    entry->font = font;
+    entry->letter = letter;
+    entry->hash = hash;
+    entry->size = size;
+    entry->dsc = g;
+    entry->dsc.bpp = 8;
+    if(px_cnt) glyph_expand(&g, src, (uint8_t *)(entry + 1));
+
+    glyph_entry_t ** bucket = &buckets[hash & (GLYPH_BUCKET_CNT - 1)];
+    entry->hash_next = *bucket;
+    *bucket = entry;
+
+    entry->next = lru_first;
+    if(lru_first) lru_first->prev = entry;
+    else lru_last = entry;
+    lru_first = entry;
+
+    stats.glyph_cnt++;
+    stats.bytes += size;
+    return entry;
+}
+
+/**
+ * Unpack the 1..4 bpp bitmap of a glyph to one opacity per pixel. The rows of the bitmap follow each
+ * other without padding. 3 bpp is read as 4 bpp, like `lv_draw_sw_letter()` does.
+ */
+static void glyph_expand(const lv_font_glyph_dsc_t * g, const uint8_t * src, uint8_t * dest)
+{
+    uint32_t px_cnt = (uint32_t)g->box_w * g->box_h;
+    uint32_t bpp = g->bpp == 3 ? 4 : g->bpp;
+    const uint8_t * opa_table;
+    switch(bpp) {
+        case 1:
+            opa_table = _lv_bpp1_opa_table;
+            break;
+        case 2:
+            opa_table = _lv_bpp2_opa_table;
+            break;
+        case 4:
+            opa_table = _lv_bpp4_opa_table;
+            break;
+        default:
+            lv_memcpy(dest, src, px_cnt);
+            return;
+    }
+
+    uint32_t mask = (1 << bpp) - 1;
+    uint32_t bit = 0;
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        dest[i] = opa_table[(src[bit >> 3] >> (8 - bpp - (bit & 0x7))) & mask];
+        bit += bpp;
+    }
+}
+
+static void cache_remove(glyph_entry_t * entry)
+{
+    glyph_entry_t ** link = &buckets[entry->hash & (GLYPH_BUCKET_CNT - 1)];
+    while(*link != entry) link = &(*link)->hash_next;
+    *link = entry->hash_next;
+
+    if(entry->prev) entry->prev->next = entry->next;
+    else lru_first = entry->next;
+    if(entry->next) entry->next->prev = entry->prev;
+    else lru_last = entry->prev;
+
+    stats.glyph_cnt--;
+    stats.bytes -= entry->size;
+    LV_IMG_CACHE_FREE(entry);
+}
+
+static void cache_trim(uint32_t max_bytes)
+{
+    while(stats.bytes > max_bytes && lru_last != NULL) {
+        cache_remove(lru_last);
+        stats.evictions++;
+    }
+}
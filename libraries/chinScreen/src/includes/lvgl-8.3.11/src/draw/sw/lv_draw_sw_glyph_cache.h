@@ -0,0 +1,83 @@
+/**
+ * @file lv_draw_sw_glyph_cache.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_GLYPH_CACHE_H
+#define LV_DRAW_SW_GLYPH_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf_internal.h"
+#include "../../font/lv_font.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;        /*Glyphs looked up and expanded by the cache*/
+    uint32_t evictions;     /*Glyphs dropped to make room; invalidation is not counted*/
+    uint32_t glyph_cnt;     /*Glyphs cached now*/
+    uint32_t bytes;         /*Their size with the bookkeeping*/
+    uint32_t budget;        /*Limit of `bytes`*/
+} lv_draw_sw_glyph_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get a glyph to draw from the cache, looking it up and expanding it to 8 bit coverage on a miss.
+ * Sub-pixel and image fonts, and glyphs that aren't found, aren't cached.
+ * @param font      the font of the label, the glyph may come from its fallback
+ * @param letter    the Unicode letter
+ * @param g         the glyph's descriptor is written here, with `bpp` 8
+ * @param map       the glyph's `box_w` x `box_h` opacities are written here
+ * @return          true: the glyph is in the cache; false: get it from the font
+ */
+bool _lv_draw_sw_glyph_cache_get(const lv_font_t * font, uint32_t letter, lv_font_glyph_dsc_t * g,
+                                 const uint8_t ** map);
+
+/**
+ * Set how many bytes the cached glyphs may use. They are allocated with `LV_IMG_CACHE_ALLOC`.
+ * @param bytes     the budget, `LV_DRAW_SW_GLYPH_CACHE_DEF_BYTES` by default, 0 disables the cache
+ */
+void lv_draw_sw_glyph_cache_set_budget(uint32_t bytes);
+
+/**
+ * Drop the glyphs of a font, e.g. before it's freed or when its size changes.
+ * @param font      the font, or the fallback they were taken from; NULL: drop every glyph
+ */
+void lv_draw_sw_glyph_cache_invalidate_font(const lv_font_t * font);
+
+/**
+ * Get the hit/miss/eviction counters and the current fill of the cache.
+ * @param stats     the stats are written here
+ */
+void lv_draw_sw_glyph_cache_get_stats(lv_draw_sw_glyph_cache_stats_t * stats);
+
+/**
+ * Clear the hit/miss/eviction counters.
+ */
+void lv_draw_sw_glyph_cache_reset_stats(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_GLYPH_CACHE_H*/
@@ -9,6 +9,7 @@
 #include "lv_draw_sw_gradient.h"
 #include "../../misc/lv_gc.h"
 #include "../../misc/lv_types.h"
+#include "lv_draw_sw_tiles.h"
 
 /*********************
  *      DEFINES
@@ -57,16 +58,27 @@ static uint8_t * grad_cache_end = 0;
 /**********************
  *   STATIC FUNCTIONS
  **********************/
-union void_cast {
-    const void * ptr;
-    const uint32_t value;
-};
-
 static uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t size, lv_coord_t w)
 {
-    union void_cast v;
-    v.ptr = g;
-    return (v.value ^ size ^ (w >> 1)); /*Yes, this is correct, it's like a hash that changes if the width changes*/
+    /*Hash what the map is computed from: draw descriptors are copied onto the stack for every
+     *draw, so the address of `g` says nothing about its stops (FNV-1a)*/
+    uint32_t h = 2166136261u;
+#define GRAD_HASH(v) h = (h ^ (uint32_t)(v)) * 16777619u
+    GRAD_HASH(g->dir);
+    GRAD_HASH(g->stops_count);
+    for(uint8_t i = 0; i < g->stops_count; i++) {
+        GRAD_HASH(g->stops[i].color.full);
+        GRAD_HASH(g->stops[i].frac);
+    }
+    GRAD_HASH(size);
+#if _DITHER_GRADIENT
+    GRAD_HASH(g->dither);
+    GRAD_HASH(w); /*The dithering state is per width*/
+#else
+    LV_UNUSED(w);
+#endif
+#undef GRAD_HASH
+    return h;
 }
 
 static size_t get_cache_item_size(lv_grad_t * c)
@@ -169,15 +181,17 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord
 #endif
 #endif
 
-    size_t act_size = (size_t)(grad_cache_end - LV_GC_ROOT(_lv_grad_cache_mem));
+    /*The cache belongs to the LVGL thread, the workers drawing tiles allocate their own maps*/
+    bool in_worker = _lv_draw_sw_tiles_in_worker();
+    size_t act_size = in_worker ? 0 : (size_t)(grad_cache_end - LV_GC_ROOT(_lv_grad_cache_mem));
     lv_grad_t * item = NULL;
-    if(req_size + act_size < grad_cache_size) {
+    if(!in_worker && req_size + act_size < grad_cache_size) {
         item = (lv_grad_t *)grad_cache_end;
         item->not_cached = 0;
     }
     else {
         /*Need to evict items from cache until we find enough space to allocate this one */
-        if(req_size <= grad_cache_size) {
+        if(!in_worker && req_size <= grad_cache_size) {
             while(act_size + req_size > grad_cache_size) {
                 uint32_t oldest_life = UINT32_MAX;
                 iterate_cache(&find_oldest_item_life, &oldest_life, NULL);
@@ -253,20 +267,22 @@ lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
     /* No gradient, no cache */
     if(g->dir == LV_GRAD_DIR_NONE) return NULL;
 
-    /* Step 0: Check if the cache exist (else create it) */
-    static bool inited = false;
-    if(!inited) {
-        lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
-        inited = true;
-    }
-
-    /* Step 1: Search cache for the given key */
-    lv_coord_t size = g->dir == LV_GRAD_DIR_HOR ? w : h;
-    uint32_t key = compute_key(g, size, w);
     lv_grad_t * item = NULL;
-    if(iterate_cache(&find_item, &key, &item) == LV_RES_OK) {
-        item->life++; /* Don't forget to bump the counter */
-        return item;
+    if(!_lv_draw_sw_tiles_in_worker()) {
+        /* Step 0: Check if the cache exist (else create it) */
+        static bool inited = false;
+        if(!inited) {
+            lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
+            inited = true;
+        }
+
+        /* Step 1: Search cache for the given key */
+        lv_coord_t size = g->dir == LV_GRAD_DIR_HOR ? w : h;
+        uint32_t key = compute_key(g, size, w);
+        if(iterate_cache(&find_item, &key, &item) == LV_RES_OK) {
+            item->life++; /* Don't forget to bump the counter */
+            return item;
+        }
     }
 
     /* Step 2: Need to allocate an item for it */
@@ -12,6 +12,7 @@
 #include "../../core/lv_refr.h"
 #include "../../misc/lv_assert.h"
 #include "lv_draw_sw_dither.h"
+#include "lv_draw_sw_tiles.h"
 
 /*********************
  *      DEFINES
@@ -117,7 +118,14 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
 
     lv_grad_dir_t grad_dir = dsc->bg_grad.dir;
     lv_color_t bg_color    = grad_dir == LV_GRAD_DIR_NONE ? dsc->bg_color : dsc->bg_grad.stops[0].color;
-    if(bg_color.full == dsc->bg_grad.stops[1].color.full) grad_dir = LV_GRAD_DIR_NONE;
+    if(grad_dir != LV_GRAD_DIR_NONE) {
+        /*A gradient is only a plain fill if all of its stops have the same color*/
+        uint8_t i;
+        for(i = 1; i < dsc->bg_grad.stops_count; i++) {
+            if(dsc->bg_grad.stops[i].color.full != bg_color.full) break;
+        }
+        if(i == dsc->bg_grad.stops_count) grad_dir = LV_GRAD_DIR_NONE;
+    }
 
     bool mask_any = lv_draw_mask_is_any(&bg_coords);
     lv_draw_sw_blend_dsc_t blend_dsc = {0};
@@ -295,6 +303,27 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
         blend_dsc.opa = opa;
         blend_dsc.mask_res = LV_DRAW_MASK_RES_FULL_COVER;
         int32_t h_end = bg_coords.y2 - rout;
+
+        bool row_runs = !mask_any_center && grad_dir == LV_GRAD_DIR_VER;
+#if _DITHER_GRADIENT
+        if(dither_func) row_runs = false;
+#endif
+        if(row_runs) {
+            /*Vertical gradient and no mask: neighbouring rows often get the same color
+             *in the map, blend each run of them as one area. Only the clipped rows matter.*/
+            h_end = LV_MIN(h_end, clipped_coords.y2);
+            h = LV_MAX(bg_coords.y1 + rout, clipped_coords.y1);
+            while(h <= h_end) {
+                blend_dsc.color = grad->map[h - bg_coords.y1];
+                blend_area.y1 = h;
+                while(h < h_end && grad->map[h + 1 - bg_coords.y1].full == blend_dsc.color.full) h++;
+                blend_area.y2 = h;
+                lv_draw_sw_blend(draw_ctx, &blend_dsc);
+                h++;
+            }
+            goto bg_clean_up;
+        }
+
         for(h = bg_coords.y1 + rout; h <= h_end; h++) {
             /*If there is no other mask do not apply mask as in the center there is no radius to mask*/
             if(mask_any_center) {
@@ -486,7 +515,9 @@ static void LV_ATTRIBUTE_FAST_MEM draw_shadow(lv_draw_ctx_t * draw_ctx, const lv
     lv_opa_t * sh_buf;
 
 #if LV_SHADOW_CACHE_SIZE
-    if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
+    /*The cache belongs to the LVGL thread, the workers drawing tiles blur their own corners*/
+    bool use_cache = !_lv_draw_sw_tiles_in_worker();
+    if(use_cache && sh_cache_size == corner_size && sh_cache_r == r_sh) {
         /*Use the cache if available*/
         sh_buf = lv_mem_buf_get(corner_size * corner_size);
         lv_memcpy(sh_buf, sh_cache, corner_size * corner_size);
@@ -497,7 +528,7 @@ static void LV_ATTRIBUTE_FAST_MEM draw_shadow(lv_draw_ctx_t * draw_ctx, const lv
         shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
 
         /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(sh_cache)) {
+        if(use_cache && (uint32_t)corner_size * corner_size < sizeof(sh_cache)) {
             lv_memcpy(sh_cache, sh_buf, corner_size * corner_size);
             sh_cache_size = corner_size;
             sh_cache_r = r_sh;
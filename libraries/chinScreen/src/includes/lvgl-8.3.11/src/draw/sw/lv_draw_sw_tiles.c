@@ -0,0 +1,446 @@
+/**
+ * @file lv_draw_sw_tiles.c
+ * Big draw operations are cut into horizontal tiles of the draw buffer, one per thread: the LVGL thread
+ * draws the first tile and the workers the others, each with the plain `lv_draw_sw` callbacks clipped to
+ * its tile. Only the rasterization is shared. The objects, events, image decoders, fonts and caches stay on
+ * the LVGL thread, so images are decoded by `lv_draw_img()` before their pixels get here, and rectangles
+ * with a background image or symbol are drawn by the LVGL thread alone.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_tiles.h"
+
+#if LV_USE_DRAW_SW_TILES
+
+#include "../../misc/lv_thread.h"
+#include "../../misc/lv_gc.h"
+#include "../../misc/lv_log.h"
+#include "../../core/lv_refr.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Thinner tiles would spend more on the masks and line ends than they save*/
+#define TILE_MIN_ROWS   4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef void (*tile_cb_t)(lv_draw_ctx_t * draw_ctx, const void * args);
+
+typedef struct {
+    tile_cb_t cb;
+    const void * args;
+    const lv_draw_sw_ctx_t * draw_ctx;          /*Copied for every tile*/
+#if LV_DRAW_COMPLEX
+    /*The masks of the LVGL thread before it starts its own tile and adds the masks of the drawing*/
+    _lv_draw_mask_saved_arr_t masks;
+#endif
+} tile_job_t;
+
+typedef struct {
+    lv_thread_t thread;
+    lv_thread_sync_t start;
+    lv_thread_sync_t done;
+    const tile_job_t * job;                     /*NULL: stop the worker*/
+    lv_area_t clip;
+} worker_t;
+
+typedef struct {
+    const lv_draw_rect_dsc_t * dsc;
+    const lv_area_t * coords;
+} rect_args_t;
+
+typedef struct {
+    const lv_draw_arc_dsc_t * dsc;
+    const lv_point_t * center;
+    uint16_t radius;
+    uint16_t start_angle;
+    uint16_t end_angle;
+} arc_args_t;
+
+typedef struct {
+    const lv_draw_img_dsc_t * dsc;
+    const lv_area_t * coords;
+    const uint8_t * src_buf;
+    lv_img_cf_t cf;
+} img_args_t;
+
+typedef struct {
+    const lv_draw_line_dsc_t * dsc;
+    const lv_point_t * point1;
+    const lv_point_t * point2;
+} line_args_t;
+
+typedef struct {
+    const lv_draw_rect_dsc_t * dsc;
+    const lv_point_t * points;
+    uint16_t point_cnt;
+} polygon_args_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void tiles_draw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+static void tiles_draw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                           uint16_t radius, uint16_t start_angle, uint16_t end_angle);
+static void tiles_draw_img_decoded(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc,
+                                   const lv_area_t * coords, const uint8_t * src_buf, lv_img_cf_t cf);
+static void tiles_draw_line(lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * point1,
+                            const lv_point_t * point2);
+static void tiles_draw_polygon(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_point_t * points,
+                               uint16_t point_cnt);
+static void rect_tile(lv_draw_ctx_t * draw_ctx, const void * args);
+static void arc_tile(lv_draw_ctx_t * draw_ctx, const void * args);
+static void img_tile(lv_draw_ctx_t * draw_ctx, const void * args);
+static void line_tile(lv_draw_ctx_t * draw_ctx, const void * args);
+static void polygon_tile(lv_draw_ctx_t * draw_ctx, const void * args);
+static bool draw_in_tiles(lv_draw_ctx_t * draw_ctx, const lv_area_t * area, tile_cb_t cb, const void * args);
+static void draw_tile(const tile_job_t * job, const lv_area_t * clip);
+static bool workers_ready(void);
+static void workers_stop(void);
+static void worker_thread(void * p);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static worker_t * workers;
+static uint32_t worker_cnt;                                 /*Running*/
+static uint32_t worker_cnt_set = LV_DRAW_SW_TILE_WORKERS;   /*Started when needed*/
+static int32_t worker_core = LV_DRAW_SW_TILE_CORE;
+static bool worker_start_failed;                            /*Don't try again in every frame*/
+static uint32_t ctx_cnt;
+static LV_THREAD_LOCAL bool in_worker;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_sw_tiles_ctx_init(lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx)
+{
+    lv_draw_sw_init_ctx(drv, draw_ctx);
+
+    lv_draw_sw_tiles_ctx_t * tiles_ctx = (lv_draw_sw_tiles_ctx_t *)draw_ctx;
+    tiles_ctx->base_draw.draw_rect = tiles_draw_rect;
+    tiles_ctx->base_draw.draw_arc = tiles_draw_arc;
+    tiles_ctx->base_draw.draw_img_decoded = tiles_draw_img_decoded;
+    tiles_ctx->base_draw.draw_line = tiles_draw_line;
+    tiles_ctx->base_draw.draw_polygon = tiles_draw_polygon;
+    ctx_cnt++;
+}
+
+void lv_draw_sw_tiles_ctx_deinit(lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx)
+{
+    lv_draw_sw_deinit_ctx(drv, draw_ctx);
+
+    /*The workers are shared by the displays*/
+    if(ctx_cnt > 0) ctx_cnt--;
+    if(ctx_cnt == 0) workers_stop();
+}
+
+void lv_draw_sw_tiles_set_workers(uint32_t cnt, int32_t core)
+{
+    workers_stop();
+    worker_cnt_set = LV_MIN(cnt, LV_DRAW_SW_TILE_WORKERS_MAX);
+    worker_core = core;
+    worker_start_failed = false;
+}
+
+uint32_t lv_draw_sw_tiles_get_workers(void)
+{
+    return worker_cnt_set;
+}
+
+bool _lv_draw_sw_tiles_in_worker(void)
+{
+    return in_worker;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void tiles_draw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
+{
+    /*Background images and symbols go through the image cache and the fonts: keep them on this thread.
+     *Error diffusion carries the error from row to row, so it can't start in the middle*/
+    if(dsc->bg_img_src == NULL && dsc->bg_grad.dither != LV_DITHER_ERR_DIFF) {
+        lv_coord_t ext = 0;
+        if(dsc->shadow_width && dsc->shadow_opa > LV_OPA_MIN) {
+            ext = dsc->shadow_width + dsc->shadow_spread + LV_MAX(LV_ABS(dsc->shadow_ofs_x), LV_ABS(dsc->shadow_ofs_y));
+        }
+        if(dsc->outline_width && dsc->outline_opa > LV_OPA_MIN) {
+            ext = LV_MAX(ext, dsc->outline_pad + dsc->outline_width);
+        }
+        lv_area_t area = *coords;
+        lv_area_increase(&area, ext, ext);
+
+        rect_args_t args = {dsc, coords};
+        if(draw_in_tiles(draw_ctx, &area, rect_tile, &args)) return;
+    }
+
+    lv_draw_sw_rect(draw_ctx, dsc, coords);
+}
+
+static void tiles_draw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                           uint16_t radius, uint16_t start_angle, uint16_t end_angle)
+{
+    if(dsc->img_src == NULL) {
+        lv_area_t area;
+        lv_area_set(&area, center->x - radius, center->y - radius, center->x + radius, center->y + radius);
+
+        arc_args_t args = {dsc, center, radius, start_angle, end_angle};
+        if(draw_in_tiles(draw_ctx, &area, arc_tile, &args)) return;
+    }
+
+    lv_draw_sw_arc(draw_ctx, dsc, center, radius, start_angle, end_angle);
+}
+
+static void tiles_draw_img_decoded(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc,
+                                   const lv_area_t * coords, const uint8_t * src_buf, lv_img_cf_t cf)
+{
+    /*Transformed images can cover anything in the clip area*/
+    const lv_area_t * area = coords;
+    if(dsc->angle || dsc->zoom != LV_IMG_ZOOM_NONE) area = draw_ctx->clip_area;
+
+    img_args_t args = {dsc, coords, src_buf, cf};
+    if(draw_in_tiles(draw_ctx, area, img_tile, &args)) return;
+
+    lv_draw_sw_img_decoded(draw_ctx, dsc, coords, src_buf, cf);
+}
+
+static void tiles_draw_line(lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * point1,
+                            const lv_point_t * point2)
+{
+    lv_area_t area;
+    lv_area_set(&area, LV_MIN(point1->x, point2->x), LV_MIN(point1->y, point2->y),
+                LV_MAX(point1->x, point2->x), LV_MAX(point1->y, point2->y));
+    lv_area_increase(&area, dsc->width, dsc->width);
+
+    line_args_t args = {dsc, point1, point2};
+    if(draw_in_tiles(draw_ctx, &area, line_tile, &args)) return;
+
+    lv_draw_sw_line(draw_ctx, dsc, point1, point2);
+}
+
+static void tiles_draw_polygon(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_point_t * points,
+                               uint16_t point_cnt)
+{
+    if(dsc->bg_img_src == NULL && dsc->bg_grad.dither != LV_DITHER_ERR_DIFF && point_cnt >= 3) {
+        lv_area_t area;
+        lv_area_set(&area, points[0].x, points[0].y, points[0].x, points[0].y);
+        uint16_t i;
+        for(i = 1; i < point_cnt; i++) {
+            area.x1 = LV_MIN(area.x1, points[i].x);
+            area.y1 = LV_MIN(area.y1, points[i].y);
+            area.x2 = LV_MAX(area.x2, points[i].x);
+            area.y2 = LV_MAX(area.y2, points[i].y);
+        }
+
+        polygon_args_t args = {dsc, points, point_cnt};
+        if(draw_in_tiles(draw_ctx, &area, polygon_tile, &args)) return;
+    }
+
+    lv_draw_sw_polygon(draw_ctx, dsc, points, point_cnt);
+}
+
+static void rect_tile(lv_draw_ctx_t * draw_ctx, const void * args)
+{
+    const rect_args_t * a = args;
+    lv_draw_sw_rect(draw_ctx, a->dsc, a->coords);
+}
+
+static void arc_tile(lv_draw_ctx_t * draw_ctx, const void * args)
+{
+    const arc_args_t * a = args;
+    lv_draw_sw_arc(draw_ctx, a->dsc, a->center, a->radius, a->start_angle, a->end_angle);
+}
+
+static void img_tile(lv_draw_ctx_t * draw_ctx, const void * args)
+{
+    const img_args_t * a = args;
+    lv_draw_sw_img_decoded(draw_ctx, a->dsc, a->coords, a->src_buf, a->cf);
+}
+
+static void line_tile(lv_draw_ctx_t * draw_ctx, const void * args)
+{
+    const line_args_t * a = args;
+    lv_draw_sw_line(draw_ctx, a->dsc, a->point1, a->point2);
+}
+
+static void polygon_tile(lv_draw_ctx_t * draw_ctx, const void * args)
+{
+    const polygon_args_t * a = args;
+    lv_draw_sw_polygon(draw_ctx, a->dsc, a->points, a->point_cnt);
+}
+
+/**
+ * Draw something in tiles if it's worth it
+ * @param draw_ctx  the draw context of the display
+ * @param area      where the drawing can change pixels (may be larger), to see if it's big enough
+ *                  and to cut it into tiles of the same size
+ * @param cb        draw into the draw context it gets, clipped to one tile
+ * @param args      the parameter of `cb`
+ * @return          true: drawn; false: too small or no workers, draw it on this thread
+ */
+static bool draw_in_tiles(lv_draw_ctx_t * draw_ctx, const lv_area_t * area, tile_cb_t cb, const void * args)
+{
+    lv_area_t a;
+    if(!_lv_area_intersect(&a, area, draw_ctx->clip_area)) return false;
+    if(lv_area_get_size(&a) < LV_DRAW_SW_TILE_MIN_PX) return false;
+
+    /*A user's set_px_cb might not be ready for more threads*/
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp && disp->driver->set_px_cb) return false;
+
+    if(!workers_ready()) return false;
+
+    lv_coord_t h = lv_area_get_height(&a);
+    uint32_t tile_cnt = LV_MIN(worker_cnt + 1, (uint32_t)(h / TILE_MIN_ROWS));
+    if(tile_cnt < 2) return false;
+
+    tile_job_t job;
+    job.cb = cb;
+    job.args = args;
+    job.draw_ctx = (const lv_draw_sw_ctx_t *)draw_ctx;
+#if LV_DRAW_COMPLEX
+    lv_memcpy(job.masks, LV_GC_ROOT(_lv_draw_mask_list), sizeof(_lv_draw_mask_saved_arr_t));
+#endif
+
+    /*Cut the drawn rows evenly; the first and last tiles take the rest of the clip area too*/
+    const lv_area_t * clip = draw_ctx->clip_area;
+    lv_area_t first = *clip;
+    uint32_t i;
+    for(i = 0; i < tile_cnt; i++) {
+        lv_area_t tile = *clip;
+        if(i > 0) tile.y1 = a.y1 + (lv_coord_t)((h * i) / tile_cnt);
+        if(i < tile_cnt - 1) tile.y2 = a.y1 + (lv_coord_t)((h * (i + 1)) / tile_cnt) - 1;
+
+        if(i == 0) {
+            first = tile;
+        }
+        else {
+            worker_t * w = &workers[i - 1];
+            w->clip = tile;
+            w->job = &job;
+            lv_thread_sync_signal(&w->start);
+        }
+    }
+
+    draw_tile(&job, &first);
+
+    for(i = 1; i < tile_cnt; i++) {
+        lv_thread_sync_wait(&workers[i - 1].done);
+    }
+
+    return true;
+}
+
+static void draw_tile(const tile_job_t * job, const lv_area_t * clip)
+{
+    /*The display's draw context with the plain software callbacks, so nothing is cut again*/
+    lv_draw_sw_ctx_t draw_ctx;
+    lv_memcpy(&draw_ctx, job->draw_ctx, sizeof(draw_ctx));
+    draw_ctx.base_draw.draw_rect = lv_draw_sw_rect;
+    draw_ctx.base_draw.draw_arc = lv_draw_sw_arc;
+    draw_ctx.base_draw.draw_img_decoded = lv_draw_sw_img_decoded;
+    draw_ctx.base_draw.draw_line = lv_draw_sw_line;
+    draw_ctx.base_draw.draw_polygon = lv_draw_sw_polygon;
+    draw_ctx.base_draw.clip_area = clip;
+
+#if LV_DRAW_COMPLEX
+    /*Start with the masks of the LVGL thread (e.g. the rounded corners of the parents).
+     *The drawing removes the masks it adds, so they are the same at the end*/
+    if(in_worker) {
+        lv_memcpy(LV_GC_ROOT(_lv_draw_mask_list), job->masks, sizeof(_lv_draw_mask_saved_arr_t));
+    }
+#endif
+
+    job->cb(&draw_ctx.base_draw, job->args);
+}
+
+static bool workers_ready(void)
+{
+    if(worker_cnt > 0) return true;
+    if(worker_cnt_set == 0 || worker_start_failed) return false;
+
+    workers = lv_mem_alloc(worker_cnt_set * sizeof(worker_t));
+    LV_ASSERT_MALLOC(workers);
+    if(workers == NULL) {
+        worker_start_failed = true;
+        return false;
+    }
+    lv_memset_00(workers, worker_cnt_set * sizeof(worker_t));
+
+    uint32_t i;
+    for(i = 0; i < worker_cnt_set; i++) {
+        worker_t * w = &workers[i];
+        if(lv_thread_sync_init(&w->start) != LV_RES_OK) break;
+        if(lv_thread_sync_init(&w->done) != LV_RES_OK) {
+            lv_thread_sync_delete(&w->start);
+            break;
+        }
+        if(lv_thread_init(&w->thread, worker_core, worker_thread, LV_DRAW_SW_TILE_STACK, w) != LV_RES_OK) {
+            lv_thread_sync_delete(&w->start);
+            lv_thread_sync_delete(&w->done);
+            break;
+        }
+        worker_cnt++;
+    }
+
+    if(worker_cnt < worker_cnt_set) {
+        LV_LOG_WARN("only %d of %d tile workers could start", (int)worker_cnt, (int)worker_cnt_set);
+        worker_start_failed = true;
+    }
+    if(worker_cnt == 0) {
+        lv_mem_free(workers);
+        workers = NULL;
+        return false;
+    }
+    return true;
+}
+
+static void workers_stop(void)
+{
+    uint32_t i;
+    for(i = 0; i < worker_cnt; i++) {
+        workers[i].job = NULL;
+        lv_thread_sync_signal(&workers[i].start);
+    }
+    for(i = 0; i < worker_cnt; i++) {
+        lv_thread_delete(&workers[i].thread);
+        lv_thread_sync_delete(&workers[i].start);
+        lv_thread_sync_delete(&workers[i].done);
+    }
+    lv_mem_free(workers);
+    workers = NULL;
+    worker_cnt = 0;
+}
+
+static void worker_thread(void * p)
+{
+    worker_t * w = p;
+    in_worker = true;
+
+    while(1) {
+        lv_thread_sync_wait(&w->start);
+        const tile_job_t * job = w->job;
+        if(job == NULL) break;
+        draw_tile(job, &w->clip);
+        lv_thread_sync_signal(&w->done);
+    }
+
+    /*Free the buffers and circles this thread cached while drawing*/
+    lv_mem_buf_free_all();
+#if LV_DRAW_COMPLEX
+    _lv_draw_mask_cleanup();
+#endif
+}
+
+#endif /*LV_USE_DRAW_SW_TILES*/
@@ -0,0 +1,79 @@
+/**
+ * @file lv_draw_sw_tiles.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_TILES_H
+#define LV_DRAW_SW_TILES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw.h"
+
+#if LV_USE_DRAW_SW_TILES
+
+#if LV_USE_OS == LV_OS_NONE
+#error "LV_USE_DRAW_SW_TILES needs threads: set LV_USE_OS"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define LV_DRAW_SW_TILE_WORKERS_MAX 7
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*The software renderer, with the big rectangles, images, arcs, lines and polygons cut into
+ *horizontal tiles of the draw buffer and drawn by the workers and the LVGL thread at once*/
+typedef lv_draw_sw_ctx_t lv_draw_sw_tiles_ctx_t;
+
+struct _lv_disp_drv_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+void lv_draw_sw_tiles_ctx_init(struct _lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx);
+
+void lv_draw_sw_tiles_ctx_deinit(struct _lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx);
+
+/**
+ * Set the worker threads. They are started when they are needed first; old workers are stopped at once.
+ * Call it from the LVGL thread (or with the LVGL lock taken), not while drawing.
+ * @param cnt       threads drawing tiles next to the LVGL thread, 0..LV_DRAW_SW_TILE_WORKERS_MAX.
+ *                  0: the LVGL thread draws everything alone, like `lv_draw_sw`
+ * @param core      pin the workers to this core (FreeRTOS on ESP32), -1: any core
+ */
+void lv_draw_sw_tiles_set_workers(uint32_t cnt, int32_t core);
+
+/**
+ * Get the number of worker threads
+ * @return          the workers set with `lv_draw_sw_tiles_set_workers()` or LV_DRAW_SW_TILE_WORKERS
+ */
+uint32_t lv_draw_sw_tiles_get_workers(void);
+
+/**
+ * Tell if the caller is a worker drawing a tile. Workers skip the caches shared with the LVGL thread.
+ * @return          true: called on a worker thread
+ */
+bool _lv_draw_sw_tiles_in_worker(void);
+
+#else
+
+#define _lv_draw_sw_tiles_in_worker() false
+
+#endif /*LV_USE_DRAW_SW_TILES*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_TILES_H*/
@@ -15,6 +15,13 @@
 /*********************
  *      DEFINES
  *********************/
+#define ZOOM_BOX_MAX    16      /*Largest n of the 1/n downscales averaging n x n pixels*/
+
+#if LV_DRAW_SW_TRANSFORM_INT_ZOOM
+    #define TRANSFORM_PATH_DEF  LV_DRAW_SW_TRANSFORM_INTEGER
+#else
+    #define TRANSFORM_PATH_DEF  LV_DRAW_SW_TRANSFORM_SEPARABLE
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -33,6 +40,26 @@ typedef struct {
     lv_point_t pivot;
 } point_transform_dsc_t;
 
+/*The source image with what is needed to read any of its pixels*/
+typedef struct {
+    const uint8_t * src;
+    const lv_opa_t * a8;        /*The alpha plane of LV_IMG_CF_RGB565A8*/
+    lv_coord_t src_w;
+    lv_coord_t src_h;
+    lv_coord_t src_stride;
+    lv_img_cf_t cf;
+    bool has_alpha;
+    int32_t px_size;
+    lv_color_t ck;
+} src_dsc_t;
+
+/*Where a destination pixel is taken from along one axis*/
+typedef struct {
+    int32_t i;          /*The source column or row*/
+    int32_t next;       /*-1 or 1: the neighbor to mix with when anti-aliasing*/
+    int32_t fract;      /*0x00..0xFF: how much of the neighbor is mixed*/
+} src_coord_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -65,9 +92,21 @@ static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t sr
                             int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                             int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf);
 
+static bool zoom_only(const src_dsc_t * s, const lv_area_t * dest_area, const point_transform_dsc_t * t,
+                      uint16_t zoom, bool aa, lv_color_t * cbuf, lv_opa_t * abuf);
+static void zoom_coord(src_coord_t * c, int32_t pos, int32_t pivot, int32_t tr_zoom, int32_t rep, int32_t box,
+                       bool aa);
+static void nearest_row(const src_dsc_t * s, const src_coord_t * cols, int32_t ys, lv_coord_t dest_w,
+                        lv_color_t * cbuf, lv_opa_t * abuf);
+static void box_row(const src_dsc_t * s, const src_coord_t * cols, int32_t ys, int32_t box, lv_coord_t dest_w,
+                    lv_color_t * cbuf, lv_opa_t * abuf);
+static bool src_dsc_init(src_dsc_t * s, const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h,
+                         lv_coord_t src_stride, lv_img_cf_t cf);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
+static lv_draw_sw_transform_path_t transform_path = TRANSFORM_PATH_DEF;
 
 /**********************
  *      MACROS
@@ -105,6 +144,12 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
     tr_dsc.pivot_x_256 = tr_dsc.pivot.x * 256;
     tr_dsc.pivot_y_256 = tr_dsc.pivot.y * 256;
 
+    if(tr_dsc.angle == 0 && transform_path != LV_DRAW_SW_TRANSFORM_GENERIC) {
+        src_dsc_t s;
+        if(src_dsc_init(&s, src_buf, src_w, src_h, src_stride, cf) &&
+           zoom_only(&s, dest_area, &tr_dsc, draw_dsc->zoom, draw_dsc->antialias, cbuf, abuf)) return;
+    }
+
     lv_coord_t dest_w = lv_area_get_width(dest_area);
     lv_coord_t dest_h = lv_area_get_height(dest_area);
     lv_coord_t y;
@@ -153,18 +198,524 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
     }
 }
 
+void lv_draw_sw_transform_set_path(lv_draw_sw_transform_path_t path)
+{
+    transform_path = path;
+}
+
+lv_draw_sw_transform_path_t lv_draw_sw_transform_get_path(void)
+{
+    return transform_path;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Fill the fields of a source image
+ * @return          false: the color format can't be transformed
+ */
+static bool src_dsc_init(src_dsc_t * s, const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h,
+                         lv_coord_t src_stride, lv_img_cf_t cf)
+{
+    s->src = src;
+    s->a8 = NULL;
+    s->src_w = src_w;
+    s->src_h = src_h;
+    s->src_stride = src_stride;
+    s->cf = cf;
+    s->ck.full = 0;
+    switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+            s->has_alpha = false;
+            s->px_size = sizeof(lv_color_t);
+            break;
+        case LV_IMG_CF_TRUE_COLOR_ALPHA:
+            s->has_alpha = true;
+            s->px_size = LV_IMG_PX_SIZE_ALPHA_BYTE;
+            break;
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED: {
+                s->has_alpha = true;
+                s->px_size = sizeof(lv_color_t);
+                lv_disp_t * d = _lv_refr_get_disp_refreshing();
+                s->ck = d->driver->color_chroma_key;
+                break;
+            }
+#if LV_COLOR_DEPTH == 16
+        case LV_IMG_CF_RGB565A8:
+            s->has_alpha = true;
+            s->px_size = sizeof(lv_color_t);
+            s->a8 = src + src_stride * src_h * sizeof(lv_color_t);
+            break;
+#endif
+        default:
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Read a pixel of the source
+ * @param s         the source image
+ * @param x         column, in the image
+ * @param y         row, in the image
+ * @param c         the color is written here
+ * @return          the opacity of the pixel
+ */
+static inline lv_opa_t src_px(const src_dsc_t * s, int32_t x, int32_t y, lv_color_t * c)
+{
+    const uint8_t * px = s->src + (y * s->src_stride + x) * s->px_size;
+    if(s->cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+#if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
+        c->full = px[0];
+#elif LV_COLOR_DEPTH == 16
+        c->full = px[0] + (px[1] << 8);
+#elif LV_COLOR_DEPTH == 32
+        c->full = *((uint32_t *)px);
+#endif
+        return px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+    }
+
+    *c = *((const lv_color_t *)px);
+    if(s->cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) return c->full == s->ck.full ? LV_OPA_TRANSP : LV_OPA_COVER;
+    if(s->a8) return s->a8[y * s->src_stride + x];
+    return LV_OPA_COVER;
+}
+
+/**
+ * Get the source pixel and the direction and weight of its neighbor from an upscaled coordinate
+ * @param c         the result is written here
+ * @param ups       the coordinate with 1/256 precision, 0x80 is the middle of a pixel
+ */
+static inline void aa_coord(src_coord_t * c, int32_t ups)
+{
+    /*`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
+    c->i = ups >> 8;
+    int32_t fract = ups & 0xFF;
+    if(fract < 0x80) {
+        c->next = -1;
+        c->fract = (0x7F - fract) * 2;
+    }
+    else {
+        c->next = 1;
+        c->fract = (fract - 0x80) * 2;
+    }
+}
+
+/**
+ * Get an anti-aliased pixel: the source pixel mixed with its horizontal and vertical neighbor
+ * @param s         the source image
+ * @param xs        the source column, see `aa_coord()`
+ * @param ys        the source row, see `aa_coord()`
+ * @param c         the color is written here, it's left as it is if the pixel is transparent
+ * @param a         the opacity is written here
+ */
+static inline void aa_px(const src_dsc_t * s, const src_coord_t * xs, const src_coord_t * ys,
+                         lv_color_t * c, lv_opa_t * a)
+{
+    const int32_t xs_int = xs->i;
+    const int32_t ys_int = ys->i;
+    const lv_coord_t src_w = s->src_w;
+    const lv_coord_t src_h = s->src_h;
+    const lv_coord_t src_stride = s->src_stride;
+    const int32_t px_size = s->px_size;
+    const lv_img_cf_t cf = s->cf;
+
+    /*Fully out of the image*/
+    if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
+        *a = 0x00;
+        return;
+    }
+
+    const int32_t xs_fract = xs->fract;
+    const int32_t ys_fract = ys->fract;
+    const int32_t x_next = xs->next;
+    const int32_t y_next = ys->next;
+
+    const uint8_t * src_tmp = s->src;
+    src_tmp += (ys_int * src_stride * px_size) + xs_int * px_size;
+
+    if(xs_int + x_next >= 0 &&
+       xs_int + x_next <= src_w - 1 &&
+       ys_int + y_next >= 0 &&
+       ys_int + y_next <= src_h - 1) {
+
+        const uint8_t * px_base = src_tmp;
+        const uint8_t * px_hor = src_tmp + x_next * px_size;
+        const uint8_t * px_ver = src_tmp + y_next * src_stride * px_size;
+        lv_color_t c_base;
+        lv_color_t c_ver;
+        lv_color_t c_hor;
+
+        if(s->has_alpha) {
+            lv_opa_t a_base;
+            lv_opa_t a_ver;
+            lv_opa_t a_hor;
+            if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+                a_base = px_base[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                a_ver = px_ver[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                a_hor = px_hor[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+            }
+#if LV_COLOR_DEPTH == 16
+            else if(cf == LV_IMG_CF_RGB565A8) {
+                const lv_opa_t * a_tmp = s->a8;
+                a_base = *(a_tmp + (ys_int * src_stride) + xs_int);
+                a_hor = *(a_tmp + (ys_int * src_stride) + xs_int + x_next);
+                a_ver = *(a_tmp + ((ys_int + y_next) * src_stride) + xs_int);
+            }
+#endif
+            else if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+                if(((lv_color_t *)px_base)->full == s->ck.full ||
+                   ((lv_color_t *)px_ver)->full == s->ck.full ||
+                   ((lv_color_t *)px_hor)->full == s->ck.full) {
+                    *a = 0x00;
+                    return;
+                }
+                else {
+                    a_base = 0xff;
+                    a_ver = 0xff;
+                    a_hor = 0xff;
+                }
+            }
+            else {
+                a_base = 0xff;
+                a_ver = 0xff;
+                a_hor = 0xff;
+            }
+
+            if(a_ver != a_base) a_ver = ((a_ver * ys_fract) + (a_base * (0x100 - ys_fract))) >> 8;
+            if(a_hor != a_base) a_hor = ((a_hor * xs_fract) + (a_base * (0x100 - xs_fract))) >> 8;
+            *a = (a_ver + a_hor) >> 1;
+
+            if(*a == 0x00) return;
+
+#if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
+            c_base.full = px_base[0];
+            c_ver.full = px_ver[0];
+            c_hor.full = px_hor[0];
+#elif LV_COLOR_DEPTH == 16
+            c_base.full = px_base[0] + (px_base[1] << 8);
+            c_ver.full = px_ver[0] + (px_ver[1] << 8);
+            c_hor.full = px_hor[0] + (px_hor[1] << 8);
+#elif LV_COLOR_DEPTH == 32
+            c_base.full = *((uint32_t *)px_base);
+            c_ver.full = *((uint32_t *)px_ver);
+            c_hor.full = *((uint32_t *)px_hor);
+#endif
+        }
+        /*No alpha channel -> RGB*/
+        else {
+            c_base = *((const lv_color_t *) px_base);
+            c_hor = *((const lv_color_t *) px_hor);
+            c_ver = *((const lv_color_t *) px_ver);
+            *a = 0xff;
+        }
+
+        if(c_base.full == c_ver.full && c_base.full == c_hor.full) {
+            *c = c_base;
+        }
+        else {
+            c_ver = lv_color_mix(c_ver, c_base, ys_fract);
+            c_hor = lv_color_mix(c_hor, c_base, xs_fract);
+            *c = lv_color_mix(c_hor, c_ver, LV_OPA_50);
+        }
+    }
+    /*Partially out of the image*/
+    else {
+#if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
+        c->full = src_tmp[0];
+#elif LV_COLOR_DEPTH == 16
+        c->full = src_tmp[0] + (src_tmp[1] << 8);
+#elif LV_COLOR_DEPTH == 32
+        c->full = *((uint32_t *)src_tmp);
+#endif
+        lv_opa_t a_px;
+        switch(cf) {
+            case LV_IMG_CF_TRUE_COLOR_ALPHA:
+                a_px = src_tmp[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                break;
+            case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+                a_px = c->full == s->ck.full ? 0x00 : 0xff;
+                break;
+#if LV_COLOR_DEPTH == 16
+            case LV_IMG_CF_RGB565A8:
+                a_px = *(s->a8 + (ys_int * src_stride) + xs_int);
+                break;
+#endif
+            default:
+                a_px = 0xff;
+        }
+
+        if((xs_int == 0 && x_next < 0) || (xs_int == src_w - 1 && x_next > 0))  {
+            *a = (a_px * (0xFF - xs_fract)) >> 8;
+        }
+        else if((ys_int == 0 && y_next < 0) || (ys_int == src_h - 1 && y_next > 0))  {
+            *a = (a_px * (0xFF - ys_fract)) >> 8;
+        }
+        else {
+            *a = 0x00;
+        }
+    }
+}
+
+/**
+ * Zoom without rotation. The source column of every destination column is found once for the whole area,
+ * and a row is copied from the previous one if it's taken from the same source row the same way.
+ * With `LV_DRAW_SW_TRANSFORM_INTEGER` 2x, 3x... upscales repeat the pixels and 1/2x, 1/3x... downscales
+ * average n x n pixels (if anti-aliased).
+ * @param s         the source image
+ * @param dest_area the area to get, relative to the image
+ * @param t         the transformation, `angle` is 0
+ * @param zoom      zoom factor of the draw descriptor, 256: no zoom
+ * @param aa        true: anti-alias
+ * @param cbuf      the colors are written here
+ * @param abuf      the opacities are written here
+ * @return          false: nothing was done, use the generic transformation
+ */
+static bool zoom_only(const src_dsc_t * s, const lv_area_t * dest_area, const point_transform_dsc_t * t,
+                      uint16_t zoom, bool aa, lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    int32_t rep = 0;
+    int32_t box = 0;
+    if(transform_path == LV_DRAW_SW_TRANSFORM_INTEGER) {
+        if(zoom > LV_IMG_ZOOM_NONE && zoom % LV_IMG_ZOOM_NONE == 0) rep = zoom / LV_IMG_ZOOM_NONE;
+        else if(aa && zoom < LV_IMG_ZOOM_NONE && LV_IMG_ZOOM_NONE % zoom == 0 &&
+                LV_IMG_ZOOM_NONE / zoom <= ZOOM_BOX_MAX) box = LV_IMG_ZOOM_NONE / zoom;
+    }
+
+    lv_coord_t dest_w = lv_area_get_width(dest_area);
+    lv_coord_t dest_h = lv_area_get_height(dest_area);
+    src_coord_t * cols = lv_mem_buf_get(dest_w * sizeof(src_coord_t));
+    if(cols == NULL) return false;
+
+    lv_coord_t x;
+    for(x = 0; x < dest_w; x++) {
+        zoom_coord(&cols[x], dest_area->x1 + x, t->pivot.x, t->zoom, rep, box, aa);
+    }
+
+    src_coord_t ys_prev = {0};
+    lv_coord_t y;
+    for(y = 0; y < dest_h; y++) {
+        src_coord_t ys;
+        zoom_coord(&ys, dest_area->y1 + y, t->pivot.y, t->zoom, rep, box, aa);
+        if(y > 0 && box == 0 && ys.i == ys_prev.i && ys.next == ys_prev.next && ys.fract == ys_prev.fract) {
+            lv_memcpy(cbuf, cbuf - dest_w, dest_w * sizeof(lv_color_t));
+            lv_memcpy(abuf, abuf - dest_w, dest_w);
+        }
+        else if(box) {
+            box_row(s, cols, ys.i, box, dest_w, cbuf, abuf);
+        }
+        else if(aa && rep == 0) {
+            for(x = 0; x < dest_w; x++) aa_px(s, &cols[x], &ys, &cbuf[x], &abuf[x]);
+        }
+        else {
+            nearest_row(s, cols, ys.i, dest_w, cbuf, abuf);
+        }
+
+        ys_prev = ys;
+        cbuf += dest_w;
+        abuf += dest_w;
+    }
+
+    lv_mem_buf_release(cols);
+    return true;
+}
+
+/**
+ * Get where a destination column or row is taken from when zooming only
+ * @param c         the result is written here
+ * @param pos       the destination column or row, relative to the image
+ * @param pivot     the pivot's coordinate on the same axis
+ * @param tr_zoom   the inverse of the zoom, 256: no zoom
+ * @param rep       >0: integer upscale, every source pixel is repeated this many times
+ * @param box       >0: 1/n downscale, the first of the `box` source pixels covered
+ * @param aa        true: also get the neighbor, as the generic transformation would
+ */
+static void zoom_coord(src_coord_t * c, int32_t pos, int32_t pivot, int32_t tr_zoom, int32_t rep, int32_t box,
+                       bool aa)
+{
+    int32_t d = pos - pivot;
+    c->next = 0;
+    c->fract = 0;
+    if(rep) {
+        /*floor(d / rep): every source pixel covers `rep` destination pixels, the pivot stays in place*/
+        c->i = pivot + (d >= 0 ? d / rep : -((rep - 1 - d) / rep));
+    }
+    else if(box) {
+        c->i = pivot + d * box;
+    }
+    else {
+        /*Same as `transform_point_upscaled()` and the steps of `lv_draw_sw_transform()` without rotation*/
+        int32_t ups = d * tr_zoom + pivot * 256 + 0x80;
+        if(aa) aa_coord(c, ups);
+        else c->i = ups >> 8;
+    }
+}
+
+/**
+ * Take every pixel of a row from one source pixel
+ */
+static void nearest_row(const src_dsc_t * s, const src_coord_t * cols, int32_t ys, lv_coord_t dest_w,
+                        lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    if(ys < 0 || ys >= s->src_h) {
+        lv_memset_00(abuf, dest_w);
+        return;
+    }
+
+    lv_coord_t x;
+    for(x = 0; x < dest_w; x++) {
+        int32_t xs = cols[x].i;
+        if(xs < 0 || xs >= s->src_w) abuf[x] = 0x00;
+        else abuf[x] = src_px(s, xs, ys, &cbuf[x]);
+    }
+}
+
+/**
+ * Average `box` x `box` pixels of an opaque true color image
+ * @param s         the source image
+ * @param xs        the first column, the box is inside the image
+ * @param ys        the first row
+ * @param box       the size of the box
+ * @param c         the result is written here
+ */
+static inline void box_px_opaque(const src_dsc_t * s, int32_t xs, int32_t ys, int32_t box, lv_color_t * c)
+{
+    const lv_color_t * row = (const lv_color_t *)s->src + ys * s->src_stride + xs;
+    int32_t yb;
+    int32_t xb;
+#if LV_COLOR_DEPTH == 16
+    if(box == 2 || box == 4) {
+        /*With the channels spread to their own bits of a word, 16 pixels are summed at once*/
+        uint32_t sum = 0;
+        for(yb = 0; yb < box; yb++) {
+            for(xb = 0; xb < box; xb++) {
+                uint32_t v = row[xb].full;
+#if LV_COLOR_16_SWAP
+                v = ((v >> 8) | (v << 8)) & 0xFFFF;
+#endif
+                sum += (v | (v << 16)) & 0x07E0F81F;
+            }
+            row += s->src_stride;
+        }
+        sum = (sum >> (box == 2 ? 2 : 4)) & 0x07E0F81F;
+        uint32_t v = (sum | (sum >> 16)) & 0xFFFF;
+#if LV_COLOR_16_SWAP
+        v = ((v >> 8) | (v << 8)) & 0xFFFF;
+#endif
+        c->full = (uint16_t)v;
+        return;
+    }
+#endif
+
+    uint32_t r = 0;
+    uint32_t g = 0;
+    uint32_t b = 0;
+    for(yb = 0; yb < box; yb++) {
+        for(xb = 0; xb < box; xb++) {
+#if LV_COLOR_DEPTH == 16
+            /*The bit fields of the swapped format are slow to read one by one*/
+            uint32_t v = row[xb].full;
+#if LV_COLOR_16_SWAP
+            v = ((v >> 8) | (v << 8)) & 0xFFFF;
+#endif
+            r += v >> 11;
+            g += (v >> 5) & 0x3F;
+            b += v & 0x1F;
+#else
+            r += LV_COLOR_GET_R(row[xb]);
+            g += LV_COLOR_GET_G(row[xb]);
+            b += LV_COLOR_GET_B(row[xb]);
+#endif
+        }
+        row += s->src_stride;
+    }
+
+    const uint32_t px_cnt = box * box;
+    r /= px_cnt;
+    g /= px_cnt;
+    b /= px_cnt;
+#if LV_COLOR_DEPTH == 16
+    uint32_t v = (r << 11) | (g << 5) | b;
+#if LV_COLOR_16_SWAP
+    v = ((v >> 8) | (v << 8)) & 0xFFFF;
+#endif
+    c->full = (uint16_t)v;
+#else
+    LV_COLOR_SET_R(*c, r);
+    LV_COLOR_SET_G(*c, g);
+    LV_COLOR_SET_B(*c, b);
+    LV_COLOR_SET_A(*c, 0xff);
+#endif
+}
+
+/**
+ * Average `box` x `box` source pixels into every pixel of a row.
+ * The colors are weighted by their opacity, so transparent pixels don't darken the edges.
+ */
+static void box_row(const src_dsc_t * s, const src_coord_t * cols, int32_t ys, int32_t box, lv_coord_t dest_w,
+                    lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    const uint32_t px_cnt = box * box;
+    const int32_t y_start = LV_MAX(ys, 0);
+    const int32_t y_end = LV_MIN(ys + box, s->src_h);
+
+    /*Opaque pixels need no weights*/
+    const bool opaque = s->cf == LV_IMG_CF_TRUE_COLOR && y_end - y_start == box;
+
+    lv_coord_t x;
+    for(x = 0; x < dest_w; x++) {
+        const int32_t x_start = LV_MAX(cols[x].i, 0);
+        const int32_t x_end = LV_MIN(cols[x].i + box, s->src_w);
+        if(opaque && x_end - x_start == box) {
+            /*A constant size for the common ones, so the loops are unrolled and the division is a shift*/
+            if(box == 2) box_px_opaque(s, x_start, y_start, 2, &cbuf[x]);
+            else if(box == 4) box_px_opaque(s, x_start, y_start, 4, &cbuf[x]);
+            else box_px_opaque(s, x_start, y_start, box, &cbuf[x]);
+            abuf[x] = LV_OPA_COVER;
+            continue;
+        }
+
+        uint32_t a_sum = 0;
+        uint32_t r_sum = 0;
+        uint32_t g_sum = 0;
+        uint32_t b_sum = 0;
+        int32_t xs;
+        int32_t yb;
+        for(yb = y_start; yb < y_end; yb++) {
+            for(xs = x_start; xs < x_end; xs++) {
+                lv_color_t c;
+                uint32_t a = src_px(s, xs, yb, &c);
+                if(a == 0) continue;
+                a_sum += a;
+                r_sum += LV_COLOR_GET_R(c) * a;
+                g_sum += LV_COLOR_GET_G(c) * a;
+                b_sum += LV_COLOR_GET_B(c) * a;
+            }
+        }
+
+        abuf[x] = a_sum / px_cnt;
+        if(abuf[x] == 0x00) continue;
+
+        LV_COLOR_SET_R(cbuf[x], r_sum / a_sum);
+        LV_COLOR_SET_G(cbuf[x], g_sum / a_sum);
+        LV_COLOR_SET_B(cbuf[x], b_sum / a_sum);
+        LV_COLOR_SET_A(cbuf[x], 0xff);
+    }
+}
+
 static void rgb_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
                       int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                       int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_img_cf_t cf)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
-    lv_disp_t * d = _lv_refr_get_disp_refreshing();
-    lv_color_t ck = d->driver->color_chroma_key;
+    lv_color_t ck = _LV_COLOR_ZERO_INITIALIZER;
+    if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+        lv_disp_t * d = _lv_refr_get_disp_refreshing();
+        ck = d->driver->color_chroma_key;
+    }
 
     lv_memset_ff(abuf, x_end);
 
@@ -271,198 +822,19 @@ static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t sr
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
-    bool has_alpha;
-    int32_t px_size;
-    lv_color_t ck = _LV_COLOR_ZERO_INITIALIZER;
-    switch(cf) {
-        case LV_IMG_CF_TRUE_COLOR:
-            has_alpha = false;
-            px_size = sizeof(lv_color_t);
-            break;
-        case LV_IMG_CF_TRUE_COLOR_ALPHA:
-            has_alpha = true;
-            px_size = LV_IMG_PX_SIZE_ALPHA_BYTE;
-            break;
-        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED: {
-                has_alpha = true;
-                px_size = sizeof(lv_color_t);
-                lv_disp_t * d = _lv_refr_get_disp_refreshing();
-                ck = d->driver->color_chroma_key;
-                break;
-            }
-#if LV_COLOR_DEPTH == 16
-        case LV_IMG_CF_RGB565A8:
-            has_alpha = true;
-            px_size = sizeof(lv_color_t);
-            break;
-#endif
-        default:
-            return;
-    }
+    src_dsc_t s;
+    if(!src_dsc_init(&s, src, src_w, src_h, src_stride, cf)) return;
 
     lv_coord_t x;
     for(x = 0; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
-        int32_t xs_int = xs_ups >> 8;
-        int32_t ys_int = ys_ups >> 8;
-
-        /*Fully out of the image*/
-        if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
-            abuf[x] = 0x00;
-            continue;
-        }
-
-        /*Get the direction the hor and ver neighbor
-         *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
-        int32_t xs_fract = xs_ups & 0xFF;
-        int32_t ys_fract = ys_ups & 0xFF;
-
-        int32_t x_next;
-        int32_t y_next;
-        if(xs_fract < 0x80) {
-            x_next = -1;
-            xs_fract = (0x7F - xs_fract) * 2;
-        }
-        else {
-            x_next = 1;
-            xs_fract = (xs_fract - 0x80) * 2;
-        }
-        if(ys_fract < 0x80) {
-            y_next = -1;
-            ys_fract = (0x7F - ys_fract) * 2;
-        }
-        else {
-            y_next = 1;
-            ys_fract = (ys_fract - 0x80) * 2;
-        }
-
-        const uint8_t * src_tmp = src;
-        src_tmp += (ys_int * src_stride * px_size) + xs_int * px_size;
-
-
-        if(xs_int + x_next >= 0 &&
-           xs_int + x_next <= src_w - 1 &&
-           ys_int + y_next >= 0 &&
-           ys_int + y_next <= src_h - 1) {
-
-            const uint8_t * px_base = src_tmp;
-            const uint8_t * px_hor = src_tmp + x_next * px_size;
-            const uint8_t * px_ver = src_tmp + y_next * src_stride * px_size;
-            lv_color_t c_base;
-            lv_color_t c_ver;
-            lv_color_t c_hor;
-
-            if(has_alpha) {
-                lv_opa_t a_base;
-                lv_opa_t a_ver;
-                lv_opa_t a_hor;
-                if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
-                    a_base = px_base[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-                    a_ver = px_ver[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-                    a_hor = px_hor[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-                }
-#if LV_COLOR_DEPTH == 16
-                else if(cf == LV_IMG_CF_RGB565A8) {
-                    const lv_opa_t * a_tmp = src + src_stride * src_h * sizeof(lv_color_t);
-                    a_base = *(a_tmp + (ys_int * src_stride) + xs_int);
-                    a_hor = *(a_tmp + (ys_int * src_stride) + xs_int + x_next);
-                    a_ver = *(a_tmp + ((ys_int + y_next) * src_stride) + xs_int);
-                }
-#endif
-                else if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
-                    if(((lv_color_t *)px_base)->full == ck.full ||
-                       ((lv_color_t *)px_ver)->full == ck.full ||
-                       ((lv_color_t *)px_hor)->full == ck.full) {
-                        abuf[x] = 0x00;
-                        continue;
-                    }
-                    else {
-                        a_base = 0xff;
-                        a_ver = 0xff;
-                        a_hor = 0xff;
-                    }
-                }
-                else {
-                    a_base = 0xff;
-                    a_ver = 0xff;
-                    a_hor = 0xff;
-                }
-
-                if(a_ver != a_base) a_ver = ((a_ver * ys_fract) + (a_base * (0x100 - ys_fract))) >> 8;
-                if(a_hor != a_base) a_hor = ((a_hor * xs_fract) + (a_base * (0x100 - xs_fract))) >> 8;
-                abuf[x] = (a_ver + a_hor) >> 1;
-
-                if(abuf[x] == 0x00) continue;
-
-#if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
-                c_base.full = px_base[0];
-                c_ver.full = px_ver[0];
-                c_hor.full = px_hor[0];
-#elif LV_COLOR_DEPTH == 16
-                c_base.full = px_base[0] + (px_base[1] << 8);
-                c_ver.full = px_ver[0] + (px_ver[1] << 8);
-                c_hor.full = px_hor[0] + (px_hor[1] << 8);
-#elif LV_COLOR_DEPTH == 32
-                c_base.full = *((uint32_t *)px_base);
-                c_ver.full = *((uint32_t *)px_ver);
-                c_hor.full = *((uint32_t *)px_hor);
-#endif
-            }
-            /*No alpha channel -> RGB*/
-            else {
-                c_base = *((const lv_color_t *) px_base);
-                c_hor = *((const lv_color_t *) px_hor);
-                c_ver = *((const lv_color_t *) px_ver);
-                abuf[x] = 0xff;
-            }
-
-            if(c_base.full == c_ver.full && c_base.full == c_hor.full) {
-                cbuf[x] = c_base;
-            }
-            else {
-                c_ver = lv_color_mix(c_ver, c_base, ys_fract);
-                c_hor = lv_color_mix(c_hor, c_base, xs_fract);
-                cbuf[x] = lv_color_mix(c_hor, c_ver, LV_OPA_50);
-            }
-        }
-        /*Partially out of the image*/
-        else {
-#if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
-            cbuf[x].full = src_tmp[0];
-#elif LV_COLOR_DEPTH == 16
-            cbuf[x].full = src_tmp[0] + (src_tmp[1] << 8);
-#elif LV_COLOR_DEPTH == 32
-            cbuf[x].full = *((uint32_t *)src_tmp);
-#endif
-            lv_opa_t a;
-            switch(cf) {
-                case LV_IMG_CF_TRUE_COLOR_ALPHA:
-                    a = src_tmp[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-                    break;
-                case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
-                    a = cbuf[x].full == ck.full ? 0x00 : 0xff;
-                    break;
-#if LV_COLOR_DEPTH == 16
-                case LV_IMG_CF_RGB565A8:
-                    a = *(src + src_stride * src_h * sizeof(lv_color_t) + (ys_int * src_stride) + xs_int);
-                    break;
-#endif
-                default:
-                    a = 0xff;
-            }
-
-            if((xs_int == 0 && x_next < 0) || (xs_int == src_w - 1 && x_next > 0))  {
-                abuf[x] = (a * (0xFF - xs_fract)) >> 8;
-            }
-            else if((ys_int == 0 && y_next < 0) || (ys_int == src_h - 1 && y_next > 0))  {
-                abuf[x] = (a * (0xFF - ys_fract)) >> 8;
-            }
-            else {
-                abuf[x] = 0x00;
-            }
-        }
+        src_coord_t xs;
+        src_coord_t ys;
+        aa_coord(&xs, xs_ups);
+        aa_coord(&ys, ys_ups);
+        aa_px(&s, &xs, &ys, &cbuf[x], &abuf[x]);
     }
 }
 
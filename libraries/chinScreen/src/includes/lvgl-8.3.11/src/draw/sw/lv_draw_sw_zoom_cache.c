@@ -0,0 +1,282 @@
+/**
+ * @file lv_draw_sw_zoom_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw.h"
+#include "lv_draw_sw_zoom_cache.h"
+#include "../lv_img_cache.h"
+#include "../lv_img_decoder.h"
+#include "../../misc/lv_ll.h"
+#include "../../core/lv_disp.h"
+#include <string.h>
+
+#if LV_DRAW_COMPLEX
+
+/*********************
+ *      DEFINES
+ *********************/
+#define ZOOM_CHUNK_PX   4096    /*Pixels zoomed at once into the temporary buffers*/
+#define ZOOM_SIZE_MAX   2047    /*The largest width and height of `lv_img_header_t`*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    lv_img_dsc_t img;       /*First, so the image given out is the entry*/
+    const void * key;       /*The data of a variable source or a copy of the file name*/
+    uint8_t is_file;
+    uint16_t zoom;
+    uint32_t ref_cnt;
+    uint32_t bytes;
+} zoom_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static zoom_entry_t * entry_create(const void * src, const void * key, uint16_t zoom);
+static bool entry_zoom(zoom_entry_t * entry, const lv_img_decoder_dsc_t * dec, uint16_t zoom);
+static bool cache_trim(uint32_t bytes);
+static void entry_free(zoom_entry_t * entry);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_ll_t zoom_ll;     /*Most recently used first*/
+static uint32_t zoom_bytes;
+static uint32_t zoom_budget = LV_DRAW_SW_ZOOM_CACHE_DEF_BYTES;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+const lv_img_dsc_t * lv_draw_sw_zoom_cache_open(const void * src, uint16_t zoom)
+{
+    if(zoom == 0 || zoom == LV_IMG_ZOOM_NONE) return NULL;
+
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    const void * key;
+    if(src_type == LV_IMG_SRC_VARIABLE) key = ((const lv_img_dsc_t *)src)->data;
+    else if(src_type == LV_IMG_SRC_FILE) key = src;
+    else return NULL;
+
+    if(zoom_ll.n_size == 0) _lv_ll_init(&zoom_ll, sizeof(zoom_entry_t));
+
+    zoom_entry_t * entry;
+    _LV_LL_READ(&zoom_ll, entry) {
+        if(entry->zoom != zoom) continue;
+        bool match = entry->is_file ? src_type == LV_IMG_SRC_FILE && strcmp(entry->key, key) == 0 :
+                     src_type == LV_IMG_SRC_VARIABLE && entry->key == key;
+        if(match) {
+            entry->ref_cnt++;
+            _lv_ll_move_before(&zoom_ll, entry, _lv_ll_get_head(&zoom_ll));
+            return &entry->img;
+        }
+    }
+
+    entry = entry_create(src, key, zoom);
+    if(entry == NULL) return NULL;
+    entry->ref_cnt = 1;
+    return &entry->img;
+}
+
+void lv_draw_sw_zoom_cache_close(const lv_img_dsc_t * img)
+{
+    if(img == NULL) return;
+
+    zoom_entry_t * entry = (zoom_entry_t *)img;
+    entry->ref_cnt--;
+    cache_trim(0);
+}
+
+void lv_draw_sw_zoom_cache_set_budget(uint32_t bytes)
+{
+    zoom_budget = bytes;
+    cache_trim(0);
+}
+
+void lv_draw_sw_zoom_cache_get_stats(lv_draw_sw_zoom_cache_stats_t * stats)
+{
+    lv_memset_00(stats, sizeof(lv_draw_sw_zoom_cache_stats_t));
+    stats->bytes = zoom_bytes;
+    stats->budget = zoom_budget;
+    if(zoom_ll.n_size == 0) return;
+
+    zoom_entry_t * entry;
+    _LV_LL_READ(&zoom_ll, entry) {
+        stats->img_cnt++;
+        stats->ref_cnt += entry->ref_cnt;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static zoom_entry_t * entry_create(const void * src, const void * key, uint16_t zoom)
+{
+    lv_img_decoder_dsc_t dec;
+    if(lv_img_decoder_open(&dec, src, lv_color_white(), 0) != LV_RES_OK) return NULL;
+
+    /*Only whole images in the formats the transformation reads without a display*/
+    lv_img_cf_t cf = dec.header.cf;
+    bool ok = dec.img_data != NULL &&
+              (cf == LV_IMG_CF_TRUE_COLOR || cf == LV_IMG_CF_TRUE_COLOR_ALPHA
+#if LV_COLOR_DEPTH == 16
+               || cf == LV_IMG_CF_RGB565A8
+#endif
+              );
+
+    uint32_t w = ((uint32_t)dec.header.w * zoom + LV_IMG_ZOOM_NONE - 1) / LV_IMG_ZOOM_NONE;
+    uint32_t h = ((uint32_t)dec.header.h * zoom + LV_IMG_ZOOM_NONE - 1) / LV_IMG_ZOOM_NONE;
+    uint32_t bytes = w * h * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    if(ok && (w == 0 || h == 0 || w > ZOOM_SIZE_MAX || h > ZOOM_SIZE_MAX)) ok = false;
+    if(ok && !cache_trim(bytes)) {
+        LV_LOG_INFO("%"LV_PRIu32" bytes of zoomed image don't fit the budget", bytes);
+        ok = false;
+    }
+
+    zoom_entry_t * entry = NULL;
+    if(ok) {
+        entry = _lv_ll_ins_head(&zoom_ll);
+        ok = entry != NULL;
+    }
+    if(ok) {
+        lv_memset_00(entry, sizeof(zoom_entry_t));
+        entry->is_file = lv_img_src_get_type(src) == LV_IMG_SRC_FILE;
+        entry->zoom = zoom;
+        entry->bytes = bytes;
+        entry->img.header.always_zero = 0;
+        entry->img.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+        entry->img.header.w = w;
+        entry->img.header.h = h;
+        entry->img.data_size = bytes;
+        entry->img.data = lv_img_cache_alloc(bytes);
+        if(entry->is_file) {
+            char * name = lv_mem_alloc(strlen(key) + 1);
+            if(name) strcpy(name, key);
+            entry->key = name;
+        }
+        else {
+            entry->key = key;
+        }
+        zoom_bytes += bytes;
+        ok = entry->img.data && entry->key;
+    }
+    if(ok) ok = entry_zoom(entry, &dec, zoom);
+    lv_img_decoder_close(&dec);
+
+    if(!ok && entry) {
+        entry_free(entry);
+        entry = NULL;
+    }
+    return entry;
+}
+
+/**
+ * Zoom the decoded image into the entry, in chunks of rows
+ * @return          false: out of memory
+ */
+static bool entry_zoom(zoom_entry_t * entry, const lv_img_decoder_dsc_t * dec, uint16_t zoom)
+{
+    lv_draw_img_dsc_t draw_dsc;
+    lv_draw_img_dsc_init(&draw_dsc);
+    draw_dsc.zoom = zoom;
+    draw_dsc.pivot.x = 0;
+    draw_dsc.pivot.y = 0;
+    lv_disp_t * disp = lv_disp_get_default();
+    draw_dsc.antialias = disp ? disp->driver->antialiasing : 1;
+
+    lv_coord_t w = entry->img.header.w;
+    lv_coord_t h = entry->img.header.h;
+    lv_coord_t rows = LV_CLAMP(1, ZOOM_CHUNK_PX / w, h);
+    lv_color_t * cbuf = lv_mem_buf_get(w * rows * sizeof(lv_color_t));
+    lv_opa_t * abuf = lv_mem_buf_get(w * rows);
+    bool ok = cbuf && abuf;
+
+    uint8_t * dest = (uint8_t *)entry->img.data;
+    lv_coord_t y;
+    for(y = 0; ok && y < h; y += rows) {
+        lv_area_t area;
+        lv_area_set(&area, 0, y, w - 1, LV_MIN(y + rows, h) - 1);
+        lv_draw_sw_transform(NULL, &area, dec->img_data, dec->header.w, dec->header.h, dec->header.w,
+                             &draw_dsc, dec->header.cf, cbuf, abuf);
+
+        /*Transparent pixels get no color, so the image is the same every time*/
+        uint32_t px_cnt = lv_area_get_size(&area);
+        uint32_t i;
+        for(i = 0; i < px_cnt; i++) {
+            if(abuf[i] == LV_OPA_TRANSP) lv_memset_00(dest, LV_IMG_PX_SIZE_ALPHA_BYTE);
+            else lv_memcpy(dest, &cbuf[i], LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+            dest[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = abuf[i];
+            dest += LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+    }
+
+    if(cbuf) lv_mem_buf_release(cbuf);
+    if(abuf) lv_mem_buf_release(abuf);
+    return ok;
+}
+
+/**
+ * Free the least recently used images nobody shows until `bytes` more fit the budget
+ * @param bytes     bytes to make room for
+ * @return          true: they fit
+ */
+static bool cache_trim(uint32_t bytes)
+{
+    if(bytes > zoom_budget) return false;
+    if(zoom_ll.n_size == 0) return true;
+
+    zoom_entry_t * entry = _lv_ll_get_tail(&zoom_ll);
+    while(entry && zoom_bytes + bytes > zoom_budget) {
+        zoom_entry_t * prev = _lv_ll_get_prev(&zoom_ll, entry);
+        if(entry->ref_cnt == 0) entry_free(entry);
+        entry = prev;
+    }
+    return zoom_bytes + bytes <= zoom_budget;
+}
+
+static void entry_free(zoom_entry_t * entry)
+{
+    /*The image cache might still know the descriptor*/
+    lv_img_cache_invalidate_src(&entry->img);
+    zoom_bytes -= entry->bytes;
+    lv_img_cache_free((void *)entry->img.data);
+    if(entry->is_file) lv_mem_free((void *)entry->key);
+    _lv_ll_remove(&zoom_ll, entry);
+    lv_mem_free(entry);
+}
+
+#else /*LV_DRAW_COMPLEX*/
+
+const lv_img_dsc_t * lv_draw_sw_zoom_cache_open(const void * src, uint16_t zoom)
+{
+    LV_UNUSED(src);
+    LV_UNUSED(zoom);
+    return NULL;
+}
+
+void lv_draw_sw_zoom_cache_close(const lv_img_dsc_t * img)
+{
+    LV_UNUSED(img);
+}
+
+void lv_draw_sw_zoom_cache_set_budget(uint32_t bytes)
+{
+    LV_UNUSED(bytes);
+}
+
+void lv_draw_sw_zoom_cache_get_stats(lv_draw_sw_zoom_cache_stats_t * stats)
+{
+    lv_memset_00(stats, sizeof(lv_draw_sw_zoom_cache_stats_t));
+}
+
+#endif /*LV_DRAW_COMPLEX*/
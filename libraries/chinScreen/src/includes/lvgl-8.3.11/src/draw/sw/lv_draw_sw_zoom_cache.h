@@ -0,0 +1,74 @@
+/**
+ * @file lv_draw_sw_zoom_cache.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_ZOOM_CACHE_H
+#define LV_DRAW_SW_ZOOM_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf_internal.h"
+#include "../lv_img_buf.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t img_cnt;       /*Pre-zoomed images*/
+    uint32_t ref_cnt;       /*Users of them*/
+    uint32_t bytes;
+    uint32_t budget;
+} lv_draw_sw_zoom_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get an image zoomed once, to show instead of zooming it every time it's drawn.
+ * The image is zoomed by `lv_draw_sw_transform()` around its top left corner, so it looks like the
+ * zoomed original. Images with the same source and zoom are shared.
+ * @param src       a variable or file source in true color, with or without alpha
+ * @param zoom      zoom factor, 256: no zoom
+ * @return          the zoomed image with a reference taken, NULL if it can't be zoomed or doesn't fit the budget
+ */
+const lv_img_dsc_t * lv_draw_sw_zoom_cache_open(const void * src, uint16_t zoom);
+
+/**
+ * Give back an image from `lv_draw_sw_zoom_cache_open()`. It's kept until its room is needed.
+ * @param img       the zoomed image
+ */
+void lv_draw_sw_zoom_cache_close(const lv_img_dsc_t * img);
+
+/**
+ * Set how many bytes the pre-zoomed images may use.
+ * @param bytes     the budget, `LV_DRAW_SW_ZOOM_CACHE_DEF_BYTES` by default
+ */
+void lv_draw_sw_zoom_cache_set_budget(uint32_t bytes);
+
+/**
+ * Get how many pre-zoomed images there are and the memory they use.
+ * @param stats     the stats are written here
+ */
+void lv_draw_sw_zoom_cache_get_stats(lv_draw_sw_zoom_cache_stats_t * stats);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_ZOOM_CACHE_H*/
@@ -23,6 +23,16 @@ typedef struct Table {
     Entry *entries;
 } Table;
 
+/* LZW bit stream over the data sub-blocks of an image */
+typedef struct Reader {
+    const uint8_t *p;   /* Next byte of the current sub-block */
+    int left;           /* Bytes left in it */
+    uint32_t bits;      /* Bits read ahead, the next key in the lowest */
+    int nbits;
+    int done;           /* The block terminator was read */
+    uint8_t buf[0xFF];  /* The current sub-block of a file */
+} Reader;
+
 static gd_GIF *  gif_open(gd_GIF * gif);
 static bool f_gif_open(gd_GIF * gif, const void * path, bool is_file);
 static void f_gif_read(gd_GIF * gif, void * buf, size_t len);
@@ -38,6 +48,60 @@ read_num(gd_GIF * gif)
     return bytes[0] + (((uint16_t) bytes[1]) << 8);
 }
 
+/* Canvas pixel of a palette color */
+static void
+make_px(uint8_t *px, const uint8_t *color, uint8_t opa)
+{
+#if LV_COLOR_DEPTH == 32
+    px[0] = *(color + 2);
+    px[1] = *(color + 1);
+    px[2] = *(color + 0);
+    px[3] = opa;
+#elif LV_COLOR_DEPTH == 16
+    lv_color_t c = lv_color_make(*(color + 0), *(color + 1), *(color + 2));
+    px[0] = c.full & 0xff;
+    px[1] = (c.full >> 8) & 0xff;
+    px[2] = opa;
+#elif LV_COLOR_DEPTH == 8
+    lv_color_t c = lv_color_make(*(color + 0), *(color + 1), *(color + 2));
+    px[0] = c.full;
+    px[1] = opa;
+#elif LV_COLOR_DEPTH == 1
+    uint8_t b = (*(color + 0)) | (*(color + 1)) | (*(color + 2));
+    px[0] = b > 128 ? 1 : 0;
+    px[1] = opa;
+#endif
+}
+
+/* Convert the active palette to canvas pixels, so frames are drawn by copying them */
+static void
+update_lut(gd_GIF *gif)
+{
+    int i;
+
+    /* The GCT only needs it once, an LCT is read again with every frame */
+    if (gif->palette == gif->lut_palette && gif->palette == &gif->gct)
+        return;
+    for (i = 0; i < gif->palette->size; i++)
+        make_px(gif->lut[i], &gif->palette->colors[i*3], 0xff);
+    gif->lut_palette = gif->palette;
+}
+
+/* Fill a rectangle of the canvas with a pixel: the first row one by one, then copies of it */
+static void
+fill_rect(gd_GIF *gif, int x, int y, int w, int h, const uint8_t *px)
+{
+    uint8_t *first, *dst;
+    int i;
+
+    if (w <= 0 || h <= 0) return;
+    first = &gif->canvas[(y * gif->width + x) * GD_PX_SIZE];
+    for (i = 0, dst = first; i < w; i++, dst += GD_PX_SIZE)
+        memcpy(dst, px, GD_PX_SIZE);
+    for (i = 1; i < h; i++)
+        memcpy(&first[i * gif->width * GD_PX_SIZE], first, w * GD_PX_SIZE);
+}
+
 
 
 gd_GIF *
@@ -70,8 +134,7 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     uint8_t sigver[3];
     uint16_t width, height, depth;
     uint8_t fdsz, bgidx, aspect;
-    int i;
-    uint8_t *bgcolor;
+    uint8_t bgpx[GD_PX_SIZE];
     int gct_sz;
     gd_GIF *gif = NULL;
 
@@ -92,28 +155,17 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     height = read_num(gif_base);
     /* FDSZ */
     f_gif_read(gif_base, &fdsz, 1);
-    /* Presence of GCT */
-    if (!(fdsz & 0x80)) {
-        LV_LOG_WARN("no global color table\n");
-        goto fail;
-    }
     /* Color Space's Depth */
     depth = ((fdsz >> 4) & 7) + 1;
     /* Ignore Sort Flag. */
-    /* GCT Size */
-    gct_sz = 1 << ((fdsz & 0x07) + 1);
+    /* GCT Size, without one every frame has a local color table */
+    gct_sz = fdsz & 0x80 ? 1 << ((fdsz & 0x07) + 1) : 0;
     /* Background Color Index */
     f_gif_read(gif_base, &bgidx, 1);
     /* Aspect Ratio */
     f_gif_read(gif_base, &aspect, 1);
     /* Create gd_GIF Structure. */
-#if LV_COLOR_DEPTH == 32
-    gif = lv_mem_alloc(sizeof(gd_GIF) + 5 * width * height);
-#elif LV_COLOR_DEPTH == 16
-    gif = lv_mem_alloc(sizeof(gd_GIF) + 4 * width * height);
-#elif LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
-    gif = lv_mem_alloc(sizeof(gd_GIF) + 3 * width * height);
-#endif
+    gif = lv_mem_alloc(sizeof(gd_GIF) + (GD_PX_SIZE + 1) * width * height);
 
     if (!gif) goto fail;
     memcpy(gif, gif_base, sizeof(gd_GIF));
@@ -126,39 +178,13 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     gif->palette = &gif->gct;
     gif->bgindex = bgidx;
     gif->canvas = (uint8_t *) &gif[1];
-#if LV_COLOR_DEPTH == 32
-    gif->frame = &gif->canvas[4 * width * height];
-#elif LV_COLOR_DEPTH == 16
-    gif->frame = &gif->canvas[3 * width * height];
-#elif LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
-    gif->frame = &gif->canvas[2 * width * height];
-#endif
+    gif->frame = &gif->canvas[GD_PX_SIZE * width * height];
     if (gif->bgindex) {
         memset(gif->frame, gif->bgindex, gif->width * gif->height);
     }
-    bgcolor = &gif->palette->colors[gif->bgindex*3];
-
-    for (i = 0; i < gif->width * gif->height; i++) {
-#if LV_COLOR_DEPTH == 32
-        gif->canvas[i*4 + 0] = *(bgcolor + 2);
-        gif->canvas[i*4 + 1] = *(bgcolor + 1);
-        gif->canvas[i*4 + 2] = *(bgcolor + 0);
-        gif->canvas[i*4 + 3] = 0xff;
-#elif LV_COLOR_DEPTH == 16
-        lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-        gif->canvas[i*3 + 0] = c.full & 0xff;
-        gif->canvas[i*3 + 1] = (c.full >> 8) & 0xff;
-        gif->canvas[i*3 + 2] = 0xff;
-#elif LV_COLOR_DEPTH == 8
-        lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-        gif->canvas[i*2 + 0] = c.full;
-        gif->canvas[i*2 + 1] = 0xff;
-#elif LV_COLOR_DEPTH == 1
-        lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-        gif->canvas[i*2 + 0] = c.ch.red > 128 ? 1 : 0;
-        gif->canvas[i*2 + 1] = 0xff;
-#endif
-    }
+    /* Transparent without a GCT */
+    make_px(bgpx, &gif->palette->colors[gif->bgindex*3], gct_sz ? 0xff : 0x00);
+    fill_rect(gif, 0, 0, gif->width, gif->height, bgpx);
     gif->anim_start = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
     gif->loop_count = -1;
     goto ok;
@@ -334,32 +360,44 @@ add_entry(Table **tablep, uint16_t length, uint16_t prefix, uint8_t suffix)
     return 0;
 }
 
+/* Move to the next data sub-block: points into the data of a memory source, one read for a file.
+ * Return 0 at the block terminator. */
+static int
+next_sub_block(gd_GIF *gif, Reader *r)
+{
+    uint8_t size;
+
+    f_gif_read(gif, &size, 1);
+    if (size == 0) {
+        r->done = 1;
+        return 0;
+    }
+    if (gif->is_file) {
+        f_gif_read(gif, r->buf, size);
+        r->p = r->buf;
+    } else {
+        r->p = (const uint8_t *) &gif->data[gif->f_rw_p];
+        gif->f_rw_p += size;
+    }
+    r->left = size;
+    return 1;
+}
+
 static uint16_t
-get_key(gd_GIF *gif, int key_size, uint8_t *sub_len, uint8_t *shift, uint8_t *byte)
+get_key(gd_GIF *gif, Reader *r, int key_size)
 {
-    int bits_read;
-    int rpad;
-    int frag_size;
     uint16_t key;
 
-    key = 0;
-    for (bits_read = 0; bits_read < key_size; bits_read += frag_size) {
-        rpad = (*shift + bits_read) % 8;
-        if (rpad == 0) {
-            /* Update byte. */
-            if (*sub_len == 0) {
-                f_gif_read(gif, sub_len, 1); /* Must be nonzero! */
-                if (*sub_len == 0) return 0x1000;
-            }
-            f_gif_read(gif, byte, 1);
-            (*sub_len)--;
-        }
-        frag_size = MIN(key_size - bits_read, 8 - rpad);
-        key |= ((uint16_t) ((*byte) >> rpad)) << bits_read;
+    while (r->nbits < key_size) {
+        if (r->left == 0 && !next_sub_block(gif, r))
+            return 0x1000;
+        r->bits |= (uint32_t) *r->p++ << r->nbits;
+        r->nbits += 8;
+        r->left--;
     }
-    /* Clear extra bits to the left. */
-    key &= (1 << key_size) - 1;
-    *shift = (*shift + key_size) % 8;
+    key = r->bits & ((1 << key_size) - 1);
+    r->bits >>= key_size;
+    r->nbits -= key_size;
     return key;
 }
 
@@ -385,36 +423,46 @@ interlaced_line_index(int h, int y)
     return y * 2 + 1;
 }
 
+/* First index of the y-th input line of the frame */
+static uint8_t *
+frame_row(gd_GIF *gif, int y, int interlace)
+{
+    if (interlace)
+        y = interlaced_line_index((int) gif->fh, y);
+    return &gif->frame[(gif->fy + y) * gif->width + gif->fx];
+}
+
 /* Decompress image pixels.
  * Return 0 on success or -1 on out-of-memory (w.r.t. LZW code table). */
 static int
 read_image_data(gd_GIF *gif, int interlace)
 {
-    uint8_t sub_len, shift, byte;
+    Reader r;
+    uint8_t byte, *row;
     int init_key_size, key_size, table_is_full=0;
     int frm_off, frm_size, str_len=0, i, p, x, y;
     uint16_t key, clear, stop;
     int ret;
     Table *table;
     Entry entry = {0};
-    size_t start, end;
 
     f_gif_read(gif, &byte, 1);
     key_size = (int) byte;
-    start = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
-    discard_sub_blocks(gif);
-    end = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
-    f_gif_seek(gif, start, LV_FS_SEEK_SET);
     clear = 1 << key_size;
     stop = clear + 1;
     table = new_table(key_size);
+    if (!table) return -1;
     key_size++;
     init_key_size = key_size;
-    sub_len = shift = 0;
-    key = get_key(gif, key_size, &sub_len, &shift, &byte); /* clear code */
+    r.left = r.nbits = r.done = 0;
+    r.bits = 0;
+    key = get_key(gif, &r, key_size); /* clear code */
     frm_off = 0;
     ret = 0;
     frm_size = gif->fw*gif->fh;
+    /* Where frm_off is in the frame */
+    x = y = 0;
+    row = frame_row(gif, 0, interlace);
     while (frm_off < frm_size) {
         if (key == clear) {
             key_size = init_key_size;
@@ -431,31 +479,48 @@ read_image_data(gd_GIF *gif, int interlace)
                 table_is_full = 1;
             }
         }
-        key = get_key(gif, key_size, &sub_len, &shift, &byte);
+        key = get_key(gif, &r, key_size);
         if (key == clear) continue;
         if (key == stop || key == 0x1000) break;
         if (ret == 1) key_size++;
         entry = table->entries[key];
         str_len = entry.length;
-        for (i = 0; i < str_len; i++) {
-            p = frm_off + entry.length - 1;
-            x = p % gif->fw;
-            y = p / gif->fw;
-            if (interlace)
-                y = interlaced_line_index((int) gif->fh, y);
-            gif->frame[(gif->fy + y) * gif->width + gif->fx + x] = entry.suffix;
-            if (entry.prefix == 0xFFF)
-                break;
-            else
-                entry = table->entries[entry.prefix];
+        /* Strings come out last pixel first */
+        if (x + str_len <= gif->fw) {
+            for (i = str_len - 1; i >= 0; i--) {
+                row[x + i] = entry.suffix;
+                if (entry.prefix == 0xFFF)
+                    break;
+                else
+                    entry = table->entries[entry.prefix];
+            }
+        } else {
+            /* Continues on the next lines */
+            for (i = 0; i < str_len; i++) {
+                p = frm_off + entry.length - 1;
+                if (p < frm_size)
+                    frame_row(gif, p / gif->fw, interlace)[p % gif->fw] = entry.suffix;
+                if (entry.prefix == 0xFFF)
+                    break;
+                else
+                    entry = table->entries[entry.prefix];
+            }
         }
         frm_off += str_len;
+        x += str_len;
+        if (x >= gif->fw) {
+            y += x / gif->fw;
+            x %= gif->fw;
+            if (y < gif->fh)
+                row = frame_row(gif, y, interlace);
+        }
         if (key < table->nentries - 1 && !table_is_full)
             table->entries[table->nentries - 1].suffix = entry.suffix;
     }
     lv_mem_free(table);
-    if (key == stop) f_gif_read(gif, &sub_len, 1); /* Must be zero! */
-    f_gif_seek(gif, end, LV_FS_SEEK_SET);
+    /* Skip the rest of the data up to the block terminator */
+    if (!r.done)
+        discard_sub_blocks(gif);
     return 0;
 }
 
@@ -483,6 +548,8 @@ read_image(gd_GIF *gif)
         gif->palette = &gif->lct;
     } else
         gif->palette = &gif->gct;
+    update_lut(gif);
+    gif->rendered = 0;
     /* Image Data. */
     return read_image_data(gif, interlace);
 }
@@ -490,91 +557,72 @@ read_image(gd_GIF *gif)
 static void
 render_frame_rect(gd_GIF *gif, uint8_t *buffer)
 {
-    int i, j, k;
-    uint8_t index, *color;
-    i = gif->fy * gif->width + gif->fx;
+    int j, k;
+    const uint8_t *index;
+    uint8_t *px;
+    uint8_t tindex = gif->gce.tindex;
     for (j = 0; j < gif->fh; j++) {
-        for (k = 0; k < gif->fw; k++) {
-            index = gif->frame[(gif->fy + j) * gif->width + gif->fx + k];
-            color = &gif->palette->colors[index*3];
-            if (!gif->gce.transparency || index != gif->gce.tindex) {
-#if LV_COLOR_DEPTH == 32
-                buffer[(i+k)*4 + 0] = *(color + 2);
-                buffer[(i+k)*4 + 1] = *(color + 1);
-                buffer[(i+k)*4 + 2] = *(color + 0);
-                buffer[(i+k)*4 + 3] = 0xFF;
-#elif LV_COLOR_DEPTH == 16
-                lv_color_t c = lv_color_make(*(color + 0), *(color + 1), *(color + 2));
-                buffer[(i+k)*3 + 0] = c.full & 0xff;
-                buffer[(i+k)*3 + 1] = (c.full >> 8) & 0xff;
-                buffer[(i+k)*3 + 2] = 0xff;
-#elif LV_COLOR_DEPTH == 8
-                lv_color_t c = lv_color_make(*(color + 0), *(color + 1), *(color + 2));
-                buffer[(i+k)*2 + 0] = c.full;
-                buffer[(i+k)*2 + 1] = 0xff;
-#elif LV_COLOR_DEPTH == 1
-                uint8_t b = (*(color + 0)) | (*(color + 1)) | (*(color + 2));
-                buffer[(i+k)*2 + 0] = b > 128 ? 1 : 0;
-                buffer[(i+k)*2 + 1] = 0xff;
-#endif
+        index = &gif->frame[(gif->fy + j) * gif->width + gif->fx];
+        px = &buffer[((gif->fy + j) * gif->width + gif->fx) * GD_PX_SIZE];
+        if (!gif->gce.transparency || !memchr(index, tindex, gif->fw)) {
+            /* Opaque row */
+            for (k = 0; k < gif->fw; k++, px += GD_PX_SIZE)
+                memcpy(px, gif->lut[index[k]], GD_PX_SIZE);
+        } else {
+            for (k = 0; k < gif->fw; k++, px += GD_PX_SIZE) {
+                if (index[k] != tindex)
+                    memcpy(px, gif->lut[index[k]], GD_PX_SIZE);
             }
         }
-        i += gif->width;
     }
 }
 
 static void
 dispose(gd_GIF *gif)
 {
-    int i, j, k;
-    uint8_t *bgcolor;
+    uint8_t bgpx[GD_PX_SIZE];
     switch (gif->gce.disposal) {
     case 2: /* Restore to background color. */
-        bgcolor = &gif->palette->colors[gif->bgindex*3];
-
-        uint8_t opa = 0xff;
-        if(gif->gce.transparency) opa = 0x00;
-
-        i = gif->fy * gif->width + gif->fx;
-        for (j = 0; j < gif->fh; j++) {
-            for (k = 0; k < gif->fw; k++) {
-#if LV_COLOR_DEPTH == 32
-                gif->canvas[(i+k)*4 + 0] = *(bgcolor + 2);
-                gif->canvas[(i+k)*4 + 1] = *(bgcolor + 1);
-                gif->canvas[(i+k)*4 + 2] = *(bgcolor + 0);
-                gif->canvas[(i+k)*4 + 3] = opa;
-#elif LV_COLOR_DEPTH == 16
-                lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-                gif->canvas[(i+k)*3 + 0] = c.full & 0xff;
-                gif->canvas[(i+k)*3 + 1] = (c.full >> 8) & 0xff;
-                gif->canvas[(i+k)*3 + 2] = opa;
-#elif LV_COLOR_DEPTH == 8
-                lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-                gif->canvas[(i+k)*2 + 0] = c.full;
-                gif->canvas[(i+k)*2 + 1] = opa;
-#elif LV_COLOR_DEPTH == 1
-                uint8_t b = (*(bgcolor + 0)) | (*(bgcolor + 1)) | (*(bgcolor + 2));
-                gif->canvas[(i+k)*2 + 0] = b > 128 ? 1 : 0;
-                gif->canvas[(i+k)*2 + 1] = opa;
-#endif
-            }
-            i += gif->width;
-        }
+        make_px(bgpx, &gif->palette->colors[gif->bgindex*3], gif->gce.transparency ? 0x00 : 0xff);
+        fill_rect(gif, gif->fx, gif->fy, gif->fw, gif->fh, bgpx);
         break;
     case 3: /* Restore to previous, i.e., don't update canvas.*/
         break;
     default:
-        /* Add frame non-transparent pixels to canvas. */
-        render_frame_rect(gif, gif->canvas);
+        /* Add frame non-transparent pixels to canvas, unless gd_render_frame() already did. */
+        if (!gif->rendered)
+            render_frame_rect(gif, gif->canvas);
     }
 }
 
+/* Add the frame rect to the dirty area, clipped to the canvas */
+static void
+add_dirty(gd_GIF *gif)
+{
+    lv_area_t a;
+
+    if (!gif->fw || !gif->fh || gif->fx >= gif->width || gif->fy >= gif->height)
+        return;
+    a.x1 = gif->fx;
+    a.y1 = gif->fy;
+    a.x2 = MIN(gif->fx + gif->fw, gif->width) - 1;
+    a.y2 = MIN(gif->fy + gif->fh, gif->height) - 1;
+    if (gif->dirty.x2 < gif->dirty.x1)
+        gif->dirty = a;
+    else
+        _lv_area_join(&gif->dirty, &gif->dirty, &a);
+}
+
 /* Return 1 if got a frame; 0 if got GIF trailer; -1 if error. */
 int
 gd_get_frame(gd_GIF *gif)
 {
     char sep;
 
+    /* Where the last frame is disposed of, unless the canvas has it already */
+    lv_area_set(&gif->dirty, 0, 0, -1, -1);
+    if (gif->gce.disposal == 2 || (gif->gce.disposal != 3 && !gif->rendered))
+        add_dirty(gif);
     dispose(gif);
     f_gif_read(gif, &sep, 1);
     while (sep != ',') {
@@ -594,6 +642,8 @@ gd_get_frame(gd_GIF *gif)
     }
     if (read_image(gif) == -1)
         return -1;
+    /* and where the next one is drawn */
+    add_dirty(gif);
     return 1;
 }
 
@@ -610,6 +660,8 @@ gd_render_frame(gd_GIF *gif, uint8_t *buffer)
 //    }
 //    memcpy(buffer, gif->canvas, gif->width * gif->height * 3);
     render_frame_rect(gif, buffer);
+    if (buffer == gif->canvas)
+        gif->rendered = 1;
 }
 
 void
@@ -3,9 +3,19 @@
 
 #include <stdint.h>
 #include "../../../misc/lv_fs.h"
+#include "../../../misc/lv_area.h"
 
 #if LV_USE_GIF
 
+/* Bytes of a canvas pixel: the color and its alpha, like LV_IMG_CF_TRUE_COLOR_ALPHA */
+#if LV_COLOR_DEPTH == 32
+#define GD_PX_SIZE 4
+#elif LV_COLOR_DEPTH == 16
+#define GD_PX_SIZE 3
+#else
+#define GD_PX_SIZE 2
+#endif
+
 typedef struct gd_Palette {
     int size;
     uint8_t colors[0x100 * 3];
@@ -33,6 +43,11 @@ typedef struct gd_GIF {
     gd_GCE gce;
     gd_Palette *palette;
     gd_Palette lct, gct;
+    /* The active palette as canvas pixels, see update_lut() */
+    uint8_t lut[0x100][GD_PX_SIZE];
+    gd_Palette *lut_palette;
+    uint8_t rendered;   /* The frame is on the canvas already */
+    lv_area_t dirty;    /* Canvas area the last gd_get_frame() changes, empty (x2 < x1) if none */
     void (*plain_text)(
         struct gd_GIF *gif, uint16_t tx, uint16_t ty,
         uint16_t tw, uint16_t th, uint8_t cw, uint8_t ch,
@@ -10,6 +10,7 @@
 #if LV_USE_GIF
 
 #include "gifdec.h"
+#include <string.h>
 
 /*********************
  *      DEFINES
@@ -19,7 +20,25 @@
 /**********************
  *      TYPEDEFS
  **********************/
+typedef struct {
+    lv_area_t dirty;    /*Canvas area changed from the previous frame*/
+    uint32_t delay;     /*How long the frame is shown [ms]*/
+} atlas_frame_t;
 
+typedef struct _lv_gif_atlas_t {
+    const void * key;       /*The data of a variable source or a copy of the file name*/
+    uint8_t is_file;
+    uint32_t ref_cnt;
+    uint32_t bytes;
+    uint16_t w;
+    uint16_t h;
+    uint16_t frame_cnt;
+    int32_t loop_count;     /*`gd_GIF.loop_count` after the first frame*/
+    lv_img_cf_t cf;         /*TRUE_COLOR if every frame is opaque*/
+    uint32_t frame_size;
+    uint8_t * data;         /*The frames one after the other*/
+    atlas_frame_t * frames;
+} lv_gif_atlas_t;
 
 /**********************
  *  STATIC PROTOTYPES
@@ -27,6 +46,14 @@
 static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void next_frame_task_cb(lv_timer_t * t);
+static void atlas_next_frame(lv_obj_t * obj);
+static void invalidate_canvas_area(lv_obj_t * obj, const lv_area_t * area);
+static lv_gif_atlas_t * atlas_open(const void * src);
+static lv_gif_atlas_t * atlas_create(const void * src, const void * key);
+static bool same_state(const gd_GIF * gif, const uint8_t * state);
+static void atlas_release(lv_gif_atlas_t * atlas);
+static bool atlas_trim(uint32_t bytes);
+static void atlas_free(lv_gif_atlas_t * atlas);
 
 /**********************
  *  STATIC VARIABLES
@@ -38,6 +65,10 @@ const lv_obj_class_t lv_gif_class = {
     .base_class = &lv_img_class
 };
 
+static lv_ll_t atlas_ll;    /*Most recently used first*/
+static uint32_t atlas_bytes;
+static uint32_t atlas_budget = LV_GIF_ATLAS_DEF_BYTES;
+
 /**********************
  *      MACROS
  **********************/
@@ -66,24 +97,44 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
         gifobj->gif = NULL;
         gifobj->imgdsc.data = NULL;
     }
-
-    if(lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE) {
-        const lv_img_dsc_t * img_dsc = src;
-        gifobj->gif = gd_open_gif_data(img_dsc->data);
-    }
-    else if(lv_img_src_get_type(src) == LV_IMG_SRC_FILE) {
-        gifobj->gif = gd_open_gif_file(src);
+    if(gifobj->atlas) {
+        lv_img_cache_invalidate_src(&gifobj->imgdsc);
+        atlas_release(gifobj->atlas);
+        gifobj->atlas = NULL;
+        gifobj->imgdsc.data = NULL;
     }
-    if(gifobj->gif == NULL) {
-        LV_LOG_WARN("Could't load the source");
-        return;
+
+    if(gifobj->use_atlas) gifobj->atlas = atlas_open(src);
+
+    if(gifobj->atlas) {
+        lv_gif_atlas_t * atlas = gifobj->atlas;
+        gifobj->imgdsc.data = atlas->data;
+        gifobj->imgdsc.header.cf = atlas->cf;
+        gifobj->imgdsc.header.h = atlas->h;
+        gifobj->imgdsc.header.w = atlas->w;
+        gifobj->atlas_frame = 0;
+        gifobj->atlas_next = 1;
+        gifobj->loop_count = atlas->loop_count;
     }
+    else {
+        if(lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE) {
+            const lv_img_dsc_t * img_dsc = src;
+            gifobj->gif = gd_open_gif_data(img_dsc->data);
+        }
+        else if(lv_img_src_get_type(src) == LV_IMG_SRC_FILE) {
+            gifobj->gif = gd_open_gif_file(src);
+        }
+        if(gifobj->gif == NULL) {
+            LV_LOG_WARN("Could't load the source");
+            return;
+        }
 
-    gifobj->imgdsc.data = gifobj->gif->canvas;
+        gifobj->imgdsc.data = gifobj->gif->canvas;
+        gifobj->imgdsc.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+        gifobj->imgdsc.header.h = gifobj->gif->height;
+        gifobj->imgdsc.header.w = gifobj->gif->width;
+    }
     gifobj->imgdsc.header.always_zero = 0;
-    gifobj->imgdsc.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
-    gifobj->imgdsc.header.h = gifobj->gif->height;
-    gifobj->imgdsc.header.w = gifobj->gif->width;
     gifobj->last_call = lv_tick_get();
 
     lv_img_set_src(obj, &gifobj->imgdsc);
@@ -91,18 +142,52 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
     lv_timer_resume(gifobj->timer);
     lv_timer_reset(gifobj->timer);
 
-    next_frame_task_cb(gifobj->timer);
+    /*The first frame of an atlas is shown already*/
+    if(gifobj->gif) next_frame_task_cb(gifobj->timer);
 
 }
 
 void lv_gif_restart(lv_obj_t * obj)
 {
     lv_gif_t * gifobj = (lv_gif_t *) obj;
-    gd_rewind(gifobj->gif);
+    if(gifobj->atlas) {
+        gifobj->atlas_next = 0;
+        gifobj->loop_count = gifobj->atlas->loop_count;
+    }
+    else {
+        gd_rewind(gifobj->gif);
+    }
     lv_timer_resume(gifobj->timer);
     lv_timer_reset(gifobj->timer);
 }
 
+void lv_gif_set_atlas(lv_obj_t * obj, bool en)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+    gifobj->use_atlas = en;
+}
+
+void lv_gif_atlas_set_budget(uint32_t bytes)
+{
+    atlas_budget = bytes;
+    atlas_trim(0);
+}
+
+void lv_gif_atlas_get_stats(lv_gif_atlas_stats_t * stats)
+{
+    lv_memset_00(stats, sizeof(lv_gif_atlas_stats_t));
+    stats->bytes = atlas_bytes;
+    stats->budget = atlas_budget;
+    if(atlas_ll.n_size == 0) return;
+
+    lv_gif_atlas_t * atlas;
+    _LV_LL_READ(&atlas_ll, atlas) {
+        stats->atlas_cnt++;
+        stats->ref_cnt += atlas->ref_cnt;
+        stats->frame_cnt += atlas->frame_cnt;
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -114,6 +199,8 @@ static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_gif_t * gifobj = (lv_gif_t *) obj;
 
     gifobj->gif = NULL;
+    gifobj->atlas = NULL;
+    gifobj->use_atlas = 0;
     gifobj->timer = lv_timer_create(next_frame_task_cb, 10, obj);
     lv_timer_pause(gifobj->timer);
 }
@@ -125,6 +212,8 @@ static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_img_cache_invalidate_src(&gifobj->imgdsc);
     if(gifobj->gif)
         gd_close_gif(gifobj->gif);
+    if(gifobj->atlas)
+        atlas_release(gifobj->atlas);
     lv_timer_del(gifobj->timer);
 }
 
@@ -132,6 +221,11 @@ static void next_frame_task_cb(lv_timer_t * t)
 {
     lv_obj_t * obj = t->user_data;
     lv_gif_t * gifobj = (lv_gif_t *) obj;
+    if(gifobj->atlas) {
+        atlas_next_frame(obj);
+        return;
+    }
+
     uint32_t elaps = lv_tick_elaps(gifobj->last_call);
     if(elaps < gifobj->gif->gce.delay * 10) return;
 
@@ -147,8 +241,279 @@ static void next_frame_task_cb(lv_timer_t * t)
 
     gd_render_frame(gifobj->gif, (uint8_t *)gifobj->imgdsc.data);
 
-    lv_img_cache_invalidate_src(lv_img_get_src(obj));
-    lv_obj_invalidate(obj);
+    /*The image is drawn straight from the canvas, so the cached entry stays valid;
+     *only the area the frame changed needs a redraw*/
+    invalidate_canvas_area(obj, &gifobj->gif->dirty);
+}
+
+static void atlas_next_frame(lv_obj_t * obj)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+    lv_gif_atlas_t * atlas = gifobj->atlas;
+    uint32_t elaps = lv_tick_elaps(gifobj->last_call);
+    if(elaps < atlas->frames[gifobj->atlas_frame].delay) return;
+
+    gifobj->last_call = lv_tick_get();
+
+    /*Count the loops like gd_get_frame() does*/
+    if(gifobj->atlas_next == atlas->frame_cnt) {
+        gifobj->atlas_next = 0;
+        if(gifobj->loop_count == 1 || gifobj->loop_count < 0) {
+            /*It was the last repeat*/
+            lv_res_t res = lv_event_send(obj, LV_EVENT_READY, NULL);
+            if(res != LV_RES_OK) return;
+            lv_timer_pause(gifobj->timer);
+            return;
+        }
+        else if(gifobj->loop_count > 1) {
+            gifobj->loop_count--;
+        }
+    }
+
+    uint32_t prev = gifobj->atlas_frame;
+    uint32_t i = gifobj->atlas_next++;
+    gifobj->atlas_frame = i;
+    gifobj->imgdsc.data = atlas->data + i * atlas->frame_size;
+
+    /*The cached entry points to the previous frame*/
+    lv_img_cache_invalidate_src(&gifobj->imgdsc);
+    if(i == (prev + 1) % atlas->frame_cnt) invalidate_canvas_area(obj, &atlas->frames[i].dirty);
+    else lv_obj_invalidate(obj);    /*Restarted*/
+}
+
+/**
+ * Invalidate where an area of the canvas shows up on the screen
+ * @param obj       pointer to a GIF object
+ * @param area      area of the canvas, might be empty
+ */
+static void invalidate_canvas_area(lv_obj_t * obj, const lv_area_t * area)
+{
+    lv_img_t * img = (lv_img_t *)obj;
+    if(area->x2 < area->x1 || area->y2 < area->y1) return;
+
+    /*Only when the object shows the canvas once, not cropped, padded or tiled*/
+    lv_area_t transformed;
+    _lv_img_buf_get_transformed_area(&transformed, img->w, img->h, img->angle, img->zoom, &img->pivot);
+    if(img->w != lv_obj_get_width(obj) || img->h != lv_obj_get_height(obj) ||
+       img->offset.x != 0 || img->offset.y != 0 || img->obj_size_mode != LV_IMG_SIZE_MODE_VIRTUAL ||
+       lv_area_get_width(&transformed) < img->w || lv_area_get_height(&transformed) < img->h) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    lv_area_t a;
+    if(img->angle == 0 && img->zoom == LV_IMG_ZOOM_NONE) {
+        lv_area_copy(&a, area);
+    }
+    else {
+        /*The bounding box of the transformed corners, with the same margin as the whole image*/
+        lv_point_t p[4] = {
+            {area->x1, area->y1},
+            {area->x2 + 1, area->y1},
+            {area->x1, area->y2 + 1},
+            {area->x2 + 1, area->y2 + 1},
+        };
+        uint32_t i;
+        for(i = 0; i < 4; i++) lv_point_transform(&p[i], img->angle, img->zoom, &img->pivot);
+        a.x1 = LV_MIN4(p[0].x, p[1].x, p[2].x, p[3].x) - 2;
+        a.x2 = LV_MAX4(p[0].x, p[1].x, p[2].x, p[3].x) + 2;
+        a.y1 = LV_MIN4(p[0].y, p[1].y, p[2].y, p[3].y) - 2;
+        a.y2 = LV_MAX4(p[0].y, p[1].y, p[2].y, p[3].y) + 2;
+    }
+    lv_area_move(&a, obj->coords.x1, obj->coords.y1);
+
+    /*Style transforms of the object or its parents are applied here*/
+    lv_obj_invalidate_area(obj, &a);
+}
+
+/**
+ * Get the atlas of a source, decoding it if there is none yet
+ * @param src       a variable or file source
+ * @return          the atlas with a reference taken, NULL if it can't be used
+ */
+static lv_gif_atlas_t * atlas_open(const void * src)
+{
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    const void * key;
+    if(src_type == LV_IMG_SRC_VARIABLE) key = ((const lv_img_dsc_t *)src)->data;
+    else if(src_type == LV_IMG_SRC_FILE) key = src;
+    else return NULL;
+
+    if(atlas_ll.n_size == 0) _lv_ll_init(&atlas_ll, sizeof(lv_gif_atlas_t));
+
+    lv_gif_atlas_t * atlas;
+    _LV_LL_READ(&atlas_ll, atlas) {
+        bool match = atlas->is_file ? src_type == LV_IMG_SRC_FILE && strcmp(atlas->key, key) == 0 :
+                     src_type == LV_IMG_SRC_VARIABLE && atlas->key == key;
+        if(match) {
+            atlas->ref_cnt++;
+            _lv_ll_move_before(&atlas_ll, atlas, _lv_ll_get_head(&atlas_ll));
+            return atlas;
+        }
+    }
+
+    atlas = atlas_create(src, key);
+    if(atlas) atlas->ref_cnt = 1;
+    return atlas;
+}
+
+static lv_gif_atlas_t * atlas_create(const void * src, const void * key)
+{
+    bool is_file = lv_img_src_get_type(src) == LV_IMG_SRC_FILE;
+    gd_GIF * gif = is_file ? gd_open_gif_file(src) : gd_open_gif_data(key);
+    if(gif == NULL) return NULL;
+
+    /*Count the frames. The second loop has to start like the first one*/
+    uint32_t px_cnt = (uint32_t)gif->width * gif->height;
+    uint32_t state_size = (GD_PX_SIZE + 1) * px_cnt;
+    uint8_t * first = lv_mem_alloc(state_size);
+    uint32_t frame_cnt = 0;
+    int32_t loop_count = -1;
+    bool opaque = true;
+    bool ok = first != NULL;
+    while(ok) {
+        int res = gd_get_frame(gif);
+        if(res < 0 || frame_cnt == UINT16_MAX) {
+            ok = false;
+        }
+        else if(res == 0) {
+            /*Past the trailer, the first frame again on what the last one left*/
+            ok = frame_cnt > 0 && gd_get_frame(gif) == 1;
+            if(ok) {
+                gd_render_frame(gif, gif->canvas);
+                ok = same_state(gif, first);
+            }
+            break;
+        }
+        else {
+            gd_render_frame(gif, gif->canvas);
+            if(frame_cnt == 0) {
+                loop_count = gif->loop_count;
+                gif->loop_count = 1;    /*Stop at the trailer*/
+                lv_memcpy(first, gif->canvas, state_size);
+            }
+            uint32_t i;
+            for(i = 0; i < px_cnt && opaque; i++) opaque = gif->canvas[i * GD_PX_SIZE + GD_PX_SIZE - 1] == 0xff;
+            frame_cnt++;
+        }
+    }
+    lv_mem_free(first);
+
+    lv_gif_atlas_t * atlas = NULL;
+    uint32_t px_size = opaque ? sizeof(lv_color_t) : GD_PX_SIZE;
+    uint32_t bytes = frame_cnt * (px_cnt * px_size + sizeof(atlas_frame_t));
+    if(ok && !atlas_trim(bytes)) {
+        LV_LOG_INFO("%"LV_PRIu32" bytes of frames don't fit the budget", bytes);
+        ok = false;
+    }
+
+    if(ok) {
+        atlas = _lv_ll_ins_head(&atlas_ll);
+        ok = atlas != NULL;
+    }
+    if(ok) {
+        lv_memset_00(atlas, sizeof(lv_gif_atlas_t));
+        atlas->is_file = is_file;
+        atlas->w = gif->width;
+        atlas->h = gif->height;
+        atlas->frame_cnt = frame_cnt;
+        atlas->loop_count = loop_count;
+        atlas->cf = opaque ? LV_IMG_CF_TRUE_COLOR : LV_IMG_CF_TRUE_COLOR_ALPHA;
+        atlas->frame_size = px_cnt * px_size;
+        atlas->bytes = bytes;
+        atlas->data = lv_img_cache_alloc(frame_cnt * atlas->frame_size);
+        atlas->frames = lv_mem_alloc(frame_cnt * sizeof(atlas_frame_t));
+        if(is_file) {
+            char * name = lv_mem_alloc(strlen(key) + 1);
+            if(name) strcpy(name, key);
+            atlas->key = name;
+        }
+        else {
+            atlas->key = key;
+        }
+        atlas_bytes += bytes;
+        ok = atlas->data && atlas->frames && atlas->key;
+    }
+
+    /*Keep the frames of the second loop, its first frame is decoded already*/
+    uint32_t f;
+    for(f = 0; ok && f < frame_cnt; f++) {
+        if(f > 0) {
+            ok = gd_get_frame(gif) == 1;
+            if(!ok) break;
+            gd_render_frame(gif, gif->canvas);
+        }
+        uint8_t * dst = atlas->data + f * atlas->frame_size;
+        if(!opaque) {
+            lv_memcpy(dst, gif->canvas, atlas->frame_size);
+        }
+        else {
+            uint32_t i;
+            for(i = 0; i < px_cnt; i++) lv_memcpy(&dst[i * px_size], &gif->canvas[i * GD_PX_SIZE], px_size);
+        }
+        atlas->frames[f].dirty = gif->dirty;
+        atlas->frames[f].delay = gif->gce.delay * 10;
+    }
+    gd_close_gif(gif);
+
+    if(!ok && atlas) {
+        atlas_free(atlas);
+        atlas = NULL;
+    }
+    return atlas;
+}
+
+/**
+ * Compare the canvas and the frame buffer of a GIF with a copy of them.
+ * Transparent pixels are the same whatever their color.
+ */
+static bool same_state(const gd_GIF * gif, const uint8_t * state)
+{
+    uint32_t px_cnt = (uint32_t)gif->width * gif->height;
+    if(memcmp(gif->frame, &state[px_cnt * GD_PX_SIZE], px_cnt) != 0) return false;
+
+    uint32_t i;
+    for(i = 0; i < px_cnt * GD_PX_SIZE; i += GD_PX_SIZE) {
+        const uint8_t opa = gif->canvas[i + GD_PX_SIZE - 1];
+        if(opa != state[i + GD_PX_SIZE - 1]) return false;
+        if(opa != 0 && memcmp(&gif->canvas[i], &state[i], GD_PX_SIZE - 1) != 0) return false;
+    }
+    return true;
+}
+
+static void atlas_release(lv_gif_atlas_t * atlas)
+{
+    atlas->ref_cnt--;
+    atlas_trim(0);
+}
+
+/**
+ * Free the least recently used atlases no GIF plays from until `bytes` more fit the budget
+ * @param bytes     bytes to make room for
+ * @return          true: they fit
+ */
+static bool atlas_trim(uint32_t bytes)
+{
+    if(bytes > atlas_budget) return false;
+    if(atlas_ll.n_size == 0) return true;
+
+    lv_gif_atlas_t * atlas = _lv_ll_get_tail(&atlas_ll);
+    while(atlas && atlas_bytes + bytes > atlas_budget) {
+        lv_gif_atlas_t * prev = _lv_ll_get_prev(&atlas_ll, atlas);
+        if(atlas->ref_cnt == 0) atlas_free(atlas);
+        atlas = prev;
+    }
+    return atlas_bytes + bytes <= atlas_budget;
+}
+
+static void atlas_free(lv_gif_atlas_t * atlas)
+{
+    atlas_bytes -= atlas->bytes;
+    lv_img_cache_free(atlas->data);
+    lv_mem_free(atlas->frames);
+    if(atlas->is_file) lv_mem_free((void *)atlas->key);
+    _lv_ll_remove(&atlas_ll, atlas);
+    lv_mem_free(atlas);
 }
 
 #endif /*LV_USE_GIF*/
@@ -27,14 +27,29 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+struct _lv_gif_atlas_t;
+
 typedef struct {
     lv_img_t img;
     gd_GIF * gif;
     lv_timer_t * timer;
     lv_img_dsc_t imgdsc;
     uint32_t last_call;
+    struct _lv_gif_atlas_t * atlas;     /*Frames decoded once, `gif` is NULL while playing from it*/
+    uint16_t atlas_frame;               /*The frame shown*/
+    uint16_t atlas_next;                /*The frame to show next, the frame count at the end of a loop*/
+    int32_t loop_count;                 /*Loops left while playing from the atlas, like in `gd_GIF`*/
+    uint8_t use_atlas : 1;
 } lv_gif_t;
 
+typedef struct {
+    uint32_t atlas_cnt;     /*GIFs decoded into an atlas*/
+    uint32_t ref_cnt;       /*GIF objects playing from them*/
+    uint32_t frame_cnt;
+    uint32_t bytes;
+    uint32_t budget;
+} lv_gif_atlas_stats_t;
+
 extern const lv_obj_class_t lv_gif_class;
 
 /**********************
@@ -45,6 +60,28 @@ lv_obj_t * lv_gif_create(lv_obj_t * parent);
 void lv_gif_set_src(lv_obj_t * obj, const void * src);
 void lv_gif_restart(lv_obj_t * gif);
 
+/**
+ * Play the sources set from now on from a frame atlas: all frames are decoded once
+ * and shared by every GIF object with the same source. Showing a frame then costs no decoding.
+ * A GIF that doesn't fit the budget or changes from one loop to the next is decoded as usual.
+ * @param obj       pointer to a GIF object
+ * @param en        true: use an atlas for the next `lv_gif_set_src()`
+ */
+void lv_gif_set_atlas(lv_obj_t * obj, bool en);
+
+/**
+ * Set how many bytes the frame atlases may use. Atlases no GIF plays from are kept
+ * until the room is needed.
+ * @param bytes the budget, `LV_GIF_ATLAS_DEF_BYTES` by default
+ */
+void lv_gif_atlas_set_budget(uint32_t bytes);
+
+/**
+ * Get how many atlases there are and the memory they use.
+ * @param stats     the stats are written here
+ */
+void lv_gif_atlas_get_stats(lv_gif_atlas_stats_t * stats);
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,607 @@
+/**
+ * @file lv_mjpeg.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_mjpeg.h"
+#if LV_USE_MJPEG
+
+#if !LV_USE_SJPG
+    #error "LV_USE_MJPEG decodes with the JPG library, enable LV_USE_SJPG"
+#endif
+
+#include "../sjpg/tjpgd.h"
+#include <string.h>
+
+#ifdef LV_MJPEG_TIME_INCLUDE
+    #include LV_MJPEG_TIME_INCLUDE
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MY_CLASS    &lv_mjpeg_player_class
+
+#define TJPGD_WORKBUFF_SIZE     4096    /*Recommended by TJPGD libray*/
+#define DEF_US_PER_FRAME        33333   /*If the AVI header doesn't tell*/
+
+#define TIME_US()   ((uint32_t)(LV_MJPEG_TIME_US_EXPR))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void lv_mjpeg_player_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_mjpeg_player_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void next_frame_task_cb(lv_timer_t * t);
+static bool play_frame(lv_obj_t * obj, bool drop);
+static bool show_frame(lv_obj_t * obj, const uint8_t * data, uint32_t size);
+static JRESULT prepare(lv_mjpeg_player_t * player, JDEC * jd, const uint8_t * data, uint32_t size);
+static size_t input_cb(JDEC * jd, uint8_t * buff, size_t ndata);
+static int output_cb(JDEC * jd, void * bitmap, JRECT * rect);
+static bool parse_header(lv_mjpeg_player_t * player);
+static bool next_chunk(lv_mjpeg_player_t * player, uint32_t * size);
+static const uint8_t * file_get(lv_mjpeg_player_t * player, uint32_t size);
+static void file_skip(lv_mjpeg_player_t * player, uint32_t size);
+static void file_seek(lv_mjpeg_player_t * player, uint32_t pos);
+static uint32_t file_tell(lv_mjpeg_player_t * player);
+static uint32_t frame_us(lv_mjpeg_player_t * player);
+static void close_src(lv_mjpeg_player_t * player);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+const lv_obj_class_t lv_mjpeg_player_class = {
+    .constructor_cb = lv_mjpeg_player_constructor,
+    .destructor_cb = lv_mjpeg_player_destructor,
+    .instance_size = sizeof(lv_mjpeg_player_t),
+    .base_class = &lv_img_class
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_obj_t * lv_mjpeg_player_create(lv_obj_t * parent)
+{
+    LV_LOG_INFO("begin");
+    lv_obj_t * obj = lv_obj_class_create_obj(MY_CLASS, parent);
+    lv_obj_class_init_obj(obj);
+    return obj;
+}
+
+lv_res_t lv_mjpeg_player_set_src(lv_obj_t * obj, const char * path)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_mjpeg_player_t * player = (lv_mjpeg_player_t *)obj;
+
+    lv_timer_pause(player->timer);
+    player->playing = 0;
+    player->paused = 0;
+    if(player->frame_buf[0]) lv_img_set_src(obj, NULL);
+    close_src(player);
+
+    if(lv_fs_open(&player->file, path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        LV_LOG_WARN("can't open %s", path);
+        return LV_RES_INV;
+    }
+    player->opened = 1;
+
+    player->buf = lv_img_cache_alloc(LV_MJPEG_READ_AHEAD);
+    player->buf_size = player->buf ? LV_MJPEG_READ_AHEAD : 0;
+    player->work = lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
+    if(player->buf == NULL || player->work == NULL) {
+        LV_LOG_WARN("out of memory");
+        close_src(player);
+        return LV_RES_INV;
+    }
+
+    if(!parse_header(player)) {
+        LV_LOG_WARN("%s is not an AVI file", path);
+        close_src(player);
+        return LV_RES_INV;
+    }
+
+    /*The size of the first frame is the size of the video*/
+    uint32_t size = 0;
+    const uint8_t * data = NULL;
+    while(size == 0 && next_chunk(player, &size)) {}
+    if(size) data = file_get(player, size);
+
+    JDEC jd;
+    if(data == NULL || prepare(player, &jd, data, size) != JDR_OK) {
+        LV_LOG_WARN("%s has no baseline JPEG frame", path);
+        close_src(player);
+        return LV_RES_INV;
+    }
+
+    uint32_t frame_size = (uint32_t)jd.width * jd.height * sizeof(lv_color_t);
+    player->frame_buf[0] = lv_img_cache_alloc(frame_size);
+    player->frame_buf[1] = lv_img_cache_alloc(frame_size);
+    if(player->frame_buf[0] == NULL || player->frame_buf[1] == NULL) {
+        LV_LOG_WARN("out of memory for %dx%d frames", jd.width, jd.height);
+        close_src(player);
+        return LV_RES_INV;
+    }
+
+    player->imgdsc.header.always_zero = 0;
+    player->imgdsc.header.cf = LV_IMG_CF_TRUE_COLOR;
+    player->imgdsc.header.w = jd.width;
+    player->imgdsc.header.h = jd.height;
+    player->imgdsc.data_size = frame_size;
+    player->front = 1;
+
+    file_seek(player, player->movi_start);
+    player->frame = 0;
+    if(!play_frame(obj, false) || player->imgdsc.data == NULL) {
+        LV_LOG_WARN("can't decode the first frame of %s", path);
+        close_src(player);
+        return LV_RES_INV;
+    }
+
+    lv_timer_set_period(player->timer, LV_MAX(frame_us(player) / 1000, 1));
+    lv_img_set_src(obj, &player->imgdsc);
+
+    return LV_RES_OK;
+}
+
+void lv_mjpeg_player_set_cmd(lv_obj_t * obj, lv_mjpeg_player_cmd_t cmd)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_mjpeg_player_t * player = (lv_mjpeg_player_t *)obj;
+
+    if(!player->frame_buf[0]) {
+        LV_LOG_WARN("no video");
+        return;
+    }
+
+    switch(cmd) {
+        case LV_MJPEG_PLAYER_CMD_RESUME:
+            if(player->paused) {
+                player->start_tick += lv_tick_elaps(player->paused_tick);
+                player->paused = 0;
+                player->playing = 1;
+                lv_timer_resume(player->timer);
+                break;
+            }
+            if(player->playing) break;
+        /*Stopped, nothing to resume: start*/
+        /*fall through*/
+        case LV_MJPEG_PLAYER_CMD_START:
+            player->paused = 0;
+            file_seek(player, player->movi_start);
+            player->frame = 0;
+            player->start_tick = lv_tick_get();
+            if(play_frame(obj, false)) {
+                player->playing = 1;
+                lv_timer_resume(player->timer);
+            }
+            else {
+                player->playing = 0;
+                lv_timer_pause(player->timer);
+            }
+            break;
+        case LV_MJPEG_PLAYER_CMD_STOP:
+            lv_timer_pause(player->timer);
+            player->playing = 0;
+            player->paused = 0;
+            file_seek(player, player->movi_start);
+            player->frame = 0;
+            break;
+        case LV_MJPEG_PLAYER_CMD_PAUSE:
+            if(player->playing) {
+                lv_timer_pause(player->timer);
+                player->playing = 0;
+                player->paused = 1;
+                player->paused_tick = lv_tick_get();
+            }
+            break;
+        default:
+            LV_LOG_WARN("unknown command: %d", cmd);
+            break;
+    }
+}
+
+void lv_mjpeg_player_set_auto_restart(lv_obj_t * obj, bool en)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_mjpeg_player_t * player = (lv_mjpeg_player_t *)obj;
+    player->auto_restart = en;
+}
+
+void lv_mjpeg_player_set_fps(lv_obj_t * obj, uint32_t fps)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_mjpeg_player_t * player = (lv_mjpeg_player_t *)obj;
+
+    /*Keep the frame on screen, the next ones come at the new rate*/
+    uint32_t shown = player->frame ? player->frame - 1 : 0;
+    uint32_t now = player->paused ? player->paused_tick : lv_tick_get();
+    player->fps = fps;
+    player->start_tick = now - (uint32_t)((uint64_t)shown * frame_us(player) / 1000);
+    lv_timer_set_period(player->timer, LV_MAX(frame_us(player) / 1000, 1));
+}
+
+uint32_t lv_mjpeg_player_get_fps(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_mjpeg_player_t * player = (lv_mjpeg_player_t *)obj;
+    return (1000000 + frame_us(player) / 2) / frame_us(player);
+}
+
+bool lv_mjpeg_player_is_playing(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_mjpeg_player_t * player = (lv_mjpeg_player_t *)obj;
+    return player->playing;
+}
+
+void lv_mjpeg_player_get_stats(lv_obj_t * obj, lv_mjpeg_player_stats_t * stats)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_mjpeg_player_t * player = (lv_mjpeg_player_t *)obj;
+
+    *stats = player->stats;
+    uint32_t n = stats->frames_shown + stats->frames_bad;
+    if(n) {
+        stats->decode_us_avg = (uint32_t)(player->decode_us_sum / n);
+        stats->read_us_avg = (uint32_t)(player->read_us_sum / n);
+    }
+}
+
+void lv_mjpeg_player_reset_stats(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_mjpeg_player_t * player = (lv_mjpeg_player_t *)obj;
+
+    lv_memset_00(&player->stats, sizeof(player->stats));
+    player->decode_us_sum = 0;
+    player->read_us_sum = 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void lv_mjpeg_player_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    LV_TRACE_OBJ_CREATE("begin");
+
+    lv_mjpeg_player_t * player = (lv_mjpeg_player_t *)obj;
+    player->timer = lv_timer_create(next_frame_task_cb, DEF_US_PER_FRAME / 1000, obj);
+    lv_timer_pause(player->timer);
+
+    LV_TRACE_OBJ_CREATE("finished");
+}
+
+static void lv_mjpeg_player_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    LV_TRACE_OBJ_CREATE("begin");
+
+    lv_mjpeg_player_t * player = (lv_mjpeg_player_t *)obj;
+    lv_timer_del(player->timer);
+    close_src(player);
+
+    LV_TRACE_OBJ_CREATE("finished");
+}
+
+static void next_frame_task_cb(lv_timer_t * t)
+{
+    lv_obj_t * obj = t->user_data;
+    lv_mjpeg_player_t * player = (lv_mjpeg_player_t *)obj;
+
+    /*The frame due now. The ones missed on the way are skipped without reading them*/
+    uint32_t due = (uint32_t)((uint64_t)lv_tick_elaps(player->start_tick) * 1000 / frame_us(player));
+    if(due < player->frame) return;
+
+    bool more = true;
+    while(more && player->frame < due) more = play_frame(obj, true);
+    if(more) more = play_frame(obj, false);
+    if(more) return;
+
+    if(player->auto_restart) {
+        lv_mjpeg_player_set_cmd(obj, LV_MJPEG_PLAYER_CMD_START);
+    }
+    else {
+        lv_mjpeg_player_set_cmd(obj, LV_MJPEG_PLAYER_CMD_STOP);
+        lv_event_send(obj, LV_EVENT_READY, NULL);
+    }
+}
+
+/**
+ * Take the next frame of the file
+ * @param obj   pointer to an MJPEG player
+ * @param drop  true: only skip over the frame
+ * @return      false at the end of the video
+ */
+static bool play_frame(lv_obj_t * obj, bool drop)
+{
+    lv_mjpeg_player_t * player = (lv_mjpeg_player_t *)obj;
+
+    uint32_t size;
+    if(!next_chunk(player, &size)) return false;
+    player->frame++;
+
+    if(drop) {
+        file_skip(player, size + (size & 1));
+        player->stats.frames_dropped++;
+        return true;
+    }
+
+    if(size == 0) {
+        /*An empty chunk repeats the previous frame*/
+        player->stats.frames_shown++;
+        return true;
+    }
+
+    const uint8_t * data = file_get(player, size);
+    if(data == NULL) return false;
+
+    player->stats.read_us = player->read_us_cur;
+    player->stats.read_us_max = LV_MAX(player->stats.read_us_max, player->read_us_cur);
+    player->read_us_sum += player->read_us_cur;
+    player->read_us_cur = 0;
+
+    show_frame(obj, data, size);
+    file_skip(player, size & 1);
+    return true;
+}
+
+static bool show_frame(lv_obj_t * obj, const uint8_t * data, uint32_t size)
+{
+    lv_mjpeg_player_t * player = (lv_mjpeg_player_t *)obj;
+
+    uint32_t t = TIME_US();
+    JDEC jd;
+    JRESULT res = prepare(player, &jd, data, size);
+    if(res == JDR_OK && (jd.width != player->imgdsc.header.w || jd.height != player->imgdsc.header.h)) res = JDR_FMT3;
+    if(res == JDR_OK) res = jd_decomp(&jd, output_cb, 0);
+    t = TIME_US() - t;
+
+    player->stats.decode_us = t;
+    player->stats.decode_us_max = LV_MAX(player->stats.decode_us_max, t);
+    player->decode_us_sum += t;
+
+    if(res != JDR_OK) {
+        LV_LOG_WARN("frame %d: JPEG error %d", (int)player->frame - 1, res);
+        player->stats.frames_bad++;
+        return false;
+    }
+    player->stats.frames_shown++;
+
+    /*Show the buffer just decoded, the next frame goes to the other one*/
+    player->front ^= 1;
+    player->imgdsc.data = (const uint8_t *)player->frame_buf[player->front];
+    lv_img_cache_invalidate_src(&player->imgdsc);
+    lv_obj_invalidate(obj);
+    return true;
+}
+
+static JRESULT prepare(lv_mjpeg_player_t * player, JDEC * jd, const uint8_t * data, uint32_t size)
+{
+    player->jpeg = data;
+    player->jpeg_size = size;
+    player->jpeg_pos = 0;
+    return jd_prepare(jd, input_cb, player->work, TJPGD_WORKBUFF_SIZE, player);
+}
+
+static size_t input_cb(JDEC * jd, uint8_t * buff, size_t ndata)
+{
+    lv_mjpeg_player_t * player = jd->device;
+
+    uint32_t rest = player->jpeg_size - player->jpeg_pos;
+    if(ndata > rest) ndata = rest;
+    if(buff) lv_memcpy(buff, player->jpeg + player->jpeg_pos, ndata);
+    player->jpeg_pos += ndata;
+    return ndata;
+}
+
+static int output_cb(JDEC * jd, void * bitmap, JRECT * rect)
+{
+    lv_mjpeg_player_t * player = jd->device;
+
+    /*RGB888 blocks into the back buffer*/
+    const uint8_t * src = bitmap;
+    lv_coord_t w = player->imgdsc.header.w;
+    lv_color_t * dest = player->frame_buf[player->front ^ 1] + (uint32_t)rect->top * w + rect->left;
+    uint32_t rect_w = rect->right - rect->left + 1;
+    uint32_t y;
+    for(y = rect->top; y <= rect->bottom; y++) {
+        uint32_t x;
+        for(x = 0; x < rect_w; x++) {
+            dest[x] = lv_color_make(src[0], src[1], src[2]);
+            src += 3;
+        }
+        dest += w;
+    }
+    return 1;
+}
+
+static inline uint32_t get_u32(const uint8_t * p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * Find the 'movi' list and the frame rate in the main header of an AVI file
+ */
+static bool parse_header(lv_mjpeg_player_t * player)
+{
+    const uint8_t * p = file_get(player, 12);
+    if(p == NULL || memcmp(p, "RIFF", 4) || memcmp(p + 8, "AVI ", 4)) return false;
+
+    player->file_us_per_frame = DEF_US_PER_FRAME;
+    player->frame_cnt = 0;
+
+    while((p = file_get(player, 8)) != NULL) {
+        bool list = !memcmp(p, "LIST", 4);
+        bool avih = !memcmp(p, "avih", 4);
+        uint32_t len = get_u32(p + 4);
+
+        if(list) {
+            p = file_get(player, 4);
+            if(p == NULL) return false;
+            if(!memcmp(p, "movi", 4)) {
+                player->movi_start = file_tell(player);
+                /*A recording that wasn't finished has no size yet, play until the end of the file*/
+                player->movi_end = len > 4 ? player->movi_start + len - 4 : UINT32_MAX;
+                return true;
+            }
+            /*Look inside the other lists, 'hdrl' has the main header*/
+            continue;
+        }
+
+        if(avih && len >= 20 && len <= 64) {
+            p = file_get(player, len);
+            if(p == NULL) return false;
+            if(get_u32(p)) player->file_us_per_frame = get_u32(p);
+            player->frame_cnt = get_u32(p + 16);
+            file_skip(player, len & 1);
+            continue;
+        }
+
+        file_skip(player, len + (len & 1));
+    }
+
+    return false;
+}
+
+/**
+ * Go to the data of the next video chunk in the 'movi' list
+ * @param player    pointer to an MJPEG player
+ * @param size      store the size of the frame here
+ * @return          false at the end of the list
+ */
+static bool next_chunk(lv_mjpeg_player_t * player, uint32_t * size)
+{
+    while(file_tell(player) + 8 <= player->movi_end) {
+        const uint8_t * p = file_get(player, 8);
+        if(p == NULL) return false;
+
+        uint32_t len = get_u32(p + 4);
+        if(!memcmp(p, "LIST", 4)) {
+            /*'rec ' lists group the chunks of a frame*/
+            if(file_get(player, 4) == NULL) return false;
+            continue;
+        }
+        /*'00dc' compressed or '00db' uncompressed, both are JPEGs in MJPEG files*/
+        if(p[2] == 'd' && (p[3] == 'c' || p[3] == 'b')) {
+            *size = len;
+            return true;
+        }
+        file_skip(player, len + (len & 1));
+    }
+
+    return false;
+}
+
+/**
+ * Take the next bytes of the file. They are read ahead in blocks of `LV_MJPEG_READ_AHEAD` so one
+ * read serves several frames.
+ * @return pointer to `size` bytes valid until the next call, NULL at the end of the file
+ */
+static const uint8_t * file_get(lv_mjpeg_player_t * player, uint32_t size)
+{
+    uint32_t avail = player->buf_len - player->buf_pos;
+    if(avail < size) {
+        if(size > player->buf_size) {
+            /*A frame larger than the read ahead buffer*/
+            uint8_t * buf = lv_img_cache_alloc(size);
+            if(buf == NULL) return NULL;
+            lv_memcpy(buf, player->buf + player->buf_pos, avail);
+            lv_img_cache_free(player->buf);
+            player->buf = buf;
+            player->buf_size = size;
+        }
+        else {
+            memmove(player->buf, player->buf + player->buf_pos, avail);
+        }
+        player->buf_pos = 0;
+        player->buf_len = avail;
+
+        uint32_t t = TIME_US();
+        uint32_t rn = 0;
+        if(lv_fs_read(&player->file, player->buf + avail, player->buf_size - avail, &rn) != LV_FS_RES_OK) rn = 0;
+        player->read_us_cur += TIME_US() - t;
+        player->stats.bytes_read += rn;
+        player->buf_len += rn;
+        player->file_pos += rn;
+
+        if(player->buf_len < size) return NULL;
+    }
+
+    const uint8_t * p = player->buf + player->buf_pos;
+    player->buf_pos += size;
+    return p;
+}
+
+static void file_skip(lv_mjpeg_player_t * player, uint32_t size)
+{
+    uint32_t avail = player->buf_len - player->buf_pos;
+    if(size <= avail) {
+        player->buf_pos += size;
+        return;
+    }
+
+    file_seek(player, player->file_pos + size - avail);
+}
+
+static void file_seek(lv_mjpeg_player_t * player, uint32_t pos)
+{
+    player->buf_pos = 0;
+    player->buf_len = 0;
+    player->file_pos = pos;
+    lv_fs_seek(&player->file, pos, LV_FS_SEEK_SET);
+}
+
+static uint32_t file_tell(lv_mjpeg_player_t * player)
+{
+    return player->file_pos - (player->buf_len - player->buf_pos);
+}
+
+static uint32_t frame_us(lv_mjpeg_player_t * player)
+{
+    return player->fps ? 1000000 / player->fps : player->file_us_per_frame;
+}
+
+static void close_src(lv_mjpeg_player_t * player)
+{
+    lv_img_cache_invalidate_src(&player->imgdsc);
+    player->imgdsc.data = NULL;
+
+    if(player->opened) lv_fs_close(&player->file);
+    player->opened = 0;
+
+    lv_img_cache_free(player->buf);
+    lv_img_cache_free(player->frame_buf[0]);
+    lv_img_cache_free(player->frame_buf[1]);
+    lv_mem_free(player->work);
+    player->buf = NULL;
+    player->frame_buf[0] = NULL;
+    player->frame_buf[1] = NULL;
+    player->work = NULL;
+    player->buf_size = 0;
+    player->buf_pos = 0;
+    player->buf_len = 0;
+    player->file_pos = 0;
+    player->frame = 0;
+
+    lv_memset_00(&player->stats, sizeof(player->stats));
+    player->decode_us_sum = 0;
+    player->read_us_sum = 0;
+    player->read_us_cur = 0;
+}
+
+#endif /*LV_USE_MJPEG*/
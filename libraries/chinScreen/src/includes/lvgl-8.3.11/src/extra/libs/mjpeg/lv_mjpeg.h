@@ -0,0 +1,167 @@
+/**
+ * @file lv_mjpeg.h
+ *
+ */
+#ifndef LV_MJPEG_H
+#define LV_MJPEG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#if LV_USE_MJPEG
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+extern const lv_obj_class_t lv_mjpeg_player_class;
+
+/**
+ * Plays the '00dc' chunks of an AVI file as baseline JPEGs, like
+ * `ffmpeg -i in.mp4 -vf scale=320:-2 -c:v mjpeg -q:v 5 -an out.avi` writes them.
+ * Frames are decoded into the back one of two true color buffers, so the one drawn is always
+ * complete. Playback follows the clock: frames that would be shown late are skipped unread.
+ */
+typedef struct {
+    uint32_t frames_shown;
+    uint32_t frames_dropped;    /*Skipped to catch up with the frame rate*/
+    uint32_t frames_bad;        /*Failed to decode, the previous frame stays on screen*/
+    uint32_t decode_us;         /*Last frame*/
+    uint32_t decode_us_avg;
+    uint32_t decode_us_max;
+    uint32_t read_us;           /*Last frame, 0 if it was already read ahead*/
+    uint32_t read_us_avg;
+    uint32_t read_us_max;
+    uint32_t bytes_read;
+} lv_mjpeg_player_stats_t;
+
+typedef struct {
+    lv_img_t img;
+    lv_timer_t * timer;
+    lv_img_dsc_t imgdsc;
+    lv_fs_file_t file;
+    uint8_t * buf;              /*Read ahead from the file, `buf_pos`..`buf_len` not used yet*/
+    uint32_t buf_size;
+    uint32_t buf_pos;
+    uint32_t buf_len;
+    uint32_t file_pos;          /*File offset of `buf + buf_len`*/
+    uint32_t movi_start;        /*File offsets of the frames of the 'movi' list*/
+    uint32_t movi_end;
+    const uint8_t * jpeg;       /*The frame being decoded and its size*/
+    uint32_t jpeg_size;
+    uint32_t jpeg_pos;
+    void * work;                /*Work area of the JPEG decoder*/
+    lv_color_t * frame_buf[2];  /*`imgdsc` shows `frame_buf[front]`*/
+    uint32_t fps;               /*From `lv_mjpeg_player_set_fps()`, 0: `file_us_per_frame`*/
+    uint32_t file_us_per_frame;
+    uint32_t frame_cnt;         /*Frames in the file, 0 if the header doesn't tell*/
+    uint32_t frame;             /*Frames taken from the file since the start*/
+    uint32_t start_tick;        /*When frame 0 was due*/
+    uint32_t paused_tick;
+    uint64_t decode_us_sum;
+    uint64_t read_us_sum;
+    uint32_t read_us_cur;       /*Reading since the last frame*/
+    lv_mjpeg_player_stats_t stats;
+    uint8_t front : 1;
+    uint8_t auto_restart : 1;
+    uint8_t playing : 1;
+    uint8_t paused : 1;
+    uint8_t opened : 1;
+} lv_mjpeg_player_t;
+
+typedef enum {
+    LV_MJPEG_PLAYER_CMD_START,      /*Play from the first frame*/
+    LV_MJPEG_PLAYER_CMD_STOP,       /*Pause and go back to the first frame*/
+    LV_MJPEG_PLAYER_CMD_PAUSE,
+    LV_MJPEG_PLAYER_CMD_RESUME,
+    _LV_MJPEG_PLAYER_CMD_LAST
+} lv_mjpeg_player_cmd_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create an MJPEG player object
+ * @param parent pointer to an object, it will be the parent of the new player
+ * @return pointer to the created player
+ */
+lv_obj_t * lv_mjpeg_player_create(lv_obj_t * parent);
+
+/**
+ * Open an AVI file and show its first frame. The player is stopped until
+ * `LV_MJPEG_PLAYER_CMD_START`.
+ * @param obj pointer to an MJPEG player
+ * @param path file name, e.g. "S:/sd/clip.avi"
+ * @return LV_RES_OK: no error; LV_RES_INV: not an AVI with a JPEG frame this decoder can read
+ */
+lv_res_t lv_mjpeg_player_set_src(lv_obj_t * obj, const char * path);
+
+/**
+ * Control the playback
+ * @param obj pointer to an MJPEG player
+ * @param cmd control command
+ */
+void lv_mjpeg_player_set_cmd(lv_obj_t * obj, lv_mjpeg_player_cmd_t cmd);
+
+/**
+ * Play the video again from the start when it ends. Otherwise it stops and sends `LV_EVENT_READY`.
+ * @param obj pointer to an MJPEG player
+ * @param en true: enable the auto restart
+ */
+void lv_mjpeg_player_set_auto_restart(lv_obj_t * obj, bool en);
+
+/**
+ * Override the frame rate of the file
+ * @param obj pointer to an MJPEG player
+ * @param fps frames per second, 0 to use the rate of the file
+ */
+void lv_mjpeg_player_set_fps(lv_obj_t * obj, uint32_t fps);
+
+/**
+ * Get the frame rate the video plays at
+ * @param obj pointer to an MJPEG player
+ * @return frames per second, rounded
+ */
+uint32_t lv_mjpeg_player_get_fps(lv_obj_t * obj);
+
+/**
+ * Check whether the video is playing
+ * @param obj pointer to an MJPEG player
+ * @return true: playing; false: stopped, paused or ended
+ */
+bool lv_mjpeg_player_is_playing(lv_obj_t * obj);
+
+/**
+ * Get the playback statistics since the source was set or `lv_mjpeg_player_reset_stats()`
+ * @param obj pointer to an MJPEG player
+ * @param stats store the statistics here
+ */
+void lv_mjpeg_player_get_stats(lv_obj_t * obj, lv_mjpeg_player_stats_t * stats);
+
+/**
+ * Zero the playback statistics
+ * @param obj pointer to an MJPEG player
+ */
+void lv_mjpeg_player_reset_stats(lv_obj_t * obj);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_MJPEG*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_MJPEG_H*/
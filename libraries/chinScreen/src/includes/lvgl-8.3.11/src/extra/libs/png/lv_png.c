@@ -28,6 +28,7 @@ static lv_res_t decoder_info(struct _lv_img_decoder_t * decoder, const void * sr
 static lv_res_t decoder_open(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
 static void decoder_close(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
 static void convert_color_depth(uint8_t * img, uint32_t px_cnt);
+static uint8_t * move_to_cache_mem(uint8_t * img, uint32_t w, uint32_t h);
 
 /**********************
  *  STATIC VARIABLES
@@ -183,7 +184,8 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
 
             /*Convert the image to the system's color depth*/
             convert_color_depth(img_data,  png_width * png_height);
-            dsc->img_data = img_data;
+            dsc->img_data = move_to_cache_mem(img_data, png_width, png_height);
+            if(dsc->img_data == NULL) return LV_RES_INV;
             return LV_RES_OK;     /*The image is fully decoded. Return with its pointer*/
         }
     }
@@ -206,7 +208,8 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
         /*Convert the image to the system's color depth*/
         convert_color_depth(img_data,  png_width * png_height);
 
-        dsc->img_data = img_data;
+        dsc->img_data = move_to_cache_mem(img_data, png_width, png_height);
+        if(dsc->img_data == NULL) return LV_RES_INV;
         return LV_RES_OK;     /*Return with its pointer*/
     }
 
@@ -220,11 +223,33 @@ static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc
 {
     LV_UNUSED(decoder); /*Unused*/
     if(dsc->img_data) {
-        lv_mem_free((uint8_t *)dsc->img_data);
+        lv_img_cache_free((uint8_t *)dsc->img_data);
         dsc->img_data = NULL;
     }
 }
 
+/**
+ * Copy the converted image into memory of the image cache, only as large as the converted
+ * format needs (3 bytes per pixel at 16 bit color depth instead of lodepng's 4)
+ * @param img the converted image, freed here
+ * @param w width of the image
+ * @param h height of the image
+ * @return the image for `dsc->img_data` or NULL if out of memory
+ */
+static uint8_t * move_to_cache_mem(uint8_t * img, uint32_t w, uint32_t h)
+{
+    uint32_t size = lv_img_buf_get_img_size(w, h, LV_IMG_CF_TRUE_COLOR_ALPHA);
+    uint8_t * cache_img = lv_img_cache_alloc(size);
+    if(cache_img == NULL) {
+        LV_LOG_WARN("out of memory for a %" LV_PRIu32 "x%" LV_PRIu32 " image", w, h);
+    }
+    else {
+        lv_memcpy(cache_img, img, size);
+    }
+    lv_mem_free(img);
+    return cache_img;
+}
+
 /**
  * If the display is not in 32 bit format (ARGB888) then covert the image to the current color depth
  * @param img the ARGB888 image
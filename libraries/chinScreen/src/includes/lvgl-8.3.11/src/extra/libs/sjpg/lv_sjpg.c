@@ -37,8 +37,14 @@
 /                   JPEG DECODER
 /                   ------------
 /   We are using TJpgDec - Tiny JPEG Decompressor library from ELM-CHAN for decoding each split-jpeg fragments.
-/   The tjpgd.c and tjpgd.h is not modified and those are used as it is. So if any update comes for the tiny-jpeg,
-/   just replace those files with updated files.
+/   tjpgd.c and tjpgd.h are modified with jd_decomp_rect() to decode a fragment a few MCU rows at a time and
+/   jd_save_state()/jd_load_state() to continue at a row decoded before, so keep them when the files are updated.
+/
+/   Only the MCU row of the last line asked for is kept, nothing is decoded in advance: areas are decoded
+/   straight into the draw buffer (read_area_cb) or line by line (read_line_cb), continuing with the next
+/   MCU rows of the fragment when the next area is below. MCUs left or right of the area and the rows above
+/   it are only followed in the huffman stream, they are not converted to pixels. The decoder state at the top of
+/   every MCU row passed is kept (20 bytes a row), so an area above or far below starts decoding at its own row.
 /---------------------------------------------------------------------------------------------------------------------------------*/
 
 /*********************
@@ -56,6 +62,7 @@
  *      DEFINES
  *********************/
 #define TJPGD_WORKBUFF_SIZE             4096    //Recommended by TJPGD libray
+#define SJPEG_MAX_MCU_HEIGHT            16      //Lines of the row cache
 
 //NEVER EDIT THESE OFFSET VALUES
 #define SJPEG_VERSION_OFFSET            8
@@ -77,15 +84,20 @@ enum io_source_type {
 typedef struct {
     enum io_source_type type;
     lv_fs_file_t lv_file;
-    uint8_t * img_cache_buff;
-    int img_cache_x_res;
-    int img_cache_y_res;
+    lv_color_t * out_buf;                 //img_data_cb() writes `out_area` of the fragment here,
+    lv_area_t out_area;                   //`out_stride` pixels a line.
+    lv_coord_t out_stride;
     uint8_t * raw_sjpg_data;              //Used when type==SJPEG_IO_SOURCE_C_ARRAY.
     uint32_t raw_sjpg_data_size;          //Num bytes pointed to by raw_sjpg_data.
     uint32_t raw_sjpg_data_next_read_pos; //Used for all types.
 } io_source_t;
 
 
+typedef struct {
+    JSTATE state;
+    uint32_t pos;                         //where the input goes on
+} sjpeg_resume_t;
+
 typedef struct {
     uint8_t * sjpeg_data;
     uint32_t sjpeg_data_size;
@@ -93,10 +105,14 @@ typedef struct {
     int sjpeg_y_res;
     int sjpeg_total_frames;
     int sjpeg_single_frame_height;
-    int sjpeg_cache_frame_index;
+    int sjpeg_cache_frame_index;        //the fragment `tjpeg_jd` is decoding, -1: none
     uint8_t ** frame_base_array;        //to save base address of each split frames upto sjpeg_total_frames.
     int * frame_base_offset;            //to save base offset for fseek
-    uint8_t * frame_cache;
+    lv_color_t * row_cache;             //the last MCU row decoded, all of its width
+    int row_cache_y;                    //its first line in the image, -1: empty
+    int row_cache_h;
+    sjpeg_resume_t * resume;            //the decoder at the top of each MCU row of the fragment passed so far
+    int resume_cnt;
     uint8_t * workb;                    //JPG work buffer for jpeg library
     JDEC * tjpeg_jd;
     io_source_t io;
@@ -109,7 +125,12 @@ static lv_res_t decoder_info(lv_img_decoder_t * decoder, const void * src, lv_im
 static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
 static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                   lv_coord_t len, uint8_t * buf);
+static lv_res_t decoder_read_area(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, const lv_area_t * area,
+                                  lv_color_t * buf, lv_coord_t stride);
 static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+static lv_res_t start_frame(SJPEG * sjpeg, int frame);
+static lv_res_t resume_frame(SJPEG * sjpeg, int row);
+static JRESULT decode_rows(SJPEG * sjpeg, const JRECT * rect);
 static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata);
 static int is_jpg(const uint8_t * raw_data, size_t len);
 static void lv_sjpg_cleanup(SJPEG * sjpeg);
@@ -133,6 +154,7 @@ void lv_split_jpeg_init(void)
     lv_img_decoder_set_open_cb(dec, decoder_open);
     lv_img_decoder_set_close_cb(dec, decoder_close);
     lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
+    lv_img_decoder_set_read_area_cb(dec, decoder_read_area);
 }
 
 /**********************
@@ -260,7 +282,6 @@ end:
             io_source_t io_source_temp;
             io_source_temp.type = SJPEG_IO_SOURCE_DISK;
             io_source_temp.raw_sjpg_data_next_read_pos = 0;
-            io_source_temp.img_cache_buff = NULL;
             io_source_temp.lv_file = file;
             JDEC jd_tmp;
 
@@ -283,17 +304,29 @@ end:
 static int img_data_cb(JDEC * jd, void * data, JRECT * rect)
 {
     io_source_t * io = jd->device;
-    uint8_t * cache = io->img_cache_buff;
-    const int xres = io->img_cache_x_res;
-    uint8_t * buf = data;
+    const lv_area_t * out = &io->out_area;
+    const uint8_t * buf = data;
     const int INPUT_PIXEL_SIZE = 3;
     const int row_width = rect->right - rect->left + 1; // Row width in pixels.
-    const int row_size = row_width * INPUT_PIXEL_SIZE;  // Row size (bytes).
 
-    for(int y = rect->top; y <= rect->bottom; y++) {
-        int row_offset = y * xres * INPUT_PIXEL_SIZE + rect->left * INPUT_PIXEL_SIZE;
-        memcpy(cache + row_offset, buf, row_size);
-        buf += row_size;
+    /*The part of the MCU in the area asked for*/
+    lv_coord_t x1 = LV_MAX(rect->left, out->x1);
+    lv_coord_t x2 = LV_MIN(rect->right, out->x2);
+    lv_coord_t y1 = LV_MAX(rect->top, out->y1);
+    lv_coord_t y2 = LV_MIN(rect->bottom, out->y2);
+    if(x1 > x2 || y1 > y2) return 1;
+
+    const int w = x2 - x1 + 1;
+    buf += ((y1 - rect->top) * row_width + (x1 - rect->left)) * INPUT_PIXEL_SIZE;
+    lv_color_t * dest = io->out_buf + (y1 - out->y1) * io->out_stride + (x1 - out->x1);
+    for(int y = y1; y <= y2; y++) {
+        const uint8_t * src = buf;
+        for(int x = 0; x < w; x++) {
+            dest[x] = lv_color_make(src[0], src[1], src[2]);
+            src += INPUT_PIXEL_SIZE;
+        }
+        buf += row_width * INPUT_PIXEL_SIZE;
+        dest += io->out_stride;
     }
 
     return 1;
@@ -320,15 +353,16 @@ static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata)
 
         lv_fs_file_t * lv_file_p = &(io->lv_file);
 
+        /*The position is counted here, decode_rows() saves it to seek back to*/
         if(buff) {
             uint32_t rn = 0;
             lv_fs_read(lv_file_p, buff, (uint32_t)ndata, &rn);
+            io->raw_sjpg_data_next_read_pos += rn;
             return rn;
         }
         else {
-            uint32_t pos;
-            lv_fs_tell(lv_file_p, &pos);
-            lv_fs_seek(lv_file_p, (uint32_t)(ndata + pos),  LV_FS_SEEK_SET);
+            io->raw_sjpg_data_next_read_pos += (uint32_t)ndata;
+            lv_fs_seek(lv_file_p, io->raw_sjpg_data_next_read_pos,  LV_FS_SEEK_SET);
             return ndata;
         }
     }
@@ -396,14 +430,20 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 sjpeg->frame_base_array[i] = sjpeg->frame_base_array[i - 1] + offset;
             }
             sjpeg->sjpeg_cache_frame_index = -1;
-            sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3/*2*/);
-            if(! sjpeg->frame_cache) {
+            sjpeg->row_cache_y = -1;
+            sjpeg->row_cache = lv_mem_alloc(sjpeg->sjpeg_x_res * LV_MIN(sjpeg->sjpeg_single_frame_height,
+                                                                        SJPEG_MAX_MCU_HEIGHT) * sizeof(lv_color_t));
+            if(! sjpeg->row_cache) {
+                lv_sjpg_cleanup(sjpeg);
+                sjpeg = NULL;
+                return LV_RES_INV;
+            }
+            sjpeg->resume = lv_mem_alloc((sjpeg->sjpeg_single_frame_height / 8 + 1) * sizeof(sjpeg_resume_t));
+            if(! sjpeg->resume) {
                 lv_sjpg_cleanup(sjpeg);
                 sjpeg = NULL;
                 return LV_RES_INV;
             }
-            sjpeg->io.img_cache_buff = sjpeg->frame_cache;
-            sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
             sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
             if(! sjpeg->workb) {
                 lv_sjpg_cleanup(sjpeg);
@@ -459,15 +499,21 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 sjpeg->frame_base_array[0] = img_frame_base;
 
                 sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
+                sjpeg->row_cache_y = -1;
+                sjpeg->row_cache = lv_mem_alloc(sjpeg->sjpeg_x_res * LV_MIN(sjpeg->sjpeg_single_frame_height,
+                                                                            SJPEG_MAX_MCU_HEIGHT) * sizeof(lv_color_t));
+                if(! sjpeg->row_cache) {
+                    lv_sjpg_cleanup(sjpeg);
+                    sjpeg = NULL;
+                    return LV_RES_INV;
+                }
+                sjpeg->resume = lv_mem_alloc((sjpeg->sjpeg_single_frame_height / 8 + 1) * sizeof(sjpeg_resume_t));
+                if(! sjpeg->resume) {
                     lv_sjpg_cleanup(sjpeg);
                     sjpeg = NULL;
                     return LV_RES_INV;
                 }
 
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
-                sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
                     lv_sjpg_cleanup(sjpeg);
@@ -578,14 +624,20 @@ end:
                 }
 
                 sjpeg->sjpeg_cache_frame_index = -1; //INVALID AT BEGINNING for a forced compare mismatch at first time.
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
+                sjpeg->row_cache_y = -1;
+                sjpeg->row_cache = lv_mem_alloc(sjpeg->sjpeg_x_res * LV_MIN(sjpeg->sjpeg_single_frame_height,
+                                                                            SJPEG_MAX_MCU_HEIGHT) * sizeof(lv_color_t));
+                if(! sjpeg->row_cache) {
+                    lv_fs_close(&lv_file);
+                    lv_sjpg_cleanup(sjpeg);
+                    return LV_RES_INV;
+                }
+                sjpeg->resume = lv_mem_alloc((sjpeg->sjpeg_single_frame_height / 8 + 1) * sizeof(sjpeg_resume_t));
+                if(! sjpeg->resume) {
                     lv_fs_close(&lv_file);
                     lv_sjpg_cleanup(sjpeg);
                     return LV_RES_INV;
                 }
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
-                sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
                     lv_fs_close(&lv_file);
@@ -638,7 +690,6 @@ end:
             io_source_t io_source_temp;
             io_source_temp.type = SJPEG_IO_SOURCE_DISK;
             io_source_temp.raw_sjpg_data_next_read_pos = 0;
-            io_source_temp.img_cache_buff = NULL;
             io_source_temp.lv_file = lv_file;
 
             JDEC jd_tmp;
@@ -666,15 +717,21 @@ end:
                 sjpeg->frame_base_offset[0] = img_frame_start_offset;
 
                 sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
+                sjpeg->row_cache_y = -1;
+                sjpeg->row_cache = lv_mem_alloc(sjpeg->sjpeg_x_res * LV_MIN(sjpeg->sjpeg_single_frame_height,
+                                                                            SJPEG_MAX_MCU_HEIGHT) * sizeof(lv_color_t));
+                if(! sjpeg->row_cache) {
+                    lv_fs_close(&lv_file);
+                    lv_sjpg_cleanup(sjpeg);
+                    return LV_RES_INV;
+                }
+                sjpeg->resume = lv_mem_alloc((sjpeg->sjpeg_single_frame_height / 8 + 1) * sizeof(sjpeg_resume_t));
+                if(! sjpeg->resume) {
                     lv_fs_close(&lv_file);
                     lv_sjpg_cleanup(sjpeg);
                     return LV_RES_INV;
                 }
 
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
-                sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
                     lv_fs_close(&lv_file);
@@ -721,144 +778,181 @@ end:
 static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                   lv_coord_t len, uint8_t * buf)
 {
-    LV_UNUSED(decoder);
-    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
-        SJPEG * sjpeg = (SJPEG *) dsc->user_data;
-        JRESULT rc;
-
-        int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
+    lv_area_t line;
+    lv_area_set(&line, x, y, x + len - 1, y);
+    return decoder_read_area(decoder, dsc, &line, (lv_color_t *)buf, len);
+}
 
-        /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
-            sjpeg->io.raw_sjpg_data = sjpeg->frame_base_array[ sjpeg_req_frame_index ];
-            if(sjpeg_req_frame_index == (sjpeg->sjpeg_total_frames - 1)) {
-                /*This is the last frame. */
-                const uint32_t frame_offset = (uint32_t)(sjpeg->io.raw_sjpg_data - sjpeg->sjpeg_data);
-                sjpeg->io.raw_sjpg_data_size = sjpeg->sjpeg_data_size - frame_offset;
-            }
-            else {
-                sjpeg->io.raw_sjpg_data_size =
-                    (uint32_t)(sjpeg->frame_base_array[sjpeg_req_frame_index + 1] - sjpeg->io.raw_sjpg_data);
+/**
+ * Decode an area of the image straight into `buf`, e.g. the draw buffer.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ * @param area the area to decode, relative to the image
+ * @param buf the first pixel of the area goes here
+ * @param stride pixels from a line of `buf` to the next
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+static lv_res_t decoder_read_area(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, const lv_area_t * area,
+                                  lv_color_t * buf, lv_coord_t stride)
+{
+    LV_UNUSED(decoder);
+    SJPEG * sjpeg = (SJPEG *) dsc->user_data;
+    if(!sjpeg) return LV_RES_INV;
+
+    const lv_coord_t w = lv_area_get_width(area);
+    int y = area->y1;
+    while(y <= area->y2) {
+        const int frame = y / sjpeg->sjpeg_single_frame_height;
+        const int frame_y = frame * sjpeg->sjpeg_single_frame_height;
+        const int y2 = LV_MIN(area->y2, frame_y + sjpeg->sjpeg_single_frame_height - 1);   /*Last line in this fragment*/
+        lv_color_t * dest = buf + (y - area->y1) * stride;
+
+        /*Lines of the MCU row decoded last*/
+        if(sjpeg->row_cache_y >= 0 && y >= sjpeg->row_cache_y && y < sjpeg->row_cache_y + sjpeg->row_cache_h) {
+            const int cache_y2 = LV_MIN(y2, sjpeg->row_cache_y + sjpeg->row_cache_h - 1);
+            const lv_color_t * src = sjpeg->row_cache + (y - sjpeg->row_cache_y) * sjpeg->sjpeg_x_res + area->x1;
+            for(; y <= cache_y2; y++) {
+                lv_memcpy(dest, src, w * sizeof(lv_color_t));
+                src += sjpeg->sjpeg_x_res;
+                dest += stride;
             }
-            sjpeg->io.raw_sjpg_data_next_read_pos = 0;
-            rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
-            if(rc != JDR_OK) return LV_RES_INV;
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
-            if(rc != JDR_OK) return LV_RES_INV;
-            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
+            continue;
         }
 
-        int offset = 0;
-        uint8_t * cache = (uint8_t *)sjpeg->frame_cache + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res *
-                          3;
-
-#if  LV_COLOR_DEPTH == 32
-        for(int i = 0; i < len; i++) {
-            buf[offset + 3] = 0xff;
-            buf[offset + 2] = *cache++;
-            buf[offset + 1] = *cache++;
-            buf[offset + 0] = *cache++;
-            offset += 4;
+        /*Go on with the fragment being decoded if `y` is in the next MCU row, else continue at the row of `y`
+         *if the decoder has been there, or decode the fragment again from its start*/
+        JDEC * jd = sjpeg->tjpeg_jd;
+        if(frame != sjpeg->sjpeg_cache_frame_index) {
+            if(start_frame(sjpeg, frame) != LV_RES_OK) return LV_RES_INV;
         }
-
-#elif  LV_COLOR_DEPTH == 16
-
-        for(int i = 0; i < len; i++) {
-            uint16_t col_16bit = (*cache++ & 0xf8) << 8;
-            col_16bit |= (*cache++ & 0xFC) << 3;
-            col_16bit |= (*cache++ >> 3);
-#if  LV_BIG_ENDIAN_SYSTEM == 1 || LV_COLOR_16_SWAP == 1
-            buf[offset++] = col_16bit >> 8;
-            buf[offset++] = col_16bit & 0xff;
-#else
-            buf[offset++] = col_16bit & 0xff;
-            buf[offset++] = col_16bit >> 8;
-#endif // LV_BIG_ENDIAN_SYSTEM
+        const int mcu_h = jd->msy * 8;
+        const int y_row = (y - frame_y) / mcu_h;
+        if(y_row != jd->mcu_y / mcu_h && (y_row < sjpeg->resume_cnt || y - frame_y < jd->mcu_y)) {
+            if(resume_frame(sjpeg, y_row) != LV_RES_OK) return LV_RES_INV;
         }
 
-#elif  LV_COLOR_DEPTH == 8
-
-        for(int i = 0; i < len; i++) {
-            uint8_t col_8bit = (*cache++ & 0xC0);
-            col_8bit |= (*cache++ & 0xe0) >> 2;
-            col_8bit |= (*cache++ & 0xe0) >> 5;
-            buf[offset++] = col_8bit;
+        if(y2 - frame_y >= jd->height) return LV_RES_INV;   /*The fragment is shorter than the header says*/
+
+        /*Only the MCU row of the last line can be needed by the next call too, keep it if it goes on below the area*/
+        const int row_y = (y2 - frame_y) / mcu_h * mcu_h;
+        const int row_y2 = LV_MIN(row_y + mcu_h, jd->height) - 1;
+        io_source_t * io = &sjpeg->io;
+        if(y2 - frame_y == row_y2) {
+            lv_area_set(&io->out_area, area->x1, y - frame_y, area->x2, y2 - frame_y);
+            io->out_buf = dest;
+            io->out_stride = stride;
+            y = y2 + 1;
+        }
+        else if(y - frame_y < row_y) {
+            lv_area_set(&io->out_area, area->x1, y - frame_y, area->x2, row_y - 1);
+            io->out_buf = dest;
+            io->out_stride = stride;
+            y = frame_y + row_y;
+        }
+        else {
+            lv_area_set(&io->out_area, 0, row_y, jd->width - 1, row_y2);
+            io->out_buf = sjpeg->row_cache;
+            io->out_stride = sjpeg->sjpeg_x_res;
+            sjpeg->row_cache_y = frame_y + row_y;
+            sjpeg->row_cache_h = row_y2 - row_y + 1;
         }
-#else
-#error Unsupported LV_COLOR_DEPTH
-
 
-#endif // LV_COLOR_DEPTH
-        return LV_RES_OK;
+        JRECT rect;
+        rect.left = io->out_area.x1;
+        rect.right = io->out_area.x2;
+        rect.top = io->out_area.y1;
+        rect.bottom = io->out_area.y2;
+        JRESULT rc = decode_rows(sjpeg, &rect);
+        if(rc != JDR_OK) {
+            sjpeg->sjpeg_cache_frame_index = -1;
+            sjpeg->row_cache_y = -1;
+            return LV_RES_INV;
+        }
     }
-    else if(dsc->src_type == LV_IMG_SRC_FILE) {
-        SJPEG * sjpeg = (SJPEG *) dsc->user_data;
-        JRESULT rc;
-        int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
 
-        lv_fs_file_t * lv_file_p = &(sjpeg->io.lv_file);
-        if(!lv_file_p) goto end;
-
-        /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
-            sjpeg->io.raw_sjpg_data_next_read_pos = (int)(sjpeg->frame_base_offset [ sjpeg_req_frame_index ]);
-            lv_fs_seek(&(sjpeg->io.lv_file), sjpeg->io.raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
-
-            rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
-            if(rc != JDR_OK) return LV_RES_INV;
-
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
-            if(rc != JDR_OK) return LV_RES_INV;
-
-            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
-        }
+    return LV_RES_OK;
+}
 
-        int offset = 0;
-        uint8_t * cache = (uint8_t *)sjpeg->frame_cache + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res *
-                          3;
-
-#if LV_COLOR_DEPTH == 32
-        for(int i = 0; i < len; i++) {
-            buf[offset + 3] = 0xff;
-            buf[offset + 2] = *cache++;
-            buf[offset + 1] = *cache++;
-            buf[offset + 0] = *cache++;
-            offset += 4;
+/**
+ * Prepare the decoder for a fragment, to decode it from its first line
+ */
+static lv_res_t start_frame(SJPEG * sjpeg, int frame)
+{
+    if(frame >= sjpeg->sjpeg_total_frames) return LV_RES_INV;
+
+    if(sjpeg->io.type == SJPEG_IO_SOURCE_C_ARRAY) {
+        sjpeg->io.raw_sjpg_data = sjpeg->frame_base_array[frame];
+        if(frame == (sjpeg->sjpeg_total_frames - 1)) {
+            /*This is the last frame. */
+            const uint32_t frame_offset = (uint32_t)(sjpeg->io.raw_sjpg_data - sjpeg->sjpeg_data);
+            sjpeg->io.raw_sjpg_data_size = sjpeg->sjpeg_data_size - frame_offset;
         }
-#elif  LV_COLOR_DEPTH == 16
-
-        for(int i = 0; i < len; i++) {
-            uint16_t col_8bit = (*cache++ & 0xf8) << 8;
-            col_8bit |= (*cache++ & 0xFC) << 3;
-            col_8bit |= (*cache++ >> 3);
-#if  LV_BIG_ENDIAN_SYSTEM == 1 || LV_COLOR_16_SWAP == 1
-            buf[offset++] = col_8bit >> 8;
-            buf[offset++] = col_8bit & 0xff;
-#else
-            buf[offset++] = col_8bit & 0xff;
-            buf[offset++] = col_8bit >> 8;
-#endif // LV_BIG_ENDIAN_SYSTEM
+        else {
+            sjpeg->io.raw_sjpg_data_size =
+                (uint32_t)(sjpeg->frame_base_array[frame + 1] - sjpeg->io.raw_sjpg_data);
         }
+        sjpeg->io.raw_sjpg_data_next_read_pos = 0;
+    }
+    else {
+        sjpeg->io.raw_sjpg_data_next_read_pos = (int)(sjpeg->frame_base_offset[frame]);
+        lv_fs_seek(&(sjpeg->io.lv_file), sjpeg->io.raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
+    }
 
-#elif  LV_COLOR_DEPTH == 8
-
-        for(int i = 0; i < len; i++) {
-            uint8_t col_8bit = (*cache++ & 0xC0);
-            col_8bit |= (*cache++ & 0xe0) >> 2;
-            col_8bit |= (*cache++ & 0xe0) >> 5;
-            buf[offset++] = col_8bit;
-        }
+    sjpeg->sjpeg_cache_frame_index = -1;
+    JRESULT rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
+    if(rc != JDR_OK) return LV_RES_INV;
 
-#else
-#error Unsupported LV_COLOR_DEPTH
+    /*The row cache holds an MCU row of the whole width, at most as high as a fragment*/
+    if(sjpeg->tjpeg_jd->width != sjpeg->sjpeg_x_res || sjpeg->tjpeg_jd->height > sjpeg->sjpeg_single_frame_height) {
+        return LV_RES_INV;
+    }
 
+    sjpeg->sjpeg_cache_frame_index = frame;
+    sjpeg->resume_cnt = 0;
+    return LV_RES_OK;
+}
 
-#endif // LV_COLOR_DEPTH
+/**
+ * Continue decoding the current fragment at an MCU row saved by decode_rows(), else from its start
+ */
+static lv_res_t resume_frame(SJPEG * sjpeg, int row)
+{
+    if(row >= sjpeg->resume_cnt) return start_frame(sjpeg, sjpeg->sjpeg_cache_frame_index);
+
+    const sjpeg_resume_t * r = &sjpeg->resume[row];
+    sjpeg->io.raw_sjpg_data_next_read_pos = r->pos;
+    if(sjpeg->io.type == SJPEG_IO_SOURCE_DISK &&
+       lv_fs_seek(&sjpeg->io.lv_file, r->pos, LV_FS_SEEK_SET) != LV_FS_RES_OK) {
+        sjpeg->sjpeg_cache_frame_index = -1;
+        return LV_RES_INV;
+    }
+    jd_load_state(sjpeg->tjpeg_jd, &r->state);
+    return LV_RES_OK;
+}
 
-        return LV_RES_OK;
+/**
+ * Decode the fragment down to `rect` an MCU row at a time, saving the state at the top of the rows
+ * not passed yet so later areas can start there
+ */
+static JRESULT decode_rows(SJPEG * sjpeg, const JRECT * rect)
+{
+    JDEC * jd = sjpeg->tjpeg_jd;
+    const int mcu_h = jd->msy * 8;
+    JRECT row_rect = *rect;
+    while(jd->mcu_y <= rect->bottom) {
+        const int row = jd->mcu_y / mcu_h;
+        if(row == sjpeg->resume_cnt) {
+            sjpeg_resume_t * r = &sjpeg->resume[row];
+            jd_save_state(jd, &r->state);
+            r->pos = sjpeg->io.raw_sjpg_data_next_read_pos - r->state.dctr;
+            sjpeg->resume_cnt++;
+        }
+        row_rect.top = LV_MAX(rect->top, jd->mcu_y);
+        row_rect.bottom = jd->mcu_y;
+        JRESULT rc = jd_decomp_rect(jd, img_data_cb, &row_rect);
+        if(rc != JDR_OK) return rc;
     }
-end:
-    return LV_RES_INV;
+    return JDR_OK;
 }
 
 /**
@@ -899,7 +993,8 @@ static int is_jpg(const uint8_t * raw_data, size_t len)
 
 static void lv_sjpg_free(SJPEG * sjpeg)
 {
-    if(sjpeg->frame_cache) lv_mem_free(sjpeg->frame_cache);
+    if(sjpeg->row_cache) lv_mem_free(sjpeg->row_cache);
+    if(sjpeg->resume) lv_mem_free(sjpeg->resume);
     if(sjpeg->frame_base_array) lv_mem_free(sjpeg->frame_base_array);
     if(sjpeg->frame_base_offset) lv_mem_free(sjpeg->frame_base_offset);
     if(sjpeg->tjpeg_jd) lv_mem_free(sjpeg->tjpeg_jd);
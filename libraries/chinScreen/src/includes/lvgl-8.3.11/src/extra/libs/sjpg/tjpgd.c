@@ -700,7 +700,8 @@ static void block_idct (
 /*-----------------------------------------------------------------------*/
 
 static JRESULT mcu_load (
-	JDEC* jd		/* Pointer to the decompressor object */
+	JDEC* jd,		/* Pointer to the decompressor object */
+	int skip		/* Only follow the huffman stream, the MCU is not output */
 )
 {
 	int32_t *tmp = (int32_t*)jd->workbuf;	/* Block working buffer for de-quantize and IDCT */
@@ -739,7 +740,7 @@ static JRESULT mcu_load (
 			tmp[0] = d * dqf[0] >> 8;				/* De-quantize, apply scale factor of Arai algorithm and descale 8 bits */
 
 			/* Extract following 63 AC elements from input stream */
-			memset(&tmp[1], 0, 63 * sizeof (int32_t));	/* Initialize all AC elements */
+			if (!skip) memset(&tmp[1], 0, 63 * sizeof (int32_t));	/* Initialize all AC elements */
 			z = 1;		/* Top of the AC elements (in zigzag-order) */
 			do {
 				d = huffext(jd, id, 1);				/* Extract a huffman coded value (zero runs and bit length) */
@@ -752,13 +753,14 @@ static JRESULT mcu_load (
 					d = bitext(jd, bc);				/* Extract data bits */
 					if (d < 0) return (JRESULT)(0 - d);	/* Err: input device */
 					bc = 1 << (bc - 1);				/* MSB position */
+					if (skip) continue;
 					if (!(d & bc)) d -= (bc << 1) - 1;	/* Restore negative value if needed */
 					i = Zig[z];						/* Get raster-order index */
 					tmp[i] = d * dqf[i] >> 8;		/* De-quantize, apply scale factor of Arai algorithm and descale 8 bits */
 				}
 			} while (++z < 64);		/* Next AC element */
 
-			if (JD_FORMAT != 2 || !cmp) {	/* C components may not be processed if in grayscale output */
+			if (!skip && (JD_FORMAT != 2 || !cmp)) {	/* C components may not be processed if in grayscale output */
 				if (z == 1 || (JD_USE_SCALE && jd->scale == 3)) {	/* If no AC element or scale ratio is 1/8, IDCT can be ommited and the block is filled with DC value */
 					d = (jd_yuv_t)((*tmp / 256) + 128);
 					if (JD_FASTDECODE >= 1) {
@@ -1084,6 +1086,10 @@ JRESULT jd_prepare (
 			}
 			jd->dptr = seg + ofs - (JD_FASTDECODE ? 0 : 1);
 
+			jd->dcv[2] = jd->dcv[1] = jd->dcv[0] = 0;	/* Initialize the state of jd_decomp_rect() */
+			jd->mcu_y = 0;
+			jd->rst = jd->rsc = 0;
+
 			return JDR_OK;		/* Initialization succeeded. Ready to decompress the JPEG image. */
 
 		case 0xC1:	/* SOF1 */
@@ -1142,7 +1148,7 @@ JRESULT jd_decomp (
 				if (rc != JDR_OK) return rc;
 				rst = 1;
 			}
-			rc = mcu_load(jd);					/* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
+			rc = mcu_load(jd, 0);				/* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
 			if (rc != JDR_OK) return rc;
 			rc = mcu_output(jd, outfunc, x, y);	/* Output the MCU (YCbCr to RGB, scaling and output) */
 			if (rc != JDR_OK) return rc;
@@ -1152,4 +1158,100 @@ JRESULT jd_decomp (
 	return rc;
 }
 
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Decompress the picture down to a rectangular, continuing at the MCU  */
+/* row where the previous call ended                                     */
+/*-----------------------------------------------------------------------*/
+
+JRESULT jd_decomp_rect (
+	JDEC* jd,								/* Initialized decompression object */
+	int (*outfunc)(JDEC*, void*, JRECT*),	/* RGB output function */
+	const JRECT* rect						/* Area to output (pixel, not scaled) */
+)
+{
+	unsigned int x, y, mx, my;
+	int out_row;
+	JRESULT rc;
+
+
+	if (rect->top < jd->mcu_y) return JDR_PAR;	/* Err: the MCU row was already passed, jd_prepare() again */
+	jd->scale = 0;
+
+	mx = jd->msx * 8; my = jd->msy * 8;			/* Size of the MCU (pixel) */
+
+	for (y = jd->mcu_y; y < jd->height && y <= rect->bottom; y += my) {	/* Vertical loop of MCUs */
+		out_row = y + my > rect->top;			/* Rows above the rectangular are only followed in the stream */
+		for (x = 0; x < jd->width; x += mx) {	/* Horizontal loop of MCUs */
+			if (jd->nrst && jd->rst++ == jd->nrst) {	/* Process restart interval if enabled */
+				rc = restart(jd, jd->rsc++);
+				if (rc != JDR_OK) return rc;
+				jd->rst = 1;
+			}
+			if (out_row && x <= rect->right && x + mx > rect->left) {
+				rc = mcu_load(jd, 0);
+				if (rc != JDR_OK) return rc;
+				rc = mcu_output(jd, outfunc, x, y);
+			} else {
+				rc = mcu_load(jd, 1);			/* Outside of the rectangular, no IDCT and color conversion */
+			}
+			if (rc != JDR_OK) return rc;
+		}
+		jd->mcu_y = (uint16_t)(y + my);
+	}
+
+	return JDR_OK;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Save the state between two jd_decomp_rect() calls                     */
+/*-----------------------------------------------------------------------*/
+
+void jd_save_state (
+	const JDEC* jd,		/* Decompressor at the top of an MCU row */
+	JSTATE* st			/* The state goes here */
+)
+{
+	st->mcu_y = jd->mcu_y;
+	st->rst = jd->rst; st->rsc = jd->rsc;
+	st->dcv[0] = jd->dcv[0]; st->dcv[1] = jd->dcv[1]; st->dcv[2] = jd->dcv[2];
+	st->dctr = (uint16_t)jd->dctr;
+	st->dbit = jd->dbit;
+#if JD_FASTDECODE >= 1
+	st->wreg = jd->wreg;
+	st->marker = jd->marker;
+#else
+	st->dbyte = st->dbit ? *jd->dptr : 0;	/* Right after jd_prepare() dptr is in front of the buffer */
+#endif
+}
+
+
+/*-----------------------------------------------------------------------*/
+/* Continue at a saved MCU row, the input function has to be moved to    */
+/* JSTATE.dctr bytes before where it was when the state was saved        */
+/*-----------------------------------------------------------------------*/
+
+void jd_load_state (
+	JDEC* jd,			/* Decompressor prepared for the same picture */
+	const JSTATE* st	/* The saved state */
+)
+{
+	jd->mcu_y = st->mcu_y;
+	jd->rst = st->rst; jd->rsc = st->rsc;
+	jd->dcv[0] = st->dcv[0]; jd->dcv[1] = st->dcv[1]; jd->dcv[2] = st->dcv[2];
+	jd->dctr = 0;		/* The input buffer is filled again at the next byte */
+	jd->dptr = jd->inbuf;
+	jd->dbit = st->dbit;
+#if JD_FASTDECODE >= 1
+	jd->wreg = st->wreg;
+	jd->marker = st->marker;
+#else
+	jd->inbuf[0] = st->dbyte;
+#endif
+}
+
 #endif /*LV_USE_SJPG*/
@@ -43,6 +43,22 @@ typedef struct {
 	uint16_t bottom;	/* Bottom end */
 } JRECT;
 
+/* Decompressor state at the top of an MCU row, to continue jd_decomp_rect() there later */
+typedef struct {
+	uint16_t mcu_y;			/* Top of the MCU row */
+	uint16_t rst, rsc;		/* Restart interval counters */
+	int16_t dcv[3];			/* Previous DC element of each component */
+	uint16_t dctr;			/* Input bytes read ahead, the stream goes on this many bytes before the read position */
+#if JD_FASTDECODE >= 1
+	uint32_t wreg;			/* Working shift register */
+	uint8_t dbit;			/* Number of bits available in wreg */
+	uint8_t marker;			/* Detected marker */
+#else
+	uint8_t dbit;			/* Reading bit mask of the current byte */
+	uint8_t dbyte;			/* The current byte */
+#endif
+} JSTATE;
+
 /* Decompressor object structure */
 typedef struct JDEC JDEC;
 struct JDEC {
@@ -76,6 +92,8 @@ struct JDEC {
 	size_t sz_pool;				/* Size of momory pool (bytes available) */
 	size_t (*infunc)(JDEC*, uint8_t*, size_t);	/* Pointer to jpeg stream input function */
 	void* device;				/* Pointer to I/O device identifiler for the session */
+	uint16_t mcu_y;				/* Top of the next MCU row jd_decomp_rect() decompresses */
+	uint16_t rst, rsc;			/* Restart interval counters of jd_decomp_rect() */
 };
 
 
@@ -83,6 +101,9 @@ struct JDEC {
 /* TJpgDec API functions */
 JRESULT jd_prepare (JDEC* jd, size_t (*infunc)(JDEC*,uint8_t*,size_t), void* pool, size_t sz_pool, void* dev);
 JRESULT jd_decomp (JDEC* jd, int (*outfunc)(JDEC*,void*,JRECT*), uint8_t scale);
+JRESULT jd_decomp_rect (JDEC* jd, int (*outfunc)(JDEC*,void*,JRECT*), const JRECT* rect);
+void jd_save_state (const JDEC* jd, JSTATE* st);
+void jd_load_state (JDEC* jd, const JSTATE* st);
 
 #endif /*LV_USE_SJPG*/
 
@@ -2,7 +2,18 @@
 
 #if LV_USE_TINY_TTF
 #include <stdio.h>
-#include "../../../misc/lv_lru.h"
+
+#ifdef LV_IMG_CACHE_ALLOC_INCLUDE
+    #include LV_IMG_CACHE_ALLOC_INCLUDE
+#endif
+#ifdef LV_TINY_TTF_TIME_INCLUDE
+    #include LV_TINY_TTF_TIME_INCLUDE
+#endif
+
+#ifndef LV_IMG_CACHE_ALLOC
+    #define LV_IMG_CACHE_ALLOC(size) lv_mem_alloc(size)
+    #define LV_IMG_CACHE_FREE(p)     lv_mem_free(p)
+#endif
 
 #define STB_RECT_PACK_IMPLEMENTATION
 #define STBRP_STATIC
@@ -16,41 +27,97 @@
 #define TTF_MALLOC(x) (lv_mem_alloc(x))
 #define TTF_FREE(x) (lv_mem_free(x))
 
+#define GLYPH_BUCKET_CNT 256    /*A power of two, a few sizes of a font use a few hundred glyphs*/
+#define KERN_CACHE_CNT 64       /*Kerning pairs kept per font file, a power of two*/
+
+/*The glyphs of every font and the pages of the font files are counted together*/
+static lv_tiny_ttf_stats_t stats;
+
 #if LV_TINY_TTF_FILE_SUPPORT
+typedef struct ttf_page {
+    uint8_t * data;
+    uint32_t index;         /*Page of the file in `data`, UINT32_MAX if none*/
+    uint32_t used;          /*`clock` when it was read last*/
+} ttf_page_t;
+
 /* a hydra stream that can be in memory or from a file*/
 typedef struct ttf_cb_stream {
     lv_fs_file_t * file;
     const void * data;
     size_t size;
     size_t position;
+    ttf_page_t pages[LV_TINY_TTF_PAGE_CNT];
+    ttf_page_t * last;      /*Most reads fall in the page of the previous one*/
+    uint32_t clock;
 } ttf_cb_stream_t;
 
+/*Get a page of the file, reading it over the one used longest ago if it's not kept*/
+static const uint8_t * ttf_cb_stream_page(ttf_cb_stream_t * stream, uint32_t index)
+{
+    ttf_page_t * page = stream->last;
+    if(page->index != index) {
+        ttf_page_t * oldest = &stream->pages[0];
+        uint32_t i;
+        for(i = 0; i < LV_TINY_TTF_PAGE_CNT; i++) {
+            page = &stream->pages[i];
+            if(page->index == index) break;
+            if(page->used < oldest->used) oldest = page;
+        }
+        if(i == LV_TINY_TTF_PAGE_CNT) {
+            page = oldest;
+            page->index = UINT32_MAX;
+            uint32_t br = 0;
+            if(lv_fs_seek(stream->file, index * LV_TINY_TTF_PAGE_SIZE, LV_FS_SEEK_SET) != LV_FS_RES_OK ||
+               lv_fs_read(stream->file, page->data, LV_TINY_TTF_PAGE_SIZE, &br) != LV_FS_RES_OK) {
+                LV_LOG_WARN("tiny_ttf: couldn't read page %"LV_PRIu32, index);
+                return NULL;
+            }
+            if(br < LV_TINY_TTF_PAGE_SIZE) lv_memset_00(page->data + br, LV_TINY_TTF_PAGE_SIZE - br);
+            page->index = index;
+            stats.page_reads++;
+            stats.bytes_read += br;
+        }
+        stream->last = page;
+    }
+    page->used = ++stream->clock;
+    return page->data;
+}
+
 static void ttf_cb_stream_read(ttf_cb_stream_t * stream, void * data, size_t to_read)
 {
+    uint8_t * out = data;
+    if(stream->position + to_read > stream->size) {
+        size_t avail = stream->position < stream->size ? stream->size - stream->position : 0;
+        lv_memset_00(out + avail, to_read - avail);
+        to_read = avail;
+    }
     if(stream->file != NULL) {
-        uint32_t br;
-        lv_fs_read(stream->file, data, to_read, &br);
+        while(to_read > 0) {
+            uint32_t ofs = stream->position % LV_TINY_TTF_PAGE_SIZE;
+            const uint8_t * page = ttf_cb_stream_page(stream, stream->position / LV_TINY_TTF_PAGE_SIZE);
+            if(page == NULL) {
+                lv_memset_00(out, to_read);
+                return;
+            }
+            size_t n = LV_MIN(to_read, LV_TINY_TTF_PAGE_SIZE - ofs);
+            lv_memcpy(out, page + ofs, n);
+            out += n;
+            to_read -= n;
+            stream->position += n;
+        }
     }
     else {
-        if(to_read + stream->position >= stream->size) {
-            to_read = stream->size - stream->position;
-        }
-        lv_memcpy(data, ((const unsigned char *)stream->data + stream->position), to_read);
+        lv_memcpy(out, ((const unsigned char *)stream->data + stream->position), to_read);
         stream->position += to_read;
     }
 }
 static void ttf_cb_stream_seek(ttf_cb_stream_t * stream, size_t position)
 {
-    if(stream->file != NULL) {
-        lv_fs_seek(stream->file, position, LV_FS_SEEK_SET);
+    if(position > stream->size) {
+        stream->position = stream->size;
     }
     else {
-        if(position > stream->size) {
-            stream->position = stream->size;
-        }
-        else {
-            stream->position = position;
-        }
+        stream->position = position;
     }
 }
 
@@ -63,24 +130,221 @@ static void ttf_cb_stream_seek(ttf_cb_stream_t * stream, size_t position)
 #include "stb_rect_pack.h"
 #include "stb_truetype_htcw.h"
 
-typedef struct ttf_font_desc {
+typedef struct ttf_kern {
+    uint16_t g1;            /*0: empty*/
+    uint16_t g2;
+    int16_t advance;
+} ttf_kern_t;
+
+/*The file or data of a font, shared by the sizes made with lv_tiny_ttf_create_size()*/
+typedef struct ttf_face {
     lv_fs_file_t file;
 #if LV_TINY_TTF_FILE_SUPPORT
     ttf_cb_stream_t stream;
+    uint8_t * page_mem;
 #else
     const uint8_t * stream;
 #endif
     stbtt_fontinfo info;
-    float scale;
     int ascent;
     int descent;
-    lv_lru_t * bitmap_cache;
+    int line_gap;
+    uint32_t ref_cnt;
+    ttf_kern_t kern[KERN_CACHE_CNT];
+} ttf_face_t;
+
+typedef struct ttf_font_desc {
+    ttf_face_t * face;
+    float scale;
+    lv_coord_t font_size;
 } ttf_font_desc_t;
 
-typedef struct ttf_bitmap_cache_key {
-    uint32_t unicode_letter;
-    lv_coord_t line_height;
-} ttf_bitmap_cache_key_t;
+/*The metrics of a glyph at a size and its bitmap once it's drawn*/
+typedef struct _glyph_entry_t {
+    struct _glyph_entry_t * hash_next;  /*Next entry in the same bucket*/
+    struct _glyph_entry_t * prev;       /*Used more recently*/
+    struct _glyph_entry_t * next;       /*Used less recently*/
+    const ttf_face_t * face;
+    uint32_t letter;
+    lv_coord_t font_size;
+    uint32_t hash;
+    uint32_t size;                      /*Bytes counted against the budget*/
+    int glyph;                          /*0: not in the font*/
+    int advance;                        /*Unscaled*/
+    int x1, y1, x2, y2;                 /*Box of the bitmap*/
+    uint8_t * bitmap;                   /*`(x2 - x1 + 1) * (y2 - y1 + 1)` opacities, NULL until drawn*/
+} glyph_entry_t;
+
+static glyph_entry_t * buckets[GLYPH_BUCKET_CNT];
+static glyph_entry_t * lru_first;       /*Most recently used*/
+static glyph_entry_t * lru_last;        /*Evicted next*/
+static uint32_t budget = LV_TINY_TTF_CACHE_DEF_BYTES;
+
+/*Used instead of the cache when a glyph doesn't fit in it*/
+static glyph_entry_t scratch_entry;
+static uint8_t * scratch_bitmap;
+static uint32_t scratch_bitmap_size;
+
+static uint32_t glyph_hash(const ttf_face_t * face, lv_coord_t font_size, uint32_t letter)
+{
+    /*FNV-1a of the face's address, the size and the letter*/
+    uint32_t h = 2166136261u;
+    lv_uintptr_t p = (lv_uintptr_t)face;
+    h = (h ^ (uint32_t)p) * 16777619u;
+    h = (h ^ (uint32_t)((uint64_t)p >> 32)) * 16777619u;
+    h = (h ^ (uint32_t)font_size) * 16777619u;
+    h = (h ^ letter) * 16777619u;
+    return h ^ (h >> 16);
+}
+
+static void cache_remove(glyph_entry_t * entry)
+{
+    glyph_entry_t ** link = &buckets[entry->hash & (GLYPH_BUCKET_CNT - 1)];
+    while(*link != entry) link = &(*link)->hash_next;
+    *link = entry->hash_next;
+
+    if(entry->prev) entry->prev->next = entry->next;
+    else lru_first = entry->next;
+    if(entry->next) entry->next->prev = entry->prev;
+    else lru_last = entry->prev;
+
+    stats.glyph_cnt--;
+    stats.bytes -= entry->size;
+    if(entry->bitmap) LV_IMG_CACHE_FREE(entry->bitmap);
+    LV_IMG_CACHE_FREE(entry);
+}
+
+/*Evict the glyphs used longest ago until `max_bytes` are used, but never `keep`*/
+static void cache_trim(uint32_t max_bytes, const glyph_entry_t * keep)
+{
+    while(stats.bytes > max_bytes && lru_last != NULL && lru_last != keep) {
+        cache_remove(lru_last);
+        stats.evictions++;
+    }
+}
+
+/**
+ * Find the metrics of a glyph in the cache, or read them from the font and add them.
+ * The entry stays valid until the next call, copy what's needed before looking up another glyph.
+ * @param cached    set to true if the glyph was in the cache
+ */
+static glyph_entry_t * glyph_get(const ttf_font_desc_t * dsc, uint32_t letter, bool * cached)
+{
+    ttf_face_t * face = dsc->face;
+    uint32_t hash = glyph_hash(face, dsc->font_size, letter);
+    glyph_entry_t * entry;
+    for(entry = buckets[hash & (GLYPH_BUCKET_CNT - 1)]; entry != NULL; entry = entry->hash_next) {
+        if(entry->face == face && entry->letter == letter && entry->font_size == dsc->font_size) break;
+    }
+
+    if(entry) {
+        /*Move it to the front of the LRU list*/
+        if(entry != lru_first) {
+            entry->prev->next = entry->next;
+            if(entry->next) entry->next->prev = entry->prev;
+            else lru_last = entry->prev;
+            entry->prev = NULL;
+            entry->next = lru_first;
+            lru_first->prev = entry;
+            lru_first = entry;
+        }
+        *cached = true;
+        return entry;
+    }
+    *cached = false;
+
+    entry = NULL;
+    if(sizeof(glyph_entry_t) <= budget) {
+        cache_trim(budget - sizeof(glyph_entry_t), NULL);
+        entry = LV_IMG_CACHE_ALLOC(sizeof(glyph_entry_t));
+    }
+    if(entry == NULL) entry = &scratch_entry;
+
+    lv_memset_00(entry, sizeof(glyph_entry_t));
+    entry->face = face;
+    entry->letter = letter;
+    entry->font_size = dsc->font_size;
+    entry->hash = hash;
+    entry->size = sizeof(glyph_entry_t);
+    entry->glyph = stbtt_FindGlyphIndex(&face->info, (int)letter);
+    if(entry->glyph != 0) {
+        int lsb;
+        stbtt_GetGlyphHMetrics(&face->info, entry->glyph, &entry->advance, &lsb);
+        stbtt_GetGlyphBitmapBox(&face->info, entry->glyph, dsc->scale, dsc->scale,
+                                &entry->x1, &entry->y1, &entry->x2, &entry->y2);
+    }
+    if(entry == &scratch_entry) return entry;
+
+    glyph_entry_t ** bucket = &buckets[hash & (GLYPH_BUCKET_CNT - 1)];
+    entry->hash_next = *bucket;
+    *bucket = entry;
+
+    entry->next = lru_first;
+    if(lru_first) lru_first->prev = entry;
+    else lru_last = entry;
+    lru_first = entry;
+
+    stats.glyph_cnt++;
+    stats.bytes += entry->size;
+    return entry;
+}
+
+/*Rasterise the bitmap of a glyph into the cache, or the scratch buffer if it doesn't fit*/
+static const uint8_t * glyph_rasterise(const ttf_font_desc_t * dsc, glyph_entry_t * entry)
+{
+    if(entry->bitmap) {
+        stats.hits++;
+        return entry->bitmap;
+    }
+
+    int w = entry->x2 - entry->x1 + 1;
+    int h = entry->y2 - entry->y1 + 1;
+    if(w <= 0 || h <= 0) return NULL;
+    uint32_t px_cnt = (uint32_t)w * (uint32_t)h;
+
+    uint8_t * buffer = NULL;
+    if(entry != &scratch_entry && entry->size + px_cnt <= budget) {
+        cache_trim(budget - px_cnt, entry);
+        buffer = LV_IMG_CACHE_ALLOC(px_cnt);
+        if(buffer) {
+            entry->bitmap = buffer;
+            entry->size += px_cnt;
+            stats.bytes += px_cnt;
+        }
+    }
+    if(buffer == NULL) {
+        if(scratch_bitmap_size < px_cnt) {
+            if(scratch_bitmap) LV_IMG_CACHE_FREE(scratch_bitmap);
+            scratch_bitmap = LV_IMG_CACHE_ALLOC(px_cnt);
+            scratch_bitmap_size = scratch_bitmap ? px_cnt : 0;
+            if(scratch_bitmap == NULL) {
+                LV_LOG_ERROR("tiny_ttf: couldn't allocate %"LV_PRIu32" bytes for a glyph", px_cnt);
+                return NULL;
+            }
+        }
+        buffer = scratch_bitmap;
+    }
+
+    uint32_t t_start = LV_TINY_TTF_TIME_US_EXPR;
+    lv_memset_00(buffer, px_cnt);
+    stbtt_MakeGlyphBitmap(&dsc->face->info, buffer, w, h, w, dsc->scale, dsc->scale, entry->glyph);
+    uint32_t t = LV_TINY_TTF_TIME_US_EXPR - t_start;
+    stats.misses++;
+    stats.raster_us += t;
+    if(t > stats.raster_us_max) stats.raster_us_max = t;
+    return buffer;
+}
+
+static int ttf_kern_get(ttf_face_t * face, int g1, int g2)
+{
+    ttf_kern_t * k = &face->kern[((uint32_t)g1 * 31u + (uint32_t)g2) & (KERN_CACHE_CNT - 1)];
+    if(k->g1 != g1 || k->g2 != g2) {
+        k->g1 = (uint16_t)g1;
+        k->g2 = (uint16_t)g2;
+        k->advance = (int16_t)stbtt_GetGlyphKernAdvance(&face->info, g1, g2);
+    }
+    return k->advance;
+}
 
 static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                  uint32_t unicode_letter_next)
@@ -98,24 +362,25 @@ static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * d
         return true;
     }
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
-    int g1 = stbtt_FindGlyphIndex(&dsc->info, (int)unicode_letter);
+    bool cached;
+    glyph_entry_t * entry = glyph_get(dsc, unicode_letter, &cached);
+    if(cached) stats.metric_hits++;
+    else stats.metric_misses++;
+    int g1 = entry->glyph;
     if(g1 == 0) {
         /* Glyph not found */
         return false;
     }
-    int x1, y1, x2, y2;
+    int x1 = entry->x1, y1 = entry->y1, x2 = entry->x2, y2 = entry->y2;
+    int advw = entry->advance;
 
-    stbtt_GetGlyphBitmapBox(&dsc->info, g1, dsc->scale, dsc->scale, &x1, &y1, &x2, &y2);
-    int g2 = 0;
-    if(unicode_letter_next != 0) {
-        g2 = stbtt_FindGlyphIndex(&dsc->info, (int)unicode_letter_next);
+    /*The entry can't be used after looking up the next glyph*/
+    int k = 0;
+    ttf_face_t * face = dsc->face;
+    if(unicode_letter_next != 0 && (face->info.kern || face->info.gpos)) {
+        int g2 = glyph_get(dsc, unicode_letter_next, &cached)->glyph;
+        if(g2 != 0) k = ttf_kern_get(face, g1, g2);
     }
-    int advw, lsb;
-    stbtt_GetGlyphHMetrics(&dsc->info, g1, &advw, &lsb);
-    int k = stbtt_GetGlyphKernAdvance(&dsc->info, g1, g2);
-    dsc_out->adv_w = (uint16_t)floor((((float)advw + (float)k) * dsc->scale) +
-                                     0.5f); /*Horizontal space required by the glyph in [px]*/
-
     dsc_out->adv_w = (uint16_t)floor((((float)advw + (float)k) * dsc->scale) +
                                      0.5f); /*Horizontal space required by the glyph in [px]*/
     dsc_out->box_w = (x2 - x1 + 1);         /*width of the bitmap in [px]*/
@@ -130,127 +395,154 @@ static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * d
 static const uint8_t * ttf_get_glyph_bitmap_cb(const lv_font_t * font, uint32_t unicode_letter)
 {
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
-    const stbtt_fontinfo * info = (const stbtt_fontinfo *)&dsc->info;
-    int g1 = stbtt_FindGlyphIndex(info, (int)unicode_letter);
-    if(g1 == 0) {
+    bool cached;
+    glyph_entry_t * entry = glyph_get(dsc, unicode_letter, &cached);
+    if(entry->glyph == 0) {
         /* Glyph not found */
         return NULL;
     }
-    int x1, y1, x2, y2;
-    stbtt_GetGlyphBitmapBox(info, g1, dsc->scale, dsc->scale, &x1, &y1, &x2, &y2);
-    int w, h;
-    w = x2 - x1 + 1;
-    h = y2 - y1 + 1;
-    uint32_t stride = w;
-    /*Try to load from cache*/
-    ttf_bitmap_cache_key_t cache_key;
-    lv_memset(&cache_key, 0, sizeof(cache_key)); /*Zero padding*/
-    cache_key.unicode_letter = unicode_letter;
-    cache_key.line_height = font->line_height;
-    uint8_t * buffer = NULL;
-    lv_lru_get(dsc->bitmap_cache, &cache_key, sizeof(cache_key), (void **)&buffer);
-    if(buffer) {
-        return buffer;
-    }
-    LV_LOG_TRACE("cache miss for letter: %u", unicode_letter);
-    /*Prepare space in cache*/
-    size_t szb = h * stride;
-    buffer = lv_mem_alloc(szb);
-    if(!buffer) {
-        LV_LOG_ERROR("failed to allocate cache value");
+    return glyph_rasterise(dsc, entry);
+}
+
+static lv_font_t * ttf_font_create(ttf_face_t * face, lv_coord_t font_size)
+{
+    ttf_font_desc_t * dsc = (ttf_font_desc_t *)TTF_MALLOC(sizeof(ttf_font_desc_t));
+    lv_font_t * out_font = (lv_font_t *)TTF_MALLOC(sizeof(lv_font_t));
+    if(dsc == NULL || out_font == NULL) {
+        LV_LOG_ERROR("tiny_ttf: out of memory\n");
+        if(dsc) TTF_FREE(dsc);
+        if(out_font) TTF_FREE(out_font);
         return NULL;
     }
-    lv_memset(buffer, 0, szb);
-    if(LV_LRU_OK != lv_lru_set(dsc->bitmap_cache, &cache_key, sizeof(cache_key), buffer, szb)) {
-        LV_LOG_ERROR("failed to add cache value");
-        lv_mem_free(buffer);
-        return NULL;
+    lv_memset_00(dsc, sizeof(ttf_font_desc_t));
+    dsc->face = face;
+    face->ref_cnt++;
+    lv_memset(out_font, 0, sizeof(lv_font_t));
+    out_font->get_glyph_dsc = ttf_get_glyph_dsc_cb;
+    out_font->get_glyph_bitmap = ttf_get_glyph_bitmap_cb;
+    out_font->dsc = dsc;
+    lv_tiny_ttf_set_size(out_font, font_size);
+    return out_font;
+}
+
+static void ttf_face_release(ttf_face_t * face)
+{
+    if(--face->ref_cnt > 0) return;
+
+    /*Its glyphs can't be found any more*/
+    glyph_entry_t * entry = lru_first;
+    while(entry) {
+        glyph_entry_t * next = entry->next;
+        if(entry->face == face) cache_remove(entry);
+        entry = next;
     }
-    /*Render into cache*/
-    stbtt_MakeGlyphBitmap(info, buffer, w, h, stride, dsc->scale, dsc->scale, g1);
-    return buffer;
+#if LV_TINY_TTF_FILE_SUPPORT
+    if(face->stream.file != NULL) {
+        lv_fs_close(&face->file);
+        LV_IMG_CACHE_FREE(face->page_mem);
+    }
+#endif
+    TTF_FREE(face);
 }
 
-static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size_t data_size, lv_coord_t font_size,
-                                      size_t cache_size)
+static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size_t data_size, lv_coord_t font_size)
 {
     if((path == NULL && data == NULL) || 0 >= font_size) {
         LV_LOG_ERROR("tiny_ttf: invalid argument\n");
         return NULL;
     }
-    ttf_font_desc_t * dsc = (ttf_font_desc_t *)TTF_MALLOC(sizeof(ttf_font_desc_t));
-    if(dsc == NULL) {
+    ttf_face_t * face = (ttf_face_t *)TTF_MALLOC(sizeof(ttf_face_t));
+    if(face == NULL) {
         LV_LOG_ERROR("tiny_ttf: out of memory\n");
         return NULL;
     }
+    lv_memset_00(face, sizeof(ttf_face_t));
 #if LV_TINY_TTF_FILE_SUPPORT
     if(path != NULL) {
-        if(LV_FS_RES_OK != lv_fs_open(&dsc->file, path, LV_FS_MODE_RD)) {
+        if(LV_FS_RES_OK != lv_fs_open(&face->file, path, LV_FS_MODE_RD)) {
             LV_LOG_ERROR("tiny_ttf: unable to open %s\n", path);
-            goto err_after_dsc;
+            goto err_after_face;
+        }
+        uint32_t size = 0;
+        lv_fs_seek(&face->file, 0, LV_FS_SEEK_END);
+        lv_fs_tell(&face->file, &size);
+        face->page_mem = LV_IMG_CACHE_ALLOC(LV_TINY_TTF_PAGE_CNT * LV_TINY_TTF_PAGE_SIZE);
+        if(face->page_mem == NULL) {
+            LV_LOG_ERROR("tiny_ttf: out of memory\n");
+            lv_fs_close(&face->file);
+            goto err_after_face;
+        }
+        uint32_t i;
+        for(i = 0; i < LV_TINY_TTF_PAGE_CNT; i++) {
+            face->stream.pages[i].data = face->page_mem + i * LV_TINY_TTF_PAGE_SIZE;
+            face->stream.pages[i].index = UINT32_MAX;
         }
-        dsc->stream.file = &dsc->file;
+        face->stream.last = &face->stream.pages[0];
+        face->stream.file = &face->file;
+        face->stream.size = size;
     }
     else {
-        dsc->stream.file = NULL;
-        dsc->stream.data = (const uint8_t *)data;
-        dsc->stream.size = data_size;
-        dsc->stream.position = 0;
+        face->stream.file = NULL;
+        face->stream.data = (const uint8_t *)data;
+        face->stream.size = data_size;
+        face->stream.position = 0;
     }
-    if(0 == stbtt_InitFont(&dsc->info, &dsc->stream, stbtt_GetFontOffsetForIndex(&dsc->stream, 0))) {
+    if(0 == stbtt_InitFont(&face->info, &face->stream, stbtt_GetFontOffsetForIndex(&face->stream, 0))) {
         LV_LOG_ERROR("tiny_ttf: init failed\n");
-        goto err_after_dsc;
+        if(face->stream.file != NULL) {
+            lv_fs_close(&face->file);
+            LV_IMG_CACHE_FREE(face->page_mem);
+        }
+        goto err_after_face;
     }
 
 #else
-    dsc->stream = (const uint8_t *)data;
+    face->stream = (const uint8_t *)data;
     LV_UNUSED(data_size);
-    if(0 == stbtt_InitFont(&dsc->info, dsc->stream, stbtt_GetFontOffsetForIndex(dsc->stream, 0))) {
+    if(0 == stbtt_InitFont(&face->info, face->stream, stbtt_GetFontOffsetForIndex(face->stream, 0))) {
         LV_LOG_ERROR("tiny_ttf: init failed\n");
-        goto err_after_dsc;
+        goto err_after_face;
     }
 #endif
+    stbtt_GetFontVMetrics(&face->info, &face->ascent, &face->descent, &face->line_gap);
 
-    dsc->bitmap_cache = lv_lru_create(cache_size, font_size * font_size, lv_mem_free, lv_mem_free);
-    if(dsc->bitmap_cache == NULL) {
-        LV_LOG_ERROR("failed to create lru cache");
-        goto err_after_dsc;
-    }
-
-    lv_font_t * out_font = (lv_font_t *)TTF_MALLOC(sizeof(lv_font_t));
+    lv_font_t * out_font = ttf_font_create(face, font_size);
     if(out_font == NULL) {
-        LV_LOG_ERROR("tiny_ttf: out of memory\n");
-        goto err_after_bitmap_cache;
+        face->ref_cnt = 1;
+        ttf_face_release(face);
     }
-    lv_memset(out_font, 0, sizeof(lv_font_t));
-    out_font->get_glyph_dsc = ttf_get_glyph_dsc_cb;
-    out_font->get_glyph_bitmap = ttf_get_glyph_bitmap_cb;
-    out_font->dsc = dsc;
-    lv_tiny_ttf_set_size(out_font, font_size);
     return out_font;
-err_after_bitmap_cache:
-    lv_lru_del(dsc->bitmap_cache);
-err_after_dsc:
-    TTF_FREE(dsc);
+err_after_face:
+    TTF_FREE(face);
     return NULL;
 }
 #if LV_TINY_TTF_FILE_SUPPORT
 lv_font_t * lv_tiny_ttf_create_file_ex(const char * path, lv_coord_t font_size, size_t cache_size)
 {
-    return lv_tiny_ttf_create(path, NULL, 0, font_size, cache_size);
+    LV_UNUSED(cache_size);
+    return lv_tiny_ttf_create(path, NULL, 0, font_size);
 }
 lv_font_t * lv_tiny_ttf_create_file(const char * path, lv_coord_t font_size)
 {
-    return lv_tiny_ttf_create_file_ex(path, font_size, 4096);
+    return lv_tiny_ttf_create(path, NULL, 0, font_size);
 }
 #endif /*LV_TINY_TTF_FILE_SUPPORT*/
 lv_font_t * lv_tiny_ttf_create_data_ex(const void * data, size_t data_size, lv_coord_t font_size, size_t cache_size)
 {
-    return lv_tiny_ttf_create(NULL, data, data_size, font_size, cache_size);
+    LV_UNUSED(cache_size);
+    return lv_tiny_ttf_create(NULL, data, data_size, font_size);
 }
 lv_font_t * lv_tiny_ttf_create_data(const void * data, size_t data_size, lv_coord_t font_size)
 {
-    return lv_tiny_ttf_create_data_ex(data, data_size, font_size, 4096);
+    return lv_tiny_ttf_create(NULL, data, data_size, font_size);
+}
+lv_font_t * lv_tiny_ttf_create_size(const lv_font_t * font, lv_coord_t font_size)
+{
+    if(font == NULL || font->dsc == NULL || 0 >= font_size) {
+        LV_LOG_ERROR("tiny_ttf: invalid argument\n");
+        return NULL;
+    }
+    return ttf_font_create(((const ttf_font_desc_t *)font->dsc)->face, font_size);
 }
 void lv_tiny_ttf_set_size(lv_font_t * font, lv_coord_t font_size)
 {
@@ -258,27 +550,62 @@ void lv_tiny_ttf_set_size(lv_font_t * font, lv_coord_t font_size)
         LV_LOG_ERROR("invalid font size: %"PRIx32, font_size);
         return;
     }
+    lv_draw_sw_glyph_cache_invalidate_font(font);
+    ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
+    ttf_face_t * face = dsc->face;
+    /*The glyphs of the old size stay cached for the other fonts of that size*/
+    dsc->font_size = font_size;
+    dsc->scale = stbtt_ScaleForMappingEmToPixels(&face->info, font_size);
+    font->line_height = (lv_coord_t)(dsc->scale * (face->ascent - face->descent + face->line_gap));
+    font->base_line = (lv_coord_t)(dsc->scale * (face->line_gap - face->descent));
+}
+uint32_t lv_tiny_ttf_warm_up(lv_font_t * font, const char * text)
+{
+    if(font == NULL || text == NULL) return 0;
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
-    dsc->scale = stbtt_ScaleForMappingEmToPixels(&dsc->info, font_size);
-    int line_gap = 0;
-    stbtt_GetFontVMetrics(&dsc->info, &dsc->ascent, &dsc->descent, &line_gap);
-    font->line_height = (lv_coord_t)(dsc->scale * (dsc->ascent - dsc->descent + line_gap));
-    font->base_line = (lv_coord_t)(dsc->scale * (line_gap - dsc->descent));
+    uint32_t misses = stats.misses;
+    uint32_t i = 0;
+    while(text[i] != '\0') {
+        uint32_t letter = _lv_txt_encoded_next(text, &i);
+        if(letter < 0x20) continue;
+        bool cached;
+        glyph_entry_t * entry = glyph_get(dsc, letter, &cached);
+        if(entry->glyph != 0 && entry->bitmap == NULL) glyph_rasterise(dsc, entry);
+    }
+    return stats.misses - misses;
 }
 void lv_tiny_ttf_destroy(lv_font_t * font)
 {
     if(font != NULL) {
+        lv_draw_sw_glyph_cache_invalidate_font(font);
         if(font->dsc != NULL) {
             ttf_font_desc_t * ttf = (ttf_font_desc_t *)font->dsc;
-#if LV_TINY_TTF_FILE_SUPPORT
-            if(ttf->stream.file != NULL) {
-                lv_fs_close(&ttf->file);
-            }
-#endif
-            lv_lru_del(ttf->bitmap_cache);
+            ttf_face_release(ttf->face);
             TTF_FREE(ttf);
         }
         TTF_FREE(font);
     }
 }
+void lv_tiny_ttf_cache_set_budget(uint32_t bytes)
+{
+    budget = bytes;
+    cache_trim(budget, NULL);
+}
+void lv_tiny_ttf_get_stats(lv_tiny_ttf_stats_t * stats_out)
+{
+    *stats_out = stats;
+    stats_out->budget = budget;
+}
+void lv_tiny_ttf_reset_stats(void)
+{
+    stats.hits = 0;
+    stats.misses = 0;
+    stats.metric_hits = 0;
+    stats.metric_misses = 0;
+    stats.evictions = 0;
+    stats.raster_us = 0;
+    stats.raster_us_max = 0;
+    stats.page_reads = 0;
+    stats.bytes_read = 0;
+}
 #endif /*LV_USE_TINY_TTF*/
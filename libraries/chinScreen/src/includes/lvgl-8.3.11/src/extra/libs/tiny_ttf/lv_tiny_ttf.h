@@ -25,30 +25,68 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/*Glyphs rasterised on demand are kept in one cache shared by every font and size*/
+typedef struct {
+    uint32_t hits;          /*Glyph bitmaps found in the cache*/
+    uint32_t misses;        /*Glyph bitmaps rasterised*/
+    uint32_t metric_hits;   /*Glyph metrics for the text layout found in the cache*/
+    uint32_t metric_misses; /*Glyph metrics read from the font*/
+    uint32_t evictions;     /*Glyphs dropped to make room; destroying a font is not counted*/
+    uint32_t glyph_cnt;     /*Glyphs cached now, with or without a bitmap*/
+    uint32_t bytes;         /*Their size with the bookkeeping*/
+    uint32_t budget;        /*Limit of `bytes`*/
+    uint32_t raster_us;     /*Time spent rasterising the `misses`*/
+    uint32_t raster_us_max; /*The slowest glyph*/
+    uint32_t page_reads;    /*Pages of font files read*/
+    uint32_t bytes_read;    /*Bytes of font files read*/
+} lv_tiny_ttf_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
 #if LV_TINY_TTF_FILE_SUPPORT
-/* create a font from the specified file or path with the specified line height.*/
+/* create a font from the specified file or path with the specified line height.
+ * the file isn't read into memory: LV_TINY_TTF_PAGE_CNT pages of it are kept and read again when needed*/
 lv_font_t * lv_tiny_ttf_create_file(const char * path, lv_coord_t font_size);
 
-/* create a font from the specified file or path with the specified line height with the specified cache size.*/
+/* create a font from the specified file or path with the specified line height.
+ * cache_size is ignored: the glyphs go to the cache shared by every font, see lv_tiny_ttf_cache_set_budget()*/
 lv_font_t * lv_tiny_ttf_create_file_ex(const char * path, lv_coord_t font_size, size_t cache_size);
 #endif /*LV_TINY_TTF_FILE_SUPPORT*/
 
-/* create a font from the specified data pointer with the specified line height.*/
+/* create a font from the specified data pointer with the specified line height.
+ * the data isn't copied, it can be in flash or a memory mapped partition and has to be kept while the font is used*/
 lv_font_t * lv_tiny_ttf_create_data(const void * data, size_t data_size, lv_coord_t font_size);
 
-/* create a font from the specified data pointer with the specified line height and the specified cache size.*/
+/* create a font from the specified data pointer with the specified line height.
+ * cache_size is ignored: the glyphs go to the cache shared by every font, see lv_tiny_ttf_cache_set_budget()*/
 lv_font_t * lv_tiny_ttf_create_data_ex(const void * data, size_t data_size, lv_coord_t font_size, size_t cache_size);
 
+/* create a font of another size from the file or data of a font, without opening or parsing it again.
+ * the fonts can be destroyed in any order*/
+lv_font_t * lv_tiny_ttf_create_size(const lv_font_t * font, lv_coord_t font_size);
+
 /* set the size of the font to a new font_size*/
 void lv_tiny_ttf_set_size(lv_font_t * font, lv_coord_t font_size);
 
+/* rasterise the letters of an UTF-8 text into the glyph cache, e.g. the digits and units of a dashboard
+ * before it's shown. returns the number of glyphs rasterised, the ones already cached aren't counted*/
+uint32_t lv_tiny_ttf_warm_up(lv_font_t * font, const char * text);
+
 /* destroy a font previously created with lv_tiny_ttf_create_xxxx()*/
 void lv_tiny_ttf_destroy(lv_font_t * font);
 
+/* set how many bytes the cached glyphs of every font may use, LV_TINY_TTF_CACHE_DEF_BYTES by default.
+ * they are allocated with `LV_IMG_CACHE_ALLOC`, 0 rasterises every glyph when it's drawn*/
+void lv_tiny_ttf_cache_set_budget(uint32_t bytes);
+
+/* get the counters and the fill of the glyph cache*/
+void lv_tiny_ttf_get_stats(lv_tiny_ttf_stats_t * stats);
+
+/* clear the counters of the glyph cache*/
+void lv_tiny_ttf_reset_stats(void);
+
 /**********************
  *      MACROS
  **********************/
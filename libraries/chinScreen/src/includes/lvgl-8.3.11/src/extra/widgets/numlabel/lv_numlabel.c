@@ -0,0 +1,577 @@
+/**
+ * @file lv_numlabel.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_numlabel.h"
+#if LV_USE_NUMLABEL
+
+#include "../../../misc/lv_assert.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MY_CLASS &lv_numlabel_class
+
+#define FLAG_LEFT       0x01    /*'-'*/
+#define FLAG_PLUS       0x02    /*'+'*/
+#define FLAG_SPACE      0x04    /*' '*/
+#define FLAG_ZERO       0x08    /*'0'*/
+
+#define PRECISION_MAX   9
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void lv_numlabel_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_numlabel_event(const lv_obj_class_t * class_p, lv_event_t * e);
+static void draw_main(lv_event_t * e);
+static const char * parse_conversion(lv_numlabel_t * numlabel, const char * fmt);
+static uint32_t format_value(const lv_numlabel_t * numlabel, bool is_float, int32_t ivalue, float fvalue,
+                             char * buf);
+static void show_value(lv_obj_t * obj, const char * value, uint32_t len);
+static void invalidate_cells(lv_obj_t * obj, uint32_t start, uint32_t end);
+static void refr_metrics(lv_obj_t * obj);
+static lv_coord_t run_width(const lv_font_t * font, const char * txt, uint32_t len, lv_coord_t letter_space);
+static lv_coord_t text_width(const lv_numlabel_t * numlabel, lv_coord_t letter_space);
+static lv_coord_t text_x(lv_obj_t * obj, const lv_area_t * content, lv_coord_t letter_space);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+const lv_obj_class_t lv_numlabel_class = {
+    .constructor_cb = lv_numlabel_constructor,
+    .event_cb = lv_numlabel_event,
+    .width_def = LV_SIZE_CONTENT,
+    .height_def = LV_SIZE_CONTENT,
+    .instance_size = sizeof(lv_numlabel_t),
+    .base_class = &lv_obj_class
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_obj_t * lv_numlabel_create(lv_obj_t * parent)
+{
+    LV_LOG_INFO("begin");
+    lv_obj_t * obj = lv_obj_class_create_obj(MY_CLASS, parent);
+    lv_obj_class_init_obj(obj);
+    return obj;
+}
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+void lv_numlabel_set_format(lv_obj_t * obj, const char * fmt)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    LV_ASSERT_NULL(fmt);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    lv_obj_invalidate(obj);
+    numlabel->conv = 0;
+    numlabel->flags = 0;
+    numlabel->width = 0;
+    numlabel->precision = -1;
+    numlabel->value_ofs = 0;
+    numlabel->value_len = 0;
+
+    /*Keep room for the longest number*/
+    const uint32_t max = LV_NUMLABEL_TEXT_MAX - 1 - LV_NUMLABEL_VALUE_MAX;
+    uint32_t len = 0;
+    while(*fmt) {
+        char c = *fmt;
+        if(fmt[0] == '%' && fmt[1] == '%') {
+            fmt += 2;
+        }
+        else if(fmt[0] == '%') {
+            if(numlabel->conv) {
+                LV_LOG_WARN("only one number can be in the format");
+                len = 0;
+                numlabel->conv = 0;
+                break;
+            }
+            fmt = parse_conversion(numlabel, fmt + 1);
+            if(fmt == NULL) {
+                LV_LOG_WARN("unsupported conversion in the format");
+                len = 0;
+                numlabel->conv = 0;
+                break;
+            }
+            numlabel->value_ofs = (uint8_t)len;
+            continue;
+        }
+        else {
+            fmt++;
+        }
+
+        if(len == max) {
+            LV_LOG_WARN("the format is too long, the end is cut");
+            break;
+        }
+        numlabel->text[len++] = c;
+    }
+    numlabel->text[len] = '\0';
+    if(numlabel->conv == 0) numlabel->value_ofs = 0;
+
+    refr_metrics(obj);
+    if(numlabel->conv) lv_numlabel_set_value(obj, 0);
+    lv_obj_refresh_self_size(obj);
+    lv_obj_invalidate(obj);
+}
+
+void lv_numlabel_set_value(lv_obj_t * obj, int32_t value)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    if(numlabel->conv == 0) return;
+
+    char buf[LV_NUMLABEL_VALUE_MAX];
+    uint32_t len = format_value(numlabel, false, value, 0, buf);
+    show_value(obj, buf, len);
+}
+
+void lv_numlabel_set_value_float(lv_obj_t * obj, float value)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    if(numlabel->conv == 0) return;
+
+    char buf[LV_NUMLABEL_VALUE_MAX];
+    uint32_t len = format_value(numlabel, true, 0, value, buf);
+    show_value(obj, buf, len);
+}
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+const char * lv_numlabel_get_text(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    return numlabel->text;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void lv_numlabel_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    LV_TRACE_OBJ_CREATE("begin");
+
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    numlabel->text[0] = '\0';
+    numlabel->conv = 0;
+    numlabel->precision = -1;
+
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+
+    LV_TRACE_OBJ_CREATE("finished");
+}
+
+static void lv_numlabel_event(const lv_obj_class_t * class_p, lv_event_t * e)
+{
+    LV_UNUSED(class_p);
+
+    lv_res_t res;
+
+    /*Call the ancestor's event handler*/
+    res = lv_obj_event_base(MY_CLASS, e);
+    if(res != LV_RES_OK) return;
+
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    if(code == LV_EVENT_STYLE_CHANGED) {
+        refr_metrics(obj);
+        lv_obj_refresh_self_size(obj);
+        lv_obj_invalidate(obj);
+    }
+    else if(code == LV_EVENT_REFR_EXT_DRAW_SIZE) {
+        /*The same room for italic letters as lv_label, or more if a digit reaches out of its cell*/
+        const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+        lv_coord_t font_h = lv_font_get_line_height(font);
+        lv_event_set_ext_draw_size(e, LV_MAX(font_h / 4, numlabel->cell_pad));
+    }
+    else if(code == LV_EVENT_GET_SELF_SIZE) {
+        const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+        lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+        lv_point_t * self_size = lv_event_get_param(e);
+        self_size->x = LV_MAX(self_size->x, text_width(numlabel, letter_space));
+        self_size->y = LV_MAX(self_size->y, lv_font_get_line_height(font));
+    }
+    else if(code == LV_EVENT_DRAW_MAIN) {
+        draw_main(e);
+    }
+}
+
+static void draw_main(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
+    if(numlabel->text[0] == '\0') return;
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &dsc);
+    if(dsc.opa <= LV_OPA_MIN) return;
+
+    lv_area_t content;
+    lv_obj_get_content_coords(obj, &content);
+    const lv_coord_t step = numlabel->cell_w + dsc.letter_space;
+    const lv_coord_t value_x = text_x(obj, &content, dsc.letter_space) + numlabel->prefix_w;
+    const lv_area_t * clip = draw_ctx->clip_area;
+    lv_point_t pos;
+    pos.y = content.y1;
+
+    /*The text around the number, letter by letter like lv_txt_get_width() measures it*/
+    const char * runs[2] = {numlabel->text, &numlabel->text[numlabel->value_ofs + numlabel->value_len]};
+    const uint32_t run_lens[2] = {numlabel->value_ofs, (uint32_t)strlen(runs[1])};
+    const lv_coord_t run_x[2] = {value_x - numlabel->prefix_w, value_x + numlabel->value_len * step};
+    uint32_t r;
+    for(r = 0; r < 2; r++) {
+        pos.x = run_x[r];
+        uint32_t i = 0;
+        while(i < run_lens[r]) {
+            uint32_t letter = _lv_txt_encoded_next(runs[r], &i);
+            uint32_t letter_next = 0;
+            if(i < run_lens[r]) {
+                uint32_t j = i;
+                letter_next = _lv_txt_encoded_next(runs[r], &j);
+            }
+            lv_draw_letter(draw_ctx, &dsc, &pos, letter);
+            pos.x += lv_font_get_glyph_width(dsc.font, letter, letter_next) + dsc.letter_space;
+        }
+    }
+
+    /*The number, centered in its cells. Only the cells in the clip area, usually the ones that changed.*/
+    const char * value = &numlabel->text[numlabel->value_ofs];
+    uint32_t i;
+    for(i = 0; i < numlabel->value_len; i++) {
+        lv_coord_t x = value_x + (lv_coord_t)i * step;
+        if(x + numlabel->cell_w + numlabel->cell_pad <= clip->x1 || x - numlabel->cell_pad > clip->x2) continue;
+        uint32_t letter = (uint8_t)value[i];
+        pos.x = x + (numlabel->cell_w - lv_font_get_glyph_width(dsc.font, letter, 0)) / 2;
+        lv_draw_letter(draw_ctx, &dsc, &pos, letter);
+    }
+}
+
+/**
+ * Parse a conversion of the format
+ * @param numlabel  the flags, width, precision and conversion are stored here
+ * @param fmt       the conversion after the '%'
+ * @return          the format after the conversion, NULL if it's not supported
+ */
+static const char * parse_conversion(lv_numlabel_t * numlabel, const char * fmt)
+{
+    while(1) {
+        if(*fmt == '-') numlabel->flags |= FLAG_LEFT;
+        else if(*fmt == '+') numlabel->flags |= FLAG_PLUS;
+        else if(*fmt == ' ') numlabel->flags |= FLAG_SPACE;
+        else if(*fmt == '0') numlabel->flags |= FLAG_ZERO;
+        else break;
+        fmt++;
+    }
+
+    uint32_t width = 0;
+    while(*fmt >= '0' && *fmt <= '9') width = width * 10 + (*fmt++ - '0');
+    numlabel->width = (uint8_t)LV_MIN(width, LV_NUMLABEL_VALUE_MAX);
+
+    if(*fmt == '.') {
+        fmt++;
+        uint32_t precision = 0;
+        while(*fmt >= '0' && *fmt <= '9') precision = precision * 10 + (*fmt++ - '0');
+        numlabel->precision = (int8_t)LV_MIN(precision, PRECISION_MAX);
+    }
+
+    while(*fmt == 'l' || *fmt == 'h') fmt++;
+
+    switch(*fmt) {
+        case 'd':
+        case 'i':
+            numlabel->conv = 'd';
+            break;
+        case 'u':
+        case 'x':
+        case 'X':
+            numlabel->conv = *fmt;
+            break;
+        case 'f':
+        case 'F':
+            numlabel->conv = 'f';
+            break;
+        default:
+            return NULL;
+    }
+    return fmt + 1;
+}
+
+/**
+ * Write a value the way `printf()` would with the conversion of the format
+ * @return          the characters written to `buf`, at most LV_NUMLABEL_VALUE_MAX
+ */
+static uint32_t format_value(const lv_numlabel_t * numlabel, bool is_float, int32_t ivalue, float fvalue,
+                             char * buf)
+{
+    static const uint32_t powers[PRECISION_MAX + 1] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+    };
+    char body[LV_NUMLABEL_VALUE_MAX];   /*Digits in reverse order*/
+    uint32_t n = 0;
+    bool neg = false;
+    bool special = false;
+
+    if(numlabel->conv == 'f') {
+        uint32_t precision = numlabel->precision < 0 ? 6 : numlabel->precision;
+        uint64_t mag = 0;
+        if(!is_float) {
+            neg = ivalue < 0;
+            mag = (uint64_t)(neg ? -(int64_t)ivalue : ivalue) * powers[precision];
+        }
+        else if(fvalue != fvalue) {
+            special = true;
+            body[n++] = 'n';
+            body[n++] = 'a';
+            body[n++] = 'n';
+        }
+        else {
+            neg = fvalue < 0;
+            /*The product is exact in a double, so ties round to even like printf() does*/
+            double scaled = (double)(neg ? -fvalue : fvalue) * powers[precision];
+            if(scaled >= 1e18) {
+                special = true;
+                body[n++] = 'f';
+                body[n++] = 'n';
+                body[n++] = 'i';
+            }
+            else {
+                mag = (uint64_t)scaled;
+                double frac = scaled - (double)mag;
+                if(frac > 0.5 || (frac == 0.5 && (mag & 1))) mag++;
+            }
+        }
+
+        if(!special) {
+            uint32_t i;
+            for(i = 0; i < precision; i++) {
+                body[n++] = (char)('0' + mag % 10);
+                mag /= 10;
+            }
+            if(precision) body[n++] = '.';
+            do {
+                body[n++] = (char)('0' + mag % 10);
+                mag /= 10;
+            } while(mag);
+        }
+    }
+    else {
+        if(is_float) {
+            if(fvalue != fvalue) ivalue = 0;
+            else if(fvalue >= 2147483647.0f) ivalue = INT32_MAX;
+            else if(fvalue <= -2147483648.0f) ivalue = INT32_MIN;
+            else ivalue = (int32_t)(fvalue < 0 ? fvalue - 0.5f : fvalue + 0.5f);
+        }
+
+        uint32_t mag = (uint32_t)ivalue;
+        if(numlabel->conv == 'd' && ivalue < 0) {
+            neg = true;
+            mag = 0 - mag;
+        }
+        const uint32_t base = numlabel->conv == 'x' || numlabel->conv == 'X' ? 16 : 10;
+        const char * digits = numlabel->conv == 'X' ? "0123456789ABCDEF" : "0123456789abcdef";
+        /*The precision is the minimum number of digits, 0 prints nothing for 0*/
+        const uint32_t min_digits = numlabel->precision < 0 ? 1 : numlabel->precision;
+        while(mag || n < min_digits) {
+            body[n++] = digits[mag % base];
+            mag /= base;
+        }
+    }
+
+    char sign = 0;
+    if(numlabel->conv == 'd' || numlabel->conv == 'f') {
+        if(neg) sign = '-';
+        else if(numlabel->flags & FLAG_PLUS) sign = '+';
+        else if(numlabel->flags & FLAG_SPACE) sign = ' ';
+    }
+
+    /*'0' pads between the sign and the digits, but not with '-', nan, inf or a precision of an integer*/
+    const uint32_t len = n + (sign ? 1 : 0);
+    const uint32_t pad = numlabel->width > len ? numlabel->width - len : 0;
+    const bool zeros = (numlabel->flags & FLAG_ZERO) && !(numlabel->flags & FLAG_LEFT) && !special &&
+                       (numlabel->conv == 'f' || numlabel->precision < 0);
+    uint32_t out = 0;
+    uint32_t i;
+    if(!zeros && !(numlabel->flags & FLAG_LEFT)) {
+        for(i = 0; i < pad; i++) buf[out++] = ' ';
+    }
+    if(sign) buf[out++] = sign;
+    if(zeros) {
+        for(i = 0; i < pad; i++) buf[out++] = '0';
+    }
+    while(n) buf[out++] = body[--n];
+    if(numlabel->flags & FLAG_LEFT) {
+        for(i = 0; i < pad; i++) buf[out++] = ' ';
+    }
+    return out;
+}
+
+/**
+ * Show a new number: only the cells whose character changed are redrawn. The label is laid
+ * out again only if the number has another number of characters.
+ */
+static void show_value(lv_obj_t * obj, const char * value, uint32_t len)
+{
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    char * cur = &numlabel->text[numlabel->value_ofs];
+
+    if(len == numlabel->value_len) {
+        uint32_t i = 0;
+        while(i < len) {
+            if(cur[i] == value[i]) {
+                i++;
+                continue;
+            }
+            uint32_t start = i;
+            while(i < len && cur[i] != value[i]) {
+                cur[i] = value[i];
+                i++;
+            }
+            invalidate_cells(obj, start, i);
+        }
+        return;
+    }
+
+    lv_obj_invalidate(obj);
+    char * suffix = cur + numlabel->value_len;
+    memmove(cur + len, suffix, strlen(suffix) + 1);
+    lv_memcpy_small(cur, value, len);
+    numlabel->value_len = (uint8_t)len;
+    lv_obj_refresh_self_size(obj);
+    lv_obj_invalidate(obj);
+}
+
+/**
+ * Invalidate the cells of the number from `start` to `end` (exclusive)
+ */
+static void invalidate_cells(lv_obj_t * obj, uint32_t start, uint32_t end)
+{
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    const lv_coord_t step = numlabel->cell_w + letter_space;
+
+    lv_area_t content;
+    lv_obj_get_content_coords(obj, &content);
+    lv_coord_t x = text_x(obj, &content, letter_space) + numlabel->prefix_w;
+
+    lv_area_t area;
+    area.x1 = x + (lv_coord_t)start * step - numlabel->cell_pad;
+    area.x2 = x + (lv_coord_t)end * step - letter_space - 1 + numlabel->cell_pad;
+    area.y1 = content.y1 - numlabel->cell_pad;
+    area.y2 = content.y1 + lv_font_get_line_height(font) - 1 + numlabel->cell_pad;
+    lv_obj_invalidate_area(obj, &area);
+}
+
+/**
+ * Measure the text around the number and the cells of the number in the current font
+ */
+static void refr_metrics(lv_obj_t * obj)
+{
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+
+    const char * suffix = &numlabel->text[numlabel->value_ofs + numlabel->value_len];
+    numlabel->prefix_w = run_width(font, numlabel->text, numlabel->value_ofs, letter_space);
+    numlabel->suffix_w = run_width(font, suffix, strlen(suffix), letter_space);
+    numlabel->cell_w = 0;
+    numlabel->cell_pad = 0;
+    if(numlabel->conv == 0) return;
+
+    const char * cells;
+    if(numlabel->conv == 'x') cells = "0123456789abcdef";
+    else if(numlabel->conv == 'X') cells = "0123456789ABCDEF";
+    else cells = "0123456789+-.";
+
+    const char * c;
+    for(c = cells; *c; c++) {
+        numlabel->cell_w = LV_MAX(numlabel->cell_w, lv_font_get_glyph_width(font, (uint8_t)*c, 0));
+    }
+
+    /*Glyphs reaching out of their cell, like lv_draw_sw_letter() places them*/
+    const lv_coord_t line_h = lv_font_get_line_height(font);
+    for(c = cells; *c; c++) {
+        lv_font_glyph_dsc_t g;
+        if(!lv_font_get_glyph_dsc(font, &g, (uint8_t)*c, 0) || g.box_w == 0) continue;
+        lv_coord_t left = (numlabel->cell_w - g.adv_w) / 2 + g.ofs_x;
+        lv_coord_t top = (font->line_height - font->base_line) - g.box_h - g.ofs_y;
+        numlabel->cell_pad = LV_MAX(numlabel->cell_pad, -left);
+        numlabel->cell_pad = LV_MAX(numlabel->cell_pad, left + g.box_w - numlabel->cell_w);
+        numlabel->cell_pad = LV_MAX(numlabel->cell_pad, -top);
+        numlabel->cell_pad = LV_MAX(numlabel->cell_pad, top + g.box_h - line_h);
+    }
+}
+
+/**
+ * Width of a part of the text with a letter space after every letter. The last letter isn't
+ * kerned with the next one, so the part keeps its width whatever follows it.
+ */
+static lv_coord_t run_width(const lv_font_t * font, const char * txt, uint32_t len, lv_coord_t letter_space)
+{
+    lv_coord_t w = 0;
+    uint32_t i = 0;
+    while(i < len) {
+        uint32_t letter = _lv_txt_encoded_next(txt, &i);
+        uint32_t letter_next = 0;
+        if(i < len) {
+            uint32_t j = i;
+            letter_next = _lv_txt_encoded_next(txt, &j);
+        }
+        w += lv_font_get_glyph_width(font, letter, letter_next) + letter_space;
+    }
+    return w;
+}
+
+static lv_coord_t text_width(const lv_numlabel_t * numlabel, lv_coord_t letter_space)
+{
+    lv_coord_t w = numlabel->prefix_w + numlabel->value_len * (numlabel->cell_w + letter_space) + numlabel->suffix_w;
+    /*No letter space after the last letter*/
+    return w > 0 ? w - letter_space : 0;
+}
+
+/**
+ * X coordinate of the first letter, by the text align of the label
+ */
+static lv_coord_t text_x(lv_obj_t * obj, const lv_area_t * content, lv_coord_t letter_space)
+{
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    lv_text_align_t align = lv_obj_get_style_text_align(obj, LV_PART_MAIN);
+    if(align == LV_TEXT_ALIGN_CENTER) {
+        return content->x1 + (lv_area_get_width(content) - text_width(numlabel, letter_space)) / 2;
+    }
+    if(align == LV_TEXT_ALIGN_RIGHT) {
+        return content->x2 + 1 - text_width(numlabel, letter_space);
+    }
+    return content->x1;
+}
+
+#endif /*LV_USE_NUMLABEL*/
@@ -0,0 +1,111 @@
+/**
+ * @file lv_numlabel.h
+ *
+ * A label showing one number in a fixed format, like "Temp: %5.1f°C".
+ * Every character of the number has a cell as wide as the widest digit, so a new value
+ * redraws only the cells whose character changed and the label is laid out again only
+ * if the number of characters changes. Updates don't allocate memory.
+ */
+
+#ifndef LV_NUMLABEL_H
+#define LV_NUMLABEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+
+#if LV_USE_NUMLABEL
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_NUMLABEL_TEXT_MAX    64      /*Bytes of the text with the number and the '\0'*/
+#define LV_NUMLABEL_VALUE_MAX   24      /*Characters of the number at most, the width of the format too*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Data of numeric label*/
+typedef struct {
+    lv_obj_t obj;
+    char text[LV_NUMLABEL_TEXT_MAX];    /*The text before, the number and the text after it*/
+    lv_coord_t prefix_w;                /*Width of the text before the number, with letter spaces*/
+    lv_coord_t suffix_w;                /*Width of the text after the number, with letter spaces*/
+    lv_coord_t cell_w;                  /*Width of a character of the number, the widest one*/
+    lv_coord_t cell_pad;                /*How far a glyph of the number can reach out of its cell*/
+    uint8_t value_ofs;                  /*Byte index of the number in `text`*/
+    uint8_t value_len;                  /*Characters of the number, one byte each*/
+    uint8_t width;                      /*Minimum characters of the number, from the format*/
+    int8_t precision;                   /*Digits after the point, -1 if the format has none*/
+    uint8_t flags;                      /*'-', '+', ' ' and '0' of the format*/
+    char conv;                          /*'d', 'u', 'x', 'X' or 'f', 0 if there is no number*/
+} lv_numlabel_t;
+
+extern const lv_obj_class_t lv_numlabel_class;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a numeric label object
+ * @param parent    pointer to an object, it will be the parent of the new label
+ * @return          pointer to the created label
+ */
+lv_obj_t * lv_numlabel_create(lv_obj_t * parent);
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+/**
+ * Set the format of the label. It takes one conversion of `printf()`: `%d`, `%i`, `%u`, `%x`, `%X`
+ * or `%f` with the flags `-`, `+`, ` ` and `0`, a width and a precision. `l` and `h` are ignored so
+ * `PRId32` works. `%%` is a percent sign. The label shows 0 until a value is set.
+ * @param obj       pointer to a numeric label
+ * @param fmt       the format, copied. The text around the number can be UTF-8.
+ */
+void lv_numlabel_set_format(lv_obj_t * obj, const char * fmt);
+
+/**
+ * Set the number shown
+ * @param obj       pointer to a numeric label
+ * @param value     the new value
+ */
+void lv_numlabel_set_value(lv_obj_t * obj, int32_t value);
+
+/**
+ * Set the number shown, rounded to the precision of the format
+ * @param obj       pointer to a numeric label
+ * @param value     the new value
+ */
+void lv_numlabel_set_value_float(lv_obj_t * obj, float value);
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+/**
+ * Get the text of the label
+ * @param obj       pointer to a numeric label
+ * @return          the text shown, with the number
+ */
+const char * lv_numlabel_get_text(const lv_obj_t * obj);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_NUMLABEL*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_NUMLABEL_H*/
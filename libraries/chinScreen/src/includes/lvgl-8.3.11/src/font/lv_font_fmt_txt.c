@@ -32,6 +32,9 @@ typedef enum {
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static const uint8_t * get_glyph_bitmap(const lv_font_t * font, uint32_t gid);
+static void glyph_dsc_fill(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t gid, int8_t kvalue,
+                           bool is_tab);
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
@@ -80,10 +83,104 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
 {
     if(unicode_letter == '\t') unicode_letter = ' ';
 
+    return get_glyph_bitmap(font, get_glyph_dsc_id(font, unicode_letter));
+}
+
+/**
+ * Used as `get_glyph_dsc` callback in LittelvGL's native font format if the font is uncompressed.
+ * @param font_p pointer to font
+ * @param dsc_out store the result descriptor here
+ * @param letter a UNICODE letter code
+ * @return true: descriptor is successfully loaded into `dsc_out`.
+ *         false: the letter was not found, no data is loaded to `dsc_out`
+ */
+bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
+                                   uint32_t unicode_letter_next)
+{
+    /*It fixes a strange compiler optimization issue: https://github.com/lvgl/lvgl/issues/4370*/
+    bool is_tab = unicode_letter == '\t';
+    if(is_tab) {
+        unicode_letter = ' ';
+    }
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
     uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
+    if(!gid) return false;
+
+    int8_t kvalue = 0;
+    if(fdsc->kern_dsc) {
+        uint32_t gid_next = get_glyph_dsc_id(font, unicode_letter_next);
+        if(gid_next) {
+            kvalue = get_kern_value(font, gid, gid_next);
+        }
+    }
+
+    glyph_dsc_fill(font, dsc_out, gid, kvalue, is_tab);
+    return true;
+}
+
+const uint8_t * lv_font_get_bitmap_fmt_txt_lut(const lv_font_t * font, uint32_t letter,
+                                               const lv_font_fmt_txt_lut_t * lut)
+{
+    if(letter == '\t') letter = ' ';
+
+    uint32_t gid = letter < lut->range ? lut->glyph_ids[letter] : get_glyph_dsc_id(font, letter);
+    return get_glyph_bitmap(font, gid);
+}
+
+bool lv_font_get_glyph_dsc_fmt_txt_lut(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
+                                       uint32_t unicode_letter_next, const lv_font_fmt_txt_lut_t * lut)
+{
+    bool is_tab = unicode_letter == '\t';
+    if(is_tab) {
+        unicode_letter = ' ';
+    }
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    uint32_t gid = unicode_letter < lut->range ? lut->glyph_ids[unicode_letter] : get_glyph_dsc_id(font, unicode_letter);
+    if(!gid) return false;
+
+    int8_t kvalue = 0;
+    if(fdsc->kern_dsc) {
+        if(lut->kern_left && unicode_letter < lut->range && unicode_letter_next < lut->range) {
+            uint8_t left = lut->kern_left[unicode_letter];
+            uint8_t right = lut->kern_right[unicode_letter_next];
+            if(left && right) kvalue = lut->kern_values[(left - 1) * lut->kern_right_cnt + (right - 1)];
+        }
+        else {
+            uint32_t gid_next = unicode_letter_next < lut->range ? lut->glyph_ids[unicode_letter_next] :
+                                get_glyph_dsc_id(font, unicode_letter_next);
+            if(gid_next) {
+                kvalue = get_kern_value(font, gid, gid_next);
+            }
+        }
+    }
+
+    glyph_dsc_fill(font, dsc_out, gid, kvalue, is_tab);
+    return true;
+}
+
+/**
+ * Free the allocated memories.
+ */
+void _lv_font_clean_up_fmt_txt(void)
+{
+#if LV_USE_FONT_COMPRESSED
+    if(LV_GC_ROOT(_lv_font_decompr_buf)) {
+        lv_mem_free(LV_GC_ROOT(_lv_font_decompr_buf));
+        LV_GC_ROOT(_lv_font_decompr_buf) = NULL;
+    }
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static const uint8_t * get_glyph_bitmap(const lv_font_t * font, uint32_t gid)
+{
     if(!gid) return NULL;
 
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+
     const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
 
     if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
@@ -138,34 +235,14 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
 }
 
 /**
- * Used as `get_glyph_dsc` callback in LittelvGL's native font format if the font is uncompressed.
- * @param font_p pointer to font
- * @param dsc_out store the result descriptor here
- * @param letter a UNICODE letter code
- * @return true: descriptor is successfully loaded into `dsc_out`.
- *         false: the letter was not found, no data is loaded to `dsc_out`
+ * Put together the descriptor of a glyph
+ * @param kvalue    the kerning with the next letter, 4.4 format
+ * @param is_tab    the glyph is a space drawn for a tab, twice as wide
  */
-bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
-                                   uint32_t unicode_letter_next)
+static void glyph_dsc_fill(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t gid, int8_t kvalue,
+                           bool is_tab)
 {
-    /*It fixes a strange compiler optimization issue: https://github.com/lvgl/lvgl/issues/4370*/
-    bool is_tab = unicode_letter == '\t';
-    if(is_tab) {
-        unicode_letter = ' ';
-    }
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
-    uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
-    if(!gid) return false;
-
-    int8_t kvalue = 0;
-    if(fdsc->kern_dsc) {
-        uint32_t gid_next = get_glyph_dsc_id(font, unicode_letter_next);
-        if(gid_next) {
-            kvalue = get_kern_value(font, gid, gid_next);
-        }
-    }
-
-    /*Put together a glyph dsc*/
     const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
 
     int32_t kv = ((int32_t)((int32_t)kvalue * fdsc->kern_scale) >> 4);
@@ -185,27 +262,8 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     dsc_out->is_placeholder = false;
 
     if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
-
-    return true;
 }
 
-/**
- * Free the allocated memories.
- */
-void _lv_font_clean_up_fmt_txt(void)
-{
-#if LV_USE_FONT_COMPRESSED
-    if(LV_GC_ROOT(_lv_font_decompr_buf)) {
-        lv_mem_free(LV_GC_ROOT(_lv_font_decompr_buf));
-        LV_GC_ROOT(_lv_font_decompr_buf) = NULL;
-    }
-#endif
-}
-
-/**********************
- *   STATIC FUNCTIONS
- **********************/
-
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 {
     if(letter == '\0') return 0;
@@ -220,7 +278,7 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
         /*Relative code point*/
         uint32_t rcp = letter - fdsc->cmaps[i].range_start;
-        if(rcp > fdsc->cmaps[i].range_length) continue;
+        if(rcp >= fdsc->cmaps[i].range_length) continue;
         uint32_t glyph_id = 0;
         if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
             glyph_id = fdsc->cmaps[i].glyph_id_start + rcp;
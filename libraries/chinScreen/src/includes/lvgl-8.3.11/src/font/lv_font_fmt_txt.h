@@ -156,6 +156,28 @@ typedef struct {
     uint32_t last_glyph_id;
 } lv_font_fmt_txt_glyph_cache_t;
 
+/**
+ * Direct look up tables of a built-in font for the letters below `range`, e.g. ASCII and Latin-1.
+ * `extras/font_compile.py` of chinScreen generates them next to the cmaps and kerning of the font.
+ * The letters from `range` up are looked up in the cmaps as usual.
+ */
+typedef struct {
+    /*Glyph ID of every letter below `range`, 0: not in the font*/
+    const uint16_t * glyph_ids;
+
+    /*Row and column of every letter below `range` in `kern_values`, 0: it's never kerned on that side.
+     *NULL if the font has no kerning*/
+    const uint8_t * kern_left;
+    const uint8_t * kern_right;
+
+    /*The kerning of every left and right letter: value = kern_values[(left - 1) * kern_right_cnt + (right - 1)],
+     *4.4 format like the kern pairs, so scaled with `kern_scale`*/
+    const int8_t * kern_values;
+
+    uint16_t range;
+    uint8_t kern_right_cnt;
+} lv_font_fmt_txt_lut_t;
+
 /*Describe store additional data for fonts*/
 typedef struct {
     /*The bitmaps of all glyphs*/
@@ -220,6 +242,30 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t lett
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+/**
+ * `get_glyph_bitmap` of a font with direct look up tables: the callback generated with the tables calls it.
+ * @param font      pointer to font
+ * @param letter    a unicode letter which bitmap should be get
+ * @param lut       the look up tables of the font
+ * @return          pointer to the bitmap or NULL if not found
+ */
+const uint8_t * lv_font_get_bitmap_fmt_txt_lut(const lv_font_t * font, uint32_t letter,
+                                               const lv_font_fmt_txt_lut_t * lut);
+
+/**
+ * `get_glyph_dsc` of a font with direct look up tables: the same as `lv_font_get_glyph_dsc_fmt_txt()`,
+ * but the glyph and the kerning of the letters below `lut->range` are read from the tables.
+ * @param font                  pointer to font
+ * @param dsc_out               store the result descriptor here
+ * @param unicode_letter        a UNICODE letter code
+ * @param unicode_letter_next   the letter after it, for kerning
+ * @param lut                   the look up tables of the font
+ * @return                      true: descriptor is successfully loaded into `dsc_out`.
+ *                              false: the letter was not found, no data is loaded to `dsc_out`
+ */
+bool lv_font_get_glyph_dsc_fmt_txt_lut(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
+                                       uint32_t unicode_letter_next, const lv_font_fmt_txt_lut_t * lut);
+
 /**
  * Free the allocated memories.
  */
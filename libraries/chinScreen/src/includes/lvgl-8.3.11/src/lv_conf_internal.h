@@ -10,6 +10,11 @@
 
 #include <stdint.h>
 
+/*Values of LV_USE_OS*/
+#define LV_OS_NONE      0
+#define LV_OS_PTHREAD   1
+#define LV_OS_FREERTOS  2
+
 /* Handle special Kconfig options */
 #ifndef LV_KCONFIG_IGNORE
     #include "lv_conf_kconfig.h"
@@ -356,6 +361,18 @@
     #endif
 #endif
 
+/*Bytes of decoded images the cache may keep (e.g. PNGs decoded into RAM).
+ *Images drawn straight from a C array don't count.
+ *With `LV_IMG_CACHE_ALLOC(size)`, `LV_IMG_CACHE_FREE(p)` and `LV_IMG_CACHE_ALLOC_INCLUDE` decoders
+ *can put these images elsewhere than `lv_mem_alloc()`, e.g. into external RAM*/
+#ifndef LV_IMG_CACHE_DEF_BYTES
+    #ifdef CONFIG_LV_IMG_CACHE_DEF_BYTES
+        #define LV_IMG_CACHE_DEF_BYTES CONFIG_LV_IMG_CACHE_DEF_BYTES
+    #else
+        #define LV_IMG_CACHE_DEF_BYTES (256 * 1024)
+    #endif
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -412,6 +429,66 @@
     #endif
 #endif
 
+/*Blend RGB565 with kernels working on 32 bit words and vectors instead of lv_color_mix() on every pixel.
+ *They give the same pixels. Used with LV_COLOR_DEPTH 16 and LV_COLOR_MIX_ROUND_OFS 0*/
+#ifndef LV_USE_DRAW_SW_BLEND_565
+    #ifdef _LV_KCONFIG_PRESENT
+        #ifdef CONFIG_LV_USE_DRAW_SW_BLEND_565
+            #define LV_USE_DRAW_SW_BLEND_565 CONFIG_LV_USE_DRAW_SW_BLEND_565
+        #else
+            #define LV_USE_DRAW_SW_BLEND_565 0
+        #endif
+    #else
+        #define LV_USE_DRAW_SW_BLEND_565 1
+    #endif
+#endif
+#if LV_USE_DRAW_SW_BLEND_565
+    /*Blend 8 pixels at once with 128 bit vectors if the compiler targets SSE2 or NEON (e.g. the simulator)*/
+    #ifndef LV_DRAW_SW_BLEND_565_SIMD
+        #ifdef _LV_KCONFIG_PRESENT
+            #ifdef CONFIG_LV_DRAW_SW_BLEND_565_SIMD
+                #define LV_DRAW_SW_BLEND_565_SIMD CONFIG_LV_DRAW_SW_BLEND_565_SIMD
+            #else
+                #define LV_DRAW_SW_BLEND_565_SIMD 0
+            #endif
+        #else
+            #define LV_DRAW_SW_BLEND_565_SIMD 1
+        #endif
+    #endif
+#endif
+
+/*Zoom images without rotation with repeated pixels for 2x, 3x... and n x n averages for 1/2x, 1/3x...
+ *instead of interpolating. Sharper and faster, but not the same pixels as before.
+ *lv_draw_sw_transform_set_path() can change it at run time*/
+#ifndef LV_DRAW_SW_TRANSFORM_INT_ZOOM
+    #ifdef CONFIG_LV_DRAW_SW_TRANSFORM_INT_ZOOM
+        #define LV_DRAW_SW_TRANSFORM_INT_ZOOM CONFIG_LV_DRAW_SW_TRANSFORM_INT_ZOOM
+    #else
+        #define LV_DRAW_SW_TRANSFORM_INT_ZOOM 0
+    #endif
+#endif
+
+/*Bytes of pre-zoomed images lv_draw_sw_zoom_cache_open() may keep, allocated with `LV_IMG_CACHE_ALLOC`.
+ *0: don't pre-zoom*/
+#ifndef LV_DRAW_SW_ZOOM_CACHE_DEF_BYTES
+    #ifdef CONFIG_LV_DRAW_SW_ZOOM_CACHE_DEF_BYTES
+        #define LV_DRAW_SW_ZOOM_CACHE_DEF_BYTES CONFIG_LV_DRAW_SW_ZOOM_CACHE_DEF_BYTES
+    #else
+        #define LV_DRAW_SW_ZOOM_CACHE_DEF_BYTES 0
+    #endif
+#endif
+
+/*Bytes of glyphs lv_draw_sw_letter() may keep looked up and expanded to a byte per pixel, allocated with
+ *`LV_IMG_CACHE_ALLOC`. Labels redrawn often then skip the font look up and the unpacking of the bitmap.
+ *0: draw every glyph from its font*/
+#ifndef LV_DRAW_SW_GLYPH_CACHE_DEF_BYTES
+    #ifdef CONFIG_LV_DRAW_SW_GLYPH_CACHE_DEF_BYTES
+        #define LV_DRAW_SW_GLYPH_CACHE_DEF_BYTES CONFIG_LV_DRAW_SW_GLYPH_CACHE_DEF_BYTES
+    #else
+        #define LV_DRAW_SW_GLYPH_CACHE_DEF_BYTES 0
+    #endif
+#endif
+
 /*-------------
  * GPU
  *-----------*/
@@ -549,6 +626,64 @@
     #endif
 #endif
 
+/*-------------
+ * Threads
+ *-----------*/
+
+/*The OS giving threads, mutexes and signals to LVGL (see misc/lv_thread.h)
+ *LV_OS_NONE, LV_OS_PTHREAD or LV_OS_FREERTOS*/
+#ifndef LV_USE_OS
+    #ifdef CONFIG_LV_USE_OS
+        #define LV_USE_OS CONFIG_LV_USE_OS
+    #else
+        #define LV_USE_OS LV_OS_NONE
+    #endif
+#endif
+
+/*Draw the big areas in horizontal tiles, on the LVGL thread and on worker threads at the same time.
+ *The objects are still walked on the LVGL thread; only the software rasterization is shared. Needs LV_USE_OS*/
+#ifndef LV_USE_DRAW_SW_TILES
+    #ifdef CONFIG_LV_USE_DRAW_SW_TILES
+        #define LV_USE_DRAW_SW_TILES CONFIG_LV_USE_DRAW_SW_TILES
+    #else
+        #define LV_USE_DRAW_SW_TILES 0
+    #endif
+#endif
+#if LV_USE_DRAW_SW_TILES
+    /*Threads helping the LVGL thread (at most 7). `lv_draw_sw_tiles_set_workers()` changes it at run time*/
+    #ifndef LV_DRAW_SW_TILE_WORKERS
+        #ifdef CONFIG_LV_DRAW_SW_TILE_WORKERS
+            #define LV_DRAW_SW_TILE_WORKERS CONFIG_LV_DRAW_SW_TILE_WORKERS
+        #else
+            #define LV_DRAW_SW_TILE_WORKERS 1
+        #endif
+    #endif
+    /*Draw smaller areas on the LVGL thread alone, it's faster than waking the workers*/
+    #ifndef LV_DRAW_SW_TILE_MIN_PX
+        #ifdef CONFIG_LV_DRAW_SW_TILE_MIN_PX
+            #define LV_DRAW_SW_TILE_MIN_PX CONFIG_LV_DRAW_SW_TILE_MIN_PX
+        #else
+            #define LV_DRAW_SW_TILE_MIN_PX (8 * 1024)
+        #endif
+    #endif
+    /*Core of the workers with LV_OS_FREERTOS, -1: any core*/
+    #ifndef LV_DRAW_SW_TILE_CORE
+        #ifdef CONFIG_LV_DRAW_SW_TILE_CORE
+            #define LV_DRAW_SW_TILE_CORE CONFIG_LV_DRAW_SW_TILE_CORE
+        #else
+            #define LV_DRAW_SW_TILE_CORE -1
+        #endif
+    #endif
+    /*Stack of the workers in bytes with LV_OS_FREERTOS*/
+    #ifndef LV_DRAW_SW_TILE_STACK
+        #ifdef CONFIG_LV_DRAW_SW_TILE_STACK
+            #define LV_DRAW_SW_TILE_STACK CONFIG_LV_DRAW_SW_TILE_STACK
+        #else
+            #define LV_DRAW_SW_TILE_STACK (4 * 1024)
+        #endif
+    #endif
+#endif
+
 /*-------------
  * Logging
  *-----------*/
@@ -1784,6 +1919,18 @@
     #endif
 #endif
 
+#ifndef LV_USE_NUMLABEL
+    #ifdef _LV_KCONFIG_PRESENT
+        #ifdef CONFIG_LV_USE_NUMLABEL
+            #define LV_USE_NUMLABEL CONFIG_LV_USE_NUMLABEL
+        #else
+            #define LV_USE_NUMLABEL 0
+        #endif
+    #else
+        #define LV_USE_NUMLABEL   1
+    #endif
+#endif
+
 #ifndef LV_USE_SPAN
     #ifdef _LV_KCONFIG_PRESENT
         #ifdef CONFIG_LV_USE_SPAN
@@ -2160,6 +2307,43 @@
         #define LV_USE_GIF 0
     #endif
 #endif
+#if LV_USE_GIF
+    /*Bytes of frames `lv_gif_set_atlas()` may keep decoded, allocated with `LV_IMG_CACHE_ALLOC`*/
+    #ifndef LV_GIF_ATLAS_DEF_BYTES
+        #ifdef CONFIG_LV_GIF_ATLAS_DEF_BYTES
+            #define LV_GIF_ATLAS_DEF_BYTES CONFIG_LV_GIF_ATLAS_DEF_BYTES
+        #else
+            #define LV_GIF_ATLAS_DEF_BYTES (512 * 1024)
+        #endif
+    #endif
+#endif
+
+/*MJPEG (AVI) video player, decodes with the JPG library*/
+#ifndef LV_USE_MJPEG
+    #ifdef CONFIG_LV_USE_MJPEG
+        #define LV_USE_MJPEG CONFIG_LV_USE_MJPEG
+    #else
+        #define LV_USE_MJPEG 0
+    #endif
+#endif
+#if LV_USE_MJPEG
+    /*Bytes read from the file at once, allocated with `LV_IMG_CACHE_ALLOC`. Grows to the largest frame*/
+    #ifndef LV_MJPEG_READ_AHEAD
+        #ifdef CONFIG_LV_MJPEG_READ_AHEAD
+            #define LV_MJPEG_READ_AHEAD CONFIG_LV_MJPEG_READ_AHEAD
+        #else
+            #define LV_MJPEG_READ_AHEAD (32 * 1024)
+        #endif
+    #endif
+    /*Microsecond clock for the decode and read times, `LV_MJPEG_TIME_INCLUDE` declares it*/
+    #ifndef LV_MJPEG_TIME_US_EXPR
+        #ifdef CONFIG_LV_MJPEG_TIME_US_EXPR
+            #define LV_MJPEG_TIME_US_EXPR CONFIG_LV_MJPEG_TIME_US_EXPR
+        #else
+            #define LV_MJPEG_TIME_US_EXPR (lv_tick_get() * 1000)
+        #endif
+    #endif
+#endif
 
 /*QR code library*/
 #ifndef LV_USE_QRCODE
@@ -2234,6 +2418,39 @@
             #define LV_TINY_TTF_FILE_SUPPORT 0
         #endif
     #endif
+    /*Bytes of rasterised glyphs kept for every font and size, allocated with `LV_IMG_CACHE_ALLOC`*/
+    #ifndef LV_TINY_TTF_CACHE_DEF_BYTES
+        #ifdef CONFIG_LV_TINY_TTF_CACHE_DEF_BYTES
+            #define LV_TINY_TTF_CACHE_DEF_BYTES CONFIG_LV_TINY_TTF_CACHE_DEF_BYTES
+        #else
+            #define LV_TINY_TTF_CACHE_DEF_BYTES (64 * 1024)
+        #endif
+    #endif
+    #if LV_TINY_TTF_FILE_SUPPORT
+        /*A font file is read in pages instead of at once, this many pages of it are kept*/
+        #ifndef LV_TINY_TTF_PAGE_SIZE
+            #ifdef CONFIG_LV_TINY_TTF_PAGE_SIZE
+                #define LV_TINY_TTF_PAGE_SIZE CONFIG_LV_TINY_TTF_PAGE_SIZE
+            #else
+                #define LV_TINY_TTF_PAGE_SIZE 4096
+            #endif
+        #endif
+        #ifndef LV_TINY_TTF_PAGE_CNT
+            #ifdef CONFIG_LV_TINY_TTF_PAGE_CNT
+                #define LV_TINY_TTF_PAGE_CNT CONFIG_LV_TINY_TTF_PAGE_CNT
+            #else
+                #define LV_TINY_TTF_PAGE_CNT 8
+            #endif
+        #endif
+    #endif
+    /*Microsecond clock for the rasterise times, `LV_TINY_TTF_TIME_INCLUDE` declares it*/
+    #ifndef LV_TINY_TTF_TIME_US_EXPR
+        #ifdef CONFIG_LV_TINY_TTF_TIME_US_EXPR
+            #define LV_TINY_TTF_TIME_US_EXPR CONFIG_LV_TINY_TTF_TIME_US_EXPR
+        #else
+            #define LV_TINY_TTF_TIME_US_EXPR (lv_tick_get() * 1000)
+        #endif
+    #endif
 #endif
 
 /*Rlottie library*/
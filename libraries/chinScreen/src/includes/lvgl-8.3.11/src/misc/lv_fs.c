@@ -25,6 +25,7 @@
  *  STATIC PROTOTYPES
  **********************/
 static const char * lv_fs_get_real_path(const char * path);
+static void lv_fs_cache_invalidate(lv_fs_file_t * file_p);
 
 /**********************
  *  STATIC VARIABLES
@@ -157,6 +158,7 @@ static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, char * buf, uint32_t
                 /*If remaining data chuck is bigger than buffer size, then do not use cache, instead read it directly from FS*/
                 res = file_p->drv->read_cb(file_p->drv, file_p->file_d, (void *)(buf + buffer_remaining_length),
                                            btr - buffer_remaining_length, &bytes_read_to_buffer);
+                lv_fs_cache_invalidate(file_p);
             }
             else {
                 /*If remaining data chunk is smaller than buffer size, then read into cache buffer*/
@@ -175,6 +177,7 @@ static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, char * buf, uint32_t
         if(btr > buffer_size) {
             /*If bigger data is requested, then do not use cache, instead read it directly*/
             res = file_p->drv->read_cb(file_p->drv, file_p->file_d, (void *)buf, btr, br);
+            lv_fs_cache_invalidate(file_p);
         }
         else {
             /*If small data is requested, then read from FS into cache buffer*/
@@ -261,6 +264,7 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
                     /*FS seek if new position is outside cache buffer*/
                     if(file_p->cache->file_position < file_p->cache->start || file_p->cache->file_position > file_p->cache->end) {
                         res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, file_p->cache->file_position, LV_FS_SEEK_SET);
+                        lv_fs_cache_invalidate(file_p);
                     }
 
                     break;
@@ -271,6 +275,7 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
                     /*FS seek if new position is outside cache buffer*/
                     if(file_p->cache->file_position < file_p->cache->start || file_p->cache->file_position > file_p->cache->end) {
                         res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, file_p->cache->file_position, LV_FS_SEEK_SET);
+                        lv_fs_cache_invalidate(file_p);
                     }
 
                     break;
@@ -278,6 +283,7 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
             case LV_FS_SEEK_END: {
                     /*Because we don't know the file size, we do a little trick: do a FS seek, then get new file position from FS*/
                     res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos, whence);
+                    lv_fs_cache_invalidate(file_p);
                     if(res == LV_FS_RES_OK) {
                         uint32_t tmp_position;
                         res = file_p->drv->tell_cb(file_p->drv, file_p->file_d, &tmp_position);
@@ -516,3 +522,14 @@ static const char * lv_fs_get_real_path(const char * path)
 
     return path;
 }
+
+/**
+ * Forget the cached data when the driver has been moved away from the end of the cache buffer
+ * (a read that went around the buffer, or a seek), else a seek back into the buffer wouldn't move the driver.
+ * @param file_p pointer to a lv_fs_file_t variable
+ */
+static void lv_fs_cache_invalidate(lv_fs_file_t * file_p)
+{
+    file_p->cache->start = UINT32_MAX;
+    file_p->cache->end = 0;
+}
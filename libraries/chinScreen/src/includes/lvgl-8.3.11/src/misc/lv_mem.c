@@ -57,6 +57,9 @@
     static lv_tlsf_t tlsf;
     static uint32_t cur_used;
     static uint32_t max_used;
+    #if LV_USE_OS != LV_OS_NONE
+        static lv_mutex_t tlsf_mutex;   /*The threads drawing tiles allocate too*/
+    #endif
 #endif
 
 static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variable if 0 byte should be allocated*/
@@ -70,6 +73,14 @@ static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variabl
     #define MEM_TRACE(...)
 #endif
 
+#if LV_MEM_CUSTOM == 0 && LV_USE_OS != LV_OS_NONE
+    #define TLSF_LOCK()     lv_mutex_lock(&tlsf_mutex)
+    #define TLSF_UNLOCK()   lv_mutex_unlock(&tlsf_mutex)
+#else
+    #define TLSF_LOCK()
+    #define TLSF_UNLOCK()
+#endif
+
 #define COPY32 *d32 = *s32; d32++; s32++;
 #define COPY8 *d8 = *s8; d8++; s8++;
 #define SET32(x) *d32 = x; d32++;
@@ -98,6 +109,9 @@ void lv_mem_init(void)
 #else
     tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_ADR, LV_MEM_SIZE);
 #endif
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_init(&tlsf_mutex);
+#endif
 #endif
 
 #if LV_MEM_ADD_JUNK
@@ -113,6 +127,9 @@ void lv_mem_deinit(void)
 {
 #if LV_MEM_CUSTOM == 0
     lv_tlsf_destroy(tlsf);
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_delete(&tlsf_mutex);
+#endif
     lv_mem_init();
 #endif
 }
@@ -131,7 +148,13 @@ void * lv_mem_alloc(size_t size)
     }
 
 #if LV_MEM_CUSTOM == 0
+    TLSF_LOCK();
     void * alloc = lv_tlsf_malloc(tlsf, size);
+    if(alloc) {
+        cur_used += size;
+        max_used = LV_MAX(cur_used, max_used);
+    }
+    TLSF_UNLOCK();
 #else
     void * alloc = LV_MEM_CUSTOM_ALLOC(size);
 #endif
@@ -153,10 +176,6 @@ void * lv_mem_alloc(size_t size)
 #endif
 
     if(alloc) {
-#if LV_MEM_CUSTOM == 0
-        cur_used += size;
-        max_used = LV_MAX(cur_used, max_used);
-#endif
         MEM_TRACE("allocated at %p", alloc);
     }
     return alloc;
@@ -176,9 +195,11 @@ void lv_mem_free(void * data)
 #  if LV_MEM_ADD_JUNK
     lv_memset(data, 0xbb, lv_tlsf_block_size(data));
 #  endif
+    TLSF_LOCK();
     size_t size = lv_tlsf_free(tlsf, data);
     if(cur_used > size) cur_used -= size;
     else cur_used = 0;
+    TLSF_UNLOCK();
 #else
     LV_MEM_CUSTOM_FREE(data);
 #endif
@@ -203,7 +224,9 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
     if(data_p == &zero_mem) return lv_mem_alloc(new_size);
 
 #if LV_MEM_CUSTOM == 0
+    TLSF_LOCK();
     void * new_p = lv_tlsf_realloc(tlsf, data_p, new_size);
+    TLSF_UNLOCK();
 #else
     void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
 #endif
@@ -250,7 +273,9 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 #if LV_MEM_CUSTOM == 0
     MEM_TRACE("begin");
 
+    TLSF_LOCK();
     lv_tlsf_walk_pool(lv_tlsf_get_pool(tlsf), lv_mem_walker, mon_p);
+    TLSF_UNLOCK();
 
     mon_p->total_size = LV_MEM_SIZE;
     mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
@@ -0,0 +1,236 @@
+/**
+ * @file lv_thread.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_thread.h"
+
+#if LV_USE_OS != LV_OS_NONE
+
+#include "lv_log.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_OS == LV_OS_PTHREAD
+    static void * thread_entry(void * p);
+#elif LV_USE_OS == LV_OS_FREERTOS
+    static void thread_entry(void * p);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+#if LV_USE_OS == LV_OS_PTHREAD
+
+lv_res_t lv_thread_init(lv_thread_t * thread, int32_t core, void (*callback)(void *), size_t stack_size,
+                        void * user_data)
+{
+    LV_UNUSED(core);
+    LV_UNUSED(stack_size);
+
+    thread->callback = callback;
+    thread->user_data = user_data;
+    if(pthread_create(&thread->thread, NULL, thread_entry, thread) != 0) {
+        LV_LOG_WARN("couldn't create the thread");
+        return LV_RES_INV;
+    }
+    return LV_RES_OK;
+}
+
+lv_res_t lv_thread_delete(lv_thread_t * thread)
+{
+    return pthread_join(thread->thread, NULL) == 0 ? LV_RES_OK : LV_RES_INV;
+}
+
+lv_res_t lv_mutex_init(lv_mutex_t * mutex)
+{
+    return pthread_mutex_init(mutex, NULL) == 0 ? LV_RES_OK : LV_RES_INV;
+}
+
+lv_res_t lv_mutex_lock(lv_mutex_t * mutex)
+{
+    return pthread_mutex_lock(mutex) == 0 ? LV_RES_OK : LV_RES_INV;
+}
+
+lv_res_t lv_mutex_unlock(lv_mutex_t * mutex)
+{
+    return pthread_mutex_unlock(mutex) == 0 ? LV_RES_OK : LV_RES_INV;
+}
+
+lv_res_t lv_mutex_delete(lv_mutex_t * mutex)
+{
+    return pthread_mutex_destroy(mutex) == 0 ? LV_RES_OK : LV_RES_INV;
+}
+
+lv_res_t lv_thread_sync_init(lv_thread_sync_t * sync)
+{
+    if(pthread_mutex_init(&sync->mutex, NULL) != 0) return LV_RES_INV;
+    if(pthread_cond_init(&sync->cond, NULL) != 0) {
+        pthread_mutex_destroy(&sync->mutex);
+        return LV_RES_INV;
+    }
+    sync->v = false;
+    return LV_RES_OK;
+}
+
+lv_res_t lv_thread_sync_wait(lv_thread_sync_t * sync)
+{
+    pthread_mutex_lock(&sync->mutex);
+    while(!sync->v) {
+        pthread_cond_wait(&sync->cond, &sync->mutex);
+    }
+    sync->v = false;
+    pthread_mutex_unlock(&sync->mutex);
+    return LV_RES_OK;
+}
+
+lv_res_t lv_thread_sync_signal(lv_thread_sync_t * sync)
+{
+    pthread_mutex_lock(&sync->mutex);
+    sync->v = true;
+    pthread_cond_signal(&sync->cond);
+    pthread_mutex_unlock(&sync->mutex);
+    return LV_RES_OK;
+}
+
+lv_res_t lv_thread_sync_delete(lv_thread_sync_t * sync)
+{
+    pthread_cond_destroy(&sync->cond);
+    pthread_mutex_destroy(&sync->mutex);
+    return LV_RES_OK;
+}
+
+#elif LV_USE_OS == LV_OS_FREERTOS
+
+lv_res_t lv_thread_init(lv_thread_t * thread, int32_t core, void (*callback)(void *), size_t stack_size,
+                        void * user_data)
+{
+    thread->callback = callback;
+    thread->user_data = user_data;
+    thread->done = xSemaphoreCreateBinary();
+    if(thread->done == NULL) return LV_RES_INV;
+
+    BaseType_t res;
+#ifdef ESP_PLATFORM
+    /*ESP-IDF counts the stack in bytes*/
+    res = xTaskCreatePinnedToCore(thread_entry, "lv_thread", stack_size, thread, uxTaskPriorityGet(NULL),
+                                  &thread->task, core < 0 ? tskNO_AFFINITY : core);
+#else
+    LV_UNUSED(core);
+    res = xTaskCreate(thread_entry, "lv_thread", stack_size / sizeof(StackType_t), thread, uxTaskPriorityGet(NULL),
+                      &thread->task);
+#endif
+    if(res != pdPASS) {
+        LV_LOG_WARN("couldn't create the task");
+        vSemaphoreDelete(thread->done);
+        return LV_RES_INV;
+    }
+    return LV_RES_OK;
+}
+
+lv_res_t lv_thread_delete(lv_thread_t * thread)
+{
+    xSemaphoreTake(thread->done, portMAX_DELAY);
+    vSemaphoreDelete(thread->done);
+    return LV_RES_OK;
+}
+
+lv_res_t lv_mutex_init(lv_mutex_t * mutex)
+{
+    *mutex = xSemaphoreCreateMutex();
+    return *mutex ? LV_RES_OK : LV_RES_INV;
+}
+
+lv_res_t lv_mutex_lock(lv_mutex_t * mutex)
+{
+    return xSemaphoreTake(*mutex, portMAX_DELAY) == pdTRUE ? LV_RES_OK : LV_RES_INV;
+}
+
+lv_res_t lv_mutex_unlock(lv_mutex_t * mutex)
+{
+    return xSemaphoreGive(*mutex) == pdTRUE ? LV_RES_OK : LV_RES_INV;
+}
+
+lv_res_t lv_mutex_delete(lv_mutex_t * mutex)
+{
+    vSemaphoreDelete(*mutex);
+    *mutex = NULL;
+    return LV_RES_OK;
+}
+
+lv_res_t lv_thread_sync_init(lv_thread_sync_t * sync)
+{
+    *sync = xSemaphoreCreateBinary();
+    return *sync ? LV_RES_OK : LV_RES_INV;
+}
+
+lv_res_t lv_thread_sync_wait(lv_thread_sync_t * sync)
+{
+    return xSemaphoreTake(*sync, portMAX_DELAY) == pdTRUE ? LV_RES_OK : LV_RES_INV;
+}
+
+lv_res_t lv_thread_sync_signal(lv_thread_sync_t * sync)
+{
+    xSemaphoreGive(*sync);  /*Fails if it's already given, that's fine*/
+    return LV_RES_OK;
+}
+
+lv_res_t lv_thread_sync_delete(lv_thread_sync_t * sync)
+{
+    vSemaphoreDelete(*sync);
+    *sync = NULL;
+    return LV_RES_OK;
+}
+
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_OS == LV_OS_PTHREAD
+
+static void * thread_entry(void * p)
+{
+    lv_thread_t * thread = p;
+    thread->callback(thread->user_data);
+    return NULL;
+}
+
+#elif LV_USE_OS == LV_OS_FREERTOS
+
+static void thread_entry(void * p)
+{
+    lv_thread_t * thread = p;
+    thread->callback(thread->user_data);
+
+    /*A FreeRTOS task can't return: tell lv_thread_delete() and delete itself.
+     *`thread` may be freed as soon as `done` is given, don't touch it after that*/
+    xSemaphoreGive(thread->done);
+    vTaskDelete(NULL);
+}
+
+#endif
+
+#endif /*LV_USE_OS != LV_OS_NONE*/
@@ -0,0 +1,133 @@
+/**
+ * @file lv_thread.h
+ * Threads, mutexes and signals of the OS selected with `LV_USE_OS`,
+ * so the same code runs with pthreads on a PC and with FreeRTOS tasks on a microcontroller.
+ */
+
+#ifndef LV_THREAD_H
+#define LV_THREAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include "lv_types.h"
+
+#if LV_USE_OS == LV_OS_PTHREAD
+#include <pthread.h>
+#elif LV_USE_OS == LV_OS_FREERTOS
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#else
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#endif
+#elif LV_USE_OS != LV_OS_NONE
+#error "lv_thread: unknown LV_USE_OS"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*A variable with one instance in every thread. Without an OS there is only one thread*/
+#if LV_USE_OS == LV_OS_NONE
+#define LV_THREAD_LOCAL
+#elif defined(__GNUC__)
+#define LV_THREAD_LOCAL __thread        /*The same plain TLS access from C and C++*/
+#elif defined(__cplusplus) && __cplusplus >= 201103L
+#define LV_THREAD_LOCAL thread_local
+#else
+#define LV_THREAD_LOCAL _Thread_local
+#endif
+
+#if LV_USE_OS != LV_OS_NONE
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+#if LV_USE_OS == LV_OS_PTHREAD
+
+typedef struct {
+    pthread_t thread;
+    void (*callback)(void *);
+    void * user_data;
+} lv_thread_t;
+
+typedef pthread_mutex_t lv_mutex_t;
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool v;
+} lv_thread_sync_t;
+
+#elif LV_USE_OS == LV_OS_FREERTOS
+
+typedef struct {
+    TaskHandle_t task;
+    SemaphoreHandle_t done;     /*Given when `callback` returned*/
+    void (*callback)(void *);
+    void * user_data;
+} lv_thread_t;
+
+typedef SemaphoreHandle_t lv_mutex_t;
+
+typedef SemaphoreHandle_t lv_thread_sync_t;
+
+#endif
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start a thread. It runs with the priority of the calling thread.
+ * @param thread        store the thread here; keep it until `lv_thread_delete()`
+ * @param core          pin the thread to this core, -1: any core. Only FreeRTOS on ESP32 pins
+ * @param callback      the thread's function
+ * @param stack_size    stack in bytes. pthreads use the default stack of the PC
+ * @param user_data     the parameter of `callback`
+ * @return              LV_RES_OK: the thread is running; LV_RES_INV: out of memory
+ */
+lv_res_t lv_thread_init(lv_thread_t * thread, int32_t core, void (*callback)(void *), size_t stack_size,
+                        void * user_data);
+
+/**
+ * Wait until the callback of a thread returns and free the thread
+ * @param thread        a thread started with `lv_thread_init()`
+ * @return              LV_RES_OK: the thread is gone
+ */
+lv_res_t lv_thread_delete(lv_thread_t * thread);
+
+lv_res_t lv_mutex_init(lv_mutex_t * mutex);
+lv_res_t lv_mutex_lock(lv_mutex_t * mutex);
+lv_res_t lv_mutex_unlock(lv_mutex_t * mutex);
+lv_res_t lv_mutex_delete(lv_mutex_t * mutex);
+
+/**
+ * A signal one thread waits for and another one gives. Signals given while nobody waits are not
+ * counted: the next wait returns at once, the one after it blocks again.
+ */
+lv_res_t lv_thread_sync_init(lv_thread_sync_t * sync);
+lv_res_t lv_thread_sync_wait(lv_thread_sync_t * sync);
+lv_res_t lv_thread_sync_signal(lv_thread_sync_t * sync);
+lv_res_t lv_thread_sync_delete(lv_thread_sync_t * sync);
+
+#endif /*LV_USE_OS != LV_OS_NONE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_THREAD_H*/
@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+"""Compare two lv_bench reports, e.g. of the last release and the working tree.
+
+    bench_compare.py old.json new.json [--threshold 5]
+
+Prints fps and ns/px per scene with the change in percent and exits with 1 if any scene got
+slower (ns/px up) by more than the threshold.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        return {s['name']: s for s in json.load(f)['scenes']}
+
+
+def change(old, new):
+    return (new - old) * 100.0 / old if old else 0.0
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare two lv_bench reports.')
+    parser.add_argument('old')
+    parser.add_argument('new')
+    parser.add_argument('--threshold', type=float, default=5.0,
+                        help='ns/px increase in percent that counts as a regression')
+    args = parser.parse_args()
+
+    old = load(args.old)
+    new = load(args.new)
+
+    print('%-18s %10s %10s %8s %10s %10s %8s' % ('scene', 'fps', 'fps', '', 'ns/px', 'ns/px', ''))
+    regressed = []
+    for name in old:
+        if name not in new:
+            print('%-18s missing from %s' % (name, args.new))
+            continue
+        o, n = old[name], new[name]
+        px_change = change(o['ns_per_px'], n['ns_per_px'])
+        print('%-18s %10.1f %10.1f %+7.1f%% %10.2f %10.2f %+7.1f%%' % (
+            name, o['fps'], n['fps'], change(o['fps'], n['fps']),
+            o['ns_per_px'], n['ns_per_px'], px_change))
+        if px_change > args.threshold:
+            regressed.append(name)
+
+    if regressed:
+        print('slower than %s by more than %.1f%%: %s' % (args.old, args.threshold, ', '.join(regressed)))
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,1333 @@
+/**
+ * @file bench_main.cpp
+ *
+ * Rendering benchmarks of the chinScreen primitives, see CMakeLists.txt next to this file.
+ *
+ *   lv_bench [--frames 100] [--warmup 5] [--repeat 3] [--scene name] [--workers n] [--out bench.json] [--ppm dir] [--list]
+ *   lv_bench --gifs [--frames 100] [--repeat 3] [--out gifs.json]
+ *   lv_bench --kernels [--frames 100] [--repeat 3] [--out kernels.json]
+ *   lv_bench --transforms [--frames 100] [--repeat 3] [--out transforms.json]
+ *   lv_bench --fonts [--frames 100] [--repeat 3] [--out fonts.json]
+ *   lv_bench --names [--frames 100] [--repeat 3] [--out names.json]
+ *   lv_bench --ttf [--frames 100] [--repeat 3] [--out ttf.json]
+ *
+ * Every scene builds its screen with the same chinScreen calls a sketch would make, then renders
+ * frames back to back with lv_refr_now(), advancing LVGL's clock by BENCH_FRAME_MS per frame so
+ * animations and GIFs step the same way on every run. Scenes that redraw everything invalidate
+ * the whole screen each frame; the others only redraw what their updates invalidate, like on the
+ * device. The library's own Serial output goes to stderr so stdout only carries the report.
+ * Each scene runs --repeat times and the fastest run is reported, which filters out most of the
+ * noise of a busy machine. --ppm saves the last frame of each scene, to check a scene still draws what it should.
+ * --workers sets the threads drawing tiles next to the LVGL thread (lv_draw_sw_tiles), 0 draws on one
+ * thread; running the same scenes with 0, 1 and 2 shows how the big areas scale with the workers.
+ *
+ * Every scene also reports heap_peak, the most memory it had allocated on top of the empty screen
+ * while it was built and rendered. The binary is linked with `--wrap` around the allocator for it.
+ *
+ * --gifs measures the GIF decoder alone instead: every GIF of icons/ani and sprites is decoded
+ * from memory, like the C arrays a sketch plays, until --frames frames are done. Each GIF is a
+ * "scene" of the report, so bench_compare.py compares two of these reports the same way.
+ *
+ * --kernels measures the blend kernels of lv_draw_sw_blend alone: each kernel of every built-in set
+ * (ref, swar, vector) blends a BENCH_KERNEL_W x BENCH_KERNEL_H band --frames times and is a "scene"
+ * like "blend:map_opa:swar". A set giving other pixels than the reference fails the run.
+ *
+ * --transforms measures lv_draw_sw_transform alone: the image of the image_transform scene is zoomed
+ * 2x, 3x, 0.5x and 1.5x without rotation, with and without anti-aliasing, once by every path (generic,
+ * separable, integer) into a band of at most BENCH_KERNEL_W x BENCH_KERNEL_H, like "zoom:2x:aa:separable".
+ * The separable path giving other visible pixels than the generic one fails the run.
+ *
+ * --fonts measures the glyph look up of text layout alone: lv_txt_get_width() of a few dashboard
+ * strings, once with the cmaps of the font ("glyphs:aladin:cmap") and once with the direct look up
+ * tables of extras/font_compile.py ("glyphs:aladin:lut"). ns_per_px is per letter there. Different widths
+ * fail the run.
+ *
+ * --names measures how colour, font and alignment names become LVGL values, the names a screen like
+ * bubble_pop passes for every object: once with a compare per known name like the library did
+ * ("names:color:scan") and once with the perfect hash tables of resolve.h ("names:color:phash").
+ * ns_per_px is per name there. Different values fail the run.
+ *
+ * --ttf measures the TrueType fonts of chinScreen_font_load() alone: the printable ASCII letters of the
+ * Ubuntu font of the tests are rasterised at 16, 24 and 48 px without a glyph cache, from memory
+ * ("ttf:24:raster") and from a file read in pages ("ttf:24:file"), then taken from the glyph cache
+ * ("ttf:24:cached"). ns_per_px is per glyph there. A cached glyph other than the rasterised one fails the run.
+ */
+
+#if LV_BUILD_BENCH
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <malloc.h>
+#include <atomic>
+
+#include "chinScreen.h"
+#include "chinScreen_host.h"
+#include "lv_test_jpeg.h"
+#include "includes/icons/ani/gear-1.inc"
+#include "includes/icons/ani/gear-2.inc"
+#include "includes/icons/ani/gear-3.inc"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_FRAME_MS      33      /*Simulated time between frames, a 30 FPS animation*/
+#define BENCH_IMG_SIZE      96
+#define BENCH_JPEG_FILE     "/tmp/lv_bench_photo.jpg"
+#define BENCH_TTF_FILE      "/tmp/lv_bench_font.ttf"
+#define BENCH_KERNEL_W      320     /*A band of the draw buffer*/
+#define BENCH_KERNEL_H      48
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const char * name;
+    const char * desc;
+    void (*setup)(void);
+    void (*frame)(uint32_t i);
+    bool full_redraw;       /*Invalidate the whole screen every frame*/
+} bench_scene_t;
+
+typedef struct {
+    uint32_t frames;
+    uint32_t rendered;      /*Frames that had something to draw*/
+    uint64_t wall_us;
+    lvgl_port_perf_summary_t render_us;
+    lvgl_port_perf_summary_t flush_us;
+    lvgl_port_perf_summary_t px;
+    size_t heap_peak;       /*Bytes allocated on top of the empty screen, at most*/
+} bench_result_t;
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_obj_t * scene_objs[128];
+static uint32_t scene_obj_cnt;
+
+static uint16_t transform_px[BENCH_IMG_SIZE * BENCH_IMG_SIZE];
+static lv_img_dsc_t transform_dsc;
+
+static uint8_t * jpeg_data;
+static lv_img_dsc_t jpeg_dsc;
+
+static std::atomic<size_t> heap_in_use;
+static std::atomic<size_t> heap_peak;
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/////////////////////////////////////////////////////////////
+// Heap in use, see `-Wl,--wrap` in CMakeLists.txt
+/////////////////////////////////////////////////////////////
+extern "C" {
+void * __real_malloc(size_t size);
+void * __real_calloc(size_t n, size_t size);
+void * __real_realloc(void * p, size_t size);
+void __real_free(void * p);
+}
+
+static void heap_add(void * p)
+{
+    if(p == NULL) return;
+    const size_t now = heap_in_use += malloc_usable_size(p);
+    size_t peak = heap_peak;
+    while(now > peak && !heap_peak.compare_exchange_weak(peak, now)) {}
+}
+
+static void heap_sub(void * p)
+{
+    if(p) heap_in_use -= malloc_usable_size(p);
+}
+
+extern "C" void * __wrap_malloc(size_t size)
+{
+    void * p = __real_malloc(size);
+    heap_add(p);
+    return p;
+}
+
+extern "C" void * __wrap_calloc(size_t n, size_t size)
+{
+    void * p = __real_calloc(n, size);
+    heap_add(p);
+    return p;
+}
+
+extern "C" void * __wrap_realloc(void * p, size_t size)
+{
+    const size_t old = p ? malloc_usable_size(p) : 0;
+    void * res = __real_realloc(p, size);
+    if(res == NULL) return NULL;
+    heap_in_use -= old;
+    heap_add(res);
+    return res;
+}
+
+extern "C" void __wrap_free(void * p)
+{
+    heap_sub(p);
+    __real_free(p);
+}
+
+static uint64_t bench_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void scene_add(lv_obj_t * obj)
+{
+    if(obj && scene_obj_cnt < sizeof(scene_objs) / sizeof(scene_objs[0])) scene_objs[scene_obj_cnt++] = obj;
+}
+
+/////////////////////////////////////////////////////////////
+// Scene: 7 stop rainbow, the way the animated backgrounds draw it
+/////////////////////////////////////////////////////////////
+static void gradient_setup(void)
+{
+    chinScreen_background_rainbow("vertical");
+}
+
+static void gradient_hor_setup(void)
+{
+    chinScreen_gradient_stop stops[8];
+    for(int i = 0; i < 8; i++) {
+        stops[i].color = i % 2 ? rainbow_colors[i % 7] : fire_colors[i % 5];
+        stops[i].position = (i * 100) / 7;
+    }
+    chinScreen_background_multi_gradient(stops, 8, "horizontal");
+}
+
+static void gradient_frame(uint32_t i)
+{
+    LV_UNUSED(i);
+}
+
+/////////////////////////////////////////////////////////////
+// Scene: recolored PNG icons over a solid background
+/////////////////////////////////////////////////////////////
+static void icons_setup(void)
+{
+    static const char * const colors[] = {"red", "cyan", "lime", "orange", "magenta", "white"};
+    chinScreen_background_solid("navy");
+    for(int i = 0; i < 6; i++) {
+        scene_add(chinScreen_icon("home", 1.0f, "middle", "center", colors[i], (i % 2) * 128, (i / 2) * 144));
+    }
+}
+
+static void icons_frame(uint32_t i)
+{
+    static const char * const colors[] = {"yellow", "pink", "skyblue", "gold"};
+    chinScreen_icon_set_color(scene_objs[i % scene_obj_cnt], colors[i % 4]);
+}
+
+/////////////////////////////////////////////////////////////
+// Scene: a grid of GIFs playing
+/////////////////////////////////////////////////////////////
+static void gif_setup(void)
+{
+    static const struct {
+        const unsigned char * data;
+        const unsigned int * len;
+    } gifs[] = {
+        {gear_1_gif, &gear_1_gif_len},
+        {gear_2_gif, &gear_2_gif_len},
+        {gear_3_gif, &gear_3_gif_len},
+    };
+
+    chinScreen_background_solid("black");
+    for(int i = 0; i < 12; i++) {
+        lv_obj_t * gif = chinScreen_gif(gifs[i % 3].data, *gifs[i % 3].len);
+        chinScreen_set_position(gif, 16 + (i % 3) * 104 - (LV_HOR_RES - 64) / 2, 24 + (i / 3) * 112 - (LV_VER_RES - 64) / 2);
+        scene_add(gif);
+    }
+}
+
+static void gif_frame(uint32_t i)
+{
+    LV_UNUSED(i);
+}
+
+/////////////////////////////////////////////////////////////
+// Scene: a dashboard of labels, a third of the values change every frame
+/////////////////////////////////////////////////////////////
+static void dashboard_setup(void)
+{
+    static const char * const sizes[] = {"small", "medium", "large"};
+    char buf[32];
+
+    chinScreen_background_solid("black");
+    chinScreen_text("chinScreen dashboard", 10, 4, "white", "xlarge");
+    for(int i = 0; i < 24; i++) {
+        const int x = 10 + (i % 2) * 160;
+        const int y = 40 + (i / 2) * 36;
+        snprintf(buf, sizeof(buf), "sensor %02d", i);
+        chinScreen_text(buf, x, y, "gray", "small");
+        chinScreen_text("0.00", x, y + 14, "lime", sizes[i % 3]);
+    }
+
+    /*Keep the value labels, the second of each pair*/
+    lv_obj_t * scr = lv_scr_act();
+    for(uint32_t c = 2; c < lv_obj_get_child_cnt(scr); c += 2) scene_add(lv_obj_get_child(scr, c));
+}
+
+static void dashboard_frame(uint32_t i)
+{
+    for(uint32_t c = i % 3; c < scene_obj_cnt; c += 3) {
+        const uint32_t v = (i * 7919 + c * 104729) % 100000;
+        lv_label_set_text_fmt(scene_objs[c], "%" LV_PRIu32 ".%02" LV_PRIu32, v / 100, v % 100);
+    }
+}
+
+/////////////////////////////////////////////////////////////
+// Scene: 100 readings updated at 10 Hz, every label every third frame
+/////////////////////////////////////////////////////////////
+static int32_t readings[100];
+
+/*A random walk in tenths, the same on every run*/
+static int32_t reading_step(uint32_t i, uint32_t c)
+{
+    int32_t v = readings[c] + (int32_t)((i * 7919 + c * 104729) % 7) - 3;
+    readings[c] = LV_CLAMP(0, v, 9999);
+    return readings[c];
+}
+
+static void readings_setup(bool numlabels)
+{
+    chinScreen_background_solid("black");
+    lv_obj_t * scr = lv_scr_act();
+    for(int c = 0; c < 100; c++) {
+        const int x = 4 + (c % 4) * 80;
+        const int y = 2 + (c / 4) * 19;
+        readings[c] = 200 + c * 7;
+        if(numlabels) {
+            scene_add(chinScreen_number("%5.1f\xC2\xB0" "C", x, y, "lime", "small"));
+        }
+        else {
+            chinScreen_text("0.0\xC2\xB0" "C", x, y, "lime", "small");
+            scene_add(lv_obj_get_child(scr, lv_obj_get_child_cnt(scr) - 1));
+        }
+    }
+}
+
+static void numlabels_setup(void)
+{
+    readings_setup(true);
+}
+
+static void numlabels_frame(uint32_t i)
+{
+    for(uint32_t c = i % 3; c < scene_obj_cnt; c += 3) {
+        lv_numlabel_set_value_float(scene_objs[c], (float)reading_step(i, c) / 10);
+    }
+}
+
+static void labels_setup(void)
+{
+    readings_setup(false);
+}
+
+static void labels_frame(uint32_t i)
+{
+    for(uint32_t c = i % 3; c < scene_obj_cnt; c += 3) {
+        const int32_t v = reading_step(i, c);
+        lv_label_set_text_fmt(scene_objs[c], "%" LV_PRId32 ".%" LV_PRId32 "\xC2\xB0" "C", v / 10, v % 10);
+    }
+}
+
+/////////////////////////////////////////////////////////////
+// Scene: rounded cards with drop shadows
+/////////////////////////////////////////////////////////////
+static void shadows_setup(void)
+{
+    static const char * const colors[] = {"steelblue", "seagreen", "darkorange", "slateblue"};
+    chinScreen_background_solid("gainsboro");
+    for(int i = 0; i < 8; i++) {
+        lv_obj_t * card = chinScreen_rectangle(colors[i % 4], "white", 130, 90);
+        bsp_display_lock(0);
+        lv_obj_set_style_radius(card, 16, LV_PART_MAIN);
+        lv_obj_set_style_shadow_width(card, 24, LV_PART_MAIN);
+        lv_obj_set_style_shadow_ofs_y(card, 6, LV_PART_MAIN);
+        lv_obj_set_style_shadow_opa(card, LV_OPA_50, LV_PART_MAIN);
+        lv_obj_set_style_shadow_color(card, lv_color_black(), LV_PART_MAIN);
+        lv_obj_align(card, LV_ALIGN_TOP_LEFT, 20 + (i % 2) * 150, 15 + (i / 2) * 115);
+        bsp_display_unlock();
+        scene_add(card);
+    }
+}
+
+static void shadows_frame(uint32_t i)
+{
+    LV_UNUSED(i);
+}
+
+/////////////////////////////////////////////////////////////
+// Scenes: a full screen photo, a 320x480 baseline JPEG like a camera writes
+/////////////////////////////////////////////////////////////
+static void jpeg_make(void)
+{
+    uint8_t * rgb = (uint8_t *)malloc(LV_HOR_RES * LV_VER_RES * 3);
+    lv_test_jpeg_fill_photo(rgb, LV_HOR_RES, LV_VER_RES, 17);
+    const lv_test_jpeg_cfg_t cfg = {85, LV_TEST_JPEG_420, 0};
+    uint32_t size = 0;
+    jpeg_data = lv_test_jpeg_encode(rgb, LV_HOR_RES, LV_VER_RES, &cfg, &size);
+    free(rgb);
+
+    memset(&jpeg_dsc, 0, sizeof(jpeg_dsc));
+    jpeg_dsc.header.cf = LV_IMG_CF_RAW;
+    jpeg_dsc.header.w = LV_HOR_RES;
+    jpeg_dsc.header.h = LV_VER_RES;
+    jpeg_dsc.data_size = size;
+    jpeg_dsc.data = jpeg_data;
+
+    FILE * f = fopen(BENCH_JPEG_FILE, "wb");
+    if(f) {
+        fwrite(jpeg_data, 1, size, f);
+        fclose(f);
+    }
+}
+
+static void jpeg_setup(void)
+{
+    scene_add(chinScreen_image_local(&jpeg_dsc, 0, 0));
+}
+
+static void jpeg_sd_setup(void)
+{
+    scene_add(chinScreen_image("S:" BENCH_JPEG_FILE, false, 0, 0));
+}
+
+/*A clock over the photo, only the band behind it is redrawn*/
+static void jpeg_clock_setup(void)
+{
+    jpeg_setup();
+    chinScreen_text("00:00", 110, 220, "white", "xlarge");
+    lv_obj_t * scr = lv_scr_act();
+    scene_add(lv_obj_get_child(scr, lv_obj_get_child_cnt(scr) - 1));
+}
+
+static void jpeg_clock_frame(uint32_t i)
+{
+    lv_label_set_text_fmt(scene_objs[1], "%02" LV_PRIu32 ":%02" LV_PRIu32, i / 60 % 60, i % 60);
+}
+
+/////////////////////////////////////////////////////////////
+// Scene: true color images zoomed and rotated every frame
+/////////////////////////////////////////////////////////////
+static void transform_setup(void)
+{
+    for(int y = 0; y < BENCH_IMG_SIZE; y++) {
+        for(int x = 0; x < BENCH_IMG_SIZE; x++) {
+            lv_color_t c = ((x / 12 + y / 12) & 1) ? lv_color_make(x * 255 / BENCH_IMG_SIZE, 64, y * 255 / BENCH_IMG_SIZE)
+                           : lv_color_white();
+            transform_px[y * BENCH_IMG_SIZE + x] = c.full;
+        }
+    }
+    memset(&transform_dsc, 0, sizeof(transform_dsc));
+    transform_dsc.header.cf = LV_IMG_CF_TRUE_COLOR;
+    transform_dsc.header.w = BENCH_IMG_SIZE;
+    transform_dsc.header.h = BENCH_IMG_SIZE;
+    transform_dsc.data_size = sizeof(transform_px);
+    transform_dsc.data = (const uint8_t *)transform_px;
+
+    chinScreen_background_solid("darkslategray");
+    for(int i = 0; i < 4; i++) {
+        scene_add(chinScreen_image_local(&transform_dsc, 40 + (i % 2) * 144, 60 + (i / 2) * 200));
+    }
+}
+
+static void transform_frame(uint32_t i)
+{
+    for(uint32_t c = 0; c < scene_obj_cnt; c++) {
+        lv_img_set_angle(scene_objs[c], (int16_t)((i * 70 + c * 450) % 3600));
+        lv_img_set_zoom(scene_objs[c], (uint16_t)(192 + ((i + c * 16) % 64) * 2));
+    }
+}
+
+/////////////////////////////////////////////////////////////
+// Scene: the same images only zoomed, like zoomed icons and sprites
+/////////////////////////////////////////////////////////////
+static void zoom_setup(void)
+{
+    static const uint16_t zooms[] = {512, 128, 768, 384};
+    transform_setup();
+    for(uint32_t c = 0; c < scene_obj_cnt; c++) lv_img_set_zoom(scene_objs[c], zooms[c % 4]);
+}
+
+static const bench_scene_t bench_scenes[] = {
+    {"multi_gradient", "chinScreen_background_rainbow(): 7 stop vertical multi gradient", gradient_setup, gradient_frame, true},
+    {"multi_gradient_hor", "8 stop horizontal multi gradient", gradient_hor_setup, gradient_frame, true},
+    {"icons_recolor", "6 PNG icons 192x192 with recolor, one recolored per frame", icons_setup, icons_frame, true},
+    {"gif_playback", "12 GIFs 64x64 playing", gif_setup, gif_frame, false},
+    {"label_dashboard", "49 labels, 8 values updated per frame", dashboard_setup, dashboard_frame, false},
+    {"readings_numlabel", "100 lv_numlabel readings %5.1f\xC2\xB0" "C at 10 Hz", numlabels_setup, numlabels_frame, false},
+    {"readings_label", "the same 100 readings with lv_label_set_text_fmt()", labels_setup, labels_frame, false},
+    {"rounded_shadows", "8 rounded rectangles with 24 px shadows", shadows_setup, shadows_frame, true},
+    {"image_transform", "4 RGB565 images 96x96, zoomed and rotated per frame", transform_setup, transform_frame, false},
+    {"image_zoom", "4 RGB565 images 96x96 zoomed 2x, 0.5x, 3x and 1.5x", zoom_setup, gradient_frame, true},
+    {"jpeg_photo", "320x480 baseline JPEG (4:2:0) from a C array", jpeg_setup, gradient_frame, true},
+    {"jpeg_photo_sd", "320x480 baseline JPEG (4:2:0) from a file", jpeg_sd_setup, gradient_frame, true},
+    {"jpeg_photo_clock", "320x480 baseline JPEG with a clock label updated per frame", jpeg_clock_setup, jpeg_clock_frame, false},
+};
+
+static void bench_run(const bench_scene_t * scene, uint32_t warmup, uint32_t frames, bench_result_t * res)
+{
+    chinScreen_clear();
+    lv_img_cache_invalidate_src(NULL);      /*Every run opens its images again*/
+    scene_obj_cnt = 0;
+    const size_t heap_base = heap_in_use;
+    heap_peak = heap_base;
+    scene->setup();
+
+    bsp_display_lock(0);
+    lv_obj_t * scr = lv_scr_act();
+    lv_refr_now(NULL);
+
+    memset(res, 0, sizeof(*res));
+    res->frames = frames;
+    uint64_t start_us = 0;
+    for(uint32_t i = 0; i < warmup + frames; i++) {
+        if(i == warmup) {
+            lvgl_port_perf_reset();
+            start_us = bench_now_us();
+        }
+        scene->frame(i);
+        if(scene->full_redraw) lv_obj_invalidate(scr);
+        lv_tick_inc(BENCH_FRAME_MS);
+        lv_timer_handler();     /*Animations and GIF timers, might already refresh*/
+        lv_refr_now(NULL);
+    }
+    res->wall_us = bench_now_us() - start_us;
+    bsp_display_unlock();
+
+    lvgl_port_perf_get(LVGL_PORT_PERF_RENDER_US, &res->render_us);
+    lvgl_port_perf_get(LVGL_PORT_PERF_FLUSH_US, &res->flush_us);
+    lvgl_port_perf_get(LVGL_PORT_PERF_PIXELS, &res->px);
+    res->rendered = res->render_us.total;
+    res->heap_peak = heap_peak - heap_base;
+}
+
+static void bench_json_scene(FILE * f, const bench_scene_t * scene, const bench_result_t * res, bool last)
+{
+    const double fps = res->wall_us ? res->frames * 1e6 / res->wall_us : 0.0;
+    const double ns_per_px = res->px.avg ? res->render_us.avg * 1000.0 / res->px.avg : 0.0;
+
+    fprintf(f, "    {\n");
+    fprintf(f, "      \"name\": \"%s\",\n", scene->name);
+    fprintf(f, "      \"desc\": \"%s\",\n", scene->desc);
+    fprintf(f, "      \"frames\": %u,\n", (unsigned)res->frames);
+    fprintf(f, "      \"frames_rendered\": %u,\n", (unsigned)res->rendered);
+    fprintf(f, "      \"fps\": %.1f,\n", fps);
+    fprintf(f, "      \"ns_per_px\": %.2f,\n", ns_per_px);
+    fprintf(f, "      \"px_per_frame\": %u,\n", (unsigned)res->px.avg);
+    fprintf(f, "      \"render_us\": {\"min\": %u, \"avg\": %u, \"p99\": %u, \"max\": %u},\n",
+            (unsigned)res->render_us.min, (unsigned)res->render_us.avg, (unsigned)res->render_us.p99,
+            (unsigned)res->render_us.max);
+    fprintf(f, "      \"flush_us\": {\"avg\": %u, \"p99\": %u},\n", (unsigned)res->flush_us.avg,
+            (unsigned)res->flush_us.p99);
+    fprintf(f, "      \"heap_peak\": %u\n", (unsigned)res->heap_peak);
+    fprintf(f, "    }%s\n", last ? "" : ",");
+}
+
+/////////////////////////////////////////////////////////////
+// GIF decoding without drawing, --gifs
+/////////////////////////////////////////////////////////////
+static uint8_t * bench_read_file(const char * path, size_t * len)
+{
+    FILE * f = fopen(path, "rb");
+    if(!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    *len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t * data = (uint8_t *)malloc(*len);
+    if(data && fread(data, 1, *len, f) != *len) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    return data;
+}
+
+/*Decode `frames` frames, rewinding at the end, the way lv_gif steps a GIF. Returns the time in us, 0 on error*/
+static uint64_t bench_gif_decode(gd_GIF * gif, uint32_t frames)
+{
+    gd_rewind(gif);
+    const uint64_t start_us = bench_now_us();
+    for(uint32_t i = 0; i < frames;) {
+        int res = gd_get_frame(gif);
+        if(res < 0) return 0;
+        if(res == 0) {
+            gd_rewind(gif);
+            continue;
+        }
+        gd_render_frame(gif, gif->canvas);
+        i++;
+    }
+    return bench_now_us() - start_us;
+}
+
+static int bench_gifs(FILE * report, uint32_t frames, uint32_t repeat)
+{
+    static const char * const dirs[] = {"icons/ani", "sprites"};
+    char names[64][64];
+    uint32_t cnt = 0;
+
+    for(uint32_t d = 0; d < sizeof(dirs) / sizeof(dirs[0]); d++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", BENCH_ASSET_DIR, dirs[d]);
+        DIR * dir = opendir(path);
+        if(!dir) {
+            perror(path);
+            return 1;
+        }
+        struct dirent * e;
+        while((e = readdir(dir)) != NULL && cnt < 64) {
+            const size_t n = strlen(e->d_name);
+            if(n < 5 || strcmp(e->d_name + n - 4, ".gif")) continue;
+            snprintf(names[cnt++], sizeof(names[0]), "%s/%.40s", dirs[d], e->d_name);
+        }
+        closedir(dir);
+    }
+    qsort(names, cnt, sizeof(names[0]), (int (*)(const void *, const void *))strcmp);
+
+    fprintf(report, "  \"scenes\": [\n");
+    jpeg_make();        /*Outside of the scenes, heap_peak only counts what drawing the photo takes*/
+    uint64_t total_us = 0;
+    int ret = 0;
+    for(uint32_t i = 0; i < cnt; i++) {
+        char path[512];
+        size_t len;
+        snprintf(path, sizeof(path), "%s/%.63s", BENCH_ASSET_DIR, names[i]);
+        uint8_t * data = bench_read_file(path, &len);
+        gd_GIF * gif = data ? gd_open_gif_data(data) : NULL;
+        uint64_t best_us = 0;
+        for(uint32_t r = 0; gif && r < repeat; r++) {
+            const uint64_t us = bench_gif_decode(gif, frames);
+            if(us == 0) break;
+            if(best_us == 0 || us < best_us) best_us = us;
+        }
+        if(best_us == 0) {
+            fprintf(stderr, "bench: can't decode %s\n", names[i]);
+            ret = 1;
+        }
+        else {
+            const uint32_t px = (uint32_t)gif->width * gif->height;
+            fprintf(report, "    {\n");
+            fprintf(report, "      \"name\": \"gif:%s\",\n", names[i]);
+            fprintf(report, "      \"desc\": \"%ux%u, decoded from memory\",\n", (unsigned)gif->width, (unsigned)gif->height);
+            fprintf(report, "      \"frames\": %u,\n", (unsigned)frames);
+            fprintf(report, "      \"fps\": %.1f,\n", frames * 1e6 / best_us);
+            fprintf(report, "      \"ns_per_px\": %.2f,\n", best_us * 1000.0 / ((double)frames * px));
+            fprintf(report, "      \"px_per_frame\": %u\n", (unsigned)px);
+            fprintf(report, "    },\n");
+            total_us += best_us;
+        }
+        if(gif) gd_close_gif(gif);
+        free(data);
+    }
+    fprintf(report, "    {\n");
+    fprintf(report, "      \"name\": \"gif:all\",\n");
+    fprintf(report, "      \"desc\": \"%u GIFs one after the other\",\n", (unsigned)cnt);
+    fprintf(report, "      \"frames\": %u,\n", (unsigned)(frames * cnt));
+    fprintf(report, "      \"fps\": %.1f,\n", total_us ? frames * cnt * 1e6 / total_us : 0.0);
+    fprintf(report, "      \"ns_per_px\": 0\n");
+    fprintf(report, "    }\n");
+    fprintf(report, "  ]\n}\n");
+    return ret;
+}
+
+/////////////////////////////////////////////////////////////
+// Blend kernels without the rest of the rendering, --kernels
+/////////////////////////////////////////////////////////////
+typedef struct {
+    const char * name;
+    const lv_draw_sw_blend_kernels_t * kernels;
+} bench_kernel_set_t;
+
+typedef enum {
+    BENCH_FILL_OPA,
+    BENCH_FILL_MASK,
+    BENCH_MAP_OPA,
+    BENCH_MAP_MASK,
+    BENCH_KERNEL_CNT,
+} bench_kernel_t;
+
+static lv_color_t kernel_dest[BENCH_KERNEL_W * BENCH_KERNEL_H];
+static lv_color_t kernel_src[BENCH_KERNEL_W * BENCH_KERNEL_H];
+static lv_opa_t kernel_mask[BENCH_KERNEL_W * BENCH_KERNEL_H];
+
+/*A photo like source and background, and a mask with transparent and covering runs between anti-aliased edges*/
+static void bench_kernel_data(void)
+{
+    for(uint32_t y = 0; y < BENCH_KERNEL_H; y++) {
+        for(uint32_t x = 0; x < BENCH_KERNEL_W; x++) {
+            const uint32_t i = y * BENCH_KERNEL_W + x;
+            kernel_dest[i] = lv_color_make(x * 255 / BENCH_KERNEL_W, y * 255 / BENCH_KERNEL_H, (x * y) & 0xff);
+            kernel_src[i] = lv_color_make((x ^ y) & 0xff, (x + 2 * y) & 0xff, 255 - x * 255 / BENCH_KERNEL_W);
+            const uint32_t m = (x + y) % 80;
+            kernel_mask[i] = m < 24 ? LV_OPA_TRANSP : m < 40 ? (lv_opa_t)((m - 24) * 16) : m < 72 ? LV_OPA_COVER :
+                             (lv_opa_t)(255 - (m - 72) * 32);
+        }
+    }
+}
+
+static void bench_kernel_call(const lv_draw_sw_blend_kernels_t * k, bench_kernel_t kernel, lv_color_t * dest)
+{
+    lv_area_t area;
+    lv_area_set(&area, 0, 0, BENCH_KERNEL_W - 1, BENCH_KERNEL_H - 1);
+    switch(kernel) {
+        case BENCH_FILL_OPA:
+            k->fill_opa(dest, &area, BENCH_KERNEL_W, lv_palette_main(LV_PALETTE_BLUE), LV_OPA_60);
+            break;
+        case BENCH_FILL_MASK:
+            k->fill_mask(dest, &area, BENCH_KERNEL_W, lv_palette_main(LV_PALETTE_BLUE), LV_OPA_COVER,
+                         kernel_mask, BENCH_KERNEL_W);
+            break;
+        case BENCH_MAP_OPA:
+            k->map_opa(dest, &area, BENCH_KERNEL_W, kernel_src, BENCH_KERNEL_W, LV_OPA_60);
+            break;
+        default:
+            k->map_mask(dest, &area, BENCH_KERNEL_W, kernel_src, BENCH_KERNEL_W, LV_OPA_COVER,
+                        kernel_mask, BENCH_KERNEL_W);
+            break;
+    }
+}
+
+static int bench_kernels(FILE * report, uint32_t frames, uint32_t repeat)
+{
+    static const char * const kernel_names[] = {"fill_opa", "fill_mask", "map_opa", "map_mask"};
+    static const bench_kernel_set_t sets[] = {
+        {"ref", &lv_draw_sw_blend_kernels_ref},
+#if LV_DRAW_SW_BLEND_565
+        {"swar", &lv_draw_sw_blend_565_swar_kernels},
+#endif
+#if LV_DRAW_SW_BLEND_565_VECTOR
+        {"vector", &lv_draw_sw_blend_565_vector_kernels},
+#endif
+    };
+    const uint32_t set_cnt = sizeof(sets) / sizeof(sets[0]);
+    static lv_color_t ref[BENCH_KERNEL_W * BENCH_KERNEL_H];
+    static lv_color_t test[BENCH_KERNEL_W * BENCH_KERNEL_H];
+    const uint32_t px = BENCH_KERNEL_W * BENCH_KERNEL_H;
+
+    bench_kernel_data();
+    fprintf(report, "  \"scenes\": [\n");
+    int ret = 0;
+    for(uint32_t k = 0; k < BENCH_KERNEL_CNT; k++) {
+        lv_memcpy(ref, kernel_dest, sizeof(ref));
+        bench_kernel_call(&lv_draw_sw_blend_kernels_ref, (bench_kernel_t)k, ref);
+
+        for(uint32_t s = 0; s < set_cnt; s++) {
+            lv_memcpy(test, kernel_dest, sizeof(test));
+            bench_kernel_call(sets[s].kernels, (bench_kernel_t)k, test);
+            if(memcmp(ref, test, sizeof(ref))) {
+                fprintf(stderr, "bench: %s of %s differs from ref\n", kernel_names[k], sets[s].name);
+                ret = 1;
+            }
+
+            /*Blending on the previous result keeps the background changing like a real one*/
+            uint64_t best_us = 0;
+            for(uint32_t r = 0; r < repeat; r++) {
+                lv_memcpy(test, kernel_dest, sizeof(test));
+                const uint64_t start_us = bench_now_us();
+                for(uint32_t i = 0; i < frames; i++) bench_kernel_call(sets[s].kernels, (bench_kernel_t)k, test);
+                const uint64_t us = bench_now_us() - start_us;
+                if(r == 0 || us < best_us) best_us = us;
+            }
+            if(best_us == 0) best_us = 1;
+
+            const bool last = k == BENCH_KERNEL_CNT - 1 && s == set_cnt - 1;
+            fprintf(report, "    {\n");
+            fprintf(report, "      \"name\": \"blend:%s:%s\",\n", kernel_names[k], sets[s].name);
+            fprintf(report, "      \"desc\": \"%ux%u, %s kernels\",\n", (unsigned)BENCH_KERNEL_W,
+                    (unsigned)BENCH_KERNEL_H, sets[s].name);
+            fprintf(report, "      \"frames\": %u,\n", (unsigned)frames);
+            fprintf(report, "      \"fps\": %.1f,\n", frames * 1e6 / best_us);
+            fprintf(report, "      \"ns_per_px\": %.2f,\n", best_us * 1000.0 / ((double)frames * px));
+            fprintf(report, "      \"px_per_frame\": %u\n", (unsigned)px);
+            fprintf(report, "    }%s\n", last ? "" : ",");
+        }
+    }
+    fprintf(report, "  ]\n}\n");
+    return ret;
+}
+
+/////////////////////////////////////////////////////////////
+// Zooming without the rest of the rendering, --transforms
+/////////////////////////////////////////////////////////////
+static void bench_transform_call(const lv_area_t * area, const lv_draw_img_dsc_t * dsc, lv_color_t * cbuf,
+                                 lv_opa_t * abuf)
+{
+    lv_draw_sw_transform(NULL, area, transform_px, BENCH_IMG_SIZE, BENCH_IMG_SIZE, BENCH_IMG_SIZE, dsc,
+                         LV_IMG_CF_TRUE_COLOR, cbuf, abuf);
+}
+
+/*Transparent pixels keep whatever color the buffer had, like aa_px() leaves them*/
+static bool bench_transform_same(const lv_color_t * ref_c, const lv_opa_t * ref_a, const lv_color_t * cbuf,
+                                 const lv_opa_t * abuf, uint32_t px)
+{
+    if(memcmp(ref_a, abuf, px)) return false;
+    for(uint32_t i = 0; i < px; i++) {
+        if(ref_a[i] && ref_c[i].full != cbuf[i].full) return false;
+    }
+    return true;
+}
+
+static int bench_transforms(FILE * report, uint32_t frames, uint32_t repeat)
+{
+    static const struct {
+        const char * name;
+        uint16_t zoom;
+    } zooms[] = {{"2x", 512}, {"3x", 768}, {"0.5x", 128}, {"1.5x", 384}};
+    static const char * const path_names[] = {"generic", "separable", "integer"};
+    const uint32_t zoom_cnt = sizeof(zooms) / sizeof(zooms[0]);
+    static lv_color_t ref_c[BENCH_KERNEL_W * BENCH_KERNEL_H];
+    static lv_opa_t ref_a[BENCH_KERNEL_W * BENCH_KERNEL_H];
+    static lv_color_t cbuf[BENCH_KERNEL_W * BENCH_KERNEL_H];
+    static lv_opa_t abuf[BENCH_KERNEL_W * BENCH_KERNEL_H];
+
+    transform_setup();      /*Only for the pixels of the image*/
+    chinScreen_clear();
+    const lv_draw_sw_transform_path_t path_def = lv_draw_sw_transform_get_path();
+
+    fprintf(report, "  \"scenes\": [\n");
+    int ret = 0;
+    for(uint32_t z = 0; z < zoom_cnt; z++) {
+        for(uint32_t aa = 0; aa < 2; aa++) {
+            lv_draw_img_dsc_t dsc;
+            lv_draw_img_dsc_init(&dsc);
+            dsc.zoom = zooms[z].zoom;
+            dsc.pivot.x = 0;
+            dsc.pivot.y = 0;
+            dsc.antialias = aa;
+
+            /*The top left part of the zoomed image*/
+            const lv_coord_t size = (lv_coord_t)(BENCH_IMG_SIZE * zooms[z].zoom / LV_IMG_ZOOM_NONE);
+            lv_area_t area;
+            lv_area_set(&area, 0, 0, LV_MIN(size, BENCH_KERNEL_W) - 1, LV_MIN(size, BENCH_KERNEL_H) - 1);
+            const uint32_t px = lv_area_get_size(&area);
+
+            lv_draw_sw_transform_set_path(LV_DRAW_SW_TRANSFORM_GENERIC);
+            bench_transform_call(&area, &dsc, ref_c, ref_a);
+
+            for(uint32_t p = LV_DRAW_SW_TRANSFORM_GENERIC; p <= LV_DRAW_SW_TRANSFORM_INTEGER; p++) {
+                lv_draw_sw_transform_set_path((lv_draw_sw_transform_path_t)p);
+                bench_transform_call(&area, &dsc, cbuf, abuf);
+                if(p == LV_DRAW_SW_TRANSFORM_SEPARABLE && !bench_transform_same(ref_c, ref_a, cbuf, abuf, px)) {
+                    fprintf(stderr, "bench: %s zoom of the separable path differs from generic\n", zooms[z].name);
+                    ret = 1;
+                }
+
+                uint64_t best_us = 0;
+                for(uint32_t r = 0; r < repeat; r++) {
+                    const uint64_t start_us = bench_now_us();
+                    for(uint32_t i = 0; i < frames; i++) bench_transform_call(&area, &dsc, cbuf, abuf);
+                    const uint64_t us = bench_now_us() - start_us;
+                    if(r == 0 || us < best_us) best_us = us;
+                }
+                if(best_us == 0) best_us = 1;
+
+                const bool last = z == zoom_cnt - 1 && aa == 1 && p == LV_DRAW_SW_TRANSFORM_INTEGER;
+                fprintf(report, "    {\n");
+                fprintf(report, "      \"name\": \"zoom:%s:%s:%s\",\n", zooms[z].name, aa ? "aa" : "no_aa",
+                        path_names[p]);
+                fprintf(report, "      \"desc\": \"%dx%d RGB565 image zoomed %s into %dx%d, %s path\",\n",
+                        BENCH_IMG_SIZE, BENCH_IMG_SIZE, zooms[z].name, (int)lv_area_get_width(&area),
+                        (int)lv_area_get_height(&area), path_names[p]);
+                fprintf(report, "      \"frames\": %u,\n", (unsigned)frames);
+                fprintf(report, "      \"fps\": %.1f,\n", frames * 1e6 / best_us);
+                fprintf(report, "      \"ns_per_px\": %.2f,\n", best_us * 1000.0 / ((double)frames * px));
+                fprintf(report, "      \"px_per_frame\": %u\n", (unsigned)px);
+                fprintf(report, "    }%s\n", last ? "" : ",");
+            }
+        }
+    }
+    fprintf(report, "  ]\n}\n");
+    lv_draw_sw_transform_set_path(path_def);
+    return ret;
+}
+
+/////////////////////////////////////////////////////////////
+// Glyph look up of text layout, --fonts
+/////////////////////////////////////////////////////////////
+static int bench_fonts(FILE * report, uint32_t frames, uint32_t repeat)
+{
+    static const struct {
+        const char * name;
+        const lv_font_t * font;
+    } fonts[] = {{"aladin", FONT_ALADIN}, {"creepy", FONT_CREEPY}, {"cursive", FONT_CURSIVE}};
+    static const char * const texts[] = {
+        "Temperature 23.5\xC2\xB0" "C", "Humidity 48 %", "WiFi: connected", "Batterie \xC3\xA0 87 %",
+        "AVAWAY Today, 12:45", "Pr\xC3\xA9sence d\xC3\xA9tect\xC3\xA9" "e",
+    };
+    const uint32_t font_cnt = sizeof(fonts) / sizeof(fonts[0]);
+    const uint32_t text_cnt = sizeof(texts) / sizeof(texts[0]);
+
+    uint32_t letters = 0;
+    for(uint32_t t = 0; t < text_cnt; t++) letters += _lv_txt_get_encoded_length(texts[t]);
+
+    fprintf(report, "  \"scenes\": [\n");
+    int ret = 0;
+    for(uint32_t f = 0; f < font_cnt; f++) {
+        /*The same font with the callbacks of lv_font_fmt_txt.c*/
+        lv_font_t cmap = *fonts[f].font;
+        cmap.get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
+        cmap.get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+        const lv_font_t * const variants[] = {&cmap, fonts[f].font};
+        static const char * const variant_names[] = {"cmap", "lut"};
+
+        for(uint32_t v = 0; v < 2; v++) {
+            for(uint32_t t = 0; t < text_cnt; t++) {
+                const uint32_t len = strlen(texts[t]);
+                if(lv_txt_get_width(texts[t], len, variants[v], 0, LV_TEXT_FLAG_NONE) !=
+                   lv_txt_get_width(texts[t], len, &cmap, 0, LV_TEXT_FLAG_NONE)) {
+                    fprintf(stderr, "bench: \"%s\" in %s is measured differently with the tables\n", texts[t],
+                            fonts[f].name);
+                    ret = 1;
+                }
+            }
+
+            uint64_t best_us = 0;
+            volatile lv_coord_t sink = 0;
+            for(uint32_t r = 0; r < repeat; r++) {
+                const uint64_t start_us = bench_now_us();
+                for(uint32_t i = 0; i < frames; i++) {
+                    for(uint32_t t = 0; t < text_cnt; t++) {
+                        sink = sink + lv_txt_get_width(texts[t], strlen(texts[t]), variants[v], 0, LV_TEXT_FLAG_NONE);
+                    }
+                }
+                const uint64_t us = bench_now_us() - start_us;
+                if(r == 0 || us < best_us) best_us = us;
+            }
+            if(best_us == 0) best_us = 1;
+
+            const bool last = f == font_cnt - 1 && v == 1;
+            fprintf(report, "    {\n");
+            fprintf(report, "      \"name\": \"glyphs:%s:%s\",\n", fonts[f].name, variant_names[v]);
+            fprintf(report, "      \"desc\": \"width of %u strings, %u letters, looked up %s\",\n",
+                    (unsigned)text_cnt, (unsigned)letters, v ? "in the direct look up tables" : "in the cmaps");
+            fprintf(report, "      \"frames\": %u,\n", (unsigned)frames);
+            fprintf(report, "      \"fps\": %.1f,\n", frames * 1e6 / best_us);
+            fprintf(report, "      \"ns_per_px\": %.2f,\n", best_us * 1000.0 / ((double)frames * letters));
+            fprintf(report, "      \"px_per_frame\": %u\n", (unsigned)letters);
+            fprintf(report, "    }%s\n", last ? "" : ",");
+        }
+    }
+    fprintf(report, "  ]\n}\n");
+    return ret;
+}
+
+/////////////////////////////////////////////////////////////
+// Name look up of the string API, --names
+/////////////////////////////////////////////////////////////
+
+/*A compare per known name, like getColorByName(), getFontBySize() and the alignments did*/
+static int bench_scan_color(const char * name)
+{
+    for(uint32_t i = 0; i < CHINSCREEN_COLOR_COUNT; i++) {
+        const char * p1 = name;
+        const char * p2 = colorNames[i];
+        while(*p1 && *p2 && tolower(*p1) == tolower(*p2)) {
+            p1++;
+            p2++;
+        }
+        if(*p1 == '\0' && *p2 == '\0') return i;
+    }
+    return -1;
+}
+
+static int bench_scan_font(const char * name)
+{
+    for(uint32_t i = 0; i < CHINSCREEN_FONT_COUNT; i++) {
+        if(strcmp(name, chinScreen_fonts[i].name) == 0) return i;
+    }
+    return -1;
+}
+
+static int bench_scan_align(const char * name)
+{
+    const char * vAlign = name;
+    const char * hAlign = name + strlen(name) + 1;
+    lv_align_t align = LV_ALIGN_CENTER;
+    if(strcmp(vAlign, "top") == 0 && strcmp(hAlign, "left") == 0) align = LV_ALIGN_TOP_LEFT;
+    else if(strcmp(vAlign, "top") == 0 && strcmp(hAlign, "center") == 0) align = LV_ALIGN_TOP_MID;
+    else if(strcmp(vAlign, "top") == 0 && strcmp(hAlign, "right") == 0) align = LV_ALIGN_TOP_RIGHT;
+    else if(strcmp(vAlign, "middle") == 0 && strcmp(hAlign, "left") == 0) align = LV_ALIGN_LEFT_MID;
+    else if(strcmp(vAlign, "middle") == 0 && strcmp(hAlign, "center") == 0) align = LV_ALIGN_CENTER;
+    else if(strcmp(vAlign, "middle") == 0 && strcmp(hAlign, "right") == 0) align = LV_ALIGN_RIGHT_MID;
+    else if(strcmp(vAlign, "bottom") == 0 && strcmp(hAlign, "left") == 0) align = LV_ALIGN_BOTTOM_LEFT;
+    else if(strcmp(vAlign, "bottom") == 0 && strcmp(hAlign, "center") == 0) align = LV_ALIGN_BOTTOM_MID;
+    else if(strcmp(vAlign, "bottom") == 0 && strcmp(hAlign, "right") == 0) align = LV_ALIGN_BOTTOM_RIGHT;
+    return align;
+}
+
+static int bench_phash_color(const char * name)
+{
+    return chinScreen_phash_find(colorTable, colorNames, CHINSCREEN_COLOR_COUNT, name);
+}
+
+static int bench_phash_font(const char * name)
+{
+    return chinScreen_phash_find(chinScreen_font_table, chinScreen_fonts, CHINSCREEN_FONT_COUNT, name);
+}
+
+static int bench_phash_align(const char * name)
+{
+    return chinScreen_resolve_align(name, name + strlen(name) + 1);
+}
+
+static int bench_names(FILE * report, uint32_t frames, uint32_t repeat)
+{
+    /*The names of bubble_pop and FlyingIconsExample, a few unknown ones and an alignment as "vertical\0horizontal"*/
+    static const char * const colors[] = {
+        "white", "black", "navy", "DeepSkyBlue", "lightblue", "hotpink", "pink", "gold", "orange", "lime",
+        "green", "mediumpurple", "violet", "cyan", "teal", "tomato", "coral", "yellow", "red", "nocolor",
+    };
+    static const char * const fonts[] = {
+        "small", "medium", "large", "xlarge", "small-pixel", "big-pixel", "aladin", "creepy-l", "cursive-s", "huge",
+    };
+    static const char * const aligns[] = {
+        "top\0left", "top\0center", "top\0right", "middle\0left", "middle\0center", "middle\0right",
+        "bottom\0left", "bottom\0center", "bottom\0right", "center\0middle",
+    };
+    static const struct {
+        const char * name;
+        const char * const * names;
+        uint32_t cnt;
+        int (*scan)(const char *);
+        int (*phash)(const char *);
+    } sets[] = {
+        {"color", colors, sizeof(colors) / sizeof(colors[0]), bench_scan_color, bench_phash_color},
+        {"font", fonts, sizeof(fonts) / sizeof(fonts[0]), bench_scan_font, bench_phash_font},
+        {"align", aligns, sizeof(aligns) / sizeof(aligns[0]), bench_scan_align, bench_phash_align},
+    };
+    const uint32_t set_cnt = sizeof(sets) / sizeof(sets[0]);
+    const uint32_t lookups = 100;     /*Per frame, a screen of objects*/
+
+    fprintf(report, "  \"scenes\": [\n");
+    int ret = 0;
+    for(uint32_t s = 0; s < set_cnt; s++) {
+        for(uint32_t n = 0; n < sets[s].cnt; n++) {
+            if(sets[s].scan(sets[s].names[n]) != sets[s].phash(sets[s].names[n])) {
+                fprintf(stderr, "bench: \"%s\" is resolved differently with the hash tables\n", sets[s].names[n]);
+                ret = 1;
+            }
+        }
+
+        for(uint32_t v = 0; v < 2; v++) {
+            int (*resolve)(const char *) = v ? sets[s].phash : sets[s].scan;
+            uint64_t best_us = 0;
+            volatile int sink = 0;
+            for(uint32_t r = 0; r < repeat; r++) {
+                const uint64_t start_us = bench_now_us();
+                for(uint32_t i = 0; i < frames; i++) {
+                    for(uint32_t l = 0; l < lookups; l++) sink = sink + resolve(sets[s].names[l % sets[s].cnt]);
+                }
+                const uint64_t us = bench_now_us() - start_us;
+                if(r == 0 || us < best_us) best_us = us;
+            }
+            if(best_us == 0) best_us = 1;
+
+            const bool last = s == set_cnt - 1 && v == 1;
+            fprintf(report, "    {\n");
+            fprintf(report, "      \"name\": \"names:%s:%s\",\n", sets[s].name, v ? "phash" : "scan");
+            fprintf(report, "      \"desc\": \"%u %s names, looked up %s\",\n", (unsigned)lookups, sets[s].name,
+                    v ? "in the perfect hash table" : "with a compare per known name");
+            fprintf(report, "      \"frames\": %u,\n", (unsigned)frames);
+            fprintf(report, "      \"fps\": %.1f,\n", frames * 1e6 / best_us);
+            fprintf(report, "      \"ns_per_px\": %.2f,\n", best_us * 1000.0 / ((double)frames * lookups));
+            fprintf(report, "      \"px_per_frame\": %u\n", (unsigned)lookups);
+            fprintf(report, "    }%s\n", last ? "" : ",");
+        }
+    }
+    fprintf(report, "  ]\n}\n");
+    return ret;
+}
+
+/////////////////////////////////////////////////////////////
+// TrueType glyphs rasterised and cached, --ttf
+/////////////////////////////////////////////////////////////
+extern "C" const uint8_t ubuntu_font[];
+extern "C" size_t ubuntu_font_size;
+
+static int bench_ttf(FILE * report, uint32_t frames, uint32_t repeat)
+{
+    static const lv_coord_t sizes[] = {16, 24, 48};
+    static const char * const variant_names[] = {"raster", "file", "cached"};
+    const uint32_t size_cnt = sizeof(sizes) / sizeof(sizes[0]);
+    uint32_t letters[95];
+    for(uint32_t i = 0; i < 95; i++) letters[i] = ' ' + i;
+
+    FILE * f = fopen(BENCH_TTF_FILE, "wb");
+    if(f) {
+        fwrite(ubuntu_font, 1, ubuntu_font_size, f);
+        fclose(f);
+    }
+
+    fprintf(report, "  \"scenes\": [\n");
+    int ret = 0;
+    for(uint32_t s = 0; s < size_cnt; s++) {
+        lv_font_t * mem_font = chinScreen_font_from_memory(ubuntu_font, ubuntu_font_size, sizes[s]);
+        lv_font_t * file_font = chinScreen_font_load("S:" BENCH_TTF_FILE, sizes[s]);
+        if(mem_font == NULL || file_font == NULL) {
+            fprintf(stderr, "bench: couldn't load the font at %d px\n", (int)sizes[s]);
+            ret = 1;
+            break;
+        }
+
+        for(uint32_t v = 0; v < 3; v++) {
+            lv_font_t * font = v == 1 ? file_font : mem_font;
+            lv_tiny_ttf_cache_set_budget(v == 2 ? LV_TINY_TTF_CACHE_DEF_BYTES : 0);
+            if(v == 2) {
+                /*The cache gives the glyphs drawn without it*/
+                for(uint32_t l = 0; l < 95; l++) {
+                    lv_font_glyph_dsc_t g;
+                    if(!lv_font_get_glyph_dsc(font, &g, letters[l], 0)) continue;
+                    const uint32_t px = (uint32_t)g.box_w * g.box_h;
+                    lv_tiny_ttf_cache_set_budget(0);
+                    uint8_t * ref = (uint8_t *)malloc(px);
+                    memcpy(ref, lv_font_get_glyph_bitmap(font, letters[l]), px);
+                    lv_tiny_ttf_cache_set_budget(LV_TINY_TTF_CACHE_DEF_BYTES);
+                    lv_font_get_glyph_bitmap(font, letters[l]);
+                    if(memcmp(ref, lv_font_get_glyph_bitmap(font, letters[l]), px)) {
+                        fprintf(stderr, "bench: '%c' at %d px is cached with other pixels\n", (char)letters[l],
+                                (int)sizes[s]);
+                        ret = 1;
+                    }
+                    free(ref);
+                }
+            }
+
+            uint64_t best_us = 0;
+            volatile uint32_t sink = 0;
+            lv_tiny_ttf_stats_t stats;
+            for(uint32_t r = 0; r < repeat; r++) {
+                lv_tiny_ttf_reset_stats();
+                const uint64_t start_us = bench_now_us();
+                for(uint32_t i = 0; i < frames; i++) {
+                    for(uint32_t l = 0; l < 95; l++) {
+                        const uint8_t * bitmap = lv_font_get_glyph_bitmap(font, letters[l]);
+                        if(bitmap) sink = sink + bitmap[0];
+                    }
+                }
+                const uint64_t us = bench_now_us() - start_us;
+                if(r == 0 || us < best_us) {
+                    best_us = us;
+                    lv_tiny_ttf_get_stats(&stats);
+                }
+            }
+            if(best_us == 0) best_us = 1;
+
+            const uint32_t drawn = stats.hits + stats.misses;
+            const bool last = s == size_cnt - 1 && v == 2;
+            fprintf(report, "    {\n");
+            fprintf(report, "      \"name\": \"ttf:%d:%s\",\n", (int)sizes[s], variant_names[v]);
+            fprintf(report, "      \"desc\": \"95 ASCII glyphs at %d px, %s, %u%% cached, %u kB of the file read\",\n",
+                    (int)sizes[s], v == 0 ? "rasterised from memory" : v == 1 ? "rasterised from the file" : "from the cache",
+                    (unsigned)(drawn ? stats.hits * 100ULL / drawn : 0), (unsigned)(stats.bytes_read / 1024));
+            fprintf(report, "      \"frames\": %u,\n", (unsigned)frames);
+            fprintf(report, "      \"fps\": %.1f,\n", frames * 1e6 / best_us);
+            fprintf(report, "      \"ns_per_px\": %.2f,\n", best_us * 1000.0 / ((double)frames * 95));
+            fprintf(report, "      \"px_per_frame\": 95\n");
+            fprintf(report, "    }%s\n", last ? "" : ",");
+        }
+        chinScreen_font_free(file_font);
+        chinScreen_font_free(mem_font);
+    }
+    fprintf(report, "  ]\n}\n");
+    lv_tiny_ttf_cache_set_budget(LV_TINY_TTF_CACHE_DEF_BYTES);
+    remove(BENCH_TTF_FILE);
+    return ret;
+}
+
+static void usage(const char * argv0)
+{
+    fprintf(stderr, "usage: %s [--frames n] [--warmup n] [--repeat n] [--scene name] [--workers n] [--out bench.json] [--ppm dir]\n"
+            "       %s --gifs [--frames n] [--repeat n] [--out gifs.json]\n"
+            "       %s --kernels [--frames n] [--repeat n] [--out kernels.json]\n"
+            "       %s --transforms [--frames n] [--repeat n] [--out transforms.json]\n"
+            "       %s --fonts [--frames n] [--repeat n] [--out fonts.json]\n"
+            "       %s --names [--frames n] [--repeat n] [--out names.json]\n"
+            "       %s --ttf [--frames n] [--repeat n] [--out ttf.json]\n"
+            "       %s --list\n", argv0, argv0, argv0, argv0, argv0, argv0, argv0, argv0);
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    const uint32_t scene_cnt = sizeof(bench_scenes) / sizeof(bench_scenes[0]);
+    uint32_t frames = 100;
+    uint32_t warmup = 5;
+    uint32_t repeat = 3;
+    const char * only = NULL;
+    const char * out = NULL;
+    const char * ppm_dir = NULL;
+    int32_t workers = -1;       /*-1: LV_DRAW_SW_TILE_WORKERS of lv_conf.h*/
+    bool gifs = false;
+    bool kernels = false;
+    bool transforms = false;
+    bool fonts = false;
+    bool names = false;
+    bool ttf = false;
+
+    for(int i = 1; i < argc; i++) {
+        if(!strcmp(argv[i], "--frames") && i + 1 < argc) {
+            frames = strtoul(argv[++i], NULL, 10);
+        }
+        else if(!strcmp(argv[i], "--warmup") && i + 1 < argc) {
+            warmup = strtoul(argv[++i], NULL, 10);
+        }
+        else if(!strcmp(argv[i], "--repeat") && i + 1 < argc) {
+            repeat = strtoul(argv[++i], NULL, 10);
+        }
+        else if(!strcmp(argv[i], "--scene") && i + 1 < argc) {
+            only = argv[++i];
+        }
+        else if(!strcmp(argv[i], "--workers") && i + 1 < argc) {
+            workers = strtol(argv[++i], NULL, 10);
+        }
+        else if(!strcmp(argv[i], "--out") && i + 1 < argc) {
+            out = argv[++i];
+        }
+        else if(!strcmp(argv[i], "--ppm") && i + 1 < argc) {
+            ppm_dir = argv[++i];
+        }
+        else if(!strcmp(argv[i], "--gifs")) {
+            gifs = true;
+        }
+        else if(!strcmp(argv[i], "--kernels")) {
+            kernels = true;
+        }
+        else if(!strcmp(argv[i], "--transforms")) {
+            transforms = true;
+        }
+        else if(!strcmp(argv[i], "--fonts")) {
+            fonts = true;
+        }
+        else if(!strcmp(argv[i], "--names")) {
+            names = true;
+        }
+        else if(!strcmp(argv[i], "--ttf")) {
+            ttf = true;
+        }
+        else if(!strcmp(argv[i], "--list")) {
+            for(uint32_t s = 0; s < scene_cnt; s++) printf("%-16s %s\n", bench_scenes[s].name, bench_scenes[s].desc);
+            return 0;
+        }
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if(frames == 0 || (!gifs && !kernels && !transforms && !fonts && !names && !ttf && frames > LVGL_PORT_PERF_WINDOW)) {
+        fprintf(stderr, "--frames must be 1..%d, the window of the port's counters\n", LVGL_PORT_PERF_WINDOW);
+        return 2;
+    }
+
+    /*The report goes to stdout (or --out), everything the library prints to stderr*/
+    FILE * report = out ? fopen(out, "w") : fdopen(dup(STDOUT_FILENO), "w");
+    if(!report) {
+        perror(out ? out : "stdout");
+        return 1;
+    }
+    fflush(stdout);
+    dup2(STDERR_FILENO, STDOUT_FILENO);
+
+    init_display();
+#if LV_USE_DRAW_SW_TILES
+    if(workers >= 0) lv_draw_sw_tiles_set_workers(workers, -1);
+    workers = lv_draw_sw_tiles_get_workers();
+#else
+    workers = 0;
+#endif
+
+    fprintf(report, "{\n");
+    fprintf(report, "  \"lvgl\": \"%d.%d.%d\",\n", LVGL_VERSION_MAJOR, LVGL_VERSION_MINOR, LVGL_VERSION_PATCH);
+    fprintf(report, "  \"hor_res\": %d,\n", (int)LV_HOR_RES);
+    fprintf(report, "  \"ver_res\": %d,\n", (int)LV_VER_RES);
+    fprintf(report, "  \"color_depth\": %d,\n", LV_COLOR_DEPTH);
+    fprintf(report, "  \"color_16_swap\": %d,\n", LV_COLOR_16_SWAP);
+    fprintf(report, "  \"frame_ms\": %d,\n", BENCH_FRAME_MS);
+    fprintf(report, "  \"repeat\": %u,\n", (unsigned)repeat);
+    fprintf(report, "  \"workers\": %d,\n", (int)workers);
+    if(gifs) {
+        int res = bench_gifs(report, frames, repeat);
+        fclose(report);
+        lvgl_port_deinit();
+        return res;
+    }
+    if(kernels) {
+        int res = bench_kernels(report, frames, repeat);
+        fclose(report);
+        lvgl_port_deinit();
+        return res;
+    }
+    if(transforms) {
+        int res = bench_transforms(report, frames, repeat);
+        fclose(report);
+        lvgl_port_deinit();
+        return res;
+    }
+    if(fonts) {
+        int res = bench_fonts(report, frames, repeat);
+        fclose(report);
+        lvgl_port_deinit();
+        return res;
+    }
+    if(names) {
+        int res = bench_names(report, frames, repeat);
+        fclose(report);
+        lvgl_port_deinit();
+        return res;
+    }
+    if(ttf) {
+        int res = bench_ttf(report, frames, repeat);
+        fclose(report);
+        lvgl_port_deinit();
+        return res;
+    }
+    fprintf(report, "  \"scenes\": [\n");
+    jpeg_make();        /*Outside of the scenes, heap_peak only counts what drawing the photo takes*/
+
+    int ret = 2;
+    for(uint32_t s = 0; s < scene_cnt; s++) {
+        if(only && strcmp(only, bench_scenes[s].name)) continue;
+
+        const bool last = only || s == scene_cnt - 1;
+        bench_result_t res;
+        fprintf(stderr, "bench: %s\n", bench_scenes[s].name);
+        bench_run(&bench_scenes[s], warmup, frames, &res);
+        for(uint32_t r = 1; r < repeat; r++) {
+            bench_result_t again;
+            bench_run(&bench_scenes[s], warmup, frames, &again);
+            if(again.render_us.avg < res.render_us.avg) res = again;
+        }
+        bench_json_scene(report, &bench_scenes[s], &res, last);
+        if(ppm_dir) {
+            char path[256];
+            snprintf(path, sizeof(path), "%s/%s.ppm", ppm_dir, bench_scenes[s].name);
+            if(!chinScreen_host_save_ppm(path)) fprintf(stderr, "failed to write %s\n", path);
+        }
+        ret = 0;
+    }
+
+    fprintf(report, "  ]\n}\n");
+    fclose(report);
+    lvgl_port_deinit();
+    free(jpeg_data);
+    remove(BENCH_JPEG_FILE);
+
+    if(ret) fprintf(stderr, "unknown scene %s, see --list\n", only);
+    return ret;
+}
+
+#endif /*LV_BUILD_BENCH*/
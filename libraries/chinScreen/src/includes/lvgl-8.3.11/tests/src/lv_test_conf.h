@@ -21,6 +21,7 @@ extern "C" {
  *********************/
 
 #define LV_USE_TINY_TTF 1
+#define LV_TINY_TTF_FILE_SUPPORT 1
 
 void lv_test_assert_fail(void);
 #define LV_ASSERT_HANDLER lv_test_assert_fail();
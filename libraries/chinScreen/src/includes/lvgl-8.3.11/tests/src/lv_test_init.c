@@ -7,9 +7,6 @@
 #include <stdlib.h>
 #include "../unity/unity.h"
 
-#define HOR_RES 800
-#define VER_RES 480
-
 static void hal_init(void);
 static void dummy_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
 
@@ -17,8 +14,8 @@ lv_indev_t * lv_test_mouse_indev;
 lv_indev_t * lv_test_keypad_indev;
 lv_indev_t * lv_test_encoder_indev;
 
-lv_color_t test_fb[HOR_RES * VER_RES];
-static lv_color_t disp_buf1[HOR_RES * VER_RES];
+lv_color_t test_fb[TEST_HOR_RES * TEST_VER_RES];
+static lv_color_t disp_buf1[TEST_HOR_RES * TEST_VER_RES];
 
 void lv_test_init(void)
 {
@@ -35,14 +32,14 @@ static void hal_init(void)
 {
     static lv_disp_draw_buf_t draw_buf;
 
-    lv_disp_draw_buf_init(&draw_buf, disp_buf1, NULL, HOR_RES * VER_RES);
+    lv_disp_draw_buf_init(&draw_buf, disp_buf1, NULL, TEST_HOR_RES * TEST_VER_RES);
 
     static lv_disp_drv_t disp_drv;
     lv_disp_drv_init(&disp_drv);
     disp_drv.draw_buf = &draw_buf;
     disp_drv.flush_cb = dummy_flush_cb;
-    disp_drv.hor_res = HOR_RES;
-    disp_drv.ver_res = VER_RES;
+    disp_drv.hor_res = TEST_HOR_RES;
+    disp_drv.ver_res = TEST_VER_RES;
     lv_disp_drv_register(&disp_drv);
 
     static lv_indev_drv_t indev_mouse_drv;
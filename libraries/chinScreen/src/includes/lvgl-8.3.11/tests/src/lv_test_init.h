@@ -9,6 +9,13 @@ extern "C" {
 #include <stdio.h>
 #include <../lvgl.h>
 
+#define TEST_HOR_RES    800
+#define TEST_VER_RES    480
+#define TEST_FB_SIZE    (TEST_HOR_RES * TEST_VER_RES * sizeof(lv_color_t))
+
+/*The last flushed area, copied to the start*/
+extern lv_color_t test_fb[];
+
 void lv_test_init(void);
 void lv_test_deinit(void);
 
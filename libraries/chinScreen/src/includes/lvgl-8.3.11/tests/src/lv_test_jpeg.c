@@ -0,0 +1,378 @@
+
+#if defined(LV_BUILD_TEST) || defined(LV_BUILD_BENCH)
+#include "lv_test_jpeg.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+typedef struct {
+    uint8_t * buf;
+    uint32_t size;
+    uint32_t cap;
+    uint32_t acc;
+    uint32_t bits;
+    int error;
+} jpeg_out_t;
+
+typedef struct {
+    uint16_t code[256];
+    uint8_t len[256];
+} huff_table_t;
+
+/*ITU T.81 Annex K*/
+static const uint8_t std_qt_luma[64] = {
+    16, 11, 10, 16, 24, 40, 51, 61,
+    12, 12, 14, 19, 26, 58, 60, 55,
+    14, 13, 16, 24, 40, 57, 69, 56,
+    14, 17, 22, 29, 51, 87, 80, 62,
+    18, 22, 37, 56, 68, 109, 103, 77,
+    24, 35, 55, 64, 81, 104, 113, 92,
+    49, 64, 78, 87, 103, 121, 120, 101,
+    72, 92, 95, 98, 112, 100, 103, 99
+};
+
+static const uint8_t std_qt_chroma[64] = {
+    17, 18, 24, 47, 99, 99, 99, 99,
+    18, 21, 26, 66, 99, 99, 99, 99,
+    24, 26, 56, 99, 99, 99, 99, 99,
+    47, 66, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99
+};
+
+static const uint8_t dc_luma_bits[16] = {0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0};
+static const uint8_t dc_chroma_bits[16] = {0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0};
+static const uint8_t dc_vals[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+
+static const uint8_t ac_luma_bits[16] = {0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d};
+static const uint8_t ac_luma_vals[162] = {
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+    0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0,
+    0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+    0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+    0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+    0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5,
+    0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+    0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+    0xf9, 0xfa
+};
+
+static const uint8_t ac_chroma_bits[16] = {0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77};
+static const uint8_t ac_chroma_vals[162] = {
+    0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+    0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0,
+    0x15, 0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26,
+    0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+    0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+    0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5,
+    0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3,
+    0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda,
+    0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+    0xf9, 0xfa
+};
+
+/*Raster index of the coefficients in zigzag order*/
+static const uint8_t zigzag[64] = {
+    0, 1, 8, 16, 9, 2, 3, 10, 17, 24, 32, 25, 18, 11, 4, 5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6, 7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+static void put_byte(jpeg_out_t * o, uint8_t b)
+{
+    if(o->size == o->cap) {
+        uint32_t cap = o->cap ? o->cap * 2 : 4096;
+        uint8_t * buf = realloc(o->buf, cap);
+        if(buf == NULL) {
+            o->error = 1;
+            return;
+        }
+        o->buf = buf;
+        o->cap = cap;
+    }
+    o->buf[o->size++] = b;
+}
+
+static void put_u16(jpeg_out_t * o, uint16_t v)
+{
+    put_byte(o, v >> 8);
+    put_byte(o, v & 0xff);
+}
+
+/*Entropy coded bits, a 0xff byte is followed by a stuffed 0*/
+static void put_bits(jpeg_out_t * o, uint32_t v, uint32_t n)
+{
+    while(n--) {
+        o->acc = (o->acc << 1) | ((v >> n) & 1);
+        if(++o->bits == 8) {
+            put_byte(o, o->acc);
+            if(o->acc == 0xff) put_byte(o, 0);
+            o->acc = 0;
+            o->bits = 0;
+        }
+    }
+}
+
+/*Pad the last byte with 1 bits*/
+static void flush_bits(jpeg_out_t * o)
+{
+    if(o->bits) put_bits(o, 0x7f, 8 - o->bits);
+}
+
+static void build_huff(huff_table_t * t, const uint8_t * bits, const uint8_t * vals)
+{
+    uint32_t code = 0;
+    uint32_t k = 0;
+    memset(t, 0, sizeof(*t));
+    for(uint32_t len = 1; len <= 16; len++) {
+        for(uint32_t i = 0; i < bits[len - 1]; i++) {
+            t->code[vals[k]] = code++;
+            t->len[vals[k]] = len;
+            k++;
+        }
+        code <<= 1;
+    }
+}
+
+static void put_dht(jpeg_out_t * o, uint8_t tc_th, const uint8_t * bits, const uint8_t * vals)
+{
+    uint32_t n = 0;
+    for(uint32_t i = 0; i < 16; i++) n += bits[i];
+    put_u16(o, 0xffc4);
+    put_u16(o, 2 + 1 + 16 + n);
+    put_byte(o, tc_th);
+    for(uint32_t i = 0; i < 16; i++) put_byte(o, bits[i]);
+    for(uint32_t i = 0; i < n; i++) put_byte(o, vals[i]);
+}
+
+static void scale_qt(uint8_t * qt, const uint8_t * std, uint8_t quality)
+{
+    if(quality < 1) quality = 1;
+    if(quality > 100) quality = 100;
+    int scale = quality < 50 ? 5000 / quality : 200 - quality * 2;
+    for(int i = 0; i < 64; i++) {
+        int q = (std[i] * scale + 50) / 100;
+        qt[i] = q < 1 ? 1 : q > 255 ? 255 : q;
+    }
+}
+
+static uint32_t bit_len(int v)
+{
+    uint32_t n = 0;
+    if(v < 0) v = -v;
+    while(v) {
+        n++;
+        v >>= 1;
+    }
+    return n;
+}
+
+/*Forward DCT, quantize and entropy code an 8x8 block of samples (0..255)*/
+static void encode_block(jpeg_out_t * o, const float * block, const uint8_t * qt, int * dc_pred,
+                         const huff_table_t * dc, const huff_table_t * ac)
+{
+    static float cos_t[8][8];
+    static int cos_init;
+    if(!cos_init) {
+        for(int x = 0; x < 8; x++) {
+            for(int u = 0; u < 8; u++) cos_t[x][u] = cosf((2 * x + 1) * u * 3.14159265f / 16);
+        }
+        cos_init = 1;
+    }
+
+    float tmp[64];
+    for(int y = 0; y < 8; y++) {
+        for(int u = 0; u < 8; u++) {
+            float s = 0;
+            for(int x = 0; x < 8; x++) s += (block[y * 8 + x] - 128) * cos_t[x][u];
+            tmp[y * 8 + u] = s * (u ? 0.5f : 0.35355339f);
+        }
+    }
+    int coef[64];
+    for(int u = 0; u < 8; u++) {
+        for(int v = 0; v < 8; v++) {
+            float s = 0;
+            for(int y = 0; y < 8; y++) s += tmp[y * 8 + u] * cos_t[y][v];
+            s *= v ? 0.5f : 0.35355339f;
+            coef[v * 8 + u] = (int)lroundf(s / qt[v * 8 + u]);
+        }
+    }
+
+    int diff = coef[0] - *dc_pred;
+    *dc_pred = coef[0];
+    uint32_t n = bit_len(diff);
+    put_bits(o, dc->code[n], dc->len[n]);
+    if(n) put_bits(o, diff > 0 ? diff : diff + (1 << n) - 1, n);
+
+    uint32_t run = 0;
+    for(int k = 1; k < 64; k++) {
+        int c = coef[zigzag[k]];
+        if(c == 0) {
+            run++;
+            continue;
+        }
+        while(run > 15) {
+            put_bits(o, ac->code[0xf0], ac->len[0xf0]);
+            run -= 16;
+        }
+        n = bit_len(c);
+        put_bits(o, ac->code[(run << 4) | n], ac->len[(run << 4) | n]);
+        put_bits(o, c > 0 ? c : c + (1 << n) - 1, n);
+        run = 0;
+    }
+    if(run) put_bits(o, ac->code[0], ac->len[0]);
+}
+
+/*Component `c` (0: Y, 1: Cb, 2: Cr) of an `sx` x `sy` pixel square, clamped to the picture*/
+static float sample(const uint8_t * rgb, uint32_t w, uint32_t h, uint32_t x, uint32_t y, uint32_t sx, uint32_t sy, int c)
+{
+    float sum = 0;
+    for(uint32_t j = 0; j < sy; j++) {
+        for(uint32_t i = 0; i < sx; i++) {
+            uint32_t px = x + i < w ? x + i : w - 1;
+            uint32_t py = y + j < h ? y + j : h - 1;
+            const uint8_t * p = rgb + (py * w + px) * 3;
+            if(c == 0) sum += 0.299f * p[0] + 0.587f * p[1] + 0.114f * p[2];
+            else if(c == 1) sum += -0.168736f * p[0] - 0.331264f * p[1] + 0.5f * p[2] + 128;
+            else sum += 0.5f * p[0] - 0.418688f * p[1] - 0.081312f * p[2] + 128;
+        }
+    }
+    return sum / (sx * sy);
+}
+
+uint8_t * lv_test_jpeg_encode(const uint8_t * rgb, uint32_t w, uint32_t h, const lv_test_jpeg_cfg_t * cfg,
+                              uint32_t * size)
+{
+    static const uint8_t jfif[] = {0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 'J', 'F', 'I', 'F', 0, 1, 1, 0, 0, 1, 0, 1, 0, 0};
+    const int hs = cfg->subsampling == LV_TEST_JPEG_444 ? 1 : 2;
+    const int vs = cfg->subsampling == LV_TEST_JPEG_420 ? 2 : 1;
+    jpeg_out_t o;
+    memset(&o, 0, sizeof(o));
+
+    uint8_t qt[2][64];
+    scale_qt(qt[0], std_qt_luma, cfg->quality);
+    scale_qt(qt[1], std_qt_chroma, cfg->quality);
+
+    for(uint32_t i = 0; i < sizeof(jfif); i++) put_byte(&o, jfif[i]);
+    for(int t = 0; t < 2; t++) {
+        put_u16(&o, 0xffdb);
+        put_u16(&o, 2 + 1 + 64);
+        put_byte(&o, t);
+        for(int k = 0; k < 64; k++) put_byte(&o, qt[t][zigzag[k]]);
+    }
+
+    put_u16(&o, 0xffc0);
+    put_u16(&o, 8 + 3 * 3);
+    put_byte(&o, 8);
+    put_u16(&o, h);
+    put_u16(&o, w);
+    put_byte(&o, 3);
+    put_byte(&o, 1);
+    put_byte(&o, (hs << 4) | vs);
+    put_byte(&o, 0);
+    for(int c = 2; c <= 3; c++) {
+        put_byte(&o, c);
+        put_byte(&o, 0x11);
+        put_byte(&o, 1);
+    }
+
+    put_dht(&o, 0x00, dc_luma_bits, dc_vals);
+    put_dht(&o, 0x10, ac_luma_bits, ac_luma_vals);
+    put_dht(&o, 0x01, dc_chroma_bits, dc_vals);
+    put_dht(&o, 0x11, ac_chroma_bits, ac_chroma_vals);
+
+    if(cfg->restart_interval) {
+        put_u16(&o, 0xffdd);
+        put_u16(&o, 4);
+        put_u16(&o, cfg->restart_interval);
+    }
+
+    put_u16(&o, 0xffda);
+    put_u16(&o, 6 + 2 * 3);
+    put_byte(&o, 3);
+    put_byte(&o, 1);
+    put_byte(&o, 0x00);
+    put_byte(&o, 2);
+    put_byte(&o, 0x11);
+    put_byte(&o, 3);
+    put_byte(&o, 0x11);
+    put_byte(&o, 0);
+    put_byte(&o, 63);
+    put_byte(&o, 0);
+
+    huff_table_t dc[2], ac[2];
+    build_huff(&dc[0], dc_luma_bits, dc_vals);
+    build_huff(&dc[1], dc_chroma_bits, dc_vals);
+    build_huff(&ac[0], ac_luma_bits, ac_luma_vals);
+    build_huff(&ac[1], ac_chroma_bits, ac_chroma_vals);
+
+    const uint32_t mcu_w = 8 * hs;
+    const uint32_t mcu_h = 8 * vs;
+    const uint32_t mcu_cnt = ((w + mcu_w - 1) / mcu_w) * ((h + mcu_h - 1) / mcu_h);
+    int dc_pred[3] = {0, 0, 0};
+    uint32_t mcu = 0;
+    float block[64];
+    for(uint32_t my = 0; my < h; my += mcu_h) {
+        for(uint32_t mx = 0; mx < w; mx += mcu_w) {
+            for(int by = 0; by < vs; by++) {
+                for(int bx = 0; bx < hs; bx++) {
+                    for(int i = 0; i < 64; i++) {
+                        block[i] = sample(rgb, w, h, mx + bx * 8 + i % 8, my + by * 8 + i / 8, 1, 1, 0);
+                    }
+                    encode_block(&o, block, qt[0], &dc_pred[0], &dc[0], &ac[0]);
+                }
+            }
+            for(int c = 1; c <= 2; c++) {
+                for(int i = 0; i < 64; i++) {
+                    block[i] = sample(rgb, w, h, mx + (i % 8) * hs, my + (i / 8) * vs, hs, vs, c);
+                }
+                encode_block(&o, block, qt[1], &dc_pred[c], &dc[1], &ac[1]);
+            }
+
+            mcu++;
+            if(cfg->restart_interval && mcu % cfg->restart_interval == 0 && mcu < mcu_cnt) {
+                flush_bits(&o);
+                put_u16(&o, 0xffd0 + ((mcu / cfg->restart_interval - 1) & 7));
+                dc_pred[0] = dc_pred[1] = dc_pred[2] = 0;
+            }
+        }
+    }
+    flush_bits(&o);
+    put_u16(&o, 0xffd9);
+
+    if(o.error) {
+        free(o.buf);
+        return NULL;
+    }
+    *size = o.size;
+    return o.buf;
+}
+
+void lv_test_jpeg_fill_photo(uint8_t * rgb, uint32_t w, uint32_t h, uint32_t seed)
+{
+    uint32_t rnd = seed * 2654435761u + 1;
+    for(uint32_t y = 0; y < h; y++) {
+        for(uint32_t x = 0; x < w; x++) {
+            rnd = rnd * 1664525u + 1013904223u;
+            const float noise = (float)((rnd >> 24) & 0x1f) - 16;
+            const float fx = (float)x / w;
+            const float fy = (float)y / h;
+            const float wave = 40 * sinf(x * 0.21f + seed) * cosf(y * 0.17f);
+            const float ring = 60 * sinf(sqrtf((fx - 0.3f) * (fx - 0.3f) + (fy - 0.6f) * (fy - 0.6f)) * 40);
+            const float v[3] = {
+                60 + 150 * fy + wave + noise,
+                40 + 120 * fx + ring + noise,
+                200 - 120 * fx * fy + (wave + ring) / 2 + noise
+            };
+            for(int c = 0; c < 3; c++) rgb[(y * w + x) * 3 + c] = v[c] < 0 ? 0 : v[c] > 255 ? 255 : (uint8_t)v[c];
+        }
+    }
+}
+
+#endif /*LV_BUILD_TEST || LV_BUILD_BENCH*/
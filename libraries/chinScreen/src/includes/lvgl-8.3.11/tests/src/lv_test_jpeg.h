@@ -0,0 +1,54 @@
+
+#ifndef LV_TEST_JPEG_H
+#define LV_TEST_JPEG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * A small baseline JPEG encoder, so the JPEG tests and benchmarks can make pictures of any size
+ * without shipping files. It writes JFIF files with the standard huffman tables, like a camera or
+ * `ffmpeg -q:v` does, so every AC coefficient code shows up in a busy picture.
+ */
+
+typedef enum {
+    LV_TEST_JPEG_444,       /*8x8 MCUs*/
+    LV_TEST_JPEG_422,       /*16x8 MCUs*/
+    LV_TEST_JPEG_420,       /*16x16 MCUs, what most cameras write*/
+} lv_test_jpeg_subsampling_t;
+
+typedef struct {
+    uint8_t quality;                        /*1..100, like the IJG encoder*/
+    lv_test_jpeg_subsampling_t subsampling;
+    uint16_t restart_interval;              /*MCUs between restart markers, 0: none*/
+} lv_test_jpeg_cfg_t;
+
+/**
+ * Encode a picture as a baseline JPEG
+ * @param rgb       `w * h` pixels, 3 bytes each: R, G, B
+ * @param w         width of the picture
+ * @param h         height of the picture
+ * @param cfg       quality, subsampling and restart interval
+ * @param size      store the size of the JPEG here
+ * @return          the JPEG file, `free()` it; NULL if out of memory
+ */
+uint8_t * lv_test_jpeg_encode(const uint8_t * rgb, uint32_t w, uint32_t h, const lv_test_jpeg_cfg_t * cfg,
+                              uint32_t * size);
+
+/**
+ * Draw a picture that compresses like a photo: smooth gradients, fine texture and some noise
+ * @param rgb       store `w * h` pixels here, 3 bytes each
+ * @param w         width of the picture
+ * @param h         height of the picture
+ * @param seed      different seeds draw different pictures
+ */
+void lv_test_jpeg_fill_photo(uint8_t * rgb, uint32_t w, uint32_t h, uint32_t seed);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_TEST_JPEG_H*/
@@ -0,0 +1,217 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <string.h>
+
+#define BUF_PX      (48 * 8)
+#define ITERATIONS  4000
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_draw_sw_blend_set_kernels(NULL);
+}
+
+void test_draw_sw_blend_kernels_select(void)
+{
+#if LV_DRAW_SW_BLEND_565_VECTOR
+    const lv_draw_sw_blend_kernels_t * def = &lv_draw_sw_blend_565_vector_kernels;
+#elif LV_DRAW_SW_BLEND_565
+    const lv_draw_sw_blend_kernels_t * def = &lv_draw_sw_blend_565_swar_kernels;
+#else
+    const lv_draw_sw_blend_kernels_t * def = &lv_draw_sw_blend_kernels_ref;
+#endif
+    TEST_ASSERT_EQUAL_PTR(def, lv_draw_sw_blend_get_kernels());
+
+    lv_draw_sw_blend_set_kernels(&lv_draw_sw_blend_kernels_ref);
+    TEST_ASSERT_EQUAL_PTR(&lv_draw_sw_blend_kernels_ref, lv_draw_sw_blend_get_kernels());
+
+    lv_draw_sw_blend_set_kernels(NULL);
+    TEST_ASSERT_EQUAL_PTR(def, lv_draw_sw_blend_get_kernels());
+}
+
+#if LV_DRAW_SW_BLEND_565
+
+typedef enum {
+    KERNEL_FILL_OPA,
+    KERNEL_FILL_MASK,
+    KERNEL_MAP_OPA,
+    KERNEL_MAP_MASK,
+} kernel_t;
+
+static lv_color_t dest_init[BUF_PX];
+static lv_color_t dest_ref[BUF_PX];
+static lv_color_t dest_test[BUF_PX];
+static lv_color_t src[BUF_PX];
+static lv_opa_t mask[BUF_PX];
+static uint32_t rnd_state = 0x12345678;
+
+static uint32_t rnd(void)
+{
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 17;
+    rnd_state ^= rnd_state << 5;
+    return rnd_state;
+}
+
+/*Runs of the same color, black among them, as backgrounds have*/
+static void make_colors(lv_color_t * buf)
+{
+    uint32_t i = 0;
+    while(i < BUF_PX) {
+        uint16_t c = rnd() % 4 == 0 ? 0 : (uint16_t)rnd();
+        uint32_t run = rnd() % 3 == 0 ? 1 + rnd() % 20 : 1;
+        while(run-- && i < BUF_PX) buf[i++].full = c;
+    }
+}
+
+/*Runs of transparent and covering masks with the values around the rounding edges*/
+static void make_mask(void)
+{
+    static const lv_opa_t edges[] = {1, 3, 4, 5, 127, 128, 251, 252, 253, 254};
+    uint32_t i = 0;
+    while(i < BUF_PX) {
+        lv_opa_t m;
+        switch(rnd() % 5) {
+            case 0:
+                m = LV_OPA_TRANSP;
+                break;
+            case 1:
+                m = LV_OPA_COVER;
+                break;
+            case 2:
+                m = edges[rnd() % sizeof(edges)];
+                break;
+            default:
+                m = (lv_opa_t)rnd();
+                break;
+        }
+        uint32_t run = rnd() % 2 ? 1 + rnd() % 12 : 1;
+        while(run-- && i < BUF_PX) mask[i++] = m;
+    }
+}
+
+static void run_kernel(const lv_draw_sw_blend_kernels_t * k, kernel_t kernel, lv_color_t * dest,
+                       const lv_area_t * area, lv_coord_t dest_stride, const lv_color_t * src_buf,
+                       lv_coord_t src_stride, lv_color_t color, lv_opa_t opa, const lv_opa_t * mask_buf,
+                       lv_coord_t mask_stride)
+{
+    switch(kernel) {
+        case KERNEL_FILL_OPA:
+            k->fill_opa(dest, area, dest_stride, color, opa);
+            break;
+        case KERNEL_FILL_MASK:
+            k->fill_mask(dest, area, dest_stride, color, opa, mask_buf, mask_stride);
+            break;
+        case KERNEL_MAP_OPA:
+            k->map_opa(dest, area, dest_stride, src_buf, src_stride, opa);
+            break;
+        case KERNEL_MAP_MASK:
+            k->map_mask(dest, area, dest_stride, src_buf, src_stride, opa, mask_buf, mask_stride);
+            break;
+    }
+}
+
+/*Blend an area with the reference and the tested kernels and compare the whole buffer*/
+static void check_area(const lv_draw_sw_blend_kernels_t * k, kernel_t kernel, int32_t w, int32_t h,
+                       lv_opa_t opa)
+{
+    /*Odd offsets and strides to have every alignment of the destination, source and mask*/
+    int32_t dest_ofs = rnd() % 4;
+    int32_t src_ofs = rnd() % 4;
+    int32_t mask_ofs = rnd() % 8;
+    lv_coord_t dest_stride = w + rnd() % 4;
+    lv_coord_t src_stride = w + rnd() % 4;
+    lv_coord_t mask_stride = w + rnd() % 8;
+    lv_color_t color;
+    color.full = rnd() % 8 == 0 ? 0 : (uint16_t)rnd();
+
+    lv_area_t area;
+    lv_area_set(&area, 0, 0, w - 1, h - 1);
+
+    lv_memcpy(dest_ref, dest_init, sizeof(dest_init));
+    lv_memcpy(dest_test, dest_init, sizeof(dest_init));
+    run_kernel(&lv_draw_sw_blend_kernels_ref, kernel, dest_ref + dest_ofs, &area, dest_stride, src + src_ofs,
+               src_stride, color, opa, mask + mask_ofs, mask_stride);
+    run_kernel(k, kernel, dest_test + dest_ofs, &area, dest_stride, src + src_ofs,
+               src_stride, color, opa, mask + mask_ofs, mask_stride);
+
+    char msg[64];
+    lv_snprintf(msg, sizeof(msg), "kernel %d, %dx%d, opa %d", kernel, (int)w, (int)h, opa);
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(dest_ref, dest_test, sizeof(dest_ref), msg);
+}
+
+static void check_kernels(const lv_draw_sw_blend_kernels_t * k)
+{
+    uint32_t i;
+    for(i = 0; i < ITERATIONS; i++) {
+        make_colors(dest_init);
+        make_colors(src);
+        make_mask();
+
+        kernel_t kernel = (kernel_t)(i % 4);
+        int32_t w = 1 + rnd() % 40;
+        int32_t h = 1 + rnd() % 6;
+        lv_opa_t opa = (lv_opa_t)rnd();
+        /*Without mask the kernels are called only for real opacity*/
+        if(kernel == KERNEL_FILL_OPA || kernel == KERNEL_MAP_OPA) opa = opa % LV_OPA_MAX;
+
+        check_area(k, kernel, w, h, opa);
+    }
+
+    /*Every opacity on areas large enough for the look-up tables*/
+    uint32_t opa;
+    for(opa = 0; opa <= LV_OPA_COVER; opa++) {
+        make_colors(dest_init);
+        make_colors(src);
+        make_mask();
+        if(opa < LV_OPA_MAX) {
+            check_area(k, KERNEL_FILL_OPA, 37, 5, opa);
+            check_area(k, KERNEL_MAP_OPA, 37, 5, opa);
+        }
+        check_area(k, KERNEL_FILL_MASK, 37, 5, opa);
+        check_area(k, KERNEL_MAP_MASK, 37, 5, opa);
+    }
+}
+
+/*The reference fill gives the black pixels before the first other one a slightly different color*/
+static void check_fill_black_lead(const lv_draw_sw_blend_kernels_t * k)
+{
+    uint32_t i;
+    for(i = 0; i < BUF_PX; i++) dest_init[i].full = i < 100 ? 0 : (i % 7 ? 0 : 0x1234);
+
+    lv_opa_t opa;
+    for(opa = 0; opa < LV_OPA_MAX; opa++) {
+        check_area(k, KERNEL_FILL_OPA, 40, 6, opa);
+    }
+}
+
+#endif /*LV_DRAW_SW_BLEND_565*/
+
+void test_draw_sw_blend_565_swar_same_as_ref(void)
+{
+#if LV_DRAW_SW_BLEND_565
+    check_kernels(&lv_draw_sw_blend_565_swar_kernels);
+    check_fill_black_lead(&lv_draw_sw_blend_565_swar_kernels);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_draw_sw_blend_565_vector_same_as_ref(void)
+{
+#if LV_DRAW_SW_BLEND_565_VECTOR
+    check_kernels(&lv_draw_sw_blend_565_vector_kernels);
+    check_fill_black_lead(&lv_draw_sw_blend_565_vector_kernels);
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
@@ -0,0 +1,161 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_init.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*The labels use the big fonts of the test config*/
+#if LV_FONT_MONTSERRAT_24 && LV_FONT_MONTSERRAT_48
+
+static lv_color_t * ref_fb;
+
+/*Labels of 1 and 4 bpp fonts, semi transparent and clipped ones among them*/
+static void create_labels(void)
+{
+    static const char * const texts[] = {"Temp: 23.5\xC2\xB0" "C", "RPM 1234567890", "Hello, chinScreen!", "-0.042 V"};
+    const lv_font_t * fonts[] = {&lv_font_montserrat_14, &lv_font_montserrat_24, &lv_font_montserrat_48,
+                                 &lv_font_unscii_8
+                                };
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        lv_obj_t * label = lv_label_create(lv_scr_act());
+        lv_label_set_text(label, texts[i % 4]);
+        lv_obj_set_style_text_font(label, fonts[i % 4], 0);
+        lv_obj_set_style_text_color(label, lv_palette_main((lv_palette_t)(i % 8)), 0);
+        if(i % 3 == 1) lv_obj_set_style_text_opa(label, LV_OPA_50, 0);
+        lv_obj_set_pos(label, (i % 3) * 290 - 20, (i / 3) * 120 - 10);
+    }
+}
+
+static void draw(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+void setUp(void)
+{
+    ref_fb = malloc(TEST_FB_SIZE);
+    TEST_ASSERT_NOT_NULL(ref_fb);
+    lv_draw_sw_glyph_cache_set_budget(0);
+    lv_draw_sw_glyph_cache_reset_stats();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_draw_sw_glyph_cache_set_budget(LV_DRAW_SW_GLYPH_CACHE_DEF_BYTES);
+    free(ref_fb);
+}
+
+void test_draw_sw_glyph_cache_draws_the_same_pixels(void)
+{
+    create_labels();
+    draw();
+    memcpy(ref_fb, test_fb, TEST_FB_SIZE);
+
+    lv_draw_sw_glyph_cache_set_budget(256 * 1024);
+    draw();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, TEST_FB_SIZE);
+
+    lv_draw_sw_glyph_cache_stats_t stats;
+    lv_draw_sw_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(0, stats.misses);
+    TEST_ASSERT_EQUAL_UINT32(stats.misses, stats.glyph_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.evictions);
+
+    /*Drawn from the cache alone*/
+    uint32_t misses = stats.misses;
+    draw();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, TEST_FB_SIZE);
+    lv_draw_sw_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(misses, stats.misses);
+    TEST_ASSERT_GREATER_OR_EQUAL(misses, stats.hits);
+}
+
+void test_draw_sw_glyph_cache_stays_in_budget(void)
+{
+    create_labels();
+    draw();
+    memcpy(ref_fb, test_fb, TEST_FB_SIZE);
+
+    /*Less than the glyphs of one frame, so the big ones are evicted all the time*/
+    lv_draw_sw_glyph_cache_set_budget(4096);
+    draw();
+    draw();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, TEST_FB_SIZE);
+
+    lv_draw_sw_glyph_cache_stats_t stats;
+    lv_draw_sw_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_LESS_OR_EQUAL(4096, stats.bytes);
+    TEST_ASSERT_GREATER_THAN(0, stats.evictions);
+    TEST_ASSERT_EQUAL_UINT32(4096, stats.budget);
+
+    lv_draw_sw_glyph_cache_set_budget(0);
+    lv_draw_sw_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.glyph_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.bytes);
+}
+
+void test_draw_sw_glyph_cache_invalidate_font(void)
+{
+    lv_draw_sw_glyph_cache_set_budget(256 * 1024);
+    create_labels();
+    draw();
+
+    lv_draw_sw_glyph_cache_stats_t all;
+    lv_draw_sw_glyph_cache_get_stats(&all);
+    lv_draw_sw_glyph_cache_invalidate_font(&lv_font_montserrat_48);
+
+    lv_draw_sw_glyph_cache_stats_t stats;
+    lv_draw_sw_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(0, stats.glyph_cnt);
+    TEST_ASSERT_LESS_THAN(all.glyph_cnt, stats.glyph_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.evictions);
+
+    /*Only the glyphs of the font are expanded again*/
+    draw();
+    lv_draw_sw_glyph_cache_stats_t again;
+    lv_draw_sw_glyph_cache_get_stats(&again);
+    TEST_ASSERT_EQUAL_UINT32(all.glyph_cnt, again.glyph_cnt);
+    TEST_ASSERT_EQUAL_UINT32(all.glyph_cnt - stats.glyph_cnt, again.misses - all.misses);
+
+    lv_draw_sw_glyph_cache_invalidate_font(NULL);
+    lv_draw_sw_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.glyph_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.bytes);
+}
+
+#else /*LV_FONT_MONTSERRAT_24 && LV_FONT_MONTSERRAT_48*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_draw_sw_glyph_cache_draws_the_same_pixels(void)
+{
+
+}
+
+void test_draw_sw_glyph_cache_stays_in_budget(void)
+{
+
+}
+
+void test_draw_sw_glyph_cache_invalidate_font(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,314 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_init.h"
+
+#if LV_USE_DRAW_SW_TILES
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define IMG_W           160
+#define IMG_H           120
+#define MAX_THREADS     8
+
+typedef struct {
+    _lv_draw_mask_common_dsc_t dsc;
+} thread_mask_t;
+
+static lv_color_t * serial_fb;
+static uint8_t img_data[IMG_W * IMG_H * LV_IMG_PX_SIZE_ALPHA_BYTE];
+static lv_img_dsc_t img_dsc;
+static thread_mask_t thread_mask;
+static int16_t thread_mask_id = -1;
+static pthread_mutex_t threads_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t threads[MAX_THREADS];
+static uint32_t thread_cnt;
+
+/*A mask changing nothing, it only notes which threads apply it*/
+static lv_draw_mask_res_t thread_mask_cb(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len,
+                                         void * param)
+{
+    LV_UNUSED(mask_buf);
+    LV_UNUSED(abs_x);
+    LV_UNUSED(abs_y);
+    LV_UNUSED(len);
+    LV_UNUSED(param);
+
+    pthread_mutex_lock(&threads_mutex);
+    uint32_t i;
+    for(i = 0; i < thread_cnt; i++) {
+        if(pthread_equal(threads[i], pthread_self())) break;
+    }
+    if(i == thread_cnt && thread_cnt < MAX_THREADS) threads[thread_cnt++] = pthread_self();
+    pthread_mutex_unlock(&threads_mutex);
+
+    return LV_DRAW_MASK_RES_CHANGED;
+}
+
+/*Add the mask while the object and its children are drawn*/
+static void thread_mask_event_cb(lv_event_t * e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    if(code == LV_EVENT_DRAW_MAIN_BEGIN) {
+        thread_mask.dsc.cb = thread_mask_cb;
+        thread_mask.dsc.type = LV_DRAW_MASK_TYPE_MAP;
+        thread_mask_id = lv_draw_mask_add(&thread_mask, NULL);
+    }
+    else if(code == LV_EVENT_DRAW_POST_END) {
+        lv_draw_mask_remove_id(thread_mask_id);
+        thread_mask_id = -1;
+    }
+}
+
+static void polygon_event_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_palette_main(LV_PALETTE_ORANGE);
+    dsc.bg_opa = LV_OPA_70;
+
+    lv_area_t a;
+    lv_obj_get_coords(obj, &a);
+    lv_point_t points[5] = {
+        {a.x1 + 10, a.y1 + 40}, {a.x1 + 120, a.y1 + 5}, {a.x2 - 5, a.y1 + 90},
+        {a.x1 + 90, a.y2 - 5}, {a.x1 + 30, a.y2 - 40}
+    };
+    lv_draw_polygon(draw_ctx, &dsc, points, 5);
+}
+
+static void make_img(void)
+{
+    uint8_t * p = img_data;
+    for(uint32_t y = 0; y < IMG_H; y++) {
+        for(uint32_t x = 0; x < IMG_W; x++) {
+            lv_color_t c = lv_color_make(x * 255 / IMG_W, y * 255 / IMG_H, (x ^ y) & 0xff);
+            memcpy(p, &c, LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+            p += LV_IMG_PX_SIZE_ALPHA_BYTE - 1;
+            *p++ = (x + y) & 0x40 ? LV_OPA_COVER : LV_OPA_50;
+        }
+    }
+    img_dsc.header.always_zero = 0;
+    img_dsc.header.w = IMG_W;
+    img_dsc.header.h = IMG_H;
+    img_dsc.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    img_dsc.data_size = sizeof(img_data);
+    img_dsc.data = img_data;
+}
+
+/*Something of every kind the tiles cut: gradients with rounded corners, shadows and outlines,
+ *clipped corners, images (also rotated), arcs, lines, polygons and a semi transparent layer*/
+static lv_obj_t * make_scene(void)
+{
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_set_scrollbar_mode(scr, LV_SCROLLBAR_MODE_OFF);
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x203040), 0);
+    lv_obj_set_style_bg_grad_color(scr, lv_color_hex(0xc0d0a0), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_VER, 0);
+
+    lv_obj_t * card = lv_obj_create(scr);
+    lv_obj_set_pos(card, 30, 30);
+    lv_obj_set_size(card, 420, 300);
+    lv_obj_set_style_radius(card, 40, 0);
+    lv_obj_set_style_clip_corner(card, true, 0);
+    lv_obj_set_style_bg_color(card, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_set_style_bg_grad_color(card, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_style_bg_grad_dir(card, LV_GRAD_DIR_HOR, 0);
+    lv_obj_set_style_bg_dither_mode(card, LV_DITHER_ORDERED, 0);
+    lv_obj_set_style_border_width(card, 5, 0);
+    lv_obj_set_style_outline_width(card, 4, 0);
+    lv_obj_set_style_outline_pad(card, 3, 0);
+    lv_obj_set_style_shadow_width(card, 30, 0);
+    lv_obj_set_style_shadow_spread(card, 4, 0);
+    lv_obj_set_style_shadow_ofs_x(card, 10, 0);
+    lv_obj_set_style_shadow_ofs_y(card, 8, 0);
+    lv_obj_set_style_pad_all(card, 0, 0);
+    lv_obj_add_event_cb(card, thread_mask_event_cb, LV_EVENT_ALL, NULL);
+
+    /*In the clipped corner of the card*/
+    lv_obj_t * img = lv_img_create(card);
+    lv_img_set_src(img, &img_dsc);
+    lv_obj_set_pos(img, -20, -10);
+
+    lv_obj_t * img_rot = lv_img_create(card);
+    lv_img_set_src(img_rot, &img_dsc);
+    lv_img_set_angle(img_rot, 300);
+    lv_img_set_zoom(img_rot, 330);
+    lv_img_set_antialias(img_rot, true);
+    lv_obj_set_pos(img_rot, 220, 130);
+
+    lv_obj_t * err_diff = lv_obj_create(scr);
+    lv_obj_set_pos(err_diff, 480, 20);
+    lv_obj_set_size(err_diff, 150, 200);
+    lv_obj_set_style_bg_color(err_diff, lv_color_hex(0x102030), 0);
+    lv_obj_set_style_bg_grad_color(err_diff, lv_color_hex(0x30a0f0), 0);
+    lv_obj_set_style_bg_grad_dir(err_diff, LV_GRAD_DIR_VER, 0);
+    lv_obj_set_style_bg_dither_mode(err_diff, LV_DITHER_ERR_DIFF, 0);
+
+    lv_obj_t * arc = lv_arc_create(scr);
+    lv_obj_set_pos(arc, 560, 240);
+    lv_obj_set_size(arc, 220, 220);
+    lv_obj_set_style_arc_width(arc, 24, LV_PART_MAIN);
+    lv_obj_set_style_arc_width(arc, 24, LV_PART_INDICATOR);
+    lv_arc_set_value(arc, 70);
+
+    static lv_point_t line_points[] = {{0, 0}, {180, 60}, {60, 140}, {300, 120}};
+    lv_obj_t * line = lv_line_create(scr);
+    lv_line_set_points(line, line_points, 4);
+    lv_obj_set_pos(line, 40, 330);
+    lv_obj_set_style_line_width(line, 12, 0);
+    lv_obj_set_style_line_rounded(line, true, 0);
+    lv_obj_set_style_line_color(line, lv_palette_main(LV_PALETTE_GREEN), 0);
+
+    lv_obj_t * poly = lv_obj_create(scr);
+    lv_obj_remove_style_all(poly);
+    lv_obj_set_pos(poly, 380, 300);
+    lv_obj_set_size(poly, 170, 170);
+    lv_obj_add_event_cb(poly, polygon_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    /*Drawn on a layer and blended as an image*/
+    lv_obj_t * layer = lv_obj_create(scr);
+    lv_obj_set_pos(layer, 250, 180);
+    lv_obj_set_size(layer, 260, 160);
+    lv_obj_set_style_opa(layer, LV_OPA_60, 0);
+    lv_obj_set_style_radius(layer, 20, 0);
+    lv_obj_set_style_bg_color(layer, lv_palette_main(LV_PALETTE_YELLOW), 0);
+    lv_obj_set_style_bg_grad_color(layer, lv_palette_main(LV_PALETTE_PURPLE), 0);
+    lv_obj_set_style_bg_grad_dir(layer, LV_GRAD_DIR_VER, 0);
+
+    return card;
+}
+
+static void refr_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+static void draw_with_workers(uint32_t cnt)
+{
+    lv_draw_sw_tiles_set_workers(cnt, -1);
+    thread_cnt = 0;
+    refr_screen();
+}
+
+static void assert_same_as_serial(void)
+{
+    for(uint32_t y = 0; y < TEST_VER_RES; y++) {
+        for(uint32_t x = 0; x < TEST_HOR_RES; x++) {
+            uint32_t i = y * TEST_HOR_RES + x;
+            if(serial_fb[i].full != test_fb[i].full) {
+                char msg[64];
+                lv_snprintf(msg, sizeof(msg), "pixel %d;%d", (int)x, (int)y);
+                TEST_ASSERT_EQUAL_HEX32_MESSAGE(lv_color_to32(serial_fb[i]), lv_color_to32(test_fb[i]), msg);
+            }
+        }
+    }
+}
+
+void setUp(void)
+{
+    make_img();
+    serial_fb = malloc(TEST_FB_SIZE);
+    TEST_ASSERT_NOT_NULL(serial_fb);
+}
+
+void tearDown(void)
+{
+    lv_draw_sw_tiles_set_workers(LV_DRAW_SW_TILE_WORKERS, LV_DRAW_SW_TILE_CORE);
+    lv_obj_clean(lv_scr_act());
+    lv_obj_remove_style_all(lv_scr_act());
+    lv_obj_set_scrollbar_mode(lv_scr_act(), LV_SCROLLBAR_MODE_AUTO);
+    lv_img_cache_invalidate_src(NULL);
+    free(serial_fb);
+}
+
+void test_tiles_draw_the_same_pixels_as_one_thread(void)
+{
+    make_scene();
+
+    draw_with_workers(0);
+    memcpy(serial_fb, test_fb, TEST_FB_SIZE);
+
+    for(uint32_t cnt = 1; cnt <= 3; cnt++) {
+        draw_with_workers(cnt);
+        assert_same_as_serial();
+    }
+}
+
+void test_workers_draw_with_the_masks_of_the_parent(void)
+{
+    make_scene();
+
+    draw_with_workers(0);
+    TEST_ASSERT_EQUAL_UINT32(1, thread_cnt);
+
+    /*The card's mask is applied by the LVGL thread and both workers*/
+    draw_with_workers(2);
+    TEST_ASSERT_EQUAL_UINT32(3, thread_cnt);
+}
+
+void test_small_areas_are_drawn_by_the_lvgl_thread(void)
+{
+    lv_obj_t * card = make_scene();
+    lv_obj_set_size(card, 60, 60);
+    lv_obj_set_style_shadow_width(card, 0, 0);
+    lv_obj_set_style_outline_width(card, 0, 0);
+    lv_obj_add_flag(lv_obj_get_child(card, 1), LV_OBJ_FLAG_HIDDEN);
+    TEST_ASSERT_LESS_THAN(LV_DRAW_SW_TILE_MIN_PX, 60 * 60);
+
+    draw_with_workers(2);
+    TEST_ASSERT_EQUAL_UINT32(1, thread_cnt);
+}
+
+void test_set_workers(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(LV_DRAW_SW_TILE_WORKERS, lv_draw_sw_tiles_get_workers());
+
+    lv_draw_sw_tiles_set_workers(3, -1);
+    TEST_ASSERT_EQUAL_UINT32(3, lv_draw_sw_tiles_get_workers());
+
+    lv_draw_sw_tiles_set_workers(100, -1);
+    TEST_ASSERT_EQUAL_UINT32(LV_DRAW_SW_TILE_WORKERS_MAX, lv_draw_sw_tiles_get_workers());
+}
+
+#else /*LV_USE_DRAW_SW_TILES*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_tiles_draw_the_same_pixels_as_one_thread(void)
+{
+
+}
+
+void test_workers_draw_with_the_masks_of_the_parent(void)
+{
+
+}
+
+void test_small_areas_are_drawn_by_the_lvgl_thread(void)
+{
+
+}
+
+void test_set_workers(void)
+{
+
+}
+
+#endif /*LV_USE_DRAW_SW_TILES*/
+
+#endif
@@ -0,0 +1,369 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_DRAW_COMPLEX
+
+#define SRC_MAX     24
+#define DEST_MAX    (64 * 40)
+#define ITERATIONS  3000
+
+static uint8_t src_buf[SRC_MAX * SRC_MAX * LV_IMG_PX_SIZE_ALPHA_BYTE];
+static lv_color_t cbuf_ref[DEST_MAX];
+static lv_color_t cbuf_test[DEST_MAX];
+static lv_opa_t abuf_ref[DEST_MAX];
+static lv_opa_t abuf_test[DEST_MAX];
+static uint32_t rnd_state = 0x2468ace1;
+static lv_draw_sw_transform_path_t path_def;
+
+static uint32_t rnd(void)
+{
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 17;
+    rnd_state ^= rnd_state << 5;
+    return rnd_state;
+}
+
+void setUp(void)
+{
+    path_def = lv_draw_sw_transform_get_path();
+}
+
+void tearDown(void)
+{
+    lv_draw_sw_transform_set_path(path_def);
+    lv_draw_sw_zoom_cache_set_budget(LV_DRAW_SW_ZOOM_CACHE_DEF_BYTES);
+}
+
+/*Patches of the same color, transparent and semi-transparent ones among them, like icons have*/
+static void make_src(lv_img_cf_t cf, lv_coord_t stride, lv_coord_t h)
+{
+    uint32_t px_size = cf == LV_IMG_CF_TRUE_COLOR_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+    uint32_t px_cnt = stride * h;
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        lv_color_t c = lv_color_make(rnd() % 4 * 85, rnd() % 2 * 255, rnd() % 3 * 127);
+        lv_opa_t a = rnd() % 4 == 0 ? LV_OPA_TRANSP : rnd() % 2 ? LV_OPA_COVER : (lv_opa_t)rnd();
+        lv_memcpy(&src_buf[i * px_size], &c, sizeof(lv_color_t));
+        if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) src_buf[i * px_size + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = a;
+#if LV_COLOR_DEPTH == 16
+        if(cf == LV_IMG_CF_RGB565A8) src_buf[px_cnt * sizeof(lv_color_t) + i] = a;
+#endif
+    }
+}
+
+static void transform(lv_draw_sw_transform_path_t path, const lv_area_t * area, lv_coord_t w, lv_coord_t h,
+                      lv_coord_t stride, const lv_draw_img_dsc_t * dsc, lv_img_cf_t cf,
+                      lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    lv_memset_00(cbuf, DEST_MAX * sizeof(lv_color_t));
+    lv_memset_ff(abuf, DEST_MAX);
+    lv_draw_sw_transform_set_path(path);
+    lv_draw_sw_transform(NULL, area, src_buf, w, h, stride, dsc, cf, cbuf, abuf);
+}
+
+void test_draw_sw_transform_zoom_separable_same_as_generic(void)
+{
+    static const uint16_t zooms[] = {32, 64, 85, 128, 192, 255, 257, 300, 384, 512, 768, 1024};
+    lv_img_cf_t cfs[] = {LV_IMG_CF_TRUE_COLOR, LV_IMG_CF_TRUE_COLOR_ALPHA,
+#if LV_COLOR_DEPTH == 16
+                         LV_IMG_CF_RGB565A8,
+#endif
+                        };
+    uint32_t i;
+    for(i = 0; i < ITERATIONS; i++) {
+        lv_img_cf_t cf = cfs[i % (sizeof(cfs) / sizeof(cfs[0]))];
+        lv_coord_t w = 1 + rnd() % SRC_MAX;
+        lv_coord_t h = 1 + rnd() % SRC_MAX;
+        lv_coord_t stride = cf == LV_IMG_CF_TRUE_COLOR ? w + (lv_coord_t)(rnd() % (SRC_MAX + 1 - w)) : w;
+        make_src(cf, stride, h);
+
+        lv_draw_img_dsc_t dsc;
+        lv_draw_img_dsc_init(&dsc);
+        dsc.zoom = i % 2 ? zooms[rnd() % (sizeof(zooms) / sizeof(zooms[0]))] : 16 + rnd() % 1024;
+        dsc.pivot.x = rnd() % (w + 8) - 4;
+        dsc.pivot.y = rnd() % (h + 8) - 4;
+        dsc.antialias = (i / 2) % 2;
+
+        /*Areas in and around the zoomed image, also cut like the chunks of lv_draw_sw_img*/
+        lv_area_t area;
+        area.x1 = rnd() % 80 - 30;
+        area.y1 = rnd() % 80 - 30;
+        area.x2 = area.x1 + rnd() % 64;
+        area.y2 = area.y1 + rnd() % 40;
+
+        transform(LV_DRAW_SW_TRANSFORM_GENERIC, &area, w, h, stride, &dsc, cf, cbuf_ref, abuf_ref);
+        transform(LV_DRAW_SW_TRANSFORM_SEPARABLE, &area, w, h, stride, &dsc, cf, cbuf_test, abuf_test);
+
+        char msg[96];
+        lv_snprintf(msg, sizeof(msg), "cf %d, %dx%d, zoom %d, pivot %d;%d, aa %d", cf, (int)w, (int)h, dsc.zoom,
+                    (int)dsc.pivot.x, (int)dsc.pivot.y, dsc.antialias);
+        uint32_t px_cnt = lv_area_get_size(&area);
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(abuf_ref, abuf_test, px_cnt, msg);
+        uint32_t p;
+        for(p = 0; p < px_cnt; p++) {
+            if(abuf_ref[p]) TEST_ASSERT_EQUAL_HEX32_MESSAGE(cbuf_ref[p].full, cbuf_test[p].full, msg);
+        }
+    }
+}
+
+void test_draw_sw_transform_zoom_2x_aa_right_edge(void)
+{
+    /*At 2x the last column is taken from just right of the image: transparent, and its color is left as it
+     *was, so buffers reused from an earlier call may differ there*/
+    lv_coord_t w = 24;
+    lv_coord_t h = 24;
+    make_src(LV_IMG_CF_TRUE_COLOR, w, h);
+
+    lv_draw_img_dsc_t dsc;
+    lv_draw_img_dsc_init(&dsc);
+    dsc.zoom = 2 * LV_IMG_ZOOM_NONE;
+    dsc.pivot.x = 0;
+    dsc.pivot.y = 0;
+    dsc.antialias = 1;
+
+    lv_area_t area;
+    lv_area_set(&area, 0, 0, 2 * w - 1, 39);
+    transform(LV_DRAW_SW_TRANSFORM_GENERIC, &area, w, h, w, &dsc, LV_IMG_CF_TRUE_COLOR, cbuf_ref, abuf_ref);
+    lv_memset_ff(cbuf_test, sizeof(cbuf_test));
+    lv_draw_sw_transform_set_path(LV_DRAW_SW_TRANSFORM_SEPARABLE);
+    lv_draw_sw_transform(NULL, &area, src_buf, w, h, w, &dsc, LV_IMG_CF_TRUE_COLOR, cbuf_test, abuf_test);
+
+    lv_coord_t dest_w = lv_area_get_width(&area);
+    uint32_t px_cnt = lv_area_get_size(&area);
+    TEST_ASSERT_EQUAL_MEMORY(abuf_ref, abuf_test, px_cnt);
+    uint32_t p;
+    for(p = 0; p < px_cnt; p++) {
+        if(p % dest_w == (uint32_t)dest_w - 1) TEST_ASSERT_EQUAL_UINT8(LV_OPA_TRANSP, abuf_test[p]);
+        if(abuf_ref[p]) TEST_ASSERT_EQUAL_HEX32(cbuf_ref[p].full, cbuf_test[p].full);
+    }
+}
+
+void test_draw_sw_transform_zoom_integer_repeats_pixels(void)
+{
+    lv_coord_t w = 7;
+    lv_coord_t h = 5;
+    make_src(LV_IMG_CF_TRUE_COLOR_ALPHA, w, h);
+
+    lv_coord_t rep;
+    for(rep = 2; rep <= 4; rep++) {
+        lv_draw_img_dsc_t dsc;
+        lv_draw_img_dsc_init(&dsc);
+        dsc.zoom = rep * LV_IMG_ZOOM_NONE;
+        dsc.pivot.x = 3;
+        dsc.pivot.y = 2;
+        dsc.antialias = rep != 3;
+
+        /*The zoomed image and a pixel around it*/
+        lv_area_t area;
+        lv_area_set(&area, dsc.pivot.x - dsc.pivot.x * rep - 1, dsc.pivot.y - dsc.pivot.y * rep - 1,
+                    dsc.pivot.x + (w - dsc.pivot.x) * rep, dsc.pivot.y + (h - dsc.pivot.y) * rep);
+        transform(LV_DRAW_SW_TRANSFORM_INTEGER, &area, w, h, w, &dsc, LV_IMG_CF_TRUE_COLOR_ALPHA, cbuf_test, abuf_test);
+
+        lv_coord_t dest_w = lv_area_get_width(&area);
+        lv_coord_t x;
+        lv_coord_t y;
+        for(y = 0; y < lv_area_get_height(&area); y++) {
+            for(x = 0; x < dest_w; x++) {
+                uint32_t i = y * dest_w + x;
+                lv_coord_t xs = x == 0 || x == dest_w - 1 ? -1 : (x - 1) / rep;
+                lv_coord_t ys = y == 0 || y == lv_area_get_height(&area) - 1 ? -1 : (y - 1) / rep;
+                if(xs < 0 || ys < 0) {
+                    TEST_ASSERT_EQUAL_UINT8(LV_OPA_TRANSP, abuf_test[i]);
+                    continue;
+                }
+                const uint8_t * px = &src_buf[(ys * w + xs) * LV_IMG_PX_SIZE_ALPHA_BYTE];
+                TEST_ASSERT_EQUAL_UINT8(px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1], abuf_test[i]);
+                if(abuf_test[i]) TEST_ASSERT_EQUAL_MEMORY(px, &cbuf_test[i], LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+            }
+        }
+    }
+}
+
+void test_draw_sw_transform_zoom_integer_averages_blocks(void)
+{
+    /*2x2 blocks: opaque red and blue, a transparent pixel that adds no color, all transparent*/
+    static const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_COVER, LV_OPA_COVER, LV_OPA_COVER,
+                                    LV_OPA_COVER, LV_OPA_COVER, LV_OPA_TRANSP, LV_OPA_COVER,
+                                    LV_OPA_TRANSP, LV_OPA_TRANSP, LV_OPA_TRANSP, LV_OPA_TRANSP
+                                   };
+    lv_coord_t w = 2;
+    lv_coord_t h = 6;
+    lv_color_t red = lv_color_make(0xff, 0, 0);
+    lv_color_t blue = lv_color_make(0, 0, 0xff);
+    uint32_t i;
+    for(i = 0; i < (uint32_t)(w * h); i++) {
+        lv_color_t c = i < 4 ? (i % 2 ? red : blue) : red;
+        lv_memcpy(&src_buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE], &c, sizeof(lv_color_t));
+        src_buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = opas[i];
+    }
+
+    lv_draw_img_dsc_t dsc;
+    lv_draw_img_dsc_init(&dsc);
+    dsc.zoom = LV_IMG_ZOOM_NONE / 2;
+    dsc.antialias = 1;
+
+    lv_area_t area;
+    lv_area_set(&area, 0, 0, 0, 2);
+    transform(LV_DRAW_SW_TRANSFORM_INTEGER, &area, w, h, w, &dsc, LV_IMG_CF_TRUE_COLOR_ALPHA, cbuf_test, abuf_test);
+
+    TEST_ASSERT_EQUAL_UINT8(LV_OPA_COVER, abuf_test[0]);
+    TEST_ASSERT_EQUAL_UINT8(LV_COLOR_GET_R(red) / 2, LV_COLOR_GET_R(cbuf_test[0]));
+    TEST_ASSERT_EQUAL_UINT8(LV_COLOR_GET_B(blue) / 2, LV_COLOR_GET_B(cbuf_test[0]));
+
+    TEST_ASSERT_EQUAL_UINT8(LV_OPA_COVER * 3 / 4, abuf_test[1]);
+    TEST_ASSERT_EQUAL_HEX32(red.full, cbuf_test[1].full);
+
+    TEST_ASSERT_EQUAL_UINT8(LV_OPA_TRANSP, abuf_test[2]);
+
+    /*Without anti-aliasing 1/2x takes one pixel of the blocks, as the other paths do*/
+    dsc.antialias = 0;
+    transform(LV_DRAW_SW_TRANSFORM_GENERIC, &area, w, h, w, &dsc, LV_IMG_CF_TRUE_COLOR_ALPHA, cbuf_ref, abuf_ref);
+    transform(LV_DRAW_SW_TRANSFORM_INTEGER, &area, w, h, w, &dsc, LV_IMG_CF_TRUE_COLOR_ALPHA, cbuf_test, abuf_test);
+    TEST_ASSERT_EQUAL_MEMORY(abuf_ref, abuf_test, 3);
+}
+
+void test_draw_sw_transform_zoom_integer_averages_opaque(void)
+{
+    /*Opaque images are averaged without weights, check that against the same pixels with alpha*/
+    static lv_color_t opaque[SRC_MAX * SRC_MAX];
+    lv_coord_t w = 20;
+    lv_coord_t h = 20;
+    uint32_t i;
+    for(i = 0; i < (uint32_t)(w * h); i++) {
+        opaque[i] = lv_color_make(rnd(), rnd(), rnd());
+        lv_memcpy(&src_buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE], &opaque[i], sizeof(lv_color_t));
+        src_buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = LV_OPA_COVER;
+    }
+
+    lv_coord_t box;
+    for(box = 2; box <= 5; box++) {
+        lv_draw_img_dsc_t dsc;
+        lv_draw_img_dsc_init(&dsc);
+        dsc.zoom = LV_IMG_ZOOM_NONE / box;
+        dsc.pivot.x = 0;
+        dsc.pivot.y = 0;
+        dsc.antialias = 1;
+
+        /*Also the boxes only partly on the image*/
+        lv_area_t area;
+        lv_area_set(&area, 0, 0, w / box, h / box);
+        transform(LV_DRAW_SW_TRANSFORM_INTEGER, &area, w, h, w, &dsc, LV_IMG_CF_TRUE_COLOR_ALPHA, cbuf_ref, abuf_ref);
+        lv_draw_sw_transform(NULL, &area, opaque, w, h, w, &dsc, LV_IMG_CF_TRUE_COLOR, cbuf_test, abuf_test);
+
+        uint32_t px_cnt = lv_area_get_size(&area);
+        TEST_ASSERT_EQUAL_MEMORY(abuf_ref, abuf_test, px_cnt);
+        for(i = 0; i < px_cnt; i++) {
+            if(abuf_ref[i]) TEST_ASSERT_EQUAL_HEX32(cbuf_ref[i].full, cbuf_test[i].full);
+        }
+    }
+}
+
+void test_draw_sw_transform_zoom_cache(void)
+{
+    static lv_color_t px[4 * 3];
+    uint32_t i;
+    for(i = 0; i < 4 * 3; i++) px[i] = lv_color_make(i * 20, 255 - i * 20, 0x40);
+    lv_img_dsc_t img;
+    lv_memset_00(&img, sizeof(img));
+    img.header.cf = LV_IMG_CF_TRUE_COLOR;
+    img.header.w = 4;
+    img.header.h = 3;
+    img.data_size = sizeof(px);
+    img.data = (const uint8_t *)px;
+
+    lv_draw_sw_zoom_cache_set_budget(64 * 1024);
+    lv_draw_sw_transform_set_path(LV_DRAW_SW_TRANSFORM_INTEGER);
+
+    const lv_img_dsc_t * zoomed = lv_draw_sw_zoom_cache_open(&img, 2 * LV_IMG_ZOOM_NONE);
+    TEST_ASSERT_NOT_NULL(zoomed);
+    TEST_ASSERT_EQUAL(LV_IMG_CF_TRUE_COLOR_ALPHA, zoomed->header.cf);
+    TEST_ASSERT_EQUAL(8, zoomed->header.w);
+    TEST_ASSERT_EQUAL(6, zoomed->header.h);
+
+    /*Every pixel of the image twice in both directions*/
+    uint32_t x;
+    uint32_t y;
+    for(y = 0; y < 6; y++) {
+        for(x = 0; x < 8; x++) {
+            const uint8_t * p = &zoomed->data[(y * 8 + x) * LV_IMG_PX_SIZE_ALPHA_BYTE];
+            TEST_ASSERT_EQUAL_MEMORY(&px[(y / 2) * 4 + x / 2], p, LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+            TEST_ASSERT_EQUAL_UINT8(LV_OPA_COVER, p[LV_IMG_PX_SIZE_ALPHA_BYTE - 1]);
+        }
+    }
+
+    /*Shared by the same source and zoom, kept while unused*/
+    TEST_ASSERT_EQUAL_PTR(zoomed, lv_draw_sw_zoom_cache_open(&img, 2 * LV_IMG_ZOOM_NONE));
+    const lv_img_dsc_t * half = lv_draw_sw_zoom_cache_open(&img, LV_IMG_ZOOM_NONE / 2);
+    TEST_ASSERT_NOT_NULL(half);
+    TEST_ASSERT_TRUE(zoomed != half);
+    TEST_ASSERT_EQUAL(2, half->header.w);
+
+    lv_draw_sw_zoom_cache_stats_t stats;
+    lv_draw_sw_zoom_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.img_cnt);
+    TEST_ASSERT_EQUAL(3, stats.ref_cnt);
+    TEST_ASSERT_EQUAL((8 * 6 + 2 * 2) * LV_IMG_PX_SIZE_ALPHA_BYTE, stats.bytes);
+
+    lv_draw_sw_zoom_cache_close(zoomed);
+    lv_draw_sw_zoom_cache_close(zoomed);
+    lv_draw_sw_zoom_cache_close(half);
+    lv_draw_sw_zoom_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.img_cnt);
+    TEST_ASSERT_EQUAL(0, stats.ref_cnt);
+
+    /*The least recently used images nobody uses make room, one that doesn't fit is not zoomed*/
+    lv_draw_sw_zoom_cache_set_budget(100);
+    lv_draw_sw_zoom_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.img_cnt);
+    TEST_ASSERT_EQUAL(2 * 2 * LV_IMG_PX_SIZE_ALPHA_BYTE, stats.bytes);
+    TEST_ASSERT_NULL(lv_draw_sw_zoom_cache_open(&img, 2 * LV_IMG_ZOOM_NONE));
+    TEST_ASSERT_NULL(lv_draw_sw_zoom_cache_open(&img, LV_IMG_ZOOM_NONE));
+}
+
+#else /*LV_DRAW_COMPLEX*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_draw_sw_transform_zoom_separable_same_as_generic(void)
+{
+
+}
+
+void test_draw_sw_transform_zoom_2x_aa_right_edge(void)
+{
+
+}
+
+void test_draw_sw_transform_zoom_integer_repeats_pixels(void)
+{
+
+}
+
+void test_draw_sw_transform_zoom_integer_averages_blocks(void)
+{
+
+}
+
+void test_draw_sw_transform_zoom_integer_averages_opaque(void)
+{
+
+}
+
+void test_draw_sw_transform_zoom_cache(void)
+{
+
+}
+
+#endif /*LV_DRAW_COMPLEX*/
+
+#endif
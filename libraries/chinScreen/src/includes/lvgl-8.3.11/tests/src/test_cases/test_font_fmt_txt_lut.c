@@ -0,0 +1,98 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+/*Fonts of chinScreen with the tables of extras/font_compile.py: kern pairs with format 0 and sparse
+ *cmaps, a format 0 cmap with glyph ID offsets and a font without kerning*/
+#include "../../../../fonts/aladin.inc"
+#include "../../../../fonts/emoji_18.inc"
+#include "../../../../fonts/monster.inc"
+
+#define LAST_LETTER     0x24F   /*Past Latin-1, so the cmaps are used too*/
+
+/*The same font with the callbacks of lv_font_fmt_txt.c*/
+static lv_font_t plain_font(const lv_font_t * font)
+{
+    lv_font_t plain = *font;
+    plain.get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
+    plain.get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    return plain;
+}
+
+static void assert_same_glyphs(const lv_font_t * font)
+{
+    lv_font_t plain = plain_font(font);
+    uint32_t found = 0;
+    uint32_t kerned = 0;
+    uint32_t letter;
+    for(letter = 0; letter <= LAST_LETTER; letter++) {
+        TEST_ASSERT_EQUAL_PTR(plain.get_glyph_bitmap(&plain, letter), font->get_glyph_bitmap(font, letter));
+
+        uint32_t next;
+        for(next = 0; next <= LAST_LETTER; next++) {
+            lv_font_glyph_dsc_t ref;
+            lv_font_glyph_dsc_t g;
+            lv_memset_ff(&ref, sizeof(ref));
+            lv_memset_ff(&g, sizeof(g));
+            bool ref_ret = plain.get_glyph_dsc(&plain, &ref, letter, next);
+            bool ret = font->get_glyph_dsc(font, &g, letter, next);
+            TEST_ASSERT_EQUAL(ref_ret, ret);
+            if(!ret) break;         /*The letter isn't in the font, no need to try every next one*/
+
+            TEST_ASSERT_EQUAL_MEMORY(&ref, &g, sizeof(ref));
+            if(next == 0) found++;
+            else {
+                lv_font_glyph_dsc_t alone;
+                font->get_glyph_dsc(font, &alone, letter, 0);
+                if(alone.adv_w != g.adv_w) kerned++;
+            }
+        }
+    }
+
+    TEST_ASSERT_GREATER_THAN(60, found);
+    if(((lv_font_fmt_txt_dsc_t *)font->dsc)->kern_dsc) TEST_ASSERT_GREATER_THAN(0, kerned);
+}
+
+void test_font_fmt_txt_lut_kern_pairs(void)
+{
+    assert_same_glyphs(&aladin);
+}
+
+void test_font_fmt_txt_lut_glyph_id_ofs_list(void)
+{
+    assert_same_glyphs(&emoji_18);
+}
+
+void test_font_fmt_txt_lut_no_kerning(void)
+{
+    assert_same_glyphs(&monster);
+}
+
+void test_font_fmt_txt_lut_tab(void)
+{
+    lv_font_t plain = plain_font(&aladin);
+    lv_font_glyph_dsc_t ref;
+    lv_font_glyph_dsc_t g;
+    lv_memset_00(&ref, sizeof(ref));
+    lv_memset_00(&g, sizeof(g));
+    TEST_ASSERT_TRUE(plain.get_glyph_dsc(&plain, &ref, '\t', 'A'));
+    TEST_ASSERT_TRUE(aladin.get_glyph_dsc(&aladin, &g, '\t', 'A'));
+    TEST_ASSERT_EQUAL_MEMORY(&ref, &g, sizeof(ref));
+    TEST_ASSERT_EQUAL_PTR(plain.get_glyph_bitmap(&plain, ' '), aladin.get_glyph_bitmap(&aladin, '\t'));
+}
+
+void test_font_fmt_txt_lut_label(void)
+{
+    /*Measured by the label the same way*/
+    lv_font_t plain = plain_font(&aladin);
+    const char * text = "Temp\xC3\xA9rature: 23.5\xC2\xB0" "C, AVAWAY\tTo";
+    lv_point_t ref;
+    lv_point_t size;
+    lv_txt_get_size(&ref, text, &plain, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    lv_txt_get_size(&size, text, &aladin, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_EQUAL(ref.x, size.x);
+    TEST_ASSERT_EQUAL(ref.y, size.y);
+}
+
+#endif
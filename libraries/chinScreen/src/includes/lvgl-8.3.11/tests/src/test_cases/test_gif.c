@@ -0,0 +1,387 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_GIF
+
+#include "../../../../icons/ani/wifi-1.inc"
+#include "../../../../icons/ani/loading-9.inc"
+#include "../../../../icons/ani/gear-1.inc"
+#include "../../../../sprites/m_f_1.inc"
+#include "../../../../sprites/m_f_2.inc"
+
+/*2x1, a GCT of red and blue. Frame 1: red, blue. Frame 2 with color 1 transparent: 1, 0*/
+static const uint8_t two_frames_gif[] = {
+    0x47, 0x49, 0x46, 0x38, 0x39, 0x61, 0x02, 0x00, 0x01, 0x00, 0x80, 0x00, 0x00,
+    0xff, 0x00, 0x00, 0x00, 0x00, 0xff,
+    0x2c, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x02, 0x02, 0x44, 0x0a, 0x00,
+    0x21, 0xf9, 0x04, 0x01, 0x0a, 0x00, 0x01, 0x00,
+    0x2c, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x02, 0x02, 0x0c, 0x0a, 0x00,
+    0x3b
+};
+
+/*2x1, only local color tables of red and blue, color 1 transparent. Frame 1: red, transparent.
+ *Frame 2: transparent, red, then disposed to the transparent background, so every loop starts the same*/
+static const uint8_t alpha_gif[] = {
+    0x47, 0x49, 0x46, 0x38, 0x39, 0x61, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x21, 0xf9, 0x04, 0x01, 0x0a, 0x00, 0x01, 0x00,
+    0x2c, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x01, 0x00, 0x80, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff,
+    0x02, 0x02, 0x44, 0x0a, 0x00,
+    0x21, 0xf9, 0x04, 0x09, 0x0a, 0x00, 0x01, 0x00,
+    0x2c, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x01, 0x00, 0x80, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff,
+    0x02, 0x02, 0x0c, 0x0a, 0x00,
+    0x3b
+};
+
+static void assert_canvas_px(gd_GIF * gif, uint32_t i, lv_color_t expected, uint8_t opa)
+{
+    const uint8_t * px = &gif->canvas[i * GD_PX_SIZE];
+    lv_color_t c;
+    lv_memcpy(&c, px, sizeof(c));
+    TEST_ASSERT_EQUAL_HEX32(lv_color_to32(expected), lv_color_to32(c));
+    TEST_ASSERT_EQUAL_HEX8(opa, px[GD_PX_SIZE - 1]);
+}
+
+static lv_obj_t * gif_create_atlas(const unsigned char * data, unsigned int len, bool atlas)
+{
+    static lv_img_dsc_t dsc;
+    dsc.data = data;
+    dsc.data_size = len;
+
+    lv_obj_t * obj = lv_gif_create(lv_scr_act());
+    lv_gif_set_atlas(obj, atlas);
+    lv_gif_set_src(obj, &dsc);
+    lv_obj_set_pos(obj, 100, 100);
+    lv_obj_update_layout(obj);
+    lv_refr_now(NULL);
+    return obj;
+}
+
+static lv_obj_t * gif_create(const unsigned char * data, unsigned int len)
+{
+    return gif_create_atlas(data, len, false);
+}
+
+/*Step to the next frame without waiting for its delay*/
+static void gif_next_frame(lv_obj_t * obj)
+{
+    lv_gif_t * gifobj = (lv_gif_t *)obj;
+    gifobj->last_call = lv_tick_get() - 10000;
+    gifobj->timer->timer_cb(gifobj->timer);
+}
+
+static uint32_t invalidated_px(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    uint32_t px = 0;
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) px += lv_area_get_size(&disp->inv_areas[i]);
+    return px;
+}
+
+static bool is_invalidated(lv_coord_t x, lv_coord_t y)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_point_t p = {x, y};
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(_lv_area_is_point_on(&disp->inv_areas[i], &p, 0)) return true;
+    }
+    return false;
+}
+
+void setUp(void)
+{
+    lv_gif_atlas_set_budget(2 * 1024 * 1024);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_refr_now(NULL);
+
+    /*Free the unused atlases*/
+    lv_gif_atlas_set_budget(0);
+}
+
+static lv_gif_atlas_stats_t atlas_stats(void)
+{
+    lv_gif_atlas_stats_t s;
+    lv_gif_atlas_get_stats(&s);
+    return s;
+}
+
+/*The decoding GIF and the one playing from the atlas show the same pixels*/
+static void assert_same_frame(lv_obj_t * decoded, lv_obj_t * atlas)
+{
+    const lv_img_dsc_t * d = &((lv_gif_t *)decoded)->imgdsc;
+    const lv_img_dsc_t * a = &((lv_gif_t *)atlas)->imgdsc;
+    const uint32_t a_px_size = a->header.cf == LV_IMG_CF_TRUE_COLOR ? sizeof(lv_color_t) : GD_PX_SIZE;
+    uint32_t i;
+    for(i = 0; i < (uint32_t)d->header.w * d->header.h; i++) {
+        const uint8_t opa = d->data[i * GD_PX_SIZE + GD_PX_SIZE - 1];
+        if(a_px_size == GD_PX_SIZE) TEST_ASSERT_EQUAL_HEX8(opa, a->data[i * GD_PX_SIZE + GD_PX_SIZE - 1]);
+        else TEST_ASSERT_EQUAL_HEX8(0xff, opa);
+
+        /*The color of transparent pixels doesn't matter*/
+        if(opa) TEST_ASSERT_EQUAL_MEMORY(&d->data[i * GD_PX_SIZE], &a->data[i * a_px_size], GD_PX_SIZE - 1);
+    }
+}
+
+static uint32_t ready_cnt;
+
+static void ready_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    ready_cnt++;
+}
+
+void test_gif_palette_and_transparency(void)
+{
+    gd_GIF * gif = gd_open_gif_data(two_frames_gif);
+    TEST_ASSERT_NOT_NULL(gif);
+
+    TEST_ASSERT_EQUAL(1, gd_get_frame(gif));
+    gd_render_frame(gif, gif->canvas);
+    assert_canvas_px(gif, 0, lv_color_hex(0xff0000), 0xff);
+    assert_canvas_px(gif, 1, lv_color_hex(0x0000ff), 0xff);
+
+    /*The transparent pixel keeps what the first frame drew*/
+    TEST_ASSERT_EQUAL(1, gd_get_frame(gif));
+    gd_render_frame(gif, gif->canvas);
+    assert_canvas_px(gif, 0, lv_color_hex(0xff0000), 0xff);
+    assert_canvas_px(gif, 1, lv_color_hex(0xff0000), 0xff);
+
+    TEST_ASSERT_EQUAL(0, gd_get_frame(gif));
+    gd_close_gif(gif);
+}
+
+void test_gif_file_matches_data(void)
+{
+    gd_GIF * data = gd_open_gif_data(wifi_1_gif);
+    gd_GIF * file = gd_open_gif_file("A:../../icons/ani/wifi-1.gif");
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_NOT_NULL(file);
+
+    /*Past the end, through a rewind*/
+    const uint32_t size = data->width * data->height * GD_PX_SIZE;
+    uint32_t i;
+    for(i = 0; i < 50; i++) {
+        int res = gd_get_frame(data);
+        TEST_ASSERT_EQUAL(res, gd_get_frame(file));
+        TEST_ASSERT_TRUE(res >= 0);
+        if(res == 0) {
+            gd_rewind(data);
+            gd_rewind(file);
+            continue;
+        }
+        gd_render_frame(data, data->canvas);
+        gd_render_frame(file, file->canvas);
+        TEST_ASSERT_EQUAL_MEMORY(data->canvas, file->canvas, size);
+    }
+
+    gd_close_gif(data);
+    gd_close_gif(file);
+}
+
+void test_gif_without_global_color_table(void)
+{
+    /*Only a local color table, like the sprites*/
+    gd_GIF * gif = gd_open_gif_data(m_f_1_gif);
+    TEST_ASSERT_NOT_NULL(gif);
+    TEST_ASSERT_EQUAL(1, gd_get_frame(gif));
+    gd_render_frame(gif, gif->canvas);
+
+    uint32_t i;
+    for(i = 0; i < (uint32_t)gif->width * gif->height; i++) {
+        TEST_ASSERT_EQUAL_HEX8(0xff, gif->canvas[i * GD_PX_SIZE + GD_PX_SIZE - 1]);
+    }
+    gd_close_gif(gif);
+}
+
+void test_gif_invalidates_only_changed_area(void)
+{
+    static const struct {
+        const unsigned char * data;
+        unsigned int len;
+        uint32_t max_percent;   /*Of the whole GIF redrawn per frame, on average*/
+    } gifs[] = {
+        {wifi_1_gif, sizeof(wifi_1_gif), 80},
+        {loading_9_gif, sizeof(loading_9_gif), 65},
+        {gear_1_gif, sizeof(gear_1_gif), 85},
+    };
+
+    uint32_t g;
+    for(g = 0; g < sizeof(gifs) / sizeof(gifs[0]); g++) {
+        lv_obj_t * obj = gif_create(gifs[g].data, gifs[g].len);
+        gd_GIF * gif = ((lv_gif_t *)obj)->gif;
+        uint32_t total = 0;
+        uint32_t i;
+
+        /*What redrawing the whole GIF costs*/
+        lv_obj_invalidate(obj);
+        const uint32_t full = invalidated_px();
+        lv_refr_now(NULL);
+
+        /*Past the last frame, so the loop back to the first one is counted too*/
+        for(i = 0; i < 100; i++) {
+            gif_next_frame(obj);
+            const uint32_t px = invalidated_px();
+            TEST_ASSERT_TRUE(px <= full);
+            total += px;
+
+            /*Everything the frame changed is redrawn*/
+            if(gif->dirty.x2 >= gif->dirty.x1) {
+                TEST_ASSERT_TRUE(is_invalidated(obj->coords.x1 + gif->dirty.x1, obj->coords.y1 + gif->dirty.y1));
+                TEST_ASSERT_TRUE(is_invalidated(obj->coords.x1 + gif->dirty.x2, obj->coords.y1 + gif->dirty.y2));
+            }
+            lv_refr_now(NULL);
+        }
+        TEST_ASSERT_LESS_THAN_UINT32(full * 100 * gifs[g].max_percent / 100, total);
+        lv_obj_del(obj);
+        lv_refr_now(NULL);
+    }
+}
+
+void test_gif_invalidate_zoomed_and_rotated(void)
+{
+    lv_obj_t * obj = gif_create(wifi_1_gif, sizeof(wifi_1_gif));
+    gd_GIF * gif = ((lv_gif_t *)obj)->gif;
+    lv_img_t * img = (lv_img_t *)obj;
+    lv_img_set_zoom(obj, 512);
+    lv_img_set_angle(obj, 300);
+    lv_refr_now(NULL);
+
+    lv_area_t whole;
+    _lv_img_buf_get_transformed_area(&whole, img->w, img->h, img->angle, img->zoom, &img->pivot);
+
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        gif_next_frame(obj);
+        TEST_ASSERT_TRUE(invalidated_px() < lv_area_get_size(&whole));
+
+        /*The corners of the changed area, where they are drawn*/
+        lv_point_t p[4] = {
+            {gif->dirty.x1, gif->dirty.y1},
+            {gif->dirty.x2, gif->dirty.y1},
+            {gif->dirty.x1, gif->dirty.y2},
+            {gif->dirty.x2, gif->dirty.y2},
+        };
+        uint32_t c;
+        for(c = 0; c < 4; c++) {
+            lv_point_transform(&p[c], img->angle, img->zoom, &img->pivot);
+            TEST_ASSERT_TRUE(is_invalidated(obj->coords.x1 + p[c].x, obj->coords.y1 + p[c].y));
+        }
+        lv_refr_now(NULL);
+    }
+}
+
+void test_gif_atlas_matches_decoding(void)
+{
+    static const struct {
+        const unsigned char * data;
+        unsigned int len;
+        lv_img_cf_t cf;
+    } gifs[] = {
+        {alpha_gif, sizeof(alpha_gif), LV_IMG_CF_TRUE_COLOR_ALPHA},
+        {wifi_1_gif, sizeof(wifi_1_gif), LV_IMG_CF_TRUE_COLOR},     /*Opaque, without the alpha bytes*/
+        {m_f_1_gif, sizeof(m_f_1_gif), LV_IMG_CF_TRUE_COLOR},
+    };
+
+    uint32_t g;
+    for(g = 0; g < sizeof(gifs) / sizeof(gifs[0]); g++) {
+        lv_obj_t * decoded = gif_create(gifs[g].data, gifs[g].len);
+        lv_obj_t * atlas = gif_create_atlas(gifs[g].data, gifs[g].len, true);
+        TEST_ASSERT_NOT_NULL(((lv_gif_t *)atlas)->atlas);
+        TEST_ASSERT_NULL(((lv_gif_t *)atlas)->gif);
+        TEST_ASSERT_EQUAL(gifs[g].cf, ((lv_gif_t *)atlas)->imgdsc.header.cf);
+
+        /*Past the last frame, so the loop back to the first one is compared too*/
+        lv_timer_t * timer = ((lv_gif_t *)decoded)->timer;
+        uint32_t i;
+        for(i = 0; i < 100 && !timer->paused; i++) {
+            assert_same_frame(decoded, atlas);
+            gif_next_frame(decoded);
+            gif_next_frame(atlas);
+            TEST_ASSERT_EQUAL(timer->paused, ((lv_gif_t *)atlas)->timer->paused);
+        }
+        lv_obj_del(decoded);
+        lv_obj_del(atlas);
+    }
+}
+
+void test_gif_atlas_counts_loops(void)
+{
+    /*No loop extension, played once*/
+    lv_obj_t * atlas = gif_create_atlas(alpha_gif, sizeof(alpha_gif), true);
+    lv_obj_add_event_cb(atlas, ready_cb, LV_EVENT_READY, NULL);
+    ready_cnt = 0;
+    TEST_ASSERT_EQUAL(2, atlas_stats().frame_cnt);
+
+    gif_next_frame(atlas);
+    TEST_ASSERT_EQUAL(0, ready_cnt);
+    gif_next_frame(atlas);
+    TEST_ASSERT_EQUAL(1, ready_cnt);
+    TEST_ASSERT_TRUE(((lv_gif_t *)atlas)->timer->paused);
+
+    /*The last frame stays until restarted*/
+    TEST_ASSERT_EQUAL(1, ((lv_gif_t *)atlas)->atlas_frame);
+    lv_gif_restart(atlas);
+    gif_next_frame(atlas);
+    TEST_ASSERT_EQUAL(0, ((lv_gif_t *)atlas)->atlas_frame);
+    TEST_ASSERT_EQUAL(1, ready_cnt);
+}
+
+void test_gif_atlas_shared_and_budget(void)
+{
+    lv_obj_t * a = gif_create_atlas(wifi_1_gif, sizeof(wifi_1_gif), true);
+    lv_obj_t * b = gif_create_atlas(wifi_1_gif, sizeof(wifi_1_gif), true);
+    lv_gif_atlas_stats_t s = atlas_stats();
+    TEST_ASSERT_EQUAL(1, s.atlas_cnt);
+    TEST_ASSERT_EQUAL(2, s.ref_cnt);
+    TEST_ASSERT_EQUAL_PTR(((lv_gif_t *)a)->atlas, ((lv_gif_t *)b)->atlas);
+    const uint32_t bytes = s.bytes;
+    TEST_ASSERT_TRUE(bytes >= s.frame_cnt * 64 * 64 * sizeof(lv_color_t));
+
+    /*Kept without users until the room is needed*/
+    lv_obj_del(a);
+    lv_obj_del(b);
+    s = atlas_stats();
+    TEST_ASSERT_EQUAL(1, s.atlas_cnt);
+    TEST_ASSERT_EQUAL(0, s.ref_cnt);
+    a = gif_create_atlas(wifi_1_gif, sizeof(wifi_1_gif), true);
+    TEST_ASSERT_EQUAL(1, atlas_stats().atlas_cnt);
+    lv_obj_del(a);
+
+    /*The unused one makes room*/
+    lv_gif_atlas_set_budget(bytes);
+    a = gif_create_atlas(m_f_1_gif, sizeof(m_f_1_gif), true);
+    b = gif_create_atlas(m_f_2_gif, sizeof(m_f_2_gif), true);
+    s = atlas_stats();
+    TEST_ASSERT_EQUAL(2, s.atlas_cnt);
+    TEST_ASSERT_EQUAL(2, s.ref_cnt);
+    TEST_ASSERT_TRUE(s.bytes < bytes);
+
+    /*The second loop would start from the second frame's transparency: decoded as usual*/
+    lv_gif_atlas_set_budget(2 * 1024 * 1024);
+    lv_obj_t * d = gif_create_atlas(two_frames_gif, sizeof(two_frames_gif), true);
+    TEST_ASSERT_NULL(((lv_gif_t *)d)->atlas);
+    TEST_ASSERT_NOT_NULL(((lv_gif_t *)d)->gif);
+
+    /*Too big for the budget: decoded as usual*/
+    lv_gif_atlas_set_budget(bytes - 1);
+    lv_obj_t * c = gif_create_atlas(wifi_1_gif, sizeof(wifi_1_gif), true);
+    TEST_ASSERT_NULL(((lv_gif_t *)c)->atlas);
+    TEST_ASSERT_NOT_NULL(((lv_gif_t *)c)->gif);
+
+    /*Lowering the budget doesn't take the frames of playing GIFs*/
+    lv_gif_atlas_set_budget(0);
+    TEST_ASSERT_EQUAL(2, atlas_stats().atlas_cnt);
+    lv_obj_del(a);
+    TEST_ASSERT_EQUAL(1, atlas_stats().atlas_cnt);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,111 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_init.h"
+
+static lv_grad_dsc_t grad;
+
+static lv_obj_t * grad_obj_create(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, 10, 10);
+    lv_obj_set_size(obj, 100, 200);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_grad(obj, &grad, 0);
+    return obj;
+}
+
+/*The test display copies only the refreshed area into test_fb, so always refresh all of it*/
+static void refresh(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+static lv_color32_t px(lv_coord_t x, lv_coord_t y)
+{
+    lv_color32_t c;
+    c.full = lv_color_to32(test_fb[y * TEST_HOR_RES + x]);
+    return c;
+}
+
+static void assert_px_near(lv_color_t expected, lv_coord_t x, lv_coord_t y)
+{
+    lv_color32_t e;
+    e.full = lv_color_to32(expected);
+    lv_color32_t a = px(x, y);
+    /*One step of the lowest color depth the tests run with*/
+    TEST_ASSERT_INT_WITHIN(8, e.ch.red, a.ch.red);
+    TEST_ASSERT_INT_WITHIN(8, e.ch.green, a.ch.green);
+    TEST_ASSERT_INT_WITHIN(8, e.ch.blue, a.ch.blue);
+}
+
+void setUp(void)
+{
+    lv_memset_00(&grad, sizeof(grad));
+    grad.dir = LV_GRAD_DIR_VER;
+    grad.stops_count = 2;
+    grad.stops[0].color = lv_color_hex(0xff0000);
+    grad.stops[0].frac = 0;
+    grad.stops[1].color = lv_color_hex(0x0000ff);
+    grad.stops[1].frac = 255;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_gradient_stops_changed_in_place(void)
+{
+    grad_obj_create();
+    refresh();
+    assert_px_near(lv_color_hex(0xff0000), 50, 10);
+    assert_px_near(lv_color_hex(0x0000ff), 50, 209);
+
+    /*Same descriptor, other colors: the cached map must not be reused*/
+    grad.stops[0].color = lv_color_hex(0x00ff00);
+    grad.stops[1].color = lv_color_hex(0xffff00);
+    refresh();
+    assert_px_near(lv_color_hex(0x00ff00), 50, 10);
+    assert_px_near(lv_color_hex(0xffff00), 50, 209);
+}
+
+void test_gradient_rows_follow_map(void)
+{
+    grad_obj_create();
+    refresh();
+
+    /*Monotonic from red to blue, every column of a row the same*/
+    lv_coord_t y;
+    for(y = 11; y < 210; y++) {
+        TEST_ASSERT_TRUE(px(50, y).ch.red <= px(50, y - 1).ch.red);
+        TEST_ASSERT_TRUE(px(50, y).ch.blue >= px(50, y - 1).ch.blue);
+        TEST_ASSERT_EQUAL_HEX32(px(10, y).full, px(109, y).full);
+    }
+    assert_px_near(lv_color_hex(0x800080), 50, 110);
+}
+
+void test_gradient_multi_stop(void)
+{
+#if LV_GRADIENT_MAX_STOPS >= 3
+    /*The first two stops equal: still a gradient, not a plain fill*/
+    grad.stops_count = 3;
+    grad.stops[1].color = lv_color_hex(0xff0000);
+    grad.stops[1].frac = 128;
+    grad.stops[2].color = lv_color_hex(0x0000ff);
+    grad.stops[2].frac = 255;
+
+    grad_obj_create();
+    refresh();
+    assert_px_near(lv_color_hex(0xff0000), 50, 10);
+    assert_px_near(lv_color_hex(0xff0000), 50, 100);
+    assert_px_near(lv_color_hex(0x0000ff), 50, 209);
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
@@ -0,0 +1,250 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_IMG_CACHE_DEF_SIZE
+
+#define IMG_W   16
+#define IMG_H   16
+#define IMG_BYTES   (IMG_W * IMG_H * LV_IMG_PX_SIZE_ALPHA_BYTE)
+
+/*"Encoded" images only the test decoder opens, like PNGs in C arrays*/
+static const uint8_t encoded[] = {0x42};
+static lv_img_dsc_t imgs[4];
+static uint32_t open_cnt;
+static uint32_t close_cnt;
+
+static bool is_test_img(const void * src)
+{
+    return lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE &&
+           (const lv_img_dsc_t *)src >= &imgs[0] && (const lv_img_dsc_t *)src < &imgs[4];
+}
+
+static lv_res_t test_decoder_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(decoder);
+    if(!is_test_img(src)) return LV_RES_INV;
+    header->always_zero = 0;
+    header->cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    header->w = IMG_W;
+    header->h = IMG_H;
+    return LV_RES_OK;
+}
+
+static lv_res_t test_decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    if(!is_test_img(dsc->src)) return LV_RES_INV;
+    uint8_t * data = lv_img_cache_alloc(IMG_BYTES);
+    if(data == NULL) return LV_RES_INV;
+    lv_memset_00(data, IMG_BYTES);
+    dsc->img_data = data;
+    open_cnt++;
+    return LV_RES_OK;
+}
+
+static void test_decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    lv_img_cache_free((void *)dsc->img_data);
+    dsc->img_data = NULL;
+    close_cnt++;
+}
+
+static lv_img_cache_stats_t stats(void)
+{
+    lv_img_cache_stats_t s;
+    lv_img_cache_get_stats(&s);
+    return s;
+}
+
+static bool open_img(int i)
+{
+    return _lv_img_cache_open(&imgs[i], lv_color_black(), 0) != NULL;
+}
+
+void setUp(void)
+{
+    static lv_img_decoder_t * decoder;
+    if(decoder == NULL) {
+        uint32_t i;
+        for(i = 0; i < 4; i++) {
+            imgs[i].header.cf = LV_IMG_CF_RAW_ALPHA;
+            imgs[i].data = encoded;
+            imgs[i].data_size = sizeof(encoded);
+        }
+
+        decoder = lv_img_decoder_create();
+        lv_img_decoder_set_info_cb(decoder, test_decoder_info);
+        lv_img_decoder_set_open_cb(decoder, test_decoder_open);
+        lv_img_decoder_set_close_cb(decoder, test_decoder_close);
+    }
+
+    lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+    lv_img_cache_set_budget(LV_IMG_CACHE_DEF_BYTES);
+    lv_img_cache_reset_stats();
+    open_cnt = 0;
+    close_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_img_cache_invalidate_src(NULL);
+}
+
+void test_img_cache_hit_decodes_once(void)
+{
+    _lv_img_cache_entry_t * e1 = _lv_img_cache_open(&imgs[0], lv_color_black(), 0);
+    _lv_img_cache_entry_t * e2 = _lv_img_cache_open(&imgs[0], lv_color_black(), 0);
+    TEST_ASSERT_NOT_NULL(e1);
+    TEST_ASSERT_EQUAL_PTR(e1, e2);
+    TEST_ASSERT_EQUAL(1, open_cnt);
+
+    /*Another recolor or frame is another image*/
+    TEST_ASSERT_NOT_NULL(_lv_img_cache_open(&imgs[0], lv_color_white(), 0));
+    TEST_ASSERT_NOT_NULL(_lv_img_cache_open(&imgs[0], lv_color_black(), 1));
+    TEST_ASSERT_EQUAL(3, open_cnt);
+
+    lv_img_cache_stats_t s = stats();
+    TEST_ASSERT_EQUAL(1, s.hits);
+    TEST_ASSERT_EQUAL(3, s.misses);
+    TEST_ASSERT_EQUAL(0, s.evictions);
+    TEST_ASSERT_EQUAL(3, s.entry_cnt);
+    TEST_ASSERT_EQUAL(3 * IMG_BYTES, s.bytes);
+}
+
+void test_img_cache_budget_evicts_least_recently_used(void)
+{
+    lv_img_cache_set_budget(2 * IMG_BYTES + IMG_BYTES / 2);
+
+    open_img(0);
+    open_img(1);
+    open_img(0);        /*1 is now the oldest*/
+    open_img(2);
+
+    lv_img_cache_stats_t s = stats();
+    TEST_ASSERT_EQUAL(1, s.evictions);
+    TEST_ASSERT_EQUAL(2, s.entry_cnt);
+    TEST_ASSERT_EQUAL(2 * IMG_BYTES, s.bytes);
+    TEST_ASSERT_EQUAL(1, close_cnt);
+
+    open_img(0);
+    open_img(2);
+    TEST_ASSERT_EQUAL(3, open_cnt);
+    open_img(1);
+    TEST_ASSERT_EQUAL(4, open_cnt);
+}
+
+void test_img_cache_keeps_image_larger_than_budget(void)
+{
+    lv_img_cache_set_budget(IMG_BYTES / 2);
+
+    /*The image being drawn stays open until the next one is opened*/
+    TEST_ASSERT_TRUE(open_img(0));
+    TEST_ASSERT_EQUAL(1, stats().entry_cnt);
+    TEST_ASSERT_TRUE(open_img(1));
+    TEST_ASSERT_EQUAL(1, stats().entry_cnt);
+    TEST_ASSERT_EQUAL(1, close_cnt);
+
+    /*Lowering the budget closes what no longer fits*/
+    lv_img_cache_set_budget(0);
+    TEST_ASSERT_EQUAL(0, stats().entry_cnt);
+    TEST_ASSERT_EQUAL(0, stats().bytes);
+}
+
+void test_img_cache_entry_limit(void)
+{
+    lv_img_cache_set_size(2);
+
+    open_img(0);
+    open_img(1);
+    open_img(2);
+    TEST_ASSERT_EQUAL(2, stats().entry_cnt);
+    TEST_ASSERT_EQUAL(1, stats().evictions);
+
+    open_img(2);
+    open_img(1);
+    TEST_ASSERT_EQUAL(3, open_cnt);
+}
+
+void test_img_cache_invalidate(void)
+{
+    open_img(0);
+    open_img(1);
+    _lv_img_cache_open(&imgs[0], lv_color_white(), 0);
+
+    lv_img_cache_invalidate_src(&imgs[0]);
+    lv_img_cache_stats_t s = stats();
+    TEST_ASSERT_EQUAL(1, s.entry_cnt);
+    TEST_ASSERT_EQUAL(IMG_BYTES, s.bytes);
+    TEST_ASSERT_EQUAL(0, s.evictions);
+    TEST_ASSERT_EQUAL(2, close_cnt);
+
+    open_img(1);
+    TEST_ASSERT_EQUAL(1, stats().hits);
+    open_img(0);
+    TEST_ASSERT_EQUAL(4, open_cnt);
+}
+
+void test_img_cache_c_array_costs_nothing(void)
+{
+    /*Drawn straight from the array by the built-in decoder, nothing to keep in the budget*/
+    static lv_color_t px[IMG_W * IMG_H];
+    static lv_img_dsc_t true_color;
+    true_color.header.cf = LV_IMG_CF_TRUE_COLOR;
+    true_color.header.w = IMG_W;
+    true_color.header.h = IMG_H;
+    true_color.data_size = sizeof(px);
+    true_color.data = (const uint8_t *)px;
+
+    TEST_ASSERT_NOT_NULL(_lv_img_cache_open(&true_color, lv_color_black(), 0));
+    TEST_ASSERT_EQUAL(1, stats().entry_cnt);
+    TEST_ASSERT_EQUAL(0, stats().bytes);
+}
+
+#else /*LV_IMG_CACHE_DEF_SIZE*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_img_cache_hit_decodes_once(void)
+{
+
+}
+
+void test_img_cache_budget_evicts_least_recently_used(void)
+{
+
+}
+
+void test_img_cache_keeps_image_larger_than_budget(void)
+{
+
+}
+
+void test_img_cache_entry_limit(void)
+{
+
+}
+
+void test_img_cache_invalidate(void)
+{
+
+}
+
+void test_img_cache_c_array_costs_nothing(void)
+{
+
+}
+
+#endif
+
+#endif
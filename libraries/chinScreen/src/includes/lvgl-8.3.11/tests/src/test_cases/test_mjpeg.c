@@ -0,0 +1,443 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_init.h"
+
+#if LV_USE_MJPEG
+
+#include <stdio.h>
+
+#define CLIP_FILE   "mjpeg_test.avi"
+#define CLIP_PATH   "A:" CLIP_FILE
+#define CLIP_W      64
+#define CLIP_H      48
+#define CLIP_FRAMES 90          /*About 40 kB, more than one read ahead*/
+#define CLIP_US     50000       /*20 fps*/
+
+static uint32_t ready_cnt;
+
+static void ready_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    ready_cnt++;
+}
+
+/*The picture of frame `i`: a color for the frame and a block that moves right*/
+static lv_color32_t frame_color(uint32_t i)
+{
+    lv_color32_t c;
+    c.ch.red = (i * 40) & 0xff;
+    c.ch.green = 255 - ((i * 40) & 0xff);
+    c.ch.blue = (i & 1) ? 200 : 40;
+    c.ch.alpha = 0xff;
+    return c;
+}
+
+static lv_coord_t block_x(uint32_t i)
+{
+    return (i % (CLIP_W / 8)) * 8;
+}
+
+/*
+ * A baseline JPEG of 8x8 blocks of flat color, so only the DC coefficients are coded.
+ * The DC categories are 4 bit codes, the only AC code is EOB, the 1 bit `0`.
+ */
+typedef struct {
+    uint8_t * p;
+    uint32_t acc;
+    uint32_t bits;
+} bit_writer_t;
+
+static void put_bits(bit_writer_t * w, uint32_t v, uint32_t n)
+{
+    while(n--) {
+        w->acc = (w->acc << 1) | ((v >> n) & 1);
+        if(++w->bits == 8) {
+            *w->p++ = w->acc;
+            if(w->acc == 0xff) *w->p++ = 0;
+            w->acc = 0;
+            w->bits = 0;
+        }
+    }
+}
+
+static void put_dc(bit_writer_t * w, int32_t diff)
+{
+    uint32_t mag = diff < 0 ? -diff : diff;
+    uint32_t cat = 0;
+    while(mag >> cat) cat++;
+    put_bits(w, cat, 4);
+    put_bits(w, diff < 0 ? (uint32_t)(diff + (1 << cat) - 1) : (uint32_t)diff, cat);
+    put_bits(w, 0, 1);  /*EOB*/
+}
+
+static uint32_t jpeg_encode(uint8_t * out, uint32_t i)
+{
+    static const uint8_t head[] = {
+        0xff, 0xd8,
+        /*All quantizers 8, so the DC coefficient is the block average - 128*/
+        0xff, 0xdb, 0x00, 0x43, 0x00,
+        8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+        8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+        0xff, 0xc0, 0x00, 0x11, 0x08, 0x00, CLIP_H, 0x00, CLIP_W, 0x03,
+        0x01, 0x11, 0x00, 0x02, 0x11, 0x00, 0x03, 0x11, 0x00,
+        /*Luma and chroma tables are the same, the decoder wants both*/
+        0xff, 0xc4, 0x00, 0x1f, 0x00, 0, 0, 0, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+        0xff, 0xc4, 0x00, 0x1f, 0x01, 0, 0, 0, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+        0xff, 0xc4, 0x00, 0x14, 0x10, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0x00,
+        0xff, 0xc4, 0x00, 0x14, 0x11, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0x00,
+        0xff, 0xda, 0x00, 0x0c, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3f, 0x00
+    };
+    lv_memcpy(out, head, sizeof(head));
+
+    bit_writer_t w = {out + sizeof(head), 0, 0};
+    int32_t pred[3] = {0, 0, 0};
+    lv_coord_t bx, by;
+    for(by = 0; by < CLIP_H; by += 8) {
+        for(bx = 0; bx < CLIP_W; bx += 8) {
+            lv_color32_t c = frame_color(i);
+            if(bx == block_x(i) && by == 8) c.full = 0xffffffff;
+            int32_t rgb[3] = {c.ch.red, c.ch.green, c.ch.blue};
+            int32_t ycc[3];
+            ycc[0] = (299 * rgb[0] + 587 * rgb[1] + 114 * rgb[2] + 500) / 1000 - 128;
+            ycc[1] = (-169 * rgb[0] - 331 * rgb[1] + 500 * rgb[2] + 128500) / 1000 - 128;
+            ycc[2] = (500 * rgb[0] - 419 * rgb[1] - 81 * rgb[2] + 128500) / 1000 - 128;
+            uint32_t k;
+            for(k = 0; k < 3; k++) {
+                put_dc(&w, ycc[k] - pred[k]);
+                pred[k] = ycc[k];
+            }
+        }
+    }
+    if(w.bits) put_bits(&w, 0x7f, 8 - w.bits);
+    *w.p++ = 0xff;
+    *w.p++ = 0xd9;
+    return w.p - out;
+}
+
+static void put_u32(FILE * f, uint32_t v)
+{
+    uint8_t b[4] = {v & 0xff, (v >> 8) & 0xff, (v >> 16) & 0xff, v >> 24};
+    fwrite(b, 1, 4, f);
+}
+
+static void put_chunk(FILE * f, const char * id, const void * data, uint32_t size)
+{
+    fwrite(id, 1, 4, f);
+    put_u32(f, size);
+    fwrite(data, 1, size, f);
+    if(size & 1) fputc(0, f);
+}
+
+/**
+ * Write an AVI like ffmpeg's: 'hdrl' with the main and the stream header, a 'JUNK' chunk, then
+ * 'movi' with the frames and an audio chunk that isn't played, then the 'idx1' index.
+ * The frame at `empty_at` is an empty chunk (repeat the previous one), the one at `bad_at` is
+ * cut short. -1: none
+ */
+static void write_clip(int32_t empty_at, int32_t bad_at)
+{
+    static uint8_t jpeg[4096];
+    FILE * f = fopen(CLIP_FILE, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+
+    fwrite("RIFF\0\0\0\0AVI ", 1, 12, f);
+
+    fwrite("LIST", 1, 4, f);
+    put_u32(f, 4 + 8 + 56 + 12 + 8 + 56);
+    fwrite("hdrl", 1, 4, f);
+    uint32_t avih[14] = {CLIP_US, 0, 0, 0x10, CLIP_FRAMES, 0, 1, 0, CLIP_W, CLIP_H};
+    put_chunk(f, "avih", avih, sizeof(avih));
+    fwrite("LIST", 1, 4, f);
+    put_u32(f, 4 + 8 + 56);
+    fwrite("strl", 1, 4, f);
+    uint32_t strh[14] = {0x73646976, 0x47504a4d, 0, 0, 0, 1, 20, 0, CLIP_FRAMES};
+    put_chunk(f, "strh", strh, sizeof(strh));
+
+    static const uint8_t junk[77];
+    put_chunk(f, "JUNK", junk, sizeof(junk));
+
+    long movi = ftell(f);
+    fwrite("LIST\0\0\0\0movi", 1, 12, f);
+    int32_t i;
+    for(i = 0; i < CLIP_FRAMES; i++) {
+        uint32_t size = jpeg_encode(jpeg, i);
+        if(i == bad_at) size /= 2;
+        if(i == empty_at) size = 0;
+        put_chunk(f, "00dc", jpeg, size);
+        if(i == 3) put_chunk(f, "01wb", junk, 33);
+    }
+    long movi_end = ftell(f);
+    put_chunk(f, "idx1", junk, 16);
+
+    long end = ftell(f);
+    fseek(f, 4, SEEK_SET);
+    put_u32(f, end - 8);
+    fseek(f, movi + 4, SEEK_SET);
+    put_u32(f, movi_end - movi - 8);
+    fclose(f);
+}
+
+/*The test display copies only the refreshed area into test_fb, so always refresh all of it*/
+static void refresh(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+static void assert_px_near(lv_color32_t e, lv_coord_t x, lv_coord_t y)
+{
+    lv_color32_t a;
+    a.full = lv_color_to32(test_fb[y * TEST_HOR_RES + x]);
+    /*JPEG rounding and one step of the lowest color depth the tests run with*/
+    TEST_ASSERT_INT_WITHIN(12, e.ch.red, a.ch.red);
+    TEST_ASSERT_INT_WITHIN(12, e.ch.green, a.ch.green);
+    TEST_ASSERT_INT_WITHIN(12, e.ch.blue, a.ch.blue);
+}
+
+static void assert_frame_shown(uint32_t i)
+{
+    refresh();
+    lv_color32_t white;
+    white.full = 0xffffffff;
+    assert_px_near(frame_color(i), CLIP_W / 2 + 4, CLIP_H - 4);
+    assert_px_near(white, block_x(i) + 4, 12);
+}
+
+static lv_obj_t * player_create(void)
+{
+    lv_obj_t * obj = lv_mjpeg_player_create(lv_scr_act());
+    lv_obj_set_pos(obj, 0, 0);
+    lv_obj_add_event_cb(obj, ready_cb, LV_EVENT_READY, NULL);
+    return obj;
+}
+
+/*Let the clock run to frame `i` and the timer see it*/
+static void play_to(lv_obj_t * obj, uint32_t i)
+{
+    lv_mjpeg_player_t * player = (lv_mjpeg_player_t *)obj;
+    player->start_tick = lv_tick_get() - (i * CLIP_US + CLIP_US / 2) / 1000;
+    player->timer->timer_cb(player->timer);
+}
+
+static lv_mjpeg_player_stats_t stats(lv_obj_t * obj)
+{
+    lv_mjpeg_player_stats_t s;
+    lv_mjpeg_player_get_stats(obj, &s);
+    return s;
+}
+
+void setUp(void)
+{
+    ready_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    remove(CLIP_FILE);
+}
+
+void test_mjpeg_plays_generated_clip(void)
+{
+    write_clip(-1, -1);
+    lv_obj_t * obj = player_create();
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_mjpeg_player_set_src(obj, CLIP_PATH));
+    lv_obj_update_layout(obj);
+    TEST_ASSERT_EQUAL(CLIP_W, lv_obj_get_width(obj));
+    TEST_ASSERT_EQUAL(CLIP_H, lv_obj_get_height(obj));
+    TEST_ASSERT_EQUAL(20, lv_mjpeg_player_get_fps(obj));
+    TEST_ASSERT_FALSE(lv_mjpeg_player_is_playing(obj));
+    assert_frame_shown(0);
+
+    lv_mjpeg_player_set_cmd(obj, LV_MJPEG_PLAYER_CMD_START);
+    TEST_ASSERT_TRUE(lv_mjpeg_player_is_playing(obj));
+
+    /*Every frame in turn, through the read ahead refills and the audio chunk*/
+    uint32_t i;
+    for(i = 1; i < CLIP_FRAMES; i++) {
+        play_to(obj, i);
+        assert_frame_shown(i);
+    }
+
+    lv_mjpeg_player_stats_t s = stats(obj);
+    TEST_ASSERT_EQUAL(CLIP_FRAMES + 1, s.frames_shown);     /*Frame 0 again at the start*/
+    TEST_ASSERT_EQUAL(0, s.frames_dropped);
+    TEST_ASSERT_EQUAL(0, s.frames_bad);
+    TEST_ASSERT_GREATER_THAN(32 * 1024, s.bytes_read);
+
+    /*Not due yet*/
+    lv_mjpeg_player_t * player = (lv_mjpeg_player_t *)obj;
+    player->timer->timer_cb(player->timer);
+    TEST_ASSERT_EQUAL(CLIP_FRAMES + 1, stats(obj).frames_shown);
+
+    /*The end*/
+    play_to(obj, CLIP_FRAMES);
+    TEST_ASSERT_EQUAL(1, ready_cnt);
+    TEST_ASSERT_FALSE(lv_mjpeg_player_is_playing(obj));
+    assert_frame_shown(CLIP_FRAMES - 1);
+}
+
+void test_mjpeg_drops_late_frames(void)
+{
+    write_clip(-1, -1);
+    lv_obj_t * obj = player_create();
+    lv_mjpeg_player_set_src(obj, CLIP_PATH);
+    lv_mjpeg_player_set_cmd(obj, LV_MJPEG_PLAYER_CMD_START);
+    lv_mjpeg_player_reset_stats(obj);
+
+    play_to(obj, 1);
+    play_to(obj, 6);
+    assert_frame_shown(6);
+    lv_mjpeg_player_stats_t s = stats(obj);
+    TEST_ASSERT_EQUAL(2, s.frames_shown);
+    TEST_ASSERT_EQUAL(4, s.frames_dropped);
+
+    /*Far behind: everything but the frame due is skipped*/
+    play_to(obj, 80);
+    assert_frame_shown(80);
+    TEST_ASSERT_EQUAL(3, stats(obj).frames_shown);
+    TEST_ASSERT_EQUAL(4 + 73, stats(obj).frames_dropped);
+}
+
+void test_mjpeg_pause_resume_and_fps(void)
+{
+    write_clip(-1, -1);
+    lv_obj_t * obj = player_create();
+    lv_mjpeg_player_t * player = (lv_mjpeg_player_t *)obj;
+    lv_mjpeg_player_set_src(obj, CLIP_PATH);
+
+    /*Resume without a pause starts*/
+    lv_mjpeg_player_set_cmd(obj, LV_MJPEG_PLAYER_CMD_RESUME);
+    TEST_ASSERT_TRUE(lv_mjpeg_player_is_playing(obj));
+    play_to(obj, 1);
+    play_to(obj, 2);
+
+    /*A long pause doesn't make the frames after it late*/
+    lv_mjpeg_player_set_cmd(obj, LV_MJPEG_PLAYER_CMD_PAUSE);
+    TEST_ASSERT_FALSE(lv_mjpeg_player_is_playing(obj));
+    player->start_tick -= 10000;
+    player->paused_tick -= 10000;
+    lv_mjpeg_player_set_cmd(obj, LV_MJPEG_PLAYER_CMD_RESUME);
+    player->timer->timer_cb(player->timer);
+    assert_frame_shown(2);
+    TEST_ASSERT_EQUAL(0, stats(obj).frames_dropped);
+
+    /*Twice the rate from here*/
+    lv_mjpeg_player_set_fps(obj, 40);
+    TEST_ASSERT_EQUAL(40, lv_mjpeg_player_get_fps(obj));
+    TEST_ASSERT_EQUAL(25, player->timer->period);
+    player->start_tick -= 26;
+    player->timer->timer_cb(player->timer);
+    assert_frame_shown(3);
+
+    /*Stop goes back to the start, keeping the picture*/
+    lv_mjpeg_player_set_cmd(obj, LV_MJPEG_PLAYER_CMD_STOP);
+    TEST_ASSERT_FALSE(lv_mjpeg_player_is_playing(obj));
+    assert_frame_shown(3);
+    lv_mjpeg_player_set_cmd(obj, LV_MJPEG_PLAYER_CMD_START);
+    assert_frame_shown(0);
+}
+
+void test_mjpeg_auto_restart(void)
+{
+    write_clip(-1, -1);
+    lv_obj_t * obj = player_create();
+    lv_mjpeg_player_set_src(obj, CLIP_PATH);
+    lv_mjpeg_player_set_auto_restart(obj, true);
+    lv_mjpeg_player_set_cmd(obj, LV_MJPEG_PLAYER_CMD_START);
+
+    play_to(obj, CLIP_FRAMES - 1);
+    play_to(obj, CLIP_FRAMES);
+    TEST_ASSERT_EQUAL(0, ready_cnt);
+    TEST_ASSERT_TRUE(lv_mjpeg_player_is_playing(obj));
+    assert_frame_shown(0);
+    play_to(obj, 1);
+    assert_frame_shown(1);
+}
+
+void test_mjpeg_empty_and_bad_frames_keep_the_picture(void)
+{
+    write_clip(2, 4);
+    lv_obj_t * obj = player_create();
+    lv_mjpeg_player_set_src(obj, CLIP_PATH);
+    lv_mjpeg_player_set_cmd(obj, LV_MJPEG_PLAYER_CMD_START);
+
+    play_to(obj, 1);
+    play_to(obj, 2);
+    assert_frame_shown(1);
+    play_to(obj, 3);
+    play_to(obj, 4);
+    assert_frame_shown(3);
+    play_to(obj, 5);
+    assert_frame_shown(5);
+
+    lv_mjpeg_player_stats_t s = stats(obj);
+    TEST_ASSERT_EQUAL(1, s.frames_bad);
+    TEST_ASSERT_EQUAL(6, s.frames_shown);     /*Frame 0 twice, the empty one counts*/
+}
+
+void test_mjpeg_rejects_other_files(void)
+{
+    lv_obj_t * obj = player_create();
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_mjpeg_player_set_src(obj, "A:no_such_clip.avi"));
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_mjpeg_player_set_src(obj, "A:../../icons/ani/wifi-1.gif"));
+    lv_mjpeg_player_set_cmd(obj, LV_MJPEG_PLAYER_CMD_START);
+    TEST_ASSERT_FALSE(lv_mjpeg_player_is_playing(obj));
+
+    /*An AVI whose first frame isn't a JPEG*/
+    write_clip(-1, 0);
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_mjpeg_player_set_src(obj, CLIP_PATH));
+    refresh();
+}
+
+#else /*LV_USE_MJPEG*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_mjpeg_plays_generated_clip(void)
+{
+
+}
+
+void test_mjpeg_drops_late_frames(void)
+{
+
+}
+
+void test_mjpeg_pause_resume_and_fps(void)
+{
+
+}
+
+void test_mjpeg_auto_restart(void)
+{
+
+}
+
+void test_mjpeg_empty_and_bad_frames_keep_the_picture(void)
+{
+
+}
+
+void test_mjpeg_rejects_other_files(void)
+{
+
+}
+
+#endif
+
+#endif
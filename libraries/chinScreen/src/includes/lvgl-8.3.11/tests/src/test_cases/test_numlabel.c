@@ -0,0 +1,273 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_init.h"
+#include "lv_test_helpers.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*The labels use the big fonts of the test config*/
+#if LV_FONT_MONTSERRAT_24 && LV_FONT_MONTSERRAT_48
+
+/*What the display shows: the areas are flushed to their place, not to the start like test_fb*/
+static lv_color_t screen[TEST_HOR_RES * TEST_VER_RES];
+static void (*test_flush_cb)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *);
+
+static void screen_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        memcpy(&screen[y * TEST_HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+    lv_disp_flush_ready(disp_drv);
+}
+
+static uint32_t invalidated_px(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    uint32_t px = 0;
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) px += lv_area_get_size(&disp->inv_areas[i]);
+    return px;
+}
+
+static lv_obj_t * numlabel_create(const char * fmt, const lv_font_t * font)
+{
+    lv_obj_t * obj = lv_numlabel_create(lv_scr_act());
+    lv_obj_set_style_text_font(obj, font, 0);
+    lv_numlabel_set_format(obj, fmt);
+    lv_obj_set_pos(obj, 20, 20);
+    return obj;
+}
+
+void setUp(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    test_flush_cb = disp->driver->flush_cb;
+    disp->driver->flush_cb = screen_flush_cb;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+void tearDown(void)
+{
+    lv_disp_get_default()->driver->flush_cb = test_flush_cb;
+    lv_obj_clean(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+void test_numlabel_prints_like_printf(void)
+{
+    static const char * const int_fmts[] = {
+        "%d", "%5d", "%-5d|", "%+d", "% d", "%05d", "%.3d", "%8.3d", "%x", "%08X", "%u", "%i%%"
+    };
+    static const int32_t ints[] = {0, 1, -1, 42, -42, 12345, -99999, INT32_MAX, INT32_MIN};
+    static const char * const float_fmts[] = {
+        "%f", "%.1f", "%5.1f", "%+07.2f", "%-8.3f|", "% .2f", "%.0f", "%.9f", "%010.4f"
+    };
+    static const float floats[] = {0.0f, 0.05f, -0.05f, 1.25f, 2.5f, 3.5f, 99.95f, -123.456f, 1e6f, 16777216.0f};
+
+    lv_obj_t * obj = lv_numlabel_create(lv_scr_act());
+    char expected[64];
+    uint32_t f;
+    uint32_t v;
+    for(f = 0; f < sizeof(int_fmts) / sizeof(int_fmts[0]); f++) {
+        lv_numlabel_set_format(obj, int_fmts[f]);
+        for(v = 0; v < sizeof(ints) / sizeof(ints[0]); v++) {
+            lv_numlabel_set_value(obj, ints[v]);
+            snprintf(expected, sizeof(expected), int_fmts[f], (int)ints[v]);
+            TEST_ASSERT_EQUAL_STRING(expected, lv_numlabel_get_text(obj));
+        }
+    }
+
+    for(f = 0; f < sizeof(float_fmts) / sizeof(float_fmts[0]); f++) {
+        lv_numlabel_set_format(obj, float_fmts[f]);
+        for(v = 0; v < sizeof(floats) / sizeof(floats[0]); v++) {
+            lv_numlabel_set_value_float(obj, floats[v]);
+            snprintf(expected, sizeof(expected), float_fmts[f], (double)floats[v]);
+            TEST_ASSERT_EQUAL_STRING(expected, lv_numlabel_get_text(obj));
+        }
+    }
+
+    /*Floats are rounded for the integer conversions, integers get the digits after the point*/
+    lv_numlabel_set_format(obj, "Temp: %5.1f\xC2\xB0" "C");
+    lv_numlabel_set_value(obj, -7);
+    TEST_ASSERT_EQUAL_STRING("Temp:  -7.0\xC2\xB0" "C", lv_numlabel_get_text(obj));
+    lv_numlabel_set_format(obj, "%d rpm");
+    lv_numlabel_set_value_float(obj, -2.5f);
+    TEST_ASSERT_EQUAL_STRING("-3 rpm", lv_numlabel_get_text(obj));
+    lv_numlabel_set_value_float(obj, 1e20f);
+    TEST_ASSERT_EQUAL_STRING("2147483647 rpm", lv_numlabel_get_text(obj));
+    lv_numlabel_set_format(obj, "%ld");
+    lv_numlabel_set_value(obj, -12);
+    TEST_ASSERT_EQUAL_STRING("-12", lv_numlabel_get_text(obj));
+}
+
+void test_numlabel_bad_format_shows_no_number(void)
+{
+    lv_obj_t * obj = lv_numlabel_create(lv_scr_act());
+    lv_numlabel_set_format(obj, "%d and %d");
+    TEST_ASSERT_EQUAL_STRING("", lv_numlabel_get_text(obj));
+    lv_numlabel_set_format(obj, "%s");
+    TEST_ASSERT_EQUAL_STRING("", lv_numlabel_get_text(obj));
+    lv_numlabel_set_value(obj, 5);
+    TEST_ASSERT_EQUAL_STRING("", lv_numlabel_get_text(obj));
+
+    lv_numlabel_set_format(obj, "100%%");
+    lv_numlabel_set_value(obj, 5);
+    TEST_ASSERT_EQUAL_STRING("100%", lv_numlabel_get_text(obj));
+}
+
+void test_numlabel_width_is_reserved_by_the_format(void)
+{
+    lv_obj_t * obj = numlabel_create("Temp: %5.1f\xC2\xB0" "C", &lv_font_montserrat_24);
+    lv_numlabel_set_value_float(obj, 1.0f);
+    lv_obj_update_layout(obj);
+    const lv_coord_t w = lv_obj_get_width(obj);
+    TEST_ASSERT_GREATER_THAN(0, w);
+
+    lv_numlabel_set_value_float(obj, 99.9f);
+    lv_obj_update_layout(obj);
+    TEST_ASSERT_EQUAL(w, lv_obj_get_width(obj));
+    lv_numlabel_set_value_float(obj, -11.1f);
+    lv_obj_update_layout(obj);
+    TEST_ASSERT_EQUAL(w, lv_obj_get_width(obj));
+
+    /*Longer than the width of the format*/
+    lv_numlabel_set_value_float(obj, 1234.5f);
+    lv_obj_update_layout(obj);
+    TEST_ASSERT_GREATER_THAN(w, lv_obj_get_width(obj));
+    lv_numlabel_set_value_float(obj, 1.0f);
+    lv_obj_update_layout(obj);
+    TEST_ASSERT_EQUAL(w, lv_obj_get_width(obj));
+}
+
+void test_numlabel_invalidates_changed_digits_only(void)
+{
+    lv_obj_t * obj = numlabel_create("Temp: %5.1f\xC2\xB0" "C", &lv_font_montserrat_24);
+    lv_numlabel_set_value_float(obj, 23.4f);
+    lv_refr_now(NULL);
+
+    lv_obj_invalidate(obj);
+    const uint32_t full = invalidated_px();
+    lv_refr_now(NULL);
+
+    /*The same value redraws nothing*/
+    lv_numlabel_set_value_float(obj, 23.4f);
+    TEST_ASSERT_EQUAL_UINT32(0, invalidated_px());
+
+    /*One digit is one cell*/
+    lv_numlabel_set_value_float(obj, 23.5f);
+    lv_disp_t * disp = lv_disp_get_default();
+    TEST_ASSERT_EQUAL_UINT32(1, disp->inv_p);
+    const uint32_t one = invalidated_px();
+    TEST_ASSERT_LESS_THAN_UINT32(full / 5, one);
+    lv_refr_now(NULL);
+
+    /*Two digits far from each other*/
+    lv_numlabel_set_value_float(obj, 33.6f);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(2 * one, invalidated_px());
+    lv_refr_now(NULL);
+
+    /*A new length lays the label out again*/
+    lv_numlabel_set_value_float(obj, 1234.6f);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(full, invalidated_px());
+    lv_refr_now(NULL);
+}
+
+void test_numlabel_updates_draw_like_a_new_label(void)
+{
+    static const char * const fmts[] = {"Temp: %5.1f\xC2\xB0" "C", "%-6d|", "RPM %+05d"};
+    static const float values[] = {0.0f, 8.8f, 17.1f, -1.5f, 100.25f, 7.0f, 1234.5f, 42.2f};
+    const lv_font_t * fonts[] = {&lv_font_montserrat_14, &lv_font_montserrat_48, &lv_font_unscii_8};
+    lv_color_t * ref_fb = malloc(TEST_FB_SIZE);
+    TEST_ASSERT_NOT_NULL(ref_fb);
+
+    uint32_t f;
+    for(f = 0; f < 3; f++) {
+        lv_obj_t * obj = numlabel_create(fmts[f], fonts[f]);
+        lv_obj_set_style_text_align(obj, (lv_text_align_t)(LV_TEXT_ALIGN_LEFT + f), 0);
+        lv_obj_set_width(obj, 400);
+        uint32_t v;
+        for(v = 0; v < sizeof(values) / sizeof(values[0]); v++) {
+            lv_numlabel_set_value_float(obj, values[v]);
+            lv_refr_now(NULL);
+        }
+        memcpy(ref_fb, screen, TEST_FB_SIZE);
+        lv_obj_del(obj);
+
+        obj = numlabel_create(fmts[f], fonts[f]);
+        lv_obj_set_style_text_align(obj, (lv_text_align_t)(LV_TEXT_ALIGN_LEFT + f), 0);
+        lv_obj_set_width(obj, 400);
+        lv_numlabel_set_value_float(obj, values[sizeof(values) / sizeof(values[0]) - 1]);
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+        TEST_ASSERT_EQUAL_MEMORY(ref_fb, screen, TEST_FB_SIZE);
+        lv_obj_del(obj);
+    }
+    free(ref_fb);
+}
+
+void test_numlabel_updates_dont_allocate(void)
+{
+    lv_obj_t * obj = numlabel_create("Temp: %5.1f\xC2\xB0" "C", &lv_font_montserrat_24);
+    lv_refr_now(NULL);
+    const uint32_t free_mem = lv_test_get_free_mem();
+
+    uint32_t i;
+    for(i = 0; i < 200; i++) {
+        lv_numlabel_set_value_float(obj, (float)i * 7.3f - 500.0f);
+    }
+    LV_HEAP_CHECK(TEST_ASSERT_EQUAL_UINT32(free_mem, lv_test_get_free_mem()));
+}
+
+#else /*LV_FONT_MONTSERRAT_24 && LV_FONT_MONTSERRAT_48*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_numlabel_prints_like_printf(void)
+{
+
+}
+
+void test_numlabel_bad_format_shows_no_number(void)
+{
+
+}
+
+void test_numlabel_width_is_reserved_by_the_format(void)
+{
+
+}
+
+void test_numlabel_invalidates_changed_digits_only(void)
+{
+
+}
+
+void test_numlabel_updates_draw_like_a_new_label(void)
+{
+
+}
+
+void test_numlabel_updates_dont_allocate(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,134 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_port_area.h"
+#include "lv_port_sim.h"
+
+/* Same geometry as the chinScreen panel: 320x480, 1/10 screen draw and transport buffers */
+#define PANEL_HOR_RES   320
+#define PANEL_VER_RES   480
+#define PANEL_BUF_SIZE  (PANEL_HOR_RES * PANEL_VER_RES / 10)
+#define PANEL_BPP       2   /*RGB565 on the bus, whatever LV_COLOR_DEPTH the test runs with*/
+
+/* Rough ESP32-S3 costs: rendering a widget heavy area and copying into the DMA transport buffer */
+#define RENDER_NS_PER_PX 60
+#define COPY_NS_PER_PX   8
+#define CHUNK_OVERHEAD_NS 20000
+
+#define MAX_AREAS 64
+
+static lv_color_t buf_1[PANEL_BUF_SIZE];
+static lv_color_t buf_2[PANEL_BUF_SIZE];
+
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+static uint32_t area_px[MAX_AREAS];
+static uint32_t area_cnt;
+
+static void recording_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(color_p);
+    if(area_cnt < MAX_AREAS) area_px[area_cnt++] = lv_area_get_size(area);
+    lv_disp_flush_ready(drv);
+}
+
+static void port_rounder_cb(lv_disp_drv_t * drv, lv_area_t * area)
+{
+    lvgl_port_area_round(area, drv->hor_res, drv->ver_res, LV_DISP_ROT_NONE);
+}
+
+/**
+ * Record the areas LVGL flushes while redrawing a full screen of widgets
+ */
+static void record_full_screen_areas(void)
+{
+    lv_disp_t * prev_default = lv_disp_get_default();
+
+    lv_disp_draw_buf_init(&draw_buf, buf_1, buf_2, PANEL_BUF_SIZE);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.flush_cb = recording_flush_cb;
+    disp_drv.hor_res = PANEL_HOR_RES;
+    disp_drv.ver_res = PANEL_VER_RES;
+    disp_drv.rounder_cb = port_rounder_cb;
+    lv_disp_t * disp = lv_disp_drv_register(&disp_drv);
+
+    lv_obj_t * scr = lv_disp_get_scr_act(disp);
+    uint32_t i;
+    for(i = 0; i < 8; i++) {
+        lv_obj_t * bar = lv_bar_create(scr);
+        lv_obj_set_size(bar, 280, 20);
+        lv_obj_set_pos(bar, 20, i * 58 + 10);
+        lv_bar_set_value(bar, i * 12, LV_ANIM_OFF);
+    }
+
+    area_cnt = 0;
+    lv_obj_invalidate(scr);
+    lv_refr_now(disp);
+
+    lv_disp_remove(disp);
+    disp_drv.draw_ctx_deinit(&disp_drv, disp_drv.draw_ctx);
+    lv_mem_free(disp_drv.draw_ctx);
+    lv_disp_set_default(prev_default);
+}
+
+static uint64_t simulate_frame_ns(uint32_t bus_bytes_per_sec, bool async_flush)
+{
+    lvgl_port_sim_cfg_t cfg = {
+        .bus_bytes_per_sec = bus_bytes_per_sec,
+        .bytes_per_pixel = PANEL_BPP,
+        .trans_size = PANEL_BUF_SIZE,
+        .copy_ns_per_px = COPY_NS_PER_PX,
+        .chunk_overhead_ns = CHUNK_OVERHEAD_NS,
+        .async_flush = async_flush,
+    };
+    lvgl_port_sim_t sim;
+    lvgl_port_sim_init(&sim, &cfg);
+
+    uint32_t i;
+    for(i = 0; i < area_cnt; i++) {
+        lvgl_port_sim_area(&sim, area_px[i], (uint64_t)area_px[i] * RENDER_NS_PER_PX);
+    }
+
+    TEST_ASSERT_EQUAL(PANEL_HOR_RES * PANEL_VER_RES * PANEL_BPP, sim.bytes);
+    return lvgl_port_sim_frame_ns(&sim);
+}
+
+void test_port_flush_pipeline_async_overlaps_render_and_transfer(void)
+{
+    record_full_screen_areas();
+    TEST_ASSERT_EQUAL(10, area_cnt);
+
+    /* 80 MHz QSPI, 40 MHz QSPI (the default), 20 MHz QSPI and a slow 40 MHz SPI */
+    static const uint32_t bandwidths[] = {40000000, 20000000, 10000000, 5000000};
+    uint32_t i;
+    printf("full screen redraw, %"LV_PRIu32" areas:\n", area_cnt);
+    for(i = 0; i < sizeof(bandwidths) / sizeof(bandwidths[0]); i++) {
+        uint64_t sync_ns = simulate_frame_ns(bandwidths[i], false);
+        uint64_t async_ns = simulate_frame_ns(bandwidths[i], true);
+        printf("  %2"LV_PRIu32" MB/s: sync %6"LV_PRIu32" us, async %6"LV_PRIu32" us\n",
+               bandwidths[i] / 1000000, (uint32_t)(sync_ns / 1000), (uint32_t)(async_ns / 1000));
+
+        TEST_ASSERT_LESS_OR_EQUAL(sync_ns, async_ns);
+    }
+
+    /* Rendering is the bottleneck at 80 MHz: the copy moves off the LVGL task */
+    TEST_ASSERT_LESS_THAN(simulate_frame_ns(40000000, false), simulate_frame_ns(40000000, true));
+}
+
+void test_port_flush_pipeline_async_is_bound_by_the_bus(void)
+{
+    record_full_screen_areas();
+
+    /* When the bus is the bottleneck only the first area's render and copy are not hidden behind it */
+    uint32_t bw = 5000000;
+    uint64_t px = (uint64_t)PANEL_HOR_RES * PANEL_VER_RES;
+    uint64_t bus_ns = px * PANEL_BPP * 1000000000ULL / bw + (uint64_t)area_cnt * CHUNK_OVERHEAD_NS;
+    uint64_t expected_ns = (uint64_t)area_px[0] * (RENDER_NS_PER_PX + COPY_NS_PER_PX) + bus_ns;
+    uint64_t async_ns = simulate_frame_ns(bw, true);
+
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(expected_ns / 1000), (uint32_t)(async_ns / 1000));
+}
+
+#endif
@@ -0,0 +1,165 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_port_area.h"
+#include "lv_port_mem.h"
+
+#define PANEL_HOR_RES   320
+#define PANEL_VER_RES   480
+#define SCREEN_PX       (PANEL_HOR_RES * PANEL_VER_RES)
+
+static lv_color_t buf_1[SCREEN_PX / 10];
+static lv_color_t buf_2[SCREEN_PX / 10];
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+static uint32_t max_flush_px;
+static uint32_t flush_cnt;
+
+static lvgl_port_mem_cfg_t rgb565_cfg(uint32_t buffer_size, bool double_buffer, uint32_t trans_size)
+{
+    lvgl_port_mem_cfg_t cfg = {
+        .hres = PANEL_HOR_RES,
+        .vres = PANEL_VER_RES,
+        .bytes_per_pixel = 2,
+        .buffer_size = buffer_size,
+        .double_buffer = double_buffer,
+        .buff_caps = LVGL_PORT_MEM_PSRAM,
+        .trans_size = trans_size,
+        .sw_rotate = LV_DISP_ROT_NONE,
+    };
+    return cfg;
+}
+
+void test_port_mem_plan_default_partial_refresh(void)
+{
+    /* init_display(): two 1/10 screen buffers in PSRAM, two 1/10 screen transport buffers */
+    lvgl_port_mem_cfg_t cfg = rgb565_cfg(SCREEN_PX / 10, true, SCREEN_PX / 10);
+    lvgl_port_mem_plan_t plan;
+
+    TEST_ASSERT_TRUE(lvgl_port_mem_plan(&cfg, &plan));
+    TEST_ASSERT_NULL(plan.error);
+    TEST_ASSERT_EQUAL(61440, plan.draw_bytes);
+    TEST_ASSERT_EQUAL(61440, plan.trans_bytes);
+    TEST_ASSERT_EQUAL(61440, plan.internal_bytes);
+    TEST_ASSERT_EQUAL(61440, plan.dma_bytes);
+    TEST_ASSERT_EQUAL(61440, plan.psram_bytes);
+    TEST_ASSERT_EQUAL(48 * PANEL_HOR_RES * 2, plan.bytes_per_flush);
+    TEST_ASSERT_EQUAL(10, plan.flushes_per_frame);
+    TEST_ASSERT_EQUAL(1, plan.chunks_per_flush);
+}
+
+void test_port_mem_plan_full_refresh(void)
+{
+    lvgl_port_mem_cfg_t cfg = rgb565_cfg(SCREEN_PX, false, SCREEN_PX / 10);
+    cfg.full_refresh = true;
+    lvgl_port_mem_plan_t plan;
+
+    TEST_ASSERT_TRUE(lvgl_port_mem_plan(&cfg, &plan));
+    TEST_ASSERT_EQUAL(SCREEN_PX * 2, plan.psram_bytes);
+    TEST_ASSERT_EQUAL(SCREEN_PX * 2, plan.bytes_per_flush);
+    TEST_ASSERT_EQUAL(1, plan.flushes_per_frame);
+    TEST_ASSERT_EQUAL(10, plan.chunks_per_flush);
+}
+
+void test_port_mem_plan_trades_internal_ram_for_transfers(void)
+{
+    /* Draw buffers in internal RAM, small transport chunks: less DMA RAM, more transfers */
+    lvgl_port_mem_cfg_t cfg = rgb565_cfg(PANEL_HOR_RES * 40, true, PANEL_HOR_RES * 10);
+    cfg.buff_caps = LVGL_PORT_MEM_INTERNAL;
+    lvgl_port_mem_plan_t plan;
+
+    TEST_ASSERT_TRUE(lvgl_port_mem_plan(&cfg, &plan));
+    TEST_ASSERT_EQUAL(2 * 12800 * 2 + 2 * 3200 * 2, plan.internal_bytes);
+    TEST_ASSERT_EQUAL(2 * 3200 * 2, plan.dma_bytes);
+    TEST_ASSERT_EQUAL(0, plan.psram_bytes);
+    TEST_ASSERT_EQUAL(40 * PANEL_HOR_RES * 2, plan.bytes_per_flush);
+    TEST_ASSERT_EQUAL(12, plan.flushes_per_frame);
+    TEST_ASSERT_EQUAL(4, plan.chunks_per_flush);
+
+    /* A transport chunk that is not a whole number of rows is only partly used */
+    cfg.trans_size = PANEL_HOR_RES * 10 + 100;
+    TEST_ASSERT_TRUE(lvgl_port_mem_plan(&cfg, &plan));
+    TEST_ASSERT_EQUAL(4, plan.chunks_per_flush);
+}
+
+void test_port_mem_plan_rejects_unusable_configs(void)
+{
+    lvgl_port_mem_plan_t plan;
+    lvgl_port_mem_cfg_t cfg;
+
+    cfg = rgb565_cfg(SCREEN_PX / 10, false, SCREEN_PX / 10);
+    cfg.full_refresh = true;
+    TEST_ASSERT_FALSE(lvgl_port_mem_plan(&cfg, &plan));
+    TEST_ASSERT_NOT_NULL(plan.error);
+
+    /* Rotated partial refresh renders full height columns, see lvgl_port_area_round() */
+    cfg = rgb565_cfg(SCREEN_PX / 10, true, SCREEN_PX / 10);
+    cfg.sw_rotate = LV_DISP_ROT_90;
+    TEST_ASSERT_FALSE(lvgl_port_mem_plan(&cfg, &plan));
+    cfg.buffer_size = SCREEN_PX;
+    TEST_ASSERT_TRUE(lvgl_port_mem_plan(&cfg, &plan));
+
+    cfg = rgb565_cfg(PANEL_HOR_RES - 1, false, SCREEN_PX / 10);
+    TEST_ASSERT_FALSE(lvgl_port_mem_plan(&cfg, &plan));
+
+    cfg = rgb565_cfg(SCREEN_PX / 10, true, PANEL_HOR_RES - 1);
+    TEST_ASSERT_FALSE(lvgl_port_mem_plan(&cfg, &plan));
+
+    /* Without transport buffers nothing rotates the pixels and the bus needs DMA memory */
+    cfg = rgb565_cfg(SCREEN_PX / 10, true, 0);
+    TEST_ASSERT_FALSE(lvgl_port_mem_plan(&cfg, &plan));
+    cfg.buff_caps = LVGL_PORT_MEM_DMA;
+    TEST_ASSERT_TRUE(lvgl_port_mem_plan(&cfg, &plan));
+    TEST_ASSERT_EQUAL(0, plan.trans_bytes);
+    TEST_ASSERT_EQUAL(plan.draw_bytes, plan.dma_bytes);
+    cfg.sw_rotate = LV_DISP_ROT_180;
+    TEST_ASSERT_FALSE(lvgl_port_mem_plan(&cfg, &plan));
+}
+
+static void measuring_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(color_p);
+    uint32_t px = lv_area_get_size(area);
+    if(px > max_flush_px) max_flush_px = px;
+    flush_cnt++;
+    lv_disp_flush_ready(drv);
+}
+
+static void port_rounder_cb(lv_disp_drv_t * drv, lv_area_t * area)
+{
+    lvgl_port_area_round(area, drv->hor_res, drv->ver_res, LV_DISP_ROT_NONE);
+}
+
+void test_port_mem_plan_matches_lvgl(void)
+{
+    lvgl_port_mem_cfg_t cfg = rgb565_cfg(SCREEN_PX / 10, true, SCREEN_PX / 10);
+    cfg.bytes_per_pixel = sizeof(lv_color_t);
+    lvgl_port_mem_plan_t plan;
+    TEST_ASSERT_TRUE(lvgl_port_mem_plan(&cfg, &plan));
+
+    lv_disp_t * prev_default = lv_disp_get_default();
+    lv_disp_draw_buf_init(&draw_buf, buf_1, buf_2, SCREEN_PX / 10);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.flush_cb = measuring_flush_cb;
+    disp_drv.hor_res = PANEL_HOR_RES;
+    disp_drv.ver_res = PANEL_VER_RES;
+    disp_drv.rounder_cb = port_rounder_cb;
+    lv_disp_t * disp = lv_disp_drv_register(&disp_drv);
+
+    max_flush_px = 0;
+    flush_cnt = 0;
+    lv_obj_invalidate(lv_disp_get_scr_act(disp));
+    lv_refr_now(disp);
+
+    lv_disp_remove(disp);
+    disp_drv.draw_ctx_deinit(&disp_drv, disp_drv.draw_ctx);
+    lv_mem_free(disp_drv.draw_ctx);
+    lv_disp_set_default(prev_default);
+
+    TEST_ASSERT_EQUAL(plan.bytes_per_flush, max_flush_px * sizeof(lv_color_t));
+    TEST_ASSERT_EQUAL(plan.flushes_per_frame, flush_cnt);
+}
+
+#endif
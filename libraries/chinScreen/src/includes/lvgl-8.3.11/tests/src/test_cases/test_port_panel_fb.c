@@ -0,0 +1,145 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_port_fb.h"
+#include "lv_port_ramwr.h"
+
+#define PANEL_HOR_RES   320
+#define PANEL_VER_RES   480
+#define CHUNK_ROWS      48
+
+static uint16_t panel_px[PANEL_HOR_RES * PANEL_VER_RES];
+static uint16_t expected_px[PANEL_HOR_RES * PANEL_VER_RES];
+static uint8_t wire[PANEL_HOR_RES * PANEL_VER_RES * 2];
+static uint32_t rnd_seed;
+
+static uint32_t rnd(uint32_t range)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return (rnd_seed >> 8) % range;
+}
+
+/* The QSPI path of panel_axs15231b_draw_bitmap() */
+static void draw_bitmap(lvgl_port_fb_t * fb, lvgl_port_ramwr_t * ramwr, int x_start, int y_start, int x_end, int y_end,
+                        const uint8_t * color)
+{
+    const uint8_t caset[4] = {x_start >> 8, x_start & 0xFF, (x_end - 1) >> 8, (x_end - 1) & 0xFF};
+    lvgl_port_fb_tx_param(fb, LVGL_PORT_FB_CMD_CASET, caset, 4);
+
+    lvgl_port_ramwr_op_t op = lvgl_port_ramwr_next(ramwr, x_start, y_start, x_end, y_end);
+    if(op.raset) {
+        const uint8_t raset[4] = {y_start >> 8, y_start & 0xFF, (y_end - 1) >> 8, (y_end - 1) & 0xFF};
+        lvgl_port_fb_tx_param(fb, LVGL_PORT_FB_CMD_RASET, raset, 4);
+    }
+    lvgl_port_fb_tx_color(fb, op.continuation ? LVGL_PORT_FB_CMD_RAMWRC : LVGL_PORT_FB_CMD_RAMWR, color,
+                          (size_t)(x_end - x_start) * (y_end - y_start) * 2);
+}
+
+/* Fill an area with a random color and send it in chunks of whole rows, like lvgl_port_flush_area() */
+static void send_area(lvgl_port_fb_t * fb, lvgl_port_ramwr_t * ramwr, int x1, int y1, int x2, int y2)
+{
+    const uint16_t color = (uint16_t)rnd(0x10000);
+    const int w = x2 - x1 + 1;
+    int x, y;
+    for(y = y1; y <= y2; y++) {
+        for(x = x1; x <= x2; x++) expected_px[y * PANEL_HOR_RES + x] = color;
+    }
+    for(y = y1; y <= y2; y += CHUNK_ROWS) {
+        const int rows = (y2 - y + 1) < CHUNK_ROWS ? (y2 - y + 1) : CHUNK_ROWS;
+        int i;
+        for(i = 0; i < w * rows; i++) {
+            wire[2 * i] = color >> 8;
+            wire[2 * i + 1] = color & 0xFF;
+        }
+        draw_bitmap(fb, ramwr, x1, y, x2 + 1, y + rows, wire);
+    }
+}
+
+void test_port_panel_fb_window_semantics(void)
+{
+    lvgl_port_fb_t fb;
+    lvgl_port_fb_init(&fb, panel_px, PANEL_HOR_RES, PANEL_VER_RES);
+
+    const uint8_t caset[4] = {0, 10, 0, 11};
+    const uint8_t raset[4] = {0, 20, 0, 21};
+    const uint8_t px[12] = {0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0x11, 0x22, 0x33, 0x44};
+    lvgl_port_fb_tx_param(&fb, LVGL_PORT_FB_CMD_CASET, caset, 4);
+    lvgl_port_fb_tx_param(&fb, LVGL_PORT_FB_CMD_RASET, raset, 4);
+
+    /* Two rows of two pixels, big endian on the wire */
+    lvgl_port_fb_tx_color(&fb, LVGL_PORT_FB_CMD_RAMWR, px, 8);
+    TEST_ASSERT_EQUAL_HEX16(0x1234, panel_px[20 * PANEL_HOR_RES + 10]);
+    TEST_ASSERT_EQUAL_HEX16(0x5678, panel_px[20 * PANEL_HOR_RES + 11]);
+    TEST_ASSERT_EQUAL_HEX16(0x9ABC, panel_px[21 * PANEL_HOR_RES + 10]);
+    TEST_ASSERT_EQUAL_HEX16(0xDEF0, panel_px[21 * PANEL_HOR_RES + 11]);
+
+    /* RAMWRC carries on at the pointer, which wrapped back to the top of the window */
+    lvgl_port_fb_tx_color(&fb, LVGL_PORT_FB_CMD_RAMWRC, px + 8, 4);
+    TEST_ASSERT_EQUAL_HEX16(0x1122, panel_px[20 * PANEL_HOR_RES + 10]);
+    TEST_ASSERT_EQUAL_HEX16(0x3344, panel_px[20 * PANEL_HOR_RES + 11]);
+
+    /* RAMWR always restarts at the top left */
+    lvgl_port_fb_tx_color(&fb, LVGL_PORT_FB_CMD_RAMWR, px, 2);
+    TEST_ASSERT_EQUAL_HEX16(0x1234, panel_px[20 * PANEL_HOR_RES + 10]);
+
+    TEST_ASSERT_EQUAL(1, fb.stats.caset);
+    TEST_ASSERT_EQUAL(1, fb.stats.raset);
+    TEST_ASSERT_EQUAL(2, fb.stats.ramwr);
+    TEST_ASSERT_EQUAL(1, fb.stats.ramwrc);
+    TEST_ASSERT_EQUAL(7, fb.stats.pixels);
+}
+
+void test_port_panel_fb_full_refresh_uses_ramwrc(void)
+{
+    lvgl_port_fb_t fb;
+    lvgl_port_ramwr_t ramwr;
+    rnd_seed = 7;
+    lvgl_port_fb_init(&fb, panel_px, PANEL_HOR_RES, PANEL_VER_RES);
+    lvgl_port_ramwr_init(&ramwr);
+    lv_memset_00(expected_px, sizeof(expected_px));
+
+    /* Straight after reset the window is the whole panel: one RAMWR, the other chunks continue */
+    send_area(&fb, &ramwr, 0, 0, PANEL_HOR_RES - 1, PANEL_VER_RES - 1);
+    send_area(&fb, &ramwr, 0, 0, PANEL_HOR_RES - 1, PANEL_VER_RES - 1);
+
+    TEST_ASSERT_EQUAL(0, fb.stats.raset);
+    TEST_ASSERT_EQUAL(2, fb.stats.ramwr);
+    TEST_ASSERT_EQUAL(2 * (PANEL_VER_RES / CHUNK_ROWS - 1), fb.stats.ramwrc);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(expected_px, panel_px, PANEL_HOR_RES * PANEL_VER_RES);
+}
+
+void test_port_panel_fb_partial_refresh_matches(void)
+{
+    lvgl_port_fb_t fb;
+    lvgl_port_ramwr_t ramwr;
+    uint32_t i;
+    rnd_seed = 1;
+    lvgl_port_fb_init(&fb, panel_px, PANEL_HOR_RES, PANEL_VER_RES);
+    lvgl_port_ramwr_init(&ramwr);
+    lv_memset_00(expected_px, sizeof(expected_px));
+
+    /* Partial areas (full width, as lvgl_port_area_round() makes them) mixed with full frames
+     * and a few narrow ones, in any order: every pixel must land where the reference puts it */
+    for(i = 0; i < 200; i++) {
+        int y1 = rnd(PANEL_VER_RES);
+        int y2 = y1 + rnd(PANEL_VER_RES - y1);
+        int x1 = 0;
+        int x2 = PANEL_HOR_RES - 1;
+        if(i % 10 == 0) {
+            y1 = 0;
+            y2 = PANEL_VER_RES - 1;
+        }
+        else if(i % 7 == 0) {
+            x1 = rnd(PANEL_HOR_RES);
+            x2 = x1 + rnd(PANEL_HOR_RES - x1);
+        }
+        send_area(&fb, &ramwr, x1, y1, x2, y2);
+    }
+
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(expected_px, panel_px, PANEL_HOR_RES * PANEL_VER_RES);
+    TEST_ASSERT_GREATER_THAN(0, fb.stats.ramwrc);
+    TEST_ASSERT_EQUAL(0, fb.stats.unknown);
+}
+
+#endif
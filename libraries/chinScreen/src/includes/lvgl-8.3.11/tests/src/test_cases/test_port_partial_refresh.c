@@ -0,0 +1,221 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_port_area.h"
+#include "lv_port_ramwr.h"
+
+/* Same geometry as the chinScreen panel: 320x480, 1/10 screen draw buffers in partial mode */
+#define PANEL_HOR_RES   320
+#define PANEL_VER_RES   480
+#define PARTIAL_BUF_SIZE (PANEL_HOR_RES * PANEL_VER_RES / 10)
+
+#define DASH_LABEL_CNT  12
+#define DASH_FRAME_CNT  20
+
+static lv_color_t full_buf[PANEL_HOR_RES * PANEL_VER_RES];
+static lv_color_t partial_buf_1[PARTIAL_BUF_SIZE];
+static lv_color_t partial_buf_2[PARTIAL_BUF_SIZE];
+
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+static uint32_t flushed_bytes;
+static uint32_t flush_calls;
+
+static void counting_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(color_p);
+    flushed_bytes += lv_area_get_size(area) * sizeof(lv_color_t);
+    flush_calls++;
+    lv_disp_flush_ready(drv);
+}
+
+static void port_rounder_cb(lv_disp_drv_t * drv, lv_area_t * area)
+{
+    lvgl_port_area_round(area, drv->hor_res, drv->ver_res, LV_DISP_ROT_NONE);
+}
+
+static lv_disp_t * panel_disp_create(bool full_refresh)
+{
+    if(full_refresh) {
+        lv_disp_draw_buf_init(&draw_buf, full_buf, NULL, PANEL_HOR_RES * PANEL_VER_RES);
+    }
+    else {
+        lv_disp_draw_buf_init(&draw_buf, partial_buf_1, partial_buf_2, PARTIAL_BUF_SIZE);
+    }
+
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.flush_cb = counting_flush_cb;
+    disp_drv.hor_res = PANEL_HOR_RES;
+    disp_drv.ver_res = PANEL_VER_RES;
+    disp_drv.full_refresh = full_refresh;
+    if(!full_refresh) disp_drv.rounder_cb = port_rounder_cb;
+
+    return lv_disp_drv_register(&disp_drv);
+}
+
+/**
+ * Build a dashboard with a few numeric readouts and update three of them per frame,
+ * like the dashboard and temp_monitor examples do. Returns the average bytes per frame.
+ */
+static uint32_t dashboard_bytes_per_frame(bool full_refresh)
+{
+    lv_disp_t * prev_default = lv_disp_get_default();
+    lv_disp_t * disp = panel_disp_create(full_refresh);
+    lv_disp_set_default(disp);
+
+    lv_obj_t * scr = lv_disp_get_scr_act(disp);
+    lv_obj_t * labels[DASH_LABEL_CNT];
+    uint32_t i;
+    for(i = 0; i < DASH_LABEL_CNT; i++) {
+        labels[i] = lv_label_create(scr);
+        lv_label_set_text_fmt(labels[i], "%d.%d", (int)i, 0);
+        lv_obj_set_pos(labels[i], (i % 3) * 100 + 10, (i / 3) * 110 + 20);
+    }
+    lv_refr_now(disp);
+
+    flushed_bytes = 0;
+    flush_calls = 0;
+    uint32_t frame;
+    for(frame = 0; frame < DASH_FRAME_CNT; frame++) {
+        for(i = 0; i < 3; i++) {
+            uint32_t idx = (frame + i * 5) % DASH_LABEL_CNT;
+            lv_label_set_text_fmt(labels[idx], "%d.%d", (int)idx, (int)frame);
+        }
+        lv_refr_now(disp);
+    }
+    uint32_t bytes = flushed_bytes / DASH_FRAME_CNT;
+
+    lv_disp_remove(disp);
+    /*The draw context belongs to the driver, lv_disp_remove() doesn't free it*/
+    disp_drv.draw_ctx_deinit(&disp_drv, disp_drv.draw_ctx);
+    lv_mem_free(disp_drv.draw_ctx);
+    lv_disp_set_default(prev_default);
+
+    return bytes;
+}
+
+void test_port_round_area_spans_panel_rows(void)
+{
+    lv_area_t a = {10, 20, 50, 30};
+    lvgl_port_area_round(&a, 320, 480, LV_DISP_ROT_NONE);
+    TEST_ASSERT_EQUAL(0, a.x1);
+    TEST_ASSERT_EQUAL(319, a.x2);
+    TEST_ASSERT_EQUAL(20, a.y1);
+    TEST_ASSERT_EQUAL(30, a.y2);
+
+    /*With 90/270 software rotation the panel rows are LVGL columns*/
+    lv_area_t b = {10, 20, 50, 30};
+    lvgl_port_area_round(&b, 480, 320, LV_DISP_ROT_90);
+    TEST_ASSERT_EQUAL(10, b.x1);
+    TEST_ASSERT_EQUAL(50, b.x2);
+    TEST_ASSERT_EQUAL(0, b.y1);
+    TEST_ASSERT_EQUAL(319, b.y2);
+}
+
+void test_port_ramwr_follows_the_row_window(void)
+{
+    lvgl_port_ramwr_t ramwr;
+    lvgl_port_ramwr_init(&ramwr);
+
+    /*Full refresh in chunks: RAMWR at the top, then RAMWRC*/
+    lvgl_port_ramwr_op_t op = lvgl_port_ramwr_next(&ramwr, 0, 0, 320, 48);
+    TEST_ASSERT_FALSE(op.raset);
+    TEST_ASSERT_FALSE(op.continuation);
+    op = lvgl_port_ramwr_next(&ramwr, 0, 48, 320, 96);
+    TEST_ASSERT_TRUE(op.continuation);
+
+    /*A dirty area elsewhere gets its own row window*/
+    op = lvgl_port_ramwr_next(&ramwr, 0, 200, 320, 220);
+    TEST_ASSERT_TRUE(op.raset);
+    TEST_ASSERT_FALSE(op.continuation);
+
+    /*Right below it, but outside the window it was given*/
+    op = lvgl_port_ramwr_next(&ramwr, 0, 220, 320, 240);
+    TEST_ASSERT_TRUE(op.raset);
+    TEST_ASSERT_FALSE(op.continuation);
+
+    /*Back at row 0 the window still starts at 220, so RAMWR alone would write there*/
+    op = lvgl_port_ramwr_next(&ramwr, 0, 0, 320, 48);
+    TEST_ASSERT_TRUE(op.raset);
+}
+
+/*Split a flushed area into transport chunks the way lvgl_port_flush_callback() does
+ *and check each chunk against the draw buffer*/
+static void flush_in_chunks(const lv_area_t * area, lv_disp_rot_t rot, int32_t chunk_lines)
+{
+    static lv_color_t draw[40 * 30];
+    static lv_color_t trans[40 * 30];
+    const int32_t w = lv_area_get_width(area);
+    const int32_t h = lv_area_get_height(area);
+    const bool cols = (rot == LV_DISP_ROT_90 || rot == LV_DISP_ROT_270);
+    int32_t i;
+    for(i = 0; i < w * h; i++) draw[i].full = i + 1;
+
+    int32_t start;
+    for(start = 0; start < (cols ? w : h); start += chunk_lines) {
+        lv_area_t chunk = *area;
+        if(cols) {
+            chunk.x1 = area->x1 + start;
+            chunk.x2 = LV_MIN(chunk.x1 + chunk_lines - 1, area->x2);
+        }
+        else {
+            chunk.y1 = area->y1 + start;
+            chunk.y2 = LV_MIN(chunk.y1 + chunk_lines - 1, area->y2);
+        }
+        lvgl_port_area_copy_chunk(trans, draw, area, &chunk, rot);
+
+        const int32_t cw = lv_area_get_width(&chunk);
+        const int32_t ch = lv_area_get_height(&chunk);
+        int32_t x, y;
+        for(y = 0; y < ch; y++) {
+            for(x = 0; x < cw; x++) {
+                int32_t src = (chunk.y1 - area->y1 + y) * w + (chunk.x1 - area->x1 + x);
+                int32_t dst;
+                switch(rot) {
+                    case LV_DISP_ROT_90:
+                        dst = x * ch + (ch - y - 1);
+                        break;
+                    case LV_DISP_ROT_180:
+                        dst = (ch - y - 1) * cw + (cw - x - 1);
+                        break;
+                    case LV_DISP_ROT_270:
+                        dst = (cw - x - 1) * ch + y;
+                        break;
+                    default:
+                        dst = y * cw + x;
+                        break;
+                }
+                TEST_ASSERT_EQUAL_UINT32(draw[src].full, trans[dst].full);
+            }
+        }
+    }
+}
+
+void test_port_flush_chunks_are_relative_to_the_area(void)
+{
+    /*A band of full panel rows that does not start at the top, like a partial refresh sends*/
+    lv_area_t rows = {0, 100, 39, 129};
+    flush_in_chunks(&rows, LV_DISP_ROT_NONE, 8);
+    flush_in_chunks(&rows, LV_DISP_ROT_180, 8);
+
+    /*With 90/270 the band is full height LVGL columns, away from the left edge*/
+    lv_area_t cols = {200, 0, 229, 39};
+    flush_in_chunks(&cols, LV_DISP_ROT_90, 7);
+    flush_in_chunks(&cols, LV_DISP_ROT_270, 7);
+}
+
+void test_port_partial_refresh_sends_less_than_full_refresh(void)
+{
+    uint32_t full = dashboard_bytes_per_frame(true);
+    uint32_t partial = dashboard_bytes_per_frame(false);
+
+    printf("dashboard, %d labels updated per frame: full refresh %"LV_PRIu32" bytes/frame, "
+           "partial refresh %"LV_PRIu32" bytes/frame\n", 3, full, partial);
+
+    TEST_ASSERT_EQUAL(PANEL_HOR_RES * PANEL_VER_RES * sizeof(lv_color_t), full);
+    TEST_ASSERT_LESS_THAN(full / 4, partial);
+}
+
+#endif
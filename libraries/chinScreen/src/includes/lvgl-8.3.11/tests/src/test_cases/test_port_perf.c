@@ -0,0 +1,154 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_port_perf.h"
+
+#define PANEL_HOR_RES   320
+#define PANEL_VER_RES   480
+
+static lv_color_t buf_1[PANEL_HOR_RES * 48];
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+static lv_refr_stat_t monitored;
+static uint32_t monitored_px;
+
+static uint32_t get_u32(const uint8_t * p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void test_port_perf_summary(void)
+{
+    lvgl_port_perf_summary_t s;
+    uint32_t i;
+    lvgl_port_perf_reset();
+
+    TEST_ASSERT_FALSE(lvgl_port_perf_get(LVGL_PORT_PERF_RENDER_US, &s));
+    TEST_ASSERT_EQUAL(0, s.count);
+
+    /* Shuffled 1 .. 100 */
+    for(i = 0; i < 100; i++) lvgl_port_perf_record(LVGL_PORT_PERF_RENDER_US, (i * 37) % 100 + 1);
+
+    TEST_ASSERT_TRUE(lvgl_port_perf_get(LVGL_PORT_PERF_RENDER_US, &s));
+    TEST_ASSERT_EQUAL(100, s.count);
+    TEST_ASSERT_EQUAL(1, s.min);
+    TEST_ASSERT_EQUAL(51, s.avg);
+    TEST_ASSERT_EQUAL(100, s.max);
+    TEST_ASSERT_EQUAL(99, s.p99);
+
+    /* Other metrics are untouched */
+    TEST_ASSERT_FALSE(lvgl_port_perf_get(LVGL_PORT_PERF_FLUSH_US, &s));
+}
+
+void test_port_perf_window_rolls(void)
+{
+    lvgl_port_perf_summary_t s;
+    uint32_t i;
+    lvgl_port_perf_reset();
+
+    /* A slow start drops out of the window */
+    for(i = 0; i < 10; i++) lvgl_port_perf_record(LVGL_PORT_PERF_SLEEP_MS, 500);
+    for(i = 0; i < LVGL_PORT_PERF_WINDOW; i++) lvgl_port_perf_record(LVGL_PORT_PERF_SLEEP_MS, i < LVGL_PORT_PERF_WINDOW - 1 ? 5 : 30);
+
+    lvgl_port_perf_get(LVGL_PORT_PERF_SLEEP_MS, &s);
+    TEST_ASSERT_EQUAL(LVGL_PORT_PERF_WINDOW, s.count);
+    TEST_ASSERT_EQUAL(LVGL_PORT_PERF_WINDOW + 10, s.total);
+    TEST_ASSERT_EQUAL(5, s.min);
+    TEST_ASSERT_EQUAL(30, s.max);
+    /* One outlier in 128 samples is above the 99th percentile */
+    TEST_ASSERT_EQUAL(5, s.p99);
+}
+
+void test_port_perf_per_frame_sums(void)
+{
+    lvgl_port_perf_summary_t s;
+    lvgl_port_perf_reset();
+
+    /* Two flushes in the first frame, one in the second */
+    lvgl_port_perf_add(LVGL_PORT_PERF_TX_BYTES, 30720);
+    lvgl_port_perf_add(LVGL_PORT_PERF_TX_BYTES, 1280);
+    lvgl_port_perf_commit(LVGL_PORT_PERF_TX_BYTES);
+    lvgl_port_perf_add(LVGL_PORT_PERF_TX_BYTES, 640);
+    lvgl_port_perf_commit(LVGL_PORT_PERF_TX_BYTES);
+
+    lvgl_port_perf_get(LVGL_PORT_PERF_TX_BYTES, &s);
+    TEST_ASSERT_EQUAL(2, s.count);
+    TEST_ASSERT_EQUAL(640, s.min);
+    TEST_ASSERT_EQUAL(32000, s.max);
+}
+
+void test_port_perf_dump(void)
+{
+    uint8_t dump[LVGL_PORT_PERF_DUMP_SIZE];
+    uint32_t i;
+    lvgl_port_perf_reset();
+
+    for(i = 0; i < 20; i++) lvgl_port_perf_record(LVGL_PORT_PERF_AREAS, i < 15 ? 3 : 40);
+
+    TEST_ASSERT_EQUAL(0, lvgl_port_perf_dump(dump, sizeof(dump) - 1, 1234));
+    TEST_ASSERT_EQUAL(LVGL_PORT_PERF_DUMP_SIZE, lvgl_port_perf_dump(dump, sizeof(dump), 1234));
+
+    TEST_ASSERT_EQUAL_HEX32(LVGL_PORT_PERF_DUMP_MAGIC, get_u32(dump));
+    TEST_ASSERT_EQUAL(LVGL_PORT_PERF_DUMP_VERSION, dump[4]);
+    TEST_ASSERT_EQUAL(LVGL_PORT_PERF_MAX, dump[5]);
+    TEST_ASSERT_EQUAL(LVGL_PORT_PERF_WINDOW, dump[6] | (dump[7] << 8));
+    TEST_ASSERT_EQUAL(1234, get_u32(dump + 8));
+
+    const uint8_t * m = dump + 12 + LVGL_PORT_PERF_AREAS * (22 + LVGL_PORT_PERF_BUCKETS);
+    TEST_ASSERT_EQUAL(20, get_u32(m));
+    TEST_ASSERT_EQUAL(20, m[4] | (m[5] << 8));
+    TEST_ASSERT_EQUAL(3, get_u32(m + 6));
+    TEST_ASSERT_EQUAL(40, get_u32(m + 14));
+    /* 3 has a bit length of 2, 40 of 6 */
+    TEST_ASSERT_EQUAL(15, m[22 + 2]);
+    TEST_ASSERT_EQUAL(5, m[22 + 6]);
+}
+
+static void dummy_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(drv);
+}
+
+static void monitor_cb(lv_disp_drv_t * drv, uint32_t time, uint32_t px)
+{
+    LV_UNUSED(drv);
+    LV_UNUSED(time);
+    monitored = *lv_refr_get_stat();
+    monitored_px = px;
+}
+
+void test_port_perf_refr_stat(void)
+{
+    lv_disp_t * prev_default = lv_disp_get_default();
+    lv_disp_draw_buf_init(&draw_buf, buf_1, NULL, PANEL_HOR_RES * 48);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.flush_cb = dummy_flush_cb;
+    disp_drv.monitor_cb = monitor_cb;
+    disp_drv.hor_res = PANEL_HOR_RES;
+    disp_drv.ver_res = PANEL_VER_RES;
+    lv_disp_t * disp = lv_disp_drv_register(&disp_drv);
+    lv_refr_now(disp);
+
+    /* Two areas far apart are not joined; the tall one takes two draw buffers */
+    lv_area_t a1 = {10, 10, 59, 29};
+    lv_area_t a2 = {0, 100, 99, 299};
+    _lv_inv_area(disp, &a1);
+    _lv_inv_area(disp, &a2);
+    lv_refr_now(disp);
+
+    lv_disp_remove(disp);
+    disp_drv.draw_ctx_deinit(&disp_drv, disp_drv.draw_ctx);
+    lv_mem_free(disp_drv.draw_ctx);
+    lv_disp_set_default(prev_default);
+
+    TEST_ASSERT_EQUAL(2, monitored.area_num);
+    TEST_ASSERT_EQUAL(50 * 20 + 100 * 200, monitored.px_num);
+    TEST_ASSERT_EQUAL(monitored_px, monitored.px_num);
+    TEST_ASSERT_EQUAL(3, monitored.flush_num);
+}
+
+#endif
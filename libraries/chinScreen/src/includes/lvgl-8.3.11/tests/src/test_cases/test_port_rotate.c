@@ -0,0 +1,143 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include <time.h>
+
+#include "unity/unity.h"
+#include "lv_port_rotate.h"
+
+#define SRC_MAX_W   480
+#define SRC_MAX_H   320
+#define BENCH_ROUNDS 50
+
+static lv_color_t src_buf[SRC_MAX_W * SRC_MAX_H + 2];
+static lv_color_t ref_buf[SRC_MAX_W * SRC_MAX_H + 2];
+static lv_color_t out_buf[SRC_MAX_W * SRC_MAX_H + 2];
+
+/* The per-pixel loops lvgl_port_flush_callback() used before the rotation kernels */
+static void naive_rotate(lv_color_t * to, const lv_color_t * from, lv_coord_t w, lv_coord_t h, lv_coord_t stride,
+                         lv_disp_rot_t rotate)
+{
+    lv_coord_t x, y;
+    switch(rotate) {
+        case LV_DISP_ROT_90:
+            for(y = 0; y < h; y++) {
+                for(x = 0; x < w; x++) {
+                    *(to + x * h + (h - y - 1)) = *(from + y * stride + x);
+                }
+            }
+            break;
+        case LV_DISP_ROT_270:
+            for(y = 0; y < h; y++) {
+                for(x = 0; x < w; x++) {
+                    *(to + (w - x - 1) * h + y) = *(from + y * stride + x);
+                }
+            }
+            break;
+        case LV_DISP_ROT_180:
+            for(y = 0; y < h; y++) {
+                for(x = 0; x < w; x++) {
+                    *(to + (h - y - 1) * w + (w - x - 1)) = *(from + y * stride + x);
+                }
+            }
+            break;
+        case LV_DISP_ROT_NONE:
+        default:
+            for(y = 0; y < h; y++) {
+                for(x = 0; x < w; x++) {
+                    *(to + y * w + x) = *(from + y * stride + x);
+                }
+            }
+            break;
+    }
+}
+
+static void fill_source(void)
+{
+    uint32_t seed = 0x12345678;
+    uint32_t i;
+    for(i = 0; i < sizeof(src_buf) / sizeof(src_buf[0]); i++) {
+        seed = seed * 1103515245 + 12345;
+        src_buf[i] = lv_color_hex(seed >> 8);
+    }
+}
+
+static void check_block(lv_coord_t w, lv_coord_t h, lv_coord_t stride, uint32_t src_ofs, uint32_t dst_ofs,
+                        lv_disp_rot_t rotate)
+{
+    const uint32_t px = (uint32_t)w * h;
+    lv_memset_00(ref_buf, sizeof(ref_buf));
+    lv_memset_00(out_buf, sizeof(out_buf));
+
+    naive_rotate(ref_buf + dst_ofs, src_buf + src_ofs, w, h, stride, rotate);
+    lvgl_port_rotate_copy(out_buf + dst_ofs, src_buf + src_ofs, w, h, stride, rotate);
+
+    char msg[96];
+    lv_snprintf(msg, sizeof(msg), "rot %d, %dx%d, stride %d, offsets %d/%d", rotate * 90, w, h, stride,
+                (int)src_ofs, (int)dst_ofs);
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(ref_buf, out_buf, (px + 2) * sizeof(lv_color_t), msg);
+}
+
+void test_port_rotate_matches_naive_loops(void)
+{
+    /* Even and odd sizes, partial tiles, strided blocks and unaligned buffers */
+    static const lv_coord_t sizes[][3] = {
+        {1, 1, 1}, {2, 2, 2}, {3, 5, 3}, {16, 16, 16}, {17, 15, 17}, {31, 33, 40},
+        {48, 320, 48}, {320, 48, 320}, {51, 301, 480}, {480, 320, 480},
+    };
+    static const lv_disp_rot_t rotations[] = {LV_DISP_ROT_NONE, LV_DISP_ROT_90, LV_DISP_ROT_180, LV_DISP_ROT_270};
+
+    fill_source();
+
+    uint32_t s, r, src_ofs, dst_ofs;
+    for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        for(r = 0; r < sizeof(rotations) / sizeof(rotations[0]); r++) {
+            for(src_ofs = 0; src_ofs < 2; src_ofs++) {
+                for(dst_ofs = 0; dst_ofs < 2; dst_ofs++) {
+                    if(sizes[s][2] * sizes[s][1] + src_ofs > SRC_MAX_W * SRC_MAX_H) continue;
+                    check_block(sizes[s][0], sizes[s][1], sizes[s][2], src_ofs, dst_ofs, rotations[r]);
+                }
+            }
+        }
+    }
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * Not a pass/fail test: prints how long a landscape frame takes to rotate for the portrait
+ * panel, as a full screen and as the 1/10 screen areas the partial refresh sends.
+ */
+void test_port_rotate_benchmark(void)
+{
+    static const lv_coord_t blocks[][2] = {{480, 320}, {48, 320}};
+    static const lv_disp_rot_t rotations[] = {LV_DISP_ROT_NONE, LV_DISP_ROT_90, LV_DISP_ROT_180, LV_DISP_ROT_270};
+
+    fill_source();
+
+    uint32_t b, r, i;
+    for(b = 0; b < sizeof(blocks) / sizeof(blocks[0]); b++) {
+        const lv_coord_t w = blocks[b][0];
+        const lv_coord_t h = blocks[b][1];
+        for(r = 0; r < sizeof(rotations) / sizeof(rotations[0]); r++) {
+            uint64_t t0 = now_ns();
+            for(i = 0; i < BENCH_ROUNDS; i++) naive_rotate(ref_buf, src_buf, w, h, w, rotations[r]);
+            uint64_t t1 = now_ns();
+            for(i = 0; i < BENCH_ROUNDS; i++) lvgl_port_rotate_copy(out_buf, src_buf, w, h, w, rotations[r]);
+            uint64_t t2 = now_ns();
+
+            uint64_t px = (uint64_t)w * h * BENCH_ROUNDS;
+            printf("rotate %3d, %3dx%3d: naive %5"LV_PRIu32" ps/px, blocked %5"LV_PRIu32" ps/px\n",
+                   rotations[r] * 90, w, h, (uint32_t)((t1 - t0) * 1000 / px), (uint32_t)((t2 - t1) * 1000 / px));
+
+            TEST_ASSERT_EQUAL_MEMORY(ref_buf, out_buf, (size_t)w * h * sizeof(lv_color_t));
+        }
+    }
+}
+
+#endif
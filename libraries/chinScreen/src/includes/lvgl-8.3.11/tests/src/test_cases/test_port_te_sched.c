@@ -0,0 +1,164 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_port_te.h"
+
+/* JC3248W535EN: 480 panel rows, 40 MHz QSPI = 32 us per 320 pixel RGB565 row */
+#define PANEL_LINES     480
+#define ROW_XFER_NS     32000
+#define BAND_ROWS       48
+#define MARGIN_US       200
+
+/* The panel in the trace runs at 60 Hz, not at the 13 + 3 ms the scheduler starts from */
+#define TRUE_PERIOD_US  16667
+#define TRUE_SCAN_US    (TRUE_PERIOD_US * 13 / 16)
+#define TRACE_EDGES     240
+#define TRACE_GLITCH    37      /*Spurious edge injected after this one*/
+#define TRACE_DROPPED   90      /*This edge never reaches the interrupt*/
+
+static int64_t trace_us[TRACE_EDGES];
+static uint32_t rnd_seed;
+
+static uint32_t rnd(uint32_t range)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return (rnd_seed >> 8) % range;
+}
+
+/* TE edge timestamps as esp_timer_get_time() would record them: +-30 us of interrupt latency */
+static void make_trace(void)
+{
+    uint32_t i;
+    rnd_seed = 1;
+    for(i = 0; i < TRACE_EDGES; i++) {
+        trace_us[i] = 1000000 + (int64_t)i * TRUE_PERIOD_US + (int64_t)rnd(61) - 30;
+    }
+}
+
+static void sched_init(lvgl_port_te_t * te)
+{
+    const lvgl_port_te_cfg_t cfg = {
+        .lines = PANEL_LINES,
+        .period_us = 16000,
+        .scan_us = 13000,
+        .row_xfer_ns = ROW_XFER_NS,
+        .margin_us = MARGIN_US,
+    };
+    lvgl_port_te_init(te, &cfg);
+}
+
+/* Feed the scheduler every edge up to now_us, like the TE interrupt would */
+static void replay_edges(lvgl_port_te_t * te, uint32_t * next, int64_t now_us)
+{
+    while(*next < TRACE_EDGES && trace_us[*next] <= now_us) {
+        if(*next != TRACE_DROPPED) lvgl_port_te_edge(te, trace_us[*next]);
+        if(*next == TRACE_GLITCH) lvgl_port_te_edge(te, trace_us[*next] + 2500);
+        (*next)++;
+    }
+}
+
+/* Check a transfer against the real scan: in any scan, the band's rows must be all old or all new */
+static bool band_tears(int64_t start_us, int32_t row_start, int32_t row_end)
+{
+    uint32_t k;
+    for(k = 0; k < TRACE_EDGES; k++) {
+        int32_t y;
+        uint32_t fresh = 0;
+        for(y = row_start; y <= row_end; y++) {
+            int64_t written = start_us + (int64_t)(y - row_start + 1) * ROW_XFER_NS / 1000;
+            int64_t scanned = trace_us[k] + (int64_t)y * TRUE_SCAN_US / PANEL_LINES;
+            if(written <= scanned) fresh++;
+        }
+        if(fresh && fresh != (uint32_t)(row_end - row_start + 1)) return true;
+    }
+    return false;
+}
+
+void test_port_te_sched_learns_period(void)
+{
+    lvgl_port_te_t te;
+    uint32_t next = 0;
+    make_trace();
+    sched_init(&te);
+
+    replay_edges(&te, &next, trace_us[TRACE_EDGES - 1]);
+
+    TEST_ASSERT_EQUAL(TRACE_EDGES - 1, te.stats.te_count);
+    TEST_ASSERT_EQUAL(1, te.stats.te_rejected);
+    TEST_ASSERT_INT_WITHIN(TRUE_PERIOD_US / 200, TRUE_PERIOD_US, te.stats.period_us);
+
+    /* A full frame takes 15.4 ms on the bus, so LVGL can refresh on every vsync */
+    TEST_ASSERT_EQUAL(17, lvgl_port_te_refr_period_ms(&te));
+}
+
+void test_port_te_sched_replay_avoids_tearing(void)
+{
+    lvgl_port_te_t te;
+    uint32_t next = 0;
+    make_trace();
+    sched_init(&te);
+
+    /* Warm up on the first second of edges */
+    int64_t now = trace_us[60];
+    replay_edges(&te, &next, now);
+
+    uint32_t naive_tears = 0;
+    uint32_t sched_tears = 0;
+    uint32_t bands = 0;
+    uint32_t frame = 0;
+    int64_t bus_free = now;
+    while(now < trace_us[TRACE_EDGES - 20]) {
+        /* A scrolling list: ten bands per frame, each rendered in 0.3 .. 2.3 ms;
+         * every third frame is sent as one full screen area, like with full refresh */
+        const int32_t band_rows = (frame % 3) ? BAND_ROWS : PANEL_LINES;
+        int32_t band;
+        for(band = 0; band < PANEL_LINES / band_rows; band++) {
+            int32_t row_start = band * band_rows;
+            int32_t row_end = row_start + band_rows - 1;
+            now += 300 + rnd(2000);
+            if(now < bus_free) now = bus_free;
+            replay_edges(&te, &next, now);
+
+            if(band_tears(now, row_start, row_end)) naive_tears++;
+
+            uint32_t wait = lvgl_port_te_plan(&te, now, row_start, row_end);
+            int64_t start = now + wait;
+            if(band_tears(start, row_start, row_end)) sched_tears++;
+
+            bus_free = start + (int64_t)band_rows * ROW_XFER_NS / 1000;
+            bands++;
+        }
+        frame++;
+    }
+
+    printf("%"LV_PRIu32" bands: %"LV_PRIu32" would tear unscheduled, %"LV_PRIu32" delayed, %"LV_PRIu32
+           " torn, %"LV_PRIu32" missed, %"LV_PRIu32" us average wait\n", bands, naive_tears, te.stats.tears_avoided,
+           sched_tears, te.stats.missed_deadlines, (uint32_t)(te.stats.wait_us / bands));
+
+    TEST_ASSERT_EQUAL(bands, te.stats.bands);
+    TEST_ASSERT_GREATER_THAN(0, naive_tears);
+    TEST_ASSERT_EQUAL(0, sched_tears);
+    TEST_ASSERT_EQUAL(0, te.stats.missed_deadlines);
+    TEST_ASSERT_GREATER_OR_EQUAL(naive_tears, te.stats.tears_avoided);
+}
+
+void test_port_te_sched_without_te_sends_right_away(void)
+{
+    lvgl_port_te_t te;
+    make_trace();
+    sched_init(&te);
+
+    /* No edge yet */
+    TEST_ASSERT_EQUAL(0, lvgl_port_te_plan(&te, 5000, 0, BAND_ROWS - 1));
+
+    /* Edges stopped coming */
+    lvgl_port_te_edge(&te, 10000);
+    lvgl_port_te_edge(&te, 26000);
+    TEST_ASSERT_EQUAL(0, lvgl_port_te_plan(&te, 26000 + 5 * 16000, 0, BAND_ROWS - 1));
+
+    TEST_ASSERT_EQUAL(2, te.stats.missed_deadlines);
+    TEST_ASSERT_EQUAL(0, te.stats.tears_avoided);
+}
+
+#endif
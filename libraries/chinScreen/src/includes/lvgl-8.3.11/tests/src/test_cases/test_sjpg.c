@@ -0,0 +1,442 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_init.h"
+#include "lv_test_helpers.h"
+#include "lv_test_jpeg.h"
+
+#if LV_USE_SJPG
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../src/extra/libs/sjpg/tjpgd.h"
+
+#define JPG_FILE        "sjpg_test.jpg"
+#define SJPG_FILE       "sjpg_test.sjpg"
+#define SJPG_BLOCK_H    16
+
+typedef struct {
+    uint8_t * data;
+    uint32_t size;
+    uint32_t w;
+    uint32_t h;
+    lv_color_t * ref;           /*The picture decoded in one go*/
+    lv_img_dsc_t dsc;
+} test_jpeg_t;
+
+typedef struct {
+    const uint8_t * data;
+    uint32_t size;
+    uint32_t pos;
+    lv_color_t * out;
+    uint32_t w;
+} ref_io_t;
+
+static test_jpeg_t jpeg;
+static uint32_t rnd;
+
+static uint32_t next_rnd(uint32_t max)
+{
+    rnd = rnd * 1664525u + 1013904223u;
+    return (rnd >> 8) % max;
+}
+
+static size_t ref_input(JDEC * jd, uint8_t * buff, size_t ndata)
+{
+    ref_io_t * io = jd->device;
+    if(ndata > io->size - io->pos) ndata = io->size - io->pos;
+    if(buff) memcpy(buff, io->data + io->pos, ndata);
+    io->pos += ndata;
+    return ndata;
+}
+
+static int ref_output(JDEC * jd, void * bitmap, JRECT * rect)
+{
+    ref_io_t * io = jd->device;
+    const uint8_t * src = bitmap;
+    for(uint32_t y = rect->top; y <= rect->bottom; y++) {
+        for(uint32_t x = rect->left; x <= rect->right; x++) {
+            io->out[y * io->w + x] = lv_color_make(src[0], src[1], src[2]);
+            src += 3;
+        }
+    }
+    return 1;
+}
+
+/*Decode a JPEG the way the decoder did before streaming: all of it with jd_decomp()*/
+static void ref_decode(const uint8_t * data, uint32_t size, lv_color_t * out, uint32_t w)
+{
+    static uint8_t work[4096];
+    JDEC jd;
+    ref_io_t io = {data, size, 0, out, w};
+    TEST_ASSERT_EQUAL(JDR_OK, jd_prepare(&jd, ref_input, work, sizeof(work), &io));
+    TEST_ASSERT_EQUAL(JDR_OK, jd_decomp(&jd, ref_output, 0));
+}
+
+static void make_jpeg(uint32_t w, uint32_t h, lv_test_jpeg_subsampling_t subsampling, uint16_t restart)
+{
+    lv_test_jpeg_cfg_t cfg = {90, subsampling, restart};
+    uint8_t * rgb = malloc(w * h * 3);
+    lv_test_jpeg_fill_photo(rgb, w, h, w + h + subsampling);
+    jpeg.data = lv_test_jpeg_encode(rgb, w, h, &cfg, &jpeg.size);
+    TEST_ASSERT_NOT_NULL(jpeg.data);
+
+    jpeg.w = w;
+    jpeg.h = h;
+    jpeg.ref = malloc(w * h * sizeof(lv_color_t));
+    ref_decode(jpeg.data, jpeg.size, jpeg.ref, w);
+
+    /*The encoder is good enough for a photo*/
+    uint64_t err = 0;
+    for(uint32_t i = 0; i < w * h; i++) {
+        lv_color32_t c;
+        c.full = lv_color_to32(jpeg.ref[i]);
+        err += LV_ABS(c.ch.red - rgb[i * 3]) + LV_ABS(c.ch.green - rgb[i * 3 + 1]) + LV_ABS(c.ch.blue - rgb[i * 3 + 2]);
+    }
+    TEST_ASSERT_LESS_THAN(12, err / (w * h * 3));
+    free(rgb);
+
+    memset(&jpeg.dsc, 0, sizeof(jpeg.dsc));
+    jpeg.dsc.header.always_zero = 0;
+    jpeg.dsc.header.cf = LV_IMG_CF_RAW;
+    jpeg.dsc.header.w = w;
+    jpeg.dsc.header.h = h;
+    jpeg.dsc.data_size = jpeg.size;
+    jpeg.dsc.data = jpeg.data;
+}
+
+static void write_file(const char * fn, const uint8_t * data, uint32_t size)
+{
+    FILE * f = fopen(fn, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL(size, fwrite(data, 1, size, f));
+    fclose(f);
+}
+
+/*The picture split into SJPG_BLOCK_H lines high JPEG fragments, the format of jpg_to_sjpg.py*/
+static uint8_t * make_sjpg(uint32_t * size)
+{
+    const uint32_t frames = (jpeg.h + SJPG_BLOCK_H - 1) / SJPG_BLOCK_H;
+    lv_test_jpeg_cfg_t cfg = {90, LV_TEST_JPEG_420, 0};
+    uint8_t * rgb = malloc(jpeg.w * jpeg.h * 3);
+    lv_test_jpeg_fill_photo(rgb, jpeg.w, jpeg.h, 1);
+
+    uint32_t cap = 22 + frames * 2;
+    uint8_t * sjpg = calloc(1, cap);
+    memcpy(sjpg, "_SJPG__\0V1.00\0", 14);
+    sjpg[14] = jpeg.w & 0xff;
+    sjpg[15] = jpeg.w >> 8;
+    sjpg[16] = jpeg.h & 0xff;
+    sjpg[17] = jpeg.h >> 8;
+    sjpg[18] = frames & 0xff;
+    sjpg[19] = frames >> 8;
+    sjpg[20] = SJPG_BLOCK_H;
+    sjpg[21] = 0;
+    *size = cap;
+
+    for(uint32_t f = 0; f < frames; f++) {
+        const uint32_t y = f * SJPG_BLOCK_H;
+        const uint32_t h = LV_MIN(SJPG_BLOCK_H, jpeg.h - y);
+        uint32_t frag_size;
+        uint8_t * frag = lv_test_jpeg_encode(rgb + y * jpeg.w * 3, jpeg.w, h, &cfg, &frag_size);
+        TEST_ASSERT_NOT_NULL(frag);
+        TEST_ASSERT_LESS_THAN(0x10000, frag_size);
+        ref_decode(frag, frag_size, jpeg.ref + y * jpeg.w, jpeg.w);
+
+        sjpg = realloc(sjpg, *size + frag_size);
+        memcpy(sjpg + *size, frag, frag_size);
+        *size += frag_size;
+        sjpg[22 + f * 2] = frag_size & 0xff;
+        sjpg[22 + f * 2 + 1] = frag_size >> 8;
+        free(frag);
+    }
+    free(rgb);
+    return sjpg;
+}
+
+static void assert_area(const lv_area_t * area, const lv_color_t * buf, lv_coord_t stride)
+{
+    for(lv_coord_t y = area->y1; y <= area->y2; y++) {
+        for(lv_coord_t x = area->x1; x <= area->x2; x++) {
+            const lv_color_t expected = jpeg.ref[y * jpeg.w + x];
+            const lv_color_t actual = buf[(y - area->y1) * stride + (x - area->x1)];
+            if(expected.full != actual.full) {
+                char msg[96];
+                snprintf(msg, sizeof(msg), "pixel %d;%d of area %d;%d %d;%d", x, y, area->x1, area->y1, area->x2, area->y2);
+                TEST_ASSERT_EQUAL_HEX32_MESSAGE(lv_color_to32(expected), lv_color_to32(actual), msg);
+            }
+        }
+    }
+}
+
+static void read_and_assert(lv_img_decoder_dsc_t * dsc, lv_coord_t x1, lv_coord_t y1, lv_coord_t x2, lv_coord_t y2)
+{
+    static lv_color_t buf[320 * 480];
+    const lv_coord_t stride = x2 - x1 + 1 + 5;      /*Like a draw buffer wider than the image*/
+    lv_area_t area;
+    lv_area_set(&area, x1, y1, x2, y2);
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(buf) / sizeof(buf[0]), stride * lv_area_get_height(&area));
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_area(dsc, &area, buf, stride));
+    assert_area(&area, buf, stride);
+}
+
+/*Bands the way the display renders them, lines one by one, then areas in any order*/
+static void assert_reads(const void * src)
+{
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, src, lv_color_white(), 0));
+    TEST_ASSERT_NULL(dsc.img_data);
+    TEST_ASSERT_EQUAL(jpeg.w, dsc.header.w);
+    TEST_ASSERT_EQUAL(jpeg.h, dsc.header.h);
+
+    static const lv_coord_t bands[] = {16, 10, 48, 1, 7};
+    for(uint32_t b = 0; b < sizeof(bands) / sizeof(bands[0]); b++) {
+        for(lv_coord_t y = 0; y < (lv_coord_t)jpeg.h; y += bands[b]) {
+            read_and_assert(&dsc, 0, y, jpeg.w - 1, LV_MIN(y + bands[b], (lv_coord_t)jpeg.h) - 1);
+        }
+    }
+
+    lv_color_t line[320];
+    for(lv_coord_t y = 0; y < (lv_coord_t)jpeg.h; y++) {
+        lv_area_t area;
+        lv_area_set(&area, 3, y, jpeg.w - 4, y);
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 3, y, jpeg.w - 6, (uint8_t *)line));
+        assert_area(&area, line, jpeg.w - 6);
+    }
+
+    rnd = 1;
+    for(uint32_t i = 0; i < 60; i++) {
+        const lv_coord_t x1 = next_rnd(jpeg.w);
+        const lv_coord_t y1 = next_rnd(jpeg.h);
+        read_and_assert(&dsc, x1, y1, x1 + next_rnd(jpeg.w - x1), y1 + next_rnd(LV_MIN(jpeg.h - y1, 40)));
+    }
+
+    lv_img_decoder_close(&dsc);
+}
+
+static void assert_screen(lv_coord_t x, lv_coord_t y)
+{
+    lv_area_t area;
+    lv_area_set(&area, 0, 0, jpeg.w - 1, jpeg.h - 1);
+    assert_area(&area, test_fb + y * TEST_HOR_RES + x, TEST_HOR_RES);
+}
+
+static void refr_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+void setUp(void)
+{
+    memset(&jpeg, 0, sizeof(jpeg));
+    lv_img_cache_invalidate_src(NULL);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_img_cache_invalidate_src(NULL);
+    free(jpeg.data);
+    free(jpeg.ref);
+    remove(JPG_FILE);
+    remove(SJPG_FILE);
+}
+
+void test_jpg_read_area_444(void)
+{
+    make_jpeg(203, 157, LV_TEST_JPEG_444, 0);
+    assert_reads(&jpeg.dsc);
+}
+
+void test_jpg_read_area_422_with_restarts(void)
+{
+    make_jpeg(203, 157, LV_TEST_JPEG_422, 7);
+    assert_reads(&jpeg.dsc);
+}
+
+void test_jpg_read_area_420(void)
+{
+    make_jpeg(203, 157, LV_TEST_JPEG_420, 0);
+    assert_reads(&jpeg.dsc);
+}
+
+void test_jpg_read_area_from_file(void)
+{
+    make_jpeg(320, 120, LV_TEST_JPEG_420, 20);
+    write_file(JPG_FILE, jpeg.data, jpeg.size);
+    assert_reads("A:" JPG_FILE);
+}
+
+void test_sjpg_read_area(void)
+{
+    make_jpeg(150, 100, LV_TEST_JPEG_420, 0);
+    uint32_t size;
+    uint8_t * sjpg = make_sjpg(&size);
+
+    lv_img_dsc_t dsc = jpeg.dsc;
+    dsc.data = sjpg;
+    dsc.data_size = size;
+    assert_reads(&dsc);
+
+    write_file(SJPG_FILE, sjpg, size);
+    assert_reads("A:" SJPG_FILE);
+    free(sjpg);
+}
+
+void test_jpg_draws_into_the_draw_buffer(void)
+{
+    make_jpeg(320, 480 - 37, LV_TEST_JPEG_420, 0);
+
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &jpeg.dsc);
+    lv_obj_set_pos(img, 101, 37);
+    refr_screen();
+    assert_screen(101, 37);
+
+    /*Partly off screen, without the scrollbar drawn over it*/
+    lv_obj_set_scrollbar_mode(lv_scr_act(), LV_SCROLLBAR_MODE_OFF);
+    lv_obj_set_pos(img, 600, 37);
+    refr_screen();
+    for(uint32_t y = 0; y < jpeg.h; y++) {
+        for(uint32_t x = 0; x < 200; x++) {
+            TEST_ASSERT_EQUAL_HEX32(lv_color_to32(jpeg.ref[y * jpeg.w + x]), lv_color_to32(test_fb[(y + 37) * TEST_HOR_RES + 600 + x]));
+        }
+    }
+    lv_obj_set_scrollbar_mode(lv_scr_act(), LV_SCROLLBAR_MODE_AUTO);
+}
+
+void test_jpg_with_opacity_draws_line_by_line(void)
+{
+    make_jpeg(120, 90, LV_TEST_JPEG_444, 0);
+    lv_img_dsc_t decoded;
+    memset(&decoded, 0, sizeof(decoded));
+    decoded.header.cf = LV_IMG_CF_TRUE_COLOR;
+    decoded.header.w = jpeg.w;
+    decoded.header.h = jpeg.h;
+    decoded.data_size = jpeg.w * jpeg.h * sizeof(lv_color_t);
+    decoded.data = (const uint8_t *)jpeg.ref;
+
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(0x3070b0), 0);
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &decoded);
+    lv_obj_set_style_img_opa(img, LV_OPA_60, 0);
+    refr_screen();
+    static lv_color_t expected[120 * 90];
+    for(uint32_t y = 0; y < jpeg.h; y++) memcpy(&expected[y * jpeg.w], &test_fb[y * TEST_HOR_RES], jpeg.w * sizeof(lv_color_t));
+
+    lv_img_set_src(img, &jpeg.dsc);
+    refr_screen();
+    for(uint32_t y = 0; y < jpeg.h; y++) {
+        for(uint32_t x = 0; x < jpeg.w; x++) {
+            TEST_ASSERT_EQUAL_HEX32(lv_color_to32(expected[y * jpeg.w + x]), lv_color_to32(test_fb[y * TEST_HOR_RES + x]));
+        }
+    }
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
+}
+
+void test_jpg_needs_one_mcu_row_of_memory(void)
+{
+    make_jpeg(320, 480, LV_TEST_JPEG_420, 0);
+
+    /*Before, a JPEG kept all of it decoded, 320 x 480 x 3 bytes*/
+    const uint32_t free_before = lv_test_get_free_mem();
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, &jpeg.dsc, lv_color_white(), 0));
+    const uint32_t opened = lv_test_get_free_mem();
+    LV_HEAP_CHECK(TEST_ASSERT_LESS_THAN(4096 + sizeof(JDEC) + 512 + 320 * 16 * sizeof(lv_color_t) + (480 / 8 + 1) * 20,
+                                        free_before - opened));
+
+    /*Decoding doesn't allocate anything else*/
+    static lv_color_t buf[320 * 480];
+    lv_area_t area;
+    lv_area_set(&area, 0, 0, 319, 479);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_area(&dsc, &area, buf, 320));
+    LV_HEAP_CHECK(TEST_ASSERT_EQUAL(opened, lv_test_get_free_mem()));
+    assert_area(&area, buf, 320);
+
+    lv_img_decoder_close(&dsc);
+    LV_HEAP_CHECK(TEST_ASSERT_EQUAL(free_before, lv_test_get_free_mem()));
+}
+
+void test_jpg_truncated(void)
+{
+    make_jpeg(160, 160, LV_TEST_JPEG_420, 0);
+    jpeg.dsc.data_size = jpeg.size / 2;
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, &jpeg.dsc, lv_color_white(), 0));
+
+    /*The lower half is missing, the upper half still decodes after the error*/
+    static lv_color_t buf[160 * 160];
+    lv_area_t area;
+    lv_area_set(&area, 0, 120, 159, 159);
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_read_area(&dsc, &area, buf, 160));
+    lv_area_set(&area, 0, 0, 159, 31);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_area(&dsc, &area, buf, 160));
+    assert_area(&area, buf, 160);
+
+    lv_img_decoder_close(&dsc);
+}
+
+#else /*LV_USE_SJPG*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_jpg_read_area_444(void)
+{
+
+}
+
+void test_jpg_read_area_422_with_restarts(void)
+{
+
+}
+
+void test_jpg_read_area_420(void)
+{
+
+}
+
+void test_jpg_read_area_from_file(void)
+{
+
+}
+
+void test_sjpg_read_area(void)
+{
+
+}
+
+void test_jpg_draws_into_the_draw_buffer(void)
+{
+
+}
+
+void test_jpg_with_opacity_draws_line_by_line(void)
+{
+
+}
+
+void test_jpg_needs_one_mcu_row_of_memory(void)
+{
+
+}
+
+void test_jpg_truncated(void)
+{
+
+}
+
+#endif /*LV_USE_SJPG*/
+
+#endif /*LV_BUILD_TEST*/
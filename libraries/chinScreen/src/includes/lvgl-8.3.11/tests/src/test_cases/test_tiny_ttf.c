@@ -2,6 +2,26 @@
 #include "../lvgl.h"
 
 #include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+#include <stdio.h>
+
+#if LV_USE_TINY_TTF
+extern const uint8_t ubuntu_font[];
+extern size_t ubuntu_font_size;
+
+#define UBUNTU_FONT_FILE "tiny_ttf_test.ttf"
+
+/*Destroyed after every test, also the ones that failed*/
+static lv_font_t * fonts[3];
+static lv_style_t style;
+
+static void font_destroy(uint32_t i)
+{
+    lv_tiny_ttf_destroy(fonts[i]);
+    fonts[i] = NULL;
+}
+#endif
 
 void setUp(void)
 {
@@ -11,18 +31,22 @@ void setUp(void)
 void tearDown(void)
 {
     /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+#if LV_USE_TINY_TTF
+    lv_style_reset(&style);
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        if(fonts[i]) font_destroy(i);
+    }
+    lv_tiny_ttf_cache_set_budget(LV_TINY_TTF_CACHE_DEF_BYTES);
+    remove(UBUNTU_FONT_FILE);
+#endif
 }
 
-void test_tiny_ttf_rendering_test(void)
-{
 #if LV_USE_TINY_TTF
-    /*Create a font*/
-    extern const uint8_t ubuntu_font[];
-    extern size_t ubuntu_font_size;
-    lv_font_t * font = lv_tiny_ttf_create_data(ubuntu_font, ubuntu_font_size, 30);
-
+static void create_test_label(lv_font_t * font)
+{
     /*Create style with the new font*/
-    static lv_style_t style;
     lv_style_init(&style);
     lv_style_set_text_font(&style, font);
     lv_style_set_text_align(&style, LV_TEXT_ALIGN_CENTER);
@@ -36,11 +60,173 @@ void test_tiny_ttf_rendering_test(void)
                       "I'm a font created with Tiny TTF\n"
                       "Accents: ÁÉÍÓÖŐÜŰ áéíóöőüű");
     lv_obj_center(label);
+}
+#endif
+
+void test_tiny_ttf_rendering_test(void)
+{
+#if LV_USE_TINY_TTF
+    /*Create a font*/
+    fonts[0] = lv_tiny_ttf_create_data(ubuntu_font, ubuntu_font_size, 30);
+    create_test_label(fonts[0]);
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("tiny_ttf_1.png");
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_tiny_ttf_glyphs_are_cached(void)
+{
+#if LV_USE_TINY_TTF
+    lv_font_t * font = fonts[0] = lv_tiny_ttf_create_data(ubuntu_font, ubuntu_font_size, 30);
+    lv_tiny_ttf_reset_stats();
+
+    lv_font_glyph_dsc_t g;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, 'A', 0));
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, 'A', 0));
+    const uint8_t * bitmap = lv_font_get_glyph_bitmap(font, 'A');
+    TEST_ASSERT_NOT_NULL(bitmap);
+    TEST_ASSERT_EQUAL_PTR(bitmap, lv_font_get_glyph_bitmap(font, 'A'));
+
+    lv_tiny_ttf_stats_t stats;
+    lv_tiny_ttf_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.metric_misses);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.metric_hits);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.misses);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.hits);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.glyph_cnt);
+    TEST_ASSERT_EQUAL_UINT32(LV_TINY_TTF_CACHE_DEF_BYTES, stats.budget);
+
+    /*Letters that aren't in the font are remembered too*/
+    TEST_ASSERT_FALSE(lv_font_get_glyph_dsc(font, &g, 0x4e2d, 0));
+    TEST_ASSERT_FALSE(lv_font_get_glyph_dsc(font, &g, 0x4e2d, 0));
+    TEST_ASSERT_NULL(lv_font_get_glyph_bitmap(font, 0x4e2d));
+    lv_tiny_ttf_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.metric_misses);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.misses);
+
+    font_destroy(0);
+    lv_tiny_ttf_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.glyph_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.bytes);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_tiny_ttf_sizes_share_the_font(void)
+{
+#if LV_USE_TINY_TTF
+    const uint32_t free_mem = lv_test_get_free_mem();
+    lv_font_t * font = fonts[0] = lv_tiny_ttf_create_data(ubuntu_font, ubuntu_font_size, 30);
+    lv_font_t * small = fonts[1] = lv_tiny_ttf_create_size(font, 16);
+    lv_font_t * same = fonts[2] = lv_tiny_ttf_create_size(small, 30);
+    TEST_ASSERT_NOT_NULL(small);
+    TEST_ASSERT_LESS_THAN(font->line_height, small->line_height);
+    TEST_ASSERT_EQUAL(font->line_height, same->line_height);
+
+    lv_font_glyph_dsc_t g_small;
+    lv_font_glyph_dsc_t g_big;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(small, &g_small, 'W', 0));
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g_big, 'W', 0));
+    TEST_ASSERT_LESS_THAN(g_big.box_w, g_small.box_w);
+
+    /*Fonts of the same size use the same glyphs*/
+    lv_tiny_ttf_reset_stats();
+    TEST_ASSERT_EQUAL_UINT32(3, lv_tiny_ttf_warm_up(font, "Wow"));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_tiny_ttf_warm_up(same, "Wow"));
+    TEST_ASSERT_EQUAL_UINT32(3, lv_tiny_ttf_warm_up(small, "Wow"));
+
+    /*The file is kept while a size uses it*/
+    font_destroy(0);
+    font_destroy(2);
+    TEST_ASSERT_EQUAL_UINT32(3, lv_tiny_ttf_warm_up(small, "xyz"));
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(small, &g_big, 'W', 0));
+    TEST_ASSERT_EQUAL(g_small.adv_w, g_big.adv_w);
+    TEST_ASSERT_EQUAL(g_small.box_w, g_big.box_w);
+    TEST_ASSERT_EQUAL(g_small.box_h, g_big.box_h);
+    font_destroy(1);
+
+    LV_HEAP_CHECK(TEST_ASSERT_EQUAL_UINT32(free_mem, lv_test_get_free_mem()));
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_tiny_ttf_cache_stays_in_budget(void)
+{
+#if LV_USE_TINY_TTF
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+    lv_font_t * font = fonts[0] = lv_tiny_ttf_create_data(ubuntu_font, ubuntu_font_size, 40);
+    lv_tiny_ttf_reset_stats();
+    TEST_ASSERT_EQUAL_UINT32(sizeof(alphabet) - 1, lv_tiny_ttf_warm_up(font, alphabet));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_tiny_ttf_warm_up(font, alphabet));
+
+    lv_tiny_ttf_stats_t stats;
+    lv_tiny_ttf_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(alphabet) - 1, stats.glyph_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.evictions);
+    const uint32_t bytes = stats.bytes;
+
+    /*The glyphs used longest ago go first*/
+    lv_tiny_ttf_cache_set_budget(bytes / 2);
+    lv_tiny_ttf_get_stats(&stats);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(bytes / 2, stats.bytes);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.evictions);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_tiny_ttf_warm_up(font, "9"));
+    TEST_ASSERT_EQUAL_UINT32(1, lv_tiny_ttf_warm_up(font, "A"));
+    lv_tiny_ttf_get_stats(&stats);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(bytes / 2, stats.bytes);
+
+    /*Without a cache every glyph is drawn again*/
+    lv_tiny_ttf_cache_set_budget(0);
+    lv_tiny_ttf_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.glyph_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.bytes);
+    TEST_ASSERT_EQUAL_UINT32(3, lv_tiny_ttf_warm_up(font, "abc"));
+    TEST_ASSERT_EQUAL_UINT32(3, lv_tiny_ttf_warm_up(font, "abc"));
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_tiny_ttf_rendering_without_cache(void)
+{
+#if LV_USE_TINY_TTF
+    lv_tiny_ttf_cache_set_budget(0);
+    fonts[0] = lv_tiny_ttf_create_data(ubuntu_font, ubuntu_font_size, 30);
+    create_test_label(fonts[0]);
 
     TEST_ASSERT_EQUAL_SCREENSHOT("tiny_ttf_1.png");
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_tiny_ttf_rendering_from_file(void)
+{
+#if LV_USE_TINY_TTF && LV_TINY_TTF_FILE_SUPPORT
+    FILE * f = fopen(UBUNTU_FONT_FILE, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL(ubuntu_font_size, fwrite(ubuntu_font, 1, ubuntu_font_size, f));
+    fclose(f);
 
-    lv_obj_del(label);
-    lv_tiny_ttf_destroy(font);
+    TEST_ASSERT_NULL(lv_tiny_ttf_create_file("A:no_such_font.ttf", 30));
+
+    lv_tiny_ttf_reset_stats();
+    fonts[0] = lv_tiny_ttf_create_file("A:" UBUNTU_FONT_FILE, 30);
+    TEST_ASSERT_NOT_NULL(fonts[0]);
+    create_test_label(fonts[0]);
+    lv_refr_now(NULL);
+
+    /*Only the pages with the used glyphs were read*/
+    lv_tiny_ttf_stats_t stats;
+    lv_tiny_ttf_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.page_reads);
+    TEST_ASSERT_LESS_THAN_UINT32(ubuntu_font_size, stats.bytes_read);
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("tiny_ttf_1.png");
 #else
     TEST_PASS();
 #endif
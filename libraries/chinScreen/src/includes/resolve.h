@@ -0,0 +1,241 @@
+//         __     __         _______
+//  .----.|  |--.|__|.-----.|     __|.----.----.-----.-----.-----.
+//  |  __||     ||  ||     ||__     ||  __|   _|  -__|  -__|     |
+//  |____||__|__||__||__|__||_______||____|__| |_____|_____|__|__|
+//
+//   Improved library for the JC3248W525EN using LVGL based on
+//   too many attempts on the internet. This should be easy to useful
+//
+//   Author: Richard Loucks
+//   Inital Release: Sept 2025
+//   For updates, see git commits
+//   https://github.com/rloucks/chinScreen
+//
+//   Version: 0.0.2b
+//
+//   Hardware based for JC3248W525EN touch screen ESP32-S3 Panel
+//
+//   File: resolve.h
+//   Purpose: turn colour, font and alignment names into LVGL values
+//   Required: YES
+//
+//   Colour and font names are hashed with FNV-1a (ignoring case) into a
+//   perfect hash table, so a name is found with one hash and one compare
+//   instead of a compare per known name. The tables are built by the
+//   compiler with C++14 and newer, at start up with C++11.
+//
+//   String literals can skip the look up altogether:
+//     CHINSCREEN_COLOR("red"), CHINSCREEN_FONT("large"),
+//     CHINSCREEN_ALIGN("top", "left")
+//   are resolved while compiling, and a misspelled name doesn't compile.
+
+/////////////////////////////////////////////////////////////
+// Compiler support
+/////////////////////////////////////////////////////////////
+#if __cplusplus >= 201402L
+#define CHINSCREEN_CONSTEXPR14 constexpr
+#else
+#define CHINSCREEN_CONSTEXPR14
+#endif
+
+#ifdef __cpp_consteval
+#define CHINSCREEN_CONSTEVAL consteval
+#else
+#define CHINSCREEN_CONSTEVAL constexpr
+#endif
+
+// Forces a value to be computed while compiling, even without consteval
+template<typename T, T v>
+struct chinScreen_constant {
+    static constexpr T value = v;
+};
+
+/////////////////////////////////////////////////////////////
+// Function: Hash and compare names, ignoring case
+/////////////////////////////////////////////////////////////
+constexpr char chinScreen_lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+}
+
+constexpr uint32_t chinScreen_hash(const char* s, uint32_t h = 2166136261u) {
+    return *s ? chinScreen_hash(s + 1, (h ^ (uint8_t)chinScreen_lower(*s)) * 16777619u) : h;
+}
+
+constexpr bool chinScreen_same_name(const char* a, const char* b) {
+    return chinScreen_lower(*a) != chinScreen_lower(*b) ? false :
+           *a == '\0' ? true : chinScreen_same_name(a + 1, b + 1);
+}
+
+// The name of a table entry, tables of structs add their own overload
+constexpr const char* chinScreen_entry_name(const char* entry) {
+    return entry;
+}
+
+/////////////////////////////////////////////////////////////
+// Perfect hash table of up to 255 names
+//
+// The names are spread over N/4 buckets by their hash. Every bucket
+// gets a displacement that moves its names to free slots, so no two
+// names share a slot. N is a power of two, 2x the names or more.
+/////////////////////////////////////////////////////////////
+template<uint16_t N>
+struct chinScreen_phash {
+    uint8_t disp[N / 4];    // Displacement of every bucket
+    uint8_t slot[N];        // Index of the name + 1, 0 if the slot is free
+    bool ok;                // false if two names have the same hash
+};
+
+template<uint16_t N>
+constexpr uint16_t chinScreen_phash_pos(uint32_t h, uint8_t d) {
+    // The step is odd, so the displacements visit every slot
+    return (uint16_t)(((h >> 16) + d * ((h >> 8) | 1)) & (N - 1));
+}
+
+template<uint16_t N, typename T>
+CHINSCREEN_CONSTEXPR14 chinScreen_phash<N> chinScreen_phash_build(const T* entries, uint16_t count) {
+    chinScreen_phash<N> t{};
+    uint32_t hashes[N] = {};
+    uint8_t bucket_size[N / 4] = {};
+    uint8_t biggest = 0;
+    if (count >= N || count > 255) return t;
+    for (uint16_t i = 0; i < count; i++) {
+        hashes[i] = chinScreen_hash(chinScreen_entry_name(entries[i]));
+        uint8_t size = ++bucket_size[hashes[i] & (N / 4 - 1)];
+        if (size > biggest) biggest = size;
+    }
+    if (biggest > 16) return t;
+
+    // The biggest buckets first, while most slots are free
+    for (uint8_t size = biggest; size > 0; size--) {
+        for (uint16_t b = 0; b < N / 4; b++) {
+            if (bucket_size[b] != size) continue;
+            uint8_t members[16] = {};
+            uint8_t n = 0;
+            for (uint16_t i = 0; i < count; i++) {
+                if ((hashes[i] & (N / 4 - 1)) == b) members[n++] = (uint8_t)i;
+            }
+
+            bool placed = false;
+            for (uint16_t d = 0; d < 256 && !placed; d++) {
+                placed = true;
+                for (uint8_t m = 0; m < n && placed; m++) {
+                    uint16_t pos = chinScreen_phash_pos<N>(hashes[members[m]], (uint8_t)d);
+                    if (t.slot[pos]) placed = false;
+                    for (uint8_t o = 0; o < m && placed; o++) {
+                        if (chinScreen_phash_pos<N>(hashes[members[o]], (uint8_t)d) == pos) placed = false;
+                    }
+                }
+                if (placed) {
+                    t.disp[b] = (uint8_t)d;
+                    for (uint8_t m = 0; m < n; m++) {
+                        t.slot[chinScreen_phash_pos<N>(hashes[members[m]], (uint8_t)d)] = (uint8_t)(members[m] + 1);
+                    }
+                }
+            }
+            if (!placed) return t;
+        }
+    }
+    t.ok = true;
+    return t;
+}
+
+// Index of the name in `entries`, -1 if it's not there
+template<uint16_t N, typename T>
+inline int chinScreen_phash_find(const chinScreen_phash<N>& t, const T* entries, uint16_t count,
+                                 const char* name) {
+    if (!name) return -1;
+    if (t.ok) {
+        uint32_t h = 2166136261u;
+        for (const char* c = name; *c; c++) h = (h ^ (uint8_t)chinScreen_lower(*c)) * 16777619u;
+        uint8_t s = t.slot[chinScreen_phash_pos<N>(h, t.disp[h & (N / 4 - 1)])];
+        if (!s) return -1;
+        const char* known = chinScreen_entry_name(entries[s - 1]);
+        while (*name && chinScreen_lower(*name) == *known) {
+            name++;
+            known++;
+        }
+        return *name == *known ? s - 1 : -1;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+        if (chinScreen_same_name(name, chinScreen_entry_name(entries[i]))) return i;
+    }
+    return -1;
+}
+
+// Used while compiling only: it isn't constexpr, so an unknown name stops the build here
+inline int chinScreen_name_not_found(const char* name) {
+    (void)name;
+    return -1;
+}
+
+template<typename T>
+constexpr int chinScreen_find_name(const T* entries, int count, const char* name, int i = 0) {
+    return i == count ? chinScreen_name_not_found(name) :
+           chinScreen_same_name(name, chinScreen_entry_name(entries[i])) ? i :
+           chinScreen_find_name(entries, count, name, i + 1);
+}
+
+#if __cplusplus >= 201402L
+#define CHINSCREEN_PHASH_ASSERT(table) static_assert((table).ok, "two names hash the same, rename one of them")
+#else
+#define CHINSCREEN_PHASH_ASSERT(table) static_assert(true, "")
+#endif
+
+/////////////////////////////////////////////////////////////
+// Alignments: "top", "middle", "bottom" and "left", "center", "right"
+/////////////////////////////////////////////////////////////
+static constexpr const char* chinScreen_align_names[] = {
+    "top", "middle", "bottom",
+    "left", "center", "right"
+};
+
+static constexpr lv_align_t chinScreen_aligns[3][3] = {
+    {LV_ALIGN_TOP_LEFT,    LV_ALIGN_TOP_MID,    LV_ALIGN_TOP_RIGHT},
+    {LV_ALIGN_LEFT_MID,    LV_ALIGN_CENTER,     LV_ALIGN_RIGHT_MID},
+    {LV_ALIGN_BOTTOM_LEFT, LV_ALIGN_BOTTOM_MID, LV_ALIGN_BOTTOM_RIGHT}
+};
+
+// The six names start with different letters, so the first letter is
+// their perfect hash and one compare is left
+inline int chinScreen_align_index(const char* name) {
+    if (!name) return -1;
+    int i;
+    switch (chinScreen_lower(*name)) {
+        case 't': i = 0; break;
+        case 'm': i = 1; break;
+        case 'b': i = 2; break;
+        case 'l': i = 3; break;
+        case 'c': i = 4; break;
+        case 'r': i = 5; break;
+        default: return -1;
+    }
+    const char* known = chinScreen_align_names[i];
+    while (*name && chinScreen_lower(*name) == *known) {
+        name++;
+        known++;
+    }
+    return *name == *known ? i : -1;
+}
+
+/////////////////////////////////////////////////////////////
+// Function: Alignment of a vertical and horizontal name,
+// LV_ALIGN_CENTER if either is unknown
+/////////////////////////////////////////////////////////////
+inline lv_align_t chinScreen_resolve_align(const char* vAlign, const char* hAlign) {
+    int v = chinScreen_align_index(vAlign);
+    int h = chinScreen_align_index(hAlign);
+    if (v < 0 || v > 2 || h < 3) return LV_ALIGN_CENTER;
+    return chinScreen_aligns[v][h - 3];
+}
+
+CHINSCREEN_CONSTEVAL int chinScreen_align_vertical(const char* vAlign) {
+    return chinScreen_find_name(chinScreen_align_names, 3, vAlign);
+}
+
+CHINSCREEN_CONSTEVAL int chinScreen_align_horizontal(const char* hAlign) {
+    return chinScreen_find_name(chinScreen_align_names + 3, 3, hAlign);
+}
+
+#define CHINSCREEN_ALIGN(vAlign, hAlign) \
+    (chinScreen_aligns[chinScreen_constant<int, chinScreen_align_vertical(vAlign)>::value] \
+                      [chinScreen_constant<int, chinScreen_align_horizontal(hAlign)>::value])
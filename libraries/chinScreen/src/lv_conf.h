@@ -143,19 +143,30 @@
  *If only the built-in image formats are used there is no real advantage of caching. (I.e. if no new image decoder is added)
  *With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
  *However the opened images might consume additional RAM.
- *0: to disable caching*/
-#define LV_IMG_CACHE_DEF_SIZE 0
+ *0: to disable caching
+ *Otherwise the most images kept open at once; LV_IMG_CACHE_DEF_BYTES limits their memory*/
+#define LV_IMG_CACHE_DEF_SIZE 32
+
+/*Bytes of decoded images kept in the cache. A 192x192 PNG icon takes 108 kB (RGB565 + alpha),
+ *so this holds a screen of 20 of them. On the board they live in PSRAM*/
+#define LV_IMG_CACHE_DEF_BYTES (2 * 1024 * 1024)
+#ifdef ESP_PLATFORM
+    #define LV_IMG_CACHE_ALLOC_INCLUDE <esp_heap_caps.h>
+    #define LV_IMG_CACHE_ALLOC(size) heap_caps_malloc_prefer(size, 2, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT, MALLOC_CAP_8BIT)
+    #define LV_IMG_CACHE_FREE(p)     heap_caps_free(p)
+#endif
 
 /*Number of stops allowed per gradient. Increase this to allow more stops.
- *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
-#define LV_GRADIENT_MAX_STOPS 2
+ *This adds (sizeof(lv_color_t) + 1) bytes per additional stop
+ *chinScreen_background_multi_gradient() draws up to this many stops with one object*/
+#define LV_GRADIENT_MAX_STOPS 8
 
 /*Default gradient buffer size.
  *When LVGL calculates the gradient "maps" it can save them into a cache to avoid calculating them again.
  *LV_GRAD_CACHE_DEF_SIZE sets the size of this cache in bytes.
  *If the cache is too small the map will be allocated only while it's required for the drawing.
  *0 mean no caching.*/
-#define LV_GRAD_CACHE_DEF_SIZE 0
+#define LV_GRAD_CACHE_DEF_SIZE (4 * 1024)    /*A few full screen (480 px) color maps*/
 
 /*Allow dithering the gradients (to achieve visual smooth color gradients on limited color depth display)
  *LV_DITHER_GRADIENT implies allocating one or two more lines of the object's rendering surface
@@ -172,6 +183,25 @@
  *Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (10*1024)
 
+/*Blend RGB565 with kernels working on 32 bit words instead of lv_color_mix() on every pixel.
+ *They give the same pixels. lv_draw_sw_blend_set_kernels() can replace them at run time*/
+#define LV_USE_DRAW_SW_BLEND_565 1
+#if LV_USE_DRAW_SW_BLEND_565
+    /*Blend 8 pixels at once with 128 bit vectors if the compiler targets SSE2 or NEON (the host build)*/
+    #define LV_DRAW_SW_BLEND_565_SIMD 1
+#endif
+
+/*Zoom 2x, 3x... by repeating pixels and 1/2x, 1/3x... by averaging blocks instead of interpolating:
+ *sharp pixel-art icons and sprites, and a lot less work per frame*/
+#define LV_DRAW_SW_TRANSFORM_INT_ZOOM 1
+
+/*Bytes of icons zoomed once by chinScreen_icon(..., prescaled = true), in PSRAM on the board*/
+#define LV_DRAW_SW_ZOOM_CACHE_DEF_BYTES (512 * 1024)
+
+/*Bytes of glyphs kept ready to draw, shared by every font: a few hundred letters of the labels
+ *redrawn all the time, in PSRAM on the board*/
+#define LV_DRAW_SW_GLYPH_CACHE_DEF_BYTES (128 * 1024)
+
 /*-------------
  * GPU
  *-----------*/
@@ -225,6 +255,29 @@
     #define LV_GPU_SDL_CUSTOM_BLEND_MODE (SDL_VERSION_ATLEAST(2, 0, 6))
 #endif
 
+/*-------------
+ * Threads
+ *-----------*/
+
+/*The OS giving threads to LVGL: FreeRTOS tasks on the board, pthreads on the host (bench, simulator)*/
+#ifdef ESP_PLATFORM
+    #define LV_USE_OS LV_OS_FREERTOS
+#else
+    #define LV_USE_OS LV_OS_PTHREAD
+#endif
+
+/*Draw the big rectangles, images, arcs and lines in horizontal tiles, shared with worker threads.
+ *The S3 has two cores and the LVGL task keeps one of them, so one worker uses the other.
+ *bsp_display_start() pins the LVGL task to the core it's called on, and lvgl_port_init()
+ *pins the worker to the other one (LV_DRAW_SW_TILE_CORE is only used when the LVGL task isn't pinned)*/
+#define LV_USE_DRAW_SW_TILES 1
+#if LV_USE_DRAW_SW_TILES
+    #define LV_DRAW_SW_TILE_WORKERS 1
+    #define LV_DRAW_SW_TILE_MIN_PX (8 * 1024)   /*Fewer pixels are drawn on the LVGL task alone*/
+    #define LV_DRAW_SW_TILE_CORE -1
+    #define LV_DRAW_SW_TILE_STACK (4 * 1024)    /*Bytes, like the LVGL task's default stack*/
+#endif
+
 /*-------------
  * Logging
  *-----------*/
@@ -552,6 +605,8 @@
 
 #define LV_USE_MSGBOX     1
 
+#define LV_USE_NUMLABEL   1
+
 #define LV_USE_SPAN       1
 #if LV_USE_SPAN
     /*A line text can contain maximum num of span descriptor */
@@ -651,10 +706,39 @@
 
 /*GIF decoder library*/
 #define LV_USE_GIF 1
+#if LV_USE_GIF
+    /*Bytes of pre-decoded GIF frames (chinScreen_icon(..., true)), in PSRAM like the image cache.
+     *A 64x64 icon with alpha takes 12 kB a frame, about 450 kB for wifi-1*/
+    #define LV_GIF_ATLAS_DEF_BYTES (2 * 1024 * 1024)
+#endif
+
+/*MJPEG (AVI) video player for chinScreen_video_*(), decodes with the JPG library above*/
+#define LV_USE_MJPEG 1
+#if LV_USE_MJPEG
+    /*Bytes read from the SD card at once, in PSRAM like the image cache. Larger than a frame, so
+     *one read usually serves several of them. It grows to fit a frame that is larger*/
+    #define LV_MJPEG_READ_AHEAD (32 * 1024)
+    #define LV_MJPEG_TIME_INCLUDE <esp_timer.h>
+    #define LV_MJPEG_TIME_US_EXPR ((uint32_t)esp_timer_get_time())
+#endif
 
 /*QR code library*/
 #define LV_USE_QRCODE 0
 
+/*TrueType fonts drawn at run time, chinScreen_font_load() with CHINSCREEN_ENABLE_GFONTS*/
+#define LV_USE_TINY_TTF 1
+#if LV_USE_TINY_TTF
+    #define LV_TINY_TTF_FILE_SUPPORT 1
+    /*Rasterised glyphs of every font and size, in PSRAM like the image cache. A 24 px glyph takes
+     *about 350 bytes, so this holds some 700 of them*/
+    #define LV_TINY_TTF_CACHE_DEF_BYTES (256 * 1024)
+    /*Font files stay on the SD card, 8 pages of 4 kB of each one are kept in PSRAM*/
+    #define LV_TINY_TTF_PAGE_SIZE 4096
+    #define LV_TINY_TTF_PAGE_CNT 8
+    #define LV_TINY_TTF_TIME_INCLUDE <esp_timer.h>
+    #define LV_TINY_TTF_TIME_US_EXPR ((uint32_t)esp_timer_get_time())
+#endif
+
 /*FreeType library*/
 #define LV_USE_FREETYPE 0
 #if LV_USE_FREETYPE
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <inttypes.h>
 #include "esp_system.h"
 #include "esp_log.h"
 #include "esp_err.h"
@@ -12,11 +13,15 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
+#include "freertos/queue.h"
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_lcd_panel_interface.h"
 
 #include "lv_port.h"
+#include "lv_port_area.h"
+#include "lv_port_mem.h"
+#include "lv_port_perf.h"
 #include "includes/lvgl-8.3.11/src/lvgl.h"
 
 #ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
@@ -29,6 +34,9 @@
 #define LVGL_PORT_HANDLE_FLUSH_READY 1
 #endif
 
+/* Longest time the LVGL task blocks in one wait for an asynchronous flush, before checking again */
+#define LVGL_PORT_FLUSH_WAIT_MS 20
+
 static const char *TAG = "LVGL";
 
 /*******************************************************************************
@@ -39,9 +47,17 @@ typedef struct lvgl_port_ctx_s {
     SemaphoreHandle_t   lvgl_mux;
     esp_timer_handle_t  tick_timer;
     bool                running;
+    bool                timers_stopped;     /* By lvgl_port_stop() */
     int                 task_max_sleep_ms;
+    int                 task_priority;
+    int                 task_affinity;
 } lvgl_port_ctx_t;
 
+typedef struct {
+    lv_area_t                 area;         /* Area rendered by LVGL */
+    lv_color_t                *color_map;   /* LVGL draw buffer holding the area */
+} lvgl_port_flush_job_t;
+
 typedef struct {
     esp_lcd_panel_io_handle_t io_handle;    /* LCD panel IO handle */
     esp_lcd_panel_handle_t    panel_handle; /* LCD panel handle */
@@ -54,7 +70,16 @@ typedef struct {
     SemaphoreHandle_t         trans_done_sem;   /* Semaphore for signaling idle transfer */
     lv_disp_rot_t             sw_rotate;        /* Panel software rotation mask */
 
+    QueueHandle_t             flush_queue;      /* Areas waiting for the flush task (async flush only) */
+    TaskHandle_t              flush_task;       /* Task copying areas into the transport buffers (async flush only) */
+    SemaphoreHandle_t         flush_wait_sem;   /* Given when LVGL's draw buffer is released (async flush only) */
+    volatile bool             flush_ready_on_done; /* Call lv_disp_flush_ready() when the queued color transfer is done */
+
     lvgl_port_wait_cb         draw_wait_cb;     /* Callback function for drawing */
+    lvgl_port_area_wait_cb    draw_area_wait_cb; /* Callback function before every transfer */
+
+    int64_t                   render_start_us;  /* When LVGL started rendering the current frame */
+    uint32_t                  render_blocked_us; /* Time of the current frame LVGL spent in flush_cb and wait_cb */
 } lvgl_port_display_ctx_t;
 
 #ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
@@ -83,6 +108,12 @@ static void lvgl_port_task_deinit(void);
 static bool lvgl_port_flush_ready_callback(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx);
 #endif
 static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map);
+static void lvgl_port_rounder_callback(lv_disp_drv_t *drv, lv_area_t *area);
+static void lvgl_port_flush_wait_callback(lv_disp_drv_t *drv);
+static void lvgl_port_render_start_callback(lv_disp_drv_t *drv);
+static void lvgl_port_monitor_callback(lv_disp_drv_t *drv, uint32_t time, uint32_t px);
+static void lvgl_port_flush_task(void *arg);
+static void lvgl_port_flush_area(lvgl_port_display_ctx_t *disp_ctx, lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map, bool async);
 #ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
 static void lvgl_port_touchpad_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data);
 #endif
@@ -97,14 +128,23 @@ esp_err_t lvgl_port_init(const lvgl_port_cfg_t *cfg)
     ESP_GOTO_ON_FALSE(cfg->task_affinity < (configNUM_CORES), ESP_ERR_INVALID_ARG, err, TAG, "Bad core number for task! Maximum core number is %d", (configNUM_CORES - 1));
 
     memset(&lvgl_port_ctx, 0, sizeof(lvgl_port_ctx));
+    lvgl_port_perf_reset();
 
     /* LVGL init */
     lv_init();
+#if LV_USE_DRAW_SW_TILES && (configNUM_CORES > 1)
+    /* The tile workers draw on the core the LVGL task doesn't use */
+    if (cfg->task_affinity >= 0) {
+        lv_draw_sw_tiles_set_workers(LV_DRAW_SW_TILE_WORKERS, cfg->task_affinity == 0 ? 1 : 0);
+    }
+#endif
     /* Tick init */
     lvgl_port_timer_period_ms = cfg->timer_period_ms;
     ESP_RETURN_ON_ERROR(lvgl_port_tick_init(), TAG, "");
     /* Create task */
     lvgl_port_ctx.task_max_sleep_ms = cfg->task_max_sleep_ms;
+    lvgl_port_ctx.task_priority = cfg->task_priority;
+    lvgl_port_ctx.task_affinity = cfg->task_affinity;
     if (lvgl_port_ctx.task_max_sleep_ms == 0) {
         lvgl_port_ctx.task_max_sleep_ms = 500;
     }
@@ -133,6 +173,7 @@ esp_err_t lvgl_port_resume(void)
 
     if (lvgl_port_ctx.tick_timer != NULL) {
         lv_timer_enable(true);
+        lvgl_port_ctx.timers_stopped = false;
         ret = esp_timer_start_periodic(lvgl_port_ctx.tick_timer, lvgl_port_timer_period_ms * 1000);
     }
 
@@ -145,6 +186,7 @@ esp_err_t lvgl_port_stop(void)
 
     if (lvgl_port_ctx.tick_timer != NULL) {
         lv_timer_enable(false);
+        lvgl_port_ctx.timers_stopped = true;
         ret = esp_timer_stop(lvgl_port_ctx.tick_timer);
     }
 
@@ -176,8 +218,11 @@ lv_disp_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg)
     lv_disp_t *disp = NULL;
     lv_color_t *buf1 = NULL;
     lv_color_t *buf2 = NULL;
-    lv_color_t *buf3 = NULL;
+    lv_color_t *trans_buf_1 = NULL;
+    lv_color_t *trans_buf_2 = NULL;
     SemaphoreHandle_t trans_done_sem = NULL;
+    SemaphoreHandle_t flush_wait_sem = NULL;
+    QueueHandle_t flush_queue = NULL;
 
     assert(disp_cfg != NULL);
     assert(disp_cfg->io_handle != NULL);
@@ -186,49 +231,96 @@ lv_disp_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg)
     assert(disp_cfg->hres > 0);
     assert(disp_cfg->vres > 0);
 
+    /* Check the configuration and report what it costs before allocating anything */
+    lvgl_port_mem_plan_t plan;
+    const lvgl_port_mem_cfg_t plan_cfg = {
+        .hres = disp_cfg->hres,
+        .vres = disp_cfg->vres,
+        .bytes_per_pixel = sizeof(lv_color_t),
+        .buffer_size = disp_cfg->buffer_size,
+        .double_buffer = disp_cfg->double_buffer,
+        .buff_caps = disp_cfg->flags.buff_dma ? LVGL_PORT_MEM_DMA :
+        disp_cfg->flags.buff_spiram ? LVGL_PORT_MEM_PSRAM : LVGL_PORT_MEM_INTERNAL,
+        .trans_size = disp_cfg->trans_size,
+        .sw_rotate = disp_cfg->sw_rotate,
+        .full_refresh = disp_cfg->flags.full_refresh,
+    };
+    lvgl_port_display_ctx_t *disp_ctx = NULL;
+    ESP_GOTO_ON_FALSE(lvgl_port_mem_plan(&plan_cfg, &plan), ESP_ERR_INVALID_ARG, err, TAG, "Invalid display configuration: %s", plan.error);
+    ESP_LOGI(TAG, "Display buffers: %"PRIu32" B internal (%"PRIu32" B DMA), %"PRIu32" B PSRAM", plan.internal_bytes, plan.dma_bytes, plan.psram_bytes);
+    ESP_LOGI(TAG, "Up to %"PRIu32" B in %"PRIu32" transfer(s) per flush, %"PRIu32" flush(es) per full screen",
+             plan.bytes_per_flush, plan.chunks_per_flush, plan.flushes_per_frame);
+
     /* Display context */
-    lvgl_port_display_ctx_t *disp_ctx = malloc(sizeof(lvgl_port_display_ctx_t));
+    disp_ctx = calloc(1, sizeof(lvgl_port_display_ctx_t));
     ESP_GOTO_ON_FALSE(disp_ctx, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for display context allocation!");
     disp_ctx->io_handle = disp_cfg->io_handle;
     disp_ctx->panel_handle = disp_cfg->panel_handle;
     disp_ctx->trans_size = disp_cfg->trans_size;
     disp_ctx->sw_rotate = disp_cfg->sw_rotate;
     disp_ctx->draw_wait_cb = disp_cfg->draw_wait_cb;
+    disp_ctx->draw_area_wait_cb = disp_cfg->draw_area_wait_cb;
 
     uint32_t buff_caps = MALLOC_CAP_DEFAULT;
     if (disp_cfg->flags.buff_dma) {
         buff_caps = MALLOC_CAP_DMA;
     } else if (disp_cfg->flags.buff_spiram) {
         buff_caps = MALLOC_CAP_SPIRAM;
+    } else if (disp_cfg->flags.buff_internal) {
+        buff_caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
     }
 
     /* alloc draw buffers used by LVGL */
     /* it's recommended to choose the size of the draw buffer(s) to be at least 1/10 screen sized */
     buf1 = heap_caps_malloc(disp_cfg->buffer_size * sizeof(lv_color_t), buff_caps);
     ESP_GOTO_ON_FALSE(buf1, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (buf1) allocation!");
+    if (disp_cfg->double_buffer) {
+        /* LVGL renders the next dirty area into buf2 while buf1 is being flushed */
+        buf2 = heap_caps_malloc(disp_cfg->buffer_size * sizeof(lv_color_t), buff_caps);
+        ESP_GOTO_ON_FALSE(buf2, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (buf2) allocation!");
+    }
 
     if (disp_ctx->trans_size) {
 
         uint32_t caps = MALLOC_CAP_DMA;
 
-        buf2 = heap_caps_malloc(disp_ctx->trans_size * sizeof(lv_color_t), caps);
-        ESP_GOTO_ON_FALSE(buf2, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for buffer(transport) allocation!");
-        disp_ctx->trans_buf_1 = buf2;
+        trans_buf_1 = heap_caps_malloc(disp_ctx->trans_size * sizeof(lv_color_t), caps);
+        ESP_GOTO_ON_FALSE(trans_buf_1, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for buffer(transport) allocation!");
+        disp_ctx->trans_buf_1 = trans_buf_1;
 
-        buf3 = heap_caps_malloc(disp_ctx->trans_size * sizeof(lv_color_t), caps);
-        ESP_GOTO_ON_FALSE(buf3, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for buffer(transport) allocation!");
-        disp_ctx->trans_buf_2 = buf3;
+        trans_buf_2 = heap_caps_malloc(disp_ctx->trans_size * sizeof(lv_color_t), caps);
+        ESP_GOTO_ON_FALSE(trans_buf_2, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for buffer(transport) allocation!");
+        disp_ctx->trans_buf_2 = trans_buf_2;
 
         trans_done_sem = xSemaphoreCreateCounting(1, 0);
         ESP_GOTO_ON_FALSE(trans_done_sem, ESP_ERR_NO_MEM, err, TAG, "Failed to create transport counting Semaphore");
         disp_ctx->trans_done_sem = trans_done_sem;
     }
 
+#if LVGL_PORT_HANDLE_FLUSH_READY
+    if (disp_cfg->flags.async_flush) {
+        /* LVGL may render the next area while the flush task is still sending this one */
+        flush_wait_sem = xSemaphoreCreateBinary();
+        ESP_GOTO_ON_FALSE(flush_wait_sem, ESP_ERR_NO_MEM, err, TAG, "Failed to create flush wait Semaphore");
+        disp_ctx->flush_wait_sem = flush_wait_sem;
+
+        if (disp_ctx->trans_size) {
+            flush_queue = xQueueCreate(1, sizeof(lvgl_port_flush_job_t));
+            ESP_GOTO_ON_FALSE(flush_queue, ESP_ERR_NO_MEM, err, TAG, "Failed to create flush queue");
+            disp_ctx->flush_queue = flush_queue;
+        }
+    }
+#else
+    if (disp_cfg->flags.async_flush) {
+        ESP_LOGW(TAG, "Asynchronous flush needs the color transfer done event, flushing synchronously");
+    }
+#endif
+
     lv_disp_draw_buf_t *disp_buf = malloc(sizeof(lv_disp_draw_buf_t));
     ESP_GOTO_ON_FALSE(disp_buf, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL display buffer allocation!");
 
     /* initialize LVGL draw buffers */
-    lv_disp_draw_buf_init(disp_buf, buf1, NULL, disp_cfg->buffer_size);
+    lv_disp_draw_buf_init(disp_buf, buf1, buf2, disp_cfg->buffer_size);
 
     ESP_LOGD(TAG, "Register display driver to LVGL");
     lv_disp_drv_init(&disp_ctx->disp_drv);
@@ -238,8 +330,16 @@ lv_disp_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg)
 
     disp_ctx->disp_drv.draw_buf = disp_buf;
     disp_ctx->disp_drv.user_data = disp_ctx;
-    /* Force full_fresh */
-    disp_ctx->disp_drv.full_refresh = 1;
+    disp_ctx->disp_drv.full_refresh = disp_cfg->flags.full_refresh;
+    if (!disp_cfg->flags.full_refresh) {
+        /* Only the invalidated areas are rendered and sent, widened to what the panel can take */
+        disp_ctx->disp_drv.rounder_cb = lvgl_port_rounder_callback;
+    }
+    if (disp_ctx->flush_wait_sem) {
+        disp_ctx->disp_drv.wait_cb = lvgl_port_flush_wait_callback;
+    }
+    disp_ctx->disp_drv.render_start_cb = lvgl_port_render_start_callback;
+    disp_ctx->disp_drv.monitor_cb = lvgl_port_monitor_callback;
 
 #if LVGL_PORT_HANDLE_FLUSH_READY
     /* Register done callback */
@@ -249,6 +349,17 @@ lv_disp_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg)
     esp_lcd_panel_io_register_event_callbacks(disp_ctx->io_handle, &cbs, &disp_ctx->disp_drv);
 #endif
 
+    if (disp_ctx->flush_queue) {
+        /* The flush task feeds the panel IO, so it runs above the LVGL task to keep the bus busy */
+        BaseType_t res;
+        if (lvgl_port_ctx.task_affinity < 0) {
+            res = xTaskCreate(lvgl_port_flush_task, "LVGL flush", 3072, disp_ctx, lvgl_port_ctx.task_priority + 1, &disp_ctx->flush_task);
+        } else {
+            res = xTaskCreatePinnedToCore(lvgl_port_flush_task, "LVGL flush", 3072, disp_ctx, lvgl_port_ctx.task_priority + 1, &disp_ctx->flush_task, lvgl_port_ctx.task_affinity);
+        }
+        ESP_GOTO_ON_FALSE(res == pdPASS, ESP_FAIL, err, TAG, "Create LVGL flush task fail!");
+    }
+
     disp = lv_disp_drv_register(&disp_ctx->disp_drv);
 
 err:
@@ -259,12 +370,21 @@ err:
         if (buf2) {
             free(buf2);
         }
-        if (buf3) {
-            free(buf3);
+        if (trans_buf_1) {
+            free(trans_buf_1);
+        }
+        if (trans_buf_2) {
+            free(trans_buf_2);
         }
         if (trans_done_sem) {
             vSemaphoreDelete(trans_done_sem);
         }
+        if (flush_wait_sem) {
+            vSemaphoreDelete(flush_wait_sem);
+        }
+        if (flush_queue) {
+            vQueueDelete(flush_queue);
+        }
         if (disp_ctx) {
             free(disp_ctx);
         }
@@ -282,6 +402,16 @@ esp_err_t lvgl_port_remove_disp(lv_disp_t *disp)
 
     lv_disp_remove(disp);
 
+    if (disp_ctx->flush_task) {
+        vTaskDelete(disp_ctx->flush_task);
+    }
+    if (disp_ctx->flush_queue) {
+        vQueueDelete(disp_ctx->flush_queue);
+    }
+    if (disp_ctx->flush_wait_sem) {
+        vSemaphoreDelete(disp_ctx->flush_wait_sem);
+    }
+
     if (disp_drv) {
         if (disp_drv->draw_buf && disp_drv->draw_buf->buf1) {
             free(disp_drv->draw_buf->buf1);
@@ -350,7 +480,13 @@ bool lvgl_port_lock(uint32_t timeout_ms)
     assert(lvgl_port_ctx.lvgl_mux && "lvgl_port_init must be called first");
 
     const TickType_t timeout_ticks = (timeout_ms == 0) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
-    return xSemaphoreTakeRecursive(lvgl_port_ctx.lvgl_mux, timeout_ticks) == pdTRUE;
+    const int64_t start_us = esp_timer_get_time();
+    if (xSemaphoreTakeRecursive(lvgl_port_ctx.lvgl_mux, timeout_ticks) != pdTRUE) {
+        return false;
+    }
+    /* Recorded with the mutex held, so only one task writes this metric at a time */
+    lvgl_port_perf_record(LVGL_PORT_PERF_LOCK_WAIT_US, (uint32_t)(esp_timer_get_time() - start_us));
+    return true;
 }
 
 void lvgl_port_unlock(void)
@@ -381,11 +517,13 @@ static void lvgl_port_task(void *arg)
             task_delay_ms = lv_timer_handler();
             lvgl_port_unlock();
         }
-        if ((task_delay_ms > lvgl_port_ctx.task_max_sleep_ms) || (1 == task_delay_ms)) {
+        /* lv_timer_handler() returns 1 while stopped, but also for a timer due in 1 ms */
+        if ((task_delay_ms > lvgl_port_ctx.task_max_sleep_ms) || (1 == task_delay_ms && lvgl_port_ctx.timers_stopped)) {
             task_delay_ms = lvgl_port_ctx.task_max_sleep_ms;
         } else if (task_delay_ms < 1) {
             task_delay_ms = 1;
         }
+        lvgl_port_perf_record(LVGL_PORT_PERF_SLEEP_MS, task_delay_ms);
         vTaskDelay(pdMS_TO_TICKS(task_delay_ms));
     }
 
@@ -421,7 +559,14 @@ static bool lvgl_port_flush_ready_callback(esp_lcd_panel_io_handle_t panel_io, e
         xSemaphoreGiveFromISR(disp_ctx->trans_done_sem, &taskAwake);
     }
 
-    return false;
+    /* Asynchronous flush straight from the draw buffer is out, LVGL may reuse it */
+    if (disp_ctx->flush_ready_on_done) {
+        disp_ctx->flush_ready_on_done = false;
+        lv_disp_flush_ready(disp_drv);
+        xSemaphoreGiveFromISR(disp_ctx->flush_wait_sem, &taskAwake);
+    }
+
+    return (taskAwake == pdTRUE);
 }
 #endif
 
@@ -430,7 +575,80 @@ static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area,
     assert(drv != NULL);
     lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)drv->user_data;
     assert(disp_ctx != NULL);
+    const int64_t start_us = esp_timer_get_time();
+
+    if (disp_ctx->flush_queue) {
+        /* Hand the area to the flush task; it calls lv_disp_flush_ready() once the last chunk is copied */
+        const lvgl_port_flush_job_t job = {
+            .area = *area,
+            .color_map = color_map,
+        };
+        xQueueSend(disp_ctx->flush_queue, &job, portMAX_DELAY);
+    } else {
+        const bool async = (disp_ctx->flush_wait_sem != NULL);
+        lvgl_port_flush_area(disp_ctx, drv, area, color_map, async);
+        if (!async) {
+            lv_disp_flush_ready(drv);
+        }
+    }
+    disp_ctx->render_blocked_us += (uint32_t)(esp_timer_get_time() - start_us);
+}
+
+static void lvgl_port_flush_wait_callback(lv_disp_drv_t *drv)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)drv->user_data;
+    assert(disp_ctx != NULL);
+
+    /* Block instead of spinning, so the flush task gets the CPU while LVGL waits for its draw buffer */
+    const int64_t start_us = esp_timer_get_time();
+    xSemaphoreTake(disp_ctx->flush_wait_sem, pdMS_TO_TICKS(LVGL_PORT_FLUSH_WAIT_MS));
+    disp_ctx->render_blocked_us += (uint32_t)(esp_timer_get_time() - start_us);
+}
+
+static void lvgl_port_render_start_callback(lv_disp_drv_t *drv)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)drv->user_data;
+    assert(disp_ctx != NULL);
+
+    disp_ctx->render_start_us = esp_timer_get_time();
+    disp_ctx->render_blocked_us = 0;
+}
+
+static void lvgl_port_monitor_callback(lv_disp_drv_t *drv, uint32_t time, uint32_t px)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)drv->user_data;
+    assert(disp_ctx != NULL);
+
+    /* End of a refresh: everything but flushing and waiting for a free draw buffer was rendering */
+    const int64_t elapsed_us = esp_timer_get_time() - disp_ctx->render_start_us;
+    const int64_t render_us = elapsed_us - disp_ctx->render_blocked_us;
+    lvgl_port_perf_record(LVGL_PORT_PERF_RENDER_US, render_us > 0 ? (uint32_t)render_us : 0);
 
+    const lv_refr_stat_t *stat = lv_refr_get_stat();
+    lvgl_port_perf_record(LVGL_PORT_PERF_AREAS, stat->area_num);
+    lvgl_port_perf_record(LVGL_PORT_PERF_PIXELS, px);
+}
+
+static void lvgl_port_flush_task(void *arg)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)arg;
+    assert(disp_ctx != NULL);
+    lvgl_port_flush_job_t job;
+
+    /* Both transport buffers are idle; from here on trans_done_sem tracks the chunk on the bus across areas */
+    if (disp_ctx->trans_done_sem) {
+        xSemaphoreGive(disp_ctx->trans_done_sem);
+    }
+
+    while (true) {
+        if (xQueueReceive(disp_ctx->flush_queue, &job, portMAX_DELAY) == pdTRUE) {
+            lvgl_port_flush_area(disp_ctx, &disp_ctx->disp_drv, &job.area, job.color_map, true);
+        }
+    }
+}
+
+static void lvgl_port_flush_area(lvgl_port_display_ctx_t *disp_ctx, lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map, bool async)
+{
     const int x_start = area->x1;
     const int x_end = area->x2;
     const int y_start = area->y1;
@@ -441,6 +659,11 @@ static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area,
     lv_color_t *from = color_map;
     lv_color_t *to = NULL;
 
+    /* Read before lv_disp_flush_ready() lets LVGL move on to the next area */
+    const bool last_area = lv_disp_flush_is_last(drv);
+    const int64_t flush_start_us = esp_timer_get_time();
+    int64_t wait_start_us;
+
     if (disp_ctx->trans_size) {
         assert(disp_ctx->trans_buf_1 != NULL);
 
@@ -450,7 +673,9 @@ static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area,
         int y_draw_end = 0;
         int trans_count = 0;
 
-        disp_ctx->trans_act = disp_ctx->trans_buf_1;
+        if (!async) {
+            disp_ctx->trans_act = disp_ctx->trans_buf_1;
+        }
         int rotate = disp_ctx->sw_rotate;
 
         int x_start_tmp = 0;
@@ -461,7 +686,6 @@ static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area,
         int y_start_tmp = 0;
         int y_end_tmp = 0;
         int max_height = 0;
-        int trans_height = 0;
 
         if (LV_DISP_ROT_270 == rotate || LV_DISP_ROT_90 == rotate) {
             max_width = ((disp_ctx->trans_size / height) > width) ? (width) : (disp_ctx->trans_size / height);
@@ -486,56 +710,44 @@ static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area,
                 trans_width = (x_end_tmp - x_start + 1) > max_width ? max_width : (x_end_tmp - x_start + 1);
                 x_start_tmp = (x_end_tmp - x_start + 1) > max_width ? (x_end_tmp - trans_width + 1) : x_start;
             } else if (LV_DISP_ROT_NONE == rotate) {
-                trans_height = (y_end - y_start_tmp + 1) > max_height ? max_height : (y_end - y_start_tmp + 1);
                 y_end_tmp = (y_end - y_start_tmp + 1) > max_height ? (y_start_tmp + max_height - 1) : y_end;
             } else {
-                trans_height = (y_end_tmp - y_start + 1) > max_height ? max_height : (y_end_tmp - y_start + 1);
                 y_start_tmp = (y_end_tmp - y_start + 1) > max_height ? (y_end_tmp - max_height + 1) : y_start;
             }
 
             disp_ctx->trans_act = (disp_ctx->trans_act == disp_ctx->trans_buf_1) ? (disp_ctx->trans_buf_2) : (disp_ctx->trans_buf_1);
             to = disp_ctx->trans_act;
 
+            lv_area_t chunk = *area;
+            if (LV_DISP_ROT_270 == rotate || LV_DISP_ROT_90 == rotate) {
+                chunk.x1 = x_start_tmp;
+                chunk.x2 = x_end_tmp;
+            } else {
+                chunk.y1 = y_start_tmp;
+                chunk.y2 = y_end_tmp;
+            }
+            lvgl_port_area_copy_chunk(to, from, area, &chunk, rotate);
+
             switch (rotate) {
             case LV_DISP_ROT_90:
-                for (int y = 0; y < height; y++) {
-                    for (int x = 0; x < trans_width; x++) {
-                        *(to + x * height + (height - y - 1)) = *(from + y * width + x_start_tmp + x);
-                    }
-                }
                 x_draw_start = drv->ver_res - y_end - 1;
                 x_draw_end = drv->ver_res - y_start - 1;
                 y_draw_start = x_start_tmp;
                 y_draw_end = x_end_tmp;
                 break;
             case LV_DISP_ROT_270:
-                for (int y = 0; y < height; y++) {
-                    for (int x = 0; x < trans_width; x++) {
-                        *(to + (trans_width - x - 1) * height + y) = *(from + y * width + x_start_tmp + x);
-                    }
-                }
                 x_draw_start = y_start;
                 x_draw_end = y_end;
                 y_draw_start = drv->hor_res - x_end_tmp - 1;
                 y_draw_end = drv->hor_res - x_start_tmp - 1;
                 break;
             case LV_DISP_ROT_180:
-                for (int y = 0; y < trans_height; y++) {
-                    for (int x = 0; x < width; x++) {
-                        *(to + (trans_height - y - 1)*width + (width - x - 1)) = *(from + y_start_tmp * width + y * (width) + x);
-                    }
-                }
                 x_draw_start = drv->hor_res - x_end - 1;
                 x_draw_end = drv->hor_res - x_start - 1;
                 y_draw_start = drv->ver_res - y_end_tmp - 1;
                 y_draw_end = drv->ver_res - y_start_tmp - 1;
                 break;
             case LV_DISP_ROT_NONE:
-                for (int y = 0; y < trans_height; y++) {
-                    for (int x = 0; x < width; x++) {
-                        *(to + y * (width) + x) = *(from + y_start_tmp * width + y * (width) + x);
-                    }
-                }
                 x_draw_start = x_start;
                 x_draw_end = x_end;
                 y_draw_start = y_start_tmp;
@@ -545,14 +757,30 @@ static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area,
                 break;
             }
 
+            /* The whole area is in the transport buffers, LVGL may render into this draw buffer again */
+            if (async && i == trans_count - 1) {
+                lv_disp_flush_ready(drv);
+                xSemaphoreGive(disp_ctx->flush_wait_sem);
+            }
+
             if (0 == i) {
                 if (disp_ctx->draw_wait_cb) {
+                    wait_start_us = esp_timer_get_time();
                     disp_ctx->draw_wait_cb(disp_ctx->panel_handle->user_data);
+                    lvgl_port_perf_add(LVGL_PORT_PERF_TE_WAIT_US, (uint32_t)(esp_timer_get_time() - wait_start_us));
+                }
+                if (!async) {
+                    xSemaphoreGive(disp_ctx->trans_done_sem);
                 }
-                xSemaphoreGive(disp_ctx->trans_done_sem);
             }
 
             xSemaphoreTake(disp_ctx->trans_done_sem, portMAX_DELAY);
+            if (disp_ctx->draw_area_wait_cb) {
+                wait_start_us = esp_timer_get_time();
+                disp_ctx->draw_area_wait_cb(disp_ctx->panel_handle->user_data, x_draw_start, y_draw_start, x_draw_end, y_draw_end);
+                lvgl_port_perf_add(LVGL_PORT_PERF_TE_WAIT_US, (uint32_t)(esp_timer_get_time() - wait_start_us));
+            }
+            lvgl_port_perf_add(LVGL_PORT_PERF_TX_BYTES, (x_draw_end - x_draw_start + 1) * (y_draw_end - y_draw_start + 1) * sizeof(lv_color_t));
             esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, x_draw_start, y_draw_start, x_draw_end + 1, y_draw_end + 1, to);
 
             if (LV_DISP_ROT_90 == rotate) {
@@ -566,9 +794,31 @@ static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area,
             }
         }
     } else {
+        if (disp_ctx->draw_area_wait_cb) {
+            wait_start_us = esp_timer_get_time();
+            disp_ctx->draw_area_wait_cb(disp_ctx->panel_handle->user_data, x_start, y_start, x_end, y_end);
+            lvgl_port_perf_add(LVGL_PORT_PERF_TE_WAIT_US, (uint32_t)(esp_timer_get_time() - wait_start_us));
+        }
+        lvgl_port_perf_add(LVGL_PORT_PERF_TX_BYTES, width * height * sizeof(lv_color_t));
+        disp_ctx->flush_ready_on_done = async;
         esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, x_start, y_start, x_end + 1, y_end + 1, color_map);
     }
-    lv_disp_flush_ready(drv);
+
+    lvgl_port_perf_add(LVGL_PORT_PERF_FLUSH_US, (uint32_t)(esp_timer_get_time() - flush_start_us));
+    if (last_area) {
+        lvgl_port_perf_commit(LVGL_PORT_PERF_FLUSH_US);
+        lvgl_port_perf_commit(LVGL_PORT_PERF_TE_WAIT_US);
+        lvgl_port_perf_commit(LVGL_PORT_PERF_TX_BYTES);
+    }
+}
+
+static void lvgl_port_rounder_callback(lv_disp_drv_t *drv, lv_area_t *area)
+{
+    assert(drv != NULL);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)drv->user_data;
+    assert(disp_ctx != NULL);
+
+    lvgl_port_area_round(area, drv->hor_res, drv->ver_res, disp_ctx->sw_rotate);
 }
 
 #ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
@@ -23,6 +23,7 @@ extern "C" {
 #endif
 
 typedef bool (*lvgl_port_wait_cb)(void *handle);
+typedef bool (*lvgl_port_area_wait_cb)(void *handle, int x_start, int y_start, int x_end, int y_end);
 
 /**
  * @brief Init configuration structure
@@ -39,8 +40,10 @@ typedef struct {
     esp_lcd_panel_io_handle_t io_handle;    /*!< LCD panel IO handle */
     esp_lcd_panel_handle_t panel_handle;    /*!< LCD panel handle */
     lvgl_port_wait_cb draw_wait_cb;
+    lvgl_port_area_wait_cb draw_area_wait_cb;   /*!< Called before every transfer with the panel area it covers (end inclusive) */
 
     uint32_t    buffer_size;    /*!< Size of the buffer for the screen in pixels */
+    bool        double_buffer;  /*!< True, if should be allocated two buffers */
     uint32_t    trans_size;     /*!< Allocated buffer will be in SRAM to move framebuf */
     uint32_t    hres;           /*!< LCD display horizontal resolution */
     uint32_t    vres;           /*!< LCD display vertical resolution */
@@ -48,6 +51,9 @@ typedef struct {
     struct {
         unsigned int buff_dma: 1;    /*!< Allocated LVGL buffer will be DMA capable */
         unsigned int buff_spiram: 1; /*!< Allocated LVGL buffer will be in PSRAM */
+        unsigned int buff_internal: 1;/*!< Allocated LVGL buffer will be in internal RAM */
+        unsigned int full_refresh: 1;/*!< Always redraw and send the whole screen (buffer_size must be hres * vres) */
+        unsigned int async_flush: 1; /*!< Send areas from a flush task, so LVGL renders the next area meanwhile (use with double_buffer) */
     } flags;
 } lvgl_port_display_cfg_t;
 
@@ -0,0 +1,28 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "lv_port_area.h"
+#include "lv_port_rotate.h"
+
+void lvgl_port_area_round(lv_area_t *area, lv_coord_t hor_res, lv_coord_t ver_res, lv_disp_rot_t sw_rotate)
+{
+    if (LV_DISP_ROT_90 == sw_rotate || LV_DISP_ROT_270 == sw_rotate) {
+        area->y1 = 0;
+        area->y2 = ver_res - 1;
+    } else {
+        area->x1 = 0;
+        area->x2 = hor_res - 1;
+    }
+}
+
+void lvgl_port_area_copy_chunk(lv_color_t *to, const lv_color_t *color_map, const lv_area_t *area,
+                               const lv_area_t *chunk, lv_disp_rot_t sw_rotate)
+{
+    const int stride = lv_area_get_width(area);
+    const int w = lv_area_get_width(chunk);
+    const int h = lv_area_get_height(chunk);
+    const lv_color_t *from = color_map + (chunk->y1 - area->y1) * stride + (chunk->x1 - area->x1);
+
+    lvgl_port_rotate_copy(to, from, w, h, stride, sw_rotate);
+}
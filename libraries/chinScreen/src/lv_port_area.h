@@ -0,0 +1,50 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Area helpers of the LVGL port
+ */
+
+#pragma once
+
+#include "includes/lvgl-8.3.11/src/lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Round an invalidated area to something the AXS15231B can receive
+ *
+ * In QSPI mode the panel keeps a single write pointer: RAMWR restarts it and RAMWRC
+ * continues from wherever the previous write stopped. Only areas that span whole panel
+ * rows can be streamed that way, so the area is widened to full panel rows. With a 90/270
+ * software rotation a panel row is an LVGL column, so the y axis is widened instead.
+ *
+ * @param[in,out] area      Area in LVGL (rotated) coordinates
+ * @param[in]     hor_res   LVGL horizontal resolution
+ * @param[in]     ver_res   LVGL vertical resolution
+ * @param[in]     sw_rotate Software rotation applied in the flush callback
+ */
+void lvgl_port_area_round(lv_area_t *area, lv_coord_t hor_res, lv_coord_t ver_res, lv_disp_rot_t sw_rotate);
+
+/**
+ * @brief Copy one transport chunk of a flushed area into a transport buffer, rotated
+ *
+ * The draw buffer holds only the flushed area, so the chunk is located relative to the
+ * area's top left corner, not in panel coordinates.
+ *
+ * @param[out] to        Transport buffer, at least as many pixels as the chunk
+ * @param[in]  color_map Draw buffer LVGL passed to the flush callback
+ * @param[in]  area      Flushed area in LVGL (rotated) coordinates
+ * @param[in]  chunk     Part of the area to copy: whole rows for 0/180, whole columns for 90/270
+ * @param[in]  sw_rotate Software rotation applied in the flush callback
+ */
+void lvgl_port_area_copy_chunk(lv_color_t *to, const lv_color_t *color_map, const lv_area_t *area,
+                               const lv_area_t *chunk, lv_disp_rot_t sw_rotate);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,95 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include "lv_port_fb.h"
+
+void lvgl_port_fb_init(lvgl_port_fb_t *fb, uint16_t *pixels, int hres, int vres)
+{
+    memset(fb, 0, sizeof(lvgl_port_fb_t));
+    fb->pixels = pixels;
+    fb->hres = hres;
+    fb->vres = vres;
+    fb->col_end = hres - 1;
+    fb->row_end = vres - 1;
+    memset(pixels, 0, (size_t)hres * vres * sizeof(uint16_t));
+}
+
+static void fb_window(const uint8_t *p, int limit, int *start, int *end)
+{
+    int s = (p[0] << 8) | p[1];
+    int e = (p[2] << 8) | p[3];
+    if (e >= limit) {
+        e = limit - 1;
+    }
+    if (s > e) {
+        s = e;
+    }
+    *start = s;
+    *end = e;
+}
+
+void lvgl_port_fb_tx_param(lvgl_port_fb_t *fb, int cmd, const void *param, size_t param_size)
+{
+    switch (cmd) {
+    case LVGL_PORT_FB_CMD_CASET:
+        if (param_size >= 4) {
+            fb_window(param, fb->hres, &fb->col_start, &fb->col_end);
+            fb->stats.caset++;
+        }
+        break;
+    case LVGL_PORT_FB_CMD_RASET:
+        if (param_size >= 4) {
+            fb_window(param, fb->vres, &fb->row_start, &fb->row_end);
+            fb->stats.raset++;
+        }
+        break;
+    case LVGL_PORT_FB_CMD_DISPON:
+        fb->display_on = true;
+        break;
+    case LVGL_PORT_FB_CMD_DISPOFF:
+        fb->display_on = false;
+        break;
+    case LVGL_PORT_FB_CMD_INVON:
+        fb->inverted = true;
+        break;
+    case LVGL_PORT_FB_CMD_INVOFF:
+        fb->inverted = false;
+        break;
+    default:
+        fb->stats.unknown++;
+        break;
+    }
+}
+
+void lvgl_port_fb_tx_color(lvgl_port_fb_t *fb, int cmd, const void *color, size_t color_size)
+{
+    if (cmd == LVGL_PORT_FB_CMD_RAMWR) {
+        fb->x = fb->col_start;
+        fb->y = fb->row_start;
+        fb->stats.ramwr++;
+    } else if (cmd == LVGL_PORT_FB_CMD_RAMWRC) {
+        fb->stats.ramwrc++;
+    } else {
+        fb->stats.unknown++;
+        return;
+    }
+
+    const uint8_t *p = color;
+    for (size_t i = 0; i + 1 < color_size; i += 2) {
+        if (fb->x < fb->col_start || fb->x > fb->col_end) {
+            /* The window moved under the pointer, the controller restarts the row */
+            fb->x = fb->col_start;
+        }
+        fb->pixels[fb->y * fb->hres + fb->x] = (uint16_t)((p[i] << 8) | p[i + 1]);
+        if (++fb->x > fb->col_end) {
+            fb->x = fb->col_start;
+            if (++fb->y > fb->row_end) {
+                fb->y = fb->row_start;
+            }
+        }
+    }
+    fb->stats.pixels += color_size / 2;
+}
@@ -0,0 +1,83 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Headless panel: frame memory and memory write commands of an AXS15231B in RGB565
+ *
+ * Takes the commands the panel driver sends (CASET, RASET, RAMWR, RAMWRC, DISPON/OFF, INVON/OFF)
+ * and writes the pixels into an in-memory framebuffer like the controller would: RAMWR starts at
+ * the top left of the window, RAMWRC continues at the write pointer, the pointer wraps at the
+ * window edges. Used by the host backend and the tests.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LVGL_PORT_FB_CMD_DISPOFF    0x28
+#define LVGL_PORT_FB_CMD_DISPON     0x29
+#define LVGL_PORT_FB_CMD_INVOFF     0x20
+#define LVGL_PORT_FB_CMD_INVON      0x21
+#define LVGL_PORT_FB_CMD_CASET      0x2A
+#define LVGL_PORT_FB_CMD_RASET      0x2B
+#define LVGL_PORT_FB_CMD_RAMWR      0x2C
+#define LVGL_PORT_FB_CMD_RAMWRC     0x3C
+
+/**
+ * @brief Command counters
+ */
+typedef struct {
+    uint32_t caset;
+    uint32_t raset;
+    uint32_t ramwr;
+    uint32_t ramwrc;
+    uint32_t pixels;        /*!< Pixels written */
+    uint32_t unknown;       /*!< Commands the emulation ignored */
+} lvgl_port_fb_stats_t;
+
+/**
+ * @brief Panel state
+ */
+typedef struct {
+    uint16_t *pixels;       /*!< hres * vres RGB565 pixels, row major, native byte order */
+    int hres;
+    int vres;
+    int col_start;          /*!< CASET window, inclusive */
+    int col_end;
+    int row_start;          /*!< RASET window, inclusive */
+    int row_end;
+    int x;                  /*!< Write pointer */
+    int y;
+    bool display_on;
+    bool inverted;
+    lvgl_port_fb_stats_t stats;
+} lvgl_port_fb_t;
+
+/**
+ * @brief Reset the panel: whole screen window, pointer at 0,0, display off
+ *
+ * @param[in] pixels Framebuffer of hres * vres pixels, cleared to black
+ */
+void lvgl_port_fb_init(lvgl_port_fb_t *fb, uint16_t *pixels, int hres, int vres);
+
+/**
+ * @brief Command with parameters, like esp_lcd_panel_io_tx_param() (big endian window coordinates)
+ */
+void lvgl_port_fb_tx_param(lvgl_port_fb_t *fb, int cmd, const void *param, size_t param_size);
+
+/**
+ * @brief Memory write, like esp_lcd_panel_io_tx_color(); color holds big endian RGB565 as sent on the bus
+ */
+void lvgl_port_fb_tx_color(lvgl_port_fb_t *fb, int cmd, const void *color, size_t color_size);
+
+#ifdef __cplusplus
+}
+#endif
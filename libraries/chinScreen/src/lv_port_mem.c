@@ -0,0 +1,84 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include "lv_port_mem.h"
+
+#define MEM_DIV_ROUND_UP(a, b)  (((a) + (b) - 1) / (b))
+
+bool lvgl_port_mem_plan(const lvgl_port_mem_cfg_t *cfg, lvgl_port_mem_plan_t *plan)
+{
+    memset(plan, 0, sizeof(lvgl_port_mem_plan_t));
+
+    const uint32_t bpp = cfg->bytes_per_pixel;
+    const uint32_t frame_px = cfg->hres * cfg->vres;
+    const bool rotated = (cfg->sw_rotate == LV_DISP_ROT_90 || cfg->sw_rotate == LV_DISP_ROT_270);
+
+    /* Footprint */
+    plan->draw_bytes = cfg->buffer_size * bpp * (cfg->double_buffer ? 2 : 1);
+    plan->trans_bytes = cfg->trans_size * bpp * 2;
+    plan->internal_bytes = plan->trans_bytes;
+    plan->dma_bytes = plan->trans_bytes;
+    switch (cfg->buff_caps) {
+    case LVGL_PORT_MEM_DMA:
+        plan->dma_bytes += plan->draw_bytes;
+        plan->internal_bytes += plan->draw_bytes;
+        break;
+    case LVGL_PORT_MEM_INTERNAL:
+        plan->internal_bytes += plan->draw_bytes;
+        break;
+    case LVGL_PORT_MEM_PSRAM:
+    default:
+        plan->psram_bytes = plan->draw_bytes;
+        break;
+    }
+
+    if (!cfg->hres || !cfg->vres || !bpp) {
+        plan->error = "resolution not set";
+        return false;
+    }
+
+    /*
+     * Traffic. Partial refresh rounds areas to whole panel rows (lvgl_port_area_round()), so the
+     * largest flush is as many full rows as fit in a draw buffer. With a 90/270 degree rotation the
+     * panel rows are LVGL columns of full height, which LVGL can only render if a whole frame fits.
+     */
+    uint32_t flush_px;
+    if (cfg->full_refresh || rotated) {
+        flush_px = frame_px;
+    } else {
+        uint32_t rows = cfg->buffer_size / cfg->hres;
+        if (rows > cfg->vres) {
+            rows = cfg->vres;
+        }
+        flush_px = rows * cfg->hres;
+    }
+    plan->bytes_per_flush = flush_px * bpp;
+    plan->flushes_per_frame = flush_px ? MEM_DIV_ROUND_UP(frame_px, flush_px) : 0;
+
+    /* A transport chunk holds whole panel rows */
+    const uint32_t panel_row_px = rotated ? cfg->vres : cfg->hres;
+    const uint32_t chunk_px = cfg->trans_size ? (cfg->trans_size / panel_row_px) * panel_row_px : flush_px;
+    plan->chunks_per_flush = (chunk_px && flush_px) ? MEM_DIV_ROUND_UP(flush_px, chunk_px) : 0;
+
+    /* Configurations lvgl_port_add_disp() cannot serve */
+    if (!cfg->buffer_size) {
+        plan->error = "draw buffer size is 0";
+    } else if (cfg->full_refresh && cfg->buffer_size < frame_px) {
+        plan->error = "full refresh needs a full screen draw buffer";
+    } else if (rotated && cfg->buffer_size < frame_px) {
+        plan->error = "90/270 degree software rotation needs a full screen draw buffer";
+    } else if (!flush_px) {
+        plan->error = "draw buffer smaller than one display row";
+    } else if (!cfg->trans_size && cfg->sw_rotate != LV_DISP_ROT_NONE) {
+        plan->error = "software rotation needs transport buffers";
+    } else if (!cfg->trans_size && cfg->buff_caps != LVGL_PORT_MEM_DMA) {
+        plan->error = "without transport buffers the draw buffers must be DMA capable";
+    } else if (cfg->trans_size && !chunk_px) {
+        plan->error = "transport buffer smaller than one panel row";
+    }
+
+    return plan->error == NULL;
+}
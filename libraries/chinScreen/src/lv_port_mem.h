@@ -0,0 +1,72 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Memory budget planner of the LVGL port
+ *
+ * Works out what a display configuration will allocate and how much it sends per flush,
+ * without allocating anything.
+ */
+
+#pragma once
+
+#include "includes/lvgl-8.3.11/src/lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Where the LVGL draw buffers are allocated
+ */
+typedef enum {
+    LVGL_PORT_MEM_PSRAM = 0,    /*!< External PSRAM (MALLOC_CAP_SPIRAM) */
+    LVGL_PORT_MEM_INTERNAL,     /*!< Internal RAM (MALLOC_CAP_INTERNAL) */
+    LVGL_PORT_MEM_DMA,          /*!< Internal DMA capable RAM (MALLOC_CAP_DMA) */
+} lvgl_port_mem_caps_t;
+
+/**
+ * @brief Display configuration to plan
+ */
+typedef struct {
+    uint32_t hres;                  /*!< LVGL horizontal resolution (after software rotation) */
+    uint32_t vres;                  /*!< LVGL vertical resolution (after software rotation) */
+    uint32_t bytes_per_pixel;       /*!< sizeof(lv_color_t) */
+    uint32_t buffer_size;           /*!< Pixels per draw buffer */
+    bool double_buffer;             /*!< Two draw buffers */
+    lvgl_port_mem_caps_t buff_caps; /*!< Draw buffer placement */
+    uint32_t trans_size;            /*!< Pixels per transport buffer (two are allocated in DMA RAM), 0 = none */
+    lv_disp_rot_t sw_rotate;        /*!< Software rotation */
+    bool full_refresh;              /*!< Always redraw and send the whole screen */
+} lvgl_port_mem_cfg_t;
+
+/**
+ * @brief Planned footprint and traffic
+ */
+typedef struct {
+    uint32_t draw_bytes;            /*!< All draw buffers */
+    uint32_t trans_bytes;           /*!< Both transport buffers */
+    uint32_t internal_bytes;        /*!< Internal RAM taken, DMA capable or not */
+    uint32_t dma_bytes;             /*!< Part of internal_bytes that must be DMA capable */
+    uint32_t psram_bytes;           /*!< PSRAM taken */
+    uint32_t bytes_per_flush;       /*!< Largest area handed to the flush callback */
+    uint32_t flushes_per_frame;     /*!< Flushes for a full screen redraw */
+    uint32_t chunks_per_flush;      /*!< Panel transfers for the largest flush */
+    const char *error;              /*!< Why the configuration cannot work, NULL if it can */
+} lvgl_port_mem_plan_t;
+
+/**
+ * @brief Plan a display configuration
+ *
+ * @param[in]  cfg  Configuration
+ * @param[out] plan Footprint and traffic, filled in even when the configuration is rejected
+ *
+ * @return true if the configuration can work, false otherwise (see plan->error)
+ */
+bool lvgl_port_mem_plan(const lvgl_port_mem_cfg_t *cfg, lvgl_port_mem_plan_t *plan);
+
+#ifdef __cplusplus
+}
+#endif
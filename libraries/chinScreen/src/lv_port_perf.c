@@ -0,0 +1,147 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include "lv_port_perf.h"
+
+#if LVGL_PORT_PERF_WINDOW > 255
+#error "LVGL_PORT_PERF_WINDOW must fit the u8 bucket counts of the dump"
+#endif
+
+static lvgl_port_perf_hist_t perf_hist[LVGL_PORT_PERF_MAX];
+
+static const char *const perf_names[LVGL_PORT_PERF_MAX] = {
+    [LVGL_PORT_PERF_RENDER_US] = "render_us",
+    [LVGL_PORT_PERF_FLUSH_US] = "flush_us",
+    [LVGL_PORT_PERF_TE_WAIT_US] = "te_wait_us",
+    [LVGL_PORT_PERF_LOCK_WAIT_US] = "lock_wait_us",
+    [LVGL_PORT_PERF_TX_BYTES] = "tx_bytes",
+    [LVGL_PORT_PERF_AREAS] = "areas",
+    [LVGL_PORT_PERF_PIXELS] = "pixels",
+    [LVGL_PORT_PERF_SLEEP_MS] = "sleep_ms",
+};
+
+void lvgl_port_perf_reset(void)
+{
+    memset(perf_hist, 0, sizeof(perf_hist));
+}
+
+void lvgl_port_perf_record(lvgl_port_perf_metric_t metric, uint32_t value)
+{
+    if (metric >= LVGL_PORT_PERF_MAX) {
+        return;
+    }
+    lvgl_port_perf_hist_t *hist = &perf_hist[metric];
+    hist->samples[hist->head] = value;
+    hist->head = (hist->head + 1) % LVGL_PORT_PERF_WINDOW;
+    if (hist->count < LVGL_PORT_PERF_WINDOW) {
+        hist->count++;
+    }
+    hist->total++;
+}
+
+void lvgl_port_perf_add(lvgl_port_perf_metric_t metric, uint32_t value)
+{
+    if (metric < LVGL_PORT_PERF_MAX) {
+        perf_hist[metric].pending += value;
+    }
+}
+
+void lvgl_port_perf_commit(lvgl_port_perf_metric_t metric)
+{
+    if (metric < LVGL_PORT_PERF_MAX) {
+        const uint32_t value = perf_hist[metric].pending;
+        perf_hist[metric].pending = 0;
+        lvgl_port_perf_record(metric, value);
+    }
+}
+
+bool lvgl_port_perf_get(lvgl_port_perf_metric_t metric, lvgl_port_perf_summary_t *summary)
+{
+    memset(summary, 0, sizeof(lvgl_port_perf_summary_t));
+    if (metric >= LVGL_PORT_PERF_MAX || !perf_hist[metric].count) {
+        return false;
+    }
+
+    /* Work on a copy, the owner of the metric may push while we sort */
+    uint32_t sorted[LVGL_PORT_PERF_WINDOW];
+    const uint32_t n = perf_hist[metric].count;
+    memcpy(sorted, perf_hist[metric].samples, n * sizeof(uint32_t));
+
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        const uint32_t v = sorted[i];
+        uint32_t j = i;
+        while (j > 0 && sorted[j - 1] > v) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = v;
+        sum += v;
+    }
+
+    summary->count = n;
+    summary->total = perf_hist[metric].total;
+    summary->min = sorted[0];
+    summary->max = sorted[n - 1];
+    summary->avg = (uint32_t)((sum + n / 2) / n);
+    /* Nearest rank: the smallest sample at or above 99 % of the window */
+    summary->p99 = sorted[(n * 99 + 99) / 100 - 1];
+    return true;
+}
+
+const char *lvgl_port_perf_name(lvgl_port_perf_metric_t metric)
+{
+    return (metric < LVGL_PORT_PERF_MAX) ? perf_names[metric] : "?";
+}
+
+static uint8_t *perf_put(uint8_t *p, uint32_t v, int bytes)
+{
+    for (int i = 0; i < bytes; i++) {
+        *p++ = (uint8_t)(v >> (8 * i));
+    }
+    return p;
+}
+
+size_t lvgl_port_perf_dump(uint8_t *buf, size_t size, uint32_t timestamp_ms)
+{
+    if (size < LVGL_PORT_PERF_DUMP_SIZE) {
+        return 0;
+    }
+
+    uint8_t *p = buf;
+    p = perf_put(p, LVGL_PORT_PERF_DUMP_MAGIC, 4);
+    p = perf_put(p, LVGL_PORT_PERF_DUMP_VERSION, 1);
+    p = perf_put(p, LVGL_PORT_PERF_MAX, 1);
+    p = perf_put(p, LVGL_PORT_PERF_WINDOW, 2);
+    p = perf_put(p, timestamp_ms, 4);
+
+    for (int m = 0; m < LVGL_PORT_PERF_MAX; m++) {
+        lvgl_port_perf_summary_t s;
+        lvgl_port_perf_get((lvgl_port_perf_metric_t)m, &s);
+        p = perf_put(p, s.total, 4);
+        p = perf_put(p, s.count, 2);
+        p = perf_put(p, s.min, 4);
+        p = perf_put(p, s.avg, 4);
+        p = perf_put(p, s.max, 4);
+        p = perf_put(p, s.p99, 4);
+
+        /* Bucket b holds the samples with a bit length of b, so 0, 1, 2-3, 4-7, ... */
+        uint8_t buckets[LVGL_PORT_PERF_BUCKETS] = {0};
+        for (uint32_t i = 0; i < s.count; i++) {
+            uint32_t v = perf_hist[m].samples[i];
+            int b = 0;
+            while (v) {
+                b++;
+                v >>= 1;
+            }
+            buckets[b < LVGL_PORT_PERF_BUCKETS ? b : LVGL_PORT_PERF_BUCKETS - 1]++;
+        }
+        memcpy(p, buckets, sizeof(buckets));
+        p += sizeof(buckets);
+    }
+
+    return (size_t)(p - buf);
+}
@@ -0,0 +1,124 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Performance counters of the LVGL port
+ *
+ * Every metric keeps its last LVGL_PORT_PERF_WINDOW samples, so min/avg/max/p99 describe what the
+ * screen is doing now rather than since boot. Per frame metrics are summed with
+ * lvgl_port_perf_add() and pushed as one sample with lvgl_port_perf_commit().
+ *
+ * A metric must only be written from one task at a time; lv_port.c writes the render side from the
+ * LVGL task, the flush side from whichever task sends to the panel and the lock wait with the LVGL
+ * mutex held.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef LVGL_PORT_PERF_WINDOW
+#define LVGL_PORT_PERF_WINDOW   128     /*!< Samples kept per metric, at most 255 */
+#endif
+
+#define LVGL_PORT_PERF_DUMP_MAGIC   0x4650564C  /*!< "LVPF" */
+#define LVGL_PORT_PERF_DUMP_VERSION 1
+#define LVGL_PORT_PERF_BUCKETS      24          /*!< log2 buckets in a dump: 0, 1, 2-3, 4-7, ... */
+#define LVGL_PORT_PERF_DUMP_SIZE    (12 + LVGL_PORT_PERF_MAX * (22 + LVGL_PORT_PERF_BUCKETS))  /*!< Bytes of lvgl_port_perf_dump() */
+
+/**
+ * @brief Metrics
+ */
+typedef enum {
+    LVGL_PORT_PERF_RENDER_US = 0,   /*!< Per frame: LVGL rendering, without the time spent flushing or waiting for a buffer */
+    LVGL_PORT_PERF_FLUSH_US,        /*!< Per frame: copying to transport buffers and sending, TE wait included */
+    LVGL_PORT_PERF_TE_WAIT_US,      /*!< Per frame: waiting for a tear-free window */
+    LVGL_PORT_PERF_LOCK_WAIT_US,    /*!< Per lvgl_port_lock(): waiting for the LVGL mutex */
+    LVGL_PORT_PERF_TX_BYTES,        /*!< Per frame: bytes sent to the panel */
+    LVGL_PORT_PERF_AREAS,           /*!< Per frame: dirty areas rendered */
+    LVGL_PORT_PERF_PIXELS,          /*!< Per frame: pixels rendered */
+    LVGL_PORT_PERF_SLEEP_MS,        /*!< Per LVGL task loop: sleep chosen after lv_timer_handler() */
+    LVGL_PORT_PERF_MAX,
+} lvgl_port_perf_metric_t;
+
+/**
+ * @brief Rolling window of one metric
+ */
+typedef struct {
+    uint32_t samples[LVGL_PORT_PERF_WINDOW];
+    uint32_t pending;   /*!< Sum for the sample being built by lvgl_port_perf_add() */
+    uint32_t total;     /*!< Samples ever pushed */
+    uint16_t head;      /*!< Next slot to write */
+    uint16_t count;     /*!< Valid samples */
+} lvgl_port_perf_hist_t;
+
+/**
+ * @brief Summary of one metric over the window
+ */
+typedef struct {
+    uint32_t count;     /*!< Samples in the window */
+    uint32_t total;     /*!< Samples ever pushed */
+    uint32_t min;
+    uint32_t avg;
+    uint32_t max;
+    uint32_t p99;
+} lvgl_port_perf_summary_t;
+
+/**
+ * @brief Forget all samples
+ */
+void lvgl_port_perf_reset(void);
+
+/**
+ * @brief Push one sample
+ */
+void lvgl_port_perf_record(lvgl_port_perf_metric_t metric, uint32_t value);
+
+/**
+ * @brief Add to the sample being built, see lvgl_port_perf_commit()
+ */
+void lvgl_port_perf_add(lvgl_port_perf_metric_t metric, uint32_t value);
+
+/**
+ * @brief Push the sample built by lvgl_port_perf_add() and start a new one at 0
+ */
+void lvgl_port_perf_commit(lvgl_port_perf_metric_t metric);
+
+/**
+ * @brief Summarize one metric
+ *
+ * @return false if the metric has no samples yet (summary is zeroed)
+ */
+bool lvgl_port_perf_get(lvgl_port_perf_metric_t metric, lvgl_port_perf_summary_t *summary);
+
+/**
+ * @brief Short name of a metric, as used by the dump decoder
+ */
+const char *lvgl_port_perf_name(lvgl_port_perf_metric_t metric);
+
+/**
+ * @brief Write all metrics in the compact binary format
+ *
+ * Little endian. Header: magic u32, version u8, metric count u8, window u16, timestamp u32.
+ * Per metric: total u32, count u16, min u32, avg u32, max u32, p99 u32, then LVGL_PORT_PERF_BUCKETS
+ * u8 counts of the window samples by bit length. extras/perf_decode.py decodes it.
+ *
+ * @param[out] buf          Destination
+ * @param[in]  size         Size of buf
+ * @param[in]  timestamp_ms Time of the dump, copied into the header
+ *
+ * @return Bytes written, 0 if buf is smaller than LVGL_PORT_PERF_DUMP_SIZE
+ */
+size_t lvgl_port_perf_dump(uint8_t *buf, size_t size, uint32_t timestamp_ms);
+
+#ifdef __cplusplus
+}
+#endif
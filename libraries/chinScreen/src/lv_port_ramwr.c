@@ -0,0 +1,37 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <limits.h>
+
+#include "lv_port_ramwr.h"
+
+void lvgl_port_ramwr_init(lvgl_port_ramwr_t *ramwr)
+{
+    ramwr->x_start = -1;
+    ramwr->x_end = -1;
+    ramwr->y_end = -1;
+    ramwr->win_y_start = 0;
+    ramwr->win_y_end = INT_MAX;
+}
+
+lvgl_port_ramwr_op_t lvgl_port_ramwr_next(lvgl_port_ramwr_t *ramwr, int x_start, int y_start, int x_end, int y_end)
+{
+    lvgl_port_ramwr_op_t op = {0};
+    const bool in_window = (y_start >= ramwr->win_y_start) && (y_end <= ramwr->win_y_end);
+
+    if (in_window && x_start == ramwr->x_start && x_end == ramwr->x_end && y_start == ramwr->y_end) {
+        /* The last write stopped at the first pixel of this area (full refresh sent in chunks) */
+        op.continuation = true;
+    } else if (!in_window || y_start != ramwr->win_y_start) {
+        /* RAMWR would start at the top of a window this area is not at */
+        op.raset = true;
+        ramwr->win_y_start = y_start;
+        ramwr->win_y_end = y_end;
+    }
+
+    ramwr->x_start = x_start;
+    ramwr->x_end = x_end;
+    ramwr->y_end = y_end;
+    return op;
+}
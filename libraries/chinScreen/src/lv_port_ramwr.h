@@ -0,0 +1,59 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Memory write command selection for QSPI panels (AXS15231B)
+ *
+ * RAMWR starts writing at the top left corner of the CASET/RASET window, RAMWRC carries on where
+ * the previous write stopped. Continuing is only right if the next area starts exactly there and
+ * still lies inside the programmed row window. This tracks the panel's window and write pointer
+ * and picks the commands for the next area.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief What the panel was last told
+ */
+typedef struct {
+    int x_start;        /*!< Column window of the last write */
+    int x_end;          /*!< (end exclusive) */
+    int y_end;          /*!< Row the write pointer stopped at, -1 if unknown */
+    int win_y_start;    /*!< Programmed row window */
+    int win_y_end;      /*!< (end exclusive) */
+} lvgl_port_ramwr_t;
+
+/**
+ * @brief Commands for one area; CASET is always sent
+ */
+typedef struct {
+    bool raset;         /*!< Send RASET y_start .. y_end - 1 before writing */
+    bool continuation;  /*!< Write with RAMWRC instead of RAMWR */
+} lvgl_port_ramwr_op_t;
+
+/**
+ * @brief Start tracking after panel reset, where the row window is the whole panel
+ */
+void lvgl_port_ramwr_init(lvgl_port_ramwr_t *ramwr);
+
+/**
+ * @brief Pick the commands for an area and update the tracked state
+ *
+ * @param[in] ramwr   State
+ * @param[in] x_start Area, end exclusive like esp_lcd_panel_draw_bitmap()
+ *
+ * @return Commands to send
+ */
+lvgl_port_ramwr_op_t lvgl_port_ramwr_next(lvgl_port_ramwr_t *ramwr, int x_start, int y_start, int x_end, int y_end);
+
+#ifdef __cplusplus
+}
+#endif
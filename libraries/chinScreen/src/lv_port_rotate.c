@@ -0,0 +1,190 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "lv_port_rotate.h"
+
+/* Move RGB565 pixels in pairs through 32 bit loads and stores */
+#if LV_COLOR_DEPTH == 16 && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define ROTATE_PAIRED 1
+#else
+#define ROTATE_PAIRED 0
+#endif
+
+#define ROTATE_MIN(a, b)    ((a) < (b) ? (a) : (b))
+#define ROTATE_ALIGNED(p)   ((((uintptr_t)(p)) & 0x3) == 0)
+
+static void rotate_none(lv_color_t *to, const lv_color_t *from, lv_coord_t w, lv_coord_t h, lv_coord_t stride)
+{
+    if (stride == w) {
+        memcpy(to, from, (size_t)w * h * sizeof(lv_color_t));
+        return;
+    }
+    for (lv_coord_t y = 0; y < h; y++) {
+        memcpy(to + y * w, from + y * stride, (size_t)w * sizeof(lv_color_t));
+    }
+}
+
+static void rotate_180(lv_color_t *to, const lv_color_t *from, lv_coord_t w, lv_coord_t h, lv_coord_t stride)
+{
+    for (lv_coord_t y = 0; y < h; y++) {
+        /* Walk the source row backwards while filling the mirrored destination row forwards */
+        const lv_color_t *s = from + y * stride + w;
+        lv_color_t *d = to + (h - y - 1) * w;
+        lv_coord_t n = w;
+#if ROTATE_PAIRED
+        if (n && !ROTATE_ALIGNED(d)) {
+            *d++ = *--s;
+            n--;
+        }
+        if (ROTATE_ALIGNED(s)) {
+            const uint32_t *s32 = (const uint32_t *)s;
+            uint32_t *d32 = (uint32_t *)d;
+            for (; n >= 2; n -= 2) {
+                uint32_t v = *--s32;
+                *d32++ = (v >> 16) | (v << 16);
+            }
+            s = (const lv_color_t *)s32;
+            d = (lv_color_t *)d32;
+        }
+#endif
+        for (lv_coord_t x = 0; x < n; x++) {
+            d[x] = *(s - x - 1);
+        }
+    }
+}
+
+/* One tile of the 90 degree rotation, a pixel at a time */
+static void rotate_90_tile(lv_color_t *to, const lv_color_t *from, lv_coord_t h, lv_coord_t stride,
+                           lv_coord_t x0, lv_coord_t x1, lv_coord_t y0, lv_coord_t y1)
+{
+    for (lv_coord_t x = x0; x < x1; x++) {
+        const lv_color_t *s = from + y0 * stride + x;
+        lv_color_t *d = to + x * h + (h - y0 - 1);
+        for (lv_coord_t y = y0; y < y1; y++) {
+            *d-- = *s;
+            s += stride;
+        }
+    }
+}
+
+/* One tile of the 270 degree rotation, a pixel at a time */
+static void rotate_270_tile(lv_color_t *to, const lv_color_t *from, lv_coord_t w, lv_coord_t h, lv_coord_t stride,
+                            lv_coord_t x0, lv_coord_t x1, lv_coord_t y0, lv_coord_t y1)
+{
+    for (lv_coord_t x = x0; x < x1; x++) {
+        const lv_color_t *s = from + y0 * stride + x;
+        lv_color_t *d = to + (w - x - 1) * h + y0;
+        for (lv_coord_t y = y0; y < y1; y++) {
+            *d++ = *s;
+            s += stride;
+        }
+    }
+}
+
+#if ROTATE_PAIRED
+/*
+ * 2x2 pixel blocks: two 32 bit loads from consecutive source rows give two pixel pairs that are
+ * each stored with one 32 bit write into consecutive destination rows. Needs even tile bounds,
+ * so any odd last column is left to the scalar kernel.
+ */
+static void rotate_90_tile_paired(lv_color_t *to, const lv_color_t *from, lv_coord_t h, lv_coord_t stride,
+                                  lv_coord_t x0, lv_coord_t x1, lv_coord_t y0, lv_coord_t y1)
+{
+    for (lv_coord_t y = y0; y < y1; y += 2) {
+        const uint32_t *a32 = (const uint32_t *)(from + y * stride + x0);
+        const uint32_t *b32 = (const uint32_t *)(from + (y + 1) * stride + x0);
+        uint32_t *d32 = (uint32_t *)(to + x0 * h + (h - y - 2));
+        for (lv_coord_t x = x0; x < x1; x += 2) {
+            uint32_t a = *a32++;
+            uint32_t b = *b32++;
+            d32[0] = (b & 0xFFFF) | (a << 16);
+            d32[h / 2] = (b >> 16) | (a & 0xFFFF0000);
+            d32 += h;
+        }
+    }
+}
+
+static void rotate_270_tile_paired(lv_color_t *to, const lv_color_t *from, lv_coord_t w, lv_coord_t h, lv_coord_t stride,
+                                   lv_coord_t x0, lv_coord_t x1, lv_coord_t y0, lv_coord_t y1)
+{
+    for (lv_coord_t y = y0; y < y1; y += 2) {
+        const uint32_t *a32 = (const uint32_t *)(from + y * stride + x0);
+        const uint32_t *b32 = (const uint32_t *)(from + (y + 1) * stride + x0);
+        uint32_t *d32 = (uint32_t *)(to + (w - x0 - 1) * h + y);
+        for (lv_coord_t x = x0; x < x1; x += 2) {
+            uint32_t a = *a32++;
+            uint32_t b = *b32++;
+            d32[0] = (a & 0xFFFF) | (b << 16);
+            *(d32 - h / 2) = (a >> 16) | (b & 0xFFFF0000);
+            d32 -= h;
+        }
+    }
+}
+#endif
+
+static void rotate_90_270(lv_color_t *to, const lv_color_t *from, lv_coord_t w, lv_coord_t h, lv_coord_t stride,
+                          bool rot_90)
+{
+#if ROTATE_PAIRED
+    /* Even heights keep every destination pair on a 32 bit boundary */
+    const bool paired = ROTATE_ALIGNED(to) && ROTATE_ALIGNED(from) && !(stride & 1) && !(h & 1);
+#else
+    const bool paired = false;
+#endif
+
+    for (lv_coord_t y0 = 0; y0 < h; y0 += LVGL_PORT_ROTATE_TILE) {
+        const lv_coord_t y1 = ROTATE_MIN(y0 + LVGL_PORT_ROTATE_TILE, h);
+        for (lv_coord_t x0 = 0; x0 < w; x0 += LVGL_PORT_ROTATE_TILE) {
+            const lv_coord_t x1 = ROTATE_MIN(x0 + LVGL_PORT_ROTATE_TILE, w);
+            lv_coord_t x_scalar = x0;
+#if ROTATE_PAIRED
+            if (paired) {
+                x_scalar = x1 & ~1;
+                if (x_scalar > x0) {
+                    if (rot_90) {
+                        rotate_90_tile_paired(to, from, h, stride, x0, x_scalar, y0, y1);
+                    } else {
+                        rotate_270_tile_paired(to, from, w, h, stride, x0, x_scalar, y0, y1);
+                    }
+                }
+            }
+#endif
+            if (x_scalar < x1) {
+                if (rot_90) {
+                    rotate_90_tile(to, from, h, stride, x_scalar, x1, y0, y1);
+                } else {
+                    rotate_270_tile(to, from, w, h, stride, x_scalar, x1, y0, y1);
+                }
+            }
+        }
+    }
+    (void)paired;
+}
+
+void lvgl_port_rotate_copy(lv_color_t *to, const lv_color_t *from, lv_coord_t w, lv_coord_t h, lv_coord_t stride,
+                           lv_disp_rot_t rotate)
+{
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+
+    switch (rotate) {
+    case LV_DISP_ROT_90:
+        rotate_90_270(to, from, w, h, stride, true);
+        break;
+    case LV_DISP_ROT_180:
+        rotate_180(to, from, w, h, stride);
+        break;
+    case LV_DISP_ROT_270:
+        rotate_90_270(to, from, w, h, stride, false);
+        break;
+    case LV_DISP_ROT_NONE:
+    default:
+        rotate_none(to, from, w, h, stride);
+        break;
+    }
+}
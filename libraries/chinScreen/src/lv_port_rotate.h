@@ -0,0 +1,51 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Software rotation kernels of the LVGL port
+ */
+
+#pragma once
+
+#include "includes/lvgl-8.3.11/src/lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Side of the square tiles the 90/270 degree transposes work on
+ *
+ * 16 RGB565 pixels are one 32 byte cache line of the ESP32-S3, so a tile reads and writes
+ * whole lines. Must be even.
+ */
+#ifndef LVGL_PORT_ROTATE_TILE
+#define LVGL_PORT_ROTATE_TILE 16
+#endif
+
+/**
+ * @brief Copy a block of the draw buffer into a transport buffer, rotated
+ *
+ * The destination is packed (no stride). For a w x h source block:
+ *  - LV_DISP_ROT_NONE: h rows of w pixels, copied as is
+ *  - LV_DISP_ROT_90:   w rows of h pixels, to[x * h + (h - y - 1)] = from[y * stride + x]
+ *  - LV_DISP_ROT_180:  h rows of w pixels, to[(h - y - 1) * w + (w - x - 1)] = from[y * stride + x]
+ *  - LV_DISP_ROT_270:  w rows of h pixels, to[(w - x - 1) * h + y] = from[y * stride + x]
+ *
+ * With 16 bit colors and 4 byte aligned buffers two pixels are moved per 32 bit access.
+ *
+ * @param[out] to     Destination buffer, at least w * h pixels
+ * @param[in]  from   First pixel of the block in the source buffer
+ * @param[in]  w      Block width in pixels
+ * @param[in]  h      Block height in pixels
+ * @param[in]  stride Source buffer width in pixels
+ * @param[in]  rotate Rotation to apply
+ */
+void lvgl_port_rotate_copy(lv_color_t *to, const lv_color_t *from, lv_coord_t w, lv_coord_t h, lv_coord_t stride,
+                           lv_disp_rot_t rotate);
+
+#ifdef __cplusplus
+}
+#endif
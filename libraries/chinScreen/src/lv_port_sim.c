@@ -0,0 +1,83 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include "lv_port_sim.h"
+
+#define SIM_MAX(a, b) ((a) > (b) ? (a) : (b))
+
+void lvgl_port_sim_init(lvgl_port_sim_t *sim, const lvgl_port_sim_cfg_t *cfg)
+{
+    memset(sim, 0, sizeof(lvgl_port_sim_t));
+    sim->cfg = *cfg;
+}
+
+static uint64_t lvgl_port_sim_xfer_ns(const lvgl_port_sim_t *sim, uint32_t px)
+{
+    uint64_t bytes = (uint64_t)px * sim->cfg.bytes_per_pixel;
+    return sim->cfg.chunk_overhead_ns + (bytes * 1000000000ULL) / sim->cfg.bus_bytes_per_sec;
+}
+
+void lvgl_port_sim_area(lvgl_port_sim_t *sim, uint32_t px, uint64_t render_ns)
+{
+    const bool async = sim->cfg.async_flush;
+
+    /* Render into the free draw buffer, then wait for the other one to be released */
+    uint64_t render_end = sim->render_free_ns + render_ns;
+    uint64_t flush_start = SIM_MAX(render_end, sim->flush_done_ns);
+
+    /* Without transport buffers the draw buffer is sent as is and held until the transfer is done */
+    if (!sim->cfg.trans_size) {
+        uint64_t start = SIM_MAX(flush_start, sim->bus_free_ns);
+        uint64_t xfer = lvgl_port_sim_xfer_ns(sim, px);
+        sim->bus_free_ns = start + xfer;
+        sim->bus_busy_ns += xfer;
+        sim->bytes += (uint64_t)px * sim->cfg.bytes_per_pixel;
+        sim->chunks++;
+        sim->render_free_ns = async ? flush_start : start;
+        sim->flush_done_ns = async ? sim->bus_free_ns : start;
+        return;
+    }
+
+    /* The copying task runs on the LVGL task (sync) or on the flush task (async) */
+    uint64_t cpu = async ? SIM_MAX(flush_start, sim->copy_free_ns) : flush_start;
+    uint64_t released = cpu;
+    uint32_t left = px;
+    bool first = true;
+    while (left) {
+        uint32_t len = (left < sim->cfg.trans_size) ? left : sim->cfg.trans_size;
+        cpu += (uint64_t)len * sim->cfg.copy_ns_per_px;
+        left -= len;
+        if (!left) {
+            released = cpu;
+        }
+
+        /* trans_done_sem: the synchronous path resets it on the first chunk of every area */
+        if (async || !first) {
+            cpu = SIM_MAX(cpu, sim->bus_free_ns);
+        }
+        uint64_t start = SIM_MAX(cpu, sim->bus_free_ns);
+        uint64_t xfer = lvgl_port_sim_xfer_ns(sim, len);
+        sim->bus_free_ns = start + xfer;
+        sim->bus_busy_ns += xfer;
+        sim->bytes += (uint64_t)len * sim->cfg.bytes_per_pixel;
+        sim->chunks++;
+        first = false;
+    }
+
+    if (async) {
+        sim->render_free_ns = flush_start;
+        sim->flush_done_ns = released;
+        sim->copy_free_ns = cpu;
+    } else {
+        sim->render_free_ns = cpu;
+        sim->flush_done_ns = cpu;
+    }
+}
+
+uint64_t lvgl_port_sim_frame_ns(const lvgl_port_sim_t *sim)
+{
+    return SIM_MAX(sim->bus_free_ns, sim->render_free_ns);
+}
@@ -0,0 +1,80 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Timing model of the LVGL port flush path
+ *
+ * Replays the areas LVGL hands to the flush callback against a panel IO with a configurable
+ * bus bandwidth, so the synchronous and asynchronous flush pipelines can be compared on the
+ * host without hardware. Times are in nanoseconds of simulated time.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Simulated panel IO and port configuration
+ */
+typedef struct {
+    uint32_t bus_bytes_per_sec; /*!< Effective color throughput of the bus, e.g. 40 MHz QSPI = 20000000 */
+    uint32_t bytes_per_pixel;   /*!< Bytes per pixel on the bus */
+    uint32_t trans_size;        /*!< Pixels per transport chunk, 0 sends straight from the draw buffer */
+    uint32_t copy_ns_per_px;    /*!< Cost of copying/rotating one pixel into a transport buffer */
+    uint32_t chunk_overhead_ns; /*!< CASET/RASET/RAMWR(C) commands sent before each chunk */
+    bool async_flush;           /*!< Flush callback only queues the area (lvgl_port_display_cfg_t::flags.async_flush) */
+} lvgl_port_sim_cfg_t;
+
+/**
+ * @brief Simulation state
+ */
+typedef struct {
+    lvgl_port_sim_cfg_t cfg;
+    uint64_t render_free_ns;    /*!< The flush callback has returned, LVGL may render the next area */
+    uint64_t flush_done_ns;     /*!< The previous area's draw buffer is released (lv_disp_flush_ready) */
+    uint64_t copy_free_ns;      /*!< The task copying into the transport buffers is idle */
+    uint64_t bus_free_ns;       /*!< The last queued chunk has left the bus */
+    uint64_t bus_busy_ns;       /*!< Total time the bus spent sending colors */
+    uint64_t bytes;             /*!< Total color bytes sent */
+    uint32_t chunks;            /*!< Total chunks sent */
+} lvgl_port_sim_t;
+
+/**
+ * @brief Reset the simulation
+ *
+ * @param[out] sim Simulation state
+ * @param[in]  cfg Panel IO and port configuration
+ */
+void lvgl_port_sim_init(lvgl_port_sim_t *sim, const lvgl_port_sim_cfg_t *cfg);
+
+/**
+ * @brief Render one area and flush it
+ *
+ * LVGL renders into the free draw buffer, waits until the previous area has been released and then
+ * calls the flush callback. The area is split into transport chunks and each chunk is copied into
+ * one of the two transport buffers before it is queued, like lvgl_port_flush_area() does:
+ *  - synchronous flush copies on the LVGL task and waits for the bus from the second chunk on,
+ *  - asynchronous flush copies on the flush task, waits for the bus before every chunk and releases
+ *    the draw buffer as soon as the last chunk is copied.
+ *
+ * @param sim       Simulation state
+ * @param px        Pixels in the area
+ * @param render_ns Time LVGL needs to render the area
+ */
+void lvgl_port_sim_area(lvgl_port_sim_t *sim, uint32_t px, uint64_t render_ns);
+
+/**
+ * @brief Time from the start of the simulation until the last pixel has been sent
+ */
+uint64_t lvgl_port_sim_frame_ns(const lvgl_port_sim_t *sim);
+
+#ifdef __cplusplus
+}
+#endif
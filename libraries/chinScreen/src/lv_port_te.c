@@ -0,0 +1,109 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include "lv_port_te.h"
+
+/* Consecutive off-period edges after which the learned period is thrown away */
+#define TE_RELEARN_OUTLIERS     4
+/* Without an edge for this many periods the TE signal is considered lost */
+#define TE_LOST_PERIODS         4
+
+void lvgl_port_te_init(lvgl_port_te_t *te, const lvgl_port_te_cfg_t *cfg)
+{
+    memset(te, 0, sizeof(lvgl_port_te_t));
+    te->cfg = *cfg;
+    te->period_q4 = cfg->period_us << 4;
+    te->stats.period_us = cfg->period_us;
+}
+
+void lvgl_port_te_edge(lvgl_port_te_t *te, int64_t now_us)
+{
+    if (te->last_te_us) {
+        const int64_t dt = now_us - te->last_te_us;
+        const int64_t period = te->period_q4 >> 4;
+
+        if (dt < period / 2) {
+            /* Glitch, keep the previous edge as phase reference */
+            te->stats.te_rejected++;
+            return;
+        }
+        if (dt <= period * 3 / 2) {
+            /* Exponential moving average, 1/8 weight for the new sample */
+            te->period_q4 = (uint32_t)((int64_t)te->period_q4 + (((dt << 4) - (int64_t)te->period_q4) / 8));
+            te->outliers = 0;
+        } else if (++te->outliers >= TE_RELEARN_OUTLIERS && dt < (int64_t)UINT32_MAX >> 4) {
+            /* Either edges are being lost or the panel really runs that slow; trust the latest gap */
+            te->period_q4 = (uint32_t)(dt << 4);
+            te->outliers = 0;
+        }
+        te->stats.period_us = te->period_q4 >> 4;
+    }
+    te->last_te_us = now_us;
+    te->stats.te_count++;
+}
+
+uint32_t lvgl_port_te_plan(lvgl_port_te_t *te, int64_t now_us, int32_t row_start, int32_t row_end)
+{
+    const int64_t period = te->period_q4 >> 4;
+    const int64_t rows = row_end - row_start + 1;
+
+    te->stats.bands++;
+    if (!te->last_te_us || now_us - te->last_te_us > period * TE_LOST_PERIODS || !te->cfg.lines) {
+        te->stats.missed_deadlines++;
+        return 0;
+    }
+
+    /* The scan time scales with the learned period */
+    const int64_t scan = period * te->cfg.scan_us / te->cfg.period_us;
+    const int64_t margin = te->cfg.margin_us;
+
+    /*
+     * Writing row y at w(y) and scanning it at s(y) are both linear in y, so the band tears in a scan
+     * only if w(y) - s(y) changes sign between its first and last row. With a = time since the beam
+     * passed row_start (mod period) and delta = how much longer the bus needs for the band than the
+     * beam, the band is tear-free when max(0, -delta) <= a <= period - max(0, delta).
+     */
+    const int64_t xfer = rows * te->cfg.row_xfer_ns / 1000;
+    const int64_t delta = xfer - rows * scan / te->cfg.lines;
+    const int64_t lo = (delta < 0 ? -delta : 0) + margin;
+    const int64_t hi = period - (delta > 0 ? delta : 0) - margin;
+    if (lo > hi) {
+        /* The band cannot be placed between two passes of the beam */
+        te->stats.missed_deadlines++;
+        return 0;
+    }
+
+    const int64_t beam_us = te->last_te_us + (int64_t)row_start * scan / te->cfg.lines;
+    int64_t a = (now_us - beam_us) % period;
+    if (a < 0) {
+        a += period;
+    }
+    if (a >= lo && a <= hi) {
+        return 0;
+    }
+
+    const int64_t wait = (a < lo) ? (lo - a) : (period - a + lo);
+    const int64_t max_wait = te->cfg.max_wait_us ? te->cfg.max_wait_us : period;
+    if (wait > max_wait) {
+        te->stats.missed_deadlines++;
+        return 0;
+    }
+
+    te->stats.tears_avoided++;
+    te->stats.wait_us += wait;
+    return (uint32_t)wait;
+}
+
+uint32_t lvgl_port_te_refr_period_ms(const lvgl_port_te_t *te)
+{
+    const uint64_t period = te->period_q4 >> 4;
+    const uint64_t frame = (uint64_t)te->cfg.lines * te->cfg.row_xfer_ns / 1000 + te->cfg.margin_us;
+    uint64_t periods = period ? (frame + period - 1) / period : 1;
+    if (!periods) {
+        periods = 1;
+    }
+    return (uint32_t)((periods * period + 999) / 1000);
+}
@@ -0,0 +1,98 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief TE driven frame scheduler
+ *
+ * Learns the panel refresh period from timestamped TE edges and plans every transfer so the
+ * written rows never cross the scan line: a band is sent either fully behind the beam or fully
+ * ahead of its next pass. Pure integer math, so lvgl_port_te_edge() can run in the TE interrupt.
+ *
+ * The TE edge is taken as the moment the panel starts scanning row 0. The panel then scans its
+ * rows linearly during the first scan_us of every period (Tvdl) and idles for the rest (Tvdh).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Scheduler configuration
+ */
+typedef struct {
+    uint32_t lines;             /*!< Panel rows scanned every refresh */
+    uint32_t period_us;         /*!< Expected TE period (Tvdl + Tvdh) until one is measured */
+    uint32_t scan_us;           /*!< Part of period_us spent scanning rows (Tvdl) */
+    uint32_t row_xfer_ns;       /*!< Time the bus needs to send one panel row */
+    uint32_t margin_us;         /*!< Distance kept between the written rows and the scan line */
+    uint32_t max_wait_us;       /*!< Longest wait for a tear-free slot before sending anyway, 0 = one period */
+} lvgl_port_te_cfg_t;
+
+/**
+ * @brief Scheduler counters
+ */
+typedef struct {
+    uint32_t te_count;          /*!< TE edges accepted */
+    uint32_t te_rejected;       /*!< TE edges dropped as glitches or outliers */
+    uint32_t period_us;         /*!< Learned TE period */
+    uint32_t bands;             /*!< Transfers planned */
+    uint32_t tears_avoided;     /*!< Transfers delayed because sending right away would have torn */
+    uint32_t missed_deadlines;  /*!< Transfers sent without a tear-free slot (no TE, bus too slow or wait too long) */
+    uint64_t wait_us;           /*!< Total time transfers were delayed */
+} lvgl_port_te_stats_t;
+
+/**
+ * @brief Scheduler state
+ */
+typedef struct {
+    lvgl_port_te_cfg_t cfg;
+    lvgl_port_te_stats_t stats;
+    int64_t last_te_us;         /*!< Timestamp of the latest accepted TE edge, 0 before the first one */
+    uint32_t period_q4;         /*!< Learned period in 1/16 us */
+    uint8_t outliers;           /*!< Consecutive edges that did not match the learned period */
+} lvgl_port_te_t;
+
+/**
+ * @brief Reset the scheduler
+ */
+void lvgl_port_te_init(lvgl_port_te_t *te, const lvgl_port_te_cfg_t *cfg);
+
+/**
+ * @brief Record a TE edge
+ *
+ * Safe to call from an interrupt.
+ *
+ * @param te     Scheduler
+ * @param now_us Edge timestamp in microseconds
+ */
+void lvgl_port_te_edge(lvgl_port_te_t *te, int64_t now_us);
+
+/**
+ * @brief Plan the transfer of a band of panel rows
+ *
+ * @param te        Scheduler
+ * @param now_us    Time the transfer could start
+ * @param row_start First panel row of the band
+ * @param row_end   Last panel row of the band
+ *
+ * @return Microseconds to wait before starting the transfer, 0 to start right away
+ */
+uint32_t lvgl_port_te_plan(lvgl_port_te_t *te, int64_t now_us, int32_t row_start, int32_t row_end);
+
+/**
+ * @brief LVGL refresh period matching the panel
+ *
+ * The learned TE period, or a multiple of it when a whole frame does not fit in one period,
+ * rounded up to milliseconds.
+ */
+uint32_t lvgl_port_te_refr_period_ms(const lvgl_port_te_t *te);
+
+#ifdef __cplusplus
+}
+#endif